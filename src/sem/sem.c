@@ -4,6 +4,11 @@
 #include "sircore_vm.h"
 #include "sem_hosted.h"
 #include "sir_jsonl.h"
+#include "sem_replay.h"
+#include "sem_bench.h"
+#include "sem_fuzz.h"
+#include "sem_serve.h"
+#include "sem_trace_bin.h"
 #include "zi_tape.h"
 #include "zcl1.h"
 
@@ -13,7 +18,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include <dirent.h>
+#include <pthread.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 #ifndef SIR_VERSION
 #define SIR_VERSION "0.0.0"
@@ -38,62 +45,103 @@ typedef enum sem_list_format {
 } sem_list_format_t;
 
 static void sem_print_help(FILE* out) {
-  fprintf(out,
-          "sem — SIR emulator host frontend (MVP)\n"
-          "\n"
-          "Usage:\n"
-          "  sem [--help] [--version]\n"
-          "  sem --print-support [--json]\n"
-          "  sem --caps [--json]\n"
-          "      [--cap KIND:NAME[:FLAGS]]...\n"
-          "      [--cap-file-fs] [--cap-async-default] [--cap-sys-info]\n"
-          "      [--fs-root PATH]\n"
-          "      [--tape-out PATH] [--tape-in PATH] [--tape-lax]\n"
-          "  sem --list <input.sir.jsonl|dir>... [--format text|json]\n"
-          "  sem --check <input.sir.jsonl|dir>... [--check-run] [--format text|json] [--diagnostics text|json] [--all]\n"
-          "  sem --cat GUEST_PATH --fs-root PATH\n"
-          "  sem --sir-hello\n"
-          "  sem --sir-module-hello\n"
-          "  sem --run FILE.sir.jsonl [--trace-jsonl-out PATH] [--coverage-jsonl-out PATH] [--diagnostics text|json] [--fs-root PATH] [--cap ...]\n"
-          "  sem --verify FILE.sir.jsonl [--diagnostics text|json]\n"
-          "\n"
-          "Options:\n"
-          "  --help        Show this help message\n"
-          "  --version     Show version information (from ./VERSION)\n"
-          "  --print-support  Print the supported SIR subset for `sem --run`\n"
-          "  --caps        Issue zi_ctl CAPS_LIST and print capabilities\n"
-          "  --list        List `*.sir.jsonl` inputs without running\n"
-          "  --check       Batch-verify one or more inputs (files or dirs)\n"
-          "  --check-run   For --check, run cases (not just verify)\n"
-          "  --format      For --check, emit results as: text (default) or json (JSON is written to stderr)\n"
-          "  --cat PATH    Read PATH via file/fs and write to stdout\n"
-          "  --sir-hello   Run a tiny built-in sircore VM smoke program\n"
-          "  --sir-module-hello  Run a tiny built-in sircore module smoke program\n"
-          "  --run FILE    Run a small supported SIR subset (MVP)\n"
-          "  --verify FILE Validate + lower (no execution)\n"
-          "  --trace-jsonl-out PATH  Write execution trace JSONL to PATH (for --run)\n"
-          "  --coverage-jsonl-out PATH  Write execution coverage JSONL to PATH (for --run)\n"
-          "  --trace-func NAME  For --trace-jsonl-out, only emit events in function NAME\n"
-          "  --trace-op OP      For --trace-jsonl-out, only emit step events matching OP (e.g. i32.add, term.cbr)\n"
-          "  --json        Emit --caps output as JSON (stdout)\n"
-          "  --diagnostics Emit --run/--verify diagnostics as: text (default) or json\n"
-          "  --all         For --run/--verify, try to emit multiple diagnostics (best-effort)\n"
-          "\n"
-          "  --cap KIND:NAME[:FLAGS]\n"
-          "      Add a capability entry. FLAGS is a comma-list of:\n"
-          "        open (ZI_CAP_CAN_OPEN), pure (ZI_CAP_PURE), block (ZI_CAP_MAY_BLOCK)\n"
-          "\n"
-          "  --cap-file-fs       Sugar for --cap file:fs:open,block\n"
-          "  --cap-async-default Sugar for --cap async:default:open,block\n"
-          "  --cap-sys-info      Sugar for --cap sys:info:pure\n"
-          "  --fs-root PATH      Sandbox root for file/fs (enables open)\n"
-          "\n"
-          "  --tape-out PATH  Record all zi_ctl requests/responses to a tape file\n"
-          "  --tape-in PATH   Replay zi_ctl from a tape file (no real host)\n"
-          "  --tape-lax       Do not require request bytes to match tape (unsafe)\n"
-          "\n"
-          "License: GPLv3+\n"
-          "© 2026 Frogfish — Author: Alexander Croft\n");
+  fputs("sem — SIR emulator host frontend (MVP)\n"
+        "\n"
+        "Usage:\n"
+        "  sem [--help] [--version]\n"
+        "  sem --print-support [--json]\n"
+        "  sem --caps [--json]\n"
+        "      [--cap KIND:NAME[:FLAGS]]...\n"
+        "      [--cap-file-fs] [--cap-async-default] [--cap-sys-info]\n"
+        "      [--fs-root PATH]\n"
+        "      [--tape-out PATH [--tape-compress]] [--tape-in PATH] [--tape-lax]\n"
+        "  sem --list <input.sir.jsonl|dir>... [--format text|json]\n"
+        "  sem --check <input.sir.jsonl|dir>... [--check-run] [-j N] [--format text|json] [--diagnostics text|json] [--all]\n"
+        "  sem --cat GUEST_PATH --fs-root PATH\n"
+        "  sem --sir-hello\n"
+        "  sem --sir-module-hello\n"
+        "  sem --run FILE.sir.jsonl [--lazy] [--cache-dir DIR] [--trace-jsonl-out PATH | --trace-bin-out PATH] [--coverage-jsonl-out PATH] [--diagnostics text|json] [--fs-root PATH] [--cap ...]\n"
+        "  sem --run FILE.sir.jsonl --tape-out PATH [--tape-compress] [--checkpoint-out PATH [--checkpoint-every N]]\n"
+        "  sem --run FILE.sir.jsonl --tape-in PATH [--tape-lax] [--checkpoint-in PATH] [--seek-step N | --seek-hostcall N] [trace flags]\n"
+        "  sem --verify FILE.sir.jsonl [--diagnostics text|json]\n"
+        "  sem --fuzz FILE.sir.jsonl [--fuzz-iters N] [--fuzz-len N] [--fuzz-mutations N] [--fuzz-seed N] [--fuzz-max-steps N]\n"
+        "      [--fuzz-corpus DIR] [--fuzz-crash-dir DIR] [--fs-root PATH] [--cap ...]\n"
+        "  sem --bench N FILE.sir.jsonl [--bench-max-insts N] [--bench-max-host-allocs N] [--bench-max-heap N]\n"
+        "      [--bench-max-ns-per-inst X] [--fs-root PATH] [--cap ...]\n"
+        "  sem --trace-dump TRACE.bin\n"
+        "  sem --serve | --serve-socket PATH [--fs-root PATH] [--cap ...]\n",
+        out);
+  fputs("\n"
+        "Options:\n"
+        "  --help        Show this help message\n"
+        "  --version     Show version information (from ./VERSION)\n"
+        "  --print-support  Print the supported SIR subset for `sem --run`\n"
+        "  --caps        Issue zi_ctl CAPS_LIST and print capabilities\n"
+        "  --list        List `*.sir.jsonl` inputs without running\n"
+        "  --check       Batch-verify one or more inputs (files or dirs)\n"
+        "  --check-run   For --check, run cases (not just verify)\n"
+        "  -j, --jobs N  For --check, check N cases concurrently (0 = one per CPU; output order is unchanged)\n"
+        "  --format      For --check, emit results as: text (default) or json (JSON is written to stderr)\n"
+        "  --cat PATH    Read PATH via file/fs and write to stdout\n"
+        "  --sir-hello   Run a tiny built-in sircore VM smoke program\n"
+        "  --sir-module-hello  Run a tiny built-in sircore module smoke program\n"
+        "  --run FILE    Run a small supported SIR subset (MVP)\n"
+        "  --verify FILE Validate + lower (no execution)\n"
+        "  --lazy        For --run, lower each fn body on its first call (uncalled fns are never lowered)\n",
+        out);
+  fputs("  --fuzz FILE   Coverage-guided fuzzing of guest stdin, in process (exit 1 if anything crashed or hung)\n"
+        "  --fuzz-iters N       Executions (default 10000)\n"
+        "  --fuzz-len N         Max input size in bytes (default 64)\n"
+        "  --fuzz-mutations N   Max stacked mutations per input (default 4)\n"
+        "  --fuzz-seed N        PRNG seed (default 1)\n"
+        "  --fuzz-max-steps N   Instructions per execution before it counts as a hang (default 1000000)\n"
+        "  --fuzz-corpus DIR    Read seeds from DIR and add inputs that reach new coverage\n"
+        "  --fuzz-crash-dir DIR Write one input per distinct crash site (and the first hang) to DIR\n"
+        "  --bench N FILE  Load FILE once, run it N times and print a k:opt_report JSONL record to stdout\n"
+        "  --bench-max-insts N       Fail (exit 1) if a run retires more than N instructions\n"
+        "  --bench-max-host-allocs N Fail if a run makes more than N executor host allocations\n"
+        "  --bench-max-heap N        Fail if the guest heap high-water mark exceeds N bytes\n"
+        "  --bench-max-ns-per-inst X Fail if the median run takes more than X ns per instruction\n",
+        out);
+  fputs("  --serve       Keep modules resident; run JSONL requests from stdin, answer on stdout (see sem_serve.h)\n"
+        "  --serve-socket PATH  Same protocol over a Unix socket, one connection at a time\n"
+        "  --cache-dir DIR  For --run, reuse/store binary module images (.sirm) keyed by input hash\n"
+        "  --trace-jsonl-out PATH  Write execution trace JSONL to PATH (for --run)\n"
+        "  --trace-bin-out PATH  Write a compact binary execution trace to PATH (for --run)\n"
+        "  --trace-dump PATH  Convert a --trace-bin-out trace to trace JSONL on stdout\n"
+        "  --coverage-jsonl-out PATH  Write execution coverage JSONL to PATH (for --run)\n"
+        "  --trace-func NAME  For --trace-jsonl-out/--trace-bin-out, only emit events in function NAME\n"
+        "  --trace-op OP      For --trace-jsonl-out/--trace-bin-out, only emit step events matching OP (e.g. i32.add, term.cbr)\n"
+        "  --json        Emit --caps output as JSON (stdout)\n"
+        "  --diagnostics Emit --run/--verify diagnostics as: text (default) or json\n"
+        "  --all         For --run/--verify, try to emit multiple diagnostics (best-effort)\n",
+        out);
+  fputs("\n"
+        "  --cap KIND:NAME[:FLAGS]\n"
+        "      Add a capability entry. FLAGS is a comma-list of:\n"
+        "        open (ZI_CAP_CAN_OPEN), pure (ZI_CAP_PURE), block (ZI_CAP_MAY_BLOCK)\n"
+        "\n"
+        "  --cap-file-fs       Sugar for --cap file:fs:open,block\n"
+        "  --cap-async-default Sugar for --cap async:default:open,block\n"
+        "  --cap-sys-info      Sugar for --cap sys:info:pure\n"
+        "  --fs-root PATH      Sandbox root for file/fs (enables open)\n",
+        out);
+  fputs("\n"
+        "  --tape-out PATH  Record all zi_ctl requests/responses to a tape file\n"
+        "  --tape-compress  With --tape-out, LZ-compress tape blocks\n"
+        "  --tape-in PATH   Replay zi_ctl from a tape file (no real host)\n"
+        "  --tape-lax       Do not require request bytes to match tape (unsafe)\n"
+        "                   With --run, the tape holds the guest's hostcalls instead\n"
+        "  --checkpoint-out PATH  With --run --tape-out, write periodic checkpoints to PATH\n"
+        "  --checkpoint-every N   Steps between checkpoints (default 1000000)\n"
+        "  --checkpoint-in PATH   With --run --tape-in, resume from the nearest checkpoint before the seek point\n"
+        "  --seek-step N          With --tape-in, output/trace start after N executed instructions\n"
+        "  --seek-hostcall N      With --tape-in, output/trace start after N replayed hostcalls\n",
+        out);
+  fputs("\n"
+        "License: GPLv3+\n"
+        "© 2026 Frogfish — Author: Alexander Croft\n",
+        out);
 }
 
 static void sem_print_version(FILE* out) {
@@ -225,10 +273,36 @@ static int sem_do_check_one(const char* path, bool do_run, const sem_cap_t* caps
   return rc;
 }
 
-static int sem_do_check_dir(const char* dir, bool do_run, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root,
-                            sem_check_format_t check_format, sem_diag_format_t diag_format, bool diag_all, uint32_t* inout_ok,
-                            uint32_t* inout_fail) {
-  if (!dir || !inout_ok || !inout_fail) return 2;
+// Inputs of one `sem --check` invocation, in reporting order (argument order, then
+// readdir order within each directory). Paths are owned.
+typedef struct sem_check_list {
+  char** paths;
+  uint32_t len;
+  uint32_t cap;
+} sem_check_list_t;
+
+static bool sem_check_list_push(sem_check_list_t* l, const char* path) {
+  if (l->len == l->cap) {
+    const uint32_t ncap = l->cap ? l->cap * 2u : 64u;
+    char** np = (char**)realloc(l->paths, (size_t)ncap * sizeof(char*));
+    if (!np) return false;
+    l->paths = np;
+    l->cap = ncap;
+  }
+  char* dup = strdup(path);
+  if (!dup) return false;
+  l->paths[l->len++] = dup;
+  return true;
+}
+
+static void sem_check_list_free(sem_check_list_t* l) {
+  for (uint32_t i = 0; i < l->len; i++) free(l->paths[i]);
+  free(l->paths);
+  memset(l, 0, sizeof(*l));
+}
+
+static int sem_collect_check_dir(const char* dir, sem_check_list_t* out) {
+  if (!dir || !out) return 2;
   DIR* d = opendir(dir);
   if (!d) {
     fprintf(stderr, "sem: --check: failed to open dir: %s\n", dir);
@@ -250,16 +324,150 @@ static int sem_do_check_dir(const char* dir, bool do_run, const sem_cap_t* caps,
       return 2;
     }
     if (!sem_path_is_file(full)) continue;
+    if (!sem_check_list_push(out, full)) {
+      fprintf(stderr, "sem: --check: out of memory\n");
+      closedir(d);
+      return 2;
+    }
+  }
+
+  closedir(d);
+  return 0;
+}
+
+// `--check -j N`: workers claim cases in order and run each with its own context and
+// guest, buffering the case's guest output and diagnostics. The main thread replays the
+// buffers and emits results strictly in list order, so output matches `-j 1`.
+typedef struct sem_check_slot {
+  char* out_buf;
+  size_t out_len;
+  char* err_buf;
+  size_t err_len;
+  int tool_rc;
+  int prog_rc;
+  bool done;
+} sem_check_slot_t;
+
+typedef struct sem_check_pool {
+  const sem_check_list_t* list;
+  sem_check_slot_t* slots;
+  bool do_run;
+  const sem_cap_t* caps;
+  uint32_t cap_count;
+  const char* fs_root;
+  sem_diag_format_t diag_format;
+  bool diag_all;
+
+  pthread_mutex_t mu;
+  pthread_cond_t cv;
+  uint32_t next;
+} sem_check_pool_t;
+
+static void sem_check_run_slot(sem_check_pool_t* p, uint32_t i, FILE* devnull) {
+  sem_check_slot_t* s = &p->slots[i];
+  FILE* out = open_memstream(&s->out_buf, &s->out_len);
+  FILE* err = open_memstream(&s->err_buf, &s->err_len);
+  if (!out || !err) {
+    if (out) fclose(out);
+    if (err) fclose(err);
+    s->tool_rc = 2;
+    return;
+  }
+  // Cases never share the process stdin: a concurrent read would make results depend on scheduling.
+  const sem_run_io_t io = {.in = devnull, .out = out, .err = err};
+  s->tool_rc = sem_check_sir_jsonl_ex(p->list->paths[i], p->do_run, p->caps, p->cap_count, p->fs_root, p->diag_format, p->diag_all, io,
+                                      &s->prog_rc);
+  fclose(out);
+  fclose(err);
+}
+
+static void* sem_check_worker(void* user) {
+  sem_check_pool_t* p = (sem_check_pool_t*)user;
+  FILE* devnull = fopen("/dev/null", "rb");
+  for (;;) {
+    pthread_mutex_lock(&p->mu);
+    const uint32_t i = p->next;
+    if (i < p->list->len) p->next++;
+    pthread_mutex_unlock(&p->mu);
+    if (i >= p->list->len) break;
+
+    if (devnull) {
+      sem_check_run_slot(p, i, devnull);
+    } else {
+      p->slots[i].tool_rc = 2;
+    }
+
+    pthread_mutex_lock(&p->mu);
+    p->slots[i].done = true;
+    pthread_cond_broadcast(&p->cv);
+    pthread_mutex_unlock(&p->mu);
+  }
+  if (devnull) fclose(devnull);
+  return NULL;
+}
+
+static int sem_do_check_parallel(const sem_check_list_t* list, uint32_t jobs, bool do_run, const sem_cap_t* caps, uint32_t cap_count,
+                                 const char* fs_root, sem_check_format_t check_format, sem_diag_format_t diag_format, bool diag_all,
+                                 uint32_t* inout_ok, uint32_t* inout_fail) {
+  if (!list->len) return 0;
+  if (jobs > list->len) jobs = list->len;
+
+  sem_check_pool_t p;
+  memset(&p, 0, sizeof(p));
+  p.list = list;
+  p.do_run = do_run;
+  p.caps = caps;
+  p.cap_count = cap_count;
+  p.fs_root = fs_root;
+  p.diag_format = diag_format;
+  p.diag_all = diag_all;
+  p.slots = (sem_check_slot_t*)calloc(list->len, sizeof(sem_check_slot_t));
+  pthread_t* threads = (pthread_t*)calloc(jobs, sizeof(pthread_t));
+  if (!p.slots || !threads) {
+    free(p.slots);
+    free(threads);
+    fprintf(stderr, "sem: --check: out of memory\n");
+    return 2;
+  }
+  pthread_mutex_init(&p.mu, NULL);
+  pthread_cond_init(&p.cv, NULL);
 
-    const int rc = sem_do_check_one(full, do_run, caps, cap_count, fs_root, check_format, diag_format, diag_all);
-    if (rc == 0)
+  uint32_t started = 0;
+  for (; started < jobs; started++) {
+    if (pthread_create(&threads[started], NULL, sem_check_worker, &p) != 0) break;
+  }
+  int tool_rc = 0;
+  if (!started) {
+    fprintf(stderr, "sem: --check: failed to start workers\n");
+    tool_rc = 2;
+    p.next = list->len;
+  }
+
+  for (uint32_t i = 0; started && i < list->len; i++) {
+    sem_check_slot_t* s = &p.slots[i];
+    pthread_mutex_lock(&p.mu);
+    while (!s->done) pthread_cond_wait(&p.cv, &p.mu);
+    pthread_mutex_unlock(&p.mu);
+
+    if (s->out_len) fwrite(s->out_buf, 1, s->out_len, stdout);
+    if (s->err_len) fwrite(s->err_buf, 1, s->err_len, stderr);
+    free(s->out_buf);
+    free(s->err_buf);
+    s->out_buf = s->err_buf = NULL;
+
+    sem_emit_check_case(check_format, do_run ? "run" : "verify", list->paths[i], s->tool_rc == 0, s->tool_rc, s->prog_rc);
+    if (s->tool_rc == 0)
       (*inout_ok)++;
     else
       (*inout_fail)++;
   }
 
-  closedir(d);
-  return 0;
+  for (uint32_t t = 0; t < started; t++) pthread_join(threads[t], NULL);
+  pthread_cond_destroy(&p.cv);
+  pthread_mutex_destroy(&p.mu);
+  free(threads);
+  free(p.slots);
+  return tool_rc;
 }
 
 static void sem_print_support(FILE* out, bool json) {
@@ -547,7 +755,7 @@ static bool sem_parse_caps_list_payload(const uint8_t* payload, uint32_t payload
   return off == payload_len;
 }
 
-static int sem_do_caps(const sem_host_t* host, bool json, const char* tape_out, const char* tape_in,
+static int sem_do_caps(const sem_host_t* host, bool json, const char* tape_out, bool tape_compress, const char* tape_in,
                        bool tape_strict) {
   uint8_t req[ZCL1_HDR_SIZE];
   uint32_t req_len = 0;
@@ -572,7 +780,7 @@ static int sem_do_caps(const sem_host_t* host, bool json, const char* tape_out,
     rc = zi_ctl_replay(&ctx, req, req_len, resp, (uint32_t)sizeof(resp));
   } else {
     if (tape_out) {
-      tw = zi_tape_writer_open(tape_out);
+      tw = zi_tape_writer_open_ex(tape_out, (zi_tape_writer_opts_t){.compress = tape_compress});
       if (!tw) {
         fprintf(stderr, "sem: failed to open tape for record: %s\n", tape_out);
         return 1;
@@ -584,7 +792,10 @@ static int sem_do_caps(const sem_host_t* host, bool json, const char* tape_out,
     }
   }
 
-  if (tw) zi_tape_writer_close(tw);
+  if (tw && !zi_tape_writer_close(tw)) {
+    fprintf(stderr, "sem: failed to write tape: %s\n", tape_out);
+    return 1;
+  }
   if (tr) zi_tape_reader_close(tr);
 
   if (rc < 0) {
@@ -740,16 +951,9 @@ static int sem_do_cat(const sem_cap_t* caps, uint32_t cap_n, const char* fs_root
     return 1;
   }
 
-  const zi_ptr_t buf_ptr = sir_zi_alloc(&rt, 4096);
-  if (!buf_ptr) {
-    (void)sir_zi_end(&rt, h);
-    sir_hosted_zabi_dispose(&rt);
-    fprintf(stderr, "sem: alloc failed\n");
-    return 1;
-  }
-
+  // Host-side copy to guest stdout (handle 1); the bytes never pass through guest memory.
   for (;;) {
-    const int32_t n = sir_zi_read(&rt, h, buf_ptr, 4096);
+    const int32_t n = sir_zi_transfer(&rt, 1, h, 1u << 20);
     if (n < 0) {
       (void)sir_zi_end(&rt, h);
       sir_hosted_zabi_dispose(&rt);
@@ -757,14 +961,6 @@ static int sem_do_cat(const sem_cap_t* caps, uint32_t cap_n, const char* fs_root
       return 1;
     }
     if (n == 0) break;
-    const uint8_t* r = NULL;
-    if (!sem_guest_mem_map_ro(rt.mem, buf_ptr, (zi_size32_t)n, &r) || !r) {
-      (void)sir_zi_end(&rt, h);
-      sir_hosted_zabi_dispose(&rt);
-      fprintf(stderr, "sem: map failed\n");
-      return 1;
-    }
-    (void)fwrite(r, 1, (size_t)n, stdout);
   }
 
   (void)sir_zi_end(&rt, h);
@@ -903,9 +1099,8 @@ int main(int argc, char** argv) {
   bool sir_module_hello = false;
   const char* run_path = NULL;
   const char* verify_path = NULL;
-  const char* check_paths_buf[256];
-  const char** check_paths = NULL;
-  uint32_t check_path_count = 0;
+  sem_check_list_t check_args = {0};
+  uint32_t check_jobs = 1;
   bool check_mode = false;
   const char* list_paths_buf[256];
   const char** list_paths = NULL;
@@ -916,14 +1111,30 @@ int main(int argc, char** argv) {
   const char* tape_out = NULL;
   const char* tape_in = NULL;
   bool tape_strict = true;
+  bool tape_compress = false;
+  const char* checkpoint_out = NULL;
+  const char* checkpoint_in = NULL;
+  uint64_t checkpoint_every = 0;
+  sem_replay_seek_t seek = SEM_SEEK_NONE;
+  uint64_t seek_at = 0;
   bool check_run = false;
   sem_check_format_t check_format = SEM_CHECK_TEXT;
   sem_list_format_t list_format = SEM_LIST_TEXT;
   const char* format_opt = NULL;
   const char* trace_jsonl_out = NULL;
+  const char* trace_bin_out = NULL;
+  const char* trace_dump = NULL;
   const char* coverage_jsonl_out = NULL;
   const char* trace_func = NULL;
   const char* trace_op = NULL;
+  bool lazy = false;
+  bool serve = false;
+  const char* serve_socket = NULL;
+  const char* cache_dir = NULL;
+  const char* fuzz_path = NULL;
+  sem_fuzz_cfg_t fuzz_cfg = {0};
+  const char* bench_path = NULL;
+  sem_bench_cfg_t bench_cfg = {0};
 
   dyn_cap_t dyn_caps[64];
   uint32_t dyn_n = 0;
@@ -933,11 +1144,13 @@ int main(int argc, char** argv) {
     const char* a = argv[i];
     if (strcmp(a, "--help") == 0) {
       sem_print_help(stdout);
+      sem_check_list_free(&check_args);
       sem_free_caps(dyn_caps, dyn_n);
       return 0;
     }
     if (strcmp(a, "--version") == 0) {
       sem_print_version(stdout);
+      sem_check_list_free(&check_args);
       sem_free_caps(dyn_caps, dyn_n);
       return 0;
     }
@@ -958,6 +1171,23 @@ int main(int argc, char** argv) {
       check_mode = true;
       continue;
     }
+    if ((strcmp(a, "-j") == 0 || strcmp(a, "--jobs") == 0) && i + 1 < argc) {
+      const char* v = argv[++i];
+      char* end = NULL;
+      const unsigned long n = strtoul(v, &end, 10);
+      if (!v[0] || !end || *end != '\0' || n > 1024) {
+        fprintf(stderr, "sem: bad --jobs value: %s\n", v);
+        sem_check_list_free(&check_args);
+        sem_free_caps(dyn_caps, dyn_n);
+        return 2;
+      }
+      check_jobs = (uint32_t)n;
+      if (check_jobs == 0) {
+        const long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+        check_jobs = (ncpu > 0) ? (uint32_t)ncpu : 1u;
+      }
+      continue;
+    }
     if (strcmp(a, "--format") == 0 && i + 1 < argc) {
       format_opt = argv[++i];
       continue;
@@ -978,16 +1208,108 @@ int main(int argc, char** argv) {
       run_path = argv[++i];
       continue;
     }
+    if (strcmp(a, "--serve") == 0) {
+      serve = true;
+      continue;
+    }
+    if (strcmp(a, "--serve-socket") == 0 && i + 1 < argc) {
+      serve_socket = argv[++i];
+      continue;
+    }
+    if (strcmp(a, "--lazy") == 0) {
+      lazy = true;
+      continue;
+    }
+    if (strcmp(a, "--cache-dir") == 0 && i + 1 < argc) {
+      cache_dir = argv[++i];
+      continue;
+    }
     if (strcmp(a, "--verify") == 0 && i + 1 < argc) {
       verify_path = argv[++i];
       continue;
     }
+    if (strcmp(a, "--fuzz") == 0 && i + 1 < argc) {
+      fuzz_path = argv[++i];
+      continue;
+    }
+    if (strcmp(a, "--fuzz-corpus") == 0 && i + 1 < argc) {
+      fuzz_cfg.corpus_dir = argv[++i];
+      continue;
+    }
+    if (strcmp(a, "--fuzz-crash-dir") == 0 && i + 1 < argc) {
+      fuzz_cfg.crash_dir = argv[++i];
+      continue;
+    }
+    if ((strcmp(a, "--fuzz-iters") == 0 || strcmp(a, "--fuzz-len") == 0 || strcmp(a, "--fuzz-mutations") == 0 ||
+         strcmp(a, "--fuzz-seed") == 0 || strcmp(a, "--fuzz-max-steps") == 0) &&
+        i + 1 < argc) {
+      const char* v = argv[++i];
+      char* end = NULL;
+      const unsigned long long n = strtoull(v, &end, 10);
+      const bool is_u32 = strcmp(a, "--fuzz-len") == 0 || strcmp(a, "--fuzz-mutations") == 0;
+      if (!v[0] || v[0] == '-' || !end || *end != '\0' || n == 0 || (is_u32 && n > 0xFFFFFFFFull)) {
+        fprintf(stderr, "sem: bad %s value: %s\n", a, v);
+        sem_check_list_free(&check_args);
+        sem_free_caps(dyn_caps, dyn_n);
+        return 2;
+      }
+      if (strcmp(a, "--fuzz-iters") == 0) fuzz_cfg.iters = (uint64_t)n;
+      else if (strcmp(a, "--fuzz-len") == 0) fuzz_cfg.max_len = (uint32_t)n;
+      else if (strcmp(a, "--fuzz-mutations") == 0) fuzz_cfg.mutations = (uint32_t)n;
+      else if (strcmp(a, "--fuzz-seed") == 0) fuzz_cfg.seed = (uint64_t)n;
+      else fuzz_cfg.max_steps = (uint64_t)n;
+      continue;
+    }
+    if (strcmp(a, "--bench") == 0 && i + 2 < argc) {
+      const char* v = argv[++i];
+      char* end = NULL;
+      const unsigned long long n = strtoull(v, &end, 10);
+      if (!v[0] || v[0] == '-' || !end || *end != '\0' || n == 0 || n > 0xFFFFFFFFull) {
+        fprintf(stderr, "sem: bad --bench count: %s\n", v);
+        sem_check_list_free(&check_args);
+        sem_free_caps(dyn_caps, dyn_n);
+        return 2;
+      }
+      bench_cfg.iters = (uint32_t)n;
+      bench_path = argv[++i];
+      continue;
+    }
+    if ((strcmp(a, "--bench-max-insts") == 0 || strcmp(a, "--bench-max-host-allocs") == 0 || strcmp(a, "--bench-max-heap") == 0) &&
+        i + 1 < argc) {
+      const char* v = argv[++i];
+      char* end = NULL;
+      const unsigned long long n = strtoull(v, &end, 10);
+      if (!v[0] || v[0] == '-' || !end || *end != '\0' || n == 0) {
+        fprintf(stderr, "sem: bad %s value: %s\n", a, v);
+        sem_check_list_free(&check_args);
+        sem_free_caps(dyn_caps, dyn_n);
+        return 2;
+      }
+      if (strcmp(a, "--bench-max-insts") == 0) bench_cfg.max_insts = (uint64_t)n;
+      else if (strcmp(a, "--bench-max-host-allocs") == 0) bench_cfg.max_host_allocs = (uint64_t)n;
+      else bench_cfg.max_heap = (uint64_t)n;
+      continue;
+    }
+    if (strcmp(a, "--bench-max-ns-per-inst") == 0 && i + 1 < argc) {
+      const char* v = argv[++i];
+      char* end = NULL;
+      const double x = strtod(v, &end);
+      if (!v[0] || !end || *end != '\0' || !(x > 0)) {
+        fprintf(stderr, "sem: bad %s value: %s\n", a, v);
+        sem_check_list_free(&check_args);
+        sem_free_caps(dyn_caps, dyn_n);
+        return 2;
+      }
+      bench_cfg.max_ns_per_inst = x;
+      continue;
+    }
     if (strcmp(a, "--diagnostics") == 0 && i + 1 < argc) {
       const char* f = argv[++i];
       if (strcmp(f, "text") == 0) diag_format = SEM_DIAG_TEXT;
       else if (strcmp(f, "json") == 0) diag_format = SEM_DIAG_JSON;
       else {
         fprintf(stderr, "sem: bad --diagnostics value (expected text|json)\n");
+        sem_check_list_free(&check_args);
         sem_free_caps(dyn_caps, dyn_n);
         return 2;
       }
@@ -1017,14 +1339,52 @@ int main(int argc, char** argv) {
       tape_in = argv[++i];
       continue;
     }
+    if (strcmp(a, "--tape-compress") == 0) {
+      tape_compress = true;
+      continue;
+    }
     if (strcmp(a, "--tape-lax") == 0) {
       tape_strict = false;
       continue;
     }
+    if (strcmp(a, "--checkpoint-out") == 0 && i + 1 < argc) {
+      checkpoint_out = argv[++i];
+      continue;
+    }
+    if (strcmp(a, "--checkpoint-in") == 0 && i + 1 < argc) {
+      checkpoint_in = argv[++i];
+      continue;
+    }
+    if ((strcmp(a, "--checkpoint-every") == 0 || strcmp(a, "--seek-step") == 0 || strcmp(a, "--seek-hostcall") == 0) && i + 1 < argc) {
+      const char* v = argv[++i];
+      char* end = NULL;
+      const unsigned long long n = strtoull(v, &end, 10);
+      if (!v[0] || v[0] == '-' || !end || *end != '\0' || (n == 0 && strcmp(a, "--checkpoint-every") == 0)) {
+        fprintf(stderr, "sem: bad %s value: %s\n", a, v);
+        sem_check_list_free(&check_args);
+        sem_free_caps(dyn_caps, dyn_n);
+        return 2;
+      }
+      if (strcmp(a, "--checkpoint-every") == 0) {
+        checkpoint_every = (uint64_t)n;
+      } else {
+        seek = (strcmp(a, "--seek-step") == 0) ? SEM_SEEK_STEP : SEM_SEEK_HOSTCALL;
+        seek_at = (uint64_t)n;
+      }
+      continue;
+    }
     if (strcmp(a, "--trace-jsonl-out") == 0 && i + 1 < argc) {
       trace_jsonl_out = argv[++i];
       continue;
     }
+    if (strcmp(a, "--trace-bin-out") == 0 && i + 1 < argc) {
+      trace_bin_out = argv[++i];
+      continue;
+    }
+    if (strcmp(a, "--trace-dump") == 0 && i + 1 < argc) {
+      trace_dump = argv[++i];
+      continue;
+    }
     if (strcmp(a, "--coverage-jsonl-out") == 0 && i + 1 < argc) {
       coverage_jsonl_out = argv[++i];
       continue;
@@ -1040,6 +1400,7 @@ int main(int argc, char** argv) {
     if (strcmp(a, "--cap") == 0 && i + 1 < argc) {
       if (!sem_add_cap(dyn_caps, &dyn_n, (uint32_t)(sizeof(dyn_caps) / sizeof(dyn_caps[0])), argv[++i])) {
         fprintf(stderr, "sem: bad --cap spec\n");
+        sem_check_list_free(&check_args);
         sem_free_caps(dyn_caps, dyn_n);
         return 2;
       }
@@ -1048,6 +1409,7 @@ int main(int argc, char** argv) {
     if (strcmp(a, "--cap-file-fs") == 0) {
       if (!sem_add_cap(dyn_caps, &dyn_n, (uint32_t)(sizeof(dyn_caps) / sizeof(dyn_caps[0])), "file:fs:open,block")) {
         fprintf(stderr, "sem: failed to add cap\n");
+        sem_check_list_free(&check_args);
         sem_free_caps(dyn_caps, dyn_n);
         return 2;
       }
@@ -1057,6 +1419,7 @@ int main(int argc, char** argv) {
       if (!sem_add_cap(dyn_caps, &dyn_n, (uint32_t)(sizeof(dyn_caps) / sizeof(dyn_caps[0])),
                        "async:default:open,block")) {
         fprintf(stderr, "sem: failed to add cap\n");
+        sem_check_list_free(&check_args);
         sem_free_caps(dyn_caps, dyn_n);
         return 2;
       }
@@ -1065,6 +1428,7 @@ int main(int argc, char** argv) {
     if (strcmp(a, "--cap-sys-info") == 0) {
       if (!sem_add_cap(dyn_caps, &dyn_n, (uint32_t)(sizeof(dyn_caps) / sizeof(dyn_caps[0])), "sys:info:pure")) {
         fprintf(stderr, "sem: failed to add cap\n");
+        sem_check_list_free(&check_args);
         sem_free_caps(dyn_caps, dyn_n);
         return 2;
       }
@@ -1072,17 +1436,18 @@ int main(int argc, char** argv) {
     }
 
     if (check_mode && a[0] != '-') {
-      if (check_path_count >= (uint32_t)(sizeof(check_paths_buf) / sizeof(check_paths_buf[0]))) {
-        fprintf(stderr, "sem: --check: too many paths\n");
+      if (!sem_check_list_push(&check_args, a)) {
+        fprintf(stderr, "sem: --check: out of memory\n");
+        sem_check_list_free(&check_args);
         sem_free_caps(dyn_caps, dyn_n);
         return 2;
       }
-      check_paths_buf[check_path_count++] = a;
       continue;
     }
     if (list_mode && a[0] != '-') {
       if (list_path_count >= (uint32_t)(sizeof(list_paths_buf) / sizeof(list_paths_buf[0]))) {
         fprintf(stderr, "sem: --list: too many paths\n");
+        sem_check_list_free(&check_args);
         sem_free_caps(dyn_caps, dyn_n);
         return 2;
       }
@@ -1092,11 +1457,11 @@ int main(int argc, char** argv) {
 
     fprintf(stderr, "sem: unknown argument: %s\n", a);
     sem_print_help(stderr);
+    sem_check_list_free(&check_args);
     sem_free_caps(dyn_caps, dyn_n);
     return 2;
   }
 
-  if (check_path_count) check_paths = check_paths_buf;
   if (list_path_count) list_paths = list_paths_buf;
 
   if (format_opt && format_opt[0]) {
@@ -1108,6 +1473,7 @@ int main(int argc, char** argv) {
       list_format = SEM_LIST_JSON;
     } else {
       fprintf(stderr, "sem: bad --format value (expected text|json)\n");
+      sem_check_list_free(&check_args);
       sem_free_caps(dyn_caps, dyn_n);
       return 2;
     }
@@ -1115,34 +1481,41 @@ int main(int argc, char** argv) {
 
   if (want_support) {
     sem_print_support(stdout, json);
+    sem_check_list_free(&check_args);
     sem_free_caps(dyn_caps, dyn_n);
     return 0;
   }
 
-  if (run_path && verify_path) {
-    fprintf(stderr, "sem: choose either --run or --verify\n");
+  if ((run_path != NULL) + (verify_path != NULL) + (fuzz_path != NULL) + (bench_path != NULL) > 1) {
+    fprintf(stderr, "sem: choose one of --run, --verify, --fuzz or --bench\n");
+    sem_check_list_free(&check_args);
     sem_free_caps(dyn_caps, dyn_n);
     return 2;
   }
-  if (list_path_count && check_path_count) {
+  if (list_path_count && check_args.len) {
     fprintf(stderr, "sem: choose either --list or --check\n");
+    sem_check_list_free(&check_args);
     sem_free_caps(dyn_caps, dyn_n);
     return 2;
   }
 
-  if (check_mode && check_path_count == 0) {
+  if (check_mode && check_args.len == 0) {
     fprintf(stderr, "sem: --check: expected at least one file/dir path\n");
+    sem_check_list_free(&check_args);
     sem_free_caps(dyn_caps, dyn_n);
     return 2;
   }
   if (list_mode && list_path_count == 0) {
     fprintf(stderr, "sem: --list: expected at least one file/dir path\n");
+    sem_check_list_free(&check_args);
     sem_free_caps(dyn_caps, dyn_n);
     return 2;
   }
 
-  if (!want_caps && !cat_path && !sir_hello && !sir_module_hello && !run_path && !verify_path && !check_path_count && !list_path_count) {
+  if (!want_caps && !cat_path && !sir_hello && !sir_module_hello && !run_path && !verify_path && !fuzz_path && !bench_path &&
+      !check_args.len && !list_path_count && !serve && !serve_socket && !trace_dump) {
     sem_print_help(stdout);
+    sem_check_list_free(&check_args);
     sem_free_caps(dyn_caps, dyn_n);
     return 0;
   }
@@ -1151,6 +1524,7 @@ int main(int argc, char** argv) {
   if (fs_root && fs_root[0] != '\0' && !sem_has_cap(dyn_caps, dyn_n, "file", "fs")) {
     if (!sem_add_cap(dyn_caps, &dyn_n, (uint32_t)(sizeof(dyn_caps) / sizeof(dyn_caps[0])), "file:fs:open,block")) {
       fprintf(stderr, "sem: failed to add file/fs cap\n");
+      sem_check_list_free(&check_args);
       sem_free_caps(dyn_caps, dyn_n);
       return 2;
     }
@@ -1166,8 +1540,23 @@ int main(int argc, char** argv) {
     caps[i].meta_len = dyn_caps[i].meta_len;
   }
 
+  if (trace_dump) {
+    const int rc = sem_trace_bin_dump(trace_dump, stdout);
+    if (rc == 2) fprintf(stderr, "sem: --trace-dump: failed to open: %s\n", trace_dump);
+    if (rc == 1) fprintf(stderr, "sem: --trace-dump: malformed trace: %s\n", trace_dump);
+    sem_check_list_free(&check_args);
+    sem_free_caps(dyn_caps, dyn_n);
+    return rc;
+  }
+  if (serve || serve_socket) {
+    const int rc = serve_socket ? sem_serve_unix(serve_socket, caps, cap_n, fs_root) : sem_serve_stream(stdin, stdout, caps, cap_n, fs_root);
+    sem_check_list_free(&check_args);
+    sem_free_caps(dyn_caps, dyn_n);
+    return rc;
+  }
   if (cat_path) {
     const int rc = sem_do_cat(caps, cap_n, fs_root, cat_path);
+    sem_check_list_free(&check_args);
     sem_free_caps(dyn_caps, dyn_n);
     return rc;
   }
@@ -1179,63 +1568,151 @@ int main(int argc, char** argv) {
       const int rc = sem_do_list_one(p, list_format);
       if (rc != 0) tool_rc = rc;
     }
+    sem_check_list_free(&check_args);
     sem_free_caps(dyn_caps, dyn_n);
     return tool_rc;
   }
   if (sir_hello) {
+    sem_check_list_free(&check_args);
     sem_free_caps(dyn_caps, dyn_n);
     return sem_do_sir_hello();
   }
   if (sir_module_hello) {
+    sem_check_list_free(&check_args);
     sem_free_caps(dyn_caps, dyn_n);
     return sem_do_sir_module_hello();
   }
   if (run_path) {
     int rc = 0;
-    if ((trace_jsonl_out && trace_jsonl_out[0]) || (coverage_jsonl_out && coverage_jsonl_out[0])) {
+    const bool want_bin_trace = trace_bin_out && trace_bin_out[0];
+    const bool want_events = (trace_jsonl_out && trace_jsonl_out[0]) || want_bin_trace || (coverage_jsonl_out && coverage_jsonl_out[0]);
+    if (want_bin_trace && trace_jsonl_out && trace_jsonl_out[0]) {
+      fprintf(stderr, "sem: --trace-bin-out cannot be combined with --trace-jsonl-out\n");
+      sem_check_list_free(&check_args);
+      sem_free_caps(dyn_caps, dyn_n);
+      return 2;
+    }
+    if (lazy && want_events) {
+      fprintf(stderr, "sem: --lazy cannot be combined with --trace-jsonl-out/--trace-bin-out/--coverage-jsonl-out\n");
+      sem_check_list_free(&check_args);
+      sem_free_caps(dyn_caps, dyn_n);
+      return 2;
+    }
+    if (cache_dir && (lazy || want_events)) {
+      fprintf(stderr, "sem: --cache-dir cannot be combined with --lazy/--trace-jsonl-out/--trace-bin-out/--coverage-jsonl-out\n");
+      sem_check_list_free(&check_args);
+      sem_free_caps(dyn_caps, dyn_n);
+      return 2;
+    }
+    const bool want_replay = tape_out || tape_in;
+    if ((checkpoint_out && !tape_out) || ((checkpoint_in || seek != SEM_SEEK_NONE) && !tape_in) || (tape_out && tape_in)) {
+      fprintf(stderr, "sem: --checkpoint-out needs --tape-out; --checkpoint-in/--seek-* need --tape-in (not both tapes)\n");
+      sem_check_list_free(&check_args);
+      sem_free_caps(dyn_caps, dyn_n);
+      return 2;
+    }
+    if (want_replay && (lazy || cache_dir)) {
+      fprintf(stderr, "sem: --tape-out/--tape-in cannot be combined with --lazy/--cache-dir\n");
+      sem_check_list_free(&check_args);
+      sem_free_caps(dyn_caps, dyn_n);
+      return 2;
+    }
+    if (want_replay) {
+      const sem_replay_cfg_t replay = {.tape_out = tape_out,
+                                       .tape_compress = tape_compress,
+                                       .checkpoint_out = checkpoint_out,
+                                       .checkpoint_every = checkpoint_every,
+                                       .tape_in = tape_in,
+                                       .tape_strict = tape_strict,
+                                       .checkpoint_in = checkpoint_in,
+                                       .seek = seek,
+                                       .seek_at = seek_at};
+      rc = sem_run_sir_jsonl_replay_ex(run_path, caps, cap_n, fs_root, diag_format, diag_all, &replay,
+                                       want_bin_trace ? trace_bin_out : trace_jsonl_out, want_bin_trace, coverage_jsonl_out, trace_func, trace_op);
+    } else if (cache_dir) {
+      int prog_rc = 0;
+      rc = sem_run_sir_jsonl_cached_ex(run_path, cache_dir, caps, cap_n, fs_root, diag_format, diag_all, &prog_rc);
+      if (rc == 0) rc = prog_rc;
+    } else if (lazy) {
+      int prog_rc = 0;
+      rc = sem_run_sir_jsonl_lazy_ex(run_path, caps, cap_n, fs_root, diag_format, diag_all, &prog_rc);
+      if (rc == 0) rc = prog_rc;
+    } else if (want_bin_trace) {
+      rc = sem_run_sir_jsonl_events_bin_ex(run_path, caps, cap_n, fs_root, diag_format, diag_all, trace_bin_out, coverage_jsonl_out, trace_func,
+                                           trace_op);
+    } else if (want_events) {
       rc = sem_run_sir_jsonl_events_ex(run_path, caps, cap_n, fs_root, diag_format, diag_all, trace_jsonl_out, coverage_jsonl_out, trace_func, trace_op);
     } else {
       rc = sem_run_sir_jsonl_ex(run_path, caps, cap_n, fs_root, diag_format, diag_all);
     }
+    sem_check_list_free(&check_args);
+    sem_free_caps(dyn_caps, dyn_n);
+    return rc;
+  }
+  if (fuzz_path) {
+    const int rc = sem_fuzz_sir_jsonl(fuzz_path, caps, cap_n, fs_root, &fuzz_cfg, stderr, NULL);
+    sem_check_list_free(&check_args);
+    sem_free_caps(dyn_caps, dyn_n);
+    return rc;
+  }
+  if (bench_path) {
+    const int rc = sem_bench_sir_jsonl(bench_path, caps, cap_n, fs_root, &bench_cfg, stdout, stderr, NULL);
+    sem_check_list_free(&check_args);
     sem_free_caps(dyn_caps, dyn_n);
     return rc;
   }
   if (verify_path) {
     const int rc = sem_verify_sir_jsonl_ex(verify_path, diag_format, diag_all);
+    sem_check_list_free(&check_args);
     sem_free_caps(dyn_caps, dyn_n);
     return rc;
   }
-  if (check_path_count) {
+  if (check_args.len) {
     uint32_t ok = 0, fail = 0;
     int tool_rc = 0;
 
-    for (uint32_t i = 0; i < check_path_count; i++) {
-      const char* p = check_paths[i];
+    sem_check_list_t cases = {0};
+    for (uint32_t i = 0; i < check_args.len; i++) {
+      const char* p = check_args.paths[i];
       if (!p || p[0] == '\0') continue;
       if (sem_path_is_dir(p)) {
-        const int rc = sem_do_check_dir(p, check_run, caps, cap_n, fs_root, check_format, diag_format, diag_all, &ok, &fail);
+        const int rc = sem_collect_check_dir(p, &cases);
         if (rc != 0) tool_rc = rc;
       } else if (sem_path_is_file(p)) {
         if (!sem_is_sir_jsonl_path(p)) {
           fprintf(stderr, "sem: --check: skipping non-.sir.jsonl file: %s\n", p);
           continue;
         }
-        const int rc = sem_do_check_one(p, check_run, caps, cap_n, fs_root, check_format, diag_format, diag_all);
+        if (!sem_check_list_push(&cases, p)) {
+          fprintf(stderr, "sem: --check: out of memory\n");
+          tool_rc = 2;
+        }
+      } else {
+        fprintf(stderr, "sem: --check: not a file/dir: %s\n", p);
+        tool_rc = 2;
+      }
+    }
+
+    if (check_jobs > 1) {
+      const int rc = sem_do_check_parallel(&cases, check_jobs, check_run, caps, cap_n, fs_root, check_format, diag_format, diag_all, &ok, &fail);
+      if (rc != 0) tool_rc = rc;
+    } else {
+      for (uint32_t i = 0; i < cases.len; i++) {
+        const int rc = sem_do_check_one(cases.paths[i], check_run, caps, cap_n, fs_root, check_format, diag_format, diag_all);
         if (rc == 0)
           ok++;
         else
           fail++;
-      } else {
-        fprintf(stderr, "sem: --check: not a file/dir: %s\n", p);
-        tool_rc = 2;
       }
     }
+    sem_check_list_free(&cases);
 
     if (check_format == SEM_CHECK_JSON) {
       fprintf(stderr, "{\"tool\":\"sem\",\"k\":\"check_summary\",\"ok\":%u,\"fail\":%u}\n", (unsigned)ok, (unsigned)fail);
     } else {
       fprintf(stdout, "sem: --check: ok=%u fail=%u\n", (unsigned)ok, (unsigned)fail);
     }
+    sem_check_list_free(&check_args);
     sem_free_caps(dyn_caps, dyn_n);
     if (tool_rc != 0) return tool_rc;
     return (fail == 0) ? 0 : 1;
@@ -1244,7 +1721,8 @@ int main(int argc, char** argv) {
   sem_host_t host;
   sem_host_init(&host, (sem_host_cfg_t){.caps = caps, .cap_count = cap_n});
 
-  const int rc = sem_do_caps(&host, json, tape_out, tape_in, tape_strict);
+  const int rc = sem_do_caps(&host, json, tape_out, tape_compress, tape_in, tape_strict);
+  sem_check_list_free(&check_args);
   sem_free_caps(dyn_caps, dyn_n);
   return rc;
 }
@@ -0,0 +1,220 @@
+#include "sem_bench.h"
+
+#include "hosted_zabi.h"
+#include "sem_hosted.h"
+#include "sir_jsonl.h"
+#include "sir_module.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef SIR_VERSION
+#define SIR_VERSION "0.0.0"
+#endif
+
+#define SEM_BENCH_GUEST_MEM (16u * 1024u * 1024u)
+#define SEM_BENCH_TRAP_EXIT 255 // exit code of term.trap and the other deterministic traps
+
+// A run that failed (negative ZI_E_*) or trapped does not measure the program.
+static bool bench_run_failed(int32_t rc) {
+  return rc < 0 || rc == SEM_BENCH_TRAP_EXIT;
+}
+
+static uint64_t bench_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static bool bench_hash_file(const char* path, uint64_t* out_hash, uint64_t* out_len) {
+  FILE* f = fopen(path, "rb");
+  if (!f) return false;
+  uint64_t h = 1469598103934665603ull;
+  uint64_t len = 0;
+  uint8_t buf[64 * 1024];
+  size_t n = 0;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+    for (size_t i = 0; i < n; i++) h = (h ^ buf[i]) * 1099511628211ull;
+    len += n;
+  }
+  const bool ok = !ferror(f);
+  fclose(f);
+  *out_hash = h;
+  *out_len = len;
+  return ok;
+}
+
+static int bench_cmp_u64(const void* a, const void* b) {
+  const uint64_t x = *(const uint64_t*)a;
+  const uint64_t y = *(const uint64_t*)b;
+  return (x > y) - (x < y);
+}
+
+static void bench_json_str(FILE* out, const char* s) {
+  fputc('"', out);
+  for (const char* p = s; p && *p; p++) {
+    const unsigned char ch = (unsigned char)*p;
+    if (ch == '\\' || ch == '"') {
+      fputc('\\', out);
+      fputc((int)ch, out);
+    } else if (ch >= 0x20) {
+      fputc((int)ch, out);
+    }
+  }
+  fputc('"', out);
+}
+
+static bool bench_check(FILE* log, const char* path, const char* what, uint64_t got, uint64_t limit) {
+  if (!limit || got <= limit) return true;
+  if (log) fprintf(log, "sem: bench: %s: %s %" PRIu64 " exceeds limit %" PRIu64 "\n", path, what, got, limit);
+  return false;
+}
+
+static void bench_emit(FILE* out, const char* path, const sem_bench_cfg_t* cfg, uint32_t iters, const sem_bench_report_t* r) {
+  fprintf(out, "{\"k\":\"opt_report\",\"tool\":\"sem\",\"mode\":\"bench\",\"version\":\"%s\",\"input\":", SIR_VERSION);
+  bench_json_str(out, path);
+  fprintf(out, ",\"input_hash\":\"%016" PRIx64 "\",\"iters\":%u,\"rc\":%d", r->input_hash, (unsigned)iters, (int)r->rc);
+  if (r->rc < 0) fprintf(out, ",\"rc_name\":\"%s\"", sem_exec_rc_name(r->rc));
+  else if (r->rc == SEM_BENCH_TRAP_EXIT) fprintf(out, ",\"rc_name\":\"trap\"");
+  fprintf(out,
+          ",\"timings\":{\"load_ns\":%" PRIu64 ",\"validate_ns\":%" PRIu64 ",\"run_ns_min\":%" PRIu64 ",\"run_ns_median\":%" PRIu64
+          ",\"run_ns_total\":%" PRIu64 ",\"ns_per_inst\":%.3f}",
+          r->load_ns, r->validate_ns, r->run_ns_min, r->run_ns_median, r->run_ns_total, r->ns_per_inst);
+  fprintf(out,
+          ",\"sizes\":{\"input_bytes\":%" PRIu64 ",\"funcs\":%u,\"insts\":%" PRIu64 ",\"insts_retired\":%" PRIu64 ",\"host_allocs\":%" PRIu64
+          ",\"host_alloc_bytes\":%" PRIu64 ",\"max_frames\":%u,\"guest_heap_hw\":%u}",
+          r->input_bytes, (unsigned)r->funcs, r->insts, r->insts_retired, r->host_allocs, r->host_alloc_bytes, (unsigned)r->max_frames,
+          (unsigned)r->guest_heap_hw);
+  fprintf(out, ",\"limits\":{");
+  bool any = false;
+  if (cfg->max_insts) {
+    fprintf(out, "\"max_insts\":%" PRIu64, cfg->max_insts);
+    any = true;
+  }
+  if (cfg->max_host_allocs) {
+    fprintf(out, "%s\"max_host_allocs\":%" PRIu64, any ? "," : "", cfg->max_host_allocs);
+    any = true;
+  }
+  if (cfg->max_heap) {
+    fprintf(out, "%s\"max_heap\":%" PRIu64, any ? "," : "", cfg->max_heap);
+    any = true;
+  }
+  if (cfg->max_ns_per_inst > 0) {
+    fprintf(out, "%s\"max_ns_per_inst\":%.3f", any ? "," : "", cfg->max_ns_per_inst);
+    any = true;
+  }
+  fprintf(out, "%s\"ok\":%s}}\n", any ? "," : "", r->limits_ok ? "true" : "false");
+}
+
+int sem_bench_sir_jsonl(const char* path, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root, const sem_bench_cfg_t* cfg,
+                        FILE* out, FILE* log, sem_bench_report_t* out_report) {
+  if (!path || !cfg) return 2;
+  if (out_report) memset(out_report, 0, sizeof(*out_report));
+  const uint32_t iters = cfg->iters ? cfg->iters : 10u;
+
+  sem_bench_report_t r;
+  memset(&r, 0, sizeof(r));
+  if (!bench_hash_file(path, &r.input_hash, &r.input_bytes)) {
+    if (log) fprintf(log, "sem: bench: %s: cannot read file\n", path);
+    return 2;
+  }
+
+  sem_load_err_t err;
+  const uint64_t t_load = bench_now_ns();
+  sem_module_t* sm = sem_module_load_sir_jsonl(path, &err);
+  r.load_ns = bench_now_ns() - t_load;
+  if (!sm) {
+    if (log) fprintf(log, "sem: bench: %s: %s: %s\n", path, err.code, err.message);
+    return 2;
+  }
+  const sir_module_t* m = sem_module_ir(sm);
+  r.funcs = m->func_count;
+  for (uint32_t i = 0; i < m->func_count; i++) r.insts += m->funcs[i].inst_count;
+  char verr[160];
+  const uint64_t t_validate = bench_now_ns();
+  const bool valid = sir_module_validate(m, verr, sizeof(verr));
+  r.validate_ns = bench_now_ns() - t_validate;
+  if (!valid) {
+    if (log) fprintf(log, "sem: bench: %s: invalid module: %s\n", path, verr);
+    sem_module_release(sm);
+    return 2;
+  }
+
+  sem_guest_mem_t mem;
+  memset(&mem, 0, sizeof(mem));
+  uint64_t* run_ns = (uint64_t*)calloc(iters, sizeof(*run_ns));
+  FILE* null_in = fopen("/dev/null", "rb");
+  FILE* null_out = fopen("/dev/null", "wb");
+  if (!run_ns || !null_in || !null_out || !sem_guest_mem_init(&mem, SEM_BENCH_GUEST_MEM, 0x10000ull)) {
+    if (log) fprintf(log, "sem: bench: failed to set up\n");
+    free(run_ns);
+    if (null_in) fclose(null_in);
+    if (null_out) fclose(null_out);
+    if (mem.buf) sem_guest_mem_dispose(&mem);
+    sem_module_release(sm);
+    return 2;
+  }
+
+  int tool_rc = 0;
+  for (uint32_t it = 0; it < iters; it++) {
+    sem_guest_mem_reset(&mem);
+    rewind(null_in);
+    sir_hosted_zabi_t hz;
+    if (!sir_hosted_zabi_init_with_mem(&hz, &mem, (sir_hosted_zabi_cfg_t){.abi_version = 0x00020005u,
+                                                                       .caps = caps,
+                                                                       .cap_count = cap_count,
+                                                                       .fs_root = fs_root,
+                                                                       .stdin_f = null_in,
+                                                                       .stdout_f = null_out,
+                                                                       .stderr_f = null_out,
+                                                                       .stdout_buffering = SIR_STDIO_BUF_FULL})) {
+      if (log) fprintf(log, "sem: bench: failed to init hosted runtime\n");
+      tool_rc = 2;
+      break;
+    }
+    sir_exec_stats_t st;
+    const uint64_t t0 = bench_now_ns();
+    // Validated above, so the timed region is execution only.
+    const int32_t rc = sir_module_run_validated(m, &mem, sem_hosted_make_host(&hz), NULL, cfg->max_steps, &st);
+    run_ns[it] = bench_now_ns() - t0;
+    if (it == 0 || !bench_run_failed(r.rc)) r.rc = rc; // keep the first failure
+    sir_hosted_zabi_dispose(&hz);
+
+    r.run_ns_total += run_ns[it];
+    if (st.steps > r.insts_retired) r.insts_retired = st.steps;
+    if (st.host_allocs > r.host_allocs) r.host_allocs = st.host_allocs;
+    if (st.host_alloc_bytes > r.host_alloc_bytes) r.host_alloc_bytes = st.host_alloc_bytes;
+    if (st.max_frames > r.max_frames) r.max_frames = st.max_frames;
+    if (mem.brk > r.guest_heap_hw) r.guest_heap_hw = mem.brk;
+  }
+
+  if (tool_rc == 0) {
+    qsort(run_ns, iters, sizeof(*run_ns), bench_cmp_u64);
+    r.run_ns_min = run_ns[0];
+    r.run_ns_median = run_ns[iters / 2u];
+    r.ns_per_inst = r.insts_retired ? (double)r.run_ns_median / (double)r.insts_retired : 0.0;
+
+    r.limits_ok = true;
+    r.limits_ok &= bench_check(log, path, "insts_retired", r.insts_retired, cfg->max_insts);
+    r.limits_ok &= bench_check(log, path, "host_allocs", r.host_allocs, cfg->max_host_allocs);
+    r.limits_ok &= bench_check(log, path, "guest_heap_hw", r.guest_heap_hw, cfg->max_heap);
+    if (cfg->max_ns_per_inst > 0 && r.ns_per_inst > cfg->max_ns_per_inst) {
+      if (log) fprintf(log, "sem: bench: %s: ns_per_inst %.3f exceeds limit %.3f\n", path, r.ns_per_inst, cfg->max_ns_per_inst);
+      r.limits_ok = false;
+    }
+    if (r.rc < 0 && log) fprintf(log, "sem: bench: %s: execution failed: %s (%d)\n", path, sem_exec_rc_name(r.rc), (int)r.rc);
+    if (r.rc == SEM_BENCH_TRAP_EXIT && log) fprintf(log, "sem: bench: %s: execution trapped (exit %d)\n", path, (int)r.rc);
+    if (out) bench_emit(out, path, cfg, iters, &r);
+  }
+
+  free(run_ns);
+  fclose(null_in);
+  fclose(null_out);
+  sem_guest_mem_dispose(&mem);
+  sem_module_release(sm);
+  if (out_report) *out_report = r;
+  if (tool_rc) return tool_rc;
+  return (bench_run_failed(r.rc) || !r.limits_ok) ? 1 : 0;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "sem_host.h"
+
+// `sem --bench N`: measure a module on a prepared instance.
+//
+// The module is parsed, lowered and validated once (timed as `load_ns`; the validator
+// alone is timed again as `validate_ns`), then run N times, each on a reset guest arena
+// with stdin at EOF and stdout/stderr discarded. The result is one `k:opt_report` JSONL
+// record (see TODO.md §0):
+//
+//   {"k":"opt_report","tool":"sem","mode":"bench","version":...,"input":...,"input_hash":...,
+//    "iters":N,"rc":...,"timings":{...},"sizes":{...},"limits":{...,"ok":true}}
+//
+// Instruction, allocation and heap counts are deterministic for a given module and
+// input, so they make tight regression thresholds; `ns_per_inst` is the median run time
+// over instructions retired and needs a generous one.
+
+typedef struct sem_bench_cfg {
+  uint32_t iters;     // runs (0 = 10)
+  uint64_t max_steps; // per-run instruction budget (0 = no limit)
+
+  // Regression thresholds (0 = unchecked). Exceeding any of them fails the bench.
+  uint64_t max_insts;       // instructions retired per run
+  uint64_t max_host_allocs; // executor host allocations per run
+  uint64_t max_heap;        // guest heap high-water mark, bytes
+  double max_ns_per_inst;
+} sem_bench_cfg_t;
+
+typedef struct sem_bench_report {
+  int32_t rc;           // first failed run's result, else the last run's exit code
+  uint64_t input_hash;  // FNV-1a of the input bytes
+  uint64_t input_bytes;
+  uint32_t funcs;
+  uint64_t insts;       // lowered instructions in the module
+  uint64_t load_ns;
+  uint64_t validate_ns;
+  uint64_t run_ns_min;
+  uint64_t run_ns_median;
+  uint64_t run_ns_total;
+  uint64_t insts_retired; // per run (max over runs)
+  uint64_t host_allocs;   // per run (max over runs)
+  uint64_t host_alloc_bytes;
+  uint32_t max_frames;
+  uint32_t guest_heap_hw; // bytes
+  double ns_per_inst;
+  bool limits_ok;
+} sem_bench_report_t;
+
+// Benchmarks `path`, writes the report record to `out` (NULL: none) and one line per
+// exceeded threshold to `log` (NULL: quiet). Returns 0 when every run exited normally
+// and every threshold held, 1 when a run failed, trapped (exit 255) or a threshold was
+// exceeded, 2 on tool errors (including a module that fails to load or validate).
+int sem_bench_sir_jsonl(const char* path, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root, const sem_bench_cfg_t* cfg,
+                        FILE* out, FILE* log, sem_bench_report_t* out_report);
@@ -0,0 +1,475 @@
+#include "sem_fuzz.h"
+
+#include "hosted_zabi.h"
+#include "sem_hosted.h"
+#include "sir_jsonl.h"
+#include "sir_module.h"
+
+#include <dirent.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <sys/stat.h>
+
+#define SEM_FUZZ_MAP_SIZE (1u << 16)
+#define SEM_FUZZ_GUEST_MEM (16u * 1024u * 1024u)
+#define SEM_FUZZ_TRAP_EXIT 255 // exit code of term.trap and the other deterministic traps
+
+typedef struct fuzz_input {
+  uint8_t* data;
+  uint32_t len;
+} fuzz_input_t;
+
+typedef struct fuzz_cov {
+  uint8_t* hits; // per edge slot for the current run (saturating)
+  uint64_t steps;
+  uint32_t prev; // location of the previous block, shifted (so A->B != B->A)
+  sir_func_id_t last_fid;
+  uint32_t last_ip;
+} fuzz_cov_t;
+
+typedef struct fuzz_crash {
+  int32_t rc;
+  sir_func_id_t fid;
+  uint32_t ip;
+} fuzz_crash_t;
+
+typedef struct fuzz {
+  const sem_fuzz_cfg_t* cfg;
+  const sir_module_t* m;
+  const sem_cap_t* caps;
+  uint32_t cap_count;
+  const char* fs_root;
+  const char* path;
+  FILE* log;
+
+  sem_guest_mem_t mem;
+  FILE* null_in;  // stdin for empty inputs
+  FILE* null_out; // guest stdout/stderr
+  fuzz_cov_t cov;
+  uint8_t* virgin; // hit-count buckets seen so far, per edge slot
+  uint64_t rng;
+
+  fuzz_input_t* corpus;
+  uint32_t corpus_len;
+  uint32_t corpus_cap;
+  fuzz_crash_t* crashes;
+  uint32_t crash_len;
+  uint32_t crash_cap;
+  sem_fuzz_stats_t stats;
+} fuzz_t;
+
+static uint64_t fuzz_rand(fuzz_t* f) {
+  // xorshift64*
+  uint64_t x = f->rng;
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  f->rng = x;
+  return x * 0x2545F4914F6CDD1Dull;
+}
+
+static uint32_t fuzz_below(fuzz_t* f, uint32_t n) {
+  return n ? (uint32_t)(fuzz_rand(f) % n) : 0u;
+}
+
+static uint64_t fuzz_fnv1a(const uint8_t* p, uint32_t n) {
+  uint64_t h = 1469598103934665603ull;
+  for (uint32_t i = 0; i < n; i++) {
+    h ^= p[i];
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+static uint32_t fuzz_loc(sir_func_id_t fid, uint32_t ip) {
+  uint32_t h = (uint32_t)fid * 0x9E3779B1u ^ ip * 0x85EBCA6Bu;
+  h ^= h >> 15;
+  h *= 0x2C1B3C6Du;
+  h ^= h >> 12;
+  return h;
+}
+
+static void fuzz_on_step(void* user, const sir_module_t* m, sir_func_id_t fid, uint32_t ip, sir_inst_kind_t k) {
+  (void)m;
+  (void)k;
+  fuzz_cov_t* c = (fuzz_cov_t*)user;
+  c->steps++;
+  if (fid != c->last_fid || ip != c->last_ip + 1u) {
+    const uint32_t cur = fuzz_loc(fid, ip);
+    uint8_t* slot = &c->hits[(cur ^ c->prev) & (SEM_FUZZ_MAP_SIZE - 1u)];
+    if (*slot != 0xFF) (*slot)++;
+    c->prev = cur >> 1;
+  }
+  c->last_fid = fid;
+  c->last_ip = ip;
+}
+
+static uint8_t fuzz_bucket(uint8_t n) {
+  if (n <= 2) return n;
+  if (n == 3) return 4;
+  if (n <= 7) return 8;
+  if (n <= 15) return 16;
+  if (n <= 31) return 32;
+  if (n <= 127) return 64;
+  return 128;
+}
+
+// Folds this run's hits into `virgin`; true when anything new showed up.
+static bool fuzz_merge_coverage(fuzz_t* f) {
+  bool fresh = false;
+  const uint8_t* hits = f->cov.hits;
+  for (uint32_t w = 0; w < SEM_FUZZ_MAP_SIZE; w += 8) {
+    uint64_t word = 0;
+    memcpy(&word, hits + w, sizeof(word));
+    if (!word) continue;
+    for (uint32_t i = w; i < w + 8; i++) {
+      if (!hits[i]) continue;
+      const uint8_t b = fuzz_bucket(hits[i]);
+      if ((b & ~f->virgin[i]) == 0) continue;
+      if (!f->virgin[i]) f->stats.edges++;
+      f->virgin[i] |= b;
+      fresh = true;
+    }
+  }
+  return fresh;
+}
+
+static int32_t fuzz_exec(fuzz_t* f, const uint8_t* data, uint32_t len) {
+  sem_guest_mem_reset(&f->mem);
+  memset(f->cov.hits, 0, SEM_FUZZ_MAP_SIZE);
+  f->cov.steps = 0;
+  f->cov.prev = 0;
+  f->cov.last_fid = 0;
+  f->cov.last_ip = 0;
+
+  // fmemopen rejects zero-sized buffers on some libcs; an empty stdin is /dev/null.
+  FILE* in = len ? fmemopen((void*)data, len, "rb") : f->null_in;
+  if (!in) return SEM_ZI_E_INTERNAL;
+  sir_hosted_zabi_t hz;
+  if (!sir_hosted_zabi_init_with_mem(&hz, &f->mem, (sir_hosted_zabi_cfg_t){.abi_version = 0x00020005u,
+                                                                         .caps = f->caps,
+                                                                         .cap_count = f->cap_count,
+                                                                         .fs_root = f->fs_root,
+                                                                         .stdin_f = in,
+                                                                         .stdout_f = f->null_out,
+                                                                         .stderr_f = f->null_out,
+                                                                         .stdout_buffering = SIR_STDIO_BUF_FULL})) {
+    if (len) fclose(in);
+    return SEM_ZI_E_INTERNAL;
+  }
+  const sir_exec_event_sink_t sink = {.user = &f->cov, .on_step = fuzz_on_step};
+  const uint64_t max_steps = f->cfg->max_steps ? f->cfg->max_steps : 1000000u;
+  const int32_t rc = sir_module_run_validated(f->m, &f->mem, sem_hosted_make_host(&hz), &sink, max_steps, NULL);
+  sir_hosted_zabi_dispose(&hz);
+  if (len) fclose(in);
+  f->stats.execs++;
+  return rc;
+}
+
+static bool fuzz_corpus_add(fuzz_t* f, const uint8_t* data, uint32_t len) {
+  if (f->corpus_len == f->corpus_cap) {
+    const uint32_t cap = f->corpus_cap ? f->corpus_cap * 2u : 64u;
+    fuzz_input_t* grown = (fuzz_input_t*)realloc(f->corpus, (size_t)cap * sizeof(*grown));
+    if (!grown) return false;
+    f->corpus = grown;
+    f->corpus_cap = cap;
+  }
+  uint8_t* copy = (uint8_t*)malloc(len ? len : 1u);
+  if (!copy) return false;
+  if (len) memcpy(copy, data, len);
+  f->corpus[f->corpus_len++] = (fuzz_input_t){.data = copy, .len = len};
+  f->stats.corpus = f->corpus_len;
+  return true;
+}
+
+// Writes `data` to dir/<prefix><key> unless it is already there (path in `out_path`).
+static bool fuzz_save(const char* dir, const char* prefix, uint64_t key, const uint8_t* data, uint32_t len, char* out_path, size_t out_cap) {
+  if (!dir || !dir[0]) return false;
+  snprintf(out_path, out_cap, "%s/%s%016" PRIx64, dir, prefix, key);
+  struct stat st;
+  if (stat(out_path, &st) == 0) return true;
+  FILE* fp = fopen(out_path, "wb");
+  if (!fp) return false;
+  const bool ok = fwrite(data, 1, len, fp) == len;
+  return fclose(fp) == 0 && ok;
+}
+
+static int fuzz_name_cmp(const void* a, const void* b) {
+  return strcmp(*(const char* const*)a, *(const char* const*)b);
+}
+
+// Loads regular files from the corpus dir in name order (readdir order is arbitrary).
+static bool fuzz_load_seeds(fuzz_t* f) {
+  const char* dir = f->cfg->corpus_dir;
+  if (!dir || !dir[0]) return true;
+  DIR* d = opendir(dir);
+  if (!d) return false;
+  char** names = NULL;
+  uint32_t n = 0, cap = 0;
+  bool ok = true;
+  struct dirent* ent = NULL;
+  while (ok && (ent = readdir(d)) != NULL) {
+    if (ent->d_name[0] == '.') continue;
+    if (n == cap) {
+      cap = cap ? cap * 2u : 32u;
+      char** grown = (char**)realloc(names, (size_t)cap * sizeof(*grown));
+      if (!grown) {
+        ok = false;
+        break;
+      }
+      names = grown;
+    }
+    names[n] = strdup(ent->d_name);
+    if (!names[n]) ok = false;
+    else n++;
+  }
+  closedir(d);
+  if (n) qsort(names, n, sizeof(*names), fuzz_name_cmp);
+
+  const uint32_t max_len = f->cfg->max_len ? f->cfg->max_len : 64u;
+  uint8_t* buf = (uint8_t*)malloc(max_len);
+  if (!buf) ok = false;
+  for (uint32_t i = 0; ok && i < n; i++) {
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/%s", dir, names[i]);
+    struct stat st;
+    if (stat(path, &st) != 0 || !S_ISREG(st.st_mode)) continue;
+    FILE* fp = fopen(path, "rb");
+    if (!fp) continue;
+    const size_t got = fread(buf, 1, max_len, fp);
+    fclose(fp);
+    ok = fuzz_corpus_add(f, buf, (uint32_t)got);
+  }
+  free(buf);
+  for (uint32_t i = 0; i < n; i++) free(names[i]);
+  free(names);
+  return ok;
+}
+
+static uint32_t fuzz_mutate(fuzz_t* f, uint8_t* buf, uint32_t len, uint32_t max_len) {
+  static const uint8_t interesting[] = {0x00, 0x01, 0x7F, 0x80, 0xFF, '\n', ' ', '0', 'A', 'a'};
+  switch (fuzz_below(f, 8)) {
+    case 0: // flip a bit
+      if (!len) break;
+      buf[fuzz_below(f, len)] ^= (uint8_t)(1u << fuzz_below(f, 8));
+      return len;
+    case 1: // random byte
+      if (!len) break;
+      buf[fuzz_below(f, len)] = (uint8_t)fuzz_rand(f);
+      return len;
+    case 2: // interesting byte
+      if (!len) break;
+      buf[fuzz_below(f, len)] = interesting[fuzz_below(f, (uint32_t)sizeof(interesting))];
+      return len;
+    case 3: { // small add/sub
+      if (!len) break;
+      const uint32_t at = fuzz_below(f, len);
+      const uint8_t delta = (uint8_t)(1u + fuzz_below(f, 16));
+      buf[at] = (uint8_t)(fuzz_below(f, 2) ? buf[at] + delta : buf[at] - delta);
+      return len;
+    }
+    case 4: { // delete a byte
+      if (!len) break;
+      const uint32_t at = fuzz_below(f, len);
+      memmove(buf + at, buf + at + 1, len - at - 1u);
+      return len - 1u;
+    }
+    case 5: { // copy a chunk within the input
+      if (len < 2) break;
+      const uint32_t n = 1u + fuzz_below(f, len / 2u);
+      const uint32_t from = fuzz_below(f, len - n + 1u);
+      const uint32_t to = fuzz_below(f, len - n + 1u);
+      memmove(buf + to, buf + from, n);
+      return len;
+    }
+    case 6: { // splice in the tail of another corpus entry
+      const fuzz_input_t* o = &f->corpus[fuzz_below(f, f->corpus_len)];
+      if (!o->len) break;
+      const uint32_t at = fuzz_below(f, len + 1u);
+      const uint32_t from = fuzz_below(f, o->len);
+      uint32_t n = o->len - from;
+      if (at + n > max_len) n = max_len - at;
+      memcpy(buf + at, o->data + from, n);
+      return at + n > len ? at + n : len;
+    }
+    default:
+      break;
+  }
+  // Insert a byte (also the fallback for empty inputs).
+  if (len >= max_len) return len;
+  const uint32_t at = fuzz_below(f, len + 1u);
+  memmove(buf + at + 1, buf + at, len - at);
+  buf[at] = (uint8_t)fuzz_rand(f);
+  return len + 1u;
+}
+
+static bool fuzz_seen_crash(fuzz_t* f, fuzz_crash_t c) {
+  for (uint32_t i = 0; i < f->crash_len; i++) {
+    if (f->crashes[i].rc == c.rc && f->crashes[i].fid == c.fid && f->crashes[i].ip == c.ip) return true;
+  }
+  if (f->crash_len == f->crash_cap) {
+    const uint32_t cap = f->crash_cap ? f->crash_cap * 2u : 16u;
+    fuzz_crash_t* grown = (fuzz_crash_t*)realloc(f->crashes, (size_t)cap * sizeof(*grown));
+    if (!grown) return true; // cannot track it: treat as seen
+    f->crashes = grown;
+    f->crash_cap = cap;
+  }
+  f->crashes[f->crash_len++] = c;
+  return false;
+}
+
+// Traps end the run with exit 255; the instruction that ended it tells a trap apart from a
+// guest that chose to exit 255 (term.exit_val).
+static bool fuzz_trapped(const fuzz_t* f, int32_t rc) {
+  const sir_func_id_t fid = f->cov.last_fid;
+  if (rc != SEM_FUZZ_TRAP_EXIT || fid == 0 || fid > f->m->func_count) return false;
+  const sir_func_t* fn = &f->m->funcs[fid - 1];
+  if (f->cov.last_ip >= fn->inst_count) return false;
+  const sir_inst_t* i = &fn->insts[f->cov.last_ip];
+  return (i->k == SIR_INST_EXIT && i->u.exit_.code == SEM_FUZZ_TRAP_EXIT) || i->k == SIR_INST_I32_DIV_S_TRAP ||
+         i->k == SIR_INST_MEM_COPY;
+}
+
+// Classifies one finished execution; keeps the input when it found something new.
+static void fuzz_triage(fuzz_t* f, const uint8_t* data, uint32_t len, int32_t rc) {
+  const uint64_t max_steps = f->cfg->max_steps ? f->cfg->max_steps : 1000000u;
+  const bool fresh = fuzz_merge_coverage(f);
+  char path[4096];
+  if (rc < 0 && f->cov.steps >= max_steps) {
+    if (f->stats.hangs++ == 0) {
+      const bool saved = fuzz_save(f->cfg->crash_dir, "hang-", fuzz_fnv1a(data, len), data, len, path, sizeof(path));
+      if (f->log) fprintf(f->log, "sem: fuzz: hang (> %" PRIu64 " steps)%s%s\n", max_steps, saved ? " -> " : "", saved ? path : "");
+    }
+    return;
+  }
+  if (rc < 0 || fuzz_trapped(f, rc)) {
+    const fuzz_crash_t c = {.rc = rc, .fid = f->cov.last_fid, .ip = f->cov.last_ip};
+    if (fuzz_seen_crash(f, c)) return;
+    f->stats.crashes++;
+    const char* what = rc < 0 ? sem_exec_rc_name(rc) : "trap";
+    char prefix[64];
+    snprintf(prefix, sizeof(prefix), "crash-%s-", what);
+    // Named after the site rather than the input, so a rerun that reaches the same crash
+    // through a different input does not add another file.
+    const uint32_t site[3] = {(uint32_t)c.rc, c.fid, c.ip};
+    const bool saved = fuzz_save(f->cfg->crash_dir, prefix, fuzz_fnv1a((const uint8_t*)site, sizeof(site)), data, len, path, sizeof(path));
+    if (f->log) {
+      const char* fn = (c.fid && c.fid <= f->m->func_count && f->m->funcs[c.fid - 1].name) ? f->m->funcs[c.fid - 1].name : "?";
+      fprintf(f->log, "sem: fuzz: crash %s in %s at ip %u", what, fn, (unsigned)c.ip);
+      if (saved) fprintf(f->log, " -> %s (repro: sem --run %s < %s)", path, f->path, path);
+      fprintf(f->log, "\n");
+    }
+    return;
+  }
+  if (!fresh) return;
+  if (!fuzz_corpus_add(f, data, len)) return;
+  (void)fuzz_save(f->cfg->corpus_dir, "id-", fuzz_fnv1a(data, len), data, len, path, sizeof(path));
+}
+
+static double fuzz_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void fuzz_dispose(fuzz_t* f) {
+  for (uint32_t i = 0; i < f->corpus_len; i++) free(f->corpus[i].data);
+  free(f->corpus);
+  free(f->crashes);
+  free(f->cov.hits);
+  free(f->virgin);
+  if (f->null_in) fclose(f->null_in);
+  if (f->null_out) fclose(f->null_out);
+  if (f->mem.buf) sem_guest_mem_dispose(&f->mem);
+}
+
+int sem_fuzz_sir_jsonl(const char* path, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root, const sem_fuzz_cfg_t* cfg,
+                       FILE* log, sem_fuzz_stats_t* out_stats) {
+  if (!path || !cfg) return 2;
+  if (out_stats) memset(out_stats, 0, sizeof(*out_stats));
+  sem_load_err_t err;
+  sem_module_t* sm = sem_module_load_sir_jsonl(path, &err);
+  if (!sm) {
+    if (log) fprintf(log, "sem: fuzz: %s: %s: %s\n", path, err.code, err.message);
+    return 2;
+  }
+
+  // Validated once here; every execution then skips the per-run check.
+  char verr[160];
+  if (!sir_module_validate(sem_module_ir(sm), verr, sizeof(verr))) {
+    if (log) fprintf(log, "sem: fuzz: %s: invalid module: %s\n", path, verr);
+    sem_module_release(sm);
+    return 2;
+  }
+
+  fuzz_t f;
+  memset(&f, 0, sizeof(f));
+  f.cfg = cfg;
+  f.m = sem_module_ir(sm);
+  f.caps = caps;
+  f.cap_count = cap_count;
+  f.fs_root = fs_root;
+  f.path = path;
+  f.log = log;
+  f.rng = cfg->seed ? cfg->seed : 1u;
+  const uint32_t max_len = cfg->max_len ? cfg->max_len : 64u;
+  const uint32_t mutations = cfg->mutations ? cfg->mutations : 4u;
+  const uint64_t iters = cfg->iters ? cfg->iters : 10000u;
+
+  f.cov.hits = (uint8_t*)calloc(1, SEM_FUZZ_MAP_SIZE);
+  f.virgin = (uint8_t*)calloc(1, SEM_FUZZ_MAP_SIZE);
+  f.null_in = fopen("/dev/null", "rb");
+  f.null_out = fopen("/dev/null", "wb");
+  uint8_t* buf = (uint8_t*)malloc(max_len);
+  if (!f.cov.hits || !f.virgin || !f.null_in || !f.null_out || !buf ||
+      !sem_guest_mem_init(&f.mem, SEM_FUZZ_GUEST_MEM, 0x10000ull)) {
+    if (log) fprintf(log, "sem: fuzz: failed to set up\n");
+    free(buf);
+    fuzz_dispose(&f);
+    sem_module_release(sm);
+    return 2;
+  }
+  if (!fuzz_load_seeds(&f)) {
+    if (log) fprintf(log, "sem: fuzz: failed to read corpus dir: %s\n", cfg->corpus_dir);
+    free(buf);
+    fuzz_dispose(&f);
+    sem_module_release(sm);
+    return 2;
+  }
+  if (f.corpus_len == 0) {
+    memset(buf, 0, max_len);
+    (void)fuzz_corpus_add(&f, buf, max_len);
+  }
+
+  const double t0 = fuzz_now();
+  // Seeds run first (in order) so their coverage is known before mutation starts.
+  const uint32_t seeds = f.corpus_len;
+  for (uint32_t i = 0; i < seeds && f.stats.execs < iters; i++) {
+    const fuzz_input_t in = f.corpus[i];
+    fuzz_triage(&f, in.data, in.len, fuzz_exec(&f, in.data, in.len));
+  }
+  while (f.stats.execs < iters) {
+    const fuzz_input_t* base = &f.corpus[fuzz_below(&f, f.corpus_len)];
+    uint32_t len = base->len < max_len ? base->len : max_len;
+    memcpy(buf, base->data, len);
+    const uint32_t n = 1u + fuzz_below(&f, mutations);
+    for (uint32_t k = 0; k < n; k++) len = fuzz_mutate(&f, buf, len, max_len);
+    fuzz_triage(&f, buf, len, fuzz_exec(&f, buf, len));
+  }
+  const double secs = fuzz_now() - t0;
+
+  if (log) {
+    fprintf(log, "sem: fuzz: execs=%" PRIu64 " (%.0f/s) corpus=%u edges=%u crashes=%u hangs=%u\n", f.stats.execs,
+            secs > 0 ? (double)f.stats.execs / secs : 0.0, (unsigned)f.stats.corpus, (unsigned)f.stats.edges, (unsigned)f.stats.crashes,
+            (unsigned)f.stats.hangs);
+  }
+  if (out_stats) *out_stats = f.stats;
+  const int rc = (f.stats.crashes || f.stats.hangs) ? 1 : 0;
+  free(buf);
+  fuzz_dispose(&f);
+  sem_module_release(sm);
+  return rc;
+}
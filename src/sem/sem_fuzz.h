@@ -0,0 +1,46 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "sem_host.h"
+
+// `sem --fuzz`: in-process, coverage-guided fuzzing of guest stdin.
+//
+// The module is parsed, lowered and validated once; every execution reuses it and one
+// guest memory arena (reset between runs), with stdin served from the mutated input.
+// Coverage is edge-based: each transfer of control (a step that does not fall through
+// from the previous instruction) hashes (previous block, this block) into a 64 KiB hit
+// map, bucketed by hit count. Inputs that reach a new edge or bucket join the corpus.
+//
+// A run that fails (negative ZI_E_*) or traps (term.trap, i32.div.s.trap, an overlapping
+// mem.copy: exit 255 from the trapping instruction) is a crash; one that exceeds `max_steps`
+// is a hang.
+// Each distinct crash site (rc, function, ip) and the first hang are written out once.
+// Crash files are named after their site, hangs and corpus inputs after their content,
+// so rerunning over the same directories never duplicates files.
+
+typedef struct sem_fuzz_cfg {
+  uint64_t iters;         // executions (0 = 10000)
+  uint32_t max_len;       // input size cap (0 = 64)
+  uint32_t mutations;     // max stacked mutations per derived input (0 = 4)
+  uint64_t seed;          // PRNG seed; runs are deterministic per seed (0 = 1)
+  uint64_t max_steps;     // instructions per execution before it counts as a hang (0 = 1000000)
+  const char* corpus_dir; // optional: seeds are read from it, new-coverage inputs are written to it
+  const char* crash_dir;  // optional: crashing/hanging inputs are written to it
+} sem_fuzz_cfg_t;
+
+typedef struct sem_fuzz_stats {
+  uint64_t execs;
+  uint32_t corpus;  // inputs kept (seeds included)
+  uint32_t edges;   // distinct hit-map entries reached
+  uint32_t crashes; // distinct crash sites
+  uint32_t hangs;
+} sem_fuzz_stats_t;
+
+// Fuzzes `path` and prints a summary (and one line per new crash) to `log` (NULL: quiet).
+// Returns 0 when nothing crashed or hung, 1 when something did, 2 on tool errors
+// (including a module that fails to load).
+int sem_fuzz_sir_jsonl(const char* path, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root, const sem_fuzz_cfg_t* cfg,
+                       FILE* log, sem_fuzz_stats_t* out_stats);
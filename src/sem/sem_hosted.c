@@ -8,6 +8,7 @@ static int32_t hz_end(void* u, zi_handle_t h) { return sir_zi_end((sir_hosted_za
 static zi_ptr_t hz_alloc(void* u, zi_size32_t n) { return sir_zi_alloc((sir_hosted_zabi_t*)u, n); }
 static int32_t hz_free(void* u, zi_ptr_t p) { return sir_zi_free((sir_hosted_zabi_t*)u, p); }
 static int32_t hz_telemetry(void* u, zi_ptr_t a, zi_size32_t b, zi_ptr_t c, zi_size32_t d) { return sir_zi_telemetry((sir_hosted_zabi_t*)u, a, b, c, d); }
+static int32_t hz_transfer(void* u, zi_handle_t d, zi_handle_t s, zi_size32_t n) { return sir_zi_transfer((sir_hosted_zabi_t*)u, d, s, n); }
 static int32_t hz_cap_count(void* u) { return sir_zi_cap_count((sir_hosted_zabi_t*)u); }
 static int32_t hz_cap_get_size(void* u, int32_t i) { return sir_zi_cap_get_size((sir_hosted_zabi_t*)u, i); }
 static int32_t hz_cap_get(void* u, int32_t i, zi_ptr_t p, zi_size32_t n) { return sir_zi_cap_get((sir_hosted_zabi_t*)u, i, p, n); }
@@ -26,6 +27,7 @@ sir_host_t sem_hosted_make_host(sir_hosted_zabi_t* hz) {
       .zi_alloc = hz_alloc,
       .zi_free = hz_free,
       .zi_telemetry = hz_telemetry,
+      .zi_transfer = hz_transfer,
       .zi_cap_count = hz_cap_count,
       .zi_cap_get_size = hz_cap_get_size,
       .zi_cap_get = hz_cap_get,
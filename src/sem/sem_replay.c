@@ -0,0 +1,838 @@
+#include "sem_replay.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sem_host.h"
+#include "zi_tape.h"
+
+enum {
+  RP_OP_READ = 1,
+  RP_OP_WRITE = 2,
+  RP_OP_END = 3,
+  RP_OP_ALLOC = 4,
+  RP_OP_FREE = 5,
+  RP_OP_TELEMETRY = 6,
+};
+
+static const uint8_t k_ckpt_magic[8] = {'S', 'E', 'M', 'C', 'K', 'P', 0, SEM_CKPT_VERSION};
+
+#define RP_REQ_MAX 32u
+
+typedef struct rp_req {
+  uint8_t b[RP_REQ_MAX];
+  uint32_t n;
+} rp_req_t;
+
+struct sem_replay {
+  sem_replay_cfg_t cfg;
+  sir_host_t inner;
+  sem_guest_mem_t* mem;
+  uint64_t fingerprint;
+
+  zi_tape_writer_t* tw;
+  zi_tape_reader_t* tr;
+  uint64_t tape_pos; // records written (record) or consumed (replay)
+  bool tape_io_err;
+  bool diverged;
+  uint64_t diverged_at;
+  const char* diverged_why;
+
+  FILE* ck_out;
+  uint8_t* shadow; // guest memory as of the previous checkpoint
+  uint32_t* dirty;
+  uint32_t dirty_cap;
+  bool ck_io_err;
+  uint32_t ck_count;
+  sir_exec_checkpoint_t ck;
+
+  bool resumed;
+  sir_exec_snapshot_t snap;
+  sir_exec_frame_t* frames;
+  sir_value_t* vals;
+  zi_ptr_t* globals;
+
+  const sir_exec_event_sink_t* sink_inner;
+  sir_exec_event_sink_t gate;
+  uint64_t steps;
+  bool open; // past the seek point: guest output and events flow
+};
+
+static void rp_put_u32(rp_req_t* r, uint32_t v) {
+  for (int i = 0; i < 4; i++) r->b[r->n++] = (uint8_t)(v >> (8 * i));
+}
+
+static void rp_put_u64(rp_req_t* r, uint64_t v) {
+  for (int i = 0; i < 8; i++) r->b[r->n++] = (uint8_t)(v >> (8 * i));
+}
+
+static uint64_t rp_get_u64(const uint8_t* p) {
+  uint64_t v = 0;
+  for (int i = 0; i < 8; i++) v |= (uint64_t)p[i] << (8 * i);
+  return v;
+}
+
+static rp_req_t rp_req(uint8_t op) {
+  rp_req_t r;
+  memset(&r, 0, sizeof(r));
+  r.b[r.n++] = op;
+  return r;
+}
+
+uint64_t sem_replay_module_fingerprint(const sir_module_t* m) {
+  uint64_t h = 1469598103934665603ull;
+#define RP_MIX(v)                              \
+  do {                                         \
+    uint64_t x_ = (uint64_t)(v);               \
+    for (int i_ = 0; i_ < 8; i_++) {           \
+      h = (h ^ (x_ & 0xFFu)) * 1099511628211ull; \
+      x_ >>= 8;                                \
+    }                                          \
+  } while (0)
+  if (!m) return h;
+  RP_MIX(m->func_count);
+  RP_MIX(m->entry);
+  RP_MIX(m->global_count);
+  for (uint32_t i = 0; i < m->global_count; i++) {
+    RP_MIX(m->globals[i].size);
+    RP_MIX(m->globals[i].align);
+    RP_MIX(m->globals[i].init_len);
+  }
+  for (uint32_t i = 0; i < m->func_count; i++) {
+    const sir_func_t* f = &m->funcs[i];
+    RP_MIX(f->inst_count);
+    RP_MIX(f->value_count);
+    RP_MIX(f->sig.param_count);
+    RP_MIX(f->sig.result_count);
+    for (uint32_t ip = 0; ip < f->inst_count; ip++) RP_MIX(f->insts[ip].k);
+  }
+#undef RP_MIX
+  return h;
+}
+
+// --- recording host ---
+
+static void rp_record(sem_replay_t* rp, const rp_req_t* r, int32_t rc, const uint8_t* resp, uint32_t resp_len) {
+  if (!zi_tape_writer_write(rp->tw, r->b, r->n, rc, resp, resp_len)) rp->tape_io_err = true;
+  rp->tape_pos++;
+}
+
+static int32_t rec_zi_read(void* user, zi_handle_t h, zi_ptr_t dst_ptr, zi_size32_t cap) {
+  sem_replay_t* rp = (sem_replay_t*)user;
+  const int32_t rc = rp->inner.v.zi_read(rp->inner.user, h, dst_ptr, cap);
+  rp_req_t r = rp_req(RP_OP_READ);
+  rp_put_u32(&r, (uint32_t)h);
+  rp_put_u64(&r, dst_ptr);
+  rp_put_u32(&r, cap);
+  const uint8_t* got = NULL;
+  if (rc > 0 && !sem_guest_mem_map_ro(rp->mem, dst_ptr, (zi_size32_t)rc, &got)) got = NULL;
+  rp_record(rp, &r, rc, got, got ? (uint32_t)rc : 0u);
+  return rc;
+}
+
+static int32_t rec_zi_write(void* user, zi_handle_t h, zi_ptr_t src_ptr, zi_size32_t len) {
+  sem_replay_t* rp = (sem_replay_t*)user;
+  const int32_t rc = rp->inner.v.zi_write(rp->inner.user, h, src_ptr, len);
+  rp_req_t r = rp_req(RP_OP_WRITE);
+  rp_put_u32(&r, (uint32_t)h);
+  rp_put_u64(&r, src_ptr);
+  rp_put_u32(&r, len);
+  rp_record(rp, &r, rc, NULL, 0);
+  return rc;
+}
+
+static int32_t rec_zi_end(void* user, zi_handle_t h) {
+  sem_replay_t* rp = (sem_replay_t*)user;
+  const int32_t rc = rp->inner.v.zi_end(rp->inner.user, h);
+  rp_req_t r = rp_req(RP_OP_END);
+  rp_put_u32(&r, (uint32_t)h);
+  rp_record(rp, &r, rc, NULL, 0);
+  return rc;
+}
+
+static zi_ptr_t rec_zi_alloc(void* user, zi_size32_t size) {
+  sem_replay_t* rp = (sem_replay_t*)user;
+  const zi_ptr_t p = rp->inner.v.zi_alloc(rp->inner.user, size);
+  rp_req_t r = rp_req(RP_OP_ALLOC);
+  rp_put_u32(&r, size);
+  uint8_t resp[8];
+  for (int i = 0; i < 8; i++) resp[i] = (uint8_t)((uint64_t)p >> (8 * i));
+  rp_record(rp, &r, 0, resp, sizeof(resp));
+  return p;
+}
+
+static int32_t rec_zi_free(void* user, zi_ptr_t ptr) {
+  sem_replay_t* rp = (sem_replay_t*)user;
+  const int32_t rc = rp->inner.v.zi_free(rp->inner.user, ptr);
+  rp_req_t r = rp_req(RP_OP_FREE);
+  rp_put_u64(&r, ptr);
+  rp_record(rp, &r, rc, NULL, 0);
+  return rc;
+}
+
+static int32_t rec_zi_telemetry(void* user, zi_ptr_t topic_ptr, zi_size32_t topic_len, zi_ptr_t msg_ptr, zi_size32_t msg_len) {
+  sem_replay_t* rp = (sem_replay_t*)user;
+  const int32_t rc = rp->inner.v.zi_telemetry(rp->inner.user, topic_ptr, topic_len, msg_ptr, msg_len);
+  rp_req_t r = rp_req(RP_OP_TELEMETRY);
+  rp_put_u64(&r, topic_ptr);
+  rp_put_u32(&r, topic_len);
+  rp_put_u64(&r, msg_ptr);
+  rp_put_u32(&r, msg_len);
+  rp_record(rp, &r, rc, NULL, 0);
+  return rc;
+}
+
+// --- replaying host ---
+
+static bool rp_next(sem_replay_t* rp, const rp_req_t* r, int32_t* out_rc, const uint8_t** out_resp, uint32_t* out_resp_len) {
+  if (rp->diverged) return false;
+  const uint8_t* req = NULL;
+  uint32_t req_len = 0;
+  if (!zi_tape_reader_next(rp->tr, &req, &req_len, out_rc, out_resp, out_resp_len)) {
+    rp->diverged = true;
+    rp->diverged_at = rp->tape_pos;
+    rp->diverged_why = "tape exhausted";
+    return false;
+  }
+  // The op byte always has to match; arguments only in strict mode.
+  if (req_len == 0 || req[0] != r->b[0] || (rp->cfg.tape_strict && (req_len != r->n || memcmp(req, r->b, r->n) != 0))) {
+    rp->diverged = true;
+    rp->diverged_at = rp->tape_pos;
+    rp->diverged_why = "request does not match tape";
+    return false;
+  }
+  rp->tape_pos++;
+  return true;
+}
+
+static bool rp_is_stdio_out(zi_handle_t h) {
+  return h == 1 || h == 2;
+}
+
+static int32_t play_zi_read(void* user, zi_handle_t h, zi_ptr_t dst_ptr, zi_size32_t cap) {
+  sem_replay_t* rp = (sem_replay_t*)user;
+  rp_req_t r = rp_req(RP_OP_READ);
+  rp_put_u32(&r, (uint32_t)h);
+  rp_put_u64(&r, dst_ptr);
+  rp_put_u32(&r, cap);
+  int32_t rc = 0;
+  const uint8_t* resp = NULL;
+  uint32_t resp_len = 0;
+  if (!rp_next(rp, &r, &rc, &resp, &resp_len)) return SEM_ZI_E_INTERNAL;
+  if (resp_len) {
+    uint8_t* dst = NULL;
+    if (resp_len > cap || !sem_guest_mem_map_rw(rp->mem, dst_ptr, resp_len, &dst) || !dst) return SEM_ZI_E_BOUNDS;
+    memcpy(dst, resp, resp_len);
+  }
+  return rc;
+}
+
+static int32_t play_zi_write(void* user, zi_handle_t h, zi_ptr_t src_ptr, zi_size32_t len) {
+  sem_replay_t* rp = (sem_replay_t*)user;
+  rp_req_t r = rp_req(RP_OP_WRITE);
+  rp_put_u32(&r, (uint32_t)h);
+  rp_put_u64(&r, src_ptr);
+  rp_put_u32(&r, len);
+  int32_t rc = 0;
+  const uint8_t* resp = NULL;
+  uint32_t resp_len = 0;
+  if (!rp_next(rp, &r, &rc, &resp, &resp_len)) return SEM_ZI_E_INTERNAL;
+  // Reproduce console output (what the recorded run managed to write); other sinks
+  // are not touched during replay.
+  if (rp->open && rp_is_stdio_out(h) && rc > 0 && (zi_size32_t)rc <= len) (void)rp->inner.v.zi_write(rp->inner.user, h, src_ptr, (zi_size32_t)rc);
+  return rc;
+}
+
+static int32_t play_zi_end(void* user, zi_handle_t h) {
+  sem_replay_t* rp = (sem_replay_t*)user;
+  rp_req_t r = rp_req(RP_OP_END);
+  rp_put_u32(&r, (uint32_t)h);
+  int32_t rc = 0;
+  const uint8_t* resp = NULL;
+  uint32_t resp_len = 0;
+  if (!rp_next(rp, &r, &rc, &resp, &resp_len)) return SEM_ZI_E_INTERNAL;
+  return rc;
+}
+
+static zi_ptr_t play_zi_alloc(void* user, zi_size32_t size) {
+  sem_replay_t* rp = (sem_replay_t*)user;
+  rp_req_t r = rp_req(RP_OP_ALLOC);
+  rp_put_u32(&r, size);
+  int32_t rc = 0;
+  const uint8_t* resp = NULL;
+  uint32_t resp_len = 0;
+  if (!rp_next(rp, &r, &rc, &resp, &resp_len)) return 0;
+  // Allocation lives in guest memory, so it is redone; the tape only confirms the address.
+  const zi_ptr_t p = rp->inner.v.zi_alloc(rp->inner.user, size);
+  if (resp_len != 8 || rp_get_u64(resp) != (uint64_t)p) {
+    rp->diverged = true;
+    rp->diverged_at = rp->tape_pos - 1u;
+    rp->diverged_why = "allocation address differs from tape";
+    return 0;
+  }
+  return p;
+}
+
+static int32_t play_zi_free(void* user, zi_ptr_t ptr) {
+  sem_replay_t* rp = (sem_replay_t*)user;
+  rp_req_t r = rp_req(RP_OP_FREE);
+  rp_put_u64(&r, ptr);
+  int32_t rc = 0;
+  const uint8_t* resp = NULL;
+  uint32_t resp_len = 0;
+  if (!rp_next(rp, &r, &rc, &resp, &resp_len)) return SEM_ZI_E_INTERNAL;
+  if (rc >= 0) (void)rp->inner.v.zi_free(rp->inner.user, ptr);
+  return rc;
+}
+
+static int32_t play_zi_telemetry(void* user, zi_ptr_t topic_ptr, zi_size32_t topic_len, zi_ptr_t msg_ptr, zi_size32_t msg_len) {
+  sem_replay_t* rp = (sem_replay_t*)user;
+  rp_req_t r = rp_req(RP_OP_TELEMETRY);
+  rp_put_u64(&r, topic_ptr);
+  rp_put_u32(&r, topic_len);
+  rp_put_u64(&r, msg_ptr);
+  rp_put_u32(&r, msg_len);
+  int32_t rc = 0;
+  const uint8_t* resp = NULL;
+  uint32_t resp_len = 0;
+  if (!rp_next(rp, &r, &rc, &resp, &resp_len)) return SEM_ZI_E_INTERNAL;
+  if (rp->open && rc >= 0) (void)rp->inner.v.zi_telemetry(rp->inner.user, topic_ptr, topic_len, msg_ptr, msg_len);
+  return rc;
+}
+
+sir_host_t sem_replay_host(sem_replay_t* rp) {
+  sir_host_t h;
+  memset(&h, 0, sizeof(h));
+  h.user = rp;
+  if (rp->tr) {
+    h.v.zi_read = play_zi_read;
+    h.v.zi_write = play_zi_write;
+    h.v.zi_end = play_zi_end;
+    h.v.zi_alloc = play_zi_alloc;
+    h.v.zi_free = play_zi_free;
+    h.v.zi_telemetry = play_zi_telemetry;
+    return h;
+  }
+  h.v.zi_read = rp->inner.v.zi_read ? rec_zi_read : NULL;
+  h.v.zi_write = rp->inner.v.zi_write ? rec_zi_write : NULL;
+  h.v.zi_end = rp->inner.v.zi_end ? rec_zi_end : NULL;
+  h.v.zi_alloc = rp->inner.v.zi_alloc ? rec_zi_alloc : NULL;
+  h.v.zi_free = rp->inner.v.zi_free ? rec_zi_free : NULL;
+  h.v.zi_telemetry = rp->inner.v.zi_telemetry ? rec_zi_telemetry : NULL;
+  return h;
+}
+
+// --- seek gate ---
+
+static bool rp_gate_open(sem_replay_t* rp) {
+  if (!rp->open) {
+    switch (rp->cfg.seek) {
+      case SEM_SEEK_STEP:
+        rp->open = rp->steps >= rp->cfg.seek_at;
+        break;
+      case SEM_SEEK_HOSTCALL:
+        rp->open = rp->tape_pos >= rp->cfg.seek_at;
+        break;
+      default:
+        rp->open = true;
+        break;
+    }
+  }
+  return rp->open;
+}
+
+static void gate_on_step(void* user, const sir_module_t* m, sir_func_id_t fid, uint32_t ip, sir_inst_kind_t k) {
+  sem_replay_t* rp = (sem_replay_t*)user;
+  const bool open = rp_gate_open(rp);
+  rp->steps++;
+  if (open && rp->sink_inner && rp->sink_inner->on_step) rp->sink_inner->on_step(rp->sink_inner->user, m, fid, ip, k);
+}
+
+static void gate_on_mem(void* user, const sir_module_t* m, sir_func_id_t fid, uint32_t ip, sir_mem_event_kind_t k, zi_ptr_t addr,
+                        uint32_t size) {
+  sem_replay_t* rp = (sem_replay_t*)user;
+  if (rp->open && rp->sink_inner && rp->sink_inner->on_mem) rp->sink_inner->on_mem(rp->sink_inner->user, m, fid, ip, k, addr, size);
+}
+
+static void gate_on_hostcall(void* user, const sir_module_t* m, sir_func_id_t fid, uint32_t ip, const char* callee, int32_t rc) {
+  sem_replay_t* rp = (sem_replay_t*)user;
+  if (rp->open && rp->sink_inner && rp->sink_inner->on_hostcall) {
+    rp->sink_inner->on_hostcall(rp->sink_inner->user, m, fid, ip, callee, rc);
+  }
+}
+
+const sir_exec_event_sink_t* sem_replay_sink(sem_replay_t* rp, const sir_exec_event_sink_t* inner) {
+  rp->sink_inner = inner;
+  rp->gate = (sir_exec_event_sink_t){.user = rp, .on_step = gate_on_step, .on_mem = gate_on_mem, .on_hostcall = gate_on_hostcall};
+  return &rp->gate;
+}
+
+// --- checkpoint files ---
+
+static void ck_put(sem_replay_t* rp, const void* p, size_t n) {
+  if (!rp->ck_io_err && fwrite(p, 1, n, rp->ck_out) != n) rp->ck_io_err = true;
+}
+
+static void ck_put_u32(sem_replay_t* rp, uint32_t v) {
+  uint8_t b[4];
+  for (int i = 0; i < 4; i++) b[i] = (uint8_t)(v >> (8 * i));
+  ck_put(rp, b, sizeof(b));
+}
+
+static void ck_put_u64(sem_replay_t* rp, uint64_t v) {
+  uint8_t b[8];
+  for (int i = 0; i < 8; i++) b[i] = (uint8_t)(v >> (8 * i));
+  ck_put(rp, b, sizeof(b));
+}
+
+static uint64_t ck_value_bits(const sir_value_t* v) {
+  switch (v->kind) {
+    case SIR_VAL_I1:
+      return v->u.u1;
+    case SIR_VAL_I8:
+      return v->u.u8;
+    case SIR_VAL_I16:
+      return v->u.u16;
+    case SIR_VAL_I32:
+      return (uint32_t)v->u.i32;
+    case SIR_VAL_I64:
+      return (uint64_t)v->u.i64;
+    case SIR_VAL_PTR:
+      return v->u.ptr;
+    case SIR_VAL_BOOL:
+      return v->u.b;
+    case SIR_VAL_F32:
+      return v->u.f32_bits;
+    case SIR_VAL_F64:
+      return v->u.f64_bits;
+    default:
+      return 0;
+  }
+}
+
+static bool ck_value_from_bits(uint8_t kind, uint64_t bits, sir_value_t* out) {
+  memset(out, 0, sizeof(*out));
+  out->kind = (sir_val_kind_t)kind;
+  switch (kind) {
+    case SIR_VAL_INVALID:
+      return true;
+    case SIR_VAL_I1:
+      out->u.u1 = (uint8_t)bits;
+      return true;
+    case SIR_VAL_I8:
+      out->u.u8 = (uint8_t)bits;
+      return true;
+    case SIR_VAL_I16:
+      out->u.u16 = (uint16_t)bits;
+      return true;
+    case SIR_VAL_I32:
+      out->u.i32 = (int32_t)(uint32_t)bits;
+      return true;
+    case SIR_VAL_I64:
+      out->u.i64 = (int64_t)bits;
+      return true;
+    case SIR_VAL_PTR:
+      out->u.ptr = (zi_ptr_t)bits;
+      return true;
+    case SIR_VAL_BOOL:
+      out->u.b = (uint8_t)bits;
+      return true;
+    case SIR_VAL_F32:
+      out->u.f32_bits = (uint32_t)bits;
+      return true;
+    case SIR_VAL_F64:
+      out->u.f64_bits = bits;
+      return true;
+    default:
+      return false;
+  }
+}
+
+static uint32_t ck_page_len(const sem_guest_mem_t* mem, uint32_t page) {
+  const uint64_t off = (uint64_t)page * SEM_CKPT_PAGE;
+  const uint64_t left = (uint64_t)mem->cap - off;
+  return (uint32_t)(left < SEM_CKPT_PAGE ? left : SEM_CKPT_PAGE);
+}
+
+static bool rp_on_checkpoint(void* user, const sir_module_t* m, const sem_guest_mem_t* mem, const sir_exec_snapshot_t* s) {
+  (void)m;
+  sem_replay_t* rp = (sem_replay_t*)user;
+
+  // Only [0, brk) is addressable and the bump allocator never shrinks it.
+  const uint32_t pages = (uint32_t)(((uint64_t)mem->brk + SEM_CKPT_PAGE - 1u) / SEM_CKPT_PAGE);
+  uint32_t n_dirty = 0;
+  for (uint32_t p = 0; p < pages; p++) {
+    const size_t off = (size_t)p * SEM_CKPT_PAGE;
+    const uint32_t len = ck_page_len(mem, p);
+    if (memcmp(mem->buf + off, rp->shadow + off, len) == 0) continue;
+    if (n_dirty == rp->dirty_cap) {
+      const uint32_t cap = rp->dirty_cap ? rp->dirty_cap * 2u : 256u;
+      uint32_t* d = (uint32_t*)realloc(rp->dirty, (size_t)cap * sizeof(*d));
+      if (!d) {
+        rp->ck_io_err = true;
+        return false;
+      }
+      rp->dirty = d;
+      rp->dirty_cap = cap;
+    }
+    rp->dirty[n_dirty++] = p;
+    memcpy(rp->shadow + off, mem->buf + off, len);
+  }
+
+  ck_put_u64(rp, s->steps);
+  ck_put_u64(rp, rp->tape_pos);
+  ck_put_u32(rp, mem->brk);
+  ck_put_u32(rp, s->global_count);
+  for (uint32_t i = 0; i < s->global_count; i++) ck_put_u64(rp, s->globals[i]);
+  ck_put_u32(rp, s->frame_count);
+  for (uint32_t k = 0; k < s->frame_count; k++) {
+    const sir_exec_frame_t* fr = &s->frames[k];
+    ck_put_u32(rp, fr->fid);
+    ck_put_u32(rp, fr->ip);
+    ck_put_u32(rp, fr->val_count);
+    for (uint32_t i = 0; i < fr->val_count; i++) {
+      const uint8_t kind = (uint8_t)fr->vals[i].kind;
+      ck_put(rp, &kind, 1);
+      ck_put_u64(rp, ck_value_bits(&fr->vals[i]));
+    }
+  }
+  ck_put_u32(rp, n_dirty);
+  for (uint32_t i = 0; i < n_dirty; i++) {
+    const uint32_t p = rp->dirty[i];
+    ck_put_u32(rp, p);
+    ck_put(rp, rp->shadow + (size_t)p * SEM_CKPT_PAGE, ck_page_len(mem, p));
+  }
+  // Keep complete records on disk so a killed run still leaves usable checkpoints. The tape
+  // buffers whole blocks, so push it out too: the checkpoint refers to tape_pos records.
+  if (rp->tw && !zi_tape_writer_flush(rp->tw)) rp->tape_io_err = true;
+  if (!rp->ck_io_err && fflush(rp->ck_out) != 0) rp->ck_io_err = true;
+  rp->ck_count++;
+  return !rp->ck_io_err;
+}
+
+typedef struct ck_reader {
+  FILE* f;
+  bool eof; // short read: truncated file
+} ck_reader_t;
+
+static bool ck_get(ck_reader_t* r, void* p, size_t n) {
+  if (r->eof) return false;
+  if (fread(p, 1, n, r->f) != n) {
+    r->eof = true;
+    return false;
+  }
+  return true;
+}
+
+static bool ck_get_u32(ck_reader_t* r, uint32_t* out) {
+  uint8_t b[4];
+  if (!ck_get(r, b, sizeof(b))) return false;
+  *out = (uint32_t)b[0] | (uint32_t)b[1] << 8 | (uint32_t)b[2] << 16 | (uint32_t)b[3] << 24;
+  return true;
+}
+
+static bool ck_get_u64(ck_reader_t* r, uint64_t* out) {
+  uint8_t b[8];
+  if (!ck_get(r, b, sizeof(b))) return false;
+  *out = rp_get_u64(b);
+  return true;
+}
+
+static void rp_free_resume(sem_replay_t* rp) {
+  free(rp->frames);
+  free(rp->vals);
+  free(rp->globals);
+  rp->frames = NULL;
+  rp->vals = NULL;
+  rp->globals = NULL;
+  rp->resumed = false;
+}
+
+// One checkpoint record. Frame/global state goes into the out_* buffers (caller frees),
+// memory pages into `pages` (page_count entries of {u32 page, bytes}).
+typedef struct ck_record {
+  uint64_t steps;
+  uint64_t tape_index;
+  uint32_t brk;
+  zi_ptr_t* globals;
+  uint32_t global_count;
+  sir_exec_frame_t* frames;
+  uint32_t frame_count;
+  sir_value_t* vals;
+  uint32_t* page_ids;
+  uint8_t* page_bytes;
+  uint32_t page_count;
+} ck_record_t;
+
+static void ck_record_free(ck_record_t* rec) {
+  free(rec->globals);
+  free(rec->frames);
+  free(rec->vals);
+  free(rec->page_ids);
+  free(rec->page_bytes);
+  memset(rec, 0, sizeof(*rec));
+}
+
+// Returns 1 for a complete record, 0 at end of file (including a truncated tail),
+// -1 for a record that cannot belong to this module/arena.
+static int ck_read_record(ck_reader_t* r, const sem_guest_mem_t* mem, ck_record_t* rec) {
+  memset(rec, 0, sizeof(*rec));
+  if (!ck_get_u64(r, &rec->steps)) return 0;
+  if (!ck_get_u64(r, &rec->tape_index) || !ck_get_u32(r, &rec->brk) || !ck_get_u32(r, &rec->global_count)) return 0;
+  if (rec->brk > mem->cap || rec->global_count > (1u << 20)) return -1;
+  rec->globals = (zi_ptr_t*)calloc(rec->global_count ? rec->global_count : 1u, sizeof(*rec->globals));
+  if (!rec->globals) return -1;
+  for (uint32_t i = 0; i < rec->global_count; i++) {
+    uint64_t g = 0;
+    if (!ck_get_u64(r, &g)) return 0;
+    rec->globals[i] = (zi_ptr_t)g;
+  }
+  if (!ck_get_u32(r, &rec->frame_count)) return 0;
+  if (rec->frame_count == 0 || rec->frame_count > 1025u) return -1;
+  rec->frames = (sir_exec_frame_t*)calloc(rec->frame_count, sizeof(*rec->frames));
+  uint32_t* val_off = (uint32_t*)calloc(rec->frame_count, sizeof(*val_off));
+  int res = 1;
+  size_t vals_len = 0;
+  size_t vals_cap = 0;
+  if (!rec->frames || !val_off) res = -1;
+  for (uint32_t k = 0; res == 1 && k < rec->frame_count; k++) {
+    uint32_t fid = 0, ip = 0, n = 0;
+    if (!ck_get_u32(r, &fid) || !ck_get_u32(r, &ip) || !ck_get_u32(r, &n)) {
+      res = 0;
+      break;
+    }
+    if (n > (1u << 20)) {
+      res = -1;
+      break;
+    }
+    if (vals_len + n > vals_cap) {
+      size_t cap = vals_cap ? vals_cap * 2u : 256u;
+      while (cap < vals_len + n) cap *= 2u;
+      sir_value_t* nv = (sir_value_t*)realloc(rec->vals, cap * sizeof(*nv));
+      if (!nv) {
+        res = -1;
+        break;
+      }
+      rec->vals = nv;
+      vals_cap = cap;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+      uint8_t kind = 0;
+      uint64_t bits = 0;
+      if (!ck_get(r, &kind, 1) || !ck_get_u64(r, &bits)) {
+        res = 0;
+        break;
+      }
+      if (!ck_value_from_bits(kind, bits, &rec->vals[vals_len + i])) {
+        res = -1;
+        break;
+      }
+    }
+    rec->frames[k] = (sir_exec_frame_t){.fid = fid, .ip = ip, .val_count = n};
+    val_off[k] = (uint32_t)vals_len;
+    vals_len += n;
+  }
+  // Value arrays may have moved while growing; point frames at them only now.
+  for (uint32_t k = 0; res == 1 && k < rec->frame_count; k++) rec->frames[k].vals = rec->vals ? rec->vals + val_off[k] : NULL;
+  free(val_off);
+  if (res != 1) return res;
+
+  if (!ck_get_u32(r, &rec->page_count)) return 0;
+  const uint32_t max_pages = (uint32_t)(((uint64_t)mem->cap + SEM_CKPT_PAGE - 1u) / SEM_CKPT_PAGE);
+  if (rec->page_count > max_pages) return -1;
+  if (rec->page_count) {
+    rec->page_ids = (uint32_t*)calloc(rec->page_count, sizeof(*rec->page_ids));
+    rec->page_bytes = (uint8_t*)malloc((size_t)rec->page_count * SEM_CKPT_PAGE);
+    if (!rec->page_ids || !rec->page_bytes) return -1;
+  }
+  for (uint32_t i = 0; i < rec->page_count; i++) {
+    uint32_t p = 0;
+    if (!ck_get_u32(r, &p)) return 0;
+    if (p >= max_pages) return -1;
+    rec->page_ids[i] = p;
+    if (!ck_get(r, rec->page_bytes + (size_t)i * SEM_CKPT_PAGE, ck_page_len(mem, p))) return 0;
+  }
+  return 1;
+}
+
+static bool ck_record_qualifies(const sem_replay_cfg_t* cfg, const ck_record_t* rec) {
+  switch (cfg->seek) {
+    case SEM_SEEK_STEP:
+      return rec->steps <= cfg->seek_at;
+    case SEM_SEEK_HOSTCALL:
+      return rec->tape_index <= cfg->seek_at;
+    default:
+      return true;
+  }
+}
+
+static bool rp_load_checkpoint(sem_replay_t* rp, char* err, size_t err_cap) {
+  FILE* f = fopen(rp->cfg.checkpoint_in, "rb");
+  if (!f) {
+    snprintf(err, err_cap, "failed to open checkpoints: %s", rp->cfg.checkpoint_in);
+    return false;
+  }
+  ck_reader_t r = {.f = f};
+  uint8_t magic[8];
+  uint64_t fp = 0, base = 0;
+  uint32_t cap = 0;
+  if (!ck_get(&r, magic, sizeof(magic)) || memcmp(magic, k_ckpt_magic, sizeof(magic)) != 0 || !ck_get_u64(&r, &fp) || !ck_get_u32(&r, &cap) ||
+      !ck_get_u64(&r, &base)) {
+    fclose(f);
+    snprintf(err, err_cap, "not a checkpoint file: %s", rp->cfg.checkpoint_in);
+    return false;
+  }
+  if (fp != rp->fingerprint || cap != rp->mem->cap || base != rp->mem->base) {
+    fclose(f);
+    snprintf(err, err_cap, "checkpoints were recorded for a different program: %s", rp->cfg.checkpoint_in);
+    return false;
+  }
+
+  // Page deltas accumulate, so every record up to the chosen one is applied in order.
+  ck_record_t rec;
+  for (;;) {
+    const int got = ck_read_record(&r, rp->mem, &rec);
+    if (got == 0) break;
+    if (got < 0) {
+      ck_record_free(&rec);
+      fclose(f);
+      rp_free_resume(rp);
+      snprintf(err, err_cap, "malformed checkpoint file: %s", rp->cfg.checkpoint_in);
+      return false;
+    }
+    if (!ck_record_qualifies(&rp->cfg, &rec)) break;
+    for (uint32_t i = 0; i < rec.page_count; i++) {
+      const uint32_t p = rec.page_ids[i];
+      memcpy(rp->mem->buf + (size_t)p * SEM_CKPT_PAGE, rec.page_bytes + (size_t)i * SEM_CKPT_PAGE, ck_page_len(rp->mem, p));
+    }
+    rp->mem->brk = rec.brk;
+    rp_free_resume(rp);
+    rp->frames = rec.frames;
+    rp->vals = rec.vals;
+    rp->globals = rec.globals;
+    rp->snap = (sir_exec_snapshot_t){
+        .steps = rec.steps, .frames = rec.frames, .frame_count = rec.frame_count, .globals = rec.globals, .global_count = rec.global_count};
+    rp->tape_pos = rec.tape_index;
+    rp->resumed = true;
+    rec.frames = NULL;
+    rec.vals = NULL;
+    rec.globals = NULL;
+    ck_record_free(&rec);
+  }
+  ck_record_free(&rec);
+  fclose(f);
+
+  if (rp->resumed) {
+    if (rp->tape_pos > zi_tape_reader_count(rp->tr) || !zi_tape_reader_seek(rp->tr, (uint32_t)rp->tape_pos)) {
+      rp_free_resume(rp);
+      snprintf(err, err_cap, "checkpoint is past the end of the tape: %s", rp->cfg.tape_in);
+      return false;
+    }
+    rp->steps = rp->snap.steps;
+  }
+  return true;
+}
+
+// --- lifecycle ---
+
+sem_replay_t* sem_replay_open(const sem_replay_cfg_t* cfg, const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, char* err,
+                              size_t err_cap) {
+  if (err && err_cap) err[0] = '\0';
+  if (!cfg || !m || !mem) return NULL;
+  sem_replay_t* rp = (sem_replay_t*)calloc(1, sizeof(*rp));
+  if (!rp) {
+    snprintf(err, err_cap, "out of memory");
+    return NULL;
+  }
+  rp->cfg = *cfg;
+  rp->inner = host;
+  rp->mem = mem;
+  rp->fingerprint = sem_replay_module_fingerprint(m);
+  rp->open = cfg->seek == SEM_SEEK_NONE;
+
+  if (cfg->tape_in) {
+    rp->tr = zi_tape_reader_open(cfg->tape_in);
+    if (!rp->tr) {
+      snprintf(err, err_cap, "failed to open tape for replay: %s", cfg->tape_in);
+      free(rp);
+      return NULL;
+    }
+    if (cfg->checkpoint_in && !rp_load_checkpoint(rp, err, err_cap)) {
+      zi_tape_reader_close(rp->tr);
+      free(rp);
+      return NULL;
+    }
+    return rp;
+  }
+
+  rp->open = true;
+  rp->tw = zi_tape_writer_open_ex(cfg->tape_out, (zi_tape_writer_opts_t){.compress = cfg->tape_compress});
+  if (!rp->tw) {
+    snprintf(err, err_cap, "failed to open tape for record: %s", cfg->tape_out ? cfg->tape_out : "");
+    free(rp);
+    return NULL;
+  }
+  if (cfg->checkpoint_out) {
+    rp->ck_out = fopen(cfg->checkpoint_out, "wb");
+    rp->shadow = rp->ck_out ? (uint8_t*)calloc(1, mem->cap) : NULL;
+    if (!rp->shadow) {
+      if (rp->ck_out) fclose(rp->ck_out);
+      (void)zi_tape_writer_close(rp->tw);
+      snprintf(err, err_cap, "failed to open checkpoint output: %s", cfg->checkpoint_out);
+      free(rp);
+      return NULL;
+    }
+    ck_put(rp, k_ckpt_magic, sizeof(k_ckpt_magic));
+    ck_put_u64(rp, rp->fingerprint);
+    ck_put_u32(rp, mem->cap);
+    ck_put_u64(rp, mem->base);
+    rp->ck = (sir_exec_checkpoint_t){
+        .user = rp, .every_steps = cfg->checkpoint_every ? cfg->checkpoint_every : SEM_CKPT_DEFAULT_EVERY, .on_checkpoint = rp_on_checkpoint};
+  }
+  return rp;
+}
+
+int32_t sem_replay_run(sem_replay_t* rp, const sir_module_t* m, sem_guest_mem_t* mem, const sir_exec_event_sink_t* sink) {
+  const sir_host_t host = sem_replay_host(rp);
+  const sir_exec_checkpoint_t* ck = rp->ck_out ? &rp->ck : NULL;
+  if (rp->resumed) return sir_module_resume(m, mem, host, sink, ck, &rp->snap);
+  return sir_module_run_checkpointed(m, mem, host, sink, ck);
+}
+
+uint64_t sem_replay_resumed_at(const sem_replay_t* rp) {
+  return (rp && rp->resumed) ? rp->snap.steps : 0;
+}
+
+bool sem_replay_close(sem_replay_t* rp, char* err, size_t err_cap) {
+  if (err && err_cap) err[0] = '\0';
+  if (!rp) return true;
+  bool ok = true;
+  if (rp->tw && (!zi_tape_writer_close(rp->tw) || rp->tape_io_err)) {
+    snprintf(err, err_cap, "failed to write tape: %s", rp->cfg.tape_out);
+    ok = false;
+  }
+  if (rp->ck_out) {
+    if (fclose(rp->ck_out) != 0) rp->ck_io_err = true;
+    if (rp->ck_io_err && ok) {
+      snprintf(err, err_cap, "failed to write checkpoints: %s", rp->cfg.checkpoint_out);
+      ok = false;
+    }
+  }
+  if (rp->tr) zi_tape_reader_close(rp->tr);
+  if (ok && rp->diverged) {
+    snprintf(err, err_cap, "replay diverged from tape at hostcall %" PRIu64 ": %s", rp->diverged_at, rp->diverged_why);
+    ok = false;
+  }
+  if (ok && rp->tr && !rp->open) {
+    snprintf(err, err_cap, "seek target %" PRIu64 " not reached (run ended after %" PRIu64 " steps, %" PRIu64 " hostcalls)", rp->cfg.seek_at,
+             rp->steps, rp->tape_pos);
+    ok = false;
+  }
+  rp_free_resume(rp);
+  free(rp->shadow);
+  free(rp->dirty);
+  free(rp);
+  return ok;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sir_module.h"
+
+// Record/replay for `sem --run` (`--tape-out` / `--tape-in`).
+//
+// Recording wraps the hosted zABI: every extern call (zi_read, zi_write, zi_end,
+// zi_alloc, zi_free, zi_telemetry) becomes one zi_tape record whose request is
+// u8 op + the call's arguments and whose response is what the host put into the guest
+// (bytes read, or the allocated pointer). Replay serves the same calls from the tape in
+// order, so a run can be repeated without stdin, files or timing; guest writes to
+// stdout/stderr are reproduced.
+//
+// Checkpoints (`--checkpoint-out`) are taken every N steps while recording:
+//
+//   header  "SEMCKP\0" + version byte, u64 module fingerprint, u32 mem_cap, u64 mem_base
+//   record  u64 steps, u64 tape_index, u32 brk,
+//           u32 global_count, u64 globals[global_count],
+//           u32 frame_count, {u32 fid, u32 ip, u32 val_count, {u8 kind, u64 bits}[val_count]}[frame_count],
+//           u32 page_count, {u32 page, bytes[SEM_CKPT_PAGE]}[page_count]
+//
+// Pages are the guest memory pages that changed since the previous record, so memory
+// at record k is the zeroed arena with the pages of records 0..k applied in order.
+// A truncated final record (recorder killed mid-write) is ignored.
+//
+// Replay with `--checkpoint-in` restores the last checkpoint at or before the seek
+// target, repositions the tape at its tape_index and resumes there, then runs muted
+// (no guest output, no trace events) until the target step/hostcall is reached.
+
+#define SEM_CKPT_VERSION 1u
+#define SEM_CKPT_PAGE 4096u
+
+typedef enum sem_replay_seek {
+  SEM_SEEK_NONE = 0,
+  SEM_SEEK_STEP = 1,     // instructions executed
+  SEM_SEEK_HOSTCALL = 2, // tape records consumed
+} sem_replay_seek_t;
+
+typedef struct sem_replay_cfg {
+  const char* tape_out; // record hostcalls
+  bool tape_compress;
+  const char* checkpoint_out; // with tape_out
+  uint64_t checkpoint_every;  // steps between checkpoints (0: SEM_CKPT_DEFAULT_EVERY)
+
+  const char* tape_in; // replay hostcalls (exclusive with tape_out)
+  bool tape_strict;    // requests must match the tape byte for byte
+  const char* checkpoint_in;
+  sem_replay_seek_t seek;
+  uint64_t seek_at;
+} sem_replay_cfg_t;
+
+#define SEM_CKPT_DEFAULT_EVERY 1000000u
+
+typedef struct sem_replay sem_replay_t;
+
+// Opens tapes/checkpoint files for one run of `m` over `mem` (a fresh arena) and `host`
+// (the live hosted zABI). When resuming, guest memory is restored here. Returns NULL
+// with a message in `err` on failure.
+sem_replay_t* sem_replay_open(const sem_replay_cfg_t* cfg, const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, char* err,
+                              size_t err_cap);
+
+// Host to run the guest against (records or replays through the tape).
+sir_host_t sem_replay_host(sem_replay_t* rp);
+
+// Gates `inner` until the seek point; the returned sink is owned by `rp`. Step counting
+// happens here, so pass the result even when `inner` is NULL.
+const sir_exec_event_sink_t* sem_replay_sink(sem_replay_t* rp, const sir_exec_event_sink_t* inner);
+
+// Runs `m` from the entry (or the restored checkpoint).
+int32_t sem_replay_run(sem_replay_t* rp, const sir_module_t* m, sem_guest_mem_t* mem, const sir_exec_event_sink_t* sink);
+
+// Finishes files. Returns false with a message in `err` when a tape/checkpoint write
+// failed or the replay diverged from the tape.
+bool sem_replay_close(sem_replay_t* rp, char* err, size_t err_cap);
+
+// Steps of the last restored checkpoint (0 when the replay started at the entry).
+uint64_t sem_replay_resumed_at(const sem_replay_t* rp);
+
+// Stable fingerprint of a module's shape (funcs, value counts, globals), stored in
+// checkpoint files so they are never applied to a different program.
+uint64_t sem_replay_module_fingerprint(const sir_module_t* m);
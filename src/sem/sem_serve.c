@@ -0,0 +1,494 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // fopencookie
+#endif
+
+#include "sem_serve.h"
+
+#include "json.h"
+#include "sir_jsonl.h"
+#include "sircc.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Resident modules are keyed by sem_content_hash_file of the module file, so a path rewritten
+// in place (even within one mtime tick and at the same size) is reloaded, and identical files at
+// different paths share one module. A client that sends the "hash" reported by an earlier
+// response skips reading the file altogether. The least recently used module is dropped beyond
+// SEM_SERVE_MAX_MODULES.
+#define SEM_SERVE_MAX_MODULES 64u
+
+typedef struct sem_serve_entry {
+  char key[SEM_CONTENT_HASH_MAX];
+  uint64_t last_use;
+  sem_module_t* sm;
+} sem_serve_entry_t;
+
+typedef struct sem_serve {
+  const sem_cap_t* caps;
+  uint32_t cap_count;
+  const char* fs_root;
+
+  sem_serve_entry_t* mods;
+  uint32_t mod_n;
+  uint32_t mod_cap;
+  uint64_t use_clock;
+
+  bool shutdown;
+} sem_serve_t;
+
+// Request keys. They are not SIR keys, so they stay out of json_keys.def and are matched
+// by content.
+typedef enum serve_key {
+  SERVE_KEY_OP,
+  SERVE_KEY_PATH,
+  SERVE_KEY_HASH,
+  SERVE_KEY_STDIN,
+  SERVE_KEY_STDIN_HEX,
+  SERVE_KEY_CAPS,
+} serve_key_t;
+
+static const char* const serve_key_names[] = {
+    [SERVE_KEY_OP] = "op",
+    [SERVE_KEY_PATH] = "path",
+    [SERVE_KEY_HASH] = "hash",
+    [SERVE_KEY_STDIN] = "stdin",
+    [SERVE_KEY_STDIN_HEX] = "stdin_hex",
+    [SERVE_KEY_CAPS] = "caps",
+};
+
+static const JsonValue* serve_req_get(const JsonValue* req, serve_key_t key) { return json_obj_get(req, serve_key_names[key]); }
+
+static void serve_dispose(sem_serve_t* sv) {
+  for (uint32_t i = 0; i < sv->mod_n; i++) sem_module_release(sv->mods[i].sm);
+  free(sv->mods);
+  sv->mods = NULL;
+  sv->mod_n = 0;
+  sv->mod_cap = 0;
+}
+
+static void serve_load_error(sem_load_err_t* err, const char* code, const char* what, const char* path) {
+  snprintf(err->code, sizeof(err->code), "%s", code);
+  snprintf(err->message, sizeof(err->message), "%s: %s", what, path);
+}
+
+static sem_serve_entry_t* serve_find(sem_serve_t* sv, const char* key) {
+  for (uint32_t i = 0; i < sv->mod_n; i++) {
+    if (strcmp(sv->mods[i].key, key) == 0) return &sv->mods[i];
+  }
+  return NULL;
+}
+
+// Loads `path` and checks that the loader saw the bytes `key` was taken from. A client-supplied
+// key must match as is; one taken by the server is retaken while the file keeps changing.
+static sem_module_t* serve_load(const char* path, char key[SEM_CONTENT_HASH_MAX], bool client_key, sem_load_err_t* err) {
+  for (int attempt = 0;; attempt++) {
+    sem_module_t* sm = sem_module_load_sir_jsonl(path, err);
+    if (!sm) return NULL;
+    char after[SEM_CONTENT_HASH_MAX];
+    if (!sem_content_hash_file(path, NULL, after)) {
+      sem_module_release(sm);
+      serve_load_error(err, "sem.serve.noent", "cannot read module", path);
+      return NULL;
+    }
+    if (strcmp(after, key) == 0) return sm;
+    sem_module_release(sm);
+    if (client_key) {
+      serve_load_error(err, "sem.serve.hash_mismatch", "\"hash\" does not match the contents of", path);
+      return NULL;
+    }
+    if (attempt == 2) {
+      serve_load_error(err, "sem.serve.unstable", "module keeps changing while loading", path);
+      return NULL;
+    }
+    memcpy(key, after, SEM_CONTENT_HASH_MAX);
+  }
+}
+
+// Returns the resident module for `hash` when given, else for the current contents of `path`,
+// loading it on a miss. `key` receives the hash the module is resident under.
+static sem_module_t* serve_get_module(sem_serve_t* sv, const char* path, const char* hash, char key[SEM_CONTENT_HASH_MAX], bool* out_cached,
+                                      sem_load_err_t* err) {
+  *out_cached = false;
+  if (hash) {
+    if (strlen(hash) >= SEM_CONTENT_HASH_MAX) {
+      serve_load_error(err, "sem.serve.bad_request", "bad \"hash\"", hash);
+      return NULL;
+    }
+    snprintf(key, SEM_CONTENT_HASH_MAX, "%s", hash);
+  } else if (!sem_content_hash_file(path, NULL, key)) {
+    serve_load_error(err, "sem.serve.noent", "cannot read module", path);
+    return NULL;
+  }
+
+  sem_serve_entry_t* e = serve_find(sv, key);
+  if (e) {
+    e->last_use = ++sv->use_clock;
+    *out_cached = true;
+    return e->sm;
+  }
+  if (!path) {
+    serve_load_error(err, "sem.serve.not_resident", "no resident module has hash", hash);
+    return NULL;
+  }
+
+  sem_module_t* sm = serve_load(path, key, hash != NULL, err);
+  if (!sm) return NULL;
+  // A server-taken key may have moved to contents that are already resident.
+  e = serve_find(sv, key);
+  if (e) {
+    sem_module_release(sm);
+    e->last_use = ++sv->use_clock;
+    *out_cached = true;
+    return e->sm;
+  }
+
+  if (sv->mod_n == SEM_SERVE_MAX_MODULES) {
+    e = &sv->mods[0];
+    for (uint32_t i = 1; i < sv->mod_n; i++) {
+      if (sv->mods[i].last_use < e->last_use) e = &sv->mods[i];
+    }
+    sem_module_release(e->sm);
+  } else {
+    if (sv->mod_n == sv->mod_cap) {
+      const uint32_t ncap = sv->mod_cap ? sv->mod_cap * 2u : 16u;
+      sem_serve_entry_t* np = (sem_serve_entry_t*)realloc(sv->mods, (size_t)ncap * sizeof(*np));
+      if (!np) {
+        sem_module_release(sm);
+        snprintf(err->code, sizeof(err->code), "sem.oom");
+        snprintf(err->message, sizeof(err->message), "out of memory");
+        return NULL;
+      }
+      sv->mods = np;
+      sv->mod_cap = ncap;
+    }
+    e = &sv->mods[sv->mod_n++];
+  }
+  memcpy(e->key, key, SEM_CONTENT_HASH_MAX);
+  e->last_use = ++sv->use_clock;
+  e->sm = sm;
+  return sm;
+}
+
+static int hex_nibble(char ch) {
+  if (ch >= '0' && ch <= '9') return ch - '0';
+  if (ch >= 'a' && ch <= 'f') return ch - 'a' + 10;
+  if (ch >= 'A' && ch <= 'F') return ch - 'A' + 10;
+  return -1;
+}
+
+static bool hex_decode(const char* s, uint8_t** out, size_t* out_len) {
+  const size_t n = strlen(s);
+  if (n % 2u) return false;
+  uint8_t* b = (uint8_t*)malloc(n / 2u + 1u);
+  if (!b) return false;
+  for (size_t i = 0; i < n / 2u; i++) {
+    const int hi = hex_nibble(s[2 * i]);
+    const int lo = hex_nibble(s[2 * i + 1]);
+    if (hi < 0 || lo < 0) {
+      free(b);
+      return false;
+    }
+    b[i] = (uint8_t)((hi << 4) | lo);
+  }
+  *out = b;
+  *out_len = n / 2u;
+  return true;
+}
+
+static void write_hex(FILE* out, const char* key, const char* p, size_t n) {
+  static const char digits[] = "0123456789abcdef";
+  fprintf(out, ",\"%s\":\"", key);
+  for (size_t i = 0; i < n; i++) {
+    const uint8_t b = (uint8_t)p[i];
+    fputc(digits[b >> 4], out);
+    fputc(digits[b & 15u], out);
+  }
+  fputc('"', out);
+}
+
+static void write_id(FILE* out, const JsonValue* id) {
+  fputc('{', out);
+  if (!id) return;
+  if (id->type == JSON_NUMBER) {
+    fprintf(out, "\"id\":%" PRId64 ",", id->v.i);
+  } else if (id->type == JSON_STRING) {
+    fputs("\"id\":", out);
+    json_write_escaped(out, id->v.s);
+    fputc(',', out);
+  }
+}
+
+static void serve_error(FILE* out, const JsonValue* id, const char* code, const char* message) {
+  write_id(out, id);
+  fputs("\"ok\":false,\"code\":", out);
+  json_write_escaped(out, code);
+  fputs(",\"message\":", out);
+  json_write_escaped(out, message);
+  fputs("}\n", out);
+}
+
+// Guest stdout/stderr reach the client as they are written, one event line per host write:
+//   {"id":1,"event":"stdout","data_hex":"..."}
+typedef struct serve_event_stream {
+  FILE* out;
+  const JsonValue* id;
+  const char* name;
+} serve_event_stream_t;
+
+static bool serve_event(serve_event_stream_t* es, const char* p, size_t n) {
+  write_id(es->out, es->id);
+  fprintf(es->out, "\"event\":\"%s\"", es->name);
+  write_hex(es->out, "data_hex", p, n);
+  fputs("}\n", es->out);
+  return fflush(es->out) == 0;
+}
+
+#if defined(__linux__)
+static ssize_t serve_event_write(void* cookie, const char* p, size_t n) {
+  return serve_event((serve_event_stream_t*)cookie, p, n) ? (ssize_t)n : -1;
+}
+
+static FILE* serve_event_open(serve_event_stream_t* es) {
+  FILE* f = fopencookie(es, "w", (cookie_io_functions_t){.write = serve_event_write});
+  if (f) setvbuf(f, NULL, _IONBF, 0);
+  return f;
+}
+#else
+static int serve_event_write(void* cookie, const char* p, int n) {
+  return serve_event((serve_event_stream_t*)cookie, p, (size_t)n) ? n : -1;
+}
+
+static FILE* serve_event_open(serve_event_stream_t* es) {
+  FILE* f = funopen(es, NULL, serve_event_write, NULL, NULL);
+  if (f) setvbuf(f, NULL, _IONBF, 0);
+  return f;
+}
+#endif
+
+// Narrows the server caps to the "kind:name" entries listed in `req_caps`.
+static bool select_caps(const sem_serve_t* sv, const JsonValue* req_caps, sem_cap_t* sel, uint32_t* out_n, const char** out_bad) {
+  *out_n = 0;
+  for (size_t i = 0; i < req_caps->v.arr.len; i++) {
+    const char* spec = json_get_string(req_caps->v.arr.items[i]);
+    *out_bad = spec ? spec : "?";
+    if (!spec) return false;
+    const char* colon = strchr(spec, ':');
+    if (!colon) return false;
+    const size_t kind_len = (size_t)(colon - spec);
+    bool found = false;
+    for (uint32_t c = 0; c < sv->cap_count; c++) {
+      const sem_cap_t* cap = &sv->caps[c];
+      if (!cap->kind || !cap->name) continue;
+      if (strlen(cap->kind) != kind_len || strncmp(cap->kind, spec, kind_len) != 0) continue;
+      if (strcmp(cap->name, colon + 1) != 0) continue;
+      if (*out_n < sv->cap_count) sel[(*out_n)++] = *cap;
+      found = true;
+      break;
+    }
+    if (!found) return false;
+  }
+  return true;
+}
+
+static void serve_run(sem_serve_t* sv, const JsonValue* req, FILE* out) {
+  const JsonValue* id = json_obj_get_sym(req, JSON_KEY_ID);
+  const char* path = json_get_string(serve_req_get(req, SERVE_KEY_PATH));
+  const JsonValue* hash_v = serve_req_get(req, SERVE_KEY_HASH);
+  const char* hash = json_get_string(hash_v);
+  if (path && !path[0]) path = NULL;
+  if (hash_v && (!hash || !hash[0])) {
+    serve_error(out, id, "sem.serve.bad_request", "bad \"hash\"");
+    return;
+  }
+  if (!path && !hash) {
+    serve_error(out, id, "sem.serve.bad_request", "missing \"path\"");
+    return;
+  }
+
+  uint8_t* in_bytes = NULL;
+  size_t in_len = 0;
+  const char* stdin_hex = json_get_string(serve_req_get(req, SERVE_KEY_STDIN_HEX));
+  const char* stdin_text = json_get_string(serve_req_get(req, SERVE_KEY_STDIN));
+  if (stdin_hex) {
+    if (!hex_decode(stdin_hex, &in_bytes, &in_len)) {
+      serve_error(out, id, "sem.serve.bad_request", "bad \"stdin_hex\"");
+      return;
+    }
+  } else if (stdin_text) {
+    in_len = strlen(stdin_text);
+    in_bytes = (uint8_t*)malloc(in_len + 1u);
+    if (!in_bytes) {
+      serve_error(out, id, "sem.oom", "out of memory");
+      return;
+    }
+    memcpy(in_bytes, stdin_text, in_len);
+  }
+
+  sem_cap_t* sel = NULL;
+  uint32_t sel_n = sv->cap_count;
+  const sem_cap_t* run_caps = sv->caps;
+  const JsonValue* req_caps = serve_req_get(req, SERVE_KEY_CAPS);
+  if (req_caps) {
+    const char* bad = NULL;
+    sel = (sem_cap_t*)calloc(sv->cap_count ? sv->cap_count : 1u, sizeof(*sel));
+    if (!json_is_array(req_caps) || !sel || !select_caps(sv, req_caps, sel, &sel_n, &bad)) {
+      char msg[256];
+      snprintf(msg, sizeof(msg), "cap not granted by server: %s", bad ? bad : "?");
+      serve_error(out, id, "sem.serve.cap", msg);
+      free(sel);
+      free(in_bytes);
+      return;
+    }
+    run_caps = sel;
+  }
+
+  bool cached = false;
+  char key[SEM_CONTENT_HASH_MAX];
+  sem_load_err_t lerr;
+  memset(&lerr, 0, sizeof(lerr));
+  sem_module_t* sm = serve_get_module(sv, path, hash, key, &cached, &lerr);
+  if (!sm) {
+    serve_error(out, id, lerr.code[0] ? lerr.code : "sem.load", lerr.message[0] ? lerr.message : "failed to load module");
+    free(sel);
+    free(in_bytes);
+    return;
+  }
+
+  // fmemopen rejects zero-sized buffers on some libcs; an empty stdin is /dev/null.
+  FILE* gin = in_len ? fmemopen(in_bytes, in_len, "rb") : fopen("/dev/null", "rb");
+  serve_event_stream_t out_es = {.out = out, .id = id, .name = "stdout"};
+  serve_event_stream_t err_es = {.out = out, .id = id, .name = "stderr"};
+  FILE* gout = serve_event_open(&out_es);
+  FILE* gerr = serve_event_open(&err_es);
+  if (!gin || !gout || !gerr) {
+    if (gin) fclose(gin);
+    if (gout) fclose(gout);
+    if (gerr) fclose(gerr);
+    serve_error(out, id, "sem.serve.io", "failed to set up guest stdio");
+    free(sel);
+    free(in_bytes);
+    return;
+  }
+
+  int prog_rc = 0;
+  const int32_t rc = sem_module_run(sm, run_caps, sel_n, sv->fs_root,
+                                    (sem_run_io_t){.in = gin, .out = gout, .err = gerr, .out_line_buffered = true}, &prog_rc);
+  fclose(gin);
+  fclose(gout);
+  fclose(gerr);
+
+  write_id(out, id);
+  if (rc == 0) {
+    fprintf(out, "\"ok\":true,\"exit\":%d", prog_rc);
+  } else {
+    fprintf(out, "\"ok\":false,\"code\":\"sem.exec\",\"message\":\"execution failed\",\"rc\":%d,\"rc_name\":\"%s\"", (int)rc, sem_exec_rc_name(rc));
+  }
+  fprintf(out, ",\"hash\":\"%s\",\"cached\":%s}\n", key, cached ? "true" : "false");
+
+  free(sel);
+  free(in_bytes);
+}
+
+static bool serve_loop(sem_serve_t* sv, FILE* in, FILE* out) {
+  char* line = NULL;
+  size_t line_cap = 0;
+  ssize_t n = 0;
+  while (!sv->shutdown && (n = getline(&line, &line_cap, in)) >= 0) {
+    size_t len = (size_t)n;
+    while (len && (line[len - 1] == '\n' || line[len - 1] == '\r' || line[len - 1] == ' ')) line[--len] = '\0';
+    if (len == 0) continue;
+
+    Arena arena;
+    arena_init(&arena);
+    JsonValue* req = NULL;
+    JsonError jerr = {0};
+    if (!json_parse(&arena, line, &req, &jerr) || !json_is_object(req)) {
+      serve_error(out, NULL, "sem.serve.bad_request", jerr.msg ? jerr.msg : "expected a JSON object");
+    } else {
+      const char* op = json_get_string(serve_req_get(req, SERVE_KEY_OP));
+      if (!op || strcmp(op, "run") == 0) {
+        serve_run(sv, req, out);
+      } else if (strcmp(op, "shutdown") == 0) {
+        write_id(out, json_obj_get_sym(req, JSON_KEY_ID));
+        fputs("\"ok\":true}\n", out);
+        sv->shutdown = true;
+      } else {
+        serve_error(out, json_obj_get_sym(req, JSON_KEY_ID), "sem.serve.bad_request", "unknown \"op\"");
+      }
+    }
+    arena_free(&arena);
+    if (fflush(out) != 0) break;
+  }
+  free(line);
+  return !ferror(out);
+}
+
+int sem_serve_stream(FILE* in, FILE* out, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root) {
+  if (!in || !out) return 1;
+  sem_serve_t sv = {.caps = caps, .cap_count = cap_count, .fs_root = fs_root};
+  const bool ok = serve_loop(&sv, in, out);
+  serve_dispose(&sv);
+  return ok ? 0 : 1;
+}
+
+int sem_serve_unix(const char* socket_path, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root) {
+  if (!socket_path) return 1;
+  struct sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (strlen(socket_path) >= sizeof(addr.sun_path)) {
+    fprintf(stderr, "sem: --serve-socket: path too long\n");
+    return 1;
+  }
+  strcpy(addr.sun_path, socket_path);
+
+  struct stat st;
+  if (lstat(socket_path, &st) == 0 && S_ISSOCK(st.st_mode)) (void)unlink(socket_path);
+
+  const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0 || bind(fd, (const struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(fd, 16) != 0) {
+    fprintf(stderr, "sem: --serve-socket: cannot listen on %s: %s\n", socket_path, strerror(errno));
+    if (fd >= 0) close(fd);
+    return 1;
+  }
+
+  // A client that disconnects mid-response must not kill the server.
+  (void)signal(SIGPIPE, SIG_IGN);
+
+  sem_serve_t sv = {.caps = caps, .cap_count = cap_count, .fs_root = fs_root};
+  while (!sv.shutdown) {
+    const int cfd = accept(fd, NULL, NULL);
+    if (cfd < 0) {
+      if (errno == EINTR) continue;
+      break;
+    }
+    const int cfd_out = dup(cfd);
+    FILE* in = fdopen(cfd, "rb");
+    FILE* out = cfd_out >= 0 ? fdopen(cfd_out, "wb") : NULL;
+    if (in && out) (void)serve_loop(&sv, in, out);
+    if (in) {
+      fclose(in);
+    } else {
+      close(cfd);
+    }
+    if (out) {
+      fclose(out);
+    } else if (cfd_out >= 0) {
+      close(cfd_out);
+    }
+  }
+  serve_dispose(&sv);
+  close(fd);
+  (void)unlink(socket_path);
+  return 0;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "sem_host.h"
+
+// `sem --serve`: a long-lived runner that keeps lowered + validated modules resident
+// and executes run requests against them, one fresh guest per request.
+//
+// Protocol: one JSON object per line in, one per line out (flushed per line).
+//
+//   request:  {"id":1,"path":"a.sir.jsonl","stdin":"text"}
+//             {"id":2,"hash":"<hash>","path":"a.sir.jsonl","stdin_hex":"00ff","caps":["file:fs"]}
+//             {"op":"shutdown"}
+//   event:    {"id":1,"event":"stdout","data_hex":"..."}
+//             {"id":1,"event":"stderr","data_hex":"..."}
+//   response: {"id":1,"ok":true,"exit":0,"hash":"<hash>","cached":true}
+//             {"id":2,"ok":false,"code":"sem.exec","message":"...","rc":-2,"rc_name":"ZI_E_BOUNDS",...}
+//
+// Guest output is streamed as events while the guest runs (stdout a line at a time, in
+// program order with stderr); the response follows the run's last event.
+// Modules are keyed by a hash of the file contents, reported as "hash" in each response:
+// an edited file is reloaded on its next request, and identical files at different paths
+// share one resident module. A request that passes "hash" is served from the resident
+// module without reading the file; "path" is then only needed to load it on a miss, and
+// the file must still hash to "hash" (else "sem.serve.hash_mismatch").
+// `caps` selects "kind:name" entries from the caps the server was started with;
+// when omitted, all server caps are granted. `fs_root` is fixed per server.
+
+// Serves requests from `in` until EOF or a shutdown request. Returns 0, or 1 on I/O error.
+int sem_serve_stream(FILE* in, FILE* out, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root);
+
+// Listens on a Unix socket at `socket_path` (replacing a stale socket file) and serves
+// one connection at a time with the stream protocol; resident modules are shared
+// across connections. Returns after a shutdown request, or 1 on setup error.
+int sem_serve_unix(const char* socket_path, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root);
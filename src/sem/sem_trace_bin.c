@@ -0,0 +1,487 @@
+#include "sem_trace_bin.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum {
+  TRB_STR = 0x01,
+  TRB_FUNC = 0x02,
+  TRB_OP = 0x03,
+  TRB_STEP = 0x10,
+  TRB_MEM_R = 0x11,
+  TRB_MEM_W = 0x12,
+  TRB_HOST = 0x13,
+};
+
+static const uint8_t k_trb_magic[8] = {'S', 'E', 'M', 'T', 'R', 'B', 0, SEM_TRACE_BIN_VERSION};
+
+#define TRB_BUF_CAP (64u * 1024u)
+#define TRB_REC_MAX 96u  // tag + 6 varints of <= 10 bytes, with headroom
+
+typedef struct trb_str {
+  char* s;
+  uint64_t hash;
+  uint32_t id;
+} trb_str_t;
+
+struct sem_trace_bin {
+  FILE* f;
+  bool io_err;
+  uint8_t* buf;
+  size_t len;
+
+  // Previous event state for delta encoding.
+  uint32_t fid;
+  uint32_t ip;
+  uint32_t node;
+  uint32_t line;
+  uint64_t addr;
+
+  // name_id per fid/op once defined (0 = not yet written).
+  uint32_t* fid_name;
+  uint32_t fid_cap;
+  uint32_t* op_name;
+  uint32_t op_cap;
+
+  // String table (open addressing; ids are dense from 1).
+  trb_str_t* strs;
+  uint32_t str_cap;
+  uint32_t str_count;
+};
+
+static uint64_t trb_hash(const char* s) {
+  uint64_t h = 1469598103934665603ull;
+  for (const unsigned char* p = (const unsigned char*)s; *p; p++) {
+    h ^= (uint64_t)*p;
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+static uint64_t trb_zigzag(int64_t v) {
+  return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static int64_t trb_unzigzag(uint64_t v) {
+  return (int64_t)(v >> 1) ^ -(int64_t)(v & 1u);
+}
+
+static void trb_flush(sem_trace_bin_t* tb) {
+  if (tb->len && fwrite(tb->buf, 1, tb->len, tb->f) != tb->len) tb->io_err = true;
+  tb->len = 0;
+}
+
+static void trb_reserve(sem_trace_bin_t* tb, size_t n) {
+  if (tb->len + n > TRB_BUF_CAP) trb_flush(tb);
+}
+
+static void trb_put_u8(sem_trace_bin_t* tb, uint8_t v) {
+  tb->buf[tb->len++] = v;
+}
+
+static void trb_put_uv(sem_trace_bin_t* tb, uint64_t v) {
+  while (v >= 0x80u) {
+    tb->buf[tb->len++] = (uint8_t)(v | 0x80u);
+    v >>= 7;
+  }
+  tb->buf[tb->len++] = (uint8_t)v;
+}
+
+static void trb_put_sv(sem_trace_bin_t* tb, int64_t v) {
+  trb_put_uv(tb, trb_zigzag(v));
+}
+
+static bool trb_grow_ids(uint32_t** ids, uint32_t* cap, uint32_t need) {
+  if (need < *cap) return true;
+  uint32_t ncap = *cap ? *cap : 64u;
+  while (ncap <= need) {
+    if (ncap > UINT32_MAX / 2u) return false;
+    ncap *= 2u;
+  }
+  uint32_t* n = (uint32_t*)realloc(*ids, (size_t)ncap * sizeof(uint32_t));
+  if (!n) return false;
+  memset(n + *cap, 0, (size_t)(ncap - *cap) * sizeof(uint32_t));
+  *ids = n;
+  *cap = ncap;
+  return true;
+}
+
+// Returns the id of `s`, writing a STR record the first time it is seen (0 on OOM).
+static uint32_t trb_intern(sem_trace_bin_t* tb, const char* s) {
+  if (!s) s = "";
+  if ((tb->str_count + 1u) * 2u > tb->str_cap) {
+    const uint32_t ncap = tb->str_cap ? tb->str_cap * 2u : 64u;
+    trb_str_t* n = (trb_str_t*)calloc(ncap, sizeof(trb_str_t));
+    if (!n) return 0;
+    for (uint32_t i = 0; i < tb->str_cap; i++) {
+      if (!tb->strs[i].s) continue;
+      uint32_t j = (uint32_t)tb->strs[i].hash & (ncap - 1u);
+      while (n[j].s) j = (j + 1u) & (ncap - 1u);
+      n[j] = tb->strs[i];
+    }
+    free(tb->strs);
+    tb->strs = n;
+    tb->str_cap = ncap;
+  }
+
+  const uint64_t h = trb_hash(s);
+  uint32_t j = (uint32_t)h & (tb->str_cap - 1u);
+  while (tb->strs[j].s) {
+    if (tb->strs[j].hash == h && strcmp(tb->strs[j].s, s) == 0) return tb->strs[j].id;
+    j = (j + 1u) & (tb->str_cap - 1u);
+  }
+  char* dup = strdup(s);
+  if (!dup) return 0;
+  const uint32_t id = ++tb->str_count;
+  tb->strs[j] = (trb_str_t){.s = dup, .hash = h, .id = id};
+
+  const size_t n = strlen(s);
+  trb_reserve(tb, TRB_REC_MAX);
+  trb_put_u8(tb, TRB_STR);
+  trb_put_uv(tb, id);
+  trb_put_uv(tb, n);
+  if (n > TRB_BUF_CAP - tb->len) {
+    trb_flush(tb);
+    if (fwrite(s, 1, n, tb->f) != n) tb->io_err = true;
+  } else {
+    memcpy(tb->buf + tb->len, s, n);
+    tb->len += n;
+  }
+  return id;
+}
+
+static bool trb_define_func(sem_trace_bin_t* tb, uint32_t fid, const char* func) {
+  if (fid < tb->fid_cap && tb->fid_name[fid]) return true;
+  if (!trb_grow_ids(&tb->fid_name, &tb->fid_cap, fid)) return false;
+  const uint32_t sid = trb_intern(tb, func);
+  if (!sid) return false;
+  tb->fid_name[fid] = sid;
+  trb_reserve(tb, TRB_REC_MAX);
+  trb_put_u8(tb, TRB_FUNC);
+  trb_put_uv(tb, fid);
+  trb_put_uv(tb, sid);
+  return true;
+}
+
+static bool trb_define_op(sem_trace_bin_t* tb, uint32_t op, const char* op_name) {
+  if (op < tb->op_cap && tb->op_name[op]) return true;
+  if (!trb_grow_ids(&tb->op_name, &tb->op_cap, op)) return false;
+  const uint32_t sid = trb_intern(tb, op_name);
+  if (!sid) return false;
+  tb->op_name[op] = sid;
+  trb_reserve(tb, TRB_REC_MAX);
+  trb_put_u8(tb, TRB_OP);
+  trb_put_uv(tb, op);
+  trb_put_uv(tb, sid);
+  return true;
+}
+
+static void trb_put_site(sem_trace_bin_t* tb, uint32_t fid, uint32_t ip) {
+  trb_put_sv(tb, (int64_t)fid - (int64_t)tb->fid);
+  trb_put_sv(tb, (int64_t)ip - (int64_t)tb->ip);
+  tb->fid = fid;
+  tb->ip = ip;
+}
+
+static void trb_put_src(sem_trace_bin_t* tb, uint32_t node, uint32_t line) {
+  trb_put_sv(tb, (int64_t)node - (int64_t)tb->node);
+  trb_put_sv(tb, (int64_t)line - (int64_t)tb->line);
+  tb->node = node;
+  tb->line = line;
+}
+
+sem_trace_bin_t* sem_trace_bin_open(const char* path) {
+  if (!path) return NULL;
+  FILE* f = fopen(path, "wb");
+  if (!f) return NULL;
+  sem_trace_bin_t* tb = (sem_trace_bin_t*)calloc(1, sizeof(*tb));
+  uint8_t* buf = (uint8_t*)malloc(TRB_BUF_CAP);
+  if (!tb || !buf) {
+    free(tb);
+    free(buf);
+    fclose(f);
+    return NULL;
+  }
+  tb->f = f;
+  tb->buf = buf;
+  memcpy(tb->buf, k_trb_magic, sizeof(k_trb_magic));
+  tb->len = sizeof(k_trb_magic);
+  return tb;
+}
+
+bool sem_trace_bin_close(sem_trace_bin_t* tb) {
+  if (!tb) return false;
+  trb_flush(tb);
+  bool ok = !tb->io_err;
+  if (fclose(tb->f) != 0) ok = false;
+  for (uint32_t i = 0; i < tb->str_cap; i++) free(tb->strs[i].s);
+  free(tb->strs);
+  free(tb->fid_name);
+  free(tb->op_name);
+  free(tb->buf);
+  free(tb);
+  return ok;
+}
+
+void sem_trace_bin_step(sem_trace_bin_t* tb, uint32_t fid, const char* func, uint32_t ip, uint32_t op, const char* op_name, uint32_t node,
+                        uint32_t line) {
+  if (!tb || tb->io_err) return;
+  if (!trb_define_func(tb, fid, func) || !trb_define_op(tb, op, op_name)) {
+    tb->io_err = true;
+    return;
+  }
+  trb_reserve(tb, TRB_REC_MAX);
+  trb_put_u8(tb, TRB_STEP);
+  trb_put_site(tb, fid, ip);
+  trb_put_uv(tb, op);
+  trb_put_src(tb, node, line);
+}
+
+void sem_trace_bin_mem(sem_trace_bin_t* tb, uint32_t fid, const char* func, uint32_t ip, bool is_write, uint64_t addr, uint32_t size,
+                       uint32_t node, uint32_t line) {
+  if (!tb || tb->io_err) return;
+  if (!trb_define_func(tb, fid, func)) {
+    tb->io_err = true;
+    return;
+  }
+  trb_reserve(tb, TRB_REC_MAX);
+  trb_put_u8(tb, is_write ? TRB_MEM_W : TRB_MEM_R);
+  trb_put_site(tb, fid, ip);
+  trb_put_sv(tb, (int64_t)(addr - tb->addr));
+  tb->addr = addr;
+  trb_put_uv(tb, size);
+  trb_put_src(tb, node, line);
+}
+
+void sem_trace_bin_hostcall(sem_trace_bin_t* tb, uint32_t fid, const char* func, uint32_t ip, const char* callee, int32_t rc, uint32_t node,
+                            uint32_t line) {
+  if (!tb || tb->io_err) return;
+  if (!trb_define_func(tb, fid, func)) {
+    tb->io_err = true;
+    return;
+  }
+  const uint32_t callee_id = trb_intern(tb, callee);
+  if (!callee_id) {
+    tb->io_err = true;
+    return;
+  }
+  trb_reserve(tb, TRB_REC_MAX);
+  trb_put_u8(tb, TRB_HOST);
+  trb_put_site(tb, fid, ip);
+  trb_put_uv(tb, callee_id);
+  trb_put_sv(tb, rc);
+  trb_put_src(tb, node, line);
+}
+
+// ---- reader / JSONL dump ----
+
+typedef struct trb_reader {
+  FILE* f;
+  char** strs;  // by id
+  uint32_t str_cap;
+  uint32_t* fid_name;
+  uint32_t fid_cap;
+  uint32_t* op_name;
+  uint32_t op_cap;
+} trb_reader_t;
+
+static bool trb_get_uv(FILE* f, uint64_t* out) {
+  uint64_t v = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    const int ch = getc(f);
+    if (ch == EOF) return false;
+    v |= (uint64_t)(ch & 0x7f) << shift;
+    if (!(ch & 0x80)) {
+      *out = v;
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool trb_get_u32(FILE* f, uint32_t* out) {
+  uint64_t v = 0;
+  if (!trb_get_uv(f, &v) || v > UINT32_MAX) return false;
+  *out = (uint32_t)v;
+  return true;
+}
+
+static bool trb_get_sv(FILE* f, int64_t* out) {
+  uint64_t v = 0;
+  if (!trb_get_uv(f, &v)) return false;
+  *out = trb_unzigzag(v);
+  return true;
+}
+
+static bool trb_apply_u32(FILE* f, uint32_t* state) {
+  int64_t d = 0;
+  if (!trb_get_sv(f, &d)) return false;
+  const int64_t v = (int64_t)*state + d;
+  if (v < 0 || v > (int64_t)UINT32_MAX) return false;
+  *state = (uint32_t)v;
+  return true;
+}
+
+static const char* trb_str_at(const trb_reader_t* r, uint32_t id) {
+  if (id == 0 || id >= r->str_cap) return NULL;
+  return r->strs[id];
+}
+
+static const char* trb_name_at(const trb_reader_t* r, const uint32_t* ids, uint32_t cap, uint32_t key) {
+  if (key >= cap || !ids[key]) return NULL;
+  return trb_str_at(r, ids[key]);
+}
+
+static void trb_write_escaped(FILE* out, const char* s) {
+  for (const unsigned char* p = (const unsigned char*)s; *p; p++) {
+    const unsigned char ch = *p;
+    if (ch == '\\' || ch == '"') {
+      fputc('\\', out);
+      fputc((int)ch, out);
+    } else if (ch == '\n') {
+      fputs("\\n", out);
+    } else if (ch == '\r') {
+      fputs("\\r", out);
+    } else if (ch == '\t') {
+      fputs("\\t", out);
+    } else if (ch < 0x20) {
+      fprintf(out, "\\u%04x", (unsigned)ch);
+    } else {
+      fputc((int)ch, out);
+    }
+  }
+}
+
+static void trb_write_head(FILE* out, const char* k, uint32_t fid, const char* func, uint32_t ip) {
+  fprintf(out, "{\"tool\":\"sem\",\"k\":\"%s\",\"fid\":%u,\"func\":\"", k, (unsigned)fid);
+  trb_write_escaped(out, func);
+  fprintf(out, "\",\"ip\":%u", (unsigned)ip);
+}
+
+static void trb_write_src_tail(FILE* out, uint32_t node, uint32_t line) {
+  if (node || line) fprintf(out, ",\"node\":%u,\"line\":%u", (unsigned)node, (unsigned)line);
+  fputs("}\n", out);
+}
+
+static bool trb_read_def(trb_reader_t* r, uint32_t** ids, uint32_t* cap) {
+  uint32_t key = 0, sid = 0;
+  if (!trb_get_u32(r->f, &key) || !trb_get_u32(r->f, &sid)) return false;
+  if (!trb_str_at(r, sid)) return false;
+  if (!trb_grow_ids(ids, cap, key)) return false;
+  (*ids)[key] = sid;
+  return true;
+}
+
+static bool trb_read_str(trb_reader_t* r) {
+  uint32_t id = 0, n = 0;
+  if (!trb_get_u32(r->f, &id) || !trb_get_u32(r->f, &n) || id == 0) return false;
+  if (id >= r->str_cap) {
+    uint32_t ncap = r->str_cap ? r->str_cap : 64u;
+    while (ncap <= id) {
+      if (ncap > UINT32_MAX / 2u) return false;
+      ncap *= 2u;
+    }
+    char** ns = (char**)realloc(r->strs, (size_t)ncap * sizeof(char*));
+    if (!ns) return false;
+    memset(ns + r->str_cap, 0, (size_t)(ncap - r->str_cap) * sizeof(char*));
+    r->strs = ns;
+    r->str_cap = ncap;
+  }
+  if (r->strs[id]) return false;
+  char* s = (char*)malloc((size_t)n + 1u);
+  if (!s) return false;
+  if (n && fread(s, 1, n, r->f) != n) {
+    free(s);
+    return false;
+  }
+  s[n] = '\0';
+  if (memchr(s, '\0', n)) {
+    free(s);
+    return false;
+  }
+  r->strs[id] = s;
+  return true;
+}
+
+static int trb_dump_records(trb_reader_t* r, FILE* out) {
+  uint32_t fid = 0, ip = 0, node = 0, line = 0;
+  uint64_t addr = 0;
+  for (;;) {
+    const int tag = getc(r->f);
+    if (tag == EOF) return ferror(r->f) ? 1 : 0;
+
+    switch (tag) {
+      case TRB_STR:
+        if (!trb_read_str(r)) return 1;
+        continue;
+      case TRB_FUNC:
+        if (!trb_read_def(r, &r->fid_name, &r->fid_cap)) return 1;
+        continue;
+      case TRB_OP:
+        if (!trb_read_def(r, &r->op_name, &r->op_cap)) return 1;
+        continue;
+      case TRB_STEP:
+      case TRB_MEM_R:
+      case TRB_MEM_W:
+      case TRB_HOST:
+        break;
+      default:
+        return 1;
+    }
+
+    if (!trb_apply_u32(r->f, &fid) || !trb_apply_u32(r->f, &ip)) return 1;
+    const char* func = trb_name_at(r, r->fid_name, r->fid_cap, fid);
+    if (!func) return 1;
+
+    if (tag == TRB_STEP) {
+      uint32_t op = 0;
+      if (!trb_get_u32(r->f, &op)) return 1;
+      const char* op_name = trb_name_at(r, r->op_name, r->op_cap, op);
+      if (!op_name || !trb_apply_u32(r->f, &node) || !trb_apply_u32(r->f, &line)) return 1;
+      trb_write_head(out, "trace_step", fid, func, ip);
+      fprintf(out, ",\"op\":\"%s\"", op_name);
+    } else if (tag == TRB_HOST) {
+      uint32_t callee_id = 0;
+      int64_t rc = 0;
+      if (!trb_get_u32(r->f, &callee_id) || !trb_get_sv(r->f, &rc)) return 1;
+      const char* callee = trb_str_at(r, callee_id);
+      if (!callee || rc < INT32_MIN || rc > INT32_MAX) return 1;
+      if (!trb_apply_u32(r->f, &node) || !trb_apply_u32(r->f, &line)) return 1;
+      trb_write_head(out, "trace_hostcall", fid, func, ip);
+      fputs(",\"callee\":\"", out);
+      trb_write_escaped(out, callee);
+      fprintf(out, "\",\"rc\":%d", (int)rc);
+    } else {
+      int64_t daddr = 0;
+      uint32_t size = 0;
+      if (!trb_get_sv(r->f, &daddr) || !trb_get_u32(r->f, &size)) return 1;
+      if (!trb_apply_u32(r->f, &node) || !trb_apply_u32(r->f, &line)) return 1;
+      addr += (uint64_t)daddr;
+      trb_write_head(out, "trace_mem", fid, func, ip);
+      fprintf(out, ",\"kind\":\"%s\",\"addr\":%" PRIu64 ",\"size\":%u", (tag == TRB_MEM_W) ? "w" : "r", addr, (unsigned)size);
+    }
+    trb_write_src_tail(out, node, line);
+  }
+}
+
+int sem_trace_bin_dump(const char* path, FILE* out) {
+  if (!path || !out) return 2;
+  FILE* f = fopen(path, "rb");
+  if (!f) return 2;
+
+  uint8_t magic[sizeof(k_trb_magic)];
+  if (fread(magic, 1, sizeof(magic), f) != sizeof(magic) || memcmp(magic, k_trb_magic, sizeof(magic)) != 0) {
+    fclose(f);
+    return 1;
+  }
+
+  trb_reader_t r = {.f = f};
+  const int rc = trb_dump_records(&r, out);
+  for (uint32_t i = 0; i < r.str_cap; i++) free(r.strs[i]);
+  free(r.strs);
+  free(r.fid_name);
+  free(r.op_name);
+  fclose(f);
+  return rc;
+}
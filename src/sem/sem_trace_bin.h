@@ -0,0 +1,43 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Compact binary execution trace (`sem --trace-bin-out`), convertible to the
+// `--trace-jsonl-out` schema with `sem --trace-dump`.
+//
+// Layout: 8-byte magic "SEMTRB\0" + version byte, then records. Each record is a tag
+// byte followed by LEB128 varints (signed fields zigzag-encoded):
+//
+//   0x01 STR   id len bytes[len]         string table entry, written once before first use
+//   0x02 FUNC  fid name_id               function name, written once per fid
+//   0x03 OP    op name_id                instruction kind name, written once per kind
+//   0x10 STEP  dfid dip op dnode dline
+//   0x11 MEM_R dfid dip daddr size dnode dline
+//   0x12 MEM_W dfid dip daddr size dnode dline
+//   0x13 HOST  dfid dip callee_id rc dnode dline
+//
+// `d*` fields are deltas against the previous event's value (addr against the previous
+// memory event), so straight-line code costs a few bytes per step.
+
+#define SEM_TRACE_BIN_VERSION 1u
+
+typedef struct sem_trace_bin sem_trace_bin_t;
+
+sem_trace_bin_t* sem_trace_bin_open(const char* path);
+// Flushes and closes; returns false if any write failed.
+bool sem_trace_bin_close(sem_trace_bin_t* tb);
+
+// `func`/`op_name` are only read the first time a fid/op is seen. node/line of 0/0
+// mean "no source location" (omitted from the JSONL form).
+void sem_trace_bin_step(sem_trace_bin_t* tb, uint32_t fid, const char* func, uint32_t ip, uint32_t op, const char* op_name, uint32_t node,
+                        uint32_t line);
+void sem_trace_bin_mem(sem_trace_bin_t* tb, uint32_t fid, const char* func, uint32_t ip, bool is_write, uint64_t addr, uint32_t size,
+                       uint32_t node, uint32_t line);
+void sem_trace_bin_hostcall(sem_trace_bin_t* tb, uint32_t fid, const char* func, uint32_t ip, const char* callee, int32_t rc, uint32_t node,
+                            uint32_t line);
+
+// Converts a binary trace to trace JSONL on `out`. Returns 0 on success, 1 for a
+// malformed/truncated trace, 2 if `path` cannot be read.
+int sem_trace_bin_dump(const char* path, FILE* out);
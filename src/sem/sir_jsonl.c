@@ -1,6 +1,8 @@
 #include "sir_jsonl.h"
 
 #include "sem_hosted.h"
+#include "sem_replay.h"
+#include "sem_trace_bin.h"
 #include "sir_module.h"
 
 #include "json.h"
@@ -15,6 +17,87 @@
 #include <stdarg.h>
 #include <string.h>
 
+#include <unistd.h>
+
+// Keyword families from sir_jsonl_tags.def; 0 means "not a known keyword".
+#define SIRJ_REC(name, kw) SIRJ_REC_##name,
+#define SIRJ_TYPEKIND(name, kw)
+#define SIRJ_TAG(name, kw)
+typedef enum sirj_rec {
+  SIRJ_REC_UNKNOWN = 0,
+#include "sir_jsonl_tags.def"
+} sirj_rec_t;
+#undef SIRJ_REC
+#undef SIRJ_TYPEKIND
+#undef SIRJ_TAG
+
+#define SIRJ_REC(name, kw)
+#define SIRJ_TYPEKIND(name, kw) SIRJ_TYPEKIND_##name,
+#define SIRJ_TAG(name, kw)
+typedef enum sirj_typekind {
+  SIRJ_TYPEKIND_UNKNOWN = 0,
+#include "sir_jsonl_tags.def"
+} sirj_typekind_t;
+#undef SIRJ_REC
+#undef SIRJ_TYPEKIND
+#undef SIRJ_TAG
+
+#define SIRJ_REC(name, kw)
+#define SIRJ_TYPEKIND(name, kw)
+#define SIRJ_TAG(name, kw) SIRJ_TAG_##name,
+typedef enum sirj_tag {
+  SIRJ_TAG_UNKNOWN = 0,
+#include "sir_jsonl_tags.def"
+} sirj_tag_t;
+#undef SIRJ_REC
+#undef SIRJ_TYPEKIND
+#undef SIRJ_TAG
+
+typedef struct sirj_ph_key {
+  const char* name;
+  uint32_t len;
+  uint32_t id;
+} sirj_ph_key_t;
+
+typedef struct sirj_ph_table {
+  const int32_t* disp;
+  const sirj_ph_key_t* keys;
+  uint32_t n;
+} sirj_ph_table_t;
+
+// Generated at configure time by src/sircc/tools/gen_tag_table.py.
+#include "sir_jsonl_tags.generated.h"
+
+static uint32_t sirj_ph_hash(uint32_t seed, const char* s, size_t n) {
+  // FNV-1a 32-bit (seeded basis) + fmix32; must match src/sircc/tools/gen_tag_table.py.
+  uint32_t h = 0x811C9DC5u ^ seed;
+  for (size_t i = 0; i < n; i++) {
+    h ^= (uint32_t)(uint8_t)s[i];
+    h *= 0x01000193u;
+  }
+  h ^= h >> 16;
+  h *= 0x85EBCA6Bu;
+  h ^= h >> 13;
+  h *= 0xC2B2AE35u;
+  h ^= h >> 16;
+  return h;
+}
+
+// One probe + one compare, independent of the vocabulary size.
+static uint32_t sirj_ph_lookup(const sirj_ph_table_t* t, const char* s) {
+  if (!t || !s || t->n == 0) return 0;
+  const size_t len = strlen(s);
+  const int32_t d = t->disp[sirj_ph_hash(0, s, len) % t->n];
+  const uint32_t slot = (d < 0) ? (uint32_t)(-(d + 1)) : sirj_ph_hash((uint32_t)d, s, len) % t->n;
+  const sirj_ph_key_t* k = &t->keys[slot];
+  if (k->len != len || memcmp(k->name, s, len) != 0) return 0;
+  return k->id;
+}
+
+static sirj_tag_t sirj_tag_lookup(const char* s) {
+  return (sirj_tag_t)sirj_ph_lookup(&sirj_tag_ph, s);
+}
+
 typedef struct type_info {
   bool present;
   bool is_fn;
@@ -66,6 +149,7 @@ typedef struct sym_info {
 typedef struct node_info {
   bool present;
   const char* tag;       // arena-owned
+  sirj_tag_t tag_id;     // interned from tag at parse time
   uint32_t type_ref;     // 0 if missing
   JsonValue* fields_obj; // object or NULL
   uint32_t loc_line;
@@ -100,6 +184,19 @@ typedef struct sirj_idmap {
   uint32_t next_id;
 } sirj_idmap_t;
 
+// Name -> id map (open addressing); the first id inserted for a name wins.
+typedef struct sirj_namemap_entry {
+  uint64_t h; // 0 marks an empty slot
+  const char* name;
+  uint32_t id;
+} sirj_namemap_entry_t;
+
+typedef struct sirj_namemap {
+  sirj_namemap_entry_t* entries;
+  uint32_t cap; // power-of-two
+  uint32_t len;
+} sirj_namemap_t;
+
 typedef struct sirj_ctx {
   Arena arena;
 
@@ -117,6 +214,7 @@ typedef struct sirj_ctx {
 
   sym_info_t* syms; // indexed by sym id
   uint32_t symrec_cap;
+  sirj_namemap_t sym_by_name; // sym name -> lowest sym id, built after parsing
 
   // Lowering maps
   sir_sym_id_t* sym_by_node; // indexed by node id; 0 means unset
@@ -144,6 +242,7 @@ typedef struct sirj_ctx {
   sir_func_id_t fn;
   sir_func_id_t* func_by_node; // node_id -> func_id (0 if none)
   uint32_t func_by_node_cap;
+  sirj_namemap_t func_by_name; // fn name -> func_id of the lowest fn node id
 
   // Primitive module type ids
   sir_type_id_t ty_i1;
@@ -179,6 +278,8 @@ typedef struct sirj_ctx {
   sem_diag_format_t diag_format;
   const char* cur_path;
   bool diag_all;
+  FILE* diag_out;  // NULL: stderr
+  sem_run_io_t io;  // guest handles 0/1/2 for --run; NULL members keep the process streams
   struct {
     const char* code;
     char msg[256];
@@ -306,7 +407,7 @@ static void sem_json_write_escaped(FILE* out, const char* s) {
   }
 }
 
-static void sem_print_one_diag(sem_diag_format_t fmt, const char* code, const char* msg, const char* path, uint32_t line, uint32_t node,
+static void sem_print_one_diag(FILE* out, sem_diag_format_t fmt, const char* code, const char* msg, const char* path, uint32_t line, uint32_t node,
                                const char* tag, uint32_t fid, uint32_t ip, const char* op) {
   if (!code) code = "sem.error";
   if (!msg || !msg[0]) msg = "error";
@@ -315,60 +416,61 @@ static void sem_print_one_diag(sem_diag_format_t fmt, const char* code, const ch
   if (!op) op = "";
 
   if (fmt == SEM_DIAG_JSON) {
-    fprintf(stderr, "{\"tool\":\"sem\",\"code\":\"");
-    sem_json_write_escaped(stderr, code);
-    fprintf(stderr, "\",\"message\":\"");
-    sem_json_write_escaped(stderr, msg);
-    fprintf(stderr, "\"");
+    fprintf(out, "{\"tool\":\"sem\",\"code\":\"");
+    sem_json_write_escaped(out, code);
+    fprintf(out, "\",\"message\":\"");
+    sem_json_write_escaped(out, msg);
+    fprintf(out, "\"");
     if (path[0]) {
-      fprintf(stderr, ",\"path\":\"");
-      sem_json_write_escaped(stderr, path);
-      fprintf(stderr, "\"");
+      fprintf(out, ",\"path\":\"");
+      sem_json_write_escaped(out, path);
+      fprintf(out, "\"");
     }
-    if (line) fprintf(stderr, ",\"line\":%u", (unsigned)line);
-    if (node) fprintf(stderr, ",\"node\":%u", (unsigned)node);
-    if (fid) fprintf(stderr, ",\"fid\":%u", (unsigned)fid);
-    if (fid) fprintf(stderr, ",\"ip\":%u", (unsigned)ip);
+    if (line) fprintf(out, ",\"line\":%u", (unsigned)line);
+    if (node) fprintf(out, ",\"node\":%u", (unsigned)node);
+    if (fid) fprintf(out, ",\"fid\":%u", (unsigned)fid);
+    if (fid) fprintf(out, ",\"ip\":%u", (unsigned)ip);
     if (op[0]) {
-      fprintf(stderr, ",\"op\":\"");
-      sem_json_write_escaped(stderr, op);
-      fprintf(stderr, "\"");
+      fprintf(out, ",\"op\":\"");
+      sem_json_write_escaped(out, op);
+      fprintf(out, "\"");
     }
     if (tag[0]) {
-      fprintf(stderr, ",\"tag\":\"");
-      sem_json_write_escaped(stderr, tag);
-      fprintf(stderr, "\"");
+      fprintf(out, ",\"tag\":\"");
+      sem_json_write_escaped(out, tag);
+      fprintf(out, "\"");
     }
-    fprintf(stderr, "}\n");
+    fprintf(out, "}\n");
     return;
   }
 
   if (path[0] && line) {
-    fprintf(stderr, "sem: %s: %s (%s:%u)\n", code, msg, path, (unsigned)line);
+    fprintf(out, "sem: %s: %s (%s:%u)\n", code, msg, path, (unsigned)line);
   } else if (path[0]) {
-    fprintf(stderr, "sem: %s: %s (%s)\n", code, msg, path);
+    fprintf(out, "sem: %s: %s (%s)\n", code, msg, path);
   } else {
-    fprintf(stderr, "sem: %s: %s\n", code, msg);
+    fprintf(out, "sem: %s: %s\n", code, msg);
   }
   if (node || tag[0]) {
-    fprintf(stderr, "sem:   at node=%u tag=%s\n", (unsigned)node, tag);
+    fprintf(out, "sem:   at node=%u tag=%s\n", (unsigned)node, tag);
   }
   if (fid) {
-    fprintf(stderr, "sem:   at fid=%u ip=%u op=%s\n", (unsigned)fid, (unsigned)ip, op[0] ? op : "?");
+    fprintf(out, "sem:   at fid=%u ip=%u op=%s\n", (unsigned)fid, (unsigned)ip, op[0] ? op : "?");
   }
 }
 
 static void sem_print_diag(const sirj_ctx_t* c) {
   if (!c || !c->diag.set) return;
+  FILE* out = c->diag_out ? c->diag_out : stderr;
   if (c->diag_all && c->diag_count) {
     for (uint32_t i = 0; i < c->diag_count; i++) {
-      sem_print_one_diag(c->diag_format, c->diags[i].code, c->diags[i].msg, c->diags[i].path, c->diags[i].line, c->diags[i].node_id,
+      sem_print_one_diag(out, c->diag_format, c->diags[i].code, c->diags[i].msg, c->diags[i].path, c->diags[i].line, c->diags[i].node_id,
                          c->diags[i].tag, c->diags[i].fid, c->diags[i].ip, c->diags[i].op);
     }
     return;
   }
-  sem_print_one_diag(c->diag_format, c->diag.code, c->diag.msg, c->diag.path, c->diag.line, c->diag.node_id, c->diag.tag, c->diag.fid, c->diag.ip,
-                     c->diag.op);
+  sem_print_one_diag(out, c->diag_format, c->diag.code, c->diag.msg, c->diag.path, c->diag.line, c->diag.node_id, c->diag.tag, c->diag.fid,
+                     c->diag.ip, c->diag.op);
 }
 
 typedef struct sem_last_step {
@@ -430,6 +532,8 @@ static void ctx_dispose(sirj_ctx_t* c) {
   free(c->val_by_node);
   free(c->kind_by_node);
   free(c->func_by_node);
+  free(c->sym_by_name.entries);
+  free(c->func_by_name.entries);
   arena_free(&c->arena);
   memset(c, 0, sizeof(*c));
 }
@@ -499,6 +603,59 @@ static uint64_t sirj_hash_num(uint32_t x) {
   return v;
 }
 
+static bool sirj_names_grow(sirj_namemap_t* m) {
+  const uint32_t new_cap = m->cap ? m->cap * 2u : 64u;
+  sirj_namemap_entry_t* ne = (sirj_namemap_entry_t*)calloc((size_t)new_cap, sizeof(sirj_namemap_entry_t));
+  if (!ne) return false;
+  for (uint32_t i = 0; i < m->cap; i++) {
+    const sirj_namemap_entry_t* e = &m->entries[i];
+    if (!e->h) continue;
+    uint32_t idx = (uint32_t)e->h & (new_cap - 1u);
+    while (ne[idx].h) idx = (idx + 1u) & (new_cap - 1u);
+    ne[idx] = *e;
+  }
+  free(m->entries);
+  m->entries = ne;
+  m->cap = new_cap;
+  return true;
+}
+
+// Inserts name -> id unless the name is already present.
+static bool sirj_names_put_first(sirj_namemap_t* m, const char* name, uint32_t id) {
+  if ((m->len + 1u) * 10u >= m->cap * 7u) {
+    if (!sirj_names_grow(m)) return false;
+  }
+  uint64_t h = sirj_hash_str(name);
+  if (!h) h = 1;
+  uint32_t idx = (uint32_t)h & (m->cap - 1u);
+  for (;;) {
+    sirj_namemap_entry_t* e = &m->entries[idx];
+    if (!e->h) {
+      *e = (sirj_namemap_entry_t){.h = h, .name = name, .id = id};
+      m->len++;
+      return true;
+    }
+    if (e->h == h && strcmp(e->name, name) == 0) return true;
+    idx = (idx + 1u) & (m->cap - 1u);
+  }
+}
+
+static bool sirj_names_get(const sirj_namemap_t* m, const char* name, uint32_t* out_id) {
+  if (!m->cap) return false;
+  uint64_t h = sirj_hash_str(name);
+  if (!h) h = 1;
+  uint32_t idx = (uint32_t)h & (m->cap - 1u);
+  for (;;) {
+    const sirj_namemap_entry_t* e = &m->entries[idx];
+    if (!e->h) return false;
+    if (e->h == h && strcmp(e->name, name) == 0) {
+      *out_id = e->id;
+      return true;
+    }
+    idx = (idx + 1u) & (m->cap - 1u);
+  }
+}
+
 static bool sirj_ids_grow(sirj_idmap_t* m) {
   if (!m) return false;
   const uint32_t old_cap = m->cap;
@@ -594,16 +751,16 @@ static bool json_get_bool(const JsonValue* v, bool* out) {
   return true;
 }
 
-static const JsonValue* obj_req(const JsonValue* obj, const char* key) {
-  const JsonValue* v = json_obj_get(obj, key);
+static const JsonValue* obj_req(const JsonValue* obj, JsonKey key) {
+  const JsonValue* v = json_obj_get_sym(obj, key);
   return v;
 }
 
 static bool parse_ref_id(sirj_ctx_t* c, const JsonValue* v, uint32_t* out_id) {
   if (!out_id) return false;
   if (!json_is_object(v)) return false;
-  const JsonValue* tv = json_obj_get(v, "t");
-  const JsonValue* idv = json_obj_get(v, "id");
+  const JsonValue* tv = json_obj_get_sym(v, JSON_KEY_T);
+  const JsonValue* idv = json_obj_get_sym(v, JSON_KEY_ID);
   const char* ts = json_get_string(tv);
   if (!ts || strcmp(ts, "ref") != 0) return false;
   return sirj_intern_id(c, idv, out_id);
@@ -613,9 +770,9 @@ static bool parse_sym_value(const JsonValue* v, const char** out_name) {
   if (!out_name) return false;
   *out_name = NULL;
   if (!json_is_object(v)) return false;
-  const char* t = json_get_string(json_obj_get(v, "t"));
+  const char* t = json_get_string(json_obj_get_sym(v, JSON_KEY_T));
   if (!t || strcmp(t, "sym") != 0) return false;
-  const char* nm = json_get_string(json_obj_get(v, "v"));
+  const char* nm = json_get_string(json_obj_get_sym(v, JSON_KEY_V));
   if (!nm || !nm[0]) return false;
   *out_name = nm;
   return true;
@@ -880,9 +1037,9 @@ static bool emit_call_fun_sym_slots(sirj_ctx_t* c, uint32_t callsite_node_id, ui
   if (!c) return false;
   if (fun_sym_node_id >= c->node_cap || !c->nodes[fun_sym_node_id].present) return false;
   const node_info_t* callee_n = &c->nodes[fun_sym_node_id];
-  if (!callee_n->tag || strcmp(callee_n->tag, "fun.sym") != 0) return false;
+  if (callee_n->tag_id != SIRJ_TAG_FUN_SYM) return false;
   if (!callee_n->fields_obj || callee_n->fields_obj->type != JSON_OBJECT) return false;
-  const char* fn_name = json_get_string(json_obj_get(callee_n->fields_obj, "name"));
+  const char* fn_name = json_get_string(json_obj_get_sym(callee_n->fields_obj, JSON_KEY_NAME));
   if (!fn_name) return false;
 
   sir_func_id_t callee_fid = 0;
@@ -944,9 +1101,9 @@ static bool emit_call_fun_sym(sirj_ctx_t* c, uint32_t callsite_node_id, uint32_t
   if (!c) return false;
   if (fun_sym_node_id >= c->node_cap || !c->nodes[fun_sym_node_id].present) return false;
   const node_info_t* callee_n = &c->nodes[fun_sym_node_id];
-  if (!callee_n->tag || strcmp(callee_n->tag, "fun.sym") != 0) return false;
+  if (callee_n->tag_id != SIRJ_TAG_FUN_SYM) return false;
   if (!callee_n->fields_obj || callee_n->fields_obj->type != JSON_OBJECT) return false;
-  const char* fn_name = json_get_string(json_obj_get(callee_n->fields_obj, "name"));
+  const char* fn_name = json_get_string(json_obj_get_sym(callee_n->fields_obj, JSON_KEY_NAME));
   if (!fn_name) return false;
 
   sir_func_id_t callee_fid = 0;
@@ -1050,18 +1207,18 @@ static bool parse_sem_branch(sirj_ctx_t* c, const JsonValue* v, sem_branch_t* ou
   if (!out) return false;
   memset(out, 0, sizeof(*out));
   if (!json_is_object(v)) return false;
-  const char* k = json_get_string(json_obj_get((JsonValue*)v, "kind"));
+  const char* k = json_get_string(json_obj_get_sym((JsonValue*)v, JSON_KEY_KIND));
   if (!k) return false;
   if (strcmp(k, "val") == 0) {
     uint32_t rid = 0;
-    if (!parse_ref_id(c, json_obj_get((JsonValue*)v, "v"), &rid)) return false;
+    if (!parse_ref_id(c, json_obj_get_sym((JsonValue*)v, JSON_KEY_V), &rid)) return false;
     out->kind = SEM_BRANCH_VAL;
     out->node_id = rid;
     return true;
   }
   if (strcmp(k, "thunk") == 0) {
     uint32_t rid = 0;
-    if (!parse_ref_id(c, json_obj_get((JsonValue*)v, "f"), &rid)) return false;
+    if (!parse_ref_id(c, json_obj_get_sym((JsonValue*)v, JSON_KEY_F), &rid)) return false;
     out->kind = SEM_BRANCH_THUNK;
     out->node_id = rid;
     return true;
@@ -1079,10 +1236,10 @@ static bool resolve_decl_fn_sym(sirj_ctx_t* c, uint32_t node_id, sir_sym_id_t* o
 
   if (node_id >= c->node_cap || !c->nodes[node_id].present) return false;
   const node_info_t* n = &c->nodes[node_id];
-  if (!n->tag || strcmp(n->tag, "decl.fn") != 0) return false;
+  if (n->tag_id != SIRJ_TAG_DECL_FN) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
 
-  const JsonValue* namev = json_obj_get(n->fields_obj, "name");
+  const JsonValue* namev = json_obj_get_sym(n->fields_obj, JSON_KEY_NAME);
   const char* nm = json_get_string(namev);
   if (!nm || nm[0] == '\0') return false;
 
@@ -1401,7 +1558,7 @@ static bool build_const_bytes(sirj_ctx_t* c, uint32_t node_id, uint32_t type_ref
   if (!type_layout(c, type_ref, &size, &align)) return false;
   (void)align;
 
-  if (strcmp(n->tag, "const.zero") == 0) {
+  if (n->tag_id == SIRJ_TAG_CONST_ZERO) {
     if (n->type_ref != type_ref) return false;
     uint8_t* b = (uint8_t*)arena_alloc(&c->arena, size);
     if (!b && size) return false;
@@ -1411,13 +1568,13 @@ static bool build_const_bytes(sirj_ctx_t* c, uint32_t node_id, uint32_t type_ref
     return true;
   }
 
-  if (strcmp(n->tag, "const.i8") == 0) {
+  if (n->tag_id == SIRJ_TAG_CONST_I8) {
     if (size != 1) return false;
     if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
     uint8_t* b = (uint8_t*)arena_alloc(&c->arena, 1);
     if (!b) return false;
     int64_t v = 0;
-    if (!json_get_i64(json_obj_get(n->fields_obj, "value"), &v)) return false;
+    if (!json_get_i64(json_obj_get_sym(n->fields_obj, JSON_KEY_VALUE), &v)) return false;
     if (v < 0 || v > 255) return false;
     b[0] = (uint8_t)v;
     *out_bytes = b;
@@ -1425,11 +1582,11 @@ static bool build_const_bytes(sirj_ctx_t* c, uint32_t node_id, uint32_t type_ref
     return true;
   }
 
-  if (strcmp(n->tag, "const.i16") == 0) {
+  if (n->tag_id == SIRJ_TAG_CONST_I16) {
     if (size != 2) return false;
     if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
     int64_t v = 0;
-    if (!json_get_i64(json_obj_get(n->fields_obj, "value"), &v)) return false;
+    if (!json_get_i64(json_obj_get_sym(n->fields_obj, JSON_KEY_VALUE), &v)) return false;
     if (v < 0 || v > 65535) return false;
     uint8_t* b = (uint8_t*)arena_alloc(&c->arena, 2);
     if (!b) return false;
@@ -1440,11 +1597,11 @@ static bool build_const_bytes(sirj_ctx_t* c, uint32_t node_id, uint32_t type_ref
     return true;
   }
 
-  if (strcmp(n->tag, "const.i32") == 0) {
+  if (n->tag_id == SIRJ_TAG_CONST_I32) {
     if (size != 4) return false;
     int64_t v = 0;
     if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-    if (!json_get_i64(json_obj_get(n->fields_obj, "value"), &v)) return false;
+    if (!json_get_i64(json_obj_get_sym(n->fields_obj, JSON_KEY_VALUE), &v)) return false;
     if (v < INT32_MIN || v > INT32_MAX) return false;
     uint8_t* b = (uint8_t*)arena_alloc(&c->arena, 4);
     if (!b) return false;
@@ -1455,11 +1612,11 @@ static bool build_const_bytes(sirj_ctx_t* c, uint32_t node_id, uint32_t type_ref
     return true;
   }
 
-  if (strcmp(n->tag, "const.i64") == 0) {
+  if (n->tag_id == SIRJ_TAG_CONST_I64) {
     if (size != 8) return false;
     int64_t v = 0;
     if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-    if (!json_get_i64(json_obj_get(n->fields_obj, "value"), &v)) return false;
+    if (!json_get_i64(json_obj_get_sym(n->fields_obj, JSON_KEY_VALUE), &v)) return false;
     uint8_t* b = (uint8_t*)arena_alloc(&c->arena, 8);
     if (!b) return false;
     memcpy(b, &v, 8);
@@ -1468,10 +1625,10 @@ static bool build_const_bytes(sirj_ctx_t* c, uint32_t node_id, uint32_t type_ref
     return true;
   }
 
-  if (strcmp(n->tag, "const.f32") == 0) {
+  if (n->tag_id == SIRJ_TAG_CONST_F32) {
     if (size != 4) return false;
     if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-    const char* bits_s = json_get_string(json_obj_get(n->fields_obj, "bits"));
+    const char* bits_s = json_get_string(json_obj_get_sym(n->fields_obj, JSON_KEY_BITS));
     uint32_t bits = 0;
     if (!parse_hex_u32(bits_s, &bits)) return false;
     bits = sem_f32_canon_bits(bits);
@@ -1483,10 +1640,10 @@ static bool build_const_bytes(sirj_ctx_t* c, uint32_t node_id, uint32_t type_ref
     return true;
   }
 
-  if (strcmp(n->tag, "const.f64") == 0) {
+  if (n->tag_id == SIRJ_TAG_CONST_F64) {
     if (size != 8) return false;
     if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-    const char* bits_s = json_get_string(json_obj_get(n->fields_obj, "bits"));
+    const char* bits_s = json_get_string(json_obj_get_sym(n->fields_obj, JSON_KEY_BITS));
     uint64_t bits = 0;
     if (!parse_hex_u64(bits_s, &bits)) return false;
     bits = sem_f64_canon_bits(bits);
@@ -1498,7 +1655,7 @@ static bool build_const_bytes(sirj_ctx_t* c, uint32_t node_id, uint32_t type_ref
     return true;
   }
 
-  if (strcmp(n->tag, "const.struct") == 0) {
+  if (n->tag_id == SIRJ_TAG_CONST_STRUCT) {
     if (n->type_ref != type_ref) return false;
     if (type_ref == 0 || type_ref >= c->type_cap) return false;
     const type_info_t* t = &c->types[type_ref];
@@ -1536,7 +1693,7 @@ static bool build_const_bytes(sirj_ctx_t* c, uint32_t node_id, uint32_t type_ref
       }
     }
 
-    const JsonValue* fv = json_obj_get(n->fields_obj, "fields");
+    const JsonValue* fv = json_obj_get_sym(n->fields_obj, JSON_KEY_FIELDS);
     if (!fv) {
       *out_bytes = b;
       *out_len = size;
@@ -1551,13 +1708,13 @@ static bool build_const_bytes(sirj_ctx_t* c, uint32_t node_id, uint32_t type_ref
       const JsonValue* asn = a->items[ai];
       if (!json_is_object(asn)) return false;
       uint32_t fi = 0;
-      if (!json_get_u32(json_obj_get(asn, "i"), &fi)) return false;
+      if (!json_get_u32(json_obj_get_sym(asn, JSON_KEY_I), &fi)) return false;
       if (fi >= nfield) return false;
       if (prev_set && fi <= prev_i) return false;
       prev_i = fi;
       prev_set = true;
 
-      const JsonValue* vv = json_obj_get(asn, "v");
+      const JsonValue* vv = json_obj_get_sym(asn, JSON_KEY_V);
       uint32_t rid = 0;
       if (!parse_ref_id(c, vv, &rid)) return false;
       uint8_t* eb = NULL;
@@ -1573,12 +1730,12 @@ static bool build_const_bytes(sirj_ctx_t* c, uint32_t node_id, uint32_t type_ref
     return true;
   }
 
-  if (strcmp(n->tag, "const.array") == 0) {
+  if (n->tag_id == SIRJ_TAG_CONST_ARRAY) {
     if (n->type_ref != type_ref) return false;
     const type_info_t* t = &c->types[type_ref];
     if (!t->present || !t->is_array) return false;
     if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-    const JsonValue* ev = json_obj_get(n->fields_obj, "elems");
+    const JsonValue* ev = json_obj_get_sym(n->fields_obj, JSON_KEY_ELEMS);
     if (!json_is_array(ev)) return false;
     if (ev->v.arr.len != t->array_len) return false;
 
@@ -1605,16 +1762,16 @@ static bool build_const_bytes(sirj_ctx_t* c, uint32_t node_id, uint32_t type_ref
     return true;
   }
 
-  if (strcmp(n->tag, "const.repeat") == 0) {
+  if (n->tag_id == SIRJ_TAG_CONST_REPEAT) {
     if (n->type_ref != type_ref) return false;
     const type_info_t* t = &c->types[type_ref];
     if (!t->present || !t->is_array) return false;
     if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
     uint32_t count = 0;
-    if (!json_get_u32(json_obj_get(n->fields_obj, "count"), &count)) return false;
+    if (!json_get_u32(json_obj_get_sym(n->fields_obj, JSON_KEY_COUNT), &count)) return false;
     if (count != t->array_len) return false;
     uint32_t elem_id = 0;
-    if (!parse_ref_id(c, json_obj_get(n->fields_obj, "elem"), &elem_id)) return false;
+    if (!parse_ref_id(c, json_obj_get_sym(n->fields_obj, JSON_KEY_ELEM), &elem_id)) return false;
 
     uint32_t es = 0, ea = 0;
     if (!type_layout(c, t->array_of, &es, &ea)) return false;
@@ -1667,7 +1824,7 @@ static bool eval_const_i1(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n,
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
   int64_t i = 0;
-  if (!json_get_i64(json_obj_get(n->fields_obj, "value"), &i)) return false;
+  if (!json_get_i64(json_obj_get_sym(n->fields_obj, JSON_KEY_VALUE), &i)) return false;
   if (i != 0 && i != 1) return false;
   const sir_val_id_t slot = alloc_slot(c, VK_I1);
   sir_mb_set_src(c->mb, node_id, n->loc_line);
@@ -1681,7 +1838,7 @@ static bool eval_const_i1(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n,
 static bool eval_const_i32(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* vv = json_obj_get(n->fields_obj, "value");
+  const JsonValue* vv = json_obj_get_sym(n->fields_obj, JSON_KEY_VALUE);
   int64_t i = 0;
   if (!json_get_i64(vv, &i)) return false;
   if (i < INT32_MIN || i > INT32_MAX) return false;
@@ -1697,7 +1854,7 @@ static bool eval_const_i32(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n
 static bool eval_const_i8(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* vv = json_obj_get(n->fields_obj, "value");
+  const JsonValue* vv = json_obj_get_sym(n->fields_obj, JSON_KEY_VALUE);
   int64_t i = 0;
   if (!json_get_i64(vv, &i)) return false;
   if (i < 0 || i > 255) return false;
@@ -1713,7 +1870,7 @@ static bool eval_const_i8(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n,
 static bool eval_const_i16(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* vv = json_obj_get(n->fields_obj, "value");
+  const JsonValue* vv = json_obj_get_sym(n->fields_obj, JSON_KEY_VALUE);
   int64_t i = 0;
   if (!json_get_i64(vv, &i)) return false;
   if (i < 0 || i > 65535) return false;
@@ -1729,7 +1886,7 @@ static bool eval_const_i16(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n
 static bool eval_const_i64(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* vv = json_obj_get(n->fields_obj, "value");
+  const JsonValue* vv = json_obj_get_sym(n->fields_obj, JSON_KEY_VALUE);
   int64_t i = 0;
   if (!json_get_i64(vv, &i)) return false;
   const sir_val_id_t slot = alloc_slot(c, VK_I64);
@@ -1744,7 +1901,7 @@ static bool eval_const_i64(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n
 static bool eval_const_f32(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const char* bits_s = json_get_string(json_obj_get(n->fields_obj, "bits"));
+  const char* bits_s = json_get_string(json_obj_get_sym(n->fields_obj, JSON_KEY_BITS));
   uint32_t bits = 0;
   if (!parse_hex_u32(bits_s, &bits)) return false;
   bits = sem_f32_canon_bits(bits);
@@ -1760,7 +1917,7 @@ static bool eval_const_f32(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n
 static bool eval_const_f64(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const char* bits_s = json_get_string(json_obj_get(n->fields_obj, "bits"));
+  const char* bits_s = json_get_string(json_obj_get_sym(n->fields_obj, JSON_KEY_BITS));
   uint64_t bits = 0;
   if (!parse_hex_u64(bits_s, &bits)) return false;
   bits = sem_f64_canon_bits(bits);
@@ -1776,7 +1933,7 @@ static bool eval_const_f64(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n
 static bool eval_const_bool(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* vv = json_obj_get(n->fields_obj, "value");
+  const JsonValue* vv = json_obj_get_sym(n->fields_obj, JSON_KEY_VALUE);
   int64_t i = 0;
   if (!json_get_i64(vv, &i)) return false;
   if (i != 0 && i != 1) return false;
@@ -1808,16 +1965,16 @@ static bool eval_store_mnemonic(sirj_ctx_t* c, uint32_t node_id, const node_info
     return false;
   }
   uint32_t addr_id = 0, val_id = 0;
-  if (!parse_ref_id(c, json_obj_get(n->fields_obj, "addr"), &addr_id)) {
+  if (!parse_ref_id(c, json_obj_get_sym(n->fields_obj, JSON_KEY_ADDR), &addr_id)) {
     sirj_diag_setf(c, "sem.parse.store.addr", c->cur_path, n->loc_line, node_id, n->tag, "%s addr must be a ref", n->tag);
     return false;
   }
-  if (!parse_ref_id(c, json_obj_get(n->fields_obj, "value"), &val_id)) {
+  if (!parse_ref_id(c, json_obj_get_sym(n->fields_obj, JSON_KEY_VALUE), &val_id)) {
     sirj_diag_setf(c, "sem.parse.store.value", c->cur_path, n->loc_line, node_id, n->tag, "%s value must be a ref", n->tag);
     return false;
   }
   uint32_t align = 0;
-  const JsonValue* alignv = json_obj_get(n->fields_obj, "align");
+  const JsonValue* alignv = json_obj_get_sym(n->fields_obj, JSON_KEY_ALIGN);
   if (alignv) {
     if (!json_get_u32(alignv, &align) || align == 0) {
       sirj_diag_setf(c, "sem.parse.store.align", c->cur_path, n->loc_line, node_id, n->tag, "%s align must be a positive integer", n->tag);
@@ -1861,7 +2018,7 @@ static bool eval_store_mnemonic(sirj_ctx_t* c, uint32_t node_id, const node_info
 static bool eval_mem_copy_stmt(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n) {
   if (!c || !n) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 3) {
     sirj_diag_setf(c, "sem.parse.mem.copy.args", c->cur_path, n->loc_line, node_id, n->tag, "mem.copy args must be [dst, src, len]");
     return false;
@@ -1881,10 +2038,10 @@ static bool eval_mem_copy_stmt(sirj_ctx_t* c, uint32_t node_id, const node_info_
   if (lk != VK_I64 && lk != VK_I32) return false;
 
   bool overlap_allow = false;
-  const JsonValue* fv = json_obj_get(n->fields_obj, "flags");
+  const JsonValue* fv = json_obj_get_sym(n->fields_obj, JSON_KEY_FLAGS);
   if (fv) {
     if (!json_is_object(fv)) return false;
-    const char* ov = json_get_string(json_obj_get(fv, "overlap"));
+    const char* ov = json_get_string(json_obj_get_sym(fv, JSON_KEY_OVERLAP));
     if (ov) {
       if (strcmp(ov, "allow") == 0) overlap_allow = true;
       else if (strcmp(ov, "disallow") == 0) overlap_allow = false;
@@ -1903,7 +2060,7 @@ static bool eval_mem_copy_stmt(sirj_ctx_t* c, uint32_t node_id, const node_info_
 static bool eval_mem_fill_stmt(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n) {
   if (!c || !n) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 3) {
     sirj_diag_setf(c, "sem.parse.mem.fill.args", c->cur_path, n->loc_line, node_id, n->tag, "mem.fill args must be [dst, byte, len]");
     return false;
@@ -1924,7 +2081,7 @@ static bool eval_mem_fill_stmt(sirj_ctx_t* c, uint32_t node_id, const node_info_
   if (lk != VK_I64 && lk != VK_I32) return false;
 
   // ignore flags for now (alignDst/vol)
-  const JsonValue* fv = json_obj_get(n->fields_obj, "flags");
+  const JsonValue* fv = json_obj_get_sym(n->fields_obj, JSON_KEY_FLAGS);
   if (fv && !json_is_object(fv)) return false;
 
   sir_mb_set_src(c->mb, node_id, n->loc_line);
@@ -1939,12 +2096,12 @@ static bool eval_load_mnemonic(sirj_ctx_t* c, uint32_t node_id, const node_info_
     return false;
   }
   uint32_t addr_id = 0;
-  if (!parse_ref_id(c, json_obj_get(n->fields_obj, "addr"), &addr_id)) {
+  if (!parse_ref_id(c, json_obj_get_sym(n->fields_obj, JSON_KEY_ADDR), &addr_id)) {
     sirj_diag_setf(c, "sem.parse.load.addr", c->cur_path, n->loc_line, node_id, n->tag, "%s addr must be a ref", n->tag);
     return false;
   }
   uint32_t align = 0;
-  const JsonValue* alignv = json_obj_get(n->fields_obj, "align");
+  const JsonValue* alignv = json_obj_get_sym(n->fields_obj, JSON_KEY_ALIGN);
   if (alignv) {
     if (!json_get_u32(alignv, &align) || align == 0) {
       sirj_diag_setf(c, "sem.parse.load.align", c->cur_path, n->loc_line, node_id, n->tag, "%s align must be a positive integer", n->tag);
@@ -1992,7 +2149,7 @@ static bool eval_load_mnemonic(sirj_ctx_t* c, uint32_t node_id, const node_info_
 static bool eval_cstr(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* vv = json_obj_get(n->fields_obj, "value");
+  const JsonValue* vv = json_obj_get_sym(n->fields_obj, JSON_KEY_VALUE);
   const char* s = json_get_string(vv);
   if (!s) return false;
   const uint32_t len = (uint32_t)strlen(s);
@@ -2010,7 +2167,7 @@ static bool eval_cstr(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, sir
 static bool eval_name(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const char* nm = json_get_string(json_obj_get(n->fields_obj, "name"));
+  const char* nm = json_get_string(json_obj_get_sym(n->fields_obj, JSON_KEY_NAME));
   if (!nm) return false;
 
   // Let bindings shadow params.
@@ -2044,7 +2201,7 @@ static bool eval_i32_add_mnemonic(sirj_ctx_t* c, uint32_t node_id, const node_in
     sirj_diag_setf(c, "sem.parse.i32.add.fields", c->cur_path, n->loc_line, node_id, n->tag, "i32.add missing/invalid fields object");
     return false;
   }
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 2) {
     sirj_diag_setf(c, "sem.parse.i32.add.args", c->cur_path, n->loc_line, node_id, n->tag, "i32.add args must be [a, b]");
     return false;
@@ -2082,7 +2239,7 @@ static bool eval_i32_bin_mnemonic(sirj_ctx_t* c, uint32_t node_id, const node_in
     sirj_diag_setf(c, "sem.parse.i32.bin.fields", c->cur_path, n->loc_line, node_id, n->tag, "%s missing/invalid fields object", n->tag);
     return false;
   }
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 2) {
     sirj_diag_setf(c, "sem.parse.i32.bin.args", c->cur_path, n->loc_line, node_id, n->tag, "%s args must be [a, b]", n->tag);
     return false;
@@ -2163,7 +2320,7 @@ static bool eval_i32_zext_i8(sirj_ctx_t* c, uint32_t node_id, const node_info_t*
     sirj_diag_setf(c, "sem.parse.i32.zext.i8.fields", c->cur_path, n->loc_line, node_id, n->tag, "i32.zext.i8 missing/invalid fields object");
     return false;
   }
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 1) {
     sirj_diag_setf(c, "sem.parse.i32.zext.i8.args", c->cur_path, n->loc_line, node_id, n->tag, "i32.zext.i8 args must be [x]");
     return false;
@@ -2195,7 +2352,7 @@ static bool eval_i32_zext_i16(sirj_ctx_t* c, uint32_t node_id, const node_info_t
     sirj_diag_setf(c, "sem.parse.i32.zext.i16.fields", c->cur_path, n->loc_line, node_id, n->tag, "i32.zext.i16 missing/invalid fields object");
     return false;
   }
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 1) {
     sirj_diag_setf(c, "sem.parse.i32.zext.i16.args", c->cur_path, n->loc_line, node_id, n->tag, "i32.zext.i16 args must be [x]");
     return false;
@@ -2227,7 +2384,7 @@ static bool eval_i64_zext_i32(sirj_ctx_t* c, uint32_t node_id, const node_info_t
     sirj_diag_setf(c, "sem.parse.i64.zext.i32.fields", c->cur_path, n->loc_line, node_id, n->tag, "i64.zext.i32 missing/invalid fields object");
     return false;
   }
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 1) {
     sirj_diag_setf(c, "sem.parse.i64.zext.i32.args", c->cur_path, n->loc_line, node_id, n->tag, "i64.zext.i32 args must be [x]");
     return false;
@@ -2260,7 +2417,7 @@ static bool eval_i32_un_mnemonic(sirj_ctx_t* c, uint32_t node_id, const node_inf
     sirj_diag_setf(c, "sem.parse.i32.un.fields", c->cur_path, n->loc_line, node_id, n->tag, "%s missing/invalid fields object", n->tag);
     return false;
   }
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 1) {
     sirj_diag_setf(c, "sem.parse.i32.un.args", c->cur_path, n->loc_line, node_id, n->tag, "%s args must be [x]", n->tag);
     return false;
@@ -2296,7 +2453,7 @@ static bool eval_i32_trunc_i64(sirj_ctx_t* c, uint32_t node_id, const node_info_
     sirj_diag_setf(c, "sem.parse.i32.trunc.i64.fields", c->cur_path, n->loc_line, node_id, n->tag, "i32.trunc.i64 missing/invalid fields object");
     return false;
   }
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 1) {
     sirj_diag_setf(c, "sem.parse.i32.trunc.i64.args", c->cur_path, n->loc_line, node_id, n->tag, "i32.trunc.i64 args must be [x]");
     return false;
@@ -2325,7 +2482,7 @@ static bool eval_i32_trunc_i64(sirj_ctx_t* c, uint32_t node_id, const node_info_
 static bool eval_i32_cmp_eq(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 2) return false;
   uint32_t a_id = 0, b_id = 0;
   if (!parse_ref_id(c, av->v.arr.items[0], &a_id)) return false;
@@ -2348,8 +2505,8 @@ static bool eval_binop_add(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
   uint32_t a_id = 0, b_id = 0;
-  if (!parse_ref_id(c, json_obj_get(n->fields_obj, "lhs"), &a_id)) return false;
-  if (!parse_ref_id(c, json_obj_get(n->fields_obj, "rhs"), &b_id)) return false;
+  if (!parse_ref_id(c, json_obj_get_sym(n->fields_obj, JSON_KEY_LHS), &a_id)) return false;
+  if (!parse_ref_id(c, json_obj_get_sym(n->fields_obj, JSON_KEY_RHS), &b_id)) return false;
   sir_val_id_t a_slot = 0, b_slot = 0;
   val_kind_t ak = VK_INVALID, bk = VK_INVALID;
   if (!eval_node(c, a_id, &a_slot, &ak)) return false;
@@ -2367,7 +2524,7 @@ static bool eval_binop_add(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n
 static bool eval_ptr_to_i64_passthrough(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 1) return false;
   uint32_t arg_id = 0;
   if (!parse_ref_id(c, av->v.arr.items[0], &arg_id)) return false;
@@ -2392,7 +2549,7 @@ static bool eval_ptr_to_i64_passthrough(sirj_ctx_t* c, uint32_t node_id, const n
 static bool eval_ptr_from_i64(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 1) return false;
   uint32_t arg_id = 0;
   if (!parse_ref_id(c, av->v.arr.items[0], &arg_id)) return false;
@@ -2412,7 +2569,7 @@ static bool eval_ptr_from_i64(sirj_ctx_t* c, uint32_t node_id, const node_info_t
 static bool eval_bool_not(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 1) return false;
   uint32_t x_id = 0;
   if (!parse_ref_id(c, av->v.arr.items[0], &x_id)) return false;
@@ -2433,7 +2590,7 @@ static bool eval_bool_bin(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n,
                           val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 2) return false;
   uint32_t a_id = 0, b_id = 0;
   if (!parse_ref_id(c, av->v.arr.items[0], &a_id)) return false;
@@ -2460,7 +2617,7 @@ static bool eval_i32_cmp(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n,
                          val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 2) return false;
   uint32_t a_id = 0, b_id = 0;
   if (!parse_ref_id(c, av->v.arr.items[0], &a_id)) return false;
@@ -2514,7 +2671,7 @@ static bool eval_i32_cmp(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n,
 static bool eval_f32_cmp_ueq(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 2) return false;
   uint32_t a_id = 0, b_id = 0;
   if (!parse_ref_id(c, av->v.arr.items[0], &a_id)) return false;
@@ -2536,7 +2693,7 @@ static bool eval_f32_cmp_ueq(sirj_ctx_t* c, uint32_t node_id, const node_info_t*
 static bool eval_f64_cmp_olt(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 2) return false;
   uint32_t a_id = 0, b_id = 0;
   if (!parse_ref_id(c, av->v.arr.items[0], &a_id)) return false;
@@ -2560,7 +2717,7 @@ static bool eval_ptr_size_alignof(sirj_ctx_t* c, uint32_t node_id, const node_in
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
   uint32_t ty_id = 0;
-  if (!parse_ref_id(c, json_obj_get(n->fields_obj, "ty"), &ty_id)) {
+  if (!parse_ref_id(c, json_obj_get_sym(n->fields_obj, JSON_KEY_TY), &ty_id)) {
     sirj_diag_setf(c, "sem.ptr.layout.bad_ty", c->cur_path, n->loc_line, node_id, n->tag, "missing/invalid ty ref");
     return false;
   }
@@ -2589,24 +2746,17 @@ static bool eval_ptr_size_alignof(sirj_ctx_t* c, uint32_t node_id, const node_in
 
 static bool find_global_gid_by_name(const sirj_ctx_t* c, const char* name, sir_global_id_t* out_gid) {
   if (!c || !name || !out_gid) return false;
-  for (uint32_t i = 0; i < c->symrec_cap; i++) {
-    if (!c->syms || !c->syms[i].present) continue;
-    if (!c->syms[i].name) continue;
-    if (strcmp(c->syms[i].name, name) == 0) {
-      if (c->syms[i].gid) {
-        *out_gid = c->syms[i].gid;
-        return true;
-      }
-      return false;
-    }
-  }
-  return false;
+  uint32_t i = 0;
+  if (!sirj_names_get(&c->sym_by_name, name, &i) || i >= c->symrec_cap) return false;
+  if (!c->syms[i].gid) return false;
+  *out_gid = c->syms[i].gid;
+  return true;
 }
 
 static bool eval_ptr_sym(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const char* nm = json_get_string(json_obj_get(n->fields_obj, "name"));
+  const char* nm = json_get_string(json_obj_get_sym(n->fields_obj, JSON_KEY_NAME));
   if (!nm) return false;
   sir_global_id_t gid = 0;
   if (find_global_gid_by_name(c, nm, &gid)) {
@@ -2641,7 +2791,7 @@ static bool eval_ptr_offset(sirj_ctx_t* c, uint32_t node_id, const node_info_t*
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
   uint32_t ty_id = 0;
-  if (!parse_ref_id(c, json_obj_get(n->fields_obj, "ty"), &ty_id)) {
+  if (!parse_ref_id(c, json_obj_get_sym(n->fields_obj, JSON_KEY_TY), &ty_id)) {
     sirj_diag_setf(c, "sem.ptr.offset.bad_ty", c->cur_path, n->loc_line, node_id, n->tag, "missing/invalid ty ref");
     return false;
   }
@@ -2655,7 +2805,7 @@ static bool eval_ptr_offset(sirj_ctx_t* c, uint32_t node_id, const node_info_t*
     return false;
   }
   (void)align;
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 2) return false;
   uint32_t base_id = 0, idx_id = 0;
   if (!parse_ref_id(c, av->v.arr.items[0], &base_id)) return false;
@@ -2731,7 +2881,7 @@ static bool eval_select(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, s
       return false;
   }
 
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 3) return false;
   uint32_t cond_id = 0, a_id = 0, b_id = 0;
   if (!parse_ref_id(c, av->v.arr.items[0], &cond_id)) return false;
@@ -2794,7 +2944,7 @@ static bool eval_sem_if(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, s
     return false;
   }
 
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 3) {
     sirj_diag_setf(c, "sem.sem.if.bad_args", c->cur_path, n->loc_line, node_id, n->tag, "sem.if expects args:[cond, then, else]");
     return false;
@@ -2868,7 +3018,7 @@ static bool eval_sem_and_or_sc(sirj_ctx_t* c, uint32_t node_id, const node_info_
     if (!type_to_val_kind(c, n->type_ref, &rk) || rk != VK_BOOL) return false;
   }
 
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 2) {
     sirj_diag_setf(c, "sem.sem.sc.bad_args", c->cur_path, n->loc_line, node_id, n->tag, "%s expects args:[lhs, rhs_thunk|val]",
                    is_or ? "sem.or_sc" : "sem.and_sc");
@@ -2930,7 +3080,7 @@ static bool eval_sem_switch(sirj_ctx_t* c, uint32_t node_id, const node_info_t*
   val_kind_t rk = VK_INVALID;
   if (!type_to_val_kind(c, n->type_ref, &rk) || rk == VK_INVALID || rk == VK_I1) return false;
 
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len < 1) return false;
   uint32_t scrut_id = 0;
   if (!parse_ref_id(c, av->v.arr.items[0], &scrut_id)) return false;
@@ -2939,7 +3089,7 @@ static bool eval_sem_switch(sirj_ctx_t* c, uint32_t node_id, const node_info_t*
   if (!eval_node(c, scrut_id, &scrut_slot, &sk)) return false;
   if (sk != VK_I32) return false; // MVP
 
-  const JsonValue* casesv = json_obj_get(n->fields_obj, "cases");
+  const JsonValue* casesv = json_obj_get_sym(n->fields_obj, JSON_KEY_CASES);
   if (!json_is_array(casesv)) return false;
   const JsonArray* ca = &casesv->v.arr;
   if (ca->len > 64) return false;
@@ -2957,13 +3107,13 @@ static bool eval_sem_switch(sirj_ctx_t* c, uint32_t node_id, const node_info_t*
   for (uint32_t i = 0; i < ncase; i++) {
     if (!json_is_object(ca->items[i])) return false;
     uint32_t lit_id = 0;
-    if (!parse_ref_id(c, json_obj_get(ca->items[i], "lit"), &lit_id)) return false;
+    if (!parse_ref_id(c, json_obj_get_sym(ca->items[i], JSON_KEY_LIT), &lit_id)) return false;
     if (!parse_const_i32_value(c, lit_id, &case_lits[i])) return false;
-    if (!parse_sem_branch(c, json_obj_get(ca->items[i], "body"), &case_body[i])) return false;
+    if (!parse_sem_branch(c, json_obj_get_sym(ca->items[i], JSON_KEY_BODY), &case_body[i])) return false;
     case_target[i] = 0;
   }
   sem_branch_t defb = {0};
-  if (!parse_sem_branch(c, json_obj_get(n->fields_obj, "default"), &defb)) return false;
+  if (!parse_sem_branch(c, json_obj_get_sym(n->fields_obj, JSON_KEY_DEFAULT), &defb)) return false;
 
   const sir_val_id_t res = alloc_slot(c, rk);
   uint32_t ip_sw = 0;
@@ -3013,7 +3163,7 @@ static bool eval_sem_cond(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n,
 static bool eval_ptr_addsub(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, bool is_sub, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 2) return false;
   uint32_t base_id = 0, off_id = 0;
   if (!parse_ref_id(c, av->v.arr.items[0], &base_id)) return false;
@@ -3038,7 +3188,7 @@ static bool eval_ptr_addsub(sirj_ctx_t* c, uint32_t node_id, const node_info_t*
 static bool eval_ptr_cmp(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, bool is_ne, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 2) return false;
   uint32_t a_id = 0, b_id = 0;
   if (!parse_ref_id(c, av->v.arr.items[0], &a_id)) return false;
@@ -3183,10 +3333,10 @@ static bool eval_adt_make(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n,
     return false;
   }
 
-  const JsonValue* flags = json_obj_get(n->fields_obj, "flags");
+  const JsonValue* flags = json_obj_get_sym(n->fields_obj, JSON_KEY_FLAGS);
   if (!json_is_object(flags)) return false;
   uint32_t variant = 0;
-  if (!json_get_u32(json_obj_get((JsonValue*)flags, "variant"), &variant)) return false;
+  if (!json_get_u32(json_obj_get_sym((JsonValue*)flags, JSON_KEY_VARIANT), &variant)) return false;
 
   uint32_t payload_ty = 0;
   if (!sum_variant_payload_type(c, sum_ty, variant, &payload_ty)) {
@@ -3199,7 +3349,7 @@ static bool eval_adt_make(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n,
     return true;
   }
 
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (payload_ty == 0) {
     if (av && json_is_array(av) && av->v.arr.len != 0) return false;
   } else {
@@ -3290,7 +3440,7 @@ static bool eval_adt_make(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n,
 static bool eval_adt_tag(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 1) return false;
   uint32_t vid = 0;
   if (!parse_ref_id(c, av->v.arr.items[0], &vid)) return false;
@@ -3309,12 +3459,12 @@ static bool eval_adt_tag(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n,
 static bool eval_adt_is(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* flags = json_obj_get(n->fields_obj, "flags");
+  const JsonValue* flags = json_obj_get_sym(n->fields_obj, JSON_KEY_FLAGS);
   if (!json_is_object(flags)) return false;
   uint32_t variant = 0;
-  if (!json_get_u32(json_obj_get((JsonValue*)flags, "variant"), &variant)) return false;
+  if (!json_get_u32(json_obj_get_sym((JsonValue*)flags, JSON_KEY_VARIANT), &variant)) return false;
 
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 1) return false;
   uint32_t vid = 0;
   if (!parse_ref_id(c, av->v.arr.items[0], &vid)) return false;
@@ -3343,10 +3493,10 @@ static bool eval_adt_get(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n,
 
   const uint32_t sum_ty = n->type_ref;
   if (sum_ty == 0 || sum_ty >= c->type_cap || !c->types[sum_ty].present || !c->types[sum_ty].is_sum) return false;
-  const JsonValue* flags = json_obj_get(n->fields_obj, "flags");
+  const JsonValue* flags = json_obj_get_sym(n->fields_obj, JSON_KEY_FLAGS);
   if (!json_is_object(flags)) return false;
   uint32_t variant = 0;
-  if (!json_get_u32(json_obj_get((JsonValue*)flags, "variant"), &variant)) return false;
+  if (!json_get_u32(json_obj_get_sym((JsonValue*)flags, JSON_KEY_VARIANT), &variant)) return false;
   uint32_t payload_ty = 0;
   if (!sum_variant_payload_type(c, sum_ty, variant, &payload_ty)) {
     sir_mb_set_src(c->mb, node_id, n->loc_line);
@@ -3358,7 +3508,7 @@ static bool eval_adt_get(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n,
   }
   if (payload_ty == 0) return false;
 
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 1) return false;
   uint32_t vid = 0;
   if (!parse_ref_id(c, av->v.arr.items[0], &vid)) return false;
@@ -3470,7 +3620,7 @@ static bool eval_sem_match_sum(sirj_ctx_t* c, uint32_t node_id, const node_info_
 
   // Sum type reference.
   uint32_t sum_ty = 0;
-  const JsonValue* sumref = json_obj_get(n->fields_obj, "sum");
+  const JsonValue* sumref = json_obj_get_sym(n->fields_obj, JSON_KEY_SUM);
   if (!parse_ref_id(c, sumref, &sum_ty)) {
     sirj_diag_setf(c, "sem.sem.match_sum.bad_sum", c->cur_path, n->loc_line, node_id, n->tag, "sem.match_sum sum must be a type ref");
     return false;
@@ -3481,7 +3631,7 @@ static bool eval_sem_match_sum(sirj_ctx_t* c, uint32_t node_id, const node_info_
   }
 
   // Args: [scrut]
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 1) {
     sirj_diag_setf(c, "sem.sem.match_sum.bad_args", c->cur_path, n->loc_line, node_id, n->tag, "sem.match_sum expects args:[scrut]");
     return false;
@@ -3501,7 +3651,7 @@ static bool eval_sem_match_sum(sirj_ctx_t* c, uint32_t node_id, const node_info_
   if (sk != VK_PTR) return false;
 
   // Cases.
-  const JsonValue* casesv = json_obj_get(n->fields_obj, "cases");
+  const JsonValue* casesv = json_obj_get_sym(n->fields_obj, JSON_KEY_CASES);
   if (!json_is_array(casesv)) return false;
   const JsonArray* ca = &casesv->v.arr;
   if (ca->len > 64) return false;
@@ -3521,7 +3671,7 @@ static bool eval_sem_match_sum(sirj_ctx_t* c, uint32_t node_id, const node_info_
   for (uint32_t i = 0; i < ncase; i++) {
     if (!json_is_object(ca->items[i])) return false;
     uint32_t variant = 0;
-    if (!json_get_u32(json_obj_get(ca->items[i], "variant"), &variant)) return false;
+    if (!json_get_u32(json_obj_get_sym(ca->items[i], JSON_KEY_VARIANT), &variant)) return false;
     if (variant >= c->types[sum_ty].sum_variant_count) return false;
 
     // reject duplicates (small N, O(N^2) is fine)
@@ -3531,7 +3681,7 @@ static bool eval_sem_match_sum(sirj_ctx_t* c, uint32_t node_id, const node_info_
 
     case_variant_u32[i] = variant;
     case_lits[i] = (int32_t)variant;
-    if (!parse_sem_branch(c, json_obj_get(ca->items[i], "body"), &case_body[i])) return false;
+    if (!parse_sem_branch(c, json_obj_get_sym(ca->items[i], JSON_KEY_BODY), &case_body[i])) return false;
     case_target[i] = 0;
 
     // If it's a thunk branch, validate signature against variant payload and result type.
@@ -3539,7 +3689,7 @@ static bool eval_sem_match_sum(sirj_ctx_t* c, uint32_t node_id, const node_info_
       const uint32_t fun_node = case_body[i].node_id;
       if (fun_node >= c->node_cap || !c->nodes[fun_node].present) return false;
       const node_info_t* fn = &c->nodes[fun_node];
-      if (!fn->tag || strcmp(fn->tag, "fun.sym") != 0) return false;
+      if (fn->tag_id != SIRJ_TAG_FUN_SYM) return false;
       const uint32_t fun_ty = fn->type_ref;
       if (fun_ty == 0 || fun_ty >= c->type_cap || !c->types[fun_ty].present || !c->types[fun_ty].is_fun) return false;
       const uint32_t sig_tid = c->types[fun_ty].fun_sig;
@@ -3559,12 +3709,12 @@ static bool eval_sem_match_sum(sirj_ctx_t* c, uint32_t node_id, const node_info_
   }
 
   sem_branch_t defb = {0};
-  if (!parse_sem_branch(c, json_obj_get(n->fields_obj, "default"), &defb)) return false;
+  if (!parse_sem_branch(c, json_obj_get_sym(n->fields_obj, JSON_KEY_DEFAULT), &defb)) return false;
   if (defb.kind == SEM_BRANCH_THUNK) {
     const uint32_t fun_node = defb.node_id;
     if (fun_node >= c->node_cap || !c->nodes[fun_node].present) return false;
     const node_info_t* fn = &c->nodes[fun_node];
-    if (!fn->tag || strcmp(fn->tag, "fun.sym") != 0) return false;
+    if (fn->tag_id != SIRJ_TAG_FUN_SYM) return false;
     const uint32_t fun_ty = fn->type_ref;
     if (fun_ty == 0 || fun_ty >= c->type_cap || !c->types[fun_ty].present || !c->types[fun_ty].is_fun) return false;
     const uint32_t sig_tid = c->types[fun_ty].fun_sig;
@@ -3636,19 +3786,10 @@ static bool eval_sem_match_sum(sirj_ctx_t* c, uint32_t node_id, const node_info_
 
 static bool resolve_internal_func_by_name(const sirj_ctx_t* c, const char* nm, sir_func_id_t* out) {
   if (!c || !nm || !out) return false;
-  for (uint32_t i = 0; i < c->node_cap; i++) {
-    const sir_func_id_t fid = (i < c->func_by_node_cap) ? c->func_by_node[i] : 0;
-    if (!fid) continue;
-    if (!c->nodes[i].present) continue;
-    if (!c->nodes[i].fields_obj || c->nodes[i].fields_obj->type != JSON_OBJECT) continue;
-    const char* fnm = json_get_string(json_obj_get(c->nodes[i].fields_obj, "name"));
-    if (!fnm) continue;
-    if (strcmp(fnm, nm) == 0) {
-      *out = fid;
-      return true;
-    }
-  }
-  return false;
+  uint32_t fid = 0;
+  if (!sirj_names_get(&c->func_by_name, nm, &fid)) return false;
+  *out = fid;
+  return true;
 }
 
 static bool eval_fun_cmp(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, bool is_ne, sir_val_id_t* out_slot, val_kind_t* out_kind) {
@@ -3657,7 +3798,7 @@ static bool eval_fun_cmp(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n,
     sirj_diag_setf(c, "sem.fun.cmp.bad_fields", c->cur_path, n->loc_line, node_id, n->tag, "fun.cmp.* missing fields");
     return false;
   }
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 2) {
     sirj_diag_setf(c, "sem.fun.cmp.bad_args", c->cur_path, n->loc_line, node_id, n->tag, "fun.cmp.* expects args:[a,b]");
     return false;
@@ -3715,7 +3856,7 @@ static bool eval_fun_cmp(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n,
 static bool eval_fun_sym(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const char* nm = json_get_string(json_obj_get(n->fields_obj, "name"));
+  const char* nm = json_get_string(json_obj_get_sym(n->fields_obj, JSON_KEY_NAME));
   if (!nm) return false;
 
   // Resolve to an in-module function id, then encode as a tagged pointer constant.
@@ -3742,7 +3883,7 @@ static bool eval_call_fun(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n,
     sirj_diag_setf(c, "sem.call.bad_fields", c->cur_path, n->loc_line, node_id, n->tag, "call.fun missing fields");
     return false;
   }
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len < 1) {
     sirj_diag_setf(c, "sem.call.bad_args", c->cur_path, n->loc_line, node_id, n->tag, "call.fun requires args:[callee, ...]");
     return false;
@@ -3754,12 +3895,12 @@ static bool eval_call_fun(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n,
   const node_info_t* callee_n = &c->nodes[callee_id];
 
   // MVP: require callee be `fun.sym` so we can resolve it at compile time.
-  if (!callee_n->tag || strcmp(callee_n->tag, "fun.sym") != 0) {
+  if (callee_n->tag_id != SIRJ_TAG_FUN_SYM) {
     sirj_diag_setf(c, "sem.call.fun.bad_callee", c->cur_path, n->loc_line, node_id, n->tag, "call.fun callee must be fun.sym (MVP)");
     return false;
   }
   if (!callee_n->fields_obj || callee_n->fields_obj->type != JSON_OBJECT) return false;
-  const char* fn_name = json_get_string(json_obj_get(callee_n->fields_obj, "name"));
+  const char* fn_name = json_get_string(json_obj_get_sym(callee_n->fields_obj, JSON_KEY_NAME));
   if (!fn_name) return false;
   sir_func_id_t callee_fid = 0;
   if (!resolve_internal_func_by_name(c, fn_name, &callee_fid)) return false;
@@ -4090,7 +4231,7 @@ static bool eval_closure_make(sirj_ctx_t* c, uint32_t node_id, const node_info_t
     return false;
   }
 
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 2) {
     sirj_diag_setf(c, "sem.closure.make.bad_args", c->cur_path, n->loc_line, node_id, n->tag, "closure.make expects args:[code, env]");
     return false;
@@ -4179,7 +4320,7 @@ static bool eval_closure_sym(sirj_ctx_t* c, uint32_t node_id, const node_info_t*
     sirj_diag_setf(c, "sem.closure.sym.bad_type", c->cur_path, n->loc_line, node_id, n->tag, "closure.sym requires closure type_ref");
     return false;
   }
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 2) {
     sirj_diag_setf(c, "sem.closure.sym.bad_args", c->cur_path, n->loc_line, node_id, n->tag, "closure.sym expects args:[sym, env]");
     return false;
@@ -4211,9 +4352,9 @@ static bool eval_closure_sym(sirj_ctx_t* c, uint32_t node_id, const node_info_t*
   bool found = false;
   for (uint32_t i = 0; i < c->node_cap; i++) {
     if (!c->nodes[i].present) continue;
-    if (!c->nodes[i].tag || strcmp(c->nodes[i].tag, "fn") != 0) continue;
+    if (c->nodes[i].tag_id != SIRJ_TAG_FN) continue;
     if (!c->nodes[i].fields_obj || c->nodes[i].fields_obj->type != JSON_OBJECT) continue;
-    const char* nm = json_get_string(json_obj_get(c->nodes[i].fields_obj, "name"));
+    const char* nm = json_get_string(json_obj_get_sym(c->nodes[i].fields_obj, JSON_KEY_NAME));
     if (nm && strcmp(nm, sym_name) == 0) {
       fn_type = c->nodes[i].type_ref;
       found = true;
@@ -4288,7 +4429,7 @@ static bool eval_closure_sym(sirj_ctx_t* c, uint32_t node_id, const node_info_t*
 static bool eval_closure_code(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 1) return false;
   uint32_t cid = 0;
   if (!parse_ref_id(c, av->v.arr.items[0], &cid)) return false;
@@ -4319,7 +4460,7 @@ static bool eval_closure_code(sirj_ctx_t* c, uint32_t node_id, const node_info_t
 static bool eval_closure_env(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 1) return false;
   uint32_t cid = 0;
   if (!parse_ref_id(c, av->v.arr.items[0], &cid)) return false;
@@ -4362,7 +4503,7 @@ static bool eval_closure_env(sirj_ctx_t* c, uint32_t node_id, const node_info_t*
 static bool eval_closure_cmp(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, bool is_ne, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len != 2) return false;
   uint32_t a_id = 0, b_id = 0;
   if (!parse_ref_id(c, av->v.arr.items[0], &a_id)) return false;
@@ -4395,7 +4536,7 @@ static bool eval_closure_cmp(sirj_ctx_t* c, uint32_t node_id, const node_info_t*
 static bool eval_call_closure(sirj_ctx_t* c, uint32_t node_id, const node_info_t* n, sir_val_id_t* out_slot, val_kind_t* out_kind) {
   if (!c || !n || !out_slot || !out_kind) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len < 1) return false;
 
   uint32_t callee_id = 0;
@@ -4513,7 +4654,7 @@ static bool eval_call_indirect(sirj_ctx_t* c, uint32_t node_id, const node_info_
     sirj_diag_setf(c, "sem.call.bad_fields", c->cur_path, n->loc_line, node_id, n->tag, "call.indirect missing fields");
     return false;
   }
-  const JsonValue* av = json_obj_get(n->fields_obj, "args");
+  const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
   if (!json_is_array(av) || av->v.arr.len < 1) {
     sirj_diag_setf(c, "sem.call.bad_args", c->cur_path, n->loc_line, node_id, n->tag, "call.indirect missing args");
     return false;
@@ -4532,17 +4673,17 @@ static bool eval_call_indirect(sirj_ctx_t* c, uint32_t node_id, const node_info_
     return false;
   }
   const node_info_t* cn = &c->nodes[callee_id];
-  if (cn->tag && strcmp(cn->tag, "decl.fn") == 0) {
+  if (cn->tag_id == SIRJ_TAG_DECL_FN) {
     if (!resolve_decl_fn_sym(c, callee_id, &callee_sym)) {
       sirj_diag_setf(c, "sem.call.bad_decl_fn", c->cur_path, n->loc_line, node_id, n->tag, "call.indirect callee decl.fn invalid");
       return false;
     }
-  } else if (cn->tag && strcmp(cn->tag, "ptr.sym") == 0) {
+  } else if (cn->tag_id == SIRJ_TAG_PTR_SYM) {
     if (!cn->fields_obj || cn->fields_obj->type != JSON_OBJECT) {
       sirj_diag_setf(c, "sem.call.bad_ptrsym", c->cur_path, n->loc_line, node_id, n->tag, "call.indirect callee ptr.sym invalid");
       return false;
     }
-    const char* nm = json_get_string(json_obj_get(cn->fields_obj, "name"));
+    const char* nm = json_get_string(json_obj_get_sym(cn->fields_obj, JSON_KEY_NAME));
     if (!nm) {
       sirj_diag_setf(c, "sem.call.bad_ptrsym", c->cur_path, n->loc_line, node_id, n->tag, "call.indirect callee ptr.sym missing name");
       return false;
@@ -4586,7 +4727,7 @@ static bool eval_call_indirect(sirj_ctx_t* c, uint32_t node_id, const node_info_
   // (We only support 0 or 1 return in the sir_module MVP.)
   // Use the SIR `sig` field when present (points to a type id).
   uint32_t sig_tid = 0;
-  const JsonValue* sigv = json_obj_get(n->fields_obj, "sig");
+  const JsonValue* sigv = json_obj_get_sym(n->fields_obj, JSON_KEY_SIG);
   if (sigv) {
     if (!parse_ref_id(c, sigv, &sig_tid)) {
       sirj_diag_setf(c, "sem.call.bad_sig", c->cur_path, n->loc_line, node_id, n->tag, "call.indirect bad sig ref");
@@ -4710,8 +4851,8 @@ static bool eval_call_direct(sirj_ctx_t* c, uint32_t node_id, const node_info_t*
   // Legacy tolerated shape:
   //   fields: { args: [ callee, ... ] }.
   uint32_t callee_id = 0;
-  const JsonValue* callee_v = json_obj_get(n->fields_obj, "callee");
-  const JsonValue* args_v = json_obj_get(n->fields_obj, "args");
+  const JsonValue* callee_v = json_obj_get_sym(n->fields_obj, JSON_KEY_CALLEE);
+  const JsonValue* args_v = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
 
   if (callee_v) {
     if (!parse_ref_id(c, callee_v, &callee_id)) {
@@ -4782,20 +4923,20 @@ static bool eval_call_direct(sirj_ctx_t* c, uint32_t node_id, const node_info_t*
   sir_sym_id_t callee_sym = 0;
   sir_func_id_t callee_fn = 0;
   const node_info_t* cn = &c->nodes[callee_id];
-  if (cn->tag && strcmp(cn->tag, "decl.fn") == 0) {
+  if (cn->tag_id == SIRJ_TAG_DECL_FN) {
     if (!resolve_decl_fn_sym(c, callee_id, &callee_sym)) {
       sirj_diag_setf(c, "sem.call.bad_decl_fn", c->cur_path, n->loc_line, node_id, n->tag, "call callee decl.fn invalid");
       return false;
     }
-  } else if (cn->tag && strcmp(cn->tag, "fn") == 0) {
+  } else if (cn->tag_id == SIRJ_TAG_FN) {
     if (callee_id >= c->func_by_node_cap || c->func_by_node[callee_id] == 0) {
       sirj_diag_setf(c, "sem.call.bad_fn", c->cur_path, n->loc_line, node_id, n->tag, "call callee fn is not lowered");
       return false;
     }
     callee_fn = c->func_by_node[callee_id];
-  } else if (cn->tag && strcmp(cn->tag, "ptr.sym") == 0) {
+  } else if (cn->tag_id == SIRJ_TAG_PTR_SYM) {
     if (!cn->fields_obj || cn->fields_obj->type != JSON_OBJECT) return false;
-    const char* nm = json_get_string(json_obj_get(cn->fields_obj, "name"));
+    const char* nm = json_get_string(json_obj_get_sym(cn->fields_obj, JSON_KEY_NAME));
     if (!nm) return false;
     if (!resolve_internal_func_by_name(c, nm, &callee_fn)) {
       sirj_diag_setf(c, "sem.call.ptrsym_not_fn", c->cur_path, n->loc_line, node_id, n->tag, "ptr.sym does not resolve to an in-module fn: %s",
@@ -4951,101 +5092,200 @@ static bool eval_node(sirj_ctx_t* c, uint32_t node_id, sir_val_id_t* out_slot, v
   const node_info_t* n = &c->nodes[node_id];
   if (!n->tag) return false;
 
-  if (strcmp(n->tag, "bparam") == 0) return eval_bparam(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "const.i1") == 0) return eval_const_i1(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "const.i8") == 0) return eval_const_i8(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "const.i16") == 0) return eval_const_i16(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "const.i32") == 0) return eval_const_i32(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "const.i64") == 0) return eval_const_i64(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "const.f32") == 0) return eval_const_f32(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "const.f64") == 0) return eval_const_f64(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "const.bool") == 0) return eval_const_bool(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "cstr") == 0) return eval_cstr(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "name") == 0) return eval_name(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "ptr.sym") == 0) return eval_ptr_sym(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "fun.sym") == 0) return eval_fun_sym(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "fun.cmp.eq") == 0) return eval_fun_cmp(c, node_id, n, false, out_slot, out_kind);
-  if (strcmp(n->tag, "fun.cmp.ne") == 0) return eval_fun_cmp(c, node_id, n, true, out_slot, out_kind);
-  if (strcmp(n->tag, "sem.if") == 0) return eval_sem_if(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "sem.cond") == 0) return eval_sem_cond(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "sem.and_sc") == 0) return eval_sem_and_or_sc(c, node_id, n, false, out_slot, out_kind);
-  if (strcmp(n->tag, "sem.or_sc") == 0) return eval_sem_and_or_sc(c, node_id, n, true, out_slot, out_kind);
-  if (strcmp(n->tag, "sem.switch") == 0) return eval_sem_switch(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "adt.make") == 0) return eval_adt_make(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "adt.tag") == 0) return eval_adt_tag(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "adt.is") == 0) return eval_adt_is(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "adt.get") == 0) return eval_adt_get(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "sem.match_sum") == 0) return eval_sem_match_sum(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "ptr.sizeof") == 0) return eval_ptr_size_alignof(c, node_id, n, true, out_slot, out_kind);
-  if (strcmp(n->tag, "ptr.alignof") == 0) return eval_ptr_size_alignof(c, node_id, n, false, out_slot, out_kind);
-  if (strcmp(n->tag, "ptr.offset") == 0) return eval_ptr_offset(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "ptr.add") == 0) return eval_ptr_addsub(c, node_id, n, false, out_slot, out_kind);
-  if (strcmp(n->tag, "ptr.sub") == 0) return eval_ptr_addsub(c, node_id, n, true, out_slot, out_kind);
-  if (strcmp(n->tag, "ptr.cmp.eq") == 0) return eval_ptr_cmp(c, node_id, n, false, out_slot, out_kind);
-  if (strcmp(n->tag, "ptr.cmp.ne") == 0) return eval_ptr_cmp(c, node_id, n, true, out_slot, out_kind);
-  if (strcmp(n->tag, "ptr.to_i64") == 0) return eval_ptr_to_i64_passthrough(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "ptr.from_i64") == 0) return eval_ptr_from_i64(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "bool.not") == 0) return eval_bool_not(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "bool.and") == 0) return eval_bool_bin(c, node_id, n, SIR_INST_BOOL_AND, out_slot, out_kind);
-  if (strcmp(n->tag, "bool.or") == 0) return eval_bool_bin(c, node_id, n, SIR_INST_BOOL_OR, out_slot, out_kind);
-  if (strcmp(n->tag, "bool.xor") == 0) return eval_bool_bin(c, node_id, n, SIR_INST_BOOL_XOR, out_slot, out_kind);
-  if (strcmp(n->tag, "select") == 0) return eval_select(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.add") == 0) return eval_i32_add_mnemonic(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.sub") == 0) return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_SUB, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.mul") == 0) return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_MUL, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.and") == 0) return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_AND, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.or") == 0) return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_OR, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.xor") == 0) return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_XOR, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.not") == 0) return eval_i32_un_mnemonic(c, node_id, n, SIR_INST_I32_NOT, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.neg") == 0) return eval_i32_un_mnemonic(c, node_id, n, SIR_INST_I32_NEG, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.shl") == 0) return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_SHL, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.shr.s") == 0) return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_SHR_S, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.shr.u") == 0) return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_SHR_U, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.div.s.sat") == 0) return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_DIV_S_SAT, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.div.s.trap") == 0) return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_DIV_S_TRAP, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.div.u.sat") == 0) return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_DIV_U_SAT, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.rem.s.sat") == 0) return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_REM_S_SAT, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.rem.u.sat") == 0) return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_REM_U_SAT, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.zext.i8") == 0) return eval_i32_zext_i8(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.zext.i16") == 0) return eval_i32_zext_i16(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "i64.zext.i32") == 0) return eval_i64_zext_i32(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.trunc.i64") == 0) return eval_i32_trunc_i64(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.cmp.eq") == 0) return eval_i32_cmp_eq(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.cmp.ne") == 0) return eval_i32_cmp(c, node_id, n, SIR_INST_I32_CMP_NE, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.cmp.slt") == 0) return eval_i32_cmp(c, node_id, n, SIR_INST_I32_CMP_SLT, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.cmp.sle") == 0) return eval_i32_cmp(c, node_id, n, SIR_INST_I32_CMP_SLE, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.cmp.sgt") == 0) return eval_i32_cmp(c, node_id, n, SIR_INST_I32_CMP_SGT, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.cmp.sge") == 0) return eval_i32_cmp(c, node_id, n, SIR_INST_I32_CMP_SGE, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.cmp.ult") == 0) return eval_i32_cmp(c, node_id, n, SIR_INST_I32_CMP_ULT, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.cmp.ule") == 0) return eval_i32_cmp(c, node_id, n, SIR_INST_I32_CMP_ULE, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.cmp.ugt") == 0) return eval_i32_cmp(c, node_id, n, SIR_INST_I32_CMP_UGT, out_slot, out_kind);
-  if (strcmp(n->tag, "i32.cmp.uge") == 0) return eval_i32_cmp(c, node_id, n, SIR_INST_I32_CMP_UGE, out_slot, out_kind);
-  if (strcmp(n->tag, "f32.cmp.ueq") == 0) return eval_f32_cmp_ueq(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "f64.cmp.olt") == 0) return eval_f64_cmp_olt(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "binop.add") == 0) return eval_binop_add(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "alloca.i8") == 0) return eval_alloca_mnemonic(c, node_id, n, 1, 1, out_slot, out_kind);
-  if (strcmp(n->tag, "alloca.i16") == 0) return eval_alloca_mnemonic(c, node_id, n, 2, 2, out_slot, out_kind);
-  if (strcmp(n->tag, "alloca.i32") == 0) return eval_alloca_mnemonic(c, node_id, n, 4, 4, out_slot, out_kind);
-  if (strcmp(n->tag, "alloca.i64") == 0) return eval_alloca_mnemonic(c, node_id, n, 8, 8, out_slot, out_kind);
-  if (strcmp(n->tag, "alloca.f32") == 0) return eval_alloca_mnemonic(c, node_id, n, 4, 4, out_slot, out_kind);
-  if (strcmp(n->tag, "alloca.f64") == 0) return eval_alloca_mnemonic(c, node_id, n, 8, 8, out_slot, out_kind);
-  if (strcmp(n->tag, "load.i8") == 0) return eval_load_mnemonic(c, node_id, n, SIR_INST_LOAD_I8, VK_I8, out_slot, out_kind);
-  if (strcmp(n->tag, "load.i16") == 0) return eval_load_mnemonic(c, node_id, n, SIR_INST_LOAD_I16, VK_I16, out_slot, out_kind);
-  if (strcmp(n->tag, "load.i32") == 0) return eval_load_mnemonic(c, node_id, n, SIR_INST_LOAD_I32, VK_I32, out_slot, out_kind);
-  if (strcmp(n->tag, "load.i64") == 0) return eval_load_mnemonic(c, node_id, n, SIR_INST_LOAD_I64, VK_I64, out_slot, out_kind);
-  if (strcmp(n->tag, "load.ptr") == 0) return eval_load_mnemonic(c, node_id, n, SIR_INST_LOAD_PTR, VK_PTR, out_slot, out_kind);
-  if (strcmp(n->tag, "load.f32") == 0) return eval_load_mnemonic(c, node_id, n, SIR_INST_LOAD_F32, VK_F32, out_slot, out_kind);
-  if (strcmp(n->tag, "load.f64") == 0) return eval_load_mnemonic(c, node_id, n, SIR_INST_LOAD_F64, VK_F64, out_slot, out_kind);
-  if (strcmp(n->tag, "closure.sym") == 0) return eval_closure_sym(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "closure.make") == 0) return eval_closure_make(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "closure.code") == 0) return eval_closure_code(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "closure.env") == 0) return eval_closure_env(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "closure.cmp.eq") == 0) return eval_closure_cmp(c, node_id, n, false, out_slot, out_kind);
-  if (strcmp(n->tag, "closure.cmp.ne") == 0) return eval_closure_cmp(c, node_id, n, true, out_slot, out_kind);
-  if (strcmp(n->tag, "call.closure") == 0) return eval_call_closure(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "call.fun") == 0) return eval_call_fun(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "call") == 0) return eval_call_direct(c, node_id, n, out_slot, out_kind);
-  if (strcmp(n->tag, "call.indirect") == 0) return eval_call_indirect(c, node_id, n, out_slot, out_kind);
+  switch (n->tag_id) {
+    case SIRJ_TAG_BPARAM:
+      return eval_bparam(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_CONST_I1:
+      return eval_const_i1(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_CONST_I8:
+      return eval_const_i8(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_CONST_I16:
+      return eval_const_i16(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_CONST_I32:
+      return eval_const_i32(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_CONST_I64:
+      return eval_const_i64(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_CONST_F32:
+      return eval_const_f32(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_CONST_F64:
+      return eval_const_f64(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_CONST_BOOL:
+      return eval_const_bool(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_CSTR:
+      return eval_cstr(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_NAME:
+      return eval_name(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_PTR_SYM:
+      return eval_ptr_sym(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_FUN_SYM:
+      return eval_fun_sym(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_FUN_CMP_EQ:
+      return eval_fun_cmp(c, node_id, n, false, out_slot, out_kind);
+    case SIRJ_TAG_FUN_CMP_NE:
+      return eval_fun_cmp(c, node_id, n, true, out_slot, out_kind);
+    case SIRJ_TAG_SEM_IF:
+      return eval_sem_if(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_SEM_COND:
+      return eval_sem_cond(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_SEM_AND_SC:
+      return eval_sem_and_or_sc(c, node_id, n, false, out_slot, out_kind);
+    case SIRJ_TAG_SEM_OR_SC:
+      return eval_sem_and_or_sc(c, node_id, n, true, out_slot, out_kind);
+    case SIRJ_TAG_SEM_SWITCH:
+      return eval_sem_switch(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_ADT_MAKE:
+      return eval_adt_make(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_ADT_TAG:
+      return eval_adt_tag(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_ADT_IS:
+      return eval_adt_is(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_ADT_GET:
+      return eval_adt_get(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_SEM_MATCH_SUM:
+      return eval_sem_match_sum(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_PTR_SIZEOF:
+      return eval_ptr_size_alignof(c, node_id, n, true, out_slot, out_kind);
+    case SIRJ_TAG_PTR_ALIGNOF:
+      return eval_ptr_size_alignof(c, node_id, n, false, out_slot, out_kind);
+    case SIRJ_TAG_PTR_OFFSET:
+      return eval_ptr_offset(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_PTR_ADD:
+      return eval_ptr_addsub(c, node_id, n, false, out_slot, out_kind);
+    case SIRJ_TAG_PTR_SUB:
+      return eval_ptr_addsub(c, node_id, n, true, out_slot, out_kind);
+    case SIRJ_TAG_PTR_CMP_EQ:
+      return eval_ptr_cmp(c, node_id, n, false, out_slot, out_kind);
+    case SIRJ_TAG_PTR_CMP_NE:
+      return eval_ptr_cmp(c, node_id, n, true, out_slot, out_kind);
+    case SIRJ_TAG_PTR_TO_I64:
+      return eval_ptr_to_i64_passthrough(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_PTR_FROM_I64:
+      return eval_ptr_from_i64(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_BOOL_NOT:
+      return eval_bool_not(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_BOOL_AND:
+      return eval_bool_bin(c, node_id, n, SIR_INST_BOOL_AND, out_slot, out_kind);
+    case SIRJ_TAG_BOOL_OR:
+      return eval_bool_bin(c, node_id, n, SIR_INST_BOOL_OR, out_slot, out_kind);
+    case SIRJ_TAG_BOOL_XOR:
+      return eval_bool_bin(c, node_id, n, SIR_INST_BOOL_XOR, out_slot, out_kind);
+    case SIRJ_TAG_SELECT:
+      return eval_select(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_I32_ADD:
+      return eval_i32_add_mnemonic(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_I32_SUB:
+      return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_SUB, out_slot, out_kind);
+    case SIRJ_TAG_I32_MUL:
+      return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_MUL, out_slot, out_kind);
+    case SIRJ_TAG_I32_AND:
+      return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_AND, out_slot, out_kind);
+    case SIRJ_TAG_I32_OR:
+      return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_OR, out_slot, out_kind);
+    case SIRJ_TAG_I32_XOR:
+      return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_XOR, out_slot, out_kind);
+    case SIRJ_TAG_I32_NOT:
+      return eval_i32_un_mnemonic(c, node_id, n, SIR_INST_I32_NOT, out_slot, out_kind);
+    case SIRJ_TAG_I32_NEG:
+      return eval_i32_un_mnemonic(c, node_id, n, SIR_INST_I32_NEG, out_slot, out_kind);
+    case SIRJ_TAG_I32_SHL:
+      return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_SHL, out_slot, out_kind);
+    case SIRJ_TAG_I32_SHR_S:
+      return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_SHR_S, out_slot, out_kind);
+    case SIRJ_TAG_I32_SHR_U:
+      return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_SHR_U, out_slot, out_kind);
+    case SIRJ_TAG_I32_DIV_S_SAT:
+      return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_DIV_S_SAT, out_slot, out_kind);
+    case SIRJ_TAG_I32_DIV_S_TRAP:
+      return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_DIV_S_TRAP, out_slot, out_kind);
+    case SIRJ_TAG_I32_DIV_U_SAT:
+      return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_DIV_U_SAT, out_slot, out_kind);
+    case SIRJ_TAG_I32_REM_S_SAT:
+      return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_REM_S_SAT, out_slot, out_kind);
+    case SIRJ_TAG_I32_REM_U_SAT:
+      return eval_i32_bin_mnemonic(c, node_id, n, SIR_INST_I32_REM_U_SAT, out_slot, out_kind);
+    case SIRJ_TAG_I32_ZEXT_I8:
+      return eval_i32_zext_i8(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_I32_ZEXT_I16:
+      return eval_i32_zext_i16(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_I64_ZEXT_I32:
+      return eval_i64_zext_i32(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_I32_TRUNC_I64:
+      return eval_i32_trunc_i64(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_I32_CMP_EQ:
+      return eval_i32_cmp_eq(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_I32_CMP_NE:
+      return eval_i32_cmp(c, node_id, n, SIR_INST_I32_CMP_NE, out_slot, out_kind);
+    case SIRJ_TAG_I32_CMP_SLT:
+      return eval_i32_cmp(c, node_id, n, SIR_INST_I32_CMP_SLT, out_slot, out_kind);
+    case SIRJ_TAG_I32_CMP_SLE:
+      return eval_i32_cmp(c, node_id, n, SIR_INST_I32_CMP_SLE, out_slot, out_kind);
+    case SIRJ_TAG_I32_CMP_SGT:
+      return eval_i32_cmp(c, node_id, n, SIR_INST_I32_CMP_SGT, out_slot, out_kind);
+    case SIRJ_TAG_I32_CMP_SGE:
+      return eval_i32_cmp(c, node_id, n, SIR_INST_I32_CMP_SGE, out_slot, out_kind);
+    case SIRJ_TAG_I32_CMP_ULT:
+      return eval_i32_cmp(c, node_id, n, SIR_INST_I32_CMP_ULT, out_slot, out_kind);
+    case SIRJ_TAG_I32_CMP_ULE:
+      return eval_i32_cmp(c, node_id, n, SIR_INST_I32_CMP_ULE, out_slot, out_kind);
+    case SIRJ_TAG_I32_CMP_UGT:
+      return eval_i32_cmp(c, node_id, n, SIR_INST_I32_CMP_UGT, out_slot, out_kind);
+    case SIRJ_TAG_I32_CMP_UGE:
+      return eval_i32_cmp(c, node_id, n, SIR_INST_I32_CMP_UGE, out_slot, out_kind);
+    case SIRJ_TAG_F32_CMP_UEQ:
+      return eval_f32_cmp_ueq(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_F64_CMP_OLT:
+      return eval_f64_cmp_olt(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_BINOP_ADD:
+      return eval_binop_add(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_ALLOCA_I8:
+      return eval_alloca_mnemonic(c, node_id, n, 1, 1, out_slot, out_kind);
+    case SIRJ_TAG_ALLOCA_I16:
+      return eval_alloca_mnemonic(c, node_id, n, 2, 2, out_slot, out_kind);
+    case SIRJ_TAG_ALLOCA_I32:
+      return eval_alloca_mnemonic(c, node_id, n, 4, 4, out_slot, out_kind);
+    case SIRJ_TAG_ALLOCA_I64:
+      return eval_alloca_mnemonic(c, node_id, n, 8, 8, out_slot, out_kind);
+    case SIRJ_TAG_ALLOCA_F32:
+      return eval_alloca_mnemonic(c, node_id, n, 4, 4, out_slot, out_kind);
+    case SIRJ_TAG_ALLOCA_F64:
+      return eval_alloca_mnemonic(c, node_id, n, 8, 8, out_slot, out_kind);
+    case SIRJ_TAG_LOAD_I8:
+      return eval_load_mnemonic(c, node_id, n, SIR_INST_LOAD_I8, VK_I8, out_slot, out_kind);
+    case SIRJ_TAG_LOAD_I16:
+      return eval_load_mnemonic(c, node_id, n, SIR_INST_LOAD_I16, VK_I16, out_slot, out_kind);
+    case SIRJ_TAG_LOAD_I32:
+      return eval_load_mnemonic(c, node_id, n, SIR_INST_LOAD_I32, VK_I32, out_slot, out_kind);
+    case SIRJ_TAG_LOAD_I64:
+      return eval_load_mnemonic(c, node_id, n, SIR_INST_LOAD_I64, VK_I64, out_slot, out_kind);
+    case SIRJ_TAG_LOAD_PTR:
+      return eval_load_mnemonic(c, node_id, n, SIR_INST_LOAD_PTR, VK_PTR, out_slot, out_kind);
+    case SIRJ_TAG_LOAD_F32:
+      return eval_load_mnemonic(c, node_id, n, SIR_INST_LOAD_F32, VK_F32, out_slot, out_kind);
+    case SIRJ_TAG_LOAD_F64:
+      return eval_load_mnemonic(c, node_id, n, SIR_INST_LOAD_F64, VK_F64, out_slot, out_kind);
+    case SIRJ_TAG_CLOSURE_SYM:
+      return eval_closure_sym(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_CLOSURE_MAKE:
+      return eval_closure_make(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_CLOSURE_CODE:
+      return eval_closure_code(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_CLOSURE_ENV:
+      return eval_closure_env(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_CLOSURE_CMP_EQ:
+      return eval_closure_cmp(c, node_id, n, false, out_slot, out_kind);
+    case SIRJ_TAG_CLOSURE_CMP_NE:
+      return eval_closure_cmp(c, node_id, n, true, out_slot, out_kind);
+    case SIRJ_TAG_CALL_CLOSURE:
+      return eval_call_closure(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_CALL_FUN:
+      return eval_call_fun(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_CALL:
+      return eval_call_direct(c, node_id, n, out_slot, out_kind);
+    case SIRJ_TAG_CALL_INDIRECT:
+      return eval_call_indirect(c, node_id, n, out_slot, out_kind);
+    default:
+      break;
+  }
 
   sirj_diag_setf(c, "sem.unsupported.node", c->cur_path, n->loc_line, node_id, n->tag, "unsupported node tag: %s", n->tag);
   return false;
@@ -5060,9 +5300,9 @@ static bool exec_inline_block(sirj_ctx_t* c, uint32_t block_id, bool* out_did_re
   if (out_exit_kind) *out_exit_kind = VK_INVALID;
   if (block_id >= c->node_cap || !c->nodes[block_id].present) return false;
   const node_info_t* bn = &c->nodes[block_id];
-  if (!bn->tag || strcmp(bn->tag, "block") != 0) return false;
+  if (bn->tag_id != SIRJ_TAG_BLOCK) return false;
   if (!bn->fields_obj || bn->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* sv = json_obj_get(bn->fields_obj, "stmts");
+  const JsonValue* sv = json_obj_get_sym(bn->fields_obj, JSON_KEY_STMTS);
   if (!json_is_array(sv)) return false;
   const JsonArray* a = &sv->v.arr;
   for (size_t i = 0; i < a->len; i++) {
@@ -5091,11 +5331,11 @@ static bool exec_stmt(sirj_ctx_t* c, uint32_t stmt_id, bool* out_did_return, sir
   const node_info_t* n = &c->nodes[stmt_id];
   if (!n->tag) return false;
 
-  if (strcmp(n->tag, "let") == 0) {
+  if (n->tag_id == SIRJ_TAG_LET) {
     if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-    const char* nm = json_get_string(json_obj_get(n->fields_obj, "name"));
+    const char* nm = json_get_string(json_obj_get_sym(n->fields_obj, JSON_KEY_NAME));
     if (!nm || nm[0] == '\0') return false;
-    const JsonValue* vv = json_obj_get(n->fields_obj, "value");
+    const JsonValue* vv = json_obj_get_sym(n->fields_obj, JSON_KEY_VALUE);
     uint32_t vid = 0;
     if (!parse_ref_id(c, vv, &vid)) return false;
     sir_val_id_t tmp = 0;
@@ -5112,16 +5352,16 @@ static bool exec_stmt(sirj_ctx_t* c, uint32_t stmt_id, bool* out_did_return, sir
     return true;
   }
 
-  if (strcmp(n->tag, "store.i8") == 0) return eval_store_mnemonic(c, stmt_id, n, SIR_INST_STORE_I8);
-  if (strcmp(n->tag, "store.i16") == 0) return eval_store_mnemonic(c, stmt_id, n, SIR_INST_STORE_I16);
-  if (strcmp(n->tag, "store.i32") == 0) return eval_store_mnemonic(c, stmt_id, n, SIR_INST_STORE_I32);
-  if (strcmp(n->tag, "store.i64") == 0) return eval_store_mnemonic(c, stmt_id, n, SIR_INST_STORE_I64);
-  if (strcmp(n->tag, "store.ptr") == 0) return eval_store_mnemonic(c, stmt_id, n, SIR_INST_STORE_PTR);
-  if (strcmp(n->tag, "store.f32") == 0) return eval_store_mnemonic(c, stmt_id, n, SIR_INST_STORE_F32);
-  if (strcmp(n->tag, "store.f64") == 0) return eval_store_mnemonic(c, stmt_id, n, SIR_INST_STORE_F64);
-  if (strcmp(n->tag, "mem.copy") == 0) return eval_mem_copy_stmt(c, stmt_id, n);
-  if (strcmp(n->tag, "mem.fill") == 0) return eval_mem_fill_stmt(c, stmt_id, n);
-  if (strcmp(n->tag, "call") == 0) {
+  if (n->tag_id == SIRJ_TAG_STORE_I8) return eval_store_mnemonic(c, stmt_id, n, SIR_INST_STORE_I8);
+  if (n->tag_id == SIRJ_TAG_STORE_I16) return eval_store_mnemonic(c, stmt_id, n, SIR_INST_STORE_I16);
+  if (n->tag_id == SIRJ_TAG_STORE_I32) return eval_store_mnemonic(c, stmt_id, n, SIR_INST_STORE_I32);
+  if (n->tag_id == SIRJ_TAG_STORE_I64) return eval_store_mnemonic(c, stmt_id, n, SIR_INST_STORE_I64);
+  if (n->tag_id == SIRJ_TAG_STORE_PTR) return eval_store_mnemonic(c, stmt_id, n, SIR_INST_STORE_PTR);
+  if (n->tag_id == SIRJ_TAG_STORE_F32) return eval_store_mnemonic(c, stmt_id, n, SIR_INST_STORE_F32);
+  if (n->tag_id == SIRJ_TAG_STORE_F64) return eval_store_mnemonic(c, stmt_id, n, SIR_INST_STORE_F64);
+  if (n->tag_id == SIRJ_TAG_MEM_COPY) return eval_mem_copy_stmt(c, stmt_id, n);
+  if (n->tag_id == SIRJ_TAG_MEM_FILL) return eval_mem_fill_stmt(c, stmt_id, n);
+  if (n->tag_id == SIRJ_TAG_CALL) {
     // Calls are expression nodes in SIR, but they often appear in block.stmts for side effects.
     sir_val_id_t tmp = 0;
     val_kind_t tk = VK_INVALID;
@@ -5130,7 +5370,7 @@ static bool exec_stmt(sirj_ctx_t* c, uint32_t stmt_id, bool* out_did_return, sir
     (void)tk;
     return true;
   }
-  if (strcmp(n->tag, "call.fun") == 0) {
+  if (n->tag_id == SIRJ_TAG_CALL_FUN) {
     // Calls are expression nodes in SIR, but they often appear in block.stmts for side effects.
     sir_val_id_t tmp = 0;
     val_kind_t tk = VK_INVALID;
@@ -5139,7 +5379,7 @@ static bool exec_stmt(sirj_ctx_t* c, uint32_t stmt_id, bool* out_did_return, sir
     (void)tk;
     return true;
   }
-  if (strcmp(n->tag, "call.indirect") == 0) {
+  if (n->tag_id == SIRJ_TAG_CALL_INDIRECT) {
     // Calls are expression nodes in SIR, but they often appear in block.stmts for side effects.
     sir_val_id_t tmp = 0;
     val_kind_t tk = VK_INVALID;
@@ -5149,9 +5389,9 @@ static bool exec_stmt(sirj_ctx_t* c, uint32_t stmt_id, bool* out_did_return, sir
     return true;
   }
 
-  if (strcmp(n->tag, "sem.defer") == 0) {
+  if (n->tag_id == SIRJ_TAG_SEM_DEFER) {
     if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-    const JsonValue* av = json_obj_get(n->fields_obj, "args");
+    const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
     if (!json_is_array(av) || av->v.arr.len != 1) return false;
     sem_branch_t br = {0};
     if (!parse_sem_branch(c, av->v.arr.items[0], &br) || br.kind != SEM_BRANCH_THUNK) return false;
@@ -5163,10 +5403,10 @@ static bool exec_stmt(sirj_ctx_t* c, uint32_t stmt_id, bool* out_did_return, sir
     return true;
   }
 
-  if (strcmp(n->tag, "sem.scope") == 0) {
+  if (n->tag_id == SIRJ_TAG_SEM_SCOPE) {
     if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-    const JsonValue* dv = json_obj_get(n->fields_obj, "defers");
-    const JsonValue* bodyv = json_obj_get(n->fields_obj, "body");
+    const JsonValue* dv = json_obj_get_sym(n->fields_obj, JSON_KEY_DEFERS);
+    const JsonValue* bodyv = json_obj_get_sym(n->fields_obj, JSON_KEY_BODY);
     if (!json_is_array(dv) || !json_is_object(bodyv)) return false;
     uint32_t body_id = 0;
     if (!parse_ref_id(c, bodyv, &body_id)) return false;
@@ -5196,7 +5436,7 @@ static bool exec_stmt(sirj_ctx_t* c, uint32_t stmt_id, bool* out_did_return, sir
     return true;
   }
 
-  if (strcmp(n->tag, "sem.continue") == 0) {
+  if (n->tag_id == SIRJ_TAG_SEM_CONTINUE) {
     // MVP: used inside thunk bodies for sem.while; treat as "return 0" from the thunk.
     if (c->in_cfg) {
       sirj_diag_setf(c, "sem.sem.continue.cfg", c->cur_path, n->loc_line, stmt_id, n->tag, "sem.continue not supported in CFG-form blocks (MVP)");
@@ -5214,7 +5454,7 @@ static bool exec_stmt(sirj_ctx_t* c, uint32_t stmt_id, bool* out_did_return, sir
     return true;
   }
 
-  if (strcmp(n->tag, "sem.break") == 0) {
+  if (n->tag_id == SIRJ_TAG_SEM_BREAK) {
     // MVP: used inside thunk bodies for sem.while; treat as "return 1" from the thunk.
     if (c->in_cfg) {
       sirj_diag_setf(c, "sem.sem.break.cfg", c->cur_path, n->loc_line, stmt_id, n->tag, "sem.break not supported in CFG-form blocks (MVP)");
@@ -5232,9 +5472,9 @@ static bool exec_stmt(sirj_ctx_t* c, uint32_t stmt_id, bool* out_did_return, sir
     return true;
   }
 
-  if (strcmp(n->tag, "sem.while") == 0) {
+  if (n->tag_id == SIRJ_TAG_SEM_WHILE) {
     if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-    const JsonValue* av = json_obj_get(n->fields_obj, "args");
+    const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
     if (!json_is_array(av) || av->v.arr.len != 2) return false;
     sem_branch_t cond = {0}, body = {0};
     if (!parse_sem_branch(c, av->v.arr.items[0], &cond) || cond.kind != SEM_BRANCH_THUNK) return false;
@@ -5303,7 +5543,7 @@ static bool exec_stmt(sirj_ctx_t* c, uint32_t stmt_id, bool* out_did_return, sir
     return true;
   }
 
-  if (strcmp(n->tag, "term.trap") == 0) {
+  if (n->tag_id == SIRJ_TAG_TERM_TRAP) {
     // Deterministic trap: terminate process.
     sir_mb_set_src(c->mb, stmt_id, n->loc_line);
     if (!sir_mb_emit_exit(c->mb, c->fn, 255)) return false;
@@ -5314,7 +5554,7 @@ static bool exec_stmt(sirj_ctx_t* c, uint32_t stmt_id, bool* out_did_return, sir
     return true;
   }
 
-  if (strcmp(n->tag, "term.unreachable") == 0) {
+  if (n->tag_id == SIRJ_TAG_TERM_UNREACHABLE) {
     // Deterministic trap: terminate process.
     sir_mb_set_src(c->mb, stmt_id, n->loc_line);
     if (!sir_mb_emit_exit(c->mb, c->fn, 254)) return false;
@@ -5325,11 +5565,11 @@ static bool exec_stmt(sirj_ctx_t* c, uint32_t stmt_id, bool* out_did_return, sir
     return true;
   }
 
-  if (strcmp(n->tag, "term.ret") == 0 || strcmp(n->tag, "return") == 0) {
+  if (n->tag_id == SIRJ_TAG_TERM_RET || n->tag_id == SIRJ_TAG_RETURN) {
     // MVP: return a previously computed value (or default 0).
     uint32_t rid = 0;
     if (n->fields_obj && n->fields_obj->type == JSON_OBJECT) {
-      const JsonValue* vv = json_obj_get(n->fields_obj, "value");
+      const JsonValue* vv = json_obj_get_sym(n->fields_obj, JSON_KEY_VALUE);
       if (vv && !parse_ref_id(c, vv, &rid)) return false;
     }
 
@@ -5388,10 +5628,10 @@ static bool lower_term_node(sirj_ctx_t* c, uint32_t term_id, term_info_t* out) {
   const node_info_t* n = &c->nodes[term_id];
   if (!n->tag) return false;
 
-  if (strcmp(n->tag, "term.ret") == 0 || strcmp(n->tag, "return") == 0) {
+  if (n->tag_id == SIRJ_TAG_TERM_RET || n->tag_id == SIRJ_TAG_RETURN) {
     uint32_t rid = 0;
     if (n->fields_obj && n->fields_obj->type == JSON_OBJECT) {
-      const JsonValue* vv = json_obj_get(n->fields_obj, "value");
+      const JsonValue* vv = json_obj_get_sym(n->fields_obj, JSON_KEY_VALUE);
       if (vv && !parse_ref_id(c, vv, &rid)) return false;
     }
     sir_val_id_t slot = 0;
@@ -5409,15 +5649,15 @@ static bool lower_term_node(sirj_ctx_t* c, uint32_t term_id, term_info_t* out) {
     return true;
   }
 
-  if (strcmp(n->tag, "term.br") == 0) {
+  if (n->tag_id == SIRJ_TAG_TERM_BR) {
     if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
-    const JsonValue* tov = json_obj_get(n->fields_obj, "to");
+    const JsonValue* tov = json_obj_get_sym(n->fields_obj, JSON_KEY_TO);
     uint32_t bid = 0;
     if (!parse_ref_id(c, tov, &bid)) return false;
     out->k = TERM_BR;
     out->to_block = bid;
 
-    const JsonValue* av = json_obj_get(n->fields_obj, "args");
+    const JsonValue* av = json_obj_get_sym(n->fields_obj, JSON_KEY_ARGS);
     if (!av) return true;
     if (!json_is_array(av)) return false;
     const JsonArray* a = &av->v.arr;
@@ -5435,20 +5675,20 @@ static bool lower_term_node(sirj_ctx_t* c, uint32_t term_id, term_info_t* out) {
     return true;
   }
 
-  if (strcmp(n->tag, "term.cbr") == 0 || strcmp(n->tag, "term.condbr") == 0) {
+  if (n->tag_id == SIRJ_TAG_TERM_CBR || n->tag_id == SIRJ_TAG_TERM_CONDBR) {
     if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
     uint32_t cond_id = 0;
-    if (!parse_ref_id(c, json_obj_get(n->fields_obj, "cond"), &cond_id)) return false;
+    if (!parse_ref_id(c, json_obj_get_sym(n->fields_obj, JSON_KEY_COND), &cond_id)) return false;
     sir_val_id_t cond_slot = 0;
     val_kind_t ck = VK_INVALID;
     if (!eval_node(c, cond_id, &cond_slot, &ck)) return false;
     if (ck != VK_BOOL) return false;
 
-    const JsonValue* thenv = json_obj_get(n->fields_obj, "then");
-    const JsonValue* elsev = json_obj_get(n->fields_obj, "else");
+    const JsonValue* thenv = json_obj_get_sym(n->fields_obj, JSON_KEY_THEN);
+    const JsonValue* elsev = json_obj_get_sym(n->fields_obj, JSON_KEY_ELSE);
     if (!json_is_object(thenv) || !json_is_object(elsev)) return false;
-    const JsonValue* thto = json_obj_get(thenv, "to");
-    const JsonValue* elto = json_obj_get(elsev, "to");
+    const JsonValue* thto = json_obj_get_sym(thenv, JSON_KEY_TO);
+    const JsonValue* elto = json_obj_get_sym(elsev, JSON_KEY_TO);
     if (!json_is_object(thto) || !json_is_object(elto)) return false;
     uint32_t then_bid = 0, else_bid = 0;
     if (!parse_ref_id(c, thto, &then_bid)) return false;
@@ -5461,12 +5701,12 @@ static bool lower_term_node(sirj_ctx_t* c, uint32_t term_id, term_info_t* out) {
     return true;
   }
 
-  if (strcmp(n->tag, "term.switch") == 0) {
+  if (n->tag_id == SIRJ_TAG_TERM_SWITCH) {
     if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
     uint32_t scrut_id = 0;
-    if (!parse_ref_id(c, json_obj_get(n->fields_obj, "scrut"), &scrut_id)) return false;
+    if (!parse_ref_id(c, json_obj_get_sym(n->fields_obj, JSON_KEY_SCRUT), &scrut_id)) return false;
 
-    const JsonValue* casesv = json_obj_get(n->fields_obj, "cases");
+    const JsonValue* casesv = json_obj_get_sym(n->fields_obj, JSON_KEY_CASES);
     if (!json_is_array(casesv)) {
       sirj_diag_setf(c, "sem.parse.term.switch.cases", c->cur_path, n->loc_line, term_id, n->tag, "term.switch.cases must be an array");
       return false;
@@ -5488,8 +5728,8 @@ static bool lower_term_node(sirj_ctx_t* c, uint32_t term_id, term_info_t* out) {
                        (unsigned)i);
         return false;
       }
-      const JsonValue* litv = json_obj_get(ca->items[i], "lit");
-      const JsonValue* tov = json_obj_get(ca->items[i], "to");
+      const JsonValue* litv = json_obj_get_sym(ca->items[i], JSON_KEY_LIT);
+      const JsonValue* tov = json_obj_get_sym(ca->items[i], JSON_KEY_TO);
       uint32_t lid = 0, bid = 0;
       if (!parse_ref_id(c, litv, &lid)) return false;
       if (!parse_ref_id(c, tov, &bid)) return false;
@@ -5497,12 +5737,12 @@ static bool lower_term_node(sirj_ctx_t* c, uint32_t term_id, term_info_t* out) {
       to_ids[i] = bid;
     }
 
-    const JsonValue* defv = json_obj_get(n->fields_obj, "default");
+    const JsonValue* defv = json_obj_get_sym(n->fields_obj, JSON_KEY_DEFAULT);
     if (!json_is_object(defv)) {
       sirj_diag_setf(c, "sem.parse.term.switch.default", c->cur_path, n->loc_line, term_id, n->tag, "term.switch.default must be an object");
       return false;
     }
-    const JsonValue* defto = json_obj_get(defv, "to");
+    const JsonValue* defto = json_obj_get_sym(defv, JSON_KEY_TO);
     uint32_t def_bid = 0;
     if (!parse_ref_id(c, defto, &def_bid)) return false;
 
@@ -5515,14 +5755,14 @@ static bool lower_term_node(sirj_ctx_t* c, uint32_t term_id, term_info_t* out) {
     return true;
   }
 
-  if (strcmp(n->tag, "term.trap") == 0) {
+  if (n->tag_id == SIRJ_TAG_TERM_TRAP) {
     // MVP: ignore msg/code payload; treat as deterministic trap.
     out->k = TERM_TRAP;
     out->trap_code = 0;
     return true;
   }
 
-  if (strcmp(n->tag, "term.unreachable") == 0) {
+  if (n->tag_id == SIRJ_TAG_TERM_UNREACHABLE) {
     out->k = TERM_UNREACHABLE;
     return true;
   }
@@ -5545,10 +5785,10 @@ static bool parse_const_i32_value(const sirj_ctx_t* c, uint32_t node_id, int32_t
   if (!c || !out) return false;
   if (node_id >= c->node_cap || !c->nodes[node_id].present) return false;
   const node_info_t* n = &c->nodes[node_id];
-  if (!n->tag || strcmp(n->tag, "const.i32") != 0) return false;
+  if (n->tag_id != SIRJ_TAG_CONST_I32) return false;
   if (!n->fields_obj || n->fields_obj->type != JSON_OBJECT) return false;
   int64_t v = 0;
-  if (!json_get_i64(json_obj_get(n->fields_obj, "value"), &v)) return false;
+  if (!json_get_i64(json_obj_get_sym(n->fields_obj, JSON_KEY_VALUE), &v)) return false;
   if (v < INT32_MIN || v > INT32_MAX) return false;
   *out = (int32_t)v;
   return true;
@@ -5572,8 +5812,8 @@ static bool lower_fn_body(sirj_ctx_t* c, uint32_t fn_node_id, bool is_entry) {
   }
 
   // CFG form: entry + blocks.
-  const JsonValue* entryv = json_obj_get(fnn->fields_obj, "entry");
-  const JsonValue* blocksv = json_obj_get(fnn->fields_obj, "blocks");
+  const JsonValue* entryv = json_obj_get_sym(fnn->fields_obj, JSON_KEY_ENTRY);
+  const JsonValue* blocksv = json_obj_get_sym(fnn->fields_obj, JSON_KEY_BLOCKS);
   if (entryv && blocksv) {
     c->in_cfg = true;
     uint32_t entry_block = 0;
@@ -5606,12 +5846,12 @@ static bool lower_fn_body(sirj_ctx_t* c, uint32_t fn_node_id, bool is_entry) {
       if (!parse_ref_id(c, blks->items[bi], &bid)) return false;
       if (bid >= c->node_cap || !c->nodes[bid].present) return false;
       const node_info_t* bn = &c->nodes[bid];
-      if (!bn->tag || strcmp(bn->tag, "block") != 0) return false;
+      if (bn->tag_id != SIRJ_TAG_BLOCK) return false;
       if (!bn->fields_obj || bn->fields_obj->type != JSON_OBJECT) return false;
 
       block_ip[bid] = sir_mb_func_ip(c->mb, c->fn);
 
-      const JsonValue* sv = json_obj_get(bn->fields_obj, "stmts");
+      const JsonValue* sv = json_obj_get_sym(bn->fields_obj, JSON_KEY_STMTS);
       if (!json_is_array(sv)) return false;
       const JsonArray* a = &sv->v.arr;
 
@@ -5646,10 +5886,10 @@ static bool lower_fn_body(sirj_ctx_t* c, uint32_t fn_node_id, bool is_entry) {
             // Resolve block params (bparams) and wire branch args.
             const node_info_t* tobn =
                 (term.to_block < c->node_cap && c->nodes[term.to_block].present) ? &c->nodes[term.to_block] : NULL;
-            if (!tobn || !tobn->tag || strcmp(tobn->tag, "block") != 0) return false;
+            if (!tobn || tobn->tag_id != SIRJ_TAG_BLOCK) return false;
             if (!tobn->fields_obj || tobn->fields_obj->type != JSON_OBJECT) return false;
 
-            const JsonValue* pv = json_obj_get(tobn->fields_obj, "params");
+            const JsonValue* pv = json_obj_get_sym(tobn->fields_obj, JSON_KEY_PARAMS);
             uint32_t dst_count = 0;
             sir_val_id_t* dst_slots = NULL;
             if (pv) {
@@ -5663,7 +5903,7 @@ static bool lower_fn_body(sirj_ctx_t* c, uint32_t fn_node_id, bool is_entry) {
                   uint32_t bpid = 0;
                   if (!parse_ref_id(c, pa->items[pi], &bpid)) return false;
                   if (bpid >= c->node_cap || !c->nodes[bpid].present) return false;
-                  if (!c->nodes[bpid].tag || strcmp(c->nodes[bpid].tag, "bparam") != 0) return false;
+                  if (c->nodes[bpid].tag_id != SIRJ_TAG_BPARAM) return false;
                   sir_val_id_t s = 0;
                   val_kind_t k = VK_INVALID;
                   if (!eval_bparam(c, bpid, &c->nodes[bpid], &s, &k)) return false;
@@ -5804,15 +6044,15 @@ static bool lower_fn_body(sirj_ctx_t* c, uint32_t fn_node_id, bool is_entry) {
   }
 
   // Legacy single-block form: body.
-  const JsonValue* bodyv = json_obj_get(fnn->fields_obj, "body");
+  const JsonValue* bodyv = json_obj_get_sym(fnn->fields_obj, JSON_KEY_BODY);
   if (!bodyv) return false;
   uint32_t body_id = 0;
   if (!parse_ref_id(c, bodyv, &body_id)) return false;
   if (body_id >= c->node_cap || !c->nodes[body_id].present) return false;
   const node_info_t* bn = &c->nodes[body_id];
-  if (!bn->tag || strcmp(bn->tag, "block") != 0) return false;
+  if (bn->tag_id != SIRJ_TAG_BLOCK) return false;
   if (!bn->fields_obj || bn->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* sv = json_obj_get(bn->fields_obj, "stmts");
+  const JsonValue* sv = json_obj_get_sym(bn->fields_obj, JSON_KEY_STMTS);
   if (!json_is_array(sv)) return false;
 
   const JsonArray* a = &sv->v.arr;
@@ -5861,10 +6101,10 @@ static bool lower_fn_body(sirj_ctx_t* c, uint32_t fn_node_id, bool is_entry) {
 
 static uint32_t loc_line_from_root(const JsonValue* root, uint32_t fallback) {
   if (!root || root->type != JSON_OBJECT) return fallback;
-  const JsonValue* locv = json_obj_get((JsonValue*)root, "loc");
+  const JsonValue* locv = json_obj_get_sym((JsonValue*)root, JSON_KEY_LOC);
   if (!locv || locv->type != JSON_OBJECT) return fallback;
   uint32_t ln = 0;
-  if (!json_get_u32(json_obj_get((JsonValue*)locv, "line"), &ln)) return fallback;
+  if (!json_get_u32(json_obj_get_sym((JsonValue*)locv, JSON_KEY_LINE), &ln)) return fallback;
   return ln ? ln : fallback;
 }
 
@@ -5927,17 +6167,18 @@ static bool parse_file(sirj_ctx_t* c, const char* path) {
         return false;
       }
 
-      const char* k = json_get_string(json_obj_get(root, "k"));
+      const char* k = json_get_string(json_obj_get_sym(root, JSON_KEY_K));
       if (!k) {
         len = 0;
         if (ch == EOF) break;
         continue;
       }
 
-      if (strcmp(k, "type") == 0) {
+      const sirj_rec_t rk = (sirj_rec_t)sirj_ph_lookup(&sirj_rec_ph, k);
+      if (rk == SIRJ_REC_TYPE) {
         const uint32_t loc_line = loc_line_from_root(root, rec_no);
         uint32_t id = 0;
-        if (!sirj_intern_id(c, json_obj_get(root, "id"), &id) || id == 0) {
+        if (!sirj_intern_id(c, json_obj_get_sym(root, JSON_KEY_ID), &id) || id == 0) {
           sirj_diag_setf(c, "sem.parse.type.id", diag_path, loc_line, 0, NULL, "type.id missing/invalid");
           free(line);
           fclose(f);
@@ -5949,7 +6190,7 @@ static bool parse_file(sirj_ctx_t* c, const char* path) {
           fclose(f);
           return false;
         }
-        const char* kind = json_get_string(json_obj_get(root, "kind"));
+        const char* kind = json_get_string(json_obj_get_sym(root, JSON_KEY_KIND));
         if (!kind) {
           sirj_diag_setf(c, "sem.parse.type.kind", diag_path, loc_line, 0, NULL, "type.kind missing");
           free(line);
@@ -5957,11 +6198,13 @@ static bool parse_file(sirj_ctx_t* c, const char* path) {
           return false;
         }
 
+        const sirj_typekind_t tk = (sirj_typekind_t)sirj_ph_lookup(&sirj_typekind_ph, kind);
+
         type_info_t ti = {0};
         ti.present = true;
         ti.loc_line = loc_line;
-        if (strcmp(kind, "prim") == 0) {
-          const char* prim = json_get_string(json_obj_get(root, "prim"));
+        if (tk == SIRJ_TYPEKIND_PRIM) {
+          const char* prim = json_get_string(json_obj_get_sym(root, JSON_KEY_PRIM));
           ti.prim = prim_from_string(prim);
           if (ti.prim == SIR_PRIM_INVALID) {
             sirj_diag_setf(c, "sem.unsupported.prim", diag_path, loc_line, 0, NULL, "unsupported prim: %s", prim ? prim : "(null)");
@@ -5969,42 +6212,42 @@ static bool parse_file(sirj_ctx_t* c, const char* path) {
             fclose(f);
             return false;
           }
-        } else if (strcmp(kind, "fn") == 0) {
+        } else if (tk == SIRJ_TYPEKIND_FN) {
           ti.is_fn = true;
-          const JsonValue* pv = obj_req(root, "params");
+          const JsonValue* pv = obj_req(root, JSON_KEY_PARAMS);
           if (!parse_u32_array(c, pv, &ti.params, &ti.param_count, &c->arena)) {
             sirj_diag_setf(c, "sem.parse.type.fn.params", diag_path, loc_line, 0, NULL, "bad fn params array");
             free(line);
             fclose(f);
             return false;
           }
-          if (!sirj_intern_id(c, json_obj_get(root, "ret"), &ti.ret)) {
+          if (!sirj_intern_id(c, json_obj_get_sym(root, JSON_KEY_RET), &ti.ret)) {
             sirj_diag_setf(c, "sem.parse.type.fn.ret", diag_path, loc_line, 0, NULL, "bad fn ret");
             free(line);
             fclose(f);
             return false;
           }
-        } else if (strcmp(kind, "fun") == 0) {
+        } else if (tk == SIRJ_TYPEKIND_FUN) {
           ti.is_fun = true;
           uint32_t sig = 0;
-          if (!sirj_intern_id(c, json_obj_get(root, "sig"), &sig)) {
+          if (!sirj_intern_id(c, json_obj_get_sym(root, JSON_KEY_SIG), &sig)) {
             sirj_diag_setf(c, "sem.parse.type.fun.sig", diag_path, loc_line, 0, NULL, "bad fun.sig");
             free(line);
             fclose(f);
             return false;
           }
           ti.fun_sig = sig;
-        } else if (strcmp(kind, "closure") == 0) {
+        } else if (tk == SIRJ_TYPEKIND_CLOSURE) {
           ti.is_closure = true;
           uint32_t call_sig = 0;
           uint32_t env = 0;
-          if (!sirj_intern_id(c, json_obj_get(root, "callSig"), &call_sig)) {
+          if (!sirj_intern_id(c, json_obj_get_sym(root, JSON_KEY_CALL_SIG), &call_sig)) {
             sirj_diag_setf(c, "sem.parse.type.closure.callSig", diag_path, loc_line, 0, NULL, "bad closure.callSig");
             free(line);
             fclose(f);
             return false;
           }
-          if (!sirj_intern_id(c, json_obj_get(root, "env"), &env)) {
+          if (!sirj_intern_id(c, json_obj_get_sym(root, JSON_KEY_ENV), &env)) {
             sirj_diag_setf(c, "sem.parse.type.closure.env", diag_path, loc_line, 0, NULL, "bad closure.env");
             free(line);
             fclose(f);
@@ -6012,9 +6255,9 @@ static bool parse_file(sirj_ctx_t* c, const char* path) {
           }
           ti.closure_call_sig = call_sig;
           ti.closure_env = env;
-        } else if (strcmp(kind, "sum") == 0) {
+        } else if (tk == SIRJ_TYPEKIND_SUM) {
           ti.is_sum = true;
-          const JsonValue* vv = json_obj_get(root, "variants");
+          const JsonValue* vv = json_obj_get_sym(root, JSON_KEY_VARIANTS);
           if (!json_is_array(vv)) {
             sirj_diag_setf(c, "sem.parse.type.sum.variants", diag_path, loc_line, 0, NULL, "bad sum.variants array");
             free(line);
@@ -6050,7 +6293,7 @@ static bool parse_file(sirj_ctx_t* c, const char* path) {
             }
             uint32_t pty = 0;
             // payload type is optional.
-            const JsonValue* tyv = json_obj_get((JsonValue*)vobj, "ty");
+            const JsonValue* tyv = json_obj_get_sym((JsonValue*)vobj, JSON_KEY_TY);
             if (tyv) {
               if (!sirj_intern_id(c, tyv, &pty)) {
                 sirj_diag_setf(c, "sem.parse.type.sum.variant", diag_path, loc_line, 0, NULL, "sum.variants[%u].ty invalid", (unsigned)vi);
@@ -6061,28 +6304,28 @@ static bool parse_file(sirj_ctx_t* c, const char* path) {
             }
             ti.sum_payload_types[vi] = pty;
           }
-        } else if (strcmp(kind, "array") == 0) {
+        } else if (tk == SIRJ_TYPEKIND_ARRAY) {
           ti.is_array = true;
-          if (!sirj_intern_id(c, json_obj_get(root, "of"), &ti.array_of)) {
+          if (!sirj_intern_id(c, json_obj_get_sym(root, JSON_KEY_OF), &ti.array_of)) {
             sirj_diag_setf(c, "sem.parse.type.array.of", diag_path, loc_line, 0, NULL, "bad array.of");
             free(line);
             fclose(f);
             return false;
           }
-          if (!json_get_u32(json_obj_get(root, "len"), &ti.array_len)) {
+          if (!json_get_u32(json_obj_get_sym(root, JSON_KEY_LEN), &ti.array_len)) {
             sirj_diag_setf(c, "sem.parse.type.array.len", diag_path, loc_line, 0, NULL, "bad array.len");
             free(line);
             fclose(f);
             return false;
           }
-        } else if (strcmp(kind, "ptr") == 0) {
+        } else if (tk == SIRJ_TYPEKIND_PTR) {
           ti.is_ptr = true;
           ti.prim = SIR_PRIM_PTR;
-          const JsonValue* ofv = json_obj_get(root, "of");
+          const JsonValue* ofv = json_obj_get_sym(root, JSON_KEY_OF);
           if (ofv) (void)sirj_intern_id(c, ofv, &ti.ptr_of);
-        } else if (strcmp(kind, "struct") == 0) {
+        } else if (tk == SIRJ_TYPEKIND_STRUCT) {
           ti.is_struct = true;
-          const JsonValue* fv = json_obj_get(root, "fields");
+          const JsonValue* fv = json_obj_get_sym(root, JSON_KEY_FIELDS);
           if (!json_is_array(fv)) {
             sirj_diag_setf(c, "sem.parse.type.struct.fields", diag_path, loc_line, 0, NULL, "bad struct.fields array");
             free(line);
@@ -6117,8 +6360,8 @@ static bool parse_file(sirj_ctx_t* c, const char* path) {
               return false;
             }
             uint32_t ty = 0;
-            if (!sirj_intern_id(c, json_obj_get(fobj, "type_ref"), &ty)) {
-              const JsonValue* tyv = json_obj_get(fobj, "ty");
+            if (!sirj_intern_id(c, json_obj_get_sym(fobj, JSON_KEY_TYPE_REF), &ty)) {
+              const JsonValue* tyv = json_obj_get_sym(fobj, JSON_KEY_TY);
               if (!parse_ref_id(c, tyv, &ty)) {
                 sirj_diag_setf(c, "sem.parse.type.struct.field", diag_path, loc_line, 0, NULL, "struct field missing/invalid type_ref");
                 free(line);
@@ -6135,7 +6378,7 @@ static bool parse_file(sirj_ctx_t* c, const char* path) {
             ti.struct_fields[fi] = ty;
 
             uint32_t falign = 0;
-            const JsonValue* av = json_obj_get(fobj, "align");
+            const JsonValue* av = json_obj_get_sym(fobj, JSON_KEY_ALIGN);
             if (av) {
               if (!json_get_u32(av, &falign) || falign == 0 || !is_pow2_u32(falign)) {
                 sirj_diag_setf(c, "sem.parse.type.struct.field.align", diag_path, loc_line, 0, NULL,
@@ -6149,7 +6392,7 @@ static bool parse_file(sirj_ctx_t* c, const char* path) {
           }
 
           bool packed = false;
-          const JsonValue* pv = json_obj_get(root, "packed");
+          const JsonValue* pv = json_obj_get_sym(root, JSON_KEY_PACKED);
           if (pv) {
             if (!json_get_bool(pv, &packed)) {
               sirj_diag_setf(c, "sem.parse.type.struct.packed", diag_path, loc_line, 0, NULL, "struct.packed must be boolean");
@@ -6161,7 +6404,7 @@ static bool parse_file(sirj_ctx_t* c, const char* path) {
           ti.struct_packed = packed;
 
           uint32_t salign = 0;
-          const JsonValue* av = json_obj_get(root, "align");
+          const JsonValue* av = json_obj_get_sym(root, JSON_KEY_ALIGN);
           if (av) {
             if (!json_get_u32(av, &salign) || salign == 0 || !is_pow2_u32(salign)) {
               sirj_diag_setf(c, "sem.parse.type.struct.align", diag_path, loc_line, 0, NULL, "struct.align must be a positive power of two");
@@ -6178,10 +6421,10 @@ static bool parse_file(sirj_ctx_t* c, const char* path) {
           ti.loc_line = loc_line;
         }
         c->types[id] = ti;
-      } else if (strcmp(k, "sym") == 0) {
+      } else if (rk == SIRJ_REC_SYM) {
         const uint32_t loc_line = loc_line_from_root(root, rec_no);
         uint32_t id = 0;
-        if (!sirj_intern_id(c, json_obj_get(root, "id"), &id) || id == 0) {
+        if (!sirj_intern_id(c, json_obj_get_sym(root, JSON_KEY_ID), &id) || id == 0) {
           sirj_diag_setf(c, "sem.parse.sym.id", diag_path, loc_line, 0, NULL, "sym.id missing/invalid");
           free(line);
           fclose(f);
@@ -6197,18 +6440,18 @@ static bool parse_file(sirj_ctx_t* c, const char* path) {
         sym_info_t si = {0};
         si.present = true;
         si.loc_line = loc_line;
-        si.name = json_get_string(json_obj_get(root, "name"));
-        si.kind = json_get_string(json_obj_get(root, "kind"));
-        const JsonValue* trv = json_obj_get(root, "type_ref");
+        si.name = json_get_string(json_obj_get_sym(root, JSON_KEY_NAME));
+        si.kind = json_get_string(json_obj_get_sym(root, JSON_KEY_KIND));
+        const JsonValue* trv = json_obj_get_sym(root, JSON_KEY_TYPE_REF);
         if (trv) (void)sirj_intern_id(c, trv, &si.type_ref);
         si.init_kind = SYM_INIT_NONE;
 
-        const JsonValue* vv = json_obj_get(root, "value");
+        const JsonValue* vv = json_obj_get_sym(root, JSON_KEY_VALUE);
         if (vv && vv->type == JSON_OBJECT) {
-          const char* t = json_get_string(json_obj_get(vv, "t"));
+          const char* t = json_get_string(json_obj_get_sym(vv, JSON_KEY_T));
           if (t && strcmp(t, "num") == 0) {
             int64_t v = 0;
-            if (!json_get_i64(json_obj_get(vv, "v"), &v)) {
+            if (!json_get_i64(json_obj_get_sym(vv, JSON_KEY_V), &v)) {
               sirj_diag_setf(c, "sem.parse.sym.value", diag_path, loc_line, id, "sym", "sym.value num missing/invalid");
               free(line);
               fclose(f);
@@ -6230,10 +6473,10 @@ static bool parse_file(sirj_ctx_t* c, const char* path) {
         }
 
         c->syms[id] = si;
-      } else if (strcmp(k, "node") == 0) {
+      } else if (rk == SIRJ_REC_NODE) {
         const uint32_t loc_line = loc_line_from_root(root, rec_no);
         uint32_t id = 0;
-        if (!sirj_intern_id(c, json_obj_get(root, "id"), &id) || id == 0) {
+        if (!sirj_intern_id(c, json_obj_get_sym(root, JSON_KEY_ID), &id) || id == 0) {
           sirj_diag_setf(c, "sem.parse.node.id", diag_path, loc_line, 0, NULL, "node.id missing/invalid");
           free(line);
           fclose(f);
@@ -6247,10 +6490,11 @@ static bool parse_file(sirj_ctx_t* c, const char* path) {
         }
         node_info_t ni = {0};
         ni.present = true;
-        ni.tag = json_get_string(json_obj_get(root, "tag"));
-        const JsonValue* trv = json_obj_get(root, "type_ref");
+        ni.tag = json_get_string(json_obj_get_sym(root, JSON_KEY_TAG));
+        ni.tag_id = sirj_tag_lookup(ni.tag);
+        const JsonValue* trv = json_obj_get_sym(root, JSON_KEY_TYPE_REF);
         if (trv) (void)sirj_intern_id(c, trv, &ni.type_ref);
-        const JsonValue* fv = json_obj_get(root, "fields");
+        const JsonValue* fv = json_obj_get_sym(root, JSON_KEY_FIELDS);
         if (fv && json_is_object(fv)) ni.fields_obj = (JsonValue*)fv;
         ni.loc_line = loc_line;
         c->nodes[id] = ni;
@@ -6271,10 +6515,10 @@ static bool find_entry_fn(const sirj_ctx_t* c, uint32_t* out_fn_node_id) {
   uint32_t best = 0;
   for (uint32_t i = 0; i < c->node_cap; i++) {
     if (!c->nodes[i].present) continue;
-    if (!c->nodes[i].tag || strcmp(c->nodes[i].tag, "fn") != 0) continue;
+    if (c->nodes[i].tag_id != SIRJ_TAG_FN) continue;
     const JsonValue* fo = c->nodes[i].fields_obj;
     if (!fo || fo->type != JSON_OBJECT) continue;
-    const char* nm = json_get_string(json_obj_get(fo, "name"));
+    const char* nm = json_get_string(json_obj_get_sym(fo, JSON_KEY_NAME));
     if (!nm) continue;
     if (strcmp(nm, "zir_main") == 0) {
       *out_fn_node_id = i;
@@ -6350,7 +6594,7 @@ static bool init_params_for_fn(sirj_ctx_t* c, uint32_t fn_node_id, uint32_t fn_t
   if (fn_node_id >= c->node_cap || !c->nodes[fn_node_id].present) return false;
   const node_info_t* fnn = &c->nodes[fn_node_id];
   if (!fnn->fields_obj || fnn->fields_obj->type != JSON_OBJECT) return false;
-  const JsonValue* pv = json_obj_get(fnn->fields_obj, "params");
+  const JsonValue* pv = json_obj_get_sym(fnn->fields_obj, JSON_KEY_PARAMS);
   if (!pv) {
     // no params
     return true;
@@ -6368,7 +6612,7 @@ static bool init_params_for_fn(sirj_ctx_t* c, uint32_t fn_node_id, uint32_t fn_t
     if (pid >= c->node_cap || !c->nodes[pid].present) return false;
     const node_info_t* pn = &c->nodes[pid];
     if (!pn->fields_obj || pn->fields_obj->type != JSON_OBJECT) return false;
-    const char* nm = json_get_string(json_obj_get(pn->fields_obj, "name"));
+    const char* nm = json_get_string(json_obj_get_sym(pn->fields_obj, JSON_KEY_NAME));
     if (!nm) return false;
 
     val_kind_t k = VK_INVALID;
@@ -6500,168 +6744,286 @@ static const char* sem_zi_err_name(int32_t rc) {
   }
 }
 
-static int sem_run_or_verify_sir_jsonl_impl(const char* path, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root,
-                                           sem_diag_format_t diag_format, bool diag_all, bool do_run, int* out_prog_rc,
-                                           const sir_exec_event_sink_t* sink, void (*post_run)(void* user, const sir_module_t* m, int32_t exec_rc),
-                                           void* post_user) {
-  if (!path) return 2;
+static bool lower_one_fn(sirj_ctx_t* c, uint32_t fn_node_id, sir_func_id_t fid, sir_func_id_t entry_fid) {
+  const char* path = c->cur_path;
+  const node_info_t* fnn = &c->nodes[fn_node_id];
+  if (!fnn->fields_obj || fnn->fields_obj->type != JSON_OBJECT) {
+    sirj_diag_setf(c, "sem.internal", path, fnn->loc_line, fn_node_id, "fn", "fn fields malformed");
+    return false;
+  }
+  const uint32_t fty = fnn->type_ref;
 
-  sirj_ctx_t c;
-  memset(&c, 0, sizeof(c));
-  arena_init(&c.arena);
-  c.diag_format = diag_format;
-  c.cur_path = path;
-  c.diag_all = diag_all;
+  if (!init_params_for_fn(c, fn_node_id, fty)) {
+    sirj_diag_setf(c, "sem.unsupported.fn_params", path, fnn->loc_line, fn_node_id, "fn", "unsupported fn params");
+    return false;
+  }
+  c->fn = fid;
+  const bool is_entry = (fid == entry_fid);
+  if (!lower_fn_body(c, fn_node_id, is_entry)) {
+    if (!c->diag.set) {
+      const char* nm = json_get_string(json_obj_get_sym(fnn->fields_obj, JSON_KEY_NAME));
+      sirj_diag_setf(c, "sem.unsupported", path, fnn->loc_line, fn_node_id, "fn", "unsupported SIR subset in fn=%s", nm ? nm : "?");
+    }
+    return false;
+  }
+  if (!sir_mb_func_set_value_count(c->mb, fid, c->next_slot)) {
+    sirj_diag_setf(c, "sem.internal", path, fnn->loc_line, fn_node_id, "fn", "failed to set value count");
+    return false;
+  }
+  return true;
+}
 
-  if (!parse_file(&c, path)) {
-    if (!c.diag.set) sirj_diag_setf(&c, "sem.parse", path, 0, 0, NULL, "failed to parse: %s", path);
-    sem_print_diag(&c);
-    ctx_dispose(&c);
-    return 1;
+static void sem_set_validate_diag(sirj_ctx_t* c, const sir_validate_diag_t* vd) {
+  const uint32_t diag_line = vd->src_line ? vd->src_line : 0;
+  const uint32_t diag_node = vd->src_node_id ? vd->src_node_id : 0;
+  if (vd->fid && vd->op != SIR_INST_INVALID) {
+    const char* op = sir_inst_kind_name(vd->op);
+    sirj_diag_setf_ex(c, vd->code ? vd->code : "sem.validate", c->cur_path, diag_line, diag_node, NULL, (uint32_t)vd->fid, (uint32_t)vd->ip, op,
+                      "module validate failed: %s", vd->message[0] ? vd->message : "invalid");
+  } else {
+    sirj_diag_setf(c, vd->code ? vd->code : "sem.validate", c->cur_path, diag_line, diag_node, NULL, "module validate failed: %s",
+                   vd->message[0] ? vd->message : "invalid");
+  }
+}
+
+// On-demand lowering for `sem --run --lazy`: bodies are lowered into the (still live)
+// builder on first call, then committed into the running module.
+typedef struct sem_lazy_ctx {
+  sirj_ctx_t* c;
+  const uint32_t* node_by_fid; // len=func_count+1
+  sir_func_id_t entry_fid;
+  bool failed; // diag is set in c
+} sem_lazy_ctx_t;
+
+static int32_t sem_lazy_load_fn(void* user, sir_module_t* m, sir_func_id_t fid) {
+  sem_lazy_ctx_t* lz = (sem_lazy_ctx_t*)user;
+  if (!lz || !lz->c || !m || fid == 0 || fid > m->func_count) return SEM_ZI_E_INTERNAL;
+  sirj_ctx_t* c = lz->c;
+  const uint32_t node_id = lz->node_by_fid[fid];
+  if (!lower_one_fn(c, node_id, fid, lz->entry_fid)) {
+    lz->failed = true;
+    return SEM_ZI_E_INVALID;
+  }
+  sir_validate_diag_t vd = {0};
+  if (!sir_mb_func_commit(c->mb, m, fid, &vd)) {
+    lz->failed = true;
+    if (vd.code) {
+      sem_set_validate_diag(c, &vd);
+      return SEM_ZI_E_INVALID;
+    }
+    sirj_diag_setf(c, "sem.internal", c->cur_path, c->nodes[node_id].loc_line, node_id, "fn", "failed to commit lazily lowered fn");
+    return SEM_ZI_E_INTERNAL;
+  }
+  return 0;
+}
+
+static int sem_exec_module(sirj_ctx_t* c, sir_module_t* m, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root, sem_lazy_ctx_t* lz,
+                           int* out_prog_rc, const sir_exec_event_sink_t* sink,
+                           void (*post_run)(void* user, const sir_module_t* m, int32_t exec_rc), void* post_user,
+                           const sem_replay_cfg_t* replay);
+
+#ifndef SIR_VERSION
+#define SIR_VERSION "0.0.0"
+#endif
+
+bool sem_content_hash_file(const char* path, const char* salt, char out[SEM_CONTENT_HASH_MAX]) {
+  FILE* f = fopen(path, "rb");
+  if (!f) return false;
+  uint64_t h1 = 1469598103934665603ull;
+  uint64_t h2 = 0x9E3779B97F4A7C15ull;
+  uint64_t len = 0;
+  for (const char* s = salt ? salt : ""; *s; s++) h1 = (h1 ^ (uint8_t)*s) * 1099511628211ull;
+  uint8_t buf[64 * 1024];
+  size_t n = 0;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+    for (size_t i = 0; i < n; i++) {
+      h1 = (h1 ^ buf[i]) * 1099511628211ull;
+      h2 = (h2 ^ buf[i]) * 0xFF51AFD7ED558CCDull;
+      h2 ^= h2 >> 29;
+    }
+    len += n;
+  }
+  const bool read_ok = !ferror(f);
+  fclose(f);
+  if (!read_ok) return false;
+  snprintf(out, SEM_CONTENT_HASH_MAX, "%016" PRIx64 "%016" PRIx64 "-%" PRIu64, h1, h2, len);
+  return true;
+}
+
+// Module image cache for `sem --run --cache-dir`. Images are keyed by the input bytes,
+// the tool version and the image format version, so stale entries are never hit and
+// nothing needs invalidating.
+static bool sem_cache_image_path(const char* cache_dir, const char* path, char* out, size_t cap) {
+  char salt[64];
+  snprintf(salt, sizeof(salt), "sem %s sirm %u\n", SIR_VERSION, (unsigned)SIR_MODULE_IMAGE_VERSION);
+  char key[SEM_CONTENT_HASH_MAX];
+  if (!sem_content_hash_file(path, salt, key)) return false;
+  const int w = snprintf(out, cap, "%s/%s.sirm", cache_dir, key);
+  return w > 0 && (size_t)w < cap;
+}
+
+// Best effort: a failed store only costs the next run a cache miss.
+static void sem_cache_store(const sir_module_t* m, const char* image_path) {
+  char tmp[4096];
+  const int w = snprintf(tmp, sizeof(tmp), "%s.tmp.%ld", image_path, (long)getpid());
+  if (w <= 0 || (size_t)w >= sizeof(tmp)) return;
+  if (!sir_module_write_image(m, tmp)) return;
+  if (rename(tmp, image_path) != 0) remove(tmp);
+}
+
+// Parses, lowers (eagerly unless `lazy`) and validates `path` into a module.
+// Returns NULL with the diagnostic set in `c` on failure.
+static sir_module_t* sem_build_module(sirj_ctx_t* c, const char* path, bool lazy, uint32_t** out_node_by_fid, sir_func_id_t* out_entry_fid) {
+  if (!parse_file(c, path)) {
+    if (!c->diag.set) sirj_diag_setf(c, "sem.parse", path, 0, 0, NULL, "failed to parse: %s", path);
+    return NULL;
+  }
+  for (uint32_t i = 0; i < c->symrec_cap; i++) {
+    if (!c->syms || !c->syms[i].present || !c->syms[i].name) continue;
+    if (!sirj_names_put_first(&c->sym_by_name, c->syms[i].name, i)) {
+      sirj_diag_setf(c, "sem.oom", path, 0, 0, NULL, "out of memory");
+      return NULL;
+    }
   }
 
   uint32_t entry_fn_node_id = 0;
-  if (!find_entry_fn(&c, &entry_fn_node_id)) {
-    sirj_diag_setf(&c, "sem.no_entry_fn", path, 0, 0, NULL, "no entry fn (expected fn name zir_main or main)");
-    sem_print_diag(&c);
-    ctx_dispose(&c);
-    return 1;
+  if (!find_entry_fn(c, &entry_fn_node_id)) {
+    sirj_diag_setf(c, "sem.no_entry_fn", path, 0, 0, NULL, "no entry fn (expected fn name zir_main or main)");
+    return NULL;
   }
 
-  c.mb = sir_mb_new();
-  if (!c.mb) {
-    sirj_diag_setf(&c, "sem.oom", path, 0, 0, NULL, "out of memory");
-    sem_print_diag(&c);
-    ctx_dispose(&c);
-    return 1;
+  c->mb = sir_mb_new();
+  if (!c->mb) {
+    sirj_diag_setf(c, "sem.oom", path, 0, 0, NULL, "out of memory");
+    return NULL;
   }
-  if (!ensure_prim_types(&c)) {
-    sirj_diag_setf(&c, "sem.oom", path, 0, 0, NULL, "out of memory");
-    sem_print_diag(&c);
-    ctx_dispose(&c);
-    return 1;
+  if (!ensure_prim_types(c)) {
+    sirj_diag_setf(c, "sem.oom", path, 0, 0, NULL, "out of memory");
+    return NULL;
   }
 
-  if (!lower_globals(&c)) {
-    if (!c.diag.set) sirj_diag_setf(&c, "sem.global", path, 0, 0, NULL, "failed to lower globals");
-    sem_print_diag(&c);
-    ctx_dispose(&c);
-    return 1;
+  if (!lower_globals(c)) {
+    if (!c->diag.set) sirj_diag_setf(c, "sem.global", path, 0, 0, NULL, "failed to lower globals");
+    return NULL;
   }
 
   // Create module funcs for all SIR fn nodes so ptr.sym can resolve them.
   uint32_t entry_fid = 0;
-  for (uint32_t i = 0; i < c.node_cap; i++) {
-    if (!c.nodes[i].present) continue;
-    if (!c.nodes[i].tag || strcmp(c.nodes[i].tag, "fn") != 0) continue;
-    if (!c.nodes[i].fields_obj || c.nodes[i].fields_obj->type != JSON_OBJECT) continue;
-    const char* nm = json_get_string(json_obj_get(c.nodes[i].fields_obj, "name"));
+  for (uint32_t i = 0; i < c->node_cap; i++) {
+    if (!c->nodes[i].present) continue;
+    if (c->nodes[i].tag_id != SIRJ_TAG_FN) continue;
+    if (!c->nodes[i].fields_obj || c->nodes[i].fields_obj->type != JSON_OBJECT) continue;
+    const char* nm = json_get_string(json_obj_get_sym(c->nodes[i].fields_obj, JSON_KEY_NAME));
     if (!nm) continue;
-    const sir_func_id_t fid = sir_mb_func_begin(c.mb, nm);
+    const sir_func_id_t fid = sir_mb_func_begin(c->mb, nm);
     if (!fid) {
-      sirj_diag_setf(&c, "sem.oom", path, c.nodes[i].loc_line, i, "fn", "out of memory");
-      sem_print_diag(&c);
-      ctx_dispose(&c);
-      return 1;
+      sirj_diag_setf(c, "sem.oom", path, c->nodes[i].loc_line, i, "fn", "out of memory");
+      return NULL;
+    }
+    c->func_by_node[i] = fid;
+    if (!sirj_names_put_first(&c->func_by_name, nm, fid)) {
+      sirj_diag_setf(c, "sem.oom", path, c->nodes[i].loc_line, i, "fn", "out of memory");
+      return NULL;
     }
-    c.func_by_node[i] = fid;
 
-    uint32_t fty = c.nodes[i].type_ref;
+    uint32_t fty = c->nodes[i].type_ref;
     sir_sig_t sig = {0};
-    if (fty && build_fn_sig(&c, fty, &sig)) {
+    if (fty && build_fn_sig(c, fty, &sig)) {
       if (i == entry_fn_node_id) {
         // `sir_module_run` executes the entry function as a process, not as a callable,
         // so it does not accept a return-value contract. Entry should EXIT/EXIT_VAL.
         sig.results = NULL;
         sig.result_count = 0;
       }
-      if (!sir_mb_func_set_sig(c.mb, fid, sig)) {
-        sirj_diag_setf(&c, "sem.oom", path, c.nodes[i].loc_line, i, "fn", "out of memory");
-        sem_print_diag(&c);
-        ctx_dispose(&c);
-        return 1;
+      if (!sir_mb_func_set_sig(c->mb, fid, sig)) {
+        sirj_diag_setf(c, "sem.oom", path, c->nodes[i].loc_line, i, "fn", "out of memory");
+        return NULL;
       }
     }
 
     if (i == entry_fn_node_id) entry_fid = fid;
   }
   if (!entry_fid) {
-    sirj_diag_setf(&c, "sem.internal", path, 0, 0, NULL, "failed to map entry function");
-    sem_print_diag(&c);
-    ctx_dispose(&c);
-    return 1;
+    sirj_diag_setf(c, "sem.internal", path, 0, 0, NULL, "failed to map entry function");
+    return NULL;
   }
-  if (!sir_mb_func_set_entry(c.mb, entry_fid)) {
-    sirj_diag_setf(&c, "sem.internal", path, 0, 0, NULL, "failed to init module func");
-    sem_print_diag(&c);
-    ctx_dispose(&c);
-    return 1;
+  if (!sir_mb_func_set_entry(c->mb, entry_fid)) {
+    sirj_diag_setf(c, "sem.internal", path, 0, 0, NULL, "failed to init module func");
+    return NULL;
   }
 
-  // Lower each function body.
-  for (uint32_t i = 0; i < c.node_cap; i++) {
-    const sir_func_id_t fid = (i < c.func_by_node_cap) ? c.func_by_node[i] : 0;
-    if (!fid) continue;
-    const node_info_t* fnn = &c.nodes[i];
-    if (!fnn->fields_obj || fnn->fields_obj->type != JSON_OBJECT) {
-      sirj_diag_setf(&c, "sem.internal", path, fnn->loc_line, i, "fn", "fn fields malformed");
-      sem_print_diag(&c);
-      ctx_dispose(&c);
-      return 1;
+  // Lower each function body (or, when lazy, defer it to the first call).
+  uint32_t* node_by_fid = NULL;
+  if (lazy) {
+    node_by_fid = (uint32_t*)arena_alloc(&c->arena, ((size_t)c->node_cap + 1u) * sizeof(uint32_t));
+    if (!node_by_fid) {
+      sirj_diag_setf(c, "sem.oom", path, 0, 0, NULL, "out of memory");
+      return NULL;
     }
-    const uint32_t fty = fnn->type_ref;
-
-    if (!init_params_for_fn(&c, i, fty)) {
-      sirj_diag_setf(&c, "sem.unsupported.fn_params", path, fnn->loc_line, i, "fn", "unsupported fn params");
-      sem_print_diag(&c);
-      ctx_dispose(&c);
-      return 1;
-    }
-    c.fn = fid;
-    const bool is_entry = (fid == entry_fid);
-    if (!lower_fn_body(&c, i, is_entry)) {
-      if (!c.diag.set) {
-        const char* nm = json_get_string(json_obj_get(fnn->fields_obj, "name"));
-        sirj_diag_setf(&c, "sem.unsupported", path, fnn->loc_line, i, "fn", "unsupported SIR subset in fn=%s", nm ? nm : "?");
+  }
+  for (uint32_t i = 0; i < c->node_cap; i++) {
+    const sir_func_id_t fid = (i < c->func_by_node_cap) ? c->func_by_node[i] : 0;
+    if (!fid) continue;
+    if (lazy) {
+      node_by_fid[fid] = i;
+      if (!sir_mb_func_set_lazy(c->mb, fid, true)) {
+        sirj_diag_setf(c, "sem.internal", path, c->nodes[i].loc_line, i, "fn", "failed to init module func");
+        return NULL;
       }
-      sem_print_diag(&c);
-      ctx_dispose(&c);
-      return 1;
+      continue;
     }
-    if (!sir_mb_func_set_value_count(c.mb, fid, c.next_slot)) {
-      sirj_diag_setf(&c, "sem.internal", path, fnn->loc_line, i, "fn", "failed to set value count");
-      sem_print_diag(&c);
-      ctx_dispose(&c);
-      return 1;
+    if (!lower_one_fn(c, i, fid, entry_fid)) {
+      return NULL;
     }
   }
 
-  sir_module_t* m = sir_mb_finalize(c.mb);
+  sir_module_t* m = sir_mb_finalize(c->mb);
   if (!m) {
-    sirj_diag_setf(&c, "sem.internal", path, 0, 0, NULL, "failed to finalize module");
-    sem_print_diag(&c);
-    ctx_dispose(&c);
-    return 1;
+    sirj_diag_setf(c, "sem.internal", path, 0, 0, NULL, "failed to finalize module");
+    return NULL;
   }
 
   sir_validate_diag_t vd = {0};
   if (!sir_module_validate_ex(m, &vd)) {
     sir_module_free(m);
-    const uint32_t diag_line = vd.src_line ? vd.src_line : 0;
-    const uint32_t diag_node = vd.src_node_id ? vd.src_node_id : 0;
-    if (vd.fid && vd.op != SIR_INST_INVALID) {
-      const char* op = sir_inst_kind_name(vd.op);
-      sirj_diag_setf_ex(&c, vd.code ? vd.code : "sem.validate", path, diag_line, diag_node, NULL, (uint32_t)vd.fid, (uint32_t)vd.ip, op,
-                        "module validate failed: %s", vd.message[0] ? vd.message : "invalid");
-    } else {
-      sirj_diag_setf(&c, vd.code ? vd.code : "sem.validate", path, diag_line, diag_node, NULL, "module validate failed: %s",
-                     vd.message[0] ? vd.message : "invalid");
-    }
+    sem_set_validate_diag(c, &vd);
+    return NULL;
+  }
+
+  if (out_node_by_fid) *out_node_by_fid = node_by_fid;
+  if (out_entry_fid) *out_entry_fid = entry_fid;
+  return m;
+}
+
+static int sem_run_or_verify_sir_jsonl_impl(const char* path, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root,
+                                           sem_diag_format_t diag_format, bool diag_all, bool do_run, bool lazy, const char* image_out,
+                                           const sem_run_io_t* io, int* out_prog_rc, const sir_exec_event_sink_t* sink,
+                                           void (*post_run)(void* user, const sir_module_t* m, int32_t exec_rc), void* post_user,
+                                           const sem_replay_cfg_t* replay) {
+  if (!path) return 2;
+
+  sirj_ctx_t c;
+  memset(&c, 0, sizeof(c));
+  arena_init(&c.arena);
+  c.diag_format = diag_format;
+  c.cur_path = path;
+  c.diag_all = diag_all;
+  if (io) {
+    c.io = *io;
+    c.diag_out = io->err;
+  }
+
+  uint32_t* node_by_fid = NULL;
+  sir_func_id_t entry_fid = 0;
+  sir_module_t* m = sem_build_module(&c, path, lazy, &node_by_fid, &entry_fid);
+  if (!m) {
     sem_print_diag(&c);
     ctx_dispose(&c);
     return 1;
   }
 
+  if (image_out) sem_cache_store(m, image_out);
+
   if (!do_run) {
     sir_module_free(m);
     ctx_dispose(&c);
@@ -6669,6 +7031,20 @@ static int sem_run_or_verify_sir_jsonl_impl(const char* path, const sem_cap_t* c
     return 0;
   }
 
+  sem_lazy_ctx_t lz = {.c = &c, .node_by_fid = node_by_fid, .entry_fid = entry_fid};
+  return sem_exec_module(&c, m, caps, cap_count, fs_root, lazy ? &lz : NULL, out_prog_rc, sink, post_run, post_user, replay);
+}
+
+// Runs a validated module and reports execution failures. Takes ownership of `m`
+// and disposes `c`.
+static int sem_exec_module(sirj_ctx_t* c, sir_module_t* m, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root, sem_lazy_ctx_t* lz,
+                           int* out_prog_rc, const sir_exec_event_sink_t* sink,
+                           void (*post_run)(void* user, const sir_module_t* m, int32_t exec_rc), void* post_user,
+                           const sem_replay_cfg_t* replay) {
+  const char* path = c->cur_path;
+  const sem_diag_format_t diag_format = c->diag_format;
+  FILE* derr = c->diag_out ? c->diag_out : stderr;
+
   sir_hosted_zabi_t hz;
   if (!sir_hosted_zabi_init(
           &hz, (sir_hosted_zabi_cfg_t){.abi_version = 0x00020005u,
@@ -6676,52 +7052,97 @@ static int sem_run_or_verify_sir_jsonl_impl(const char* path, const sem_cap_t* c
                                        .guest_mem_base = 0x10000ull,
                                        .caps = caps,
                                        .cap_count = cap_count,
-                                       .fs_root = fs_root})) {
+                                       .fs_root = fs_root,
+                                       .stdin_f = c->io.in,
+                                       .stdout_f = c->io.out,
+                                       .stderr_f = c->io.err,
+                                       .stdout_buffering = c->io.out_line_buffered ? SIR_STDIO_BUF_LINE : SIR_STDIO_BUF_AUTO})) {
     sir_module_free(m);
-    sirj_diag_setf(&c, "sem.runtime_init", path, 0, 0, NULL, "failed to init runtime");
-    sem_print_diag(&c);
-    ctx_dispose(&c);
+    sirj_diag_setf(c, "sem.runtime_init", path, 0, 0, NULL, "failed to init runtime");
+    sem_print_diag(c);
+    ctx_dispose(c);
     return 1;
   }
 
   const sir_host_t host = sem_hosted_make_host(&hz);
-  sem_wrap_sink_t wrap = {.inner = sink};
+  char replay_err[512];
+  sem_replay_t* rp = NULL;
+  if (replay) {
+    rp = sem_replay_open(replay, m, hz.mem, host, replay_err, sizeof(replay_err));
+    if (!rp) {
+      sir_hosted_zabi_dispose(&hz);
+      sir_module_free(m);
+      sirj_diag_setf(c, "sem.replay", path, 0, 0, NULL, "%s", replay_err);
+      sem_print_diag(c);
+      ctx_dispose(c);
+      return 1;
+    }
+    if (sem_replay_resumed_at(rp) && diag_format == SEM_DIAG_TEXT) {
+      fprintf(derr, "sem: replay: resuming from checkpoint at step %" PRIu64 "\n", sem_replay_resumed_at(rp));
+    }
+  }
+
+  sem_wrap_sink_t wrap = {.inner = rp ? sem_replay_sink(rp, sink) : sink};
   const sir_exec_event_sink_t wrap_sink = {
       .user = &wrap,
       .on_step = sem_wrap_on_step,
       .on_mem = sem_wrap_on_mem,
       .on_hostcall = sem_wrap_on_hostcall,
   };
-  const sir_exec_event_sink_t* sink2 = (sink || diag_format == SEM_DIAG_JSON) ? &wrap_sink : NULL;
-  const int32_t rc = sir_module_run_ex(m, hz.mem, host, sink2);
+  const sir_exec_event_sink_t* sink2 = (sink || rp || diag_format == SEM_DIAG_JSON) ? &wrap_sink : NULL;
+  // Every caller has validated `m` (sem_build_module, or the cache hit path).
+  int32_t rc = 0;
+  if (rp) {
+    rc = sem_replay_run(rp, m, hz.mem, sink2);
+  } else if (lz) {
+    rc = sir_module_run_lazy(m, hz.mem, host, sink2, sem_lazy_load_fn, lz);
+  } else {
+    rc = sir_module_run_validated(m, hz.mem, host, sink2, 0, NULL);
+  }
+  // Guest stdout is buffered; it must land before any trap diagnostic below.
+  (void)sir_hosted_zabi_flush(&hz);
   if (post_run) post_run(post_user, m, rc);
+  const bool replay_ok = sem_replay_close(rp, replay_err, sizeof(replay_err));
 
   sir_hosted_zabi_dispose(&hz);
   sir_module_free(m);
-  ctx_dispose(&c);
+  if (!replay_ok) {
+    // Reported instead of the exec error a diverged replay host produces.
+    sirj_diag_setf(c, "sem.replay", path, 0, 0, NULL, "%s", replay_err);
+    sem_print_diag(c);
+    ctx_dispose(c);
+    return 1;
+  }
+  if (lz && lz->failed) {
+    // A body lowered on demand failed to lower/validate: report it like the eager path would.
+    sem_print_diag(c);
+    ctx_dispose(c);
+    return 1;
+  }
+  ctx_dispose(c);
 
   if (rc < 0) {
     // Execution errors come from sircore (ZI_E_*).
     if (diag_format == SEM_DIAG_JSON) {
-      fprintf(stderr, "{\"tool\":\"sem\",\"code\":\"sem.exec\",\"message\":\"execution failed\",\"rc\":%d,\"rc_name\":\"%s\"", (int)rc,
+      fprintf(derr, "{\"tool\":\"sem\",\"code\":\"sem.exec\",\"message\":\"execution failed\",\"rc\":%d,\"rc_name\":\"%s\"", (int)rc,
               sem_zi_err_name(rc));
       if (sink2) {
-        if (wrap.last.node_id) fprintf(stderr, ",\"node\":%u", (unsigned)wrap.last.node_id);
-        if (wrap.last.line) fprintf(stderr, ",\"line\":%u", (unsigned)wrap.last.line);
+        if (wrap.last.node_id) fprintf(derr, ",\"node\":%u", (unsigned)wrap.last.node_id);
+        if (wrap.last.line) fprintf(derr, ",\"line\":%u", (unsigned)wrap.last.line);
         if (wrap.last.fid) {
-          fprintf(stderr, ",\"fid\":%u", (unsigned)wrap.last.fid);
-          fprintf(stderr, ",\"ip\":%u", (unsigned)wrap.last.ip);
-          fprintf(stderr, ",\"op\":\"%s\"", sir_inst_kind_name(wrap.last.op));
+          fprintf(derr, ",\"fid\":%u", (unsigned)wrap.last.fid);
+          fprintf(derr, ",\"ip\":%u", (unsigned)wrap.last.ip);
+          fprintf(derr, ",\"op\":\"%s\"", sir_inst_kind_name(wrap.last.op));
         }
       }
-      fprintf(stderr, "}\n");
+      fprintf(derr, "}\n");
     } else {
-      fprintf(stderr, "sem: execution failed: %s (%d)\n", sem_zi_err_name(rc), (int)rc);
+      fprintf(derr, "sem: execution failed: %s (%d)\n", sem_zi_err_name(rc), (int)rc);
       if (sink2 && wrap.last.fid) {
-        fprintf(stderr, "sem:   at fid=%u ip=%u op=%s\n", (unsigned)wrap.last.fid, (unsigned)wrap.last.ip, sir_inst_kind_name(wrap.last.op));
+        fprintf(derr, "sem:   at fid=%u ip=%u op=%s\n", (unsigned)wrap.last.fid, (unsigned)wrap.last.ip, sir_inst_kind_name(wrap.last.op));
       }
       if (sink2 && (wrap.last.node_id || wrap.last.line)) {
-        fprintf(stderr, "sem:   at node=%u line=%u\n", (unsigned)wrap.last.node_id, (unsigned)wrap.last.line);
+        fprintf(derr, "sem:   at node=%u line=%u\n", (unsigned)wrap.last.node_id, (unsigned)wrap.last.line);
       }
     }
     return 1;
@@ -6733,7 +7154,7 @@ static int sem_run_or_verify_sir_jsonl_impl(const char* path, const sem_cap_t* c
 int sem_run_sir_jsonl(const char* path, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root) {
   int prog_rc = 0;
   const int tool_rc =
-      sem_run_or_verify_sir_jsonl_impl(path, caps, cap_count, fs_root, SEM_DIAG_TEXT, false, true, &prog_rc, NULL, NULL, NULL);
+      sem_run_or_verify_sir_jsonl_impl(path, caps, cap_count, fs_root, SEM_DIAG_TEXT, false, true, false, NULL, NULL, &prog_rc, NULL, NULL, NULL, NULL);
   if (tool_rc != 0) return tool_rc;
   return prog_rc;
 }
@@ -6741,7 +7162,7 @@ int sem_run_sir_jsonl(const char* path, const sem_cap_t* caps, uint32_t cap_coun
 int sem_run_sir_jsonl_ex(const char* path, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root, sem_diag_format_t diag_format,
                          bool diag_all) {
   int prog_rc = 0;
-  const int tool_rc = sem_run_or_verify_sir_jsonl_impl(path, caps, cap_count, fs_root, diag_format, diag_all, true, &prog_rc, NULL, NULL, NULL);
+  const int tool_rc = sem_run_or_verify_sir_jsonl_impl(path, caps, cap_count, fs_root, diag_format, diag_all, true, false, NULL, NULL, &prog_rc, NULL, NULL, NULL, NULL);
   if (tool_rc != 0) return tool_rc;
   return prog_rc;
 }
@@ -6749,14 +7170,124 @@ int sem_run_sir_jsonl_ex(const char* path, const sem_cap_t* caps, uint32_t cap_c
 int sem_run_sir_jsonl_capture_ex(const char* path, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root, sem_diag_format_t diag_format,
                                  bool diag_all, int* out_prog_rc) {
   int prog_rc = 0;
-  const int tool_rc = sem_run_or_verify_sir_jsonl_impl(path, caps, cap_count, fs_root, diag_format, diag_all, true, &prog_rc, NULL, NULL, NULL);
+  const int tool_rc = sem_run_or_verify_sir_jsonl_impl(path, caps, cap_count, fs_root, diag_format, diag_all, true, false, NULL, NULL, &prog_rc, NULL, NULL, NULL, NULL);
+  if (tool_rc != 0) return tool_rc;
+  if (out_prog_rc) *out_prog_rc = prog_rc;
+  return 0;
+}
+
+int sem_run_sir_jsonl_lazy_ex(const char* path, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root, sem_diag_format_t diag_format,
+                              bool diag_all, int* out_prog_rc) {
+  int prog_rc = 0;
+  const int tool_rc = sem_run_or_verify_sir_jsonl_impl(path, caps, cap_count, fs_root, diag_format, diag_all, true, true, NULL, NULL, &prog_rc, NULL, NULL, NULL, NULL);
+  if (tool_rc != 0) return tool_rc;
+  if (out_prog_rc) *out_prog_rc = prog_rc;
+  return 0;
+}
+
+int sem_run_sir_jsonl_cached_ex(const char* path, const char* cache_dir, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root,
+                                sem_diag_format_t diag_format, bool diag_all, int* out_prog_rc) {
+  if (!path) return 2;
+  char image_path[4096];
+  const bool have_key = cache_dir && cache_dir[0] && sem_cache_image_path(cache_dir, path, image_path, sizeof(image_path));
+
+  sir_module_t* m = have_key ? sir_module_load_image(image_path) : NULL;
+  // Cache files are untrusted input: a hit is validated like a freshly built module
+  // (which also bounds-checks its operand offsets), still far cheaper than the frontend.
+  if (m && !sir_module_validate_ex(m, NULL)) {
+    // Corrupt or foreign image: rebuild it below.
+    sir_module_free(m);
+    m = NULL;
+  }
+  int prog_rc = 0;
+  int tool_rc = 0;
+  if (m) {
+    sirj_ctx_t c;
+    memset(&c, 0, sizeof(c));
+    arena_init(&c.arena);
+    c.diag_format = diag_format;
+    c.cur_path = path;
+    c.diag_all = diag_all;
+    tool_rc = sem_exec_module(&c, m, caps, cap_count, fs_root, NULL, &prog_rc, NULL, NULL, NULL, NULL);
+  } else {
+    tool_rc = sem_run_or_verify_sir_jsonl_impl(path, caps, cap_count, fs_root, diag_format, diag_all, true, false,
+                                               have_key ? image_path : NULL, NULL, &prog_rc, NULL, NULL, NULL, NULL);
+  }
   if (tool_rc != 0) return tool_rc;
   if (out_prog_rc) *out_prog_rc = prog_rc;
   return 0;
 }
 
+struct sem_module {
+  sir_module_t* m;
+};
+
+sem_module_t* sem_module_load_sir_jsonl(const char* path, sem_load_err_t* err) {
+  if (err) memset(err, 0, sizeof(*err));
+  if (!path) return NULL;
+
+  sirj_ctx_t c;
+  memset(&c, 0, sizeof(c));
+  arena_init(&c.arena);
+  c.diag_format = SEM_DIAG_TEXT;
+  c.cur_path = path;
+
+  sir_module_t* m = sem_build_module(&c, path, false, NULL, NULL);
+  sem_module_t* sm = m ? (sem_module_t*)calloc(1, sizeof(*sm)) : NULL;
+  if (!sm) {
+    if (err) {
+      snprintf(err->code, sizeof(err->code), "%s", (c.diag.set && c.diag.code) ? c.diag.code : "sem.oom");
+      snprintf(err->message, sizeof(err->message), "%s", c.diag.set ? c.diag.msg : "out of memory");
+      err->line = c.diag.set ? c.diag.line : 0;
+      err->node_id = c.diag.set ? c.diag.node_id : 0;
+    }
+    sir_module_free(m);
+    ctx_dispose(&c);
+    return NULL;
+  }
+  // The finalized module owns everything it references; the frontend state can go.
+  ctx_dispose(&c);
+  sm->m = m;
+  return sm;
+}
+
+void sem_module_release(sem_module_t* sm) {
+  if (!sm) return;
+  sir_module_free(sm->m);
+  free(sm);
+}
+
+int32_t sem_module_run(const sem_module_t* sm, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root, sem_run_io_t io,
+                       int* out_prog_rc) {
+  if (!sm || !sm->m) return SEM_ZI_E_INVALID;
+  sir_hosted_zabi_t hz;
+  if (!sir_hosted_zabi_init(&hz, (sir_hosted_zabi_cfg_t){.abi_version = 0x00020005u,
+                                                         .guest_mem_cap = 16u * 1024u * 1024u,
+                                                         .guest_mem_base = 0x10000ull,
+                                                         .caps = caps,
+                                                         .cap_count = cap_count,
+                                                         .fs_root = fs_root,
+                                                         .stdin_f = io.in,
+                                                         .stdout_f = io.out,
+                                                         .stderr_f = io.err,
+                                                         .stdout_buffering = io.out_line_buffered ? SIR_STDIO_BUF_LINE : SIR_STDIO_BUF_AUTO})) {
+    return SEM_ZI_E_INTERNAL;
+  }
+  const sir_host_t host = sem_hosted_make_host(&hz);
+  const int32_t rc = sir_module_run_ex(sm->m, hz.mem, host, NULL);
+  sir_hosted_zabi_dispose(&hz);
+  if (rc < 0) return rc;
+  if (out_prog_rc) *out_prog_rc = (int)rc;
+  return 0;
+}
+
+const sir_module_t* sem_module_ir(const sem_module_t* sm) { return sm ? sm->m : NULL; }
+
+const char* sem_exec_rc_name(int32_t rc) { return sem_zi_err_name(rc); }
+
 typedef struct sem_trace_ctx {
   FILE* out;
+  sem_trace_bin_t* bin; // binary sink (--trace-bin-out) instead of JSONL when non-NULL
   const char* func_filter; // exact match on function name when non-NULL
   const char* op_filter;   // exact match on sir_inst_kind_name when non-NULL (step records only)
 } sem_trace_ctx_t;
@@ -6782,6 +7313,16 @@ static const char* sem_trace_func_name(const sir_module_t* m, sir_func_id_t fid)
   return f->name ? f->name : "";
 }
 
+static void sem_trace_src(const sir_module_t* m, sir_func_id_t fid, uint32_t ip, uint32_t* out_node, uint32_t* out_line) {
+  *out_node = 0;
+  *out_line = 0;
+  if (!m || fid == 0 || fid > m->func_count) return;
+  const sir_func_t* f = &m->funcs[fid - 1];
+  if (ip >= f->inst_count) return;
+  *out_node = f->insts[ip].src_node_id;
+  *out_line = f->insts[ip].src_line;
+}
+
 static void sem_trace_write_src(FILE* out, const sir_module_t* m, sir_func_id_t fid, uint32_t ip) {
   if (!out || !m || fid == 0 || fid > m->func_count) return;
   const sir_func_t* f = &m->funcs[fid - 1];
@@ -6794,10 +7335,16 @@ static void sem_trace_write_src(FILE* out, const sir_module_t* m, sir_func_id_t
 
 static void sem_trace_on_step(void* user, const sir_module_t* m, sir_func_id_t fid, uint32_t ip, sir_inst_kind_t k) {
   sem_trace_ctx_t* t = (sem_trace_ctx_t*)user;
-  if (!t || !t->out) return;
+  if (!t || (!t->out && !t->bin)) return;
   const char* fn = sem_trace_func_name(m, fid);
   if (t->func_filter && t->func_filter[0] && strcmp(fn, t->func_filter) != 0) return;
   if (t->op_filter && t->op_filter[0] && strcmp(sir_inst_kind_name(k), t->op_filter) != 0) return;
+  if (t->bin) {
+    uint32_t node = 0, line = 0;
+    sem_trace_src(m, fid, ip, &node, &line);
+    sem_trace_bin_step(t->bin, fid, fn, ip, (uint32_t)k, sir_inst_kind_name(k), node, line);
+    return;
+  }
   fprintf(t->out, "{\"tool\":\"sem\",\"k\":\"trace_step\",\"fid\":%u,\"func\":\"", (unsigned)fid);
   sem_json_write_escaped(t->out, fn);
   fprintf(t->out, "\",\"ip\":%u,\"op\":\"%s\"", (unsigned)ip, sir_inst_kind_name(k));
@@ -6824,9 +7371,15 @@ static void sem_cov_on_step(void* user, const sir_module_t* m, sir_func_id_t fid
 static void sem_trace_on_mem(void* user, const sir_module_t* m, sir_func_id_t fid, uint32_t ip, sir_mem_event_kind_t k, zi_ptr_t addr,
                              uint32_t size) {
   sem_trace_ctx_t* t = (sem_trace_ctx_t*)user;
-  if (!t || !t->out) return;
+  if (!t || (!t->out && !t->bin)) return;
   const char* fn = sem_trace_func_name(m, fid);
   if (t->func_filter && t->func_filter[0] && strcmp(fn, t->func_filter) != 0) return;
+  if (t->bin) {
+    uint32_t node = 0, line = 0;
+    sem_trace_src(m, fid, ip, &node, &line);
+    sem_trace_bin_mem(t->bin, fid, fn, ip, k == SIR_MEM_WRITE, (uint64_t)addr, size, node, line);
+    return;
+  }
   fprintf(t->out, "{\"tool\":\"sem\",\"k\":\"trace_mem\",\"fid\":%u,\"func\":\"", (unsigned)fid);
   sem_json_write_escaped(t->out, fn);
   fprintf(t->out, "\",\"ip\":%u,\"kind\":\"%s\",\"addr\":%" PRIu64 ",\"size\":%u", (unsigned)ip, (k == SIR_MEM_WRITE) ? "w" : "r",
@@ -6837,9 +7390,15 @@ static void sem_trace_on_mem(void* user, const sir_module_t* m, sir_func_id_t fi
 
 static void sem_trace_on_hostcall(void* user, const sir_module_t* m, sir_func_id_t fid, uint32_t ip, const char* callee, int32_t rc) {
   sem_trace_ctx_t* t = (sem_trace_ctx_t*)user;
-  if (!t || !t->out) return;
+  if (!t || (!t->out && !t->bin)) return;
   const char* fn = sem_trace_func_name(m, fid);
   if (t->func_filter && t->func_filter[0] && strcmp(fn, t->func_filter) != 0) return;
+  if (t->bin) {
+    uint32_t node = 0, line = 0;
+    sem_trace_src(m, fid, ip, &node, &line);
+    sem_trace_bin_hostcall(t->bin, fid, fn, ip, callee ? callee : "", rc, node, line);
+    return;
+  }
   fprintf(t->out, "{\"tool\":\"sem\",\"k\":\"trace_hostcall\",\"fid\":%u,\"func\":\"", (unsigned)fid);
   sem_json_write_escaped(t->out, fn);
   fprintf(t->out, "\",\"ip\":%u,\"callee\":\"", (unsigned)ip);
@@ -6923,16 +7482,22 @@ static void sem_events_post_run(void* user, const sir_module_t* m, int32_t exec_
           (uint64_t)e->cov->total_steps);
 }
 
-int sem_run_sir_jsonl_events_ex(const char* path, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root, sem_diag_format_t diag_format,
-                                bool diag_all, const char* trace_jsonl_out_path, const char* coverage_jsonl_out_path, const char* trace_func_filter,
-                                const char* trace_op_filter) {
+static int sem_run_events_impl(const char* path, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root, sem_diag_format_t diag_format,
+                               bool diag_all, const char* trace_out_path, bool trace_bin, const char* coverage_jsonl_out_path,
+                               const char* trace_func_filter, const char* trace_op_filter,
+                               const sem_replay_cfg_t* replay) {
   FILE* trace_out = NULL;
+  sem_trace_bin_t* trace_bin_out = NULL;
   FILE* cov_out = NULL;
 
-  if (trace_jsonl_out_path && trace_jsonl_out_path[0]) {
-    trace_out = fopen(trace_jsonl_out_path, "wb");
-    if (!trace_out) {
-      fprintf(stderr, "sem: failed to open trace output: %s\n", trace_jsonl_out_path);
+  if (trace_out_path && trace_out_path[0]) {
+    if (trace_bin) {
+      trace_bin_out = sem_trace_bin_open(trace_out_path);
+    } else {
+      trace_out = fopen(trace_out_path, "wb");
+    }
+    if (!trace_out && !trace_bin_out) {
+      fprintf(stderr, "sem: failed to open trace output: %s\n", trace_out_path);
       return 2;
     }
   }
@@ -6940,15 +7505,16 @@ int sem_run_sir_jsonl_events_ex(const char* path, const sem_cap_t* caps, uint32_
     cov_out = fopen(coverage_jsonl_out_path, "wb");
     if (!cov_out) {
       if (trace_out) fclose(trace_out);
+      if (trace_bin_out) sem_trace_bin_close(trace_bin_out);
       fprintf(stderr, "sem: failed to open coverage output: %s\n", coverage_jsonl_out_path);
       return 2;
     }
   }
 
-  sem_trace_ctx_t t = {.out = trace_out, .func_filter = trace_func_filter, .op_filter = trace_op_filter};
+  sem_trace_ctx_t t = {.out = trace_out, .bin = trace_bin_out, .func_filter = trace_func_filter, .op_filter = trace_op_filter};
   sem_cov_ctx_t cov = {.out = cov_out};
 
-  sem_events_ctx_t ev = {.trace = trace_out ? &t : NULL, .cov = cov_out ? &cov : NULL, .cov_inited = false};
+  sem_events_ctx_t ev = {.trace = (trace_out || trace_bin_out) ? &t : NULL, .cov = cov_out ? &cov : NULL, .cov_inited = false};
 
   const sir_exec_event_sink_t sink = {
       .user = &ev,
@@ -6958,18 +7524,46 @@ int sem_run_sir_jsonl_events_ex(const char* path, const sem_cap_t* caps, uint32_
   };
 
   int prog_rc = 0;
-  const int tool_rc = sem_run_or_verify_sir_jsonl_impl(path, caps, cap_count, fs_root, diag_format, diag_all, true, &prog_rc,
-                                                       (trace_out || cov_out) ? &sink : NULL, cov_out ? sem_events_post_run : NULL, &ev);
+  const int tool_rc = sem_run_or_verify_sir_jsonl_impl(path, caps, cap_count, fs_root, diag_format, diag_all, true, false, NULL, NULL, &prog_rc,
+                                                       (ev.trace || cov_out) ? &sink : NULL, cov_out ? sem_events_post_run : NULL, &ev, replay);
 
+  int write_rc = 0;
   if (trace_out) fclose(trace_out);
+  if (trace_bin_out && !sem_trace_bin_close(trace_bin_out)) {
+    fprintf(stderr, "sem: failed to write trace output: %s\n", trace_out_path);
+    write_rc = 2;
+  }
   if (cov_out) fclose(cov_out);
   free(cov.offsets);
   free(cov.counts);
 
   if (tool_rc != 0) return tool_rc;
+  if (write_rc != 0) return write_rc;
   return prog_rc;
 }
 
+int sem_run_sir_jsonl_events_ex(const char* path, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root, sem_diag_format_t diag_format,
+                                bool diag_all, const char* trace_jsonl_out_path, const char* coverage_jsonl_out_path, const char* trace_func_filter,
+                                const char* trace_op_filter) {
+  return sem_run_events_impl(path, caps, cap_count, fs_root, diag_format, diag_all, trace_jsonl_out_path, false, coverage_jsonl_out_path,
+                             trace_func_filter, trace_op_filter, NULL);
+}
+
+int sem_run_sir_jsonl_events_bin_ex(const char* path, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root, sem_diag_format_t diag_format,
+                                    bool diag_all, const char* trace_bin_out_path, const char* coverage_jsonl_out_path, const char* trace_func_filter,
+                                    const char* trace_op_filter) {
+  return sem_run_events_impl(path, caps, cap_count, fs_root, diag_format, diag_all, trace_bin_out_path, true, coverage_jsonl_out_path,
+                             trace_func_filter, trace_op_filter, NULL);
+}
+
+int sem_run_sir_jsonl_replay_ex(const char* path, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root, sem_diag_format_t diag_format,
+                                bool diag_all, const sem_replay_cfg_t* replay, const char* trace_out_path, bool trace_bin,
+                                const char* coverage_jsonl_out_path, const char* trace_func_filter, const char* trace_op_filter) {
+  if (!replay) return 2;
+  return sem_run_events_impl(path, caps, cap_count, fs_root, diag_format, diag_all, trace_out_path, trace_bin, coverage_jsonl_out_path,
+                             trace_func_filter, trace_op_filter, replay);
+}
+
 int sem_run_sir_jsonl_trace_ex(const char* path, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root, sem_diag_format_t diag_format,
                                bool diag_all, const char* trace_jsonl_out_path) {
   if (!trace_jsonl_out_path || !trace_jsonl_out_path[0]) {
@@ -6993,5 +7587,15 @@ int sem_verify_sir_jsonl(const char* path, sem_diag_format_t diag_format) {
 }
 
 int sem_verify_sir_jsonl_ex(const char* path, sem_diag_format_t diag_format, bool diag_all) {
-  return sem_run_or_verify_sir_jsonl_impl(path, NULL, 0, NULL, diag_format, diag_all, false, NULL, NULL, NULL, NULL);
+  return sem_run_or_verify_sir_jsonl_impl(path, NULL, 0, NULL, diag_format, diag_all, false, false, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+}
+
+int sem_check_sir_jsonl_ex(const char* path, bool do_run, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root,
+                           sem_diag_format_t diag_format, bool diag_all, sem_run_io_t io, int* out_prog_rc) {
+  int prog_rc = 0;
+  const int tool_rc = sem_run_or_verify_sir_jsonl_impl(path, caps, cap_count, fs_root, diag_format, diag_all, do_run, false, NULL, &io, &prog_rc,
+                                                       NULL, NULL, NULL, NULL);
+  if (tool_rc != 0) return tool_rc;
+  if (out_prog_rc) *out_prog_rc = prog_rc;
+  return 0;
 }
@@ -2,6 +2,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdio.h>
 
 #include "sem_host.h"
 
@@ -24,6 +25,62 @@ int sem_run_sir_jsonl_ex(const char* path, const sem_cap_t* caps, uint32_t cap_c
 int sem_run_sir_jsonl_capture_ex(const char* path, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root, sem_diag_format_t diag_format,
                                  bool diag_all, int* out_prog_rc);
 
+// Like sem_run_sir_jsonl_capture_ex, but lowers fn bodies on demand: signatures are
+// registered up front and each body is lowered + validated the first time it is called.
+// Lowering/validation diagnostics for a called fn match the eager path; fns that are
+// never called are never lowered (use sem_verify_sir_jsonl_ex to check the whole file).
+int sem_run_sir_jsonl_lazy_ex(const char* path, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root, sem_diag_format_t diag_format,
+                              bool diag_all, int* out_prog_rc);
+
+// Like sem_run_sir_jsonl_capture_ex, but reuses a binary module image (.sirm) from
+// `cache_dir` keyed by the input's content hash and the tool version, skipping
+// parse + lowering on a hit. On a miss the module is built as usual and its image is
+// stored for next time. The directory must exist; cache failures fall back silently.
+int sem_run_sir_jsonl_cached_ex(const char* path, const char* cache_dir, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root,
+                                sem_diag_format_t diag_format, bool diag_all, int* out_prog_rc);
+
+// Hash of a file's bytes, with `salt` (may be NULL) mixed in first, formatted as
+// "<32 hex digits>-<byte length>". Keys .sirm cache entries and `sem --serve` modules.
+// Returns false if the file cannot be read.
+#define SEM_CONTENT_HASH_MAX 64
+bool sem_content_hash_file(const char* path, const char* salt, char out[SEM_CONTENT_HASH_MAX]);
+
+// Resident modules (used by `sem --serve`): parse, lower and validate once, then run
+// any number of times, each run on a fresh guest (memory, handles, caps, stdio).
+typedef struct sem_module sem_module_t;
+
+typedef struct sem_load_err {
+  char code[64];
+  char message[256];
+  uint32_t line;
+  uint32_t node_id;
+} sem_load_err_t;
+
+// Returns NULL on failure and fills `err` (when provided) with the first diagnostic.
+sem_module_t* sem_module_load_sir_jsonl(const char* path, sem_load_err_t* err);
+void sem_module_release(sem_module_t* sm);
+
+// Streams behind guest handles 0/1/2 for one run; NULL keeps the process stream.
+typedef struct sem_run_io {
+  FILE* in;
+  FILE* out;
+  FILE* err;
+  bool out_line_buffered; // flush guest stdout at each newline (for streaming) rather than in blocks
+} sem_run_io_t;
+
+// Returns 0 and sets *out_prog_rc when the guest exits, or the negative ZI_E_* that
+// stopped execution. Nothing is printed.
+int32_t sem_module_run(const sem_module_t* sm, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root, sem_run_io_t io,
+                       int* out_prog_rc);
+
+// The lowered module behind `sm` (owned by `sm`), for drivers that run it through
+// sircore directly, e.g. `sem --fuzz`.
+struct sir_module;
+const struct sir_module* sem_module_ir(const sem_module_t* sm);
+
+// Stable name for a negative ZI_E_* returned by sem_module_run (e.g. "ZI_E_BOUNDS").
+const char* sem_exec_rc_name(int32_t rc);
+
 // Run and emit an instruction-level trace as JSONL to the given path.
 // Trace output is written to the file only (never mixed with program stdout/stderr).
 int sem_run_sir_jsonl_trace_ex(const char* path, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root, sem_diag_format_t diag_format,
@@ -40,9 +97,30 @@ int sem_run_sir_jsonl_events_ex(const char* path, const sem_cap_t* caps, uint32_
                                 bool diag_all, const char* trace_jsonl_out_path, const char* coverage_jsonl_out_path, const char* trace_func_filter,
                                 const char* trace_op_filter);
 
+// Same as sem_run_sir_jsonl_events_ex, but the trace is written in the compact binary
+// format (sem_trace_bin.h); convert it to trace JSONL with sem_trace_bin_dump.
+int sem_run_sir_jsonl_events_bin_ex(const char* path, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root, sem_diag_format_t diag_format,
+                                    bool diag_all, const char* trace_bin_out_path, const char* coverage_jsonl_out_path, const char* trace_func_filter,
+                                    const char* trace_op_filter);
+
+// Record or replay a run through a hostcall tape, optionally with checkpoints
+// (see sem_replay.h). Sidecars work as in the _events_ variants (`trace_bin` selects the
+// binary trace); when replaying to a seek point they start there.
+typedef struct sem_replay_cfg sem_replay_cfg_t;
+int sem_run_sir_jsonl_replay_ex(const char* path, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root, sem_diag_format_t diag_format,
+                                bool diag_all, const sem_replay_cfg_t* replay, const char* trace_out_path, bool trace_bin,
+                                const char* coverage_jsonl_out_path, const char* trace_func_filter, const char* trace_op_filter);
+
 // Parse + lower + validate (but do not execute) a small SIR JSONL subset.
 // Returns 0 on success, or 1/2 for tool errors.
 int sem_verify_sir_jsonl(const char* path, sem_diag_format_t diag_format);
 
 // Same as sem_verify_sir_jsonl, but with explicit diagnostics settings.
 int sem_verify_sir_jsonl_ex(const char* path, sem_diag_format_t diag_format, bool diag_all);
+
+// One `sem --check` case (verify, or run when `do_run`) with its output routed through
+// `io`: guest handles 0/1/2 use io.in/out/err and diagnostics go to io.err (NULL keeps
+// the process stream). Safe to call concurrently from several threads.
+// Returns 0 (and the program exit code via `out_prog_rc` when run), or 1/2 for tool errors.
+int sem_check_sir_jsonl_ex(const char* path, bool do_run, const sem_cap_t* caps, uint32_t cap_count, const char* fs_root,
+                           sem_diag_format_t diag_format, bool diag_all, sem_run_io_t io, int* out_prog_rc);
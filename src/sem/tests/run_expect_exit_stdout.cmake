@@ -0,0 +1,34 @@
+# Expects:
+#   -DSEM=<path to sem>
+#   -DINPUT=<sir.jsonl to run with --run>
+#   -DEXPECT_EXIT=<expected exit code>
+#   -DEXPECT_STDOUT=<exact expected stdout; use \n for newlines>
+
+if(NOT DEFINED SEM)
+  message(FATAL_ERROR "run_expect_exit_stdout.cmake: missing -DSEM")
+endif()
+if(NOT DEFINED INPUT)
+  message(FATAL_ERROR "run_expect_exit_stdout.cmake: missing -DINPUT")
+endif()
+if(NOT DEFINED EXPECT_EXIT)
+  message(FATAL_ERROR "run_expect_exit_stdout.cmake: missing -DEXPECT_EXIT")
+endif()
+if(NOT DEFINED EXPECT_STDOUT)
+  message(FATAL_ERROR "run_expect_exit_stdout.cmake: missing -DEXPECT_STDOUT")
+endif()
+
+execute_process(
+  COMMAND "${SEM}" --run "${INPUT}"
+  RESULT_VARIABLE rc
+  OUTPUT_VARIABLE out
+  ERROR_VARIABLE err
+)
+
+if(NOT rc EQUAL EXPECT_EXIT)
+  message(FATAL_ERROR "expected exit code ${EXPECT_EXIT}, got ${rc}\nstdout:\n${out}\nstderr:\n${err}")
+endif()
+
+string(REPLACE "\\n" "\n" exp "${EXPECT_STDOUT}")
+if(NOT out STREQUAL exp)
+  message(FATAL_ERROR "stdout mismatch\nwant:\n${exp}\ngot:\n${out}\nstderr:\n${err}")
+endif()
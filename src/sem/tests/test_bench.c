@@ -0,0 +1,90 @@
+#include "sem_bench.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+static int fail(const char* msg) {
+  fprintf(stderr, "sem_unit: %s\n", msg);
+  return 1;
+}
+
+#define FIB SEM_SOURCE_DIR "/src/sem/tests/bench/call_fib.sir.jsonl"
+#define MEM SEM_SOURCE_DIR "/src/sem/tests/bench/mem_churn.sir.jsonl"
+#define TRAP SEM_SOURCE_DIR "/src/sircc/examples/term_trap.sir.jsonl"
+
+int main(void) {
+  // call_fib computes fib(20) recursively: 21891 calls, 20 deep under main.
+  sem_bench_cfg_t cfg = {0};
+  cfg.iters = 3;
+  sem_bench_report_t a = {0};
+  FILE* out = tmpfile();
+  if (!out) return fail("tmpfile failed");
+  if (sem_bench_sir_jsonl(FIB, NULL, 0, NULL, &cfg, out, NULL, &a) != 0) return fail("bench of call_fib failed");
+  if (a.rc != 6765 % 256) return fail("call_fib exit code mismatch");
+  if (a.funcs != 2 || a.insts == 0) return fail("module size not reported");
+  if (a.insts_retired == 0 || a.max_frames != 21) return fail("unexpected step count or call depth");
+  if (a.host_allocs < 21891) return fail("expected one frame allocation per call");
+  if (a.run_ns_min == 0 || a.run_ns_min > a.run_ns_median || a.run_ns_median > a.run_ns_total) return fail("inconsistent timings");
+  if (a.ns_per_inst <= 0 || !a.limits_ok) return fail("expected ns/inst and no limits tripped");
+
+  // One opt_report record.
+  rewind(out);
+  char line[2048];
+  if (!fgets(line, sizeof(line), out)) return fail("missing report record");
+  if (!strstr(line, "\"k\":\"opt_report\"") || !strstr(line, "\"mode\":\"bench\"") || !strstr(line, "\"insts_retired\":") ||
+      !strstr(line, "\"ok\":true}}\n")) {
+    return fail("report record shape");
+  }
+  if (fgets(line, sizeof(line), out)) return fail("expected exactly one record");
+  fclose(out);
+
+  // Counts are deterministic run to run.
+  sem_bench_report_t b = {0};
+  if (sem_bench_sir_jsonl(FIB, NULL, 0, NULL, &cfg, NULL, NULL, &b) != 0) return fail("second bench failed");
+  if (b.insts_retired != a.insts_retired || b.host_allocs != a.host_allocs || b.input_hash != a.input_hash) {
+    return fail("bench counts should not vary between runs");
+  }
+
+  // Guest heap high-water mark covers module globals (two 4 KiB arrays).
+  sem_bench_report_t m = {0};
+  if (sem_bench_sir_jsonl(MEM, NULL, 0, NULL, &cfg, NULL, NULL, &m) != 0) return fail("bench of mem_churn failed");
+  if (m.guest_heap_hw < 8192) return fail("guest heap high-water mark too low");
+
+  // Thresholds below the measured values fail the bench (exit 1), and say why.
+  {
+    sem_bench_cfg_t q = cfg;
+    q.max_insts = a.insts_retired - 1;
+    q.max_host_allocs = 10;
+    FILE* log = tmpfile();
+    if (!log) return fail("tmpfile failed");
+    sem_bench_report_t r = {0};
+    if (sem_bench_sir_jsonl(FIB, NULL, 0, NULL, &q, NULL, log, &r) != 1) return fail("expected threshold failure");
+    if (r.limits_ok) return fail("limits_ok should be false");
+    rewind(log);
+    if (!fgets(line, sizeof(line), log) || !strstr(line, "insts_retired")) return fail("missing insts_retired diagnostic");
+    if (!fgets(line, sizeof(line), log) || !strstr(line, "host_allocs")) return fail("missing host_allocs diagnostic");
+    fclose(log);
+  }
+
+  // A step budget that stops the guest reports the trap.
+  {
+    sem_bench_cfg_t q = cfg;
+    q.max_steps = 100;
+    sem_bench_report_t r = {0};
+    if (sem_bench_sir_jsonl(FIB, NULL, 0, NULL, &q, NULL, NULL, &r) != 1) return fail("expected bounded run to fail");
+    if (r.rc >= 0 || r.insts_retired != 100) return fail("bounded run should stop at the budget");
+  }
+
+  // A guest trap exits 255; that is a failed bench, not a sample.
+  {
+    sem_bench_cfg_t q = cfg;
+    q.iters = 3;
+    sem_bench_report_t r = {0};
+    if (sem_bench_sir_jsonl(TRAP, NULL, 0, NULL, &q, NULL, NULL, &r) != 1) return fail("expected trapping run to fail the bench");
+    if (r.rc != 255) return fail("trapping run should report exit 255");
+  }
+
+  if (sem_bench_sir_jsonl("/nonexistent/x.sir.jsonl", NULL, 0, NULL, &cfg, NULL, NULL, NULL) != 2) return fail("missing file should be a tool error");
+  return 0;
+}
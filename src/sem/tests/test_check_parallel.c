@@ -0,0 +1,105 @@
+#include "sir_jsonl.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int fail(const char* msg) {
+  fprintf(stderr, "sem_unit: %s\n", msg);
+  return 1;
+}
+
+// Mix of runs that write to the guest stdout, verify failures and runtime traps.
+static const char* k_cases[] = {
+    SEM_SOURCE_DIR "/src/sircc/examples/hello_zabi25_write.sir.jsonl",
+    SEM_SOURCE_DIR "/src/sircc/examples/mem_copy_fill.sir.jsonl",
+    SEM_SOURCE_DIR "/src/sircc/examples/bad_cfg_br_args_mismatch.sir.jsonl",
+    SEM_SOURCE_DIR "/src/sircc/examples/adt_wrong_variant_traps.sir.jsonl",
+    SEM_SOURCE_DIR "/src/sem/tests/fixtures/sem_while_break_once.sir.jsonl",
+    SEM_SOURCE_DIR "/src/sem/tests/fixtures/call_direct_internal.sir.jsonl",
+};
+#define CASE_COUNT (sizeof(k_cases) / sizeof(k_cases[0]))
+#define ROUNDS 8u
+
+typedef struct result {
+  int tool_rc;
+  int prog_rc;
+  char* out;
+  size_t out_len;
+  char* err;
+  size_t err_len;
+} result_t;
+
+static void run_case(const char* path, result_t* r) {
+  memset(r, 0, sizeof(*r));
+  FILE* in = fopen("/dev/null", "rb");
+  FILE* out = open_memstream(&r->out, &r->out_len);
+  FILE* err = open_memstream(&r->err, &r->err_len);
+  if (!in || !out || !err) {
+    r->tool_rc = -1;
+    return;
+  }
+  r->tool_rc = sem_check_sir_jsonl_ex(path, true, NULL, 0, NULL, SEM_DIAG_JSON, false, (sem_run_io_t){.in = in, .out = out, .err = err},
+                                      &r->prog_rc);
+  fclose(in);
+  fclose(out);
+  fclose(err);
+}
+
+static void result_free(result_t* r) {
+  free(r->out);
+  free(r->err);
+}
+
+typedef struct worker {
+  uint32_t start;
+  result_t results[ROUNDS * CASE_COUNT];
+} worker_t;
+
+static void* worker_main(void* user) {
+  worker_t* w = (worker_t*)user;
+  for (uint32_t i = 0; i < ROUNDS * CASE_COUNT; i++) {
+    run_case(k_cases[(w->start + i) % CASE_COUNT], &w->results[i]);
+  }
+  return NULL;
+}
+
+static int same(const result_t* a, const result_t* b) {
+  return a->tool_rc == b->tool_rc && a->prog_rc == b->prog_rc && a->out_len == b->out_len && a->err_len == b->err_len &&
+         memcmp(a->out, b->out, a->out_len) == 0 && memcmp(a->err, b->err, a->err_len) == 0;
+}
+
+int main(void) {
+  result_t base[CASE_COUNT];
+  for (uint32_t i = 0; i < CASE_COUNT; i++) {
+    run_case(k_cases[i], &base[i]);
+    if (base[i].tool_rc < 0) return fail("failed to set up case streams");
+  }
+  // The mix must exercise captured guest output, captured diagnostics and both outcomes.
+  if (base[0].tool_rc != 0 || base[0].out_len == 0) return fail("expected hello case to run and write stdout");
+  if (base[2].tool_rc == 0 || base[2].err_len == 0) return fail("expected bad case to fail with a captured diagnostic");
+  if (!strstr(base[2].err, "\"code\":")) return fail("expected JSON diagnostic for bad case");
+
+  enum { THREADS = 4 };
+  static worker_t workers[THREADS];
+  pthread_t th[THREADS];
+  for (uint32_t t = 0; t < THREADS; t++) {
+    workers[t].start = t;
+    if (pthread_create(&th[t], NULL, worker_main, &workers[t]) != 0) return fail("pthread_create failed");
+  }
+  for (uint32_t t = 0; t < THREADS; t++) pthread_join(th[t], NULL);
+
+  for (uint32_t t = 0; t < THREADS; t++) {
+    for (uint32_t i = 0; i < ROUNDS * CASE_COUNT; i++) {
+      const uint32_t ci = (workers[t].start + i) % CASE_COUNT;
+      if (!same(&workers[t].results[i], &base[ci])) {
+        fprintf(stderr, "sem_unit: case %s differs under concurrency\n", k_cases[ci]);
+        return 1;
+      }
+      result_free(&workers[t].results[i]);
+    }
+  }
+  for (uint32_t i = 0; i < CASE_COUNT; i++) result_free(&base[i]);
+  return 0;
+}
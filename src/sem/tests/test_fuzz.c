@@ -0,0 +1,130 @@
+#include "sem_fuzz.h"
+
+#include <dirent.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static int fail(const char* msg) {
+  fprintf(stderr, "sem_unit: %s\n", msg);
+  return 1;
+}
+
+// fuzz_magic reads 4 bytes into a global and traps in i32.div.s.trap (1 / 0) only when they
+// start with "FZ"; each matching byte sits behind its own branch, so coverage feedback is
+// needed to reach it. The trap exits 255, which the fuzzer must still count as a crash.
+#define MAGIC SEM_SOURCE_DIR "/src/sem/tests/fixtures/fuzz_magic.sir.jsonl"
+
+static uint32_t count_prefix(const char* dir, const char* prefix) {
+  DIR* d = opendir(dir);
+  if (!d) return 0;
+  uint32_t n = 0;
+  const struct dirent* e;
+  while ((e = readdir(d)) != NULL) {
+    if (strncmp(e->d_name, prefix, strlen(prefix)) == 0) n++;
+  }
+  closedir(d);
+  return n;
+}
+
+static void rm_dir(const char* dir) {
+  DIR* d = opendir(dir);
+  if (d) {
+    const struct dirent* e;
+    char p[512];
+    while ((e = readdir(d)) != NULL) {
+      if (e->d_name[0] == '.') continue;
+      snprintf(p, sizeof(p), "%s/%s", dir, e->d_name);
+      (void)unlink(p);
+    }
+    closedir(d);
+  }
+  (void)rmdir(dir);
+}
+
+int main(void) {
+  char crash_dir[] = "/tmp/sem_fuzz_crash_XXXXXX";
+  char corpus_dir[] = "/tmp/sem_fuzz_corpus_XXXXXX";
+  if (!mkdtemp(crash_dir) || !mkdtemp(corpus_dir)) return fail("mkdtemp failed");
+
+  sem_fuzz_cfg_t cfg = {0};
+  cfg.iters = 100000;
+  cfg.max_len = 4;
+  cfg.seed = 7;
+  cfg.crash_dir = crash_dir;
+  cfg.corpus_dir = corpus_dir;
+
+  sem_fuzz_stats_t a = {0};
+  if (sem_fuzz_sir_jsonl(MAGIC, NULL, 0, NULL, &cfg, NULL, &a) != 1) return fail("expected the magic crash to be found");
+  if (a.execs != cfg.iters) return fail("expected every iteration to execute");
+  if (a.crashes != 1 || a.hangs != 0) return fail("expected exactly one crash site and no hangs");
+  if (a.edges == 0 || a.corpus < 2) return fail("expected coverage to grow the corpus");
+  if (count_prefix(crash_dir, "crash-trap-") != 1) return fail("expected one trap crash file");
+  if (count_prefix(corpus_dir, "id-") == 0) return fail("expected corpus inputs to be written");
+
+  // The crash file reproduces on its own.
+  {
+    DIR* d = opendir(crash_dir);
+    if (!d) return fail("opendir failed");
+    const struct dirent* e;
+    char p[512] = {0};
+    while ((e = readdir(d)) != NULL) {
+      if (strncmp(e->d_name, "crash-", 6) == 0) snprintf(p, sizeof(p), "%s/%s", crash_dir, e->d_name);
+    }
+    closedir(d);
+    FILE* f = fopen(p, "rb");
+    if (!f) return fail("crash file missing");
+    unsigned char buf[8];
+    const size_t n = fread(buf, 1, sizeof(buf), f);
+    fclose(f);
+    if (n < 2 || buf[0] != 'F' || buf[1] != 'Z') return fail("crash file does not hold the magic prefix");
+  }
+
+  // Same seed, same directories: no duplicate files (crashes are named by site, inputs by content).
+  // The second run starts from the saved corpus, so the crash is found again.
+  const uint32_t ids = count_prefix(corpus_dir, "id-");
+  sem_fuzz_stats_t b = {0};
+  if (sem_fuzz_sir_jsonl(MAGIC, NULL, 0, NULL, &cfg, NULL, &b) != 1) return fail("rerun should find the crash again");
+  if (b.crashes != 1) return fail("rerun crash count mismatch");
+  if (count_prefix(crash_dir, "crash-") != 1) return fail("rerun duplicated the crash file");
+  if (count_prefix(corpus_dir, "id-") < ids) return fail("rerun lost corpus inputs");
+
+  // Determinism without directories: same seed, same stats.
+  {
+    sem_fuzz_cfg_t q = cfg;
+    q.crash_dir = NULL;
+    q.corpus_dir = NULL;
+    q.iters = 2000;
+    sem_fuzz_stats_t x = {0}, y = {0};
+    const int rx = sem_fuzz_sir_jsonl(MAGIC, NULL, 0, NULL, &q, NULL, &x);
+    const int ry = sem_fuzz_sir_jsonl(MAGIC, NULL, 0, NULL, &q, NULL, &y);
+    if (rx != ry || x.execs != y.execs || x.corpus != y.corpus || x.edges != y.edges || x.crashes != y.crashes) {
+      return fail("same seed should give the same run");
+    }
+  }
+
+  // A step budget smaller than the guest's shortest path turns every run into a hang.
+  {
+    sem_fuzz_cfg_t q = cfg;
+    q.crash_dir = NULL;
+    q.corpus_dir = NULL;
+    q.iters = 50;
+    q.max_steps = 3;
+    sem_fuzz_stats_t h = {0};
+    if (sem_fuzz_sir_jsonl(MAGIC, NULL, 0, NULL, &q, NULL, &h) != 1) return fail("expected hang to be reported");
+    if (h.hangs == 0 || h.crashes != 0) return fail("expected hangs and no crashes");
+  }
+
+  // Tool errors are distinct from findings.
+  {
+    sem_fuzz_cfg_t q = {0};
+    q.iters = 10;
+    if (sem_fuzz_sir_jsonl("/nonexistent/x.sir.jsonl", NULL, 0, NULL, &q, NULL, NULL) != 2) return fail("missing module should be a tool error");
+  }
+
+  rm_dir(crash_dir);
+  rm_dir(corpus_dir);
+  return 0;
+}
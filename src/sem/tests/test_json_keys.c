@@ -0,0 +1,48 @@
+#include "json.h"
+#include "sircc.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+static int fail(const char* msg) {
+  fprintf(stderr, "sem_unit: %s\n", msg);
+  return 1;
+}
+
+int main(void) {
+  // Every well-known key round-trips through the perfect hash.
+  for (int k = JSON_KEY_NONE + 1; k < JSON_KEYS_COUNT; k++) {
+    const char* name = json_key_name((JsonKey)k);
+    if (!name || json_key_lookup(name) != (JsonKey)k) return fail("key lookup does not round-trip");
+  }
+  if (json_key_name(JSON_KEY_NONE) || json_key_lookup("no_such_key") != JSON_KEY_NONE) return fail("unknown key resolved");
+  if (json_key_lookup("typeref") != JSON_KEY_NONE || json_key_lookup("") != JSON_KEY_NONE) return fail("near-miss key resolved");
+
+  Arena a;
+  arena_init(&a);
+  JsonValue* root = NULL;
+  JsonError err;
+  if (!json_parse(&a, "{\"k\":\"node\",\"id\":7,\"custom\":1,\"fields\":{\"args\":[]}}", &root, &err)) return fail("parse failed");
+
+  // Parsed well-known keys are stored as the canonical pointers; others are copies.
+  if (root->v.obj.items[0].key != json_key_name(JSON_KEY_K)) return fail("key `k` not interned");
+  if (root->v.obj.items[1].key != json_key_name(JSON_KEY_ID)) return fail("key `id` not interned");
+  if (strcmp(root->v.obj.items[2].key, "custom") != 0) return fail("unknown key not preserved");
+
+  int64_t id = 0;
+  if (!json_get_i64(json_obj_get_sym(root, JSON_KEY_ID), &id) || id != 7) return fail("get_sym(id)");
+  if (!json_is_array(json_obj_get_sym(json_obj_get_sym(root, JSON_KEY_FIELDS), JSON_KEY_ARGS))) return fail("get_sym(fields.args)");
+  if (json_obj_get_sym(root, JSON_KEY_TAG) || json_obj_get_sym(root, JSON_KEY_NONE)) return fail("get_sym found an absent key");
+  if (json_obj_get(root, "custom") == NULL || json_obj_get(root, "id") != json_obj_get_sym(root, JSON_KEY_ID)) {
+    return fail("get by string disagrees with get_sym");
+  }
+
+  // Objects assembled by hand with a plain literal key still match by content.
+  char tag_key[] = "tag";
+  root->v.obj.items[2].key = tag_key;
+  if (json_obj_get_sym(root, JSON_KEY_TAG) != root->v.obj.items[2].value) return fail("hand-built key not matched");
+
+  arena_free(&a);
+  return 0;
+}
@@ -0,0 +1,144 @@
+#include "json.h"
+#include "sircc.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int fail(const char* msg) {
+  fprintf(stderr, "sem_unit: %s\n", msg);
+  return 1;
+}
+
+static const char* const k_corpus[] = {
+    SEM_SOURCE_DIR "/src/sircc/examples/zasm_ptr_offset_dynamic_print_D.sir.jsonl",
+    SEM_SOURCE_DIR "/src/sircc/examples/simd_shuffle_two_inputs.sir.jsonl",
+    SEM_SOURCE_DIR "/src/sircc/examples/hello_zabi25_write.sir.jsonl",
+    SEM_SOURCE_DIR "/src/sircc/examples/cfg_if.sir.jsonl",
+    SEM_SOURCE_DIR "/src/sem/tests/bench/call_fib.sir.jsonl",
+};
+
+static bool same_tree(const JsonValue* a, const JsonValue* b) {
+  if (!a || !b) return a == b;
+  if (a->type != b->type) return false;
+  switch (a->type) {
+    case JSON_NULL: return true;
+    case JSON_BOOL: return a->v.b == b->v.b;
+    case JSON_NUMBER: return a->v.i == b->v.i;
+    case JSON_STRING: return strcmp(a->v.s, b->v.s) == 0;
+    case JSON_ARRAY:
+      if (a->v.arr.len != b->v.arr.len) return false;
+      for (size_t i = 0; i < a->v.arr.len; i++) {
+        if (!same_tree(a->v.arr.items[i], b->v.arr.items[i])) return false;
+      }
+      return true;
+    case JSON_OBJECT:
+      if (a->v.obj.len != b->v.obj.len) return false;
+      for (size_t i = 0; i < a->v.obj.len; i++) {
+        if (strcmp(a->v.obj.items[i].key, b->v.obj.items[i].key) != 0) return false;
+        if (!same_tree(a->v.obj.items[i].value, b->v.obj.items[i].value)) return false;
+      }
+      return true;
+  }
+  return false;
+}
+
+// Parses `s` in scalar and indexed mode; both must agree on result, tree, and error.
+static bool same_parse(const char* s, bool* out_ok) {
+  Arena a, b;
+  arena_init(&a);
+  arena_init(&b);
+  JsonValue* va = NULL;
+  JsonValue* vb = NULL;
+  JsonError ea, eb;
+  const bool oka = json_parse_mode(&a, s, JSON_PARSE_SCALAR, &va, &ea);
+  const bool okb = json_parse_mode(&b, s, JSON_PARSE_INDEXED, &vb, &eb);
+  bool same = oka == okb;
+  if (same && oka) same = same_tree(va, vb);
+  if (same && !oka) {
+    same = ea.offset == eb.offset && ((!ea.msg && !eb.msg) || (ea.msg && eb.msg && strcmp(ea.msg, eb.msg) == 0));
+  }
+  if (!same) fprintf(stderr, "sem_unit: mismatch on: %s\n", s);
+  arena_free(&a);
+  arena_free(&b);
+  if (out_ok) *out_ok = oka;
+  return same;
+}
+
+static uint32_t rng_next(uint32_t* st) {
+  *st = *st * 1664525u + 1013904223u;
+  return *st >> 8;
+}
+
+int main(void) {
+  static const char* const k_cases[] = {
+      "",
+      "   ",
+      "{}",
+      " [ 1 , -2 ,3 ] ",
+      "{\"a\":\"x\\\"y\\\\z\\n\\u0041\\u00e9\",\"b\":[true,false,null]}",
+      "\"unterminated",
+      "\"trailing backslash\\",
+      "\"bad \\q escape\"",
+      "\"bad \\u12 escape\"",
+      "{\"a\" 1}",
+      "[1 2]",
+      "{\"a\":1,}",
+      "[1,2]   x",
+      "-",
+      "tru",
+  };
+  for (size_t i = 0; i < sizeof(k_cases) / sizeof(k_cases[0]); i++) {
+    if (!same_parse(k_cases[i], NULL)) return fail("hand-written case differs between modes");
+  }
+
+  // Runs and escapes straddling 64-byte blocks, plus an input past the on-stack index.
+  char big[20000];
+  char pad[72];
+  memset(pad, 'p', sizeof(pad));
+  size_t n = 0;
+  big[n++] = '[';
+  for (unsigned k = 0; n < sizeof(big) - 256; k++) {
+    n += (size_t)snprintf(big + n, sizeof(big) - n, "%s\"%.*s\\\"%u\\\\\",\n\t%u", k ? "," : "", (int)(k % 71u), pad, k, k);
+  }
+  big[n++] = ']';
+  big[n] = 0;
+  bool ok = false;
+  if (!same_parse(big, &ok) || !ok) return fail("large document differs between modes");
+
+  uint32_t seed = 0x5eed1234u;
+  static const char k_bytes[] = "\"\\{}[]:, \n\t\r0-aeu";
+  size_t lines = 0;
+  for (size_t f = 0; f < sizeof(k_corpus) / sizeof(k_corpus[0]); f++) {
+    FILE* in = fopen(k_corpus[f], "rb");
+    if (!in) return fail("cannot open corpus file");
+    char line[8192];
+    while (fgets(line, sizeof(line), in)) {
+      line[strcspn(line, "\n")] = 0;
+      if (!line[0]) continue;
+      if (!same_parse(line, &ok) || !ok) return fail("corpus line differs between modes");
+      lines++;
+
+      // Byte flips and truncations must fail (or succeed) identically.
+      const size_t len = strlen(line);
+      for (unsigned m = 0; m < 16 && len; m++) {
+        char mut[8192];
+        memcpy(mut, line, len + 1);
+        const size_t at = rng_next(&seed) % len;
+        if (m % 4u == 3u) {
+          mut[at] = 0;
+        } else {
+          mut[at] = k_bytes[rng_next(&seed) % (sizeof(k_bytes) - 1u)];
+        }
+        if (!same_parse(mut, NULL)) return fail("mutated line differs between modes");
+      }
+    }
+    fclose(in);
+  }
+  if (lines < 50) return fail("corpus unexpectedly small");
+
+  printf("json scan: %s, %zu corpus lines\n", json_scan_isa(), lines);
+  return 0;
+}
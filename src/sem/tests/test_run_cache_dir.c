@@ -0,0 +1,111 @@
+#include "sir_jsonl.h"
+
+#include <dirent.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <unistd.h>
+
+static int fail(const char* msg) {
+  fprintf(stderr, "sem_unit: %s\n", msg);
+  return 1;
+}
+
+#define FIXTURE_A SEM_SOURCE_DIR "/src/sem/tests/fixtures/call_direct_internal.sir.jsonl"
+#define FIXTURE_B SEM_SOURCE_DIR "/src/sem/tests/fixtures/sem_cond_thunk_trap_not_taken.sir.jsonl"
+
+// Returns the number of entries in `dir` (excluding . and ..); writes the last
+// entry seen that does not match `skip` into `out`.
+static int list_images(const char* dir, const char* skip, char* out, size_t cap) {
+  DIR* d = opendir(dir);
+  if (!d) return -1;
+  int n = 0;
+  struct dirent* e;
+  while ((e = readdir(d)) != NULL) {
+    if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0) continue;
+    n++;
+    if (out && (!skip || strcmp(e->d_name, skip) != 0)) snprintf(out, cap, "%s", e->d_name);
+  }
+  closedir(d);
+  return n;
+}
+
+static bool copy_file(const char* from, const char* to) {
+  FILE* in = fopen(from, "rb");
+  if (!in) return false;
+  FILE* out = fopen(to, "wb");
+  if (!out) {
+    fclose(in);
+    return false;
+  }
+  char buf[4096];
+  size_t n = 0;
+  bool ok = true;
+  while ((n = fread(buf, 1, sizeof(buf), in)) > 0) {
+    if (fwrite(buf, 1, n, out) != n) ok = false;
+  }
+  fclose(in);
+  if (fclose(out) != 0) ok = false;
+  return ok;
+}
+
+static int run_cached(const char* path, const char* dir, int* prog_rc) {
+  *prog_rc = -1;
+  return sem_run_sir_jsonl_cached_ex(path, dir, NULL, 0, NULL, SEM_DIAG_TEXT, false, prog_rc);
+}
+
+static int check(const char* dir) {
+  char img_a[256] = {0};
+  char img_b[256] = {0};
+  char p_a[512];
+  char p_b[512];
+  int prog_rc = 0;
+
+  // Miss: builds the module and stores exactly one image.
+  if (run_cached(FIXTURE_A, dir, &prog_rc) != 0 || prog_rc != 12) return fail("cold cached run: expected rc=12");
+  if (list_images(dir, NULL, img_a, sizeof(img_a)) != 1) return fail("expected one cached image");
+  if (strstr(img_a, ".sirm") == NULL) return fail("expected a .sirm image");
+
+  // Hit: same result.
+  if (run_cached(FIXTURE_A, dir, &prog_rc) != 0 || prog_rc != 12) return fail("warm cached run: expected rc=12");
+  if (list_images(dir, NULL, NULL, 0) != 1) return fail("warm run must not add images");
+
+  // Prove the image is what runs: put B's image under A's key.
+  if (run_cached(FIXTURE_B, dir, &prog_rc) != 0 || prog_rc != 7) return fail("cold cached run of B: expected rc=7");
+  if (list_images(dir, img_a, img_b, sizeof(img_b)) != 2) return fail("expected two cached images");
+  snprintf(p_a, sizeof(p_a), "%s/%s", dir, img_a);
+  snprintf(p_b, sizeof(p_b), "%s/%s", dir, img_b);
+  if (!copy_file(p_b, p_a)) return fail("failed to swap images");
+  if (run_cached(FIXTURE_A, dir, &prog_rc) != 0 || prog_rc != 7) return fail("expected A's key to run B's image");
+
+  // A corrupt image is ignored and rebuilt.
+  FILE* f = fopen(p_a, "wb");
+  if (!f || fputs("not an image", f) < 0) return fail("failed to corrupt image");
+  fclose(f);
+  if (run_cached(FIXTURE_A, dir, &prog_rc) != 0 || prog_rc != 12) return fail("corrupt image: expected rebuild and rc=12");
+  if (run_cached(FIXTURE_A, dir, &prog_rc) != 0 || prog_rc != 12) return fail("rebuilt image: expected rc=12");
+  return 0;
+}
+
+int main(void) {
+  char dir[] = "/tmp/sem_cache_dir_XXXXXX";
+  if (!mkdtemp(dir)) return fail("mkdtemp failed");
+
+  const int rc = check(dir);
+
+  DIR* d = opendir(dir);
+  if (d) {
+    struct dirent* e;
+    char p[512];
+    while ((e = readdir(d)) != NULL) {
+      if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0) continue;
+      snprintf(p, sizeof(p), "%s/%s", dir, e->d_name);
+      unlink(p);
+    }
+    closedir(d);
+  }
+  rmdir(dir);
+  return rc;
+}
@@ -0,0 +1,110 @@
+#include "sir_jsonl.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <unistd.h>
+
+static int fail(const char* msg) {
+  fprintf(stderr, "sem_unit: %s\n", msg);
+  return 1;
+}
+
+static bool write_all(FILE* f, const char* s) {
+  return f && s && fputs(s, f) >= 0;
+}
+
+// `main` returns 7 (or the result of `dead` when call_dead is set); `dead`
+// contains an unsupported tag and must only be lowered if it is called.
+static bool write_program(const char* path, bool call_dead) {
+  FILE* out = fopen(path, "wb");
+  if (!out) return false;
+  bool ok = true;
+  ok = ok && write_all(out, "{\"ir\":\"sir-v1.0\",\"k\":\"meta\",\"producer\":\"sem-unit\",\"unit\":\"lazy_uncalled_fn\"}\n");
+  ok = ok && write_all(out, "{\"ir\":\"sir-v1.0\",\"k\":\"type\",\"id\":1,\"kind\":\"prim\",\"prim\":\"i32\"}\n");
+  ok = ok && write_all(out, "{\"ir\":\"sir-v1.0\",\"k\":\"type\",\"id\":11,\"kind\":\"fn\",\"params\":[],\"ret\":1}\n");
+  ok = ok && write_all(out, "{\"ir\":\"sir-v1.0\",\"k\":\"node\",\"id\":10,\"tag\":\"const.i3\",\"type_ref\":1,\"fields\":{\"value\":1}}\n");
+  ok = ok && write_all(out, "{\"ir\":\"sir-v1.0\",\"k\":\"node\",\"id\":11,\"tag\":\"term.ret\",\"fields\":{\"value\":{\"t\":\"ref\",\"id\":10}}}\n");
+  ok = ok && write_all(out, "{\"ir\":\"sir-v1.0\",\"k\":\"node\",\"id\":12,\"tag\":\"block\",\"fields\":{\"stmts\":[{\"t\":\"ref\",\"id\":11}]}}\n");
+  ok = ok && write_all(out,
+                       "{\"ir\":\"sir-v1.0\",\"k\":\"node\",\"id\":20,\"tag\":\"fn\",\"type_ref\":11,\"fields\":{\"name\":\"dead\",\"params\":[],\"body\":{\"t\":\"ref\",\"id\":12}}}\n");
+  if (call_dead) {
+    ok = ok && write_all(out, "{\"ir\":\"sir-v1.0\",\"k\":\"node\",\"id\":30,\"tag\":\"call\",\"type_ref\":1,\"fields\":{\"callee\":{\"t\":\"ref\",\"id\":20},\"args\":[]}}\n");
+  } else {
+    ok = ok && write_all(out, "{\"ir\":\"sir-v1.0\",\"k\":\"node\",\"id\":30,\"tag\":\"const.i32\",\"type_ref\":1,\"fields\":{\"value\":7}}\n");
+  }
+  ok = ok && write_all(out, "{\"ir\":\"sir-v1.0\",\"k\":\"node\",\"id\":31,\"tag\":\"term.ret\",\"fields\":{\"value\":{\"t\":\"ref\",\"id\":30}}}\n");
+  ok = ok && write_all(out, "{\"ir\":\"sir-v1.0\",\"k\":\"node\",\"id\":32,\"tag\":\"block\",\"fields\":{\"stmts\":[{\"t\":\"ref\",\"id\":31}]}}\n");
+  ok = ok && write_all(out,
+                       "{\"ir\":\"sir-v1.0\",\"k\":\"node\",\"id\":40,\"tag\":\"fn\",\"type_ref\":11,\"fields\":{\"name\":\"main\",\"params\":[],\"body\":{\"t\":\"ref\",\"id\":32}}}\n");
+  if (fclose(out) != 0) ok = false;
+  return ok;
+}
+
+static bool make_tmp(char* path) {
+  const int fd = mkstemp(path);
+  if (fd < 0) return false;
+  close(fd);
+  return true;
+}
+
+int main(void) {
+  // A call into an internal fn lowers that fn on demand and matches eager execution.
+  int prog_rc = -1;
+  int rc = sem_run_sir_jsonl_lazy_ex(SEM_SOURCE_DIR "/src/sem/tests/fixtures/call_direct_internal.sir.jsonl", NULL, 0, NULL, SEM_DIAG_TEXT,
+                                     false, &prog_rc);
+  if (rc != 0) return fail("lazy run of call_direct_internal failed");
+  if (prog_rc != 12) {
+    fprintf(stderr, "sem_unit: expected prog_rc=12 got prog_rc=%d\n", prog_rc);
+    return fail("unexpected return code");
+  }
+
+  char sir_path[] = "/tmp/sem_run_lazy_uncalled_XXXXXX";
+  if (!make_tmp(sir_path)) return fail("mkstemp failed");
+
+  // Uncalled fn with an unsupported node: eager verify rejects it, lazy run does not.
+  if (!write_program(sir_path, false)) {
+    unlink(sir_path);
+    return fail("write failed");
+  }
+
+  char diag_path[] = "/tmp/sem_run_lazy_uncalled_out_XXXXXX";
+  if (!make_tmp(diag_path)) {
+    unlink(sir_path);
+    return fail("mkstemp diag failed");
+  }
+  FILE* diag = freopen(diag_path, "wb", stderr);
+  (void)diag;
+
+  const int verify_rc = sem_verify_sir_jsonl_ex(sir_path, SEM_DIAG_JSON, false);
+  prog_rc = -1;
+  const int lazy_rc = sem_run_sir_jsonl_lazy_ex(sir_path, NULL, 0, NULL, SEM_DIAG_JSON, false, &prog_rc);
+  const int lazy_prog_rc = prog_rc;
+
+  // The same fn is lowered (and rejected) once it is actually called.
+  bool wrote_called = write_program(sir_path, true);
+  prog_rc = -1;
+  const int called_rc = wrote_called ? sem_run_sir_jsonl_lazy_ex(sir_path, NULL, 0, NULL, SEM_DIAG_JSON, false, &prog_rc) : 0;
+
+  fflush(stderr);
+  unlink(sir_path);
+
+  FILE* f = fopen(diag_path, "rb");
+  char buf[4096];
+  size_t n = 0;
+  if (f) {
+    n = fread(buf, 1, sizeof(buf) - 1, f);
+    fclose(f);
+  }
+  buf[n] = '\0';
+  unlink(diag_path);
+
+  if (verify_rc == 0) return fail("expected eager verify to fail");
+  if (lazy_rc != 0) return fail("expected lazy run to succeed");
+  if (lazy_prog_rc != 7) return fail("expected lazy run to return 7");
+  if (!wrote_called) return fail("write failed");
+  if (called_rc == 0) return fail("expected lazy run to fail once the bad fn is called");
+  if (strstr(buf, "\"code\":\"sem.unsupported.node\"") == NULL) return fail("expected sem.unsupported.node diagnostic");
+  return 0;
+}
@@ -0,0 +1,117 @@
+#include "sem_replay.h"
+#include "sir_jsonl.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <unistd.h>
+
+static int fail(const char* msg) {
+  fprintf(stderr, "sem_unit: %s\n", msg);
+  return 1;
+}
+
+// 64 iterations of: read 4 bytes from stdin, echo them, bump a global; exits with 64.
+#define FIXTURE SEM_SOURCE_DIR "/src/sem/tests/fixtures/replay_echo_loop.sir.jsonl"
+
+static bool make_temp(char* path) {
+  const int fd = mkstemp(path);
+  if (fd < 0) return false;
+  close(fd);
+  return true;
+}
+
+static long read_all(const char* path, char* buf, size_t cap) {
+  FILE* f = fopen(path, "rb");
+  if (!f) return -1;
+  const size_t n = fread(buf, 1, cap, f);
+  fclose(f);
+  return (long)n;
+}
+
+// Runs FIXTURE with stdin from `in` and stdout captured into `out`.
+static int run(const sem_replay_cfg_t* cfg, const char* in, const char* out) {
+  fflush(stdout);
+  if (!freopen(in, "rb", stdin)) return -1;
+  if (!freopen(out, "wb", stdout)) return -1;
+  const int rc = sem_run_sir_jsonl_replay_ex(FIXTURE, NULL, 0, NULL, SEM_DIAG_TEXT, false, cfg, NULL, false, NULL, NULL, NULL);
+  fflush(stdout);
+  return rc;
+}
+
+static int check(const char* in, const char* out, const char* tape, const char* ckpt) {
+  char want[512];
+  char got[512];
+
+  FILE* f = fopen(in, "wb");
+  if (!f) return fail("failed to write stdin");
+  for (int i = 0; i < 256; i++) fputc('A' + (i % 26), f);
+  fclose(f);
+
+  // Record: echo all 256 bytes, one checkpoint every 50 steps.
+  sem_replay_cfg_t rec = {0};
+  rec.tape_out = tape;
+  rec.checkpoint_out = ckpt;
+  rec.checkpoint_every = 50;
+  if (run(&rec, in, out) != 64) return fail("record: expected rc=64");
+  const long want_n = read_all(out, want, sizeof(want));
+  if (want_n != 256) return fail("record: expected 256 bytes of output");
+
+  // Full replay: stdin is empty, the tape supplies the reads.
+  sem_replay_cfg_t play = {0};
+  play.tape_in = tape;
+  play.tape_strict = true;
+  if (run(&play, "/dev/null", out) != 64) return fail("replay: expected rc=64");
+  if (read_all(out, got, sizeof(got)) != want_n || memcmp(got, want, (size_t)want_n) != 0) return fail("replay: output differs");
+
+  // Seek by hostcall: after 10 tape records (5 read/write pairs) 20 bytes are behind us.
+  play.checkpoint_in = ckpt;
+  play.seek = SEM_SEEK_HOSTCALL;
+  play.seek_at = 10;
+  if (run(&play, "/dev/null", out) != 64) return fail("seek hostcall: expected rc=64");
+  if (read_all(out, got, sizeof(got)) != want_n - 20 || memcmp(got, want + 20, (size_t)(want_n - 20)) != 0)
+    return fail("seek hostcall: expected the output suffix");
+
+  // Seek by step, landing exactly on and between checkpoints: always a suffix.
+  const uint64_t steps[] = {0, 50, 777, 1500};
+  long prev = want_n + 1;
+  for (size_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++) {
+    play.seek = SEM_SEEK_STEP;
+    play.seek_at = steps[i];
+    if (run(&play, "/dev/null", out) != 64) return fail("seek step: expected rc=64");
+    const long n = read_all(out, got, sizeof(got));
+    if (n < 0 || n >= prev || memcmp(got, want + (want_n - n), (size_t)n) != 0) return fail("seek step: expected a shrinking output suffix");
+    prev = n;
+  }
+
+  // A target past the end of the run is an error, not a silent full replay.
+  play.seek = SEM_SEEK_HOSTCALL;
+  play.seek_at = 1000;
+  if (run(&play, "/dev/null", out) != 1) return fail("seek past end: expected tool error");
+
+  // A checkpoint file is bound to its module.
+  FILE* ck = fopen(ckpt, "r+b");
+  if (!ck || fseek(ck, 8, SEEK_SET) != 0 || fputc(0x5a, ck) == EOF) return fail("failed to patch checkpoint");
+  fclose(ck);
+  play.seek_at = 10;
+  if (run(&play, "/dev/null", out) == 64) return fail("foreign checkpoint: expected failure");
+  return 0;
+}
+
+int main(void) {
+  char in[] = "/tmp/sem_replay_in_XXXXXX";
+  char out[] = "/tmp/sem_replay_out_XXXXXX";
+  char tape[] = "/tmp/sem_replay_tape_XXXXXX";
+  char ckpt[] = "/tmp/sem_replay_ckpt_XXXXXX";
+  if (!make_temp(in) || !make_temp(out) || !make_temp(tape) || !make_temp(ckpt)) return fail("mkstemp failed");
+
+  const int rc = check(in, out, tape, ckpt);
+
+  unlink(in);
+  unlink(out);
+  unlink(tape);
+  unlink(ckpt);
+  return rc;
+}
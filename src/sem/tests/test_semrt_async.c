@@ -0,0 +1,289 @@
+#include "hosted_file_fs.h"
+#include "hosted_zabi.h"
+#include "zcl1.h"
+#include "zi_tape.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static int fail(const char* msg) {
+  fprintf(stderr, "sem_unit_tests: %s\n", msg);
+  return 1;
+}
+
+static void u64le(uint8_t* p, uint64_t v) {
+  zcl1_write_u32le(p + 0, (uint32_t)(v & 0xFFFFFFFFu));
+  zcl1_write_u32le(p + 4, (uint32_t)(v >> 32));
+}
+
+static uint64_t rd64(const uint8_t* p) {
+  return (uint64_t)zcl1_read_u32le(p) | ((uint64_t)zcl1_read_u32le(p + 4) << 32);
+}
+
+static zi_ptr_t put(sir_hosted_zabi_t* rt, const void* bytes, uint32_t n) {
+  const zi_ptr_t p = sir_zi_alloc(rt, n);
+  uint8_t* w = NULL;
+  if (!p || !sem_guest_mem_map_rw(rt->mem, p, n, &w) || !w) return 0;
+  memcpy(w, bytes, n);
+  return p;
+}
+
+static zi_handle_t open_file(sir_hosted_zabi_t* rt, const char* guest_path, uint32_t oflags) {
+  const zi_ptr_t path_ptr = put(rt, guest_path, (uint32_t)strlen(guest_path));
+  uint8_t params[20];
+  u64le(params + 0, (uint64_t)path_ptr);
+  zcl1_write_u32le(params + 8, (uint32_t)strlen(guest_path));
+  zcl1_write_u32le(params + 12, oflags);
+  zcl1_write_u32le(params + 16, 0644);
+  const zi_ptr_t params_ptr = put(rt, params, sizeof(params));
+  const zi_ptr_t kind_ptr = put(rt, "file", 4);
+  const zi_ptr_t name_ptr = put(rt, "fs", 2);
+
+  uint8_t req[40];
+  memset(req, 0, sizeof(req));
+  u64le(req + 0, (uint64_t)kind_ptr);
+  zcl1_write_u32le(req + 8, 4);
+  u64le(req + 12, (uint64_t)name_ptr);
+  zcl1_write_u32le(req + 20, 2);
+  u64le(req + 28, (uint64_t)params_ptr);
+  zcl1_write_u32le(req + 36, sizeof(params));
+  return sir_zi_cap_open(rt, put(rt, req, sizeof(req)));
+}
+
+static uint32_t submit_req(uint8_t* out, uint32_t cap, uint32_t rid, uint8_t kind, zi_handle_t h, uint64_t off, uint64_t user_data,
+                           const char* data, uint32_t len) {
+  uint8_t payload[64];
+  memset(payload, 0, sizeof(payload));
+  payload[0] = kind;
+  zcl1_write_u32le(payload + 4, (uint32_t)h);
+  u64le(payload + 8, off);
+  u64le(payload + 16, user_data);
+  zcl1_write_u32le(payload + 24, len);
+  const uint32_t plen = 28u + (kind == SIR_ASYNC_WRITE ? len : 0u);
+  if (kind == SIR_ASYNC_WRITE) memcpy(payload + 28, data, len);
+  uint32_t n = 0;
+  if (!zcl1_write(out, cap, SIR_ASYNC_OP_SUBMIT, rid, 0, payload, plen, &n)) return 0;
+  return n;
+}
+
+static uint32_t poll_req(uint8_t* out, uint32_t cap, uint32_t rid, uint32_t min_complete, uint32_t max_complete) {
+  uint8_t payload[8];
+  zcl1_write_u32le(payload, min_complete);
+  zcl1_write_u32le(payload + 4, max_complete);
+  uint32_t n = 0;
+  if (!zcl1_write(out, cap, SIR_ASYNC_OP_POLL, rid, 0, payload, sizeof(payload), &n)) return 0;
+  return n;
+}
+
+// Frame status of a single response (-1: transport error or not a frame).
+static int status_of(const uint8_t* resp, int32_t rc) {
+  zcl1_hdr_t h = {0};
+  const uint8_t* p = NULL;
+  if (rc < 0 || !zcl1_parse(resp, (uint32_t)rc, &h, &p)) return -1;
+  return (int)h.status;
+}
+
+typedef struct completion {
+  uint64_t user_data;
+  int32_t result;
+  uint32_t data_len;
+  const uint8_t* data;
+} completion_t;
+
+// Parses a POLL response; returns the completion count or -1.
+static int parse_poll(const uint8_t* resp, int32_t rc, completion_t* out, int max, uint32_t* outstanding) {
+  zcl1_hdr_t h = {0};
+  const uint8_t* p = NULL;
+  if (rc < 0 || !zcl1_parse(resp, (uint32_t)rc, &h, &p) || h.status != 1 || h.payload_len < 8) return -1;
+  const uint32_t n = zcl1_read_u32le(p);
+  if ((int)n > max) return -1;
+  *outstanding = zcl1_read_u32le(p + 4);
+  uint32_t off = 8;
+  for (uint32_t i = 0; i < n; i++) {
+    if (h.payload_len - off < 16) return -1;
+    out[i].user_data = rd64(p + off);
+    out[i].result = (int32_t)zcl1_read_u32le(p + off + 8);
+    out[i].data_len = zcl1_read_u32le(p + off + 12);
+    out[i].data = p + off + 16;
+    off += 16;
+    if (h.payload_len - off < out[i].data_len) return -1;
+    off += out[i].data_len;
+  }
+  return off == h.payload_len ? (int)n : -1;
+}
+
+static int check(sir_hosted_zabi_t* rt) {
+  sem_host_t* host = &rt->ctl_host;
+  const zi_handle_t h = open_file(rt, "/data.bin", ZI_FILE_O_READ | ZI_FILE_O_WRITE);
+  if (h < 3) return fail("open failed");
+
+  // Four reads in one BATCH; the last one runs past EOF.
+  static const uint64_t offs[4] = {0, 1000, 2000, 4000};
+  uint8_t subs_buf[4][64];
+  const uint8_t* subs[4];
+  uint32_t sub_lens[4];
+  for (int i = 0; i < 4; i++) {
+    sub_lens[i] = submit_req(subs_buf[i], sizeof(subs_buf[i]), (uint32_t)i, SIR_ASYNC_READ, h, offs[i], 100u + (uint64_t)i, NULL, 200);
+    subs[i] = subs_buf[i];
+  }
+  uint8_t req[512];
+  uint32_t req_len = 0;
+  if (!sem_build_batch_req(1, subs, sub_lens, 4, req, sizeof(req), &req_len)) return fail("build batch failed");
+  static uint8_t resp[8192];
+  if (status_of(resp, sem_zi_ctl(host, req, req_len, resp, sizeof(resp))) != 1) return fail("batched submit failed");
+
+  completion_t c[8];
+  uint32_t outstanding = 0;
+  req_len = poll_req(req, sizeof(req), 2, 4, 0);
+  int n = parse_poll(resp, sem_zi_ctl(host, req, req_len, resp, sizeof(resp)), c, 8, &outstanding);
+  if (n != 4 || outstanding != 0) return fail("expected four completions");
+  for (int i = 0; i < n; i++) {
+    const uint64_t k = c[i].user_data - 100u;
+    if (k > 3) return fail("unexpected user_data");
+    const uint32_t want = offs[k] == 4000 ? 96u : 200u;
+    if (c[i].result != (int32_t)want || c[i].data_len != want) return fail("bad read size");
+    for (uint32_t j = 0; j < want; j++) {
+      if (c[i].data[j] != (uint8_t)((offs[k] + j) * 13u)) return fail("read data mismatch");
+    }
+  }
+
+  // Write, then read it back; nothing left to poll afterwards.
+  req_len = submit_req(req, sizeof(req), 3, SIR_ASYNC_WRITE, h, 10, 7, "HELLO", 5);
+  if (status_of(resp, sem_zi_ctl(host, req, req_len, resp, sizeof(resp))) != 1) return fail("write submit failed");
+  req_len = poll_req(req, sizeof(req), 4, 1, 0);
+  n = parse_poll(resp, sem_zi_ctl(host, req, req_len, resp, sizeof(resp)), c, 8, &outstanding);
+  if (n != 1 || c[0].user_data != 7 || c[0].result != 5 || c[0].data_len != 0) return fail("bad write completion");
+  req_len = submit_req(req, sizeof(req), 5, SIR_ASYNC_READ, h, 10, 8, NULL, 5);
+  (void)sem_zi_ctl(host, req, req_len, resp, sizeof(resp));
+  req_len = poll_req(req, sizeof(req), 6, 1, 0);
+  n = parse_poll(resp, sem_zi_ctl(host, req, req_len, resp, sizeof(resp)), c, 8, &outstanding);
+  if (n != 1 || c[0].data_len != 5 || memcmp(c[0].data, "HELLO", 5) != 0) return fail("write not visible to a later read");
+  req_len = poll_req(req, sizeof(req), 7, 0, 0);
+  n = parse_poll(resp, sem_zi_ctl(host, req, req_len, resp, sizeof(resp)), c, 8, &outstanding);
+  if (n != 0 || outstanding != 0) return fail("non-blocking poll on an empty queue must return nothing");
+
+  // Completions that do not fit stay queued for the next POLL.
+  for (uint32_t i = 0; i < 2; i++) {
+    req_len = submit_req(req, sizeof(req), 8, SIR_ASYNC_READ, h, 100u * i, 20u + i, NULL, 100);
+    (void)sem_zi_ctl(host, req, req_len, resp, sizeof(resp));
+  }
+  req_len = poll_req(req, sizeof(req), 9, 2, 0);
+  n = parse_poll(resp, sem_zi_ctl(host, req, req_len, resp, ZCL1_HDR_SIZE + 8u + 16u + 100u + 10u), c, 8, &outstanding);
+  if (n != 1 || outstanding != 1) return fail("expected one completion to fit");
+  n = parse_poll(resp, sem_zi_ctl(host, req, req_len, resp, sizeof(resp)), c, 8, &outstanding);
+  if (n != 1 || outstanding != 0) return fail("expected the held-back completion");
+
+  // Handles without a host descriptor, and stale handles, get error frames.
+  req_len = submit_req(req, sizeof(req), 10, SIR_ASYNC_READ, 0, 0, 0, NULL, 4);
+  if (status_of(resp, sem_zi_ctl(host, req, req_len, resp, sizeof(resp))) != 0) return fail("stdin must be rejected");
+  req_len = submit_req(req, sizeof(req), 11, SIR_ASYNC_READ, 999, 0, 0, NULL, 4);
+  if (status_of(resp, sem_zi_ctl(host, req, req_len, resp, sizeof(resp))) != 0) return fail("unknown handle must be rejected");
+
+  // The submission and its poll replay from a tape without the file.
+  char tape[] = "/tmp/sem_async_tape_XXXXXX";
+  const int fd = mkstemp(tape);
+  if (fd < 0) return fail("mkstemp failed");
+  close(fd);
+  zi_tape_writer_t* tw = zi_tape_writer_open(tape);
+  if (!tw) return fail("tape open failed");
+  zi_ctl_record_ctx_t rec = {.inner = sem_zi_ctl, .inner_user = host, .tape = tw};
+  uint8_t sreq[64];
+  uint8_t preq[64];
+  const uint32_t sreq_len = submit_req(sreq, sizeof(sreq), 12, SIR_ASYNC_READ, h, 50, 99, NULL, 32);
+  const uint32_t preq_len = poll_req(preq, sizeof(preq), 13, 1, 0);
+  uint8_t srec[256];
+  static uint8_t prec[1024];
+  const int32_t srec_rc = zi_ctl_record(&rec, sreq, sreq_len, srec, sizeof(srec));
+  const int32_t prec_rc = zi_ctl_record(&rec, preq, preq_len, prec, sizeof(prec));
+  if (!zi_tape_writer_close(tw) || srec_rc <= 0 || prec_rc <= 0) return fail("record failed");
+  n = parse_poll(prec, prec_rc, c, 8, &outstanding);
+  if (n != 1 || c[0].user_data != 99 || c[0].data_len != 32) return fail("recorded poll mismatch");
+
+  zi_tape_reader_t* tr = zi_tape_reader_open(tape);
+  if (!tr || zi_tape_reader_count(tr) != 2) return fail("expected two tape records");
+  zi_ctl_replay_ctx_t play = {.tape = tr, .strict_match = true};
+  uint8_t sgot[256];
+  static uint8_t pgot[1024];
+  const int32_t sgot_rc = zi_ctl_replay(&play, sreq, sreq_len, sgot, sizeof(sgot));
+  const int32_t pgot_rc = zi_ctl_replay(&play, preq, preq_len, pgot, sizeof(pgot));
+  zi_tape_reader_close(tr);
+  unlink(tape);
+  if (sgot_rc != srec_rc || pgot_rc != prec_rc || memcmp(pgot, prec, (size_t)prec_rc) != 0) return fail("replay differs");
+
+  (void)sir_zi_end(rt, h);
+  return 0;
+}
+
+static int run(const char* root, bool with_async, bool async_inline) {
+  sem_cap_t caps[2];
+  memset(caps, 0, sizeof(caps));
+  caps[0].kind = "file";
+  caps[0].name = "fs";
+  caps[0].flags = SEM_ZI_CAP_CAN_OPEN | SEM_ZI_CAP_MAY_BLOCK;
+  caps[1].kind = "async";
+  caps[1].name = "default";
+  caps[1].flags = SEM_ZI_CAP_CAN_OPEN | SEM_ZI_CAP_MAY_BLOCK;
+
+  sir_hosted_zabi_t rt;
+  if (!sir_hosted_zabi_init(&rt, (sir_hosted_zabi_cfg_t){.guest_mem_cap = 1024 * 1024,
+                                                         .guest_mem_base = 0x10000ull,
+                                                         .caps = caps,
+                                                         .cap_count = with_async ? 2u : 1u,
+                                                         .fs_root = root,
+                                                         .async_inline = async_inline})) {
+    return fail("sir_hosted_zabi_init failed");
+  }
+
+  int rc = 0;
+  if (with_async) {
+    rc = check(&rt);
+  } else {
+    // Without async:default the ops are unknown to the host.
+    const zi_handle_t h = open_file(&rt, "/data.bin", ZI_FILE_O_READ);
+    uint8_t req[64];
+    uint8_t resp[512];
+    const uint32_t req_len = submit_req(req, sizeof(req), 1, SIR_ASYNC_READ, h, 0, 0, NULL, 4);
+    if (h < 3 || rt.async || status_of(resp, sem_zi_ctl(&rt.ctl_host, req, req_len, resp, sizeof(resp))) != 0)
+      rc = fail("async ops must be unavailable without the cap");
+    (void)sir_zi_end(&rt, h);
+  }
+
+  // Dispose with ops still in flight must wait for them.
+  if (rc == 0 && with_async) {
+    const zi_handle_t h = open_file(&rt, "/data.bin", ZI_FILE_O_READ);
+    uint8_t req[64];
+    uint8_t resp[512];
+    for (uint32_t i = 0; i < 16; i++) {
+      const uint32_t req_len = submit_req(req, sizeof(req), i, SIR_ASYNC_READ, h, i * 64u, i, NULL, 64);
+      (void)sem_zi_ctl(&rt.ctl_host, req, req_len, resp, sizeof(resp));
+    }
+    (void)sir_zi_end(&rt, h); // ops hold their own descriptors
+  }
+  sir_hosted_zabi_dispose(&rt);
+  return rc;
+}
+
+int main(void) {
+  char root_tmpl[] = "/tmp/sem_async.XXXXXX";
+  char* root = mkdtemp(root_tmpl);
+  if (!root) return fail("mkdtemp failed");
+
+  char data[1024];
+  snprintf(data, sizeof(data), "%s/data.bin", root);
+  int rc = 0;
+  for (int pass = 0; pass < 3 && rc == 0; pass++) {
+    FILE* f = fopen(data, "wb");
+    if (!f) return fail("create data.bin failed");
+    for (uint32_t i = 0; i < 4096u; i++) fputc((int)(uint8_t)(i * 13u), f);
+    fclose(f);
+    // Thread pool, inline fallback, and no cap at all.
+    rc = run(root, pass != 2, pass == 1);
+  }
+
+  (void)unlink(data);
+  (void)rmdir(root);
+  return rc;
+}
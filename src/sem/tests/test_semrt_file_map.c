@@ -0,0 +1,181 @@
+#include "hosted_file_fs.h"
+#include "hosted_zabi.h"
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static int fail(const char* msg) {
+  fprintf(stderr, "sem_unit_tests: %s\n", msg);
+  return 1;
+}
+
+static void u32le(uint8_t* p, uint32_t v) {
+  p[0] = (uint8_t)(v & 0xffu);
+  p[1] = (uint8_t)((v >> 8) & 0xffu);
+  p[2] = (uint8_t)((v >> 16) & 0xffu);
+  p[3] = (uint8_t)((v >> 24) & 0xffu);
+}
+
+static void u64le(uint8_t* p, uint64_t v) {
+  u32le(p + 0, (uint32_t)(v & 0xFFFFFFFFu));
+  u32le(p + 4, (uint32_t)((v >> 32) & 0xFFFFFFFFu));
+}
+
+static zi_ptr_t put(sir_hosted_zabi_t* rt, const void* bytes, uint32_t n) {
+  const zi_ptr_t p = sir_zi_alloc(rt, n);
+  uint8_t* w = NULL;
+  if (!p || !sem_guest_mem_map_rw(rt->mem, p, n, &w) || !w) return 0;
+  memcpy(w, bytes, n);
+  return p;
+}
+
+// file/fs open through zi_cap_open; `out_ptr` is the ZI_FILE_O_MAP result slot (0: none).
+static zi_handle_t open_file(sir_hosted_zabi_t* rt, const char* guest_path, uint32_t oflags, zi_ptr_t out_ptr) {
+  const zi_ptr_t path_ptr = put(rt, guest_path, (uint32_t)strlen(guest_path));
+  uint8_t params[28];
+  u64le(params + 0, (uint64_t)path_ptr);
+  u32le(params + 8, (uint32_t)strlen(guest_path));
+  u32le(params + 12, oflags);
+  u32le(params + 16, 0644);
+  u64le(params + 20, (uint64_t)out_ptr);
+  const zi_ptr_t params_ptr = put(rt, params, sizeof(params));
+  const zi_ptr_t kind_ptr = put(rt, "file", 4);
+  const zi_ptr_t name_ptr = put(rt, "fs", 2);
+
+  uint8_t req[40];
+  memset(req, 0, sizeof(req));
+  u64le(req + 0, (uint64_t)kind_ptr);
+  u32le(req + 8, 4);
+  u64le(req + 12, (uint64_t)name_ptr);
+  u32le(req + 20, 2);
+  u64le(req + 28, (uint64_t)params_ptr);
+  u32le(req + 36, out_ptr ? 28u : 20u);
+  return sir_zi_cap_open(rt, put(rt, req, sizeof(req)));
+}
+
+static uint64_t rd64(const uint8_t* p) {
+  uint64_t v = 0;
+  for (int i = 7; i >= 0; i--) v = (v << 8) | p[i];
+  return v;
+}
+
+static int check(sir_hosted_zabi_t* rt, const char* root, FILE* out) {
+  const zi_ptr_t slot = sir_zi_alloc(rt, 12);
+  uint8_t* sp = NULL;
+  if (!slot || !sem_guest_mem_map_rw(rt->mem, slot, 12, &sp)) return fail("alloc slot failed");
+
+  // Writable + map is rejected.
+  if (open_file(rt, "/big.bin", ZI_FILE_O_READ | ZI_FILE_O_WRITE | ZI_FILE_O_MAP, slot) != SEM_ZI_E_INVALID)
+    return fail("map of a writable open must fail");
+
+  // Read-only map: the region holds the file, guest stores stay private.
+  const zi_handle_t h = open_file(rt, "/big.bin", ZI_FILE_O_READ | ZI_FILE_O_MAP, slot);
+  if (h < 3) return fail("map open failed");
+  const zi_ptr_t region = (zi_ptr_t)rd64(sp);
+  const uint32_t region_len = (uint32_t)rd64(sp + 8) & 0xFFFFFFFFu;
+  if (!region || region_len != 10000u) return fail("bad map region");
+  uint8_t* m = NULL;
+  if (!sem_guest_mem_map_rw(rt->mem, region, region_len, &m) || !m) return fail("region not guest-addressable");
+  for (uint32_t i = 0; i < region_len; i++) {
+    if (m[i] != (uint8_t)(i * 7u)) return fail("region contents mismatch");
+  }
+  m[0] = 0xEE;
+
+  // The handle still streams the file (from the descriptor, not the private copy).
+  if (sir_zi_transfer(rt, 1, h, 1) != 1) return fail("transfer of one byte failed");
+  int32_t total = 1;
+  for (;;) {
+    const int32_t n = sir_zi_transfer(rt, 1, h, 4096);
+    if (n < 0) return fail("transfer failed");
+    if (n == 0) break;
+    total += n;
+  }
+  if (total != 10000) return fail("transfer size mismatch");
+  (void)sir_zi_end(rt, h);
+  if (m[0] != 0 || m[region_len - 1] != 0) return fail("region must read as zero after zi_end");
+
+  // Empty file: no region.
+  const zi_handle_t he = open_file(rt, "/empty.bin", ZI_FILE_O_READ | ZI_FILE_O_MAP, slot);
+  if (he < 3 || rd64(sp) != 0 || rd64(sp + 8) != 0) return fail("empty map must yield {0, 0}");
+  (void)sir_zi_end(rt, he);
+
+  // File to file inside the sandbox (kernel copy where available).
+  const zi_handle_t src = open_file(rt, "/big.bin", ZI_FILE_O_READ, 0);
+  const zi_handle_t dst = open_file(rt, "/copy.bin", ZI_FILE_O_WRITE | ZI_FILE_O_CREATE | ZI_FILE_O_TRUNC, 0);
+  if (src < 3 || dst < 3) return fail("open for copy failed");
+  int32_t n = 0;
+  while ((n = sir_zi_transfer(rt, dst, src, 1u << 20)) > 0) {
+  }
+  if (n < 0) return fail("file-to-file transfer failed");
+  if (sir_zi_transfer(rt, src, dst, 1) != SEM_ZI_E_NOSYS) return fail("transfer must respect handle directions");
+  (void)sir_zi_end(rt, src);
+  (void)sir_zi_end(rt, dst);
+
+  char path[1024];
+  snprintf(path, sizeof(path), "%s/copy.bin", root);
+  struct stat st;
+  if (stat(path, &st) != 0 || st.st_size != 10000) return fail("copy size mismatch");
+
+  // Guest stdout got the file exactly once, after flushing.
+  if (!sir_hosted_zabi_flush(rt)) return fail("flush failed");
+  uint8_t got[10000];
+  rewind(out);
+  if (fread(got, 1, sizeof(got), out) != sizeof(got)) return fail("stdout size mismatch");
+  for (uint32_t i = 0; i < sizeof(got); i++) {
+    if (got[i] != (uint8_t)(i * 7u)) return fail("stdout contents mismatch");
+  }
+  return 0;
+}
+
+int main(void) {
+  char root_tmpl[] = "/tmp/sem_fsmap.XXXXXX";
+  char* root = mkdtemp(root_tmpl);
+  if (!root) return fail("mkdtemp failed");
+
+  char big[1024];
+  char empty[1024];
+  char copy[1024];
+  snprintf(big, sizeof(big), "%s/big.bin", root);
+  snprintf(empty, sizeof(empty), "%s/empty.bin", root);
+  snprintf(copy, sizeof(copy), "%s/copy.bin", root);
+  FILE* f = fopen(big, "wb");
+  if (!f) return fail("create big.bin failed");
+  for (uint32_t i = 0; i < 10000u; i++) fputc((int)(uint8_t)(i * 7u), f);
+  fclose(f);
+  f = fopen(empty, "wb");
+  if (!f) return fail("create empty.bin failed");
+  fclose(f);
+
+  sem_cap_t caps[1];
+  memset(caps, 0, sizeof(caps));
+  caps[0].kind = "file";
+  caps[0].name = "fs";
+  caps[0].flags = SEM_ZI_CAP_CAN_OPEN | SEM_ZI_CAP_MAY_BLOCK;
+
+  FILE* out = tmpfile();
+  if (!out) return fail("tmpfile failed");
+  sir_hosted_zabi_t rt;
+  if (!sir_hosted_zabi_init(&rt, (sir_hosted_zabi_cfg_t){.guest_mem_cap = 1024 * 1024,
+                                                         .guest_mem_base = 0x10000ull,
+                                                         .caps = caps,
+                                                         .cap_count = 1,
+                                                         .fs_root = root,
+                                                         .stdout_f = out})) {
+    return fail("sir_hosted_zabi_init failed");
+  }
+
+  const int rc = check(&rt, root, out);
+  sir_hosted_zabi_dispose(&rt);
+  fclose(out);
+
+  (void)unlink(big);
+  (void)unlink(empty);
+  (void)unlink(copy);
+  (void)rmdir(root);
+  return rc;
+}
@@ -0,0 +1,67 @@
+#include "handles.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+static int fail(const char* msg) {
+  fprintf(stderr, "sem_unit_tests: %s\n", msg);
+  return 1;
+}
+
+static const sem_handle_ops_t nop_ops = {
+    .read = NULL,
+    .write = NULL,
+    .end = NULL,
+};
+
+static sem_handle_entry_t entry(uint32_t tag) {
+  return (sem_handle_entry_t){.ops = &nop_ops, .ctx = NULL, .hflags = tag};
+}
+
+int main(void) {
+  sem_handles_t hs;
+  if (!sem_handles_init(&hs, SEM_HANDLES_MAX)) return fail("init failed");
+  if (!sem_handle_install(&hs, 1, entry(ZI_H_WRITABLE))) return fail("install of a reserved handle failed");
+  if (sem_handle_install(&hs, 3, entry(0))) return fail("install must be limited to reserved handles");
+  if (sem_handle_release(&hs, 1)) return fail("reserved handles must not be released");
+
+  // First allocations are the plain slot indices.
+  const zi_handle_t a = sem_handle_alloc(&hs, entry(1));
+  const zi_handle_t b = sem_handle_alloc(&hs, entry(2));
+  if (a != 3 || b != 4) return fail("expected handles 3 and 4");
+
+  // Release + realloc reuses the slot under a new generation; the stale value is dead.
+  if (!sem_handle_release(&hs, a)) return fail("release failed");
+  if (sem_handle_release(&hs, a)) return fail("double release must fail");
+  const zi_handle_t c = sem_handle_alloc(&hs, entry(3));
+  if (c == a || ((uint32_t)c & SEM_HANDLE_INDEX_MASK) != 3u) return fail("expected slot 3 under a new generation");
+  sem_handle_entry_t e;
+  if (sem_handle_lookup(&hs, a, &e)) return fail("stale handle must not resolve");
+  if (sem_handle_hflags(&hs, a) != 0) return fail("stale handle must have no flags");
+  if (!sem_handle_lookup(&hs, c, &e) || e.hflags != 3) return fail("new handle must resolve to its own entry");
+  if (sem_handle_lookup(&hs, c + 1, &e) || sem_handle_lookup(&hs, -1, &e)) return fail("bogus handles must not resolve");
+
+  // Grows well past the initial storage; values stay dense and deterministic.
+  static zi_handle_t many[20000];
+  for (uint32_t i = 0; i < 20000u; i++) {
+    many[i] = sem_handle_alloc(&hs, entry(i));
+    if (many[i] != (zi_handle_t)(5u + i)) return fail("growth must hand out fresh slots in order");
+  }
+  for (uint32_t i = 0; i < 20000u; i += 2) {
+    if (!sem_handle_release(&hs, many[i])) return fail("bulk release failed");
+  }
+  // LIFO reuse: the most recently released slot comes back first.
+  const zi_handle_t d = sem_handle_alloc(&hs, entry(7));
+  if (((uint32_t)d & SEM_HANDLE_INDEX_MASK) != (uint32_t)many[19998]) return fail("expected LIFO slot reuse");
+  if (!sem_handle_lookup(&hs, many[19999], &e) || e.hflags != 19999u) return fail("live handles must survive growth");
+  sem_handles_dispose(&hs);
+
+  // The limit counts slots (reserved included).
+  if (!sem_handles_init(&hs, 5)) return fail("small init failed");
+  if (sem_handle_alloc(&hs, entry(1)) != 3 || sem_handle_alloc(&hs, entry(2)) != 4) return fail("small table alloc failed");
+  if (sem_handle_alloc(&hs, entry(3)) >= 0) return fail("expected the limit to be enforced");
+  if (!sem_handle_release(&hs, 4) || sem_handle_alloc(&hs, entry(4)) < 0) return fail("a released slot must be reusable at the limit");
+  sem_handles_dispose(&hs);
+  return 0;
+}
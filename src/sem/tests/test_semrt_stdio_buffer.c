@@ -0,0 +1,71 @@
+#include "hosted_zabi.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <sys/stat.h>
+
+static int fail(const char* msg) {
+  fprintf(stderr, "sem_unit_tests: %s\n", msg);
+  return 1;
+}
+
+// Bytes that reached the file itself (not our buffer, not the FILE's).
+static long on_disk(FILE* f) {
+  struct stat st;
+  if (fstat(fileno(f), &st) != 0) return -1;
+  return (long)st.st_size;
+}
+
+static int32_t put(sir_hosted_zabi_t* rt, zi_handle_t h, zi_ptr_t p, const char* s) {
+  const zi_size32_t n = (zi_size32_t)strlen(s);
+  uint8_t* w = NULL;
+  if (!sem_guest_mem_map_rw(rt->mem, p, n, &w) || !w) return -1;
+  memcpy(w, s, n);
+  return sir_zi_write(rt, h, p, n);
+}
+
+static int check(sir_stdio_buffering_t mode) {
+  FILE* out = tmpfile();
+  FILE* err = tmpfile();
+  if (!out || !err) return fail("tmpfile failed");
+
+  sir_hosted_zabi_t rt;
+  if (!sir_hosted_zabi_init(&rt, (sir_hosted_zabi_cfg_t){.guest_mem_cap = 1024 * 1024,
+                                                         .guest_mem_base = 0x10000ull,
+                                                         .stdout_f = out,
+                                                         .stderr_f = err,
+                                                         .stdout_buffering = mode})) {
+    return fail("sir_hosted_zabi_init failed");
+  }
+  const zi_ptr_t p = sir_zi_alloc(&rt, 64);
+  int rc = 0;
+
+  if (put(&rt, 1, p, "ab") != 2) rc = fail("zi_write bad count");
+  else if (on_disk(out) != 0) rc = fail("partial line must stay buffered");
+  else if (put(&rt, 1, p, "c\n") != 2) rc = fail("zi_write bad count");
+  else if (on_disk(out) != (mode == SIR_STDIO_BUF_LINE ? 4 : 0)) rc = fail("newline flush does not match the mode");
+  else if (put(&rt, 2, p, "E") != 1) rc = fail("stderr write failed");
+  else if (on_disk(out) != 4 || on_disk(err) != 1) rc = fail("stderr must drain stdout first and be unbuffered");
+  else if (put(&rt, 1, p, "d") != 1 || on_disk(out) != 4) rc = fail("expected buffered write");
+  else if (sir_zi_end(&rt, 1) != 0 || on_disk(out) != 5) rc = fail("zi_end must flush");
+  else if (put(&rt, 1, p, "e") != 1 || !sir_hosted_zabi_flush(&rt) || on_disk(out) != 6) rc = fail("explicit flush failed");
+  else if (put(&rt, 1, p, "f") != 1) rc = fail("zi_write bad count");
+
+  sir_hosted_zabi_dispose(&rt);
+  if (rc == 0 && on_disk(out) != 7) rc = fail("dispose must flush");
+
+  char got[16] = {0};
+  rewind(out);
+  if (rc == 0 && (fread(got, 1, sizeof(got), out) != 7 || memcmp(got, "abc\ndef", 7) != 0)) rc = fail("stdout contents mismatch");
+  fclose(out);
+  fclose(err);
+  return rc;
+}
+
+int main(void) {
+  if (check(SIR_STDIO_BUF_FULL) != 0) return 1;
+  if (check(SIR_STDIO_BUF_LINE) != 0) return 1;
+  return 0;
+}
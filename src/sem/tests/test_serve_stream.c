@@ -0,0 +1,213 @@
+#include "sem_serve.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static int fail(const char* msg) {
+  fprintf(stderr, "sem_unit: %s\n", msg);
+  return 1;
+}
+
+#define ECHO8 SEM_SOURCE_DIR "/src/sem/tests/fixtures/serve_echo8.sir.jsonl"
+#define TRANSFER SEM_SOURCE_DIR "/src/sem/tests/fixtures/serve_transfer.sir.jsonl"
+
+static bool next_line(FILE* f, char* buf, size_t cap) {
+  if (!fgets(buf, (int)cap, f)) return false;
+  return strchr(buf, '\n') != NULL;
+}
+
+static bool has(const char* line, const char* needle) {
+  if (strstr(line, needle)) return true;
+  fprintf(stderr, "sem_unit: missing %s in: %s", needle, line);
+  return false;
+}
+
+static bool copy_file(const char* src, const char* dst, const char* from, const char* to) {
+  FILE* f = fopen(src, "rb");
+  if (!f) return false;
+  static char buf[1 << 16];
+  const size_t n = fread(buf, 1, sizeof(buf) - 1, f);
+  fclose(f);
+  buf[n] = 0;
+  if (from) {
+    char* at = strstr(buf, from);
+    if (!at || strlen(from) != strlen(to)) return false;
+    memcpy(at, to, strlen(to));
+  }
+  FILE* g = fopen(dst, "wb");
+  if (!g) return false;
+  const bool ok = fwrite(buf, 1, n, g) == n;
+  return fclose(g) == 0 && ok;
+}
+
+// Reads up to the next response line, appending the data of the stdout events before it to
+// `out_hex` and counting them in `*out_events` (either may be NULL).
+static bool next_response(FILE* f, char* line, size_t cap, char* out_hex, size_t hex_cap, int* out_events) {
+  if (out_hex) out_hex[0] = '\0';
+  if (out_events) *out_events = 0;
+  static const char data_key[] = "\"data_hex\":\"";
+  while (next_line(f, line, cap)) {
+    if (!strstr(line, "\"event\":")) return true;
+    if (!strstr(line, "\"event\":\"stdout\"")) continue;
+    if (out_events) (*out_events)++;
+    const char* d = strstr(line, data_key);
+    const char* e = d ? strchr(d + strlen(data_key), '"') : NULL;
+    if (!e) return false;
+    d += strlen(data_key);
+    if (!out_hex) continue;
+    const size_t have = strlen(out_hex);
+    if (have + (size_t)(e - d) >= hex_cap) return false;
+    memcpy(out_hex + have, d, (size_t)(e - d));
+    out_hex[have + (size_t)(e - d)] = '\0';
+  }
+  return false;
+}
+
+// One request/response round trip against a live server.
+static bool ask_raw(FILE* to, FILE* from, const char* req, char* line, size_t cap) {
+  fprintf(to, "%s\n", req);
+  fflush(to);
+  return next_response(from, line, cap, NULL, 0, NULL);
+}
+
+static bool ask(FILE* to, FILE* from, const char* path, const char* stdin_text, char* line, size_t cap) {
+  char req[512];
+  snprintf(req, sizeof(req), "{\"id\":0,\"path\":\"%s\",\"stdin\":\"%s\"}", path, stdin_text);
+  return ask_raw(to, from, req, line, cap);
+}
+
+// Copies the "hash" of a run response into `out`.
+static bool response_hash(const char* line, char* out, size_t cap) {
+  const char* h = strstr(line, "\"hash\":\"");
+  const char* e = h ? strchr(h + 8, '"') : NULL;
+  if (!e || (size_t)(e - (h + 8)) >= cap) return false;
+  memcpy(out, h + 8, (size_t)(e - (h + 8)));
+  out[e - (h + 8)] = '\0';
+  return true;
+}
+
+// The cache is keyed by content: identical files at different paths share a module, and a file
+// rewritten in place at the same size and mtime is still reloaded.
+static int content_key_case(void) {
+  char dir[] = "/tmp/sem_serve_XXXXXX";
+  if (!mkdtemp(dir)) return fail("mkdtemp failed");
+  char a[64], b[64];
+  snprintf(a, sizeof(a), "%s/a.sir.jsonl", dir);
+  snprintf(b, sizeof(b), "%s/b.sir.jsonl", dir);
+  if (!copy_file(ECHO8, a, NULL, NULL) || !copy_file(ECHO8, b, NULL, NULL)) return fail("copy fixture failed");
+
+  int req[2], resp[2];
+  if (pipe(req) != 0 || pipe(resp) != 0) return fail("pipe failed");
+  const pid_t pid = fork();
+  if (pid < 0) return fail("fork failed");
+  if (pid == 0) {
+    close(req[1]);
+    close(resp[0]);
+    FILE* in = fdopen(req[0], "r");
+    FILE* out = fdopen(resp[1], "w");
+    _exit(in && out && sem_serve_stream(in, out, NULL, 0, NULL) == 0 ? 0 : 1);
+  }
+  close(req[0]);
+  close(resp[1]);
+  FILE* to = fdopen(req[1], "w");
+  FILE* from = fdopen(resp[0], "r");
+  if (!to || !from) return fail("fdopen failed");
+
+  int rc = 0;
+  char line[1024];
+  char hash[128];
+  char msg[512];
+  struct stat st;
+  if (!ask(to, from, a, "hello", line, sizeof(line)) || !has(line, "\"exit\":5") || !has(line, "\"cached\":false") ||
+      !response_hash(line, hash, sizeof(hash))) {
+    rc = fail("bad first load");
+  } else if ((snprintf(msg, sizeof(msg), "{\"id\":0,\"hash\":\"%s\",\"stdin\":\"hi\"}", hash), !ask_raw(to, from, msg, line, sizeof(line))) ||
+             !has(line, "\"exit\":2") || !has(line, "\"cached\":true")) {
+    rc = fail("a resident hash must run without a path");
+  } else if (!ask_raw(to, from, "{\"id\":0,\"hash\":\"0-0\"}", line, sizeof(line)) || !has(line, "\"code\":\"sem.serve.not_resident\"")) {
+    rc = fail("an unknown hash without a path must be rejected");
+  } else if ((snprintf(msg, sizeof(msg), "{\"id\":0,\"hash\":\"0-0\",\"path\":\"%s\"}", a), !ask_raw(to, from, msg, line, sizeof(line))) ||
+             !has(line, "\"code\":\"sem.serve.hash_mismatch\"")) {
+    rc = fail("a hash that does not match the file must be rejected");
+  } else if (!ask(to, from, b, "hello", line, sizeof(line)) || !has(line, "\"exit\":5") || !has(line, "\"cached\":true")) {
+    rc = fail("identical module at another path must be shared");
+  } else if (stat(b, &st) != 0 || !copy_file(ECHO8, b, "\"value\":8}", "\"value\":2}")) {
+    rc = fail("rewrite failed");
+  } else {
+    struct timeval tv[2] = {{st.st_atime, 0}, {st.st_mtime, 0}};
+    (void)utimes(b, tv);
+    if (!ask(to, from, b, "hello", line, sizeof(line)) || !has(line, "\"exit\":2") || !has(line, "\"cached\":false")) {
+      rc = fail("same-size rewrite must reload the module");
+    } else if (!ask(to, from, a, "hello", line, sizeof(line)) || !has(line, "\"exit\":5") || !has(line, "\"cached\":true")) {
+      rc = fail("original contents must stay cached");
+    }
+  }
+
+  fclose(to);
+  fclose(from);
+  int status = 0;
+  if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) rc = rc ? rc : fail("server failed");
+  (void)unlink(a);
+  (void)unlink(b);
+  (void)rmdir(dir);
+  return rc;
+}
+
+int main(void) {
+  FILE* in = tmpfile();
+  FILE* out = tmpfile();
+  if (!in || !out) return fail("tmpfile failed");
+
+  // serve_echo8 reads up to 8 bytes from stdin, echoes them and exits with the count.
+  fputs("{\"id\":1,\"path\":\"" ECHO8 "\",\"stdin\":\"hello\"}\n", in);
+  fputs("{\"id\":2,\"path\":\"" ECHO8 "\",\"stdin_hex\":\"414243\"}\n", in);
+  fputs("\n", in);
+  fputs("{\"id\":\"missing\",\"path\":\"/nonexistent/x.sir.jsonl\"}\n", in);
+  fputs("{\"id\":4,\"path\":\"" ECHO8 "\",\"caps\":[\"file:fs\"]}\n", in);
+  fputs("{\"id\":5,\"path\":\"" ECHO8 "\"}\n", in);
+  fputs("not json\n", in);
+  // serve_transfer moves stdin to stdout with one zi_transfer and exits with the count.
+  fputs("{\"id\":9,\"path\":\"" TRANSFER "\",\"stdin\":\"hello world\"}\n", in);
+  fputs("{\"op\":\"shutdown\",\"id\":7}\n", in);
+  fputs("{\"id\":8,\"path\":\"" ECHO8 "\"}\n", in);
+  rewind(in);
+
+  if (sem_serve_stream(in, out, NULL, 0, NULL) != 0) return fail("sem_serve_stream failed");
+  fclose(in);
+  rewind(out);
+
+  char line[1024];
+  char hex[256];
+  int events = 0;
+  // Fresh guest per request: each run sees only its own stdin/stdout.
+  if (!next_response(out, line, sizeof(line), hex, sizeof(hex), &events)) return fail("missing response 1");
+  if (!has(line, "\"id\":1,") || !has(line, "\"ok\":true") || !has(line, "\"exit\":5") || !has(line, "\"cached\":false") ||
+      !has(line, "\"hash\":\"") || strcmp(hex, "68656c6c6f") != 0 || events != 1 || strstr(line, "stdout_hex"))
+    return fail("bad response 1");
+  if (!next_response(out, line, sizeof(line), hex, sizeof(hex), &events)) return fail("missing response 2");
+  if (!has(line, "\"id\":2,") || !has(line, "\"exit\":3") || !has(line, "\"cached\":true") || strcmp(hex, "414243") != 0)
+    return fail("bad response 2");
+  if (!next_response(out, line, sizeof(line), NULL, 0, NULL)) return fail("missing response 3");
+  if (!has(line, "\"id\":\"missing\"") || !has(line, "\"ok\":false") || !has(line, "\"code\":\"sem.serve.noent\"")) return fail("bad response 3");
+  if (!next_response(out, line, sizeof(line), NULL, 0, NULL)) return fail("missing response 4");
+  if (!has(line, "\"id\":4,") || !has(line, "\"code\":\"sem.serve.cap\"")) return fail("bad response 4");
+  if (!next_response(out, line, sizeof(line), hex, sizeof(hex), &events)) return fail("missing response 5");
+  if (!has(line, "\"id\":5,") || !has(line, "\"exit\":0") || events != 0) return fail("bad response 5");
+  if (!next_response(out, line, sizeof(line), NULL, 0, NULL)) return fail("missing response 6");
+  if (!has(line, "\"code\":\"sem.serve.bad_request\"")) return fail("bad response 6");
+  if (!next_response(out, line, sizeof(line), hex, sizeof(hex), &events)) return fail("missing response 9");
+  if (!has(line, "\"id\":9,") || !has(line, "\"exit\":11") || strcmp(hex, "68656c6c6f20776f726c64") != 0)
+    return fail("bad zi_transfer response");
+  if (!next_line(out, line, sizeof(line))) return fail("missing shutdown response");
+  if (!has(line, "\"id\":7,") || !has(line, "\"ok\":true")) return fail("bad shutdown response");
+  if (next_line(out, line, sizeof(line))) return fail("requests after shutdown must not be served");
+  fclose(out);
+  return content_key_case();
+}
@@ -0,0 +1,102 @@
+#include "sem_trace_bin.h"
+#include "sir_jsonl.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <unistd.h>
+
+static int fail(const char* msg) {
+  fprintf(stderr, "sem_unit: %s\n", msg);
+  return 1;
+}
+
+static char* slurp(const char* path, size_t* out_len) {
+  FILE* f = fopen(path, "rb");
+  if (!f) return NULL;
+  char* buf = NULL;
+  size_t len = 0;
+  FILE* mem = open_memstream(&buf, &len);
+  if (!mem) {
+    fclose(f);
+    return NULL;
+  }
+  char tmp[4096];
+  size_t n = 0;
+  while ((n = fread(tmp, 1, sizeof(tmp), f)) > 0) fwrite(tmp, 1, n, mem);
+  fclose(f);
+  fclose(mem);
+  *out_len = len;
+  return buf;
+}
+
+static bool mk_tmp(char* path) {
+  const int fd = mkstemp(path);
+  if (fd < 0) return false;
+  close(fd);
+  return true;
+}
+
+// The dumped binary trace must match --trace-jsonl-out byte for byte.
+static int check_roundtrip(const char* sir_path, const char* must_contain) {
+  char jsonl_path[] = "/tmp/sem_trace_bin_jsonl_XXXXXX";
+  char bin_path[] = "/tmp/sem_trace_bin_bin_XXXXXX";
+  char dump_path[] = "/tmp/sem_trace_bin_dump_XXXXXX";
+  if (!mk_tmp(jsonl_path) || !mk_tmp(bin_path) || !mk_tmp(dump_path)) return fail("mkstemp failed");
+
+  int rc = 0;
+  const int rc_json = sem_run_sir_jsonl_events_ex(sir_path, NULL, 0, NULL, SEM_DIAG_TEXT, false, jsonl_path, NULL, NULL, NULL);
+  const int rc_bin = sem_run_sir_jsonl_events_bin_ex(sir_path, NULL, 0, NULL, SEM_DIAG_TEXT, false, bin_path, NULL, NULL, NULL);
+  FILE* dump = fopen(dump_path, "wb");
+  const int rc_dump = dump ? sem_trace_bin_dump(bin_path, dump) : 2;
+  if (dump) fclose(dump);
+
+  size_t jl = 0, dl = 0, bl = 0;
+  char* j = slurp(jsonl_path, &jl);
+  char* d = slurp(dump_path, &dl);
+  char* b = slurp(bin_path, &bl);
+  if (rc_json != rc_bin) {
+    rc = fail("binary trace run returned a different rc");
+  } else if (rc_dump != 0) {
+    rc = fail("sem_trace_bin_dump failed");
+  } else if (!j || !d || !b || jl == 0) {
+    rc = fail("missing trace output");
+  } else if (jl != dl || memcmp(j, d, jl) != 0) {
+    fprintf(stderr, "sem_unit: dump of %s differs from trace JSONL\n", sir_path);
+    rc = 1;
+  } else if (!strstr(j, must_contain)) {
+    fprintf(stderr, "sem_unit: trace of %s missing %s\n", sir_path, must_contain);
+    rc = 1;
+  } else if (bl >= jl) {
+    rc = fail("binary trace is not smaller than JSONL");
+  }
+
+  // Truncating a valid trace mid-record must be reported as malformed.
+  if (rc == 0 && b && bl > 9) {
+    FILE* t = fopen(bin_path, "wb");
+    if (!t || fwrite(b, 1, bl - 1, t) != bl - 1) rc = fail("failed to rewrite trace");
+    if (t) fclose(t);
+    FILE* sink = fopen("/dev/null", "wb");
+    if (rc == 0 && sink && sem_trace_bin_dump(bin_path, sink) != 1) rc = fail("expected truncated trace to be rejected");
+    if (sink) fclose(sink);
+  }
+
+  free(j);
+  free(d);
+  free(b);
+  unlink(jsonl_path);
+  unlink(bin_path);
+  unlink(dump_path);
+  return rc;
+}
+
+int main(void) {
+  if (check_roundtrip(SEM_SOURCE_DIR "/src/sircc/examples/cfg_if.sir.jsonl", "\"k\":\"trace_step\"")) return 1;
+  if (check_roundtrip(SEM_SOURCE_DIR "/src/sircc/examples/mem_copy_fill.sir.jsonl", "\"k\":\"trace_mem\"")) return 1;
+  if (check_roundtrip(SEM_SOURCE_DIR "/src/sircc/examples/hello_zabi25_write.sir.jsonl", "\"k\":\"trace_hostcall\"")) return 1;
+
+  if (sem_trace_bin_dump("/nonexistent/trace.bin", stdout) != 2) return fail("expected open failure");
+  return 0;
+}
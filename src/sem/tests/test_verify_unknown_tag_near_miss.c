@@ -0,0 +1,97 @@
+#include "sir_jsonl.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <unistd.h>
+
+static int fail(const char* msg) {
+  fprintf(stderr, "sem_unit: %s\n", msg);
+  return 1;
+}
+
+static bool write_all(FILE* f, const char* s) {
+  return f && s && fputs(s, f) >= 0;
+}
+
+int main(void) {
+  char sir_path[] = "/tmp/sem_verify_unknown_tag_XXXXXX";
+  const int fd = mkstemp(sir_path);
+  if (fd < 0) return fail("mkstemp failed");
+  FILE* out = fdopen(fd, "wb");
+  if (!out) {
+    close(fd);
+    unlink(sir_path);
+    return fail("fdopen failed");
+  }
+
+  // Tags are interned through a perfect hash; a near miss of a known mnemonic
+  // ("const.i3" vs "const.i32") must still be rejected as unsupported, and
+  // unknown record kinds must still be ignored.
+  if (!write_all(out, "{\"ir\":\"sir-v1.0\",\"k\":\"meta\",\"producer\":\"sem-unit\",\"unit\":\"unknown_tag\"}\n")) return fail("write failed");
+  if (!write_all(out, "{\"ir\":\"sir-v1.0\",\"k\":\"typ\",\"id\":9,\"kind\":\"prim\",\"prim\":\"i32\"}\n")) return fail("write failed");
+  if (!write_all(out, "{\"ir\":\"sir-v1.0\",\"k\":\"type\",\"id\":1,\"kind\":\"prim\",\"prim\":\"i32\"}\n")) return fail("write failed");
+  if (!write_all(out, "{\"ir\":\"sir-v1.0\",\"k\":\"type\",\"id\":11,\"kind\":\"fn\",\"params\":[],\"ret\":1}\n")) return fail("write failed");
+  if (!write_all(out, "{\"ir\":\"sir-v1.0\",\"k\":\"node\",\"id\":110,\"tag\":\"const.i3\",\"type_ref\":1,\"fields\":{\"value\":7}}\n"))
+    return fail("write failed");
+  if (!write_all(out, "{\"ir\":\"sir-v1.0\",\"k\":\"node\",\"id\":131,\"tag\":\"term.ret\",\"fields\":{\"value\":{\"t\":\"ref\",\"id\":110}}}\n"))
+    return fail("write failed");
+  if (!write_all(out, "{\"ir\":\"sir-v1.0\",\"k\":\"node\",\"id\":140,\"tag\":\"block\",\"fields\":{\"stmts\":[{\"t\":\"ref\",\"id\":131}]}}\n"))
+    return fail("write failed");
+  if (!write_all(out, "{\"ir\":\"sir-v1.0\",\"k\":\"node\",\"id\":150,\"tag\":\"fn\",\"type_ref\":11,\"fields\":{\"name\":\"zir_main\",\"params\":[],\"body\":{\"t\":\"ref\",\"id\":140}}}\n"))
+    return fail("write failed");
+
+  fclose(out);
+
+  char diag_path[] = "/tmp/sem_verify_unknown_tag_out_XXXXXX";
+  const int dfd = mkstemp(diag_path);
+  if (dfd < 0) {
+    unlink(sir_path);
+    return fail("mkstemp diag failed");
+  }
+
+  const int saved_stderr = dup(STDERR_FILENO);
+  if (saved_stderr < 0) {
+    close(dfd);
+    unlink(diag_path);
+    unlink(sir_path);
+    return fail("dup stderr failed");
+  }
+  if (dup2(dfd, STDERR_FILENO) < 0) {
+    close(saved_stderr);
+    close(dfd);
+    unlink(diag_path);
+    unlink(sir_path);
+    return fail("dup2 failed");
+  }
+  close(dfd);
+
+  const int rc = sem_verify_sir_jsonl_ex(sir_path, SEM_DIAG_JSON, false);
+
+  fflush(stderr);
+  (void)dup2(saved_stderr, STDERR_FILENO);
+  close(saved_stderr);
+
+  unlink(sir_path);
+
+  if (rc == 0) {
+    unlink(diag_path);
+    return fail("expected verify to fail");
+  }
+
+  FILE* f = fopen(diag_path, "rb");
+  if (!f) {
+    unlink(diag_path);
+    return fail("failed to open diag output");
+  }
+  char line[2048];
+  const bool ok = (fgets(line, sizeof(line), f) != NULL);
+  fclose(f);
+  unlink(diag_path);
+  if (!ok) return fail("expected JSON diagnostic line");
+
+  if (strstr(line, "\"code\":\"sem.unsupported.node\"") == NULL) return fail("expected sem.unsupported.node diagnostic");
+  if (strstr(line, "\"tag\":\"const.i3\"") == NULL) return fail("missing tag field in JSON diagnostic");
+  return 0;
+}
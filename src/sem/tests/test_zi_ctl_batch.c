@@ -0,0 +1,134 @@
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE // mkstemp
+#endif
+
+#include "sem_host.h"
+#include "zcl1.h"
+#include "zi_tape.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static int fail(const char* msg) {
+  fprintf(stderr, "sem_unit_tests: %s\n", msg);
+  return 1;
+}
+
+typedef struct sub_resp {
+  int32_t rc;
+  zcl1_hdr_t h;
+  const uint8_t* payload;
+} sub_resp_t;
+
+// Splits a BATCH response into its sub-responses; returns the count or -1.
+static int split(const uint8_t* resp, int32_t len, sub_resp_t* out, int max) {
+  zcl1_hdr_t h = {0};
+  const uint8_t* p = NULL;
+  if (len < 0 || !zcl1_parse(resp, (uint32_t)len, &h, &p)) return -1;
+  if (h.op != SEM_ZI_CTL_OP_BATCH || h.status != 1 || h.payload_len < 4) return -1;
+  const uint32_t n = zcl1_read_u32le(p);
+  if ((int)n > max) return -1;
+  uint32_t off = 4;
+  for (uint32_t i = 0; i < n; i++) {
+    if (off + 8 > h.payload_len) return -1;
+    out[i].rc = (int32_t)zcl1_read_u32le(p + off);
+    const uint32_t flen = zcl1_read_u32le(p + off + 4);
+    off += 8;
+    if (off + flen > h.payload_len) return -1;
+    if (flen && !zcl1_parse(p + off, flen, &out[i].h, &out[i].payload)) return -1;
+    off += flen;
+  }
+  return off == h.payload_len ? (int)n : -1;
+}
+
+int main(void) {
+  static uint8_t meta[200];
+  const sem_cap_t caps[2] = {
+      {.kind = "file", .name = "fs", .flags = SEM_ZI_CAP_CAN_OPEN},
+      {.kind = "async", .name = "default", .flags = SEM_ZI_CAP_PURE, .meta = meta, .meta_len = sizeof(meta)},
+  };
+  sem_host_t host;
+  sem_host_init(&host, (sem_host_cfg_t){.caps = caps, .cap_count = 2});
+
+  // Three sub-requests: CAPS_LIST, an unknown op, and a nested BATCH.
+  uint8_t list[ZCL1_HDR_SIZE];
+  uint8_t unknown[ZCL1_HDR_SIZE];
+  uint8_t nested[ZCL1_HDR_SIZE + 4];
+  uint32_t list_len = 0;
+  uint32_t unknown_len = 0;
+  uint32_t nested_len = 0;
+  if (!sem_build_caps_list_req(7, list, sizeof(list), &list_len)) return fail("build CAPS_LIST failed");
+  if (!zcl1_write(unknown, sizeof(unknown), 999, 8, 0, NULL, 0, &unknown_len)) return fail("build unknown op failed");
+  if (!sem_build_batch_req(9, NULL, NULL, 0, nested, sizeof(nested), &nested_len)) return fail("build nested batch failed");
+  const uint8_t* subs[3] = {list, unknown, nested};
+  const uint32_t sub_lens[3] = {list_len, unknown_len, nested_len};
+
+  uint8_t req[256];
+  uint32_t req_len = 0;
+  if (!sem_build_batch_req(1, subs, sub_lens, 3, req, sizeof(req), &req_len)) return fail("build batch failed");
+
+  uint8_t resp[1024];
+  const int32_t rc = sem_zi_ctl(&host, req, req_len, resp, sizeof(resp));
+  sub_resp_t sr[4];
+  if (split(resp, rc, sr, 4) != 3) return fail("expected three sub-responses");
+  if (sr[0].rc <= 0 || sr[0].h.op != SEM_ZI_CTL_OP_CAPS_LIST || sr[0].h.rid != 7 || sr[0].h.status != 1)
+    return fail("bad CAPS_LIST sub-response");
+  if (zcl1_read_u32le(sr[0].payload + 4) != 2) return fail("expected two caps");
+  if (sr[1].rc <= 0 || sr[1].h.rid != 8 || sr[1].h.status != 0) return fail("unknown op must get an error frame");
+  if (sr[2].rc <= 0 || sr[2].h.rid != 9 || sr[2].h.status != 0) return fail("nested batch must get an error frame");
+
+  // Same answers as standalone calls.
+  uint8_t one[1024];
+  const int32_t one_rc = sem_zi_ctl(&host, list, list_len, one, sizeof(one));
+  if (one_rc != sr[0].rc || memcmp(one + ZCL1_HDR_SIZE, sr[0].payload, (size_t)one_rc - ZCL1_HDR_SIZE) != 0)
+    return fail("batched CAPS_LIST differs");
+
+  // A sub-response that does not fit (CAPS_LIST is ~280 bytes with the meta blob) is
+  // reported as ZI_E_BOUNDS; the rest still runs.
+  const uint8_t* subs2[2] = {list, unknown};
+  const uint32_t lens2[2] = {list_len, unknown_len};
+  if (!sem_build_batch_req(2, subs2, lens2, 2, req, sizeof(req), &req_len)) return fail("build batch 2 failed");
+  const int32_t small_rc = sem_zi_ctl(&host, req, req_len, resp, (uint32_t)(ZCL1_HDR_SIZE + 4 + 8 + 150));
+  if (split(resp, small_rc, sr, 4) != 2 || sr[0].rc != SEM_ZI_E_BOUNDS || sr[1].rc <= 0)
+    return fail("expected BOUNDS then a response");
+
+  // Malformed: frame length overruns the payload; nothing runs.
+  if (!sem_build_batch_req(3, subs, sub_lens, 1, req, sizeof(req), &req_len)) return fail("build batch 3 failed");
+  zcl1_write_u32le(req + ZCL1_HDR_SIZE + 4, 1000);
+  zcl1_hdr_t h = {0};
+  const uint8_t* p = NULL;
+  const int32_t bad_rc = sem_zi_ctl(&host, req, req_len, resp, sizeof(resp));
+  if (bad_rc < 0 || !zcl1_parse(resp, (uint32_t)bad_rc, &h, &p) || h.status != 0)
+    return fail("malformed batch must get an error response");
+
+  // Overlapping buffers (answered in place): nothing runs, and the error frame says why.
+  if (!sem_build_batch_req(5, subs, sub_lens, 3, req, sizeof(req), &req_len)) return fail("build batch 5 failed");
+  const int32_t inplace_rc = sem_zi_ctl(&host, req, req_len, req, sizeof(req));
+  if (inplace_rc < 0 || !zcl1_parse(req, (uint32_t)inplace_rc, &h, &p) || h.status != 0 || h.rid != 5)
+    return fail("overlapping batch must get an error response");
+
+  // Recorded and replayed as one tape record.
+  char tape[] = "/tmp/sem_zi_ctl_batch_XXXXXX";
+  const int fd = mkstemp(tape);
+  if (fd < 0) return fail("mkstemp failed");
+  close(fd);
+  if (!sem_build_batch_req(4, subs, sub_lens, 3, req, sizeof(req), &req_len)) return fail("build batch 4 failed");
+  zi_tape_writer_t* tw = zi_tape_writer_open(tape);
+  if (!tw) return fail("tape open failed");
+  zi_ctl_record_ctx_t rec = {.inner = sem_zi_ctl, .inner_user = &host, .tape = tw};
+  const int32_t rec_rc = zi_ctl_record(&rec, req, req_len, resp, sizeof(resp));
+  if (!zi_tape_writer_close(tw) || rec_rc <= 0) return fail("record failed");
+
+  zi_tape_reader_t* tr = zi_tape_reader_open(tape);
+  if (!tr || zi_tape_reader_count(tr) != 1) return fail("expected exactly one tape record");
+  zi_ctl_replay_ctx_t play = {.tape = tr, .strict_match = true};
+  uint8_t replayed[1024];
+  const int32_t play_rc = zi_ctl_replay(&play, req, req_len, replayed, sizeof(replayed));
+  zi_tape_reader_close(tr);
+  unlink(tape);
+  if (play_rc != rec_rc || memcmp(replayed, resp, (size_t)rec_rc) != 0) return fail("replayed batch differs");
+  return 0;
+}
@@ -0,0 +1,247 @@
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE // mkstemp
+#endif
+
+#include "zi_tape.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+static int fail(const char* msg) {
+  fprintf(stderr, "sem_unit: %s\n", msg);
+  return 1;
+}
+
+#define REC_COUNT 5000u
+
+// Deterministic record i: a request unique per record, and a response drawn from a
+// small set so dedup has repeats; every 7th record is a transport error (no payload).
+static uint32_t make_req(uint32_t i, uint8_t* buf) {
+  const uint32_t n = 16u + (i % 48u);
+  for (uint32_t k = 0; k < n; k++) buf[k] = (uint8_t)(i * 31u + k);
+  memcpy(buf, &i, sizeof(i));
+  return n;
+}
+
+static int32_t make_resp(uint32_t i, uint8_t* buf, uint32_t* out_len) {
+  if (i % 7u == 3u) {
+    *out_len = 0;
+    return -2;
+  }
+  const uint32_t variant = (i % 11u == 0) ? i : (i % 5u);  // mostly repeats, some unique
+  const uint32_t n = 120u + (variant % 100u);
+  for (uint32_t k = 0; k < n; k++) buf[k] = (uint8_t)(variant + k / 3u);
+  *out_len = n;
+  return (int32_t)n;
+}
+
+static bool write_tape(const char* path, bool compress, uint32_t count, bool close_it) {
+  zi_tape_writer_t* w = zi_tape_writer_open_ex(path, (zi_tape_writer_opts_t){.compress = compress});
+  if (!w) return false;
+  uint8_t req[64], resp[256];
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t resp_len = 0;
+    const int32_t rc = make_resp(i, resp, &resp_len);
+    if (!zi_tape_writer_write(w, req, make_req(i, req), rc, resp, resp_len)) return false;
+  }
+  if (!close_it) return true;  // leaked on purpose: simulates a writer that never closed
+  return zi_tape_writer_close(w);
+}
+
+static bool check_rec(zi_tape_reader_t* r, uint32_t i) {
+  const uint8_t* req = NULL;
+  const uint8_t* resp = NULL;
+  uint32_t req_len = 0, resp_len = 0;
+  int32_t rc = 0;
+  if (!zi_tape_reader_next(r, &req, &req_len, &rc, &resp, &resp_len)) return false;
+  uint8_t want_req[64], want_resp[256];
+  uint32_t want_resp_len = 0;
+  const uint32_t want_req_len = make_req(i, want_req);
+  const int32_t want_rc = make_resp(i, want_resp, &want_resp_len);
+  return req_len == want_req_len && memcmp(req, want_req, req_len) == 0 && rc == want_rc && resp_len == want_resp_len &&
+         (resp_len == 0 || memcmp(resp, want_resp, resp_len) == 0);
+}
+
+static int check_tape(const char* path, uint32_t count) {
+  zi_tape_reader_t* r = zi_tape_reader_open(path);
+  if (!r) return fail("failed to open tape");
+  if (zi_tape_reader_count(r) != count) {
+    zi_tape_reader_close(r);
+    return fail("unexpected record count");
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    if (!check_rec(r, i)) {
+      zi_tape_reader_close(r);
+      fprintf(stderr, "sem_unit: sequential record %u mismatch\n", (unsigned)i);
+      return 1;
+    }
+  }
+  const uint8_t* a = NULL;
+  uint32_t al = 0;
+  int32_t rc = 0;
+  if (zi_tape_reader_next(r, &a, &al, &rc, &a, &al)) {
+    zi_tape_reader_close(r);
+    return fail("expected EOF after last record");
+  }
+  // Random access, including jumps backwards across blocks.
+  for (uint32_t k = 0; k < 500u && count; k++) {
+    const uint32_t i = (k * 7919u) % count;
+    if (!zi_tape_reader_seek(r, i) || !check_rec(r, i)) {
+      zi_tape_reader_close(r);
+      fprintf(stderr, "sem_unit: seek record %u mismatch\n", (unsigned)i);
+      return 1;
+    }
+  }
+  zi_tape_reader_close(r);
+  return 0;
+}
+
+static long file_size(const char* path) {
+  struct stat st;
+  return stat(path, &st) == 0 ? (long)st.st_size : -1;
+}
+
+int main(void) {
+  char raw_path[] = "/tmp/sem_zi_tape_raw_XXXXXX";
+  char z_path[] = "/tmp/sem_zi_tape_z_XXXXXX";
+  char v1_path[] = "/tmp/sem_zi_tape_v1_XXXXXX";
+  int fds[3] = {mkstemp(raw_path), mkstemp(z_path), mkstemp(v1_path)};
+  for (int i = 0; i < 3; i++) {
+    if (fds[i] < 0) return fail("mkstemp failed");
+    close(fds[i]);
+  }
+
+  int rc = 0;
+  if (!write_tape(raw_path, false, REC_COUNT, true) || !write_tape(z_path, true, REC_COUNT, true)) rc = fail("failed to write tapes");
+  if (!rc) rc = check_tape(raw_path, REC_COUNT);
+  if (!rc) rc = check_tape(z_path, REC_COUNT);
+  if (!rc && file_size(z_path) >= file_size(raw_path)) rc = fail("compressed tape is not smaller");
+
+  // Dedup: the uncompressed tape must be smaller than the same records without dedup
+  // (v1 layout: 12 bytes of lengths/rc plus both payloads per record).
+  if (!rc) {
+    uint64_t v1_total = 0;
+    uint8_t req[64], resp[256];
+    for (uint32_t i = 0; i < REC_COUNT; i++) {
+      uint32_t n = 0;
+      (void)make_resp(i, resp, &n);
+      v1_total += 12u + make_req(i, req) + n;
+    }
+    if ((uint64_t)file_size(raw_path) >= v1_total * 3u / 4u) rc = fail("dedup did not shrink the tape");
+  }
+
+  // Far more distinct responses than the dedup cache holds, each written twice: evicted
+  // entries are simply stored again and every record must still read back intact.
+  if (!rc) {
+    zi_tape_writer_t* w = zi_tape_writer_open(z_path);
+    if (!w) rc = fail("failed to open churn tape");
+    uint8_t resp[256];
+    for (uint32_t i = 0; !rc && i < 4096u; i++) {
+      const uint32_t v = (i % 2048u) * 2654435761u;
+      for (uint32_t k = 0; k < sizeof(resp); k++) resp[k] = (uint8_t)(v >> (k % 4u * 8u)) ^ (uint8_t)k;
+      if (!zi_tape_writer_write(w, (const uint8_t*)&i, sizeof(i), 0, resp, sizeof(resp))) rc = fail("churn tape write failed");
+    }
+    if (w && !zi_tape_writer_close(w) && !rc) rc = fail("churn tape close failed");
+    zi_tape_reader_t* r = rc ? NULL : zi_tape_reader_open(z_path);
+    if (!rc && !r) rc = fail("failed to open churn tape for reading");
+    for (uint32_t i = 0; r && !rc && i < 4096u; i++) {
+      const uint8_t *req = NULL, *got = NULL;
+      uint32_t req_len = 0, got_len = 0;
+      int32_t rrc = -1;
+      const uint32_t v = (i % 2048u) * 2654435761u;
+      for (uint32_t k = 0; k < sizeof(resp); k++) resp[k] = (uint8_t)(v >> (k % 4u * 8u)) ^ (uint8_t)k;
+      if (!zi_tape_reader_next(r, &req, &req_len, &rrc, &got, &got_len) || req_len != sizeof(i) || memcmp(req, &i, sizeof(i)) != 0 ||
+          rrc != 0 || got_len != sizeof(resp) || memcmp(got, resp, sizeof(resp)) != 0) {
+        rc = fail("churn tape record mismatch");
+      }
+    }
+    if (r) zi_tape_reader_close(r);
+  }
+
+  // A writer that never closed leaves no index: complete blocks are recovered by scanning.
+  if (!rc) {
+    if (!write_tape(z_path, true, REC_COUNT, false)) rc = fail("failed to write unclosed tape");
+    zi_tape_reader_t* r = rc ? NULL : zi_tape_reader_open(z_path);
+    if (!rc && !r) rc = fail("failed to open unclosed tape");
+    if (r) {
+      const uint32_t n = zi_tape_reader_count(r);
+      if (n == 0 || n >= REC_COUNT) rc = fail("expected a partial recovery of the unclosed tape");
+      for (uint32_t i = 0; !rc && i < n; i++) {
+        if (!check_rec(r, i)) rc = fail("recovered record mismatch");
+      }
+      zi_tape_reader_close(r);
+    }
+  }
+
+  // After an explicit flush every record written so far survives a writer that never closes.
+  if (!rc) {
+    zi_tape_writer_t* w = zi_tape_writer_open_ex(z_path, (zi_tape_writer_opts_t){.compress = true});
+    if (!w) rc = fail("failed to open flush tape");
+    uint8_t req[64], resp[256];
+    for (uint32_t i = 0; !rc && i < 37u; i++) {
+      uint32_t resp_len = 0;
+      const int32_t rrc = make_resp(i, resp, &resp_len);
+      if (!zi_tape_writer_write(w, req, make_req(i, req), rrc, resp, resp_len)) rc = fail("flush tape write failed");
+    }
+    if (!rc && !zi_tape_writer_flush(w)) rc = fail("flush failed");
+    if (!rc) rc = check_tape(z_path, 37u);  // writer deliberately left open
+  }
+
+  // The reader honours the header flags: compressed blocks need bit0, unknown bits are rejected.
+  if (!rc) {
+    if (!write_tape(z_path, true, 100u, true)) rc = fail("failed to write flag tape");
+    FILE* f = rc ? NULL : fopen(z_path, "r+b");
+    if (!rc && !f) rc = fail("fopen failed");
+    const uint8_t no_flags[4] = {0, 0, 0, 0};
+    const uint8_t bad_flags[4] = {3, 0, 0, 0};
+    if (f) {
+      if (fseek(f, 8, SEEK_SET) != 0 || fwrite(no_flags, 1, 4, f) != 4 || fflush(f) != 0) rc = fail("failed to clear tape flags");
+      zi_tape_reader_t* r = rc ? NULL : zi_tape_reader_open(z_path);
+      if (r) {
+        const uint8_t *req = NULL, *resp = NULL;
+        uint32_t req_len = 0, resp_len = 0;
+        int32_t rrc = 0;
+        if (zi_tape_reader_next(r, &req, &req_len, &rrc, &resp, &resp_len)) rc = fail("compressed block read without the compress flag");
+        zi_tape_reader_close(r);
+      }
+      if (!rc && (fseek(f, 8, SEEK_SET) != 0 || fwrite(bad_flags, 1, 4, f) != 4 || fflush(f) != 0)) rc = fail("failed to set tape flags");
+      if (!rc) {
+        r = zi_tape_reader_open(z_path);
+        if (r) {
+          zi_tape_reader_close(r);
+          rc = fail("tape with unknown flags must be rejected");
+        }
+      }
+      fclose(f);
+    }
+  }
+
+  // v1 tapes (bare native records, no header) are still readable.
+  if (!rc) {
+    FILE* f = fopen(v1_path, "wb");
+    if (!f) return fail("fopen failed");
+    uint8_t req[64], resp[256];
+    for (uint32_t i = 0; i < 100u; i++) {
+      const uint32_t req_len = make_req(i, req);
+      uint32_t resp_len = 0;
+      const int32_t rrc = make_resp(i, resp, &resp_len);
+      fwrite(&req_len, 1, 4, f);
+      fwrite(req, 1, req_len, f);
+      fwrite(&rrc, 1, 4, f);
+      fwrite(&resp_len, 1, 4, f);
+      fwrite(resp, 1, resp_len, f);
+    }
+    fclose(f);
+    rc = check_tape(v1_path, 100u);
+  }
+
+  unlink(raw_path);
+  unlink(z_path);
+  unlink(v1_path);
+  return rc;
+}
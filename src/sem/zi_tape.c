@@ -1,38 +1,343 @@
 #include "zi_tape.h"
 
+#include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define ZI_TAPE_HDR_SIZE 12u
+#define ZI_TAPE_BLK_HDR_SIZE 12u
+#define ZI_TAPE_TRAILER_SIZE 12u
+#define ZI_TAPE_BLOCK_TARGET (64u * 1024u)
+#define ZI_TAPE_DEDUP_MAX 4096u    // responses up to this size are remembered for dedup
+#define ZI_TAPE_DEDUP_SLOTS 512u   // direct-mapped, so at most SLOTS * MAX bytes are held
+#define ZI_TAPE_FLAG_COMPRESS 1u
+
+static const uint8_t k_tape_magic[8] = {'Z', 'I', 'T', 'A', 'P', 'E', 0, 2};
+static const uint8_t k_index_magic[4] = {'Z', 'I', 'X', '2'};
+
+typedef struct zi_tape_blk {
+  uint64_t file_off;  // block header offset (v2)
+  uint32_t first_rec;
+  uint32_t rec_count;
+} zi_tape_blk_t;
+
+typedef struct zi_tape_dedup {
+  uint8_t* bytes;  // NULL: empty slot
+  uint32_t len;
+  uint32_t cap;
+  uint32_t id;
+  uint64_t hash;
+} zi_tape_dedup_t;
 
 struct zi_tape_writer {
   FILE* f;
+  bool compress;
+  bool io_err;
+  uint64_t file_off;
+
+  uint8_t* blk;
+  uint32_t blk_len;
+  uint32_t blk_cap;
+  uint32_t blk_recs;
+  uint8_t* zbuf;
+  uint32_t zcap;
+
+  zi_tape_blk_t* blocks;
+  uint32_t block_count;
+  uint32_t block_cap;
+  uint32_t* rec_off;
+  uint32_t rec_count;
+  uint32_t rec_cap;
+  uint32_t* payload_rec;
+  uint32_t payload_count;
+  uint32_t payload_cap;
+
+  zi_tape_dedup_t* dd;  // ZI_TAPE_DEDUP_SLOTS entries once the first response is seen
 };
 
+typedef struct zi_tape_slot {
+  uint32_t blk_index;  // UINT32_MAX: empty
+  const uint8_t* blk;  // raw blocks point into the mapping
+  uint32_t blk_len;
+  uint8_t* dbuf;
+  uint32_t dcap;
+} zi_tape_slot_t;
+
 struct zi_tape_reader {
-  FILE* f;
-  uint8_t* req;
-  uint8_t* resp;
-  uint32_t req_cap;
-  uint32_t resp_cap;
+  const uint8_t* map;
+  size_t map_len;
+  bool v1;
+  bool compressed;  // header flag: blocks may be LZ-compressed
+
+  zi_tape_blk_t* blocks;
+  uint32_t block_count;
+  uint32_t* rec_off;
+  uint32_t rec_count;
+  uint32_t* payload_rec;
+  uint32_t payload_count;
+  uint32_t pos;
+
+  // Loaded blocks: [0] holds the current record, [1] the block defining a deduplicated
+  // response, so replaying repeats does not re-decompress the same two blocks.
+  zi_tape_slot_t slot[2];
 };
 
-static bool io_write_u32(FILE* f, uint32_t v) {
-  return fwrite(&v, 1, sizeof(v), f) == sizeof(v);
+static void le_put_u32(uint8_t* p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t le_get_u32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void le_put_u64(uint8_t* p, uint64_t v) {
+  le_put_u32(p, (uint32_t)v);
+  le_put_u32(p + 4, (uint32_t)(v >> 32));
 }
 
-static bool io_write_i32(FILE* f, int32_t v) {
-  return fwrite(&v, 1, sizeof(v), f) == sizeof(v);
+static uint64_t le_get_u64(const uint8_t* p) {
+  return (uint64_t)le_get_u32(p) | ((uint64_t)le_get_u32(p + 4) << 32);
+}
+
+static bool ensure_cap(uint8_t** buf, uint32_t* cap, uint32_t need) {
+  if (*cap >= need) return true;
+  uint32_t new_cap = *cap ? *cap : 256;
+  while (new_cap < need) {
+    if (new_cap > UINT32_MAX / 2u) return false;
+    new_cap *= 2;
+  }
+  uint8_t* nb = (uint8_t*)realloc(*buf, new_cap);
+  if (!nb) return false;
+  *buf = nb;
+  *cap = new_cap;
+  return true;
+}
+
+static bool push_u32(uint32_t** arr, uint32_t* len, uint32_t* cap, uint32_t v) {
+  if (*len == *cap) {
+    const uint32_t ncap = *cap ? *cap * 2u : 64u;
+    uint32_t* n = (uint32_t*)realloc(*arr, (size_t)ncap * sizeof(uint32_t));
+    if (!n) return false;
+    *arr = n;
+    *cap = ncap;
+  }
+  (*arr)[(*len)++] = v;
+  return true;
+}
+
+static bool push_blk(zi_tape_blk_t** arr, uint32_t* len, uint32_t* cap, zi_tape_blk_t v) {
+  if (*len == *cap) {
+    const uint32_t ncap = *cap ? *cap * 2u : 16u;
+    zi_tape_blk_t* n = (zi_tape_blk_t*)realloc(*arr, (size_t)ncap * sizeof(zi_tape_blk_t));
+    if (!n) return false;
+    *arr = n;
+    *cap = ncap;
+  }
+  (*arr)[(*len)++] = v;
+  return true;
+}
+
+// ---- block compression (byte-oriented LZ77: literal-run/match tokens, 16-bit offsets) ----
+
+#define ZI_LZ_MIN_MATCH 4u
+#define ZI_LZ_HASH_BITS 12u
+
+static uint32_t lz_bound(uint32_t n) {
+  return n + n / 255u + 16u;
+}
+
+static uint32_t lz_read32(const uint8_t* p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static uint8_t* lz_put_len(uint8_t* op, uint32_t n) {
+  while (n >= 255u) {
+    *op++ = 255u;
+    n -= 255u;
+  }
+  *op++ = (uint8_t)n;
+  return op;
+}
+
+static uint8_t* lz_put_seq(uint8_t* op, const uint8_t* lit, uint32_t lit_len, uint32_t off, uint32_t match_len) {
+  const uint32_t ml = match_len ? match_len - ZI_LZ_MIN_MATCH : 0;
+  *op++ = (uint8_t)(((lit_len < 15u ? lit_len : 15u) << 4) | (ml < 15u ? ml : 15u));
+  if (lit_len >= 15u) op = lz_put_len(op, lit_len - 15u);
+  memcpy(op, lit, lit_len);
+  op += lit_len;
+  if (!match_len) return op;
+  *op++ = (uint8_t)off;
+  *op++ = (uint8_t)(off >> 8);
+  if (ml >= 15u) op = lz_put_len(op, ml - 15u);
+  return op;
+}
+
+// `dst` must hold lz_bound(n) bytes. Returns the compressed size.
+static uint32_t lz_compress(const uint8_t* src, uint32_t n, uint8_t* dst) {
+  uint32_t table[1u << ZI_LZ_HASH_BITS];
+  memset(table, 0xff, sizeof(table));
+  uint8_t* op = dst;
+  uint32_t anchor = 0;
+  uint32_t i = 0;
+  while (i + ZI_LZ_MIN_MATCH <= n) {
+    const uint32_t seq = lz_read32(src + i);
+    const uint32_t h = (seq * 2654435761u) >> (32u - ZI_LZ_HASH_BITS);
+    const uint32_t cand = table[h];
+    table[h] = i;
+    if (cand == UINT32_MAX || i - cand > 0xffffu || lz_read32(src + cand) != seq) {
+      i++;
+      continue;
+    }
+    uint32_t len = ZI_LZ_MIN_MATCH;
+    while (i + len < n && src[cand + len] == src[i + len]) len++;
+    op = lz_put_seq(op, src + anchor, i - anchor, i - cand, len);
+    i += len;
+    anchor = i;
+  }
+  op = lz_put_seq(op, src + anchor, n - anchor, 0, 0);
+  return (uint32_t)(op - dst);
+}
+
+static bool lz_get_len(const uint8_t** ip, const uint8_t* iend, uint32_t* n) {
+  for (;;) {
+    if (*ip >= iend) return false;
+    const uint8_t b = *(*ip)++;
+    if (*n > UINT32_MAX - b) return false;
+    *n += b;
+    if (b != 255u) return true;
+  }
+}
+
+static bool lz_decompress(const uint8_t* src, uint32_t n, uint8_t* dst, uint32_t out_len) {
+  const uint8_t* ip = src;
+  const uint8_t* iend = src + n;
+  uint8_t* op = dst;
+  uint8_t* oend = dst + out_len;
+  while (ip < iend) {
+    const uint8_t tok = *ip++;
+    uint32_t lit = tok >> 4;
+    if (lit == 15u && !lz_get_len(&ip, iend, &lit)) return false;
+    if ((size_t)(iend - ip) < lit || (size_t)(oend - op) < lit) return false;
+    memcpy(op, ip, lit);
+    ip += lit;
+    op += lit;
+    if (ip == iend) break;
+
+    if (iend - ip < 2) return false;
+    const uint32_t off = (uint32_t)ip[0] | ((uint32_t)ip[1] << 8);
+    ip += 2;
+    uint32_t ml = tok & 15u;
+    if (ml == 15u && !lz_get_len(&ip, iend, &ml)) return false;
+    ml += ZI_LZ_MIN_MATCH;
+    if (off == 0 || off > (size_t)(op - dst) || (size_t)(oend - op) < ml) return false;
+    const uint8_t* from = op - off;
+    for (uint32_t k = 0; k < ml; k++) op[k] = from[k];
+    op += ml;
+  }
+  return op == oend;
+}
+
+// ---- writer ----
+
+static uint64_t payload_hash(const uint8_t* p, uint32_t n) {
+  uint64_t h = 1469598103934665603ull;
+  for (uint32_t i = 0; i < n; i++) {
+    h ^= p[i];
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+static bool io_write(zi_tape_writer_t* w, const void* p, size_t n) {
+  if (n && fwrite(p, 1, n, w->f) != n) {
+    w->io_err = true;
+    return false;
+  }
+  w->file_off += n;
+  return true;
+}
+
+static bool blk_append(zi_tape_writer_t* w, const void* p, uint32_t n) {
+  if (n > UINT32_MAX - w->blk_len || !ensure_cap(&w->blk, &w->blk_cap, w->blk_len + n)) return false;
+  if (n) memcpy(w->blk + w->blk_len, p, n);
+  w->blk_len += n;
+  return true;
+}
+
+static bool blk_append_u32(zi_tape_writer_t* w, uint32_t v) {
+  uint8_t b[4];
+  le_put_u32(b, v);
+  return blk_append(w, b, sizeof(b));
+}
+
+static bool writer_flush_block(zi_tape_writer_t* w) {
+  if (!w->blk_recs) return true;
+  const uint8_t* stored = w->blk;
+  uint32_t stored_len = w->blk_len;
+  if (w->compress && ensure_cap(&w->zbuf, &w->zcap, lz_bound(w->blk_len))) {
+    const uint32_t clen = lz_compress(w->blk, w->blk_len, w->zbuf);
+    if (clen < w->blk_len) {
+      stored = w->zbuf;
+      stored_len = clen;
+    }
+  }
+
+  const zi_tape_blk_t b = {.file_off = w->file_off, .first_rec = w->rec_count - w->blk_recs, .rec_count = w->blk_recs};
+  if (!push_blk(&w->blocks, &w->block_count, &w->block_cap, b)) return false;
+  uint8_t hdr[ZI_TAPE_BLK_HDR_SIZE];
+  le_put_u32(hdr, w->blk_len);
+  le_put_u32(hdr + 4, stored_len);
+  le_put_u32(hdr + 8, w->blk_recs);
+  if (!io_write(w, hdr, sizeof(hdr)) || !io_write(w, stored, stored_len)) return false;
+  w->blk_len = 0;
+  w->blk_recs = 0;
+  return true;
 }
 
-static bool io_read_u32(FILE* f, uint32_t* out) {
-  return fread(out, 1, sizeof(*out), f) == sizeof(*out);
+// The dedup cache is a fixed table indexed by payload hash: a new response replaces
+// whatever its slot held, so memory stays bounded however long the tape runs, and
+// repeats only dedup while their slot has not been reused since.
+
+// Returns the payload id of an identical earlier response, or UINT32_MAX.
+static uint32_t dedup_find(const zi_tape_writer_t* w, const uint8_t* p, uint32_t n, uint64_t h) {
+  if (!w->dd) return UINT32_MAX;
+  const zi_tape_dedup_t* e = &w->dd[h & (ZI_TAPE_DEDUP_SLOTS - 1u)];
+  if (e->bytes && e->hash == h && e->len == n && memcmp(e->bytes, p, n) == 0) return e->id;
+  return UINT32_MAX;
 }
 
-static bool io_read_i32(FILE* f, int32_t* out) {
-  return fread(out, 1, sizeof(*out), f) == sizeof(*out);
+static void dedup_insert(zi_tape_writer_t* w, const uint8_t* p, uint32_t n, uint64_t h, uint32_t id) {
+  if (!w->dd) {
+    w->dd = (zi_tape_dedup_t*)calloc(ZI_TAPE_DEDUP_SLOTS, sizeof(zi_tape_dedup_t));
+    if (!w->dd) return;  // dedup is best-effort
+  }
+  zi_tape_dedup_t* e = &w->dd[h & (ZI_TAPE_DEDUP_SLOTS - 1u)];
+  if (!e->bytes || e->cap < n) {
+    uint8_t* nb = (uint8_t*)realloc(e->bytes, n ? n : 1u);
+    if (!nb) return;
+    e->bytes = nb;
+    e->cap = n ? n : 1u;
+  }
+  if (n) memcpy(e->bytes, p, n);
+  e->len = n;
+  e->id = id;
+  e->hash = h;
 }
 
 zi_tape_writer_t* zi_tape_writer_open(const char* path) {
+  return zi_tape_writer_open_ex(path, (zi_tape_writer_opts_t){0});
+}
+
+zi_tape_writer_t* zi_tape_writer_open_ex(const char* path, zi_tape_writer_opts_t opts) {
   if (!path) return NULL;
   FILE* f = fopen(path, "wb");
   if (!f) return NULL;
@@ -42,83 +347,410 @@ zi_tape_writer_t* zi_tape_writer_open(const char* path) {
     return NULL;
   }
   w->f = f;
+  w->compress = opts.compress;
+
+  uint8_t hdr[ZI_TAPE_HDR_SIZE];
+  memcpy(hdr, k_tape_magic, sizeof(k_tape_magic));
+  le_put_u32(hdr + 8, opts.compress ? ZI_TAPE_FLAG_COMPRESS : 0u);
+  (void)io_write(w, hdr, sizeof(hdr));
   return w;
 }
 
-void zi_tape_writer_close(zi_tape_writer_t* w) {
-  if (!w) return;
-  if (w->f) fclose(w->f);
+static bool writer_write_index(zi_tape_writer_t* w) {
+  const uint64_t index_off = w->file_off;
+  uint8_t b[16];
+  le_put_u32(b, w->block_count);
+  if (!io_write(w, b, 4)) return false;
+  for (uint32_t i = 0; i < w->block_count; i++) {
+    le_put_u64(b, w->blocks[i].file_off);
+    le_put_u32(b + 8, w->blocks[i].first_rec);
+    le_put_u32(b + 12, w->blocks[i].rec_count);
+    if (!io_write(w, b, 16)) return false;
+  }
+  le_put_u32(b, w->rec_count);
+  if (!io_write(w, b, 4)) return false;
+  for (uint32_t i = 0; i < w->rec_count; i++) {
+    le_put_u32(b, w->rec_off[i]);
+    if (!io_write(w, b, 4)) return false;
+  }
+  le_put_u32(b, w->payload_count);
+  if (!io_write(w, b, 4)) return false;
+  for (uint32_t i = 0; i < w->payload_count; i++) {
+    le_put_u32(b, w->payload_rec[i]);
+    if (!io_write(w, b, 4)) return false;
+  }
+  le_put_u64(b, index_off);
+  memcpy(b + 8, k_index_magic, sizeof(k_index_magic));
+  return io_write(w, b, ZI_TAPE_TRAILER_SIZE);
+}
+
+bool zi_tape_writer_close(zi_tape_writer_t* w) {
+  if (!w) return false;
+  bool ok = false;
+  if (w->f) {
+    ok = writer_flush_block(w) && writer_write_index(w) && !w->io_err;
+    if (fclose(w->f) != 0) ok = false;
+  }
+  if (w->dd) {
+    for (uint32_t i = 0; i < ZI_TAPE_DEDUP_SLOTS; i++) free(w->dd[i].bytes);
+  }
+  free(w->dd);
+  free(w->blk);
+  free(w->zbuf);
+  free(w->blocks);
+  free(w->rec_off);
+  free(w->payload_rec);
   free(w);
+  return ok;
+}
+
+bool zi_tape_writer_flush(zi_tape_writer_t* w) {
+  if (!w || !w->f || w->io_err) return false;
+  if (!writer_flush_block(w)) return false;
+  if (fflush(w->f) != 0) w->io_err = true;
+  return !w->io_err;
 }
 
 bool zi_tape_writer_write(zi_tape_writer_t* w, const uint8_t* req, uint32_t req_len, int32_t rc, const uint8_t* resp,
                           uint32_t resp_len) {
-  if (!w || !w->f) return false;
+  if (!w || !w->f || w->io_err) return false;
   if (req_len && !req) return false;
   if (resp_len && !resp) return false;
 
-  if (!io_write_u32(w->f, req_len)) return false;
-  if (req_len && fwrite(req, 1, req_len, w->f) != req_len) return false;
-  if (!io_write_i32(w->f, rc)) return false;
-  if (!io_write_u32(w->f, resp_len)) return false;
-  if (resp_len && fwrite(resp, 1, resp_len, w->f) != resp_len) return false;
-  return fflush(w->f) == 0;
+  const uint32_t rec = w->rec_count;
+  if (!push_u32(&w->rec_off, &w->rec_count, &w->rec_cap, w->blk_len)) return false;
+  w->blk_recs++;
+  if (!blk_append_u32(w, req_len) || !blk_append(w, req, req_len) || !blk_append_u32(w, (uint32_t)rc)) return false;
+
+  const bool dedup = resp_len <= ZI_TAPE_DEDUP_MAX;
+  const uint64_t h = dedup ? payload_hash(resp, resp_len) : 0;
+  const uint32_t prev = dedup ? dedup_find(w, resp, resp_len, h) : UINT32_MAX;
+  if (prev != UINT32_MAX) {
+    const uint8_t kind = 1;
+    if (!blk_append(w, &kind, 1) || !blk_append_u32(w, prev)) return false;
+  } else {
+    const uint8_t kind = 0;
+    const uint32_t id = w->payload_count;
+    if (!blk_append(w, &kind, 1) || !blk_append_u32(w, resp_len) || !blk_append(w, resp, resp_len)) return false;
+    if (!push_u32(&w->payload_rec, &w->payload_count, &w->payload_cap, rec)) return false;
+    if (dedup) dedup_insert(w, resp, resp_len, h, id);
+  }
+
+  if (w->blk_len >= ZI_TAPE_BLOCK_TARGET) return writer_flush_block(w);
+  return true;
+}
+
+// ---- reader ----
+
+typedef struct zi_tape_rec {
+  const uint8_t* req;
+  uint32_t req_len;
+  int32_t rc;
+  bool is_ref;
+  uint32_t payload_id;
+  const uint8_t* resp;
+  uint32_t resp_len;
+} zi_tape_rec_t;
+
+// Parses one record at `off` within `b[0..len)`; *out_next receives the following offset.
+static bool parse_rec(bool v1, const uint8_t* b, uint32_t len, uint32_t off, zi_tape_rec_t* out, uint32_t* out_next) {
+  memset(out, 0, sizeof(*out));
+  if (off > len || len - off < 4) return false;
+  out->req_len = le_get_u32(b + off);
+  off += 4;
+  if (len - off < out->req_len) return false;
+  out->req = b + off;
+  off += out->req_len;
+  if (len - off < 4) return false;
+  out->rc = (int32_t)le_get_u32(b + off);
+  off += 4;
+  if (!v1) {
+    if (len - off < 5) return false;
+    const uint8_t kind = b[off++];
+    if (kind > 1) return false;
+    out->is_ref = kind == 1;
+    if (out->is_ref) {
+      out->payload_id = le_get_u32(b + off);
+      *out_next = off + 4;
+      return true;
+    }
+  }
+  if (len - off < 4) return false;
+  out->resp_len = le_get_u32(b + off);
+  off += 4;
+  if (len - off < out->resp_len) return false;
+  out->resp = b + off;
+  *out_next = off + out->resp_len;
+  return true;
+}
+
+static const zi_tape_slot_t* reader_load_block(zi_tape_reader_t* r, uint32_t k, uint32_t slot) {
+  zi_tape_slot_t* sl = &r->slot[slot];
+  if (sl->blk_index == k) return sl;
+  if (k >= r->block_count) return NULL;
+  sl->blk_index = UINT32_MAX;
+  if (r->v1) {
+    sl->blk = r->map;
+    sl->blk_len = (uint32_t)r->map_len;
+    sl->blk_index = k;
+    return sl;
+  }
+  const uint64_t off = r->blocks[k].file_off;
+  if (off > r->map_len || r->map_len - off < ZI_TAPE_BLK_HDR_SIZE) return NULL;
+  const uint8_t* h = r->map + off;
+  const uint32_t raw_len = le_get_u32(h);
+  const uint32_t stored_len = le_get_u32(h + 4);
+  if (r->map_len - off - ZI_TAPE_BLK_HDR_SIZE < stored_len || stored_len > raw_len) return NULL;
+  const uint8_t* data = h + ZI_TAPE_BLK_HDR_SIZE;
+  if (stored_len != raw_len && !r->compressed) return NULL;
+  if (stored_len == raw_len) {
+    sl->blk = data;
+  } else {
+    if (!ensure_cap(&sl->dbuf, &sl->dcap, raw_len ? raw_len : 1u)) return NULL;
+    if (!lz_decompress(data, stored_len, sl->dbuf, raw_len)) return NULL;
+    sl->blk = sl->dbuf;
+  }
+  sl->blk_len = raw_len;
+  sl->blk_index = k;
+  return sl;
+}
+
+static uint32_t reader_block_of(const zi_tape_reader_t* r, uint32_t rec) {
+  uint32_t lo = 0, hi = r->block_count;
+  while (hi - lo > 1u) {
+    const uint32_t mid = lo + (hi - lo) / 2u;
+    if (r->blocks[mid].first_rec <= rec)
+      lo = mid;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+static bool reader_get(zi_tape_reader_t* r, uint32_t i, zi_tape_rec_t* out) {
+  if (i >= r->rec_count) return false;
+  const zi_tape_slot_t* sl = reader_load_block(r, reader_block_of(r, i), 0);
+  if (!sl) return false;
+  uint32_t next = 0;
+  if (!parse_rec(r->v1, sl->blk, sl->blk_len, r->rec_off[i], out, &next)) return false;
+  if (!out->is_ref) return true;
+
+  if (out->payload_id >= r->payload_count) return false;
+  const uint32_t j = r->payload_rec[out->payload_id];
+  if (j >= i) return false;
+  const uint32_t kj = reader_block_of(r, j);
+  const zi_tape_slot_t* def_sl = (kj == sl->blk_index) ? sl : reader_load_block(r, kj, 1);
+  if (!def_sl) return false;
+  zi_tape_rec_t def;
+  if (!parse_rec(false, def_sl->blk, def_sl->blk_len, r->rec_off[j], &def, &next) || def.is_ref) return false;
+  out->resp = def.resp;
+  out->resp_len = def.resp_len;
+  return true;
+}
+
+// Builds the v1 index by walking the records (v1 tapes have no header or index).
+static bool reader_index_v1(zi_tape_reader_t* r) {
+  if (r->map_len > UINT32_MAX) return false;
+  r->v1 = true;
+  uint32_t cap = 0;
+  uint32_t off = 0;
+  const uint32_t len = (uint32_t)r->map_len;
+  while (off < len) {
+    zi_tape_rec_t rec;
+    uint32_t next = 0;
+    if (!parse_rec(true, r->map, len, off, &rec, &next)) break;  // trailing partial record
+    if (!push_u32(&r->rec_off, &r->rec_count, &cap, off)) return false;
+    off = next;
+  }
+  uint32_t bcap = 0;
+  return push_blk(&r->blocks, &r->block_count, &bcap, (zi_tape_blk_t){.file_off = 0, .first_rec = 0, .rec_count = r->rec_count});
+}
+
+static bool reader_index_from_footer(zi_tape_reader_t* r) {
+  if (r->map_len < ZI_TAPE_HDR_SIZE + ZI_TAPE_TRAILER_SIZE) return false;
+  const uint8_t* t = r->map + r->map_len - ZI_TAPE_TRAILER_SIZE;
+  if (memcmp(t + 8, k_index_magic, sizeof(k_index_magic)) != 0) return false;
+  const uint64_t index_off = le_get_u64(t);
+  const uint64_t end = r->map_len - ZI_TAPE_TRAILER_SIZE;
+  if (index_off < ZI_TAPE_HDR_SIZE || index_off > end) return false;
+  const uint8_t* p = r->map + index_off;
+  uint64_t left = end - index_off;
+
+  if (left < 4) return false;
+  const uint32_t nb = le_get_u32(p);
+  p += 4;
+  left -= 4;
+  if (left / 16u < nb) return false;
+  r->blocks = (zi_tape_blk_t*)calloc(nb ? nb : 1u, sizeof(zi_tape_blk_t));
+  if (!r->blocks) return false;
+  for (uint32_t i = 0; i < nb; i++) {
+    r->blocks[i] = (zi_tape_blk_t){.file_off = le_get_u64(p), .first_rec = le_get_u32(p + 8), .rec_count = le_get_u32(p + 12)};
+    p += 16;
+  }
+  left -= (uint64_t)nb * 16u;
+  r->block_count = nb;
+
+  if (left < 4) return false;
+  const uint32_t nr = le_get_u32(p);
+  p += 4;
+  left -= 4;
+  if (left / 4u < nr) return false;
+  r->rec_off = (uint32_t*)calloc(nr ? nr : 1u, sizeof(uint32_t));
+  if (!r->rec_off) return false;
+  for (uint32_t i = 0; i < nr; i++, p += 4) r->rec_off[i] = le_get_u32(p);
+  left -= (uint64_t)nr * 4u;
+  r->rec_count = nr;
+
+  if (left < 4) return false;
+  const uint32_t np = le_get_u32(p);
+  p += 4;
+  left -= 4;
+  if (left / 4u < np) return false;
+  r->payload_rec = (uint32_t*)calloc(np ? np : 1u, sizeof(uint32_t));
+  if (!r->payload_rec) return false;
+  for (uint32_t i = 0; i < np; i++, p += 4) r->payload_rec[i] = le_get_u32(p);
+  r->payload_count = np;
+
+  // Blocks must tile the records in order.
+  uint32_t expect = 0;
+  for (uint32_t i = 0; i < nb; i++) {
+    if (r->blocks[i].first_rec != expect || r->blocks[i].rec_count == 0 || r->blocks[i].rec_count > nr - expect) return false;
+    expect += r->blocks[i].rec_count;
+  }
+  return expect == nr;
+}
+
+// Recovers the index of a tape whose writer never closed it: walk the blocks and
+// drop anything after the last complete one.
+static bool reader_index_by_scan(zi_tape_reader_t* r) {
+  free(r->blocks);
+  free(r->rec_off);
+  free(r->payload_rec);
+  r->blocks = NULL;
+  r->rec_off = NULL;
+  r->payload_rec = NULL;
+  r->block_count = r->rec_count = r->payload_count = 0;
+  r->slot[0].blk_index = UINT32_MAX;
+
+  uint32_t bcap = 0, rcap = 0, pcap = 0;
+  uint64_t off = ZI_TAPE_HDR_SIZE;
+  while (r->map_len - off >= ZI_TAPE_BLK_HDR_SIZE) {
+    const uint32_t stored_len = le_get_u32(r->map + off + 4);
+    const uint32_t nrec = le_get_u32(r->map + off + 8);
+    if (r->map_len - off - ZI_TAPE_BLK_HDR_SIZE < stored_len || nrec == 0) break;
+
+    const uint32_t first = r->rec_count;
+    if (!push_blk(&r->blocks, &r->block_count, &bcap, (zi_tape_blk_t){.file_off = off, .first_rec = first, .rec_count = nrec})) return false;
+    const zi_tape_slot_t* sl = reader_load_block(r, r->block_count - 1u, 0);
+    if (!sl) {
+      r->block_count--;
+      break;
+    }
+    uint32_t roff = 0;
+    bool ok = true;
+    const uint32_t payload_mark = r->payload_count;
+    for (uint32_t i = 0; i < nrec; i++) {
+      zi_tape_rec_t rec;
+      uint32_t next = 0;
+      if (!parse_rec(false, sl->blk, sl->blk_len, roff, &rec, &next) ||
+          !push_u32(&r->rec_off, &r->rec_count, &rcap, roff) ||
+          (!rec.is_ref && !push_u32(&r->payload_rec, &r->payload_count, &pcap, first + i))) {
+        ok = false;
+        break;
+      }
+      roff = next;
+    }
+    if (!ok || roff != sl->blk_len) {
+      r->block_count--;
+      r->rec_count = first;
+      r->payload_count = payload_mark;
+      break;
+    }
+    off += ZI_TAPE_BLK_HDR_SIZE + stored_len;
+  }
+  r->slot[0].blk_index = UINT32_MAX;
+  return true;
 }
 
 zi_tape_reader_t* zi_tape_reader_open(const char* path) {
   if (!path) return NULL;
-  FILE* f = fopen(path, "rb");
-  if (!f) return NULL;
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0) return NULL;
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < 0) {
+    close(fd);
+    return NULL;
+  }
   zi_tape_reader_t* r = (zi_tape_reader_t*)calloc(1, sizeof(*r));
   if (!r) {
-    fclose(f);
+    close(fd);
+    return NULL;
+  }
+  r->slot[0].blk_index = UINT32_MAX;
+  r->slot[1].blk_index = UINT32_MAX;
+  r->map_len = (size_t)st.st_size;
+  if (r->map_len) {
+    void* m = mmap(NULL, r->map_len, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (m == MAP_FAILED) {
+      close(fd);
+      free(r);
+      return NULL;
+    }
+    r->map = (const uint8_t*)m;
+  }
+  close(fd);
+
+  bool ok = false;
+  if (r->map_len >= ZI_TAPE_HDR_SIZE && memcmp(r->map, k_tape_magic, sizeof(k_tape_magic)) == 0) {
+    // Unknown flag bits mean a layout this reader cannot decode.
+    const uint32_t flags = le_get_u32(r->map + 8);
+    r->compressed = (flags & ZI_TAPE_FLAG_COMPRESS) != 0;
+    ok = (flags & ~ZI_TAPE_FLAG_COMPRESS) == 0 && (reader_index_from_footer(r) || reader_index_by_scan(r));
+  } else {
+    ok = reader_index_v1(r);
+  }
+  if (!ok) {
+    zi_tape_reader_close(r);
     return NULL;
   }
-  r->f = f;
   return r;
 }
 
 void zi_tape_reader_close(zi_tape_reader_t* r) {
   if (!r) return;
-  if (r->f) fclose(r->f);
-  free(r->req);
-  free(r->resp);
+  if (r->map) munmap((void*)r->map, r->map_len);
+  free(r->blocks);
+  free(r->rec_off);
+  free(r->payload_rec);
+  free(r->slot[0].dbuf);
+  free(r->slot[1].dbuf);
   free(r);
 }
 
-static bool ensure_cap(uint8_t** buf, uint32_t* cap, uint32_t need) {
-  if (*cap >= need) return true;
-  uint32_t new_cap = *cap ? *cap : 256;
-  while (new_cap < need) new_cap *= 2;
-  uint8_t* nb = (uint8_t*)realloc(*buf, new_cap);
-  if (!nb) return false;
-  *buf = nb;
-  *cap = new_cap;
+uint32_t zi_tape_reader_count(const zi_tape_reader_t* r) {
+  return r ? r->rec_count : 0;
+}
+
+bool zi_tape_reader_seek(zi_tape_reader_t* r, uint32_t index) {
+  if (!r || index > r->rec_count) return false;
+  r->pos = index;
   return true;
 }
 
 bool zi_tape_reader_next(zi_tape_reader_t* r, const uint8_t** out_req, uint32_t* out_req_len, int32_t* out_rc,
                          const uint8_t** out_resp, uint32_t* out_resp_len) {
-  if (!r || !r->f || !out_req || !out_req_len || !out_rc || !out_resp || !out_resp_len) return false;
-
-  uint32_t req_len = 0;
-  if (!io_read_u32(r->f, &req_len)) return false;
-  if (!ensure_cap(&r->req, &r->req_cap, req_len)) return false;
-  if (req_len && fread(r->req, 1, req_len, r->f) != req_len) return false;
-
-  int32_t rc = 0;
-  if (!io_read_i32(r->f, &rc)) return false;
-
-  uint32_t resp_len = 0;
-  if (!io_read_u32(r->f, &resp_len)) return false;
-  if (!ensure_cap(&r->resp, &r->resp_cap, resp_len)) return false;
-  if (resp_len && fread(r->resp, 1, resp_len, r->f) != resp_len) return false;
-
-  *out_req = r->req;
-  *out_req_len = req_len;
-  *out_rc = rc;
-  *out_resp = r->resp;
-  *out_resp_len = resp_len;
+  if (!r || !out_req || !out_req_len || !out_rc || !out_resp || !out_resp_len) return false;
+  if (r->pos >= r->rec_count) return false;
+
+  zi_tape_rec_t rec;
+  if (!reader_get(r, r->pos, &rec)) return false;
+  r->pos++;
+
+  *out_req = rec.req;
+  *out_req_len = rec.req_len;
+  *out_rc = rec.rc;
+  *out_resp = rec.resp;
+  *out_resp_len = rec.resp_len;
   return true;
 }
 
@@ -3,14 +3,43 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+// zi_ctl tapes (record/replay).
+//
+// v2 layout (little-endian):
+//   header  "ZITAPE\0" 0x02, u32 flags (bit0: blocks may be compressed)
+//   blocks  u32 raw_len, u32 stored_len, u32 rec_count, bytes[stored_len]
+//           (stored_len < raw_len: LZ-compressed, only valid with flag bit0; otherwise raw)
+//   index   u32 block_count, {u64 file_off, u32 first_rec, u32 rec_count}[block_count],
+//           u32 rec_count, u32 off_in_block[rec_count],
+//           u32 payload_count, u32 defining_rec[payload_count]
+//   trailer u64 index_off, "ZIX2"
+//
+// A record is u32 req_len, req, i32 rc, then either u8 0 + u32 resp_len + resp (the
+// payload gets the next payload id) or u8 1 + u32 payload_id (repeat of an earlier
+// identical response). Records are buffered into blocks; the index is written on close.
+// Tapes whose index is missing (writer did not close) are recovered by scanning the
+// blocks, and v1 tapes (bare {u32 req_len, req, i32 rc, u32 resp_len, resp} records)
+// are still readable. Tapes with unknown flag bits are rejected.
+
 typedef struct zi_tape_writer zi_tape_writer_t;
 typedef struct zi_tape_reader zi_tape_reader_t;
 
+typedef struct zi_tape_writer_opts {
+  bool compress;  // LZ-compress blocks (kept raw when that does not help)
+} zi_tape_writer_opts_t;
+
 zi_tape_writer_t* zi_tape_writer_open(const char* path);
-void zi_tape_writer_close(zi_tape_writer_t* w);
+zi_tape_writer_t* zi_tape_writer_open_ex(const char* path, zi_tape_writer_opts_t opts);
+// Flushes the last block and writes the index. Returns false if any write failed.
+bool zi_tape_writer_close(zi_tape_writer_t* w);
+// Ends the current block early and pushes it to the file, so every record written so far
+// survives the process being killed (recovered by the block scan). Returns false on a write error.
+bool zi_tape_writer_flush(zi_tape_writer_t* w);
 bool zi_tape_writer_write(zi_tape_writer_t* w, const uint8_t* req, uint32_t req_len, int32_t rc, const uint8_t* resp,
                           uint32_t resp_len);
 
+// Maps the tape read-only; records are served from the mapping (raw blocks) or from
+// one decompressed block at a time.
 zi_tape_reader_t* zi_tape_reader_open(const char* path);
 void zi_tape_reader_close(zi_tape_reader_t* r);
 
@@ -19,6 +48,11 @@ void zi_tape_reader_close(zi_tape_reader_t* r);
 bool zi_tape_reader_next(zi_tape_reader_t* r, const uint8_t** out_req, uint32_t* out_req_len, int32_t* out_rc,
                          const uint8_t** out_resp, uint32_t* out_resp_len);
 
+// Random access: total record count, and repositioning so the next
+// zi_tape_reader_next returns record `index` (index == count positions at EOF).
+uint32_t zi_tape_reader_count(const zi_tape_reader_t* r);
+bool zi_tape_reader_seek(zi_tape_reader_t* r, uint32_t index);
+
 typedef int32_t (*sir_zi_ctl_fn)(void* user, const uint8_t* req, uint32_t req_len, uint8_t* resp, uint32_t resp_cap);
 
 typedef struct zi_ctl_record_ctx {
@@ -16,21 +16,61 @@
 #include <string.h>
 #include <unistd.h>
 
+void program_init(SirProgram* p, const SirccOptions* opt) {
+  memset(p, 0, sizeof(*p));
+  p->opt = opt;
+  p->exit_code = SIRCC_EXIT_ERROR;
+  arena_init(&p->arena);
+  sir_idmaps_init(p);
+}
+
+void program_free(SirProgram* p) {
+  stream_free(p);
+  free(p->srcs);
+  free(p->syms);
+  free(p->types);
+  free(p->nodes);
+  free(p->pending_features);
+  sir_nodes_free(p);
+  sir_names_free(p);
+  free(p->lowered_nodes);
+  sir_idmaps_free(p);
+  arena_free(&p->arena);
+}
+
+static bool link_exe(SirProgram* p, const SirccOptions* opt, const char* const* objs, size_t objs_len) {
+  bool ok = false;
+  if (opt->runtime == SIRCC_RUNTIME_ZABI25) {
+    ok = run_clang_link_zabi25(p, opt->clang_path, objs, objs_len, opt->output_path);
+  } else {
+    ok = run_clang_link(p, opt->clang_path, objs, objs_len, opt->output_path);
+  }
+  return ok && run_strip(p, opt->output_path);
+}
+
 int sircc_compile(const SirccOptions* opt) {
   if (!opt || !opt->input_path) return SIRCC_EXIT_USAGE;
   if (!opt->verify_only && !opt->lower_hl && !opt->output_path) return SIRCC_EXIT_USAGE;
 
-  SirProgram p = {0};
-  p.opt = opt;
-  p.exit_code = SIRCC_EXIT_ERROR;
-  arena_init(&p.arena);
-  sir_idmaps_init(&p);
+  SirProgram p;
+  program_init(&p, opt);
   char* owned_triple = NULL;
 
-  bool ok = parse_program(&p, opt, opt->input_path);
+  bool ok = cache_check_options(&p) && units_check_options(&p);
+  if (!ok) goto done;
+  ok = opt->stream ? stream_parse_program(&p) : parse_program(&p, opt, opt->input_path);
   if (!ok) goto done;
 
-  ok = validate_program(&p);
+  // --stream skips the node table (it is sized by node id); nodes decode on demand instead, and
+  // are validated a segment at a time as they are loaded again.
+  if ((!opt->stream && !sir_nodes_build(&p)) || !sir_names_build(&p)) {
+    bump_exit_code(&p, SIRCC_EXIT_INTERNAL);
+    err_codef(&p, "sircc.oom", "sircc: out of memory decoding nodes");
+    ok = false;
+    goto done;
+  }
+
+  ok = opt->stream ? validate_program_decls(&p) : validate_program(&p);
   if (!ok) goto done;
 
   const char* use_triple = opt->target_triple ? opt->target_triple : p.target_triple;
@@ -90,7 +130,7 @@ int sircc_compile(const SirccOptions* opt) {
   }
 
   if (opt->verify_only) {
-    ok = true;
+    ok = opt->stream ? stream_verify(&p) : units_verify(&p);
     goto done;
   }
 
@@ -99,6 +139,12 @@ int sircc_compile(const SirccOptions* opt) {
   if (p.feat_sem_v1) {
     ok = lower_hl_in_place(&p);
     if (!ok) goto done;
+    if (!sir_nodes_build(&p) || !sir_names_build(&p)) {
+      bump_exit_code(&p, SIRCC_EXIT_INTERNAL);
+      err_codef(&p, "sircc.oom", "sircc: out of memory decoding nodes");
+      ok = false;
+      goto done;
+    }
   }
 
   if (opt->emit == SIRCC_EMIT_ZASM_IR) {
@@ -141,6 +187,25 @@ int sircc_compile(const SirccOptions* opt) {
     use_triple = owned_triple;
   }
 
+  if (opt->stream) {
+    char** objs = NULL;
+    size_t objs_len = 0;
+    ok = stream_emit_objs(&p, use_triple, &objs, &objs_len);
+    if (ok) ok = link_exe(&p, opt, (const char* const*)objs, objs_len);
+    free_obj_paths(objs, objs_len);
+    goto done;
+  }
+
+  if (opt->cache_dir) {
+    char** objs = NULL;
+    size_t objs_len = 0;
+    ok = cache_emit_objs(&p, use_triple, &objs, &objs_len);
+    if (ok) ok = link_exe(&p, opt, (const char* const*)objs, objs_len);
+    for (size_t i = 0; i < objs_len; i++) free(objs[i]); // cache entries stay on disk
+    free(objs);
+    goto done;
+  }
+
   LLVMContextRef ctx = LLVMContextCreate();
   LLVMModuleRef mod = LLVMModuleCreateWithNameInContext("sir", ctx);
 
@@ -151,7 +216,7 @@ int sircc_compile(const SirccOptions* opt) {
     goto done;
   }
 
-  if (!lower_functions(&p, ctx, mod)) {
+  if (!lower_functions(&p, ctx, mod) || !units_link(&p, ctx, mod, use_triple)) {
     LLVMDisposeModule(mod);
     LLVMContextDispose(ctx);
     ok = false;
@@ -168,6 +233,39 @@ int sircc_compile(const SirccOptions* opt) {
     goto done;
   }
 
+  if (opt->emit == SIRCC_EMIT_LLVM_IR && opt->emit_llvm_pre_opt) {
+    ok = emit_module_ir(&p, mod, opt->output_path);
+    LLVMDisposeModule(mod);
+    LLVMContextDispose(ctx);
+    goto done;
+  }
+
+  // -j N (N > 1) opts into the partitioned pipeline (and, for executables, per-partition
+  // codegen); its output is the same for every such N. Without it, the whole module goes
+  // through optimize_module.
+  bool partitioned = false;
+  char** part_objs = NULL;
+  size_t part_objs_len = 0;
+  if (opt->jobs > 1) {
+    if (opt->emit == SIRCC_EMIT_EXE) {
+      ok = emit_module_objs_partitioned(&p, mod, use_triple, &part_objs, &part_objs_len, &partitioned);
+    } else {
+      ok = optimize_module_partitioned(&p, &ctx, &mod, &partitioned);
+    }
+    if (!ok) {
+      LLVMDisposeModule(mod);
+      LLVMContextDispose(ctx);
+      goto done;
+    }
+  }
+
+  if (!partitioned && !optimize_module(&p, mod, use_triple)) {
+    LLVMDisposeModule(mod);
+    LLVMContextDispose(ctx);
+    ok = false;
+    goto done;
+  }
+
   if (opt->emit == SIRCC_EMIT_LLVM_IR) {
     ok = emit_module_ir(&p, mod, opt->output_path);
     LLVMDisposeModule(mod);
@@ -183,39 +281,43 @@ int sircc_compile(const SirccOptions* opt) {
   }
 
   char tmp_obj[4096];
-  if (!make_tmp_obj(tmp_obj, sizeof(tmp_obj))) {
-    bump_exit_code(&p, SIRCC_EXIT_INTERNAL);
-    err_codef(&p, "sircc.tmp_obj.create_failed", "sircc: failed to create temporary object path");
+  const char* tmp_obj_path = tmp_obj;
+  const char* const* link_objs = &tmp_obj_path;
+  size_t link_objs_len = 1;
+  if (partitioned) {
     LLVMDisposeModule(mod);
     LLVMContextDispose(ctx);
-    ok = false;
-    goto done;
-  }
+    link_objs = (const char* const*)part_objs;
+    link_objs_len = part_objs_len;
+  } else {
+    if (!make_tmp_obj(tmp_obj, sizeof(tmp_obj))) {
+      bump_exit_code(&p, SIRCC_EXIT_INTERNAL);
+      err_codef(&p, "sircc.tmp_obj.create_failed", "sircc: failed to create temporary object path");
+      LLVMDisposeModule(mod);
+      LLVMContextDispose(ctx);
+      ok = false;
+      goto done;
+    }
 
-  ok = emit_module_obj(&p, mod, use_triple, tmp_obj);
-  LLVMDisposeModule(mod);
-  LLVMContextDispose(ctx);
-  if (!ok) {
-    unlink(tmp_obj);
-    goto done;
+    ok = emit_module_obj(&p, mod, use_triple, tmp_obj);
+    LLVMDisposeModule(mod);
+    LLVMContextDispose(ctx);
+    if (!ok) {
+      unlink(tmp_obj);
+      goto done;
+    }
   }
 
-  if (opt->runtime == SIRCC_RUNTIME_ZABI25) {
-    ok = run_clang_link_zabi25(&p, opt->clang_path, tmp_obj, opt->output_path);
+  ok = link_exe(&p, opt, link_objs, link_objs_len);
+  if (partitioned) {
+    free_obj_paths(part_objs, part_objs_len);
   } else {
-    ok = run_clang_link(&p, opt->clang_path, tmp_obj, opt->output_path);
+    unlink(tmp_obj);
   }
-  unlink(tmp_obj);
-  if (ok) ok = run_strip(&p, opt->output_path);
 
 done:
   if (owned_triple) LLVMDisposeMessage(owned_triple);
-  free(p.srcs);
-  free(p.syms);
-  free(p.types);
-  free(p.nodes);
-  free(p.pending_features);
-  sir_idmaps_free(&p);
-  arena_free(&p.arena);
-  return ok ? SIRCC_EXIT_OK : p.exit_code;
+  const int exit_code = p.exit_code;
+  program_free(&p);
+  return ok ? SIRCC_EXIT_OK : exit_code;
 }
@@ -13,6 +13,20 @@ typedef enum SirccEmitKind {
   SIRCC_EMIT_ZASM_IR,
 } SirccEmitKind;
 
+// Optimization level. DEFAULT keeps the historical pipeline (no IR passes, default
+// codegen); the explicit levels run LLVM's `default<ON>` new-PM pipeline before
+// emission (split into thinlto-pre-link/thinlto per partition under jobs > 1) and
+// pick a matching codegen level.
+typedef enum SirccOptLevel {
+  SIRCC_OPT_DEFAULT = 0,
+  SIRCC_OPT_O0,
+  SIRCC_OPT_O1,
+  SIRCC_OPT_O2,
+  SIRCC_OPT_O3,
+  SIRCC_OPT_OS,
+  SIRCC_OPT_OZ,
+} SirccOptLevel;
+
 typedef enum SirccExitCode {
   SIRCC_EXIT_OK = 0,
   SIRCC_EXIT_ERROR = 1,        // invalid input / validation / codegen / link failure
@@ -42,8 +56,15 @@ typedef struct SirccOptions {
   const char* const* prelude_paths; // optional; JSONL files parsed before input_path
   size_t prelude_paths_len;
   const char* input_path;
+  const char* const* extra_input_paths; // optional; further units compiled and linked with input_path
+  size_t extra_input_paths_len;
   const char* output_path;
   SirccEmitKind emit;
+  SirccOptLevel opt_level;
+  bool emit_llvm_pre_opt; // with --emit-llvm: write IR before the optimization pipeline
+  int jobs; // -j N: N > 1 runs -O partitioned on N threads (same output for every such N); 0/1: off
+  bool stream; // --stream: bounded-memory compile, one function's nodes at a time (see compiler_stream.c)
+  const char* cache_dir; // --cache-dir: reuse per-function-group objects across builds (see compiler_cache.c)
   const char* clang_path;
   const char* target_triple;
   SirccRuntimeKind runtime;
@@ -0,0 +1,518 @@
+// SPDX-FileCopyrightText: 2026 Frogfish
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "compiler_internal.h"
+#include "version.h"
+
+#include <llvm-c/Analysis.h>
+#include <llvm-c/Core.h>
+#include <llvm/Config/llvm-config.h>
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Incremental compile cache (--cache-dir DIR).
+//
+// Every fn gets a 128-bit content hash: the unit-wide inputs to codegen (compiler and LLVM
+// version, target, options, feature gates, all types and syms) followed by the fn's node graph,
+// walked from the fn node. Node ids are not hashed, only the order in which the walk first reaches
+// a node, so renumbering a unit does not invalidate it. Another fn reached from the graph (a
+// callee, or a fn named by a string such as fun.sym's) only contributes its signature, which is
+// all that lowering the caller reads from it.
+//
+// Fns are compiled in groups to bound the number of objects handed to the linker. Group
+// boundaries are content-defined (a fn whose hash is 0 modulo SIRCC_CACHE_GROUP_FNS, 16 by
+// default, ends a group; no group exceeds four times that), so editing one fn only changes the
+// key of the group holding it. Each group is an object DIR/<key>.o that is reused when present and
+// otherwise lowered on its own, with its callees declared, and written atomically. Local fns and
+// sym globals are promoted to hidden `<name>.sircc.cache` symbols so that objects can reference
+// each other, and every object that uses a global defines it as weak_odr.
+
+typedef struct CacheHash {
+  uint64_t a;
+  uint64_t b;
+} CacheHash;
+
+typedef struct CacheWalk {
+  uint32_t* seen;  // per node id: 1 + visit number within the current walk, 0 = not visited
+  int64_t* order;  // node ids visited since the last walk_reset, in visit order
+  size_t order_len;
+  size_t order_cap;
+  size_t base;     // first entry of the current walk in `order`
+  NodeRec** need;  // fns the walked graphs need declared
+  size_t need_len;
+  size_t need_cap;
+  uint8_t* needed; // per node id: already in `need`
+  bool oom;
+} CacheWalk;
+
+static void ch_init(CacheHash* h) {
+  h->a = 14695981039346656037ull;
+  h->b = 0x6a09e667f3bcc908ull;
+}
+
+static void ch_bytes(CacheHash* h, const void* data, size_t len) {
+  const unsigned char* s = (const unsigned char*)data;
+  uint64_t a = h->a;
+  uint64_t b = h->b;
+  for (size_t i = 0; i < len; i++) {
+    a = (a ^ s[i]) * 1099511628211ull;
+    b = (b + s[i] + 1) * 0x9e3779b97f4a7c15ull;
+    b ^= b >> 29;
+  }
+  h->a = a;
+  h->b = b;
+}
+
+static void ch_u64(CacheHash* h, uint64_t v) { ch_bytes(h, &v, sizeof(v)); }
+
+static void ch_str(CacheHash* h, const char* s) {
+  if (!s) {
+    ch_u64(h, UINT64_MAX);
+    return;
+  }
+  const size_t n = strlen(s);
+  ch_u64(h, n);
+  ch_bytes(h, s, n);
+}
+
+static bool cache_oom(SirProgram* p) {
+  bump_exit_code(p, SIRCC_EXIT_INTERNAL);
+  err_codef(p, "sircc.oom", "sircc: out of memory");
+  return false;
+}
+
+static bool is_fn(const NodeRec* n) { return n && strcmp(n->tag, "fn") == 0; }
+
+static void hash_fn_sig(CacheHash* h, const NodeRec* fn) {
+  ch_str(h, fn->fields ? json_get_string(json_obj_get_sym(fn->fields, JSON_KEY_NAME)) : NULL);
+  ch_str(h, fn->fields ? json_get_string(json_obj_get_sym(fn->fields, JSON_KEY_LINKAGE)) : NULL);
+  ch_u64(h, (uint64_t)fn->type_ref);
+}
+
+static void need_fn(CacheWalk* w, NodeRec* fn) {
+  if (w->needed[fn->id]) return;
+  if (w->need_len == w->need_cap) {
+    const size_t cap = w->need_cap ? w->need_cap * 2 : 64;
+    NodeRec** need = (NodeRec**)realloc(w->need, cap * sizeof(NodeRec*));
+    if (!need) {
+      w->oom = true;
+      return;
+    }
+    w->need = need;
+    w->need_cap = cap;
+  }
+  w->needed[fn->id] = 1;
+  w->need[w->need_len++] = fn;
+}
+
+// Returns the visit number of node `id` in the current walk, queueing it when it is new.
+static uint32_t visit(CacheWalk* w, int64_t id) {
+  if (w->seen[id]) return w->seen[id] - 1;
+  if (w->order_len == w->order_cap) {
+    const size_t cap = w->order_cap ? w->order_cap * 2 : 256;
+    int64_t* order = (int64_t*)realloc(w->order, cap * sizeof(int64_t));
+    if (!order) {
+      w->oom = true;
+      return 0;
+    }
+    w->order = order;
+    w->order_cap = cap;
+  }
+  w->order[w->order_len++] = id;
+  w->seen[id] = (uint32_t)(w->order_len - w->base);
+  return w->seen[id] - 1;
+}
+
+// JSON without following refs or names (decl.fn fields).
+static void hash_json_raw(CacheHash* h, const JsonValue* v) {
+  if (!v) {
+    ch_u64(h, 'n');
+    return;
+  }
+  switch (v->type) {
+    case JSON_NULL:
+      ch_u64(h, 'n');
+      break;
+    case JSON_BOOL:
+      ch_u64(h, 'b');
+      ch_u64(h, v->v.b ? 1u : 0u);
+      break;
+    case JSON_NUMBER:
+      ch_u64(h, 'i');
+      ch_u64(h, (uint64_t)v->v.i);
+      break;
+    case JSON_STRING:
+      ch_u64(h, 's');
+      ch_str(h, v->v.s);
+      break;
+    case JSON_ARRAY:
+      ch_u64(h, 'a');
+      ch_u64(h, v->v.arr.len);
+      for (size_t i = 0; i < v->v.arr.len; i++) hash_json_raw(h, v->v.arr.items[i]);
+      break;
+    case JSON_OBJECT:
+      ch_u64(h, 'o');
+      ch_u64(h, v->v.obj.len);
+      for (size_t i = 0; i < v->v.obj.len; i++) {
+        ch_str(h, v->v.obj.items[i].key);
+        hash_json_raw(h, v->v.obj.items[i].value);
+      }
+      break;
+  }
+}
+
+static void hash_json(SirProgram* p, CacheWalk* w, CacheHash* h, const JsonValue* v) {
+  if (!v || v->type != JSON_OBJECT) {
+    hash_json_raw(h, v);
+    if (v && v->type == JSON_STRING) {
+      // Any string may name a fn (fun.sym, ptr.sym, call.indirect through a name node, ...).
+      NodeRec* fn = find_fn_node_by_name(p, v->v.s);
+      if (fn) {
+        ch_u64(h, 'F');
+        hash_fn_sig(h, fn);
+        need_fn(w, fn);
+      }
+      NodeRec* decl = find_decl_fn_node_by_name(p, v->v.s);
+      if (decl) {
+        ch_u64(h, 'D');
+        ch_u64(h, (uint64_t)decl->type_ref);
+        hash_json_raw(h, decl->fields);
+      }
+    } else if (v && v->type == JSON_ARRAY) {
+      for (size_t i = 0; i < v->v.arr.len; i++) hash_json(p, w, h, v->v.arr.items[i]);
+    }
+    return;
+  }
+
+  int64_t id = 0;
+  if (sir_node_ref_quiet(p, v, &id)) {
+    NodeRec* n = (id >= 0 && (size_t)id < p->nodes_cap) ? p->nodes[id] : NULL;
+    if (!n) {
+      ch_u64(h, 'U');
+    } else if (is_fn(n) && !w->seen[id]) {
+      ch_u64(h, 'F');
+      hash_fn_sig(h, n);
+      need_fn(w, n);
+    } else {
+      ch_u64(h, 'r');
+      ch_u64(h, visit(w, id));
+    }
+    return;
+  }
+
+  ch_u64(h, 'o');
+  ch_u64(h, v->v.obj.len);
+  for (size_t i = 0; i < v->v.obj.len; i++) {
+    ch_str(h, v->v.obj.items[i].key);
+    hash_json(p, w, h, v->v.obj.items[i].value);
+  }
+}
+
+// Hashes every node queued since the walk began.
+static void hash_queued(SirProgram* p, CacheWalk* w, CacheHash* h) {
+  for (size_t i = w->base; i < w->order_len && !w->oom; i++) {
+    const NodeRec* n = p->nodes[w->order[i]];
+    ch_str(h, n->tag);
+    ch_u64(h, (uint64_t)n->type_ref);
+    hash_json(p, w, h, n->fields);
+  }
+}
+
+// Ends the current walk; its nodes stay in `order` until walk_reset.
+static void walk_end(CacheWalk* w) {
+  for (size_t i = w->base; i < w->order_len; i++) w->seen[w->order[i]] = 0;
+  w->base = w->order_len;
+}
+
+// Forgets the needed fns and all but the first `keep` visited nodes.
+static void walk_reset(CacheWalk* w, size_t keep) {
+  for (size_t i = 0; i < w->need_len; i++) w->needed[w->need[i]->id] = 0;
+  w->need_len = 0;
+  w->order_len = keep;
+  w->base = keep;
+}
+
+static void hash_fn(SirProgram* p, CacheWalk* w, const CacheHash* unit, NodeRec* fn, CacheHash* out) {
+  *out = *unit;
+  (void)visit(w, fn->id);
+  need_fn(w, fn);
+  hash_queued(p, w, out);
+  walk_end(w);
+}
+
+static void hash_unit(SirProgram* p, CacheWalk* w, const char* triple, CacheHash* h) {
+  ch_init(h);
+  ch_str(h, "sircc-cache-v1");
+  ch_str(h, SIRCC_VERSION);
+  ch_str(h, LLVM_VERSION_STRING);
+
+  ch_str(h, triple);
+  ch_str(h, p->target_cpu);
+  ch_str(h, p->target_features);
+  const unsigned layout[] = {p->ptr_bytes, p->ptr_bits,  p->target_big_endian, p->align_i8,  p->align_i16, p->align_i32,
+                             p->align_i64, p->align_f32, p->align_f64,         p->align_ptr};
+  for (size_t i = 0; i < sizeof(layout) / sizeof(layout[0]); i++) ch_u64(h, layout[i]);
+  ch_str(h, p->struct_align);
+
+  const SirccOptions* opt = p->opt;
+  ch_u64(h, (uint64_t)opt->opt_level);
+  ch_u64(h, (uint64_t)opt->runtime);
+  ch_u64(h, opt->verify_strict ? 1u : 0u);
+  const bool feats[] = {p->feat_atomics_v1, p->feat_simd_v1, p->feat_adt_v1, p->feat_fun_v1, p->feat_closure_v1,
+                        p->feat_coro_v1,    p->feat_eh_v1,   p->feat_gc_v1,  p->feat_sem_v1, p->feat_data_v1};
+  for (size_t i = 0; i < sizeof(feats) / sizeof(feats[0]); i++) ch_u64(h, feats[i] ? 1u : 0u);
+  ch_str(h, p->unit_name);
+
+  for (size_t i = 0; i < p->types_cap; i++) {
+    const TypeRec* t = p->types[i];
+    if (!t) continue;
+    ch_u64(h, i);
+    ch_str(h, sir_id_str_for_internal(p, SIR_ID_TYPE, (int64_t)i));
+    ch_u64(h, (uint64_t)t->kind);
+    ch_str(h, t->name);
+    ch_str(h, t->prim);
+    ch_u64(h, (uint64_t)t->of);
+    ch_u64(h, (uint64_t)t->len);
+    ch_u64(h, t->param_len);
+    for (size_t j = 0; j < t->param_len; j++) ch_u64(h, (uint64_t)t->params[j]);
+    ch_u64(h, (uint64_t)t->ret);
+    ch_u64(h, t->varargs ? 1u : 0u);
+    ch_u64(h, t->field_len);
+    for (size_t j = 0; j < t->field_len; j++) {
+      ch_str(h, t->fields[j].name);
+      ch_u64(h, (uint64_t)t->fields[j].type_ref);
+    }
+    ch_u64(h, (uint64_t)t->lane_ty);
+    ch_u64(h, (uint64_t)t->lanes);
+    ch_u64(h, (uint64_t)t->sig);
+    ch_u64(h, (uint64_t)t->call_sig);
+    ch_u64(h, (uint64_t)t->env_ty);
+    ch_u64(h, t->variant_len);
+    for (size_t j = 0; j < t->variant_len; j++) {
+      ch_str(h, t->variants[j].name);
+      ch_u64(h, (uint64_t)t->variants[j].ty);
+    }
+  }
+
+  // Sym initializers may refer to const nodes; those stay listed in `order` (see cache_emit_objs).
+  for (size_t i = 0; i < p->syms_cap; i++) {
+    const SymRec* s = p->syms[i];
+    if (!s) continue;
+    ch_u64(h, i);
+    ch_str(h, sir_id_str_for_internal(p, SIR_ID_SYM, (int64_t)i));
+    ch_str(h, s->name);
+    ch_str(h, s->kind);
+    ch_str(h, s->linkage);
+    ch_u64(h, (uint64_t)s->type_ref);
+    hash_json(p, w, h, s->value);
+    hash_queued(p, w, h);
+    walk_end(w);
+  }
+}
+
+static bool promote(LLVMValueRef v) {
+  static const char sfx[] = ".sircc.cache";
+  size_t n = 0;
+  const char* nm = LLVMGetValueName2(v, &n);
+  char* name = (char*)malloc(n + sizeof(sfx));
+  if (!name) return false;
+  memcpy(name, nm, n);
+  memcpy(name + n, sfx, sizeof(sfx));
+  LLVMSetValueName2(v, name, n + sizeof(sfx) - 1);
+  free(name);
+  LLVMSetLinkage(v, LLVMExternalLinkage);
+  LLVMSetVisibility(v, LLVMHiddenVisibility);
+  return true;
+}
+
+// Links a group's module up with the other groups' objects, whichever run wrote them.
+static bool finish_module(SirProgram* p, LLVMModuleRef mod) {
+  for (LLVMValueRef fn = LLVMGetFirstFunction(mod); fn; fn = LLVMGetNextFunction(fn)) {
+    if (LLVMGetLinkage(fn) == LLVMInternalLinkage && !promote(fn)) return cache_oom(p);
+    if (LLVMCountBasicBlocks(fn) == 0) LLVMSetLinkage(fn, LLVMExternalLinkage); // defined by another group
+  }
+  for (size_t i = 0; i < p->syms_cap; i++) {
+    const SymRec* sym = p->syms[i];
+    if (!sym || !sym->name) continue;
+    LLVMValueRef g = LLVMGetNamedGlobal(mod, sym->name);
+    if (!g || !LLVMGetInitializer(g)) continue;
+    if (LLVMGetLinkage(g) == LLVMInternalLinkage && !promote(g)) return cache_oom(p);
+    LLVMSetLinkage(g, LLVMWeakODRLinkage);
+  }
+  return true;
+}
+
+static bool build_group(SirProgram* p, CacheWalk* w, LLVMContextRef ctx, const char* triple, NodeRec** fns, size_t len,
+                        const char* path) {
+  // Re-walk the members for the fns they need declared; lowering reads nothing else from them.
+  const size_t sym_nodes = w->order_len;
+  for (size_t i = 0; i < len; i++) {
+    CacheHash scratch;
+    ch_init(&scratch);
+    hash_fn(p, w, &scratch, fns[i], &scratch);
+  }
+  if (w->oom) return cache_oom(p);
+
+  LLVMModuleRef mod = LLVMModuleCreateWithNameInContext("sir", ctx);
+  bool ok = init_target_for_module(p, mod, triple);
+  for (size_t i = 0; ok && i < w->need_len; i++) ok = lower_fn_proto(p, ctx, mod, w->need[i]);
+  for (size_t i = 0; ok && i < len; i++) ok = lower_fn_streamed(p, ctx, mod, fns[i]);
+  ok = ok && finish_module(p, mod);
+
+  char* verr = NULL;
+  if (ok && LLVMVerifyModule(mod, LLVMReturnStatusAction, &verr) != 0) {
+    err_codef(p, "sircc.llvm.verify_failed", "sircc: LLVM verification failed: %s", verr ? verr : "(unknown)");
+    ok = false;
+  }
+  LLVMDisposeMessage(verr);
+  ok = ok && optimize_module(p, mod, triple);
+
+  char tmp[4096];
+  if (ok && snprintf(tmp, sizeof(tmp), "%s.tmp.%ld", path, (long)getpid()) >= (int)sizeof(tmp)) {
+    err_codef(p, "sircc.cache.path_too_long", "sircc: cache path too long: %s", path);
+    ok = false;
+  }
+  if (ok) {
+    ok = emit_module_obj(p, mod, triple, tmp);
+    if (ok && rename(tmp, path) != 0) {
+      err_codef(p, "sircc.cache.write_failed", "sircc: failed to write cache object %s: %s", path, strerror(errno));
+      ok = false;
+    }
+    if (!ok) remove(tmp);
+  }
+  LLVMDisposeModule(mod);
+
+  // Protos and constants are module-bound; drop what this group cached on its nodes.
+  for (size_t i = 0; i < w->order_len; i++) {
+    NodeRec* n = p->nodes[w->order[i]];
+    n->llvm_value = NULL;
+    n->resolving = false;
+  }
+  for (size_t i = 0; i < w->need_len; i++) w->need[i]->llvm_value = NULL;
+  walk_reset(w, sym_nodes);
+  return ok;
+}
+
+static bool push_obj(SirProgram* p, char*** objs, size_t* len, size_t* cap, const char* path) {
+  if (*len == *cap) {
+    const size_t ncap = *cap ? *cap * 2 : 16;
+    char** grown = (char**)realloc(*objs, ncap * sizeof(char*));
+    if (!grown) return cache_oom(p);
+    *objs = grown;
+    *cap = ncap;
+  }
+  char* s = strdup(path);
+  if (!s) return cache_oom(p);
+  (*objs)[(*len)++] = s;
+  return true;
+}
+
+bool cache_check_options(SirProgram* p) {
+  const SirccOptions* opt = p->opt;
+  if (!opt->cache_dir || opt->verify_only || opt->lower_hl) return true;
+  const char* what = NULL;
+  if (opt->stream) what = "--stream";
+  else if (opt->jobs > 1) what = "-j";
+  else if (opt->emit != SIRCC_EMIT_EXE) what = "--emit-llvm/--emit-obj/--emit-zasm (it links an executable)";
+  if (!what) return true;
+  err_codef(p, "sircc.cache.unsupported", "sircc: --cache-dir does not support %s", what);
+  return false;
+}
+
+bool cache_emit_objs(SirProgram* p, const char* triple, char*** out_paths, size_t* out_len) {
+  const char* dir = p->opt->cache_dir;
+  *out_paths = NULL;
+  *out_len = 0;
+  if (mkdir(dir, 0777) != 0 && errno != EEXIST) {
+    err_codef(p, "sircc.cache.dir_failed", "sircc: failed to create cache dir %s: %s", dir, strerror(errno));
+    return false;
+  }
+
+  uint64_t target = 16;
+  uint64_t env_target = 0;
+  if (parse_env_u64("SIRCC_CACHE_GROUP_FNS", &env_target) && env_target) target = env_target;
+
+  CacheWalk w = {0};
+  w.seen = (uint32_t*)calloc(p->nodes_cap ? p->nodes_cap : 1, sizeof(uint32_t));
+  w.needed = (uint8_t*)calloc(p->nodes_cap ? p->nodes_cap : 1, 1);
+  NodeRec** fns = (NodeRec**)malloc((p->nodes_cap ? p->nodes_cap : 1) * sizeof(NodeRec*));
+  CacheHash* hashes = (CacheHash*)malloc((p->nodes_cap ? p->nodes_cap : 1) * sizeof(CacheHash));
+  char** objs = NULL;
+  size_t objs_len = 0;
+  size_t objs_cap = 0;
+  size_t reused = 0;
+  bool ok = w.seen && w.needed && fns && hashes;
+  if (!ok) cache_oom(p);
+
+  CacheHash unit;
+  size_t fns_len = 0;
+  if (ok) {
+    hash_unit(p, &w, triple, &unit);
+    const size_t sym_nodes = w.order_len;
+    walk_reset(&w, sym_nodes);
+    for (size_t i = 0; i < p->nodes_cap; i++) {
+      if (!is_fn(p->nodes[i])) continue;
+      fns[fns_len] = p->nodes[i];
+      hash_fn(p, &w, &unit, fns[fns_len], &hashes[fns_len]);
+      walk_reset(&w, sym_nodes);
+      fns_len++;
+    }
+    if (w.oom) ok = cache_oom(p);
+  }
+
+  // A unit without fns still gets one (empty) group for its globals.
+  LLVMContextRef ctx = ok ? LLVMContextCreate() : NULL;
+  for (size_t start = 0; ok && (start < fns_len || objs_len == 0);) {
+    size_t end = start;
+    while (end < fns_len) {
+      end++;
+      if (hashes[end - 1].a % target == 0 || end - start >= target * 4) break;
+    }
+
+    CacheHash key = unit;
+    ch_u64(&key, end - start);
+    for (size_t i = start; i < end; i++) {
+      ch_u64(&key, hashes[i].a);
+      ch_u64(&key, hashes[i].b);
+    }
+    char path[4096];
+    if (snprintf(path, sizeof(path), "%s/%016llx%016llx.o", dir, (unsigned long long)key.a, (unsigned long long)key.b) >=
+        (int)sizeof(path)) {
+      err_codef(p, "sircc.cache.path_too_long", "sircc: cache path too long: %s", dir);
+      ok = false;
+      break;
+    }
+    if (access(path, R_OK) == 0) {
+      reused++;
+    } else {
+      ok = build_group(p, &w, ctx, triple, fns + start, end - start, path);
+    }
+    ok = ok && push_obj(p, &objs, &objs_len, &objs_cap, path);
+    start = end;
+  }
+  if (ctx) LLVMContextDispose(ctx);
+
+  if (ok && p->opt->verbose) fprintf(stderr, "sircc: cache: reused %zu of %zu objects\n", reused, objs_len);
+
+  free(w.seen);
+  free(w.needed);
+  free(w.order);
+  free(w.need);
+  free(fns);
+  free(hashes);
+  if (!ok) {
+    for (size_t i = 0; i < objs_len; i++) free(objs[i]);
+    free(objs);
+    return false;
+  }
+  *out_paths = objs;
+  *out_len = objs_len;
+  return true;
+}
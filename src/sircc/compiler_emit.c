@@ -4,15 +4,17 @@
 #include "compiler_internal.h"
 
 #include <llvm-c/Analysis.h>
+#include <llvm-c/Error.h>
 #include <llvm-c/Target.h>
 #include <llvm-c/TargetMachine.h>
+#include <llvm-c/Transforms/PassBuilder.h>
 
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-static void llvm_init_targets_once(void) {
+void llvm_init_targets_once(void) {
   static int inited = 0;
   if (inited) return;
   // Avoid forcing linkage against every LLVM target backend. For the
@@ -253,6 +255,102 @@ align_mismatch2:
   return false;
 }
 
+LLVMCodeGenOptLevel codegen_level(const SirProgram* p) {
+  switch (p && p->opt ? p->opt->opt_level : SIRCC_OPT_DEFAULT) {
+    case SIRCC_OPT_O0:
+      return LLVMCodeGenLevelNone;
+    case SIRCC_OPT_O1:
+      return LLVMCodeGenLevelLess;
+    case SIRCC_OPT_O3:
+      return LLVMCodeGenLevelAggressive;
+    default:
+      return LLVMCodeGenLevelDefault;
+  }
+}
+
+const char* pipeline_for_level(SirccOptLevel level) {
+  switch (level) {
+    case SIRCC_OPT_O0:
+      return "default<O0>";
+    case SIRCC_OPT_O1:
+      return "default<O1>";
+    case SIRCC_OPT_O2:
+      return "default<O2>";
+    case SIRCC_OPT_O3:
+      return "default<O3>";
+    case SIRCC_OPT_OS:
+      return "default<Os>";
+    case SIRCC_OPT_OZ:
+      return "default<Oz>";
+    default:
+      return NULL;
+  }
+}
+
+const char* split_pipeline_for_level(SirccOptLevel level, bool pre_link) {
+  switch (level) {
+    case SIRCC_OPT_O0:
+      return pre_link ? "thinlto-pre-link<O0>" : "thinlto<O0>";
+    case SIRCC_OPT_O1:
+      return pre_link ? "thinlto-pre-link<O1>" : "thinlto<O1>";
+    case SIRCC_OPT_O2:
+      return pre_link ? "thinlto-pre-link<O2>" : "thinlto<O2>";
+    case SIRCC_OPT_O3:
+      return pre_link ? "thinlto-pre-link<O3>" : "thinlto<O3>";
+    case SIRCC_OPT_OS:
+      return pre_link ? "thinlto-pre-link<Os>" : "thinlto<Os>";
+    case SIRCC_OPT_OZ:
+      return pre_link ? "thinlto-pre-link<Oz>" : "thinlto<Oz>";
+    default:
+      return NULL;
+  }
+}
+
+bool optimize_module(SirProgram* p, LLVMModuleRef mod, const char* triple) {
+  return run_module_pipeline(p, mod, triple, pipeline_for_level(p && p->opt ? p->opt->opt_level : SIRCC_OPT_DEFAULT));
+}
+
+bool run_module_pipeline(SirProgram* p, LLVMModuleRef mod, const char* triple, const char* pipeline) {
+  if (!pipeline) return true;
+
+  llvm_init_targets_once();
+
+  char* err = NULL;
+  const char* use_triple = triple ? triple : LLVMGetDefaultTargetTriple();
+  LLVMTargetRef target = NULL;
+  if (LLVMGetTargetFromTriple(use_triple, &target, &err) != 0) {
+    err_codef(p, "sircc.llvm.triple.unsupported", "sircc: target triple '%s' unsupported: %s", use_triple, err ? err : "(unknown)");
+    LLVMDisposeMessage(err);
+    if (!triple) LLVMDisposeMessage((char*)use_triple);
+    return false;
+  }
+
+  // The target machine gives the pipeline target-aware cost models (TTI); the module
+  // already carries the triple and data layout from init_target_for_module.
+  const char* cpu = (p && p->target_cpu && *p->target_cpu) ? p->target_cpu : "generic";
+  const char* features = (p && p->target_features && *p->target_features) ? p->target_features : "";
+  LLVMTargetMachineRef tm =
+      LLVMCreateTargetMachine(target, use_triple, cpu, features, codegen_level(p), LLVMRelocDefault, LLVMCodeModelDefault);
+  if (!tm) {
+    err_codef(p, "sircc.llvm.target_machine.create_failed", "sircc: failed to create target machine");
+    if (!triple) LLVMDisposeMessage((char*)use_triple);
+    return false;
+  }
+
+  LLVMPassBuilderOptionsRef pbo = LLVMCreatePassBuilderOptions();
+  LLVMErrorRef perr = LLVMRunPasses(mod, pipeline, tm, pbo);
+  LLVMDisposePassBuilderOptions(pbo);
+  LLVMDisposeTargetMachine(tm);
+  if (!triple) LLVMDisposeMessage((char*)use_triple);
+  if (perr) {
+    char* msg = LLVMGetErrorMessage(perr);
+    err_codef(p, "sircc.llvm.opt_failed", "sircc: LLVM optimization pipeline '%s' failed: %s", pipeline, msg ? msg : "(unknown)");
+    LLVMDisposeErrorMessage(msg);
+    return false;
+  }
+  return true;
+}
+
 bool emit_module_obj(SirProgram* p, LLVMModuleRef mod, const char* triple, const char* out_path) {
   llvm_init_targets_once();
 
@@ -269,7 +367,7 @@ bool emit_module_obj(SirProgram* p, LLVMModuleRef mod, const char* triple, const
   const char* cpu = (p && p->target_cpu && *p->target_cpu) ? p->target_cpu : "generic";
   const char* features = (p && p->target_features && *p->target_features) ? p->target_features : "";
   LLVMTargetMachineRef tm =
-      LLVMCreateTargetMachine(target, use_triple, cpu, features, LLVMCodeGenLevelDefault, LLVMRelocDefault, LLVMCodeModelDefault);
+      LLVMCreateTargetMachine(target, use_triple, cpu, features, codegen_level(p), LLVMRelocDefault, LLVMCodeModelDefault);
   if (!tm) {
     err_codef(p, "sircc.llvm.target_machine.create_failed", "sircc: failed to create target machine");
     if (!triple) LLVMDisposeMessage((char*)use_triple);
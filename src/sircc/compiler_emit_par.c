@@ -0,0 +1,597 @@
+// SPDX-FileCopyrightText: 2026 Frogfish
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "compiler_internal.h"
+
+#include <llvm-c/Analysis.h>
+#include <llvm-c/BitReader.h>
+#include <llvm-c/BitWriter.h>
+#include <llvm-c/Error.h>
+#include <llvm-c/Linker.h>
+#include <llvm-c/TargetMachine.h>
+#include <llvm-c/Transforms/PassBuilder.h>
+
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Partitioned pipeline (-j N with N > 1, at -O levels with IR passes).
+//
+// Lowering stays on one thread: it runs against the shared SirProgram node/type caches. The
+// optimization pipeline is split the way ThinLTO splits it: the whole-module half
+// (thinlto-pre-link: simplification, inlining and IPO over the complete call graph) also runs
+// on that thread, so no call loses inlining to a partition boundary. The module is then split
+// into partitions of whole functions: on that thread, each partition is cut from a clone of the
+// module and written to its own bitcode, so a worker parses only its partition into its own
+// LLVMContext. Workers run the per-partition half (thinlto: loop and vector optimizations)
+// and, for executables, code generation independently.
+//
+// Partitions are contiguous runs of defined functions balanced by instruction count; their
+// number depends only on the module, never on N, so the output is the same for every N > 1.
+// Local functions/globals are promoted to hidden external symbols (renamed to stay unique) so
+// partitions can reference each other; when partitions are linked back into one module the
+// original names and linkage are restored. Partition 0 owns every global variable definition.
+
+#define PAR_MAX_PARTS 16u
+
+typedef struct ParPromoted {
+  char* name; // name while promoted
+  char* orig_name;
+  LLVMLinkage linkage;
+  LLVMVisibility visibility;
+} ParPromoted;
+
+typedef struct ParPlan {
+  size_t parts;
+  int32_t* fn_part; // per function in module order; -1 for declarations
+  size_t fn_len;
+  ParPromoted* promoted;
+  size_t promoted_len;
+  LLVMMemoryBufferRef* part_bitcode; // len=parts; NULL until plan_split
+} ParPlan;
+
+typedef struct ParJob {
+  const ParPlan* plan;
+  const SirProgram* p; // read-only from workers (opt, target_cpu, target_features)
+  size_t part;
+  bool emit_obj;
+  LLVMMemoryBufferRef out; // object file, or optimized bitcode when !emit_obj
+  const char* err_code;
+  char* err; // malloc'd
+} ParJob;
+
+typedef struct ParPool {
+  ParJob* jobs;
+  size_t len;
+  size_t next;
+  pthread_mutex_t mu;
+} ParPool;
+
+static char* dup_n(const char* s, size_t n) {
+  char* out = (char*)malloc(n + 1);
+  if (!out) return NULL;
+  if (n) memcpy(out, s, n);
+  out[n] = 0;
+  return out;
+}
+
+static bool is_llvm_reserved(LLVMValueRef v) {
+  size_t n = 0;
+  const char* nm = LLVMGetValueName2(v, &n);
+  return nm && n >= 5 && memcmp(nm, "llvm.", 5) == 0;
+}
+
+static bool is_local_linkage(LLVMLinkage l) { return l == LLVMInternalLinkage || l == LLVMPrivateLinkage; }
+
+static size_t fn_weight(LLVMValueRef fn) {
+  size_t n = 0;
+  for (LLVMBasicBlockRef bb = LLVMGetFirstBasicBlock(fn); bb; bb = LLVMGetNextBasicBlock(bb)) {
+    for (LLVMValueRef in = LLVMGetFirstInstruction(bb); in; in = LLVMGetNextInstruction(in)) n++;
+  }
+  return n;
+}
+
+static void plan_free(ParPlan* plan) {
+  free(plan->fn_part);
+  for (size_t i = 0; i < plan->promoted_len; i++) {
+    free(plan->promoted[i].name);
+    free(plan->promoted[i].orig_name);
+  }
+  free(plan->promoted);
+  if (plan->part_bitcode) {
+    for (size_t i = 0; i < plan->parts; i++) {
+      if (plan->part_bitcode[i]) LLVMDisposeMemoryBuffer(plan->part_bitcode[i]);
+    }
+    free(plan->part_bitcode);
+  }
+  memset(plan, 0, sizeof(*plan));
+}
+
+static bool plan_promote(ParPlan* plan, LLVMValueRef v, size_t ordinal) {
+  if (!is_local_linkage(LLVMGetLinkage(v)) || is_llvm_reserved(v)) return true;
+  ParPromoted* pr = &plan->promoted[plan->promoted_len];
+  size_t n = 0;
+  const char* nm = LLVMGetValueName2(v, &n);
+  pr->orig_name = dup_n(nm ? nm : "", nm ? n : 0);
+  if (!pr->orig_name) return false;
+  pr->linkage = LLVMGetLinkage(v);
+  pr->visibility = LLVMGetVisibility(v);
+
+  char buf[512];
+  int len = (nm && n) ? snprintf(buf, sizeof(buf), "%.*s.sircc.part", (int)(n > 400 ? 400 : n), nm)
+                      : snprintf(buf, sizeof(buf), "sircc.part.anon.%zu", ordinal);
+  LLVMSetValueName2(v, buf, (size_t)len);
+  LLVMSetLinkage(v, LLVMExternalLinkage);
+  LLVMSetVisibility(v, LLVMHiddenVisibility);
+
+  // LLVM uniquifies clashing names; remember what it actually picked.
+  nm = LLVMGetValueName2(v, &n);
+  pr->name = dup_n(nm, n);
+  if (!pr->name) {
+    free(pr->orig_name);
+    return false;
+  }
+  plan->promoted_len++;
+  return true;
+}
+
+// True when the module has enough defined functions to be worth splitting.
+static bool par_can_split(LLVMModuleRef mod) {
+  if (LLVMGetFirstGlobalAlias(mod) || LLVMGetFirstGlobalIFunc(mod)) return false;
+  size_t defined = 0;
+  for (LLVMValueRef fn = LLVMGetFirstFunction(mod); fn && defined < 2; fn = LLVMGetNextFunction(fn)) {
+    if (LLVMCountBasicBlocks(fn)) defined++;
+  }
+  return defined >= 2;
+}
+
+// Returns false on OOM; a plan without promoted symbols or fn_part (modules with
+// aliases/ifuncs) means "do not split".
+static bool plan_build(LLVMModuleRef mod, ParPlan* plan) {
+  memset(plan, 0, sizeof(*plan));
+  plan->parts = 1;
+  if (LLVMGetFirstGlobalAlias(mod) || LLVMGetFirstGlobalIFunc(mod)) return true;
+
+  size_t fns = 0, defined = 0, globals = 0;
+  for (LLVMValueRef fn = LLVMGetFirstFunction(mod); fn; fn = LLVMGetNextFunction(fn)) {
+    fns++;
+    if (LLVMCountBasicBlocks(fn)) defined++;
+  }
+  for (LLVMValueRef g = LLVMGetFirstGlobal(mod); g; g = LLVMGetNextGlobal(g)) globals++;
+  // Inlining may leave a single defined function; it still goes through one partition.
+  const size_t parts = defined < 1 ? 1 : defined < PAR_MAX_PARTS ? defined : PAR_MAX_PARTS;
+
+  plan->fn_part = (int32_t*)calloc(fns, sizeof(int32_t));
+  size_t* weights = (size_t*)calloc(fns, sizeof(size_t));
+  plan->promoted = (ParPromoted*)calloc(fns + globals, sizeof(ParPromoted));
+  if (!plan->fn_part || !weights || !plan->promoted) {
+    free(weights);
+    plan_free(plan);
+    return false;
+  }
+  plan->fn_len = fns;
+
+  uint64_t total = 0;
+  size_t i = 0;
+  for (LLVMValueRef fn = LLVMGetFirstFunction(mod); fn; fn = LLVMGetNextFunction(fn), i++) {
+    weights[i] = LLVMCountBasicBlocks(fn) ? fn_weight(fn) : 0;
+    total += weights[i];
+  }
+
+  // Partition k takes functions until its running weight reaches (k+1)/parts of the total,
+  // leaving at least one function for each later partition.
+  uint64_t acc = 0;
+  size_t part = 0, seen = 0;
+  i = 0;
+  for (LLVMValueRef fn = LLVMGetFirstFunction(mod); fn; fn = LLVMGetNextFunction(fn), i++) {
+    if (!weights[i]) {
+      plan->fn_part[i] = -1;
+      continue;
+    }
+    plan->fn_part[i] = (int32_t)part;
+    acc += weights[i];
+    seen++;
+    const bool full = acc * parts >= total * (part + 1);
+    const bool must_advance = defined - seen <= parts - part - 1;
+    if (part + 1 < parts && (full || must_advance)) part++;
+  }
+  free(weights);
+  plan->parts = part + 1;
+
+  i = 0;
+  for (LLVMValueRef fn = LLVMGetFirstFunction(mod); fn; fn = LLVMGetNextFunction(fn), i++) {
+    if (!plan_promote(plan, fn, i)) goto oom;
+  }
+  for (LLVMValueRef g = LLVMGetFirstGlobal(mod); g; g = LLVMGetNextGlobal(g), i++) {
+    if (!plan_promote(plan, g, i)) goto oom;
+  }
+  return true;
+
+oom:
+  plan_free(plan);
+  return false;
+}
+
+static void job_fail(ParJob* job, const char* code, const char* fmt, ...) {
+  if (job->err) return;
+  char buf[1024];
+  va_list ap;
+  va_start(ap, fmt);
+  vsnprintf(buf, sizeof(buf), fmt, ap);
+  va_end(ap);
+  job->err_code = code;
+  job->err = dup_n(buf, strlen(buf));
+}
+
+static void drop_body(LLVMValueRef fn) {
+  // Cut every use first so blocks and instructions can be erased in any order.
+  for (LLVMBasicBlockRef bb = LLVMGetFirstBasicBlock(fn); bb; bb = LLVMGetNextBasicBlock(bb)) {
+    for (LLVMValueRef in = LLVMGetFirstInstruction(bb); in; in = LLVMGetNextInstruction(in)) {
+      LLVMTypeRef ty = LLVMTypeOf(in);
+      if (LLVMGetTypeKind(ty) != LLVMVoidTypeKind) LLVMReplaceAllUsesWith(in, LLVMGetUndef(ty));
+    }
+  }
+  for (LLVMBasicBlockRef bb = LLVMGetFirstBasicBlock(fn); bb; bb = LLVMGetNextBasicBlock(bb)) {
+    LLVMValueRef in;
+    while ((in = LLVMGetFirstInstruction(bb))) LLVMInstructionEraseFromParent(in);
+  }
+  LLVMBasicBlockRef bb;
+  while ((bb = LLVMGetFirstBasicBlock(fn))) LLVMDeleteBasicBlock(bb);
+  LLVMSetLinkage(fn, LLVMExternalLinkage);
+}
+
+bool declare_global(LLVMModuleRef m, LLVMValueRef g) {
+  size_t n = 0;
+  const char* nm = LLVMGetValueName2(g, &n);
+  char* name = dup_n(nm ? nm : "", nm ? n : 0);
+  if (!name) return false;
+  LLVMValueRef d = LLVMAddGlobalInAddressSpace(m, LLVMGlobalGetValueType(g), "", LLVMGetPointerAddressSpace(LLVMTypeOf(g)));
+  LLVMSetLinkage(d, LLVMExternalLinkage);
+  LLVMSetVisibility(d, LLVMGetVisibility(g));
+  LLVMSetThreadLocalMode(d, LLVMGetThreadLocalMode(g));
+  LLVMSetGlobalConstant(d, LLVMIsGlobalConstant(g));
+  LLVMSetAlignment(d, LLVMGetAlignment(g));
+  LLVMReplaceAllUsesWith(g, d);
+  LLVMSetValueName2(g, "", 0);
+  LLVMSetValueName2(d, name, n);
+  LLVMDeleteGlobal(g);
+  free(name);
+  return true;
+}
+
+// Reduces a full copy of the module to the definitions owned by `part`. Returns NULL, or
+// the error code on failure.
+static const char* strip_to_part(const ParPlan* plan, size_t part, LLVMModuleRef m) {
+  size_t i = 0;
+  for (LLVMValueRef fn = LLVMGetFirstFunction(m); fn; fn = LLVMGetNextFunction(fn), i++) {
+    const bool defined = LLVMCountBasicBlocks(fn) != 0;
+    if (i >= plan->fn_len || defined != (plan->fn_part[i] >= 0)) return "sircc.par.split_failed";
+    if (defined && (size_t)plan->fn_part[i] != part) drop_body(fn);
+  }
+  if (part == 0) return NULL;
+
+  LLVMValueRef g = LLVMGetFirstGlobal(m);
+  while (g) {
+    LLVMValueRef next = LLVMGetNextGlobal(g);
+    if (is_llvm_reserved(g)) {
+      LLVMDeleteGlobal(g); // llvm.used, llvm.global_ctors, ...: kept by partition 0 only
+    } else if (LLVMGetInitializer(g)) {
+      if (!declare_global(m, g)) return "sircc.oom";
+    }
+    g = next;
+  }
+  return NULL;
+}
+
+static bool oom(SirProgram* p) {
+  bump_exit_code(p, SIRCC_EXIT_INTERNAL);
+  err_codef(p, "sircc.oom", "sircc: out of memory partitioning module");
+  return false;
+}
+
+// Writes each partition's bitcode, cut one at a time from a clone of `mod`, so workers never
+// parse (or hold) the whole module.
+static bool plan_split(SirProgram* p, LLVMModuleRef mod, ParPlan* plan) {
+  plan->part_bitcode = (LLVMMemoryBufferRef*)calloc(plan->parts, sizeof(LLVMMemoryBufferRef));
+  if (!plan->part_bitcode) return oom(p);
+  for (size_t k = 0; k < plan->parts; k++) {
+    LLVMModuleRef m = LLVMCloneModule(mod);
+    if (!m) return oom(p);
+    const char* code = strip_to_part(plan, k, m);
+    if (!code) {
+      plan->part_bitcode[k] = LLVMWriteBitcodeToMemoryBuffer(m);
+      if (!plan->part_bitcode[k]) code = "sircc.oom";
+    }
+    LLVMDisposeModule(m);
+    if (code && strcmp(code, "sircc.oom") == 0) return oom(p);
+    if (code) {
+      bump_exit_code(p, SIRCC_EXIT_INTERNAL);
+      err_codef(p, code, "sircc: partition %zu: function list does not match the partition plan", k);
+      return false;
+    }
+  }
+  return true;
+}
+
+static LLVMTargetMachineRef job_target_machine(ParJob* job, LLVMModuleRef m) {
+  const char* triple = LLVMGetTarget(m);
+  char* err = NULL;
+  LLVMTargetRef target = NULL;
+  if (LLVMGetTargetFromTriple(triple, &target, &err) != 0) {
+    job_fail(job, "sircc.llvm.triple.unsupported", "target triple '%s' unsupported: %s", triple, err ? err : "(unknown)");
+    LLVMDisposeMessage(err);
+    return NULL;
+  }
+  const SirProgram* p = job->p;
+  const char* cpu = (p->target_cpu && *p->target_cpu) ? p->target_cpu : "generic";
+  const char* features = (p->target_features && *p->target_features) ? p->target_features : "";
+  LLVMTargetMachineRef tm =
+      LLVMCreateTargetMachine(target, triple, cpu, features, codegen_level(p), LLVMRelocDefault, LLVMCodeModelDefault);
+  if (!tm) job_fail(job, "sircc.llvm.target_machine.create_failed", "failed to create target machine");
+  return tm;
+}
+
+static void run_job(ParJob* job) {
+  const LLVMMemoryBufferRef bc = job->plan->part_bitcode[job->part];
+  LLVMContextRef ctx = LLVMContextCreate();
+  LLVMMemoryBufferRef in = LLVMCreateMemoryBufferWithMemoryRange(LLVMGetBufferStart(bc), LLVMGetBufferSize(bc), "sir.bc", 0);
+  LLVMModuleRef m = NULL;
+  const bool parse_failed = LLVMParseBitcodeInContext2(ctx, in, &m) != 0;
+  LLVMDisposeMemoryBuffer(in);
+  if (parse_failed) {
+    job_fail(job, "sircc.par.split_failed", "failed to read the partition bitcode");
+    LLVMContextDispose(ctx);
+    return;
+  }
+
+  LLVMTargetMachineRef tm = job_target_machine(job, m);
+  if (!tm) goto out;
+
+  const char* pipeline = split_pipeline_for_level(job->p->opt ? job->p->opt->opt_level : SIRCC_OPT_DEFAULT, false);
+  if (pipeline) {
+    LLVMPassBuilderOptionsRef pbo = LLVMCreatePassBuilderOptions();
+    LLVMErrorRef perr = LLVMRunPasses(m, pipeline, tm, pbo);
+    LLVMDisposePassBuilderOptions(pbo);
+    if (perr) {
+      char* msg = LLVMGetErrorMessage(perr);
+      job_fail(job, "sircc.llvm.opt_failed", "LLVM optimization pipeline '%s' failed: %s", pipeline, msg ? msg : "(unknown)");
+      LLVMDisposeErrorMessage(msg);
+      goto out;
+    }
+  }
+
+  if (job->emit_obj) {
+    char* err = NULL;
+    if (LLVMTargetMachineEmitToMemoryBuffer(tm, m, LLVMObjectFile, &err, &job->out) != 0) {
+      job_fail(job, "sircc.llvm.emit_obj_failed", "failed to emit object: %s", err ? err : "(unknown)");
+      LLVMDisposeMessage(err);
+      job->out = NULL;
+    }
+  } else {
+    job->out = LLVMWriteBitcodeToMemoryBuffer(m);
+    if (!job->out) job_fail(job, "sircc.oom", "out of memory");
+  }
+
+out:
+  if (tm) LLVMDisposeTargetMachine(tm);
+  LLVMDisposeModule(m);
+  LLVMContextDispose(ctx);
+}
+
+static void* par_worker(void* user) {
+  ParPool* pool = (ParPool*)user;
+  for (;;) {
+    pthread_mutex_lock(&pool->mu);
+    const size_t i = pool->next;
+    if (i < pool->len) pool->next++;
+    pthread_mutex_unlock(&pool->mu);
+    if (i >= pool->len) break;
+    run_job(&pool->jobs[i]);
+  }
+  return NULL;
+}
+
+// Runs every partition; the calling thread works too. Reports the first failing partition.
+static ParJob* run_partitions(SirProgram* p, const ParPlan* plan, bool emit_obj) {
+  ParJob* jobs = (ParJob*)calloc(plan->parts, sizeof(ParJob));
+  if (!jobs) return NULL;
+  for (size_t i = 0; i < plan->parts; i++) {
+    jobs[i] = (ParJob){.plan = plan, .p = p, .part = i, .emit_obj = emit_obj};
+  }
+
+  size_t threads_len = (size_t)(p->opt && p->opt->jobs > 0 ? p->opt->jobs : 1);
+  if (threads_len > plan->parts) threads_len = plan->parts;
+  ParPool pool = {.jobs = jobs, .len = plan->parts, .next = 0};
+  pthread_mutex_init(&pool.mu, NULL);
+  pthread_t* threads = threads_len > 1 ? (pthread_t*)calloc(threads_len - 1, sizeof(pthread_t)) : NULL;
+  size_t started = 0;
+  for (; threads && started + 1 < threads_len; started++) {
+    if (pthread_create(&threads[started], NULL, par_worker, &pool) != 0) break;
+  }
+  par_worker(&pool);
+  for (size_t t = 0; t < started; t++) pthread_join(threads[t], NULL);
+  pthread_mutex_destroy(&pool.mu);
+  free(threads);
+  return jobs;
+}
+
+static bool report_jobs(SirProgram* p, ParJob* jobs, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    if (!jobs[i].err_code) continue;
+    if (strcmp(jobs[i].err_code, "sircc.oom") == 0) bump_exit_code(p, SIRCC_EXIT_INTERNAL);
+    err_codef(p, jobs[i].err_code, "sircc: partition %zu: %s", i, jobs[i].err ? jobs[i].err : "(out of memory)");
+    return false;
+  }
+  return true;
+}
+
+static void free_jobs(ParJob* jobs, size_t len) {
+  if (!jobs) return;
+  for (size_t i = 0; i < len; i++) {
+    if (jobs[i].out) LLVMDisposeMemoryBuffer(jobs[i].out);
+    free(jobs[i].err);
+  }
+  free(jobs);
+}
+
+static void restore_promoted(const ParPlan* plan, LLVMModuleRef mod) {
+  for (size_t i = 0; i < plan->promoted_len; i++) {
+    const ParPromoted* pr = &plan->promoted[i];
+    LLVMValueRef v = LLVMGetNamedFunction(mod, pr->name);
+    if (!v) v = LLVMGetNamedGlobal(mod, pr->name);
+    if (!v) continue; // optimized away
+    LLVMSetLinkage(v, pr->linkage);
+    LLVMSetVisibility(v, pr->visibility);
+    LLVMSetValueName2(v, pr->orig_name, strlen(pr->orig_name));
+  }
+}
+
+// Runs the whole-module half of the pipeline, then plans the split.
+static bool prelink_and_plan(SirProgram* p, LLVMModuleRef mod, ParPlan* plan) {
+  const char* pre = split_pipeline_for_level(p->opt ? p->opt->opt_level : SIRCC_OPT_DEFAULT, true);
+  if (!run_module_pipeline(p, mod, LLVMGetTarget(mod), pre)) return false;
+  if (!plan_build(mod, plan)) return oom(p);
+  if (!plan->fn_part) {
+    bump_exit_code(p, SIRCC_EXIT_INTERNAL);
+    err_codef(p, "sircc.par.split_failed", "sircc: module cannot be partitioned after whole-module optimization");
+    return false;
+  }
+  if (plan_split(p, mod, plan)) return true;
+  plan_free(plan);
+  return false;
+}
+
+bool optimize_module_partitioned(SirProgram* p, LLVMContextRef* ctx, LLVMModuleRef* mod, bool* handled) {
+  *handled = false;
+  if (!pipeline_for_level(p->opt ? p->opt->opt_level : SIRCC_OPT_DEFAULT)) return true; // no IR passes
+  if (!par_can_split(*mod)) return true;
+  llvm_init_targets_once();
+  *handled = true;
+
+  ParPlan plan;
+  if (!prelink_and_plan(p, *mod, &plan)) return false;
+
+  ParJob* jobs = run_partitions(p, &plan, false);
+  if (!jobs) {
+    plan_free(&plan);
+    return oom(p);
+  }
+  bool ok = report_jobs(p, jobs, plan.parts);
+
+  // Link the optimized partitions back together, in partition order.
+  LLVMContextRef out_ctx = LLVMContextCreate();
+  LLVMModuleRef out = NULL;
+  for (size_t i = 0; ok && i < plan.parts; i++) {
+    LLVMModuleRef m = NULL;
+    if (LLVMParseBitcodeInContext2(out_ctx, jobs[i].out, &m) != 0) {
+      err_codef(p, "sircc.par.link_failed", "sircc: partition %zu: failed to read optimized bitcode", i);
+      ok = false;
+    } else if (!out) {
+      out = m;
+    } else if (LLVMLinkModules2(out, m) != 0) {
+      err_codef(p, "sircc.par.link_failed", "sircc: partition %zu: failed to link into the output module", i);
+      ok = false;
+    }
+  }
+  free_jobs(jobs, plan.parts);
+
+  if (ok) {
+    restore_promoted(&plan, out);
+    size_t id_len = 0;
+    const char* id = LLVMGetModuleIdentifier(*mod, &id_len);
+    LLVMSetModuleIdentifier(out, id, id_len); // the partition bitcode was parsed as "sir.bc"
+    char* verr = NULL;
+    if (LLVMVerifyModule(out, LLVMReturnStatusAction, &verr) != 0) {
+      err_codef(p, "sircc.llvm.verify_failed", "sircc: LLVM verification failed after partitioned optimization: %s",
+                verr ? verr : "(unknown)");
+      ok = false;
+    }
+    LLVMDisposeMessage(verr);
+  }
+  plan_free(&plan);
+  if (!ok) {
+    if (out) LLVMDisposeModule(out);
+    LLVMContextDispose(out_ctx);
+    return false;
+  }
+
+  LLVMDisposeModule(*mod);
+  LLVMContextDispose(*ctx);
+  *mod = out;
+  *ctx = out_ctx;
+  return true;
+}
+
+void free_obj_paths(char** paths, size_t len) {
+  if (!paths) return;
+  for (size_t i = 0; i < len; i++) {
+    if (!paths[i]) continue;
+    unlink(paths[i]);
+    free(paths[i]);
+  }
+  free(paths);
+}
+
+bool emit_module_objs_partitioned(SirProgram* p, LLVMModuleRef mod, const char* triple, char*** out_paths, size_t* out_len,
+                                  bool* handled) {
+  (void)triple; // init_target_for_module already pinned the module triple and data layout
+  *handled = false;
+  *out_paths = NULL;
+  *out_len = 0;
+  if (!pipeline_for_level(p->opt ? p->opt->opt_level : SIRCC_OPT_DEFAULT)) return true; // no IR passes
+  if (!par_can_split(mod)) return true;
+  llvm_init_targets_once();
+  *handled = true;
+
+  ParPlan plan;
+  if (!prelink_and_plan(p, mod, &plan)) return false;
+
+  ParJob* jobs = run_partitions(p, &plan, true);
+  if (!jobs) {
+    plan_free(&plan);
+    return oom(p);
+  }
+  bool ok = report_jobs(p, jobs, plan.parts);
+
+  char** paths = ok ? (char**)calloc(plan.parts, sizeof(char*)) : NULL;
+  if (ok && !paths) ok = oom(p);
+  for (size_t i = 0; ok && i < plan.parts; i++) {
+    char tmp[4096];
+    if (!make_tmp_obj(tmp, sizeof(tmp))) {
+      bump_exit_code(p, SIRCC_EXIT_INTERNAL);
+      err_codef(p, "sircc.tmp_obj.create_failed", "sircc: failed to create temporary object path");
+      ok = false;
+      break;
+    }
+    if (!(paths[i] = dup_n(tmp, strlen(tmp)))) {
+      unlink(tmp);
+      ok = oom(p);
+      break;
+    }
+    FILE* f = fopen(paths[i], "wb");
+    const size_t n = LLVMGetBufferSize(jobs[i].out);
+    if (!f || fwrite(LLVMGetBufferStart(jobs[i].out), 1, n, f) != n) {
+      err_codef(p, "sircc.io.write_failed", "sircc: failed to write partition object %s", paths[i]);
+      ok = false;
+    }
+    if (f && fclose(f) != 0 && ok) {
+      err_codef(p, "sircc.io.write_failed", "sircc: failed to write partition object %s", paths[i]);
+      ok = false;
+    }
+  }
+  free_jobs(jobs, plan.parts);
+  if (!ok) {
+    free_obj_paths(paths, plan.parts);
+    plan_free(&plan);
+    return false;
+  }
+  *out_paths = paths;
+  *out_len = plan.parts;
+  plan_free(&plan);
+  return true;
+}
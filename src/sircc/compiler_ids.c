@@ -38,6 +38,7 @@ static void idmap_init(SirIdMap* m) {
 static void idmap_free(SirIdMap* m) {
   if (!m) return;
   free(m->entries);
+  free(m->str_by_id);
   memset(m, 0, sizeof(*m));
 }
 
@@ -82,6 +83,21 @@ static bool idmap_grow(SirIdMap* m, size_t new_cap) {
   return true;
 }
 
+static bool idmap_note_str(SirIdMap* m, int64_t id, const char* s) {
+  if (id <= 0) return true;
+  if ((size_t)id >= m->str_by_id_cap) {
+    size_t ncap = m->str_by_id_cap ? m->str_by_id_cap : 256;
+    while (ncap <= (size_t)id) ncap *= 2;
+    const char** nr = (const char**)realloc(m->str_by_id, ncap * sizeof(*nr));
+    if (!nr) return false;
+    memset(nr + m->str_by_id_cap, 0, (ncap - m->str_by_id_cap) * sizeof(*nr));
+    m->str_by_id = nr;
+    m->str_by_id_cap = ncap;
+  }
+  m->str_by_id[id] = s;
+  return true;
+}
+
 static bool idmap_get_or_put(SirProgram* p, SirIdMap* m, bool is_str, int64_t ikey, const char* s, size_t slen,
                              int64_t* out) {
   if (!p || !m || !out) return false;
@@ -101,6 +117,14 @@ static bool idmap_get_or_put(SirProgram* p, SirIdMap* m, bool is_str, int64_t ik
   for (;;) {
     SirIdMapEntry* e = &m->entries[idx];
     if (!e->used) {
+      if (is_str && p->keep_arena) {
+        // Streaming: `s` lives in a segment arena that is about to be released.
+        char* keep = (char*)arena_alloc(p->keep_arena, slen + 1);
+        if (!keep) return false;
+        memcpy(keep, s, slen);
+        keep[slen] = 0;
+        s = keep;
+      }
       e->used = true;
       e->hash = h;
       e->is_str = is_str;
@@ -109,6 +133,7 @@ static bool idmap_get_or_put(SirProgram* p, SirIdMap* m, bool is_str, int64_t ik
       e->slen = slen;
       e->val = m->next_id++;
       m->len++;
+      if (is_str && !idmap_note_str(m, e->val, s)) return false;
       *out = e->val;
       return true;
     }
@@ -155,15 +180,8 @@ void sir_idmaps_free(SirProgram* p) {
 const char* sir_id_str_for_internal(SirProgram* p, SirIdKind kind, int64_t internal_id) {
   if (!p || internal_id == 0) return NULL;
   SirIdMap* m = map_for(p, kind);
-  if (!m || !m->entries || m->cap == 0) return NULL;
-  for (size_t i = 0; i < m->cap; i++) {
-    const SirIdMapEntry* e = &m->entries[i];
-    if (!e->used) continue;
-    if (!e->is_str) continue;
-    if (e->val != internal_id) continue;
-    return e->skey;
-  }
-  return NULL;
+  if (!m || internal_id < 0 || (size_t)internal_id >= m->str_by_id_cap) return NULL;
+  return m->str_by_id[internal_id];
 }
 
 bool sir_intern_id(SirProgram* p, SirIdKind kind, const JsonValue* v, int64_t* out_id, const char* ctx) {
@@ -191,7 +209,8 @@ bool sir_intern_id(SirProgram* p, SirIdKind kind, const JsonValue* v, int64_t* o
   const char* s = json_get_string((JsonValue*)v);
   if (s && *s) {
     size_t slen = strlen(s);
-    // json_parse allocates strings in the program arena, so the pointer is stable.
+    // json_parse allocates strings in the program arena, so the pointer is stable (idmap_get_or_put
+    // copies it while --stream has a segment arena active).
     return idmap_get_or_put(p, m, true, 0, s, slen, out_id);
   }
 
@@ -201,15 +220,15 @@ bool sir_intern_id(SirProgram* p, SirIdKind kind, const JsonValue* v, int64_t* o
 
 static bool parse_ref_id_kind(SirProgram* p, SirIdKind kind, const JsonValue* v, int64_t* out_id, const char* ctx) {
   if (!v || v->type != JSON_OBJECT) return false;
-  const char* ts = json_get_string(json_obj_get((JsonValue*)v, "t"));
+  const char* ts = json_get_string(json_obj_get_sym((JsonValue*)v, JSON_KEY_T));
   if (!ts || strcmp(ts, "ref") != 0) return false;
-  const char* k = json_get_string(json_obj_get((JsonValue*)v, "k"));
+  const char* k = json_get_string(json_obj_get_sym((JsonValue*)v, JSON_KEY_K));
   if (k) {
     if (kind == SIR_ID_NODE && strcmp(k, "node") != 0) return false;
     if (kind == SIR_ID_TYPE && strcmp(k, "type") != 0) return false;
     if (kind == SIR_ID_SYM && strcmp(k, "sym") != 0) return false;
   }
-  return sir_intern_id(p, kind, json_obj_get((JsonValue*)v, "id"), out_id, ctx);
+  return sir_intern_id(p, kind, json_obj_get_sym((JsonValue*)v, JSON_KEY_ID), out_id, ctx);
 }
 
 bool parse_node_ref_id(SirProgram* p, const JsonValue* v, int64_t* out_id) {
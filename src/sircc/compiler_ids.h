@@ -29,6 +29,8 @@ typedef struct SirIdMap {
   size_t cap;
   size_t len;
   int64_t next_id; // internal dense ids start at 1; 0 reserved for "absent" where applicable
+  const char** str_by_id; // internal id -> string key (NULL for ids not allocated from a string)
+  size_t str_by_id_cap;
 } SirIdMap;
 
 struct SirProgram;
@@ -5,10 +5,12 @@
 
 #include "compiler.h"
 #include "compiler_ids.h"
+#include "compiler_nodes.h"
 #include "json.h"
 #include "sircc.h"
 
 #include <llvm-c/Core.h>
+#include <llvm-c/TargetMachine.h>
 
 #include <stdbool.h>
 #include <stddef.h>
@@ -117,6 +119,20 @@ typedef struct PendingFeatureUse {
   const char* need;
 } PendingFeatureUse;
 
+// Name -> record map (open addressing). When several records share a name the
+// lowest id wins, matching the linear scans it replaces.
+typedef struct SirNameMapEntry {
+  uint64_t hash; // 0 marks an empty slot
+  const char* name;
+  void* rec;
+} SirNameMapEntry;
+
+typedef struct SirNameMap {
+  SirNameMapEntry* entries;
+  size_t cap; // power of two
+  size_t len;
+} SirNameMap;
+
 typedef struct SirProgram {
   Arena arena;
 
@@ -182,11 +198,40 @@ typedef struct SirProgram {
   NodeRec** nodes;
   size_t nodes_cap;
 
+  // Decoded view of `nodes` (tag enum, resolved args, immediates); see compiler_nodes.h.
+  SirNodeTable node_tab;
+
+  // Name indexes for fn / decl.fn nodes and syms, rebuilt with `node_tab`.
+  SirNameMap fn_by_name;
+  SirNameMap decl_fn_by_name;
+  SirNameMap sym_by_name;
+  bool names_built;
+
+  // Nodes given a per-function llvm_value/resolving since the last reset (lower_functions).
+  NodeRec** lowered_nodes;
+  size_t lowered_len;
+  size_t lowered_cap;
+  bool lowered_overflow; // list is incomplete; fall back to a full reset
+
+  // --lower-hl: the fn blocks array last grown by cfg_fn_append_blocks and its arena capacity,
+  // so appending blocks while lowering sem.* is amortized O(1).
+  JsonValue* hl_blocks_arr;
+  size_t hl_blocks_cap;
+
+  // --stream (compiler_stream.c): while a segment is loaded, `arena` is its scratch arena and
+  // `keep_arena` the long-lived one; interned id strings are copied there.
+  Arena* keep_arena;
+  struct SirStream* stream;
+
   PendingFeatureUse* pending_features;
   size_t pending_features_len;
   size_t pending_features_cap;
 } SirProgram;
 
+// Zero-initialized program state for one unit (freed by program_free).
+void program_init(SirProgram* p, const SirccOptions* opt);
+void program_free(SirProgram* p);
+
 // Diagnostics
 void bump_exit_code(SirProgram* p, int code);
 void errf(SirProgram* p, const char* fmt, ...);
@@ -225,6 +270,7 @@ bool is_ident(const char* s);
 
 bool read_line(FILE* f, char** buf, size_t* cap, size_t* out_len, size_t max_line_bytes, bool* out_too_long);
 bool is_blank_line(const char* s);
+bool parse_env_u64(const char* name, uint64_t* out); // false when unset or not a decimal integer
 
 // Tables
 TypeRec* get_type(SirProgram* p, int64_t id);
@@ -233,10 +279,22 @@ SymRec* find_sym_by_name(SirProgram* p, const char* name);
 NodeRec* get_node(SirProgram* p, int64_t id);
 NodeRec* find_fn_node_by_name(SirProgram* p, const char* name);
 NodeRec* find_decl_fn_node_by_name(SirProgram* p, const char* name);
+// (Re)builds the name indexes behind the find_*_by_name lookups. Returns false on OOM.
+bool sir_names_build(SirProgram* p);
+void sir_names_free(SirProgram* p);
 
 // Frontend
 bool parse_program(SirProgram* p, const SirccOptions* opt, const char* input_path);
+// The per-record steps of parse_program, shared with the --stream reader.
+void parse_record_begin(SirProgram* p, const char* path, size_t line_no);
+bool parse_record(SirProgram* p, const SirccOptions* opt, JsonValue* root);
+void parse_limits(size_t* out_max_line_bytes, size_t* out_max_records); // SIRCC_MAX_LINE_BYTES / SIRCC_MAX_RECORDS
+bool parse_check_pending_features(SirProgram* p);
 bool validate_program(SirProgram* p);
+// validate_program split for --stream: unit-wide checks (feature deps, types, data:v1) once, then
+// the fn/CFG and per-node checks for each loaded set of nodes.
+bool validate_program_decls(SirProgram* p);
+bool validate_node_set(SirProgram* p, NodeRec* const* nodes, size_t len);
 
 // Type/codegen helpers
 LLVMValueRef get_or_declare_intrinsic(LLVMModuleRef mod, const char* name, LLVMTypeRef ret, LLVMTypeRef* params, unsigned param_count);
@@ -248,18 +306,60 @@ bool type_size_align(SirProgram* p, int64_t type_id, int64_t* out_size, int64_t*
 
 // Lowering
 bool lower_functions(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod);
+// lower_functions in pieces for --stream / --cache-dir: declare every loaded fn node (or just `n`)
+// in `mod`, then lower one body at a time (per-function node state is cleared before returning).
+bool lower_fn_protos(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod);
+bool lower_fn_proto(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod, NodeRec* n);
+bool lower_fn_streamed(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod, NodeRec* fn);
+// Defines every public sym global up front (they are otherwise added on first use), so that other
+// units linked into `mod` can refer to them.
+bool lower_public_syms(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod);
 
 // Emission
 bool emit_module_ir(SirProgram* p, LLVMModuleRef mod, const char* out_path);
 bool init_target_for_module(SirProgram* p, LLVMModuleRef mod, const char* triple);
 bool init_target_info(SirProgram* p, const char* triple);
+bool optimize_module(SirProgram* p, LLVMModuleRef mod, const char* triple);
+bool run_module_pipeline(SirProgram* p, LLVMModuleRef mod, const char* triple, const char* pipeline); // NULL: no-op
 bool emit_module_obj(SirProgram* p, LLVMModuleRef mod, const char* triple, const char* out_path);
+void llvm_init_targets_once(void);
+LLVMCodeGenOptLevel codegen_level(const SirProgram* p);
+const char* pipeline_for_level(SirccOptLevel level); // NULL: no IR passes
+// The partitioned pipeline splits default<ON> in two: the whole-module half (inlining, IPO)
+// and the per-partition half. NULL: no IR passes.
+const char* split_pipeline_for_level(SirccOptLevel level, bool pre_link);
+
+// Partitioned -O pipeline for -j N (N > 1); see compiler_emit_par.c. Both return *handled=false (and touch
+// nothing) when there are no IR passes to run or the module does not have enough functions
+// to split.
+bool optimize_module_partitioned(SirProgram* p, LLVMContextRef* ctx, LLVMModuleRef* mod, bool* handled);
+bool emit_module_objs_partitioned(SirProgram* p, LLVMModuleRef mod, const char* triple, char*** out_paths, size_t* out_len,
+                                  bool* handled);
+void free_obj_paths(char** paths, size_t len); // unlinks and frees
+// Replaces global variable `g` by an external declaration of the same name (false on OOM).
+bool declare_global(LLVMModuleRef m, LLVMValueRef g);
+
+// Streaming compile (--stream); see compiler_stream.c.
+bool stream_parse_program(SirProgram* p);
+bool stream_verify(SirProgram* p);
+bool stream_emit_objs(SirProgram* p, const char* triple, char*** out_paths, size_t* out_len);
+void stream_free(SirProgram* p);
+
+// Incremental compile (--cache-dir); see compiler_cache.c. Objects are paths into the cache dir.
+bool cache_check_options(SirProgram* p);
+bool cache_emit_objs(SirProgram* p, const char* triple, char*** out_paths, size_t* out_len);
+
+// Multi-unit compile (extra inputs after the first); see compiler_units.c.
+bool units_check_options(SirProgram* p);
+bool units_verify(SirProgram* p);
+bool units_link(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod, const char* triple);
 
 // ZASM (zir) emission (zasm-v1.1 JSONL).
 bool emit_zasm_v11(SirProgram* p, const char* out_path);
 
 // Link
-bool run_clang_link(SirProgram* p, const char* clang_path, const char* obj_path, const char* out_path);
-bool run_clang_link_zabi25(SirProgram* p, const char* clang_path, const char* guest_obj_path, const char* out_path);
+bool run_clang_link(SirProgram* p, const char* clang_path, const char* const* obj_paths, size_t obj_len, const char* out_path);
+bool run_clang_link_zabi25(SirProgram* p, const char* clang_path, const char* const* guest_obj_paths, size_t guest_obj_len,
+                           const char* out_path);
 bool run_strip(SirProgram* p, const char* exe_path);
 bool make_tmp_obj(char* out, size_t out_cap);
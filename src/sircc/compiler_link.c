@@ -14,18 +14,32 @@
 #include <sys/wait.h>
 #include <unistd.h>
 
-bool run_clang_link(SirProgram* p, const char* clang_path, const char* obj_path, const char* out_path) {
+bool run_clang_link(SirProgram* p, const char* clang_path, const char* const* obj_paths, size_t obj_len, const char* out_path) {
   const char* clang = clang_path ? clang_path : "clang";
   const SirccOptions* opt = p ? p->opt : NULL;
 
-  char* const argv[] = {(char*)clang, (char*)"-o", (char*)out_path, (char*)obj_path, NULL};
+  char** argv = (char**)calloc(obj_len + 4, sizeof(char*));
+  if (!argv) {
+    bump_exit_code(p, SIRCC_EXIT_INTERNAL);
+    err_codef(p, "sircc.oom", "sircc: out of memory");
+    return false;
+  }
+  size_t ai = 0;
+  argv[ai++] = (char*)clang;
+  argv[ai++] = (char*)"-o";
+  argv[ai++] = (char*)out_path;
+  for (size_t i = 0; i < obj_len; i++) argv[ai++] = (char*)obj_paths[i];
+  argv[ai] = NULL;
 
   if (opt && opt->verbose) {
-    fprintf(stderr, "sircc: link: %s -o %s %s\n", clang, out_path, obj_path);
+    fprintf(stderr, "sircc: link: %s -o %s", clang, out_path);
+    for (size_t i = 0; i < obj_len; i++) fprintf(stderr, " %s", obj_paths[i]);
+    fprintf(stderr, "\n");
   }
 
   pid_t pid = fork();
   if (pid < 0) {
+    free(argv);
     bump_exit_code(p, SIRCC_EXIT_INTERNAL);
     err_codef(p, "sircc.proc.fork_failed", "sircc: fork failed: %s", strerror(errno));
     return false;
@@ -35,6 +49,7 @@ bool run_clang_link(SirProgram* p, const char* clang_path, const char* obj_path,
     fprintf(stderr, "sircc: failed to exec '%s': %s\n", clang, strerror(errno));
     _exit(127);
   }
+  free(argv);
   int st = 0;
   if (waitpid(pid, &st, 0) < 0) {
     bump_exit_code(p, SIRCC_EXIT_INTERNAL);
@@ -183,7 +198,8 @@ static bool run_clang_compile_c(SirProgram* p, const char* clang_path, const cha
   return true;
 }
 
-bool run_clang_link_zabi25(SirProgram* p, const char* clang_path, const char* guest_obj_path, const char* out_path) {
+bool run_clang_link_zabi25(SirProgram* p, const char* clang_path, const char* const* guest_obj_paths, size_t guest_obj_len,
+                           const char* out_path) {
   const SirccOptions* opt = p ? p->opt : NULL;
   char root[PATH_MAX];
   if (!resolve_zabi25_root(opt, root, sizeof(root))) {
@@ -215,12 +231,30 @@ bool run_clang_link_zabi25(SirProgram* p, const char* clang_path, const char* gu
 
   const char* clang = clang_path ? clang_path : "clang";
   if (opt && opt->verbose) {
-    fprintf(stderr, "sircc: link(zabi25): %s -o %s %s %s %s\n", clang, out_path, runner_obj, guest_obj_path, lib_path);
+    fprintf(stderr, "sircc: link(zabi25): %s -o %s %s", clang, out_path, runner_obj);
+    for (size_t i = 0; i < guest_obj_len; i++) fprintf(stderr, " %s", guest_obj_paths[i]);
+    fprintf(stderr, " %s\n", lib_path);
+  }
+
+  char** argv = (char**)calloc(guest_obj_len + 6, sizeof(char*));
+  if (!argv) {
+    unlink(runner_obj);
+    bump_exit_code(p, SIRCC_EXIT_INTERNAL);
+    err_codef(p, "sircc.oom", "sircc: out of memory");
+    return false;
   }
+  size_t ai = 0;
+  argv[ai++] = (char*)clang;
+  argv[ai++] = (char*)"-o";
+  argv[ai++] = (char*)out_path;
+  argv[ai++] = runner_obj;
+  for (size_t i = 0; i < guest_obj_len; i++) argv[ai++] = (char*)guest_obj_paths[i];
+  argv[ai++] = lib_path;
+  argv[ai] = NULL;
 
-  char* const argv[] = {(char*)clang, (char*)"-o", (char*)out_path, runner_obj, (char*)guest_obj_path, (char*)lib_path, NULL};
   pid_t pid = fork();
   if (pid < 0) {
+    free(argv);
     unlink(runner_obj);
     bump_exit_code(p, SIRCC_EXIT_INTERNAL);
     err_codef(p, "sircc.proc.fork_failed", "sircc: fork failed: %s", strerror(errno));
@@ -231,6 +265,7 @@ bool run_clang_link_zabi25(SirProgram* p, const char* clang_path, const char* gu
     fprintf(stderr, "sircc: failed to exec '%s': %s\n", clang, strerror(errno));
     _exit(127);
   }
+  free(argv);
   int st = 0;
   if (waitpid(pid, &st, 0) < 0) {
     unlink(runner_obj);
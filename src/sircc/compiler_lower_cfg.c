@@ -21,13 +21,13 @@ bool lower_stmt(FunctionCtx* f, int64_t node_id) {
       LOWER_ERR_NODE(f, n, "sircc.let.missing_fields", "sircc: let node %lld missing fields", (long long)node_id);
       return false;
     }
-    const char* name = json_get_string(json_obj_get(n->fields, "name"));
+    const char* name = json_get_string(json_obj_get_sym(n->fields, JSON_KEY_NAME));
     if (!name) {
       LOWER_ERR_NODE(f, n, "sircc.let.name.missing", "sircc: let node %lld missing fields.name", (long long)node_id);
       return false;
     }
     int64_t vid = 0;
-    if (!parse_node_ref_id(f->p, json_obj_get(n->fields, "value"), &vid)) {
+    if (!parse_node_ref_id(f->p, json_obj_get_sym(n->fields, JSON_KEY_VALUE), &vid)) {
       LOWER_ERR_NODE(f, n, "sircc.let.value.ref_bad", "sircc: let node %lld missing fields.value ref", (long long)node_id);
       return false;
     }
@@ -48,7 +48,7 @@ bool lower_stmt(FunctionCtx* f, int64_t node_id) {
       return false;
     }
     int64_t aid = 0, vid = 0;
-    if (!parse_node_ref_id(f->p, json_obj_get(n->fields, "addr"), &aid) || !parse_node_ref_id(f->p, json_obj_get(n->fields, "value"), &vid)) {
+    if (!parse_node_ref_id(f->p, json_obj_get_sym(n->fields, JSON_KEY_ADDR), &aid) || !parse_node_ref_id(f->p, json_obj_get_sym(n->fields, JSON_KEY_VALUE), &vid)) {
       LOWER_ERR_NODE(f, n, "sircc.store.addr_value.ref_bad", "sircc: %s node %lld requires fields.addr and fields.value refs", n->tag, (long long)node_id);
       return false;
     }
@@ -86,7 +86,7 @@ bool lower_stmt(FunctionCtx* f, int64_t node_id) {
     if (want_ptr != pty) {
       pval = LLVMBuildBitCast(f->builder, pval, want_ptr, "st.cast");
     }
-    JsonValue* alignv = json_obj_get(n->fields, "align");
+    JsonValue* alignv = json_obj_get_sym(n->fields, JSON_KEY_ALIGN);
     unsigned align = 1;
     if (alignv) {
       int64_t a = 0;
@@ -107,7 +107,7 @@ bool lower_stmt(FunctionCtx* f, int64_t node_id) {
     if (!emit_trap_if_misaligned(f, pval, align)) return false;
     LLVMValueRef st = LLVMBuildStore(f->builder, vval, pval);
     LLVMSetAlignment(st, align);
-    JsonValue* volv = json_obj_get(n->fields, "vol");
+    JsonValue* volv = json_obj_get_sym(n->fields, JSON_KEY_VOL);
     if (volv && volv->type == JSON_BOOL) LLVMSetVolatile(st, volv->v.b ? 1 : 0);
     return true;
   }
@@ -117,7 +117,7 @@ bool lower_stmt(FunctionCtx* f, int64_t node_id) {
       LOWER_ERR_NODE(f, n, "sircc.mem.copy.missing_fields", "sircc: mem.copy node %lld missing fields", (long long)node_id);
       return false;
     }
-    JsonValue* args = json_obj_get(n->fields, "args");
+    JsonValue* args = json_obj_get_sym(n->fields, JSON_KEY_ARGS);
     if (!args || args->type != JSON_ARRAY || args->v.arr.len != 3) {
       LOWER_ERR_NODE(f, n, "sircc.mem.copy.args.bad", "sircc: mem.copy node %lld requires args:[dst, src, len]", (long long)node_id);
       return false;
@@ -145,9 +145,9 @@ bool lower_stmt(FunctionCtx* f, int64_t node_id) {
     unsigned align_dst = 1;
     unsigned align_src = 1;
     bool use_memmove = false;
-    JsonValue* flags = json_obj_get(n->fields, "flags");
+    JsonValue* flags = json_obj_get_sym(n->fields, JSON_KEY_FLAGS);
     if (flags && flags->type == JSON_OBJECT) {
-      JsonValue* adv = json_obj_get(flags, "alignDst");
+      JsonValue* adv = json_obj_get_sym(flags, JSON_KEY_ALIGN_DST);
       if (adv) {
         int64_t a = 0;
         if (!json_get_i64(adv, &a)) {
@@ -160,7 +160,7 @@ bool lower_stmt(FunctionCtx* f, int64_t node_id) {
         }
         align_dst = (unsigned)a;
       }
-      JsonValue* asv = json_obj_get(flags, "alignSrc");
+      JsonValue* asv = json_obj_get_sym(flags, JSON_KEY_ALIGN_SRC);
       if (asv) {
         int64_t a = 0;
         if (!json_get_i64(asv, &a)) {
@@ -173,7 +173,7 @@ bool lower_stmt(FunctionCtx* f, int64_t node_id) {
         }
         align_src = (unsigned)a;
       }
-      const char* ov = json_get_string(json_obj_get(flags, "overlap"));
+      const char* ov = json_get_string(json_obj_get_sym(flags, JSON_KEY_OVERLAP));
       if (ov) {
         if (strcmp(ov, "allow") == 0) use_memmove = true;
         else if (strcmp(ov, "disallow") == 0) use_memmove = false;
@@ -232,7 +232,7 @@ bool lower_stmt(FunctionCtx* f, int64_t node_id) {
       LOWER_ERR_NODE(f, n, "sircc.mem.fill.missing_fields", "sircc: mem.fill node %lld missing fields", (long long)node_id);
       return false;
     }
-    JsonValue* args = json_obj_get(n->fields, "args");
+    JsonValue* args = json_obj_get_sym(n->fields, JSON_KEY_ARGS);
     if (!args || args->type != JSON_ARRAY || args->v.arr.len != 3) {
       LOWER_ERR_NODE(f, n, "sircc.mem.fill.args.bad", "sircc: mem.fill node %lld requires args:[dst, byte, len]", (long long)node_id);
       return false;
@@ -262,9 +262,9 @@ bool lower_stmt(FunctionCtx* f, int64_t node_id) {
     }
 
     unsigned align_dst = 1;
-    JsonValue* flags = json_obj_get(n->fields, "flags");
+    JsonValue* flags = json_obj_get_sym(n->fields, JSON_KEY_FLAGS);
     if (flags && flags->type == JSON_OBJECT) {
-      JsonValue* adv = json_obj_get(flags, "alignDst");
+      JsonValue* adv = json_obj_get_sym(flags, JSON_KEY_ALIGN_DST);
       if (adv) {
         int64_t a = 0;
         if (!json_get_i64(adv, &a)) {
@@ -293,10 +293,10 @@ bool lower_stmt(FunctionCtx* f, int64_t node_id) {
       LOWER_ERR_NODE(f, n, "sircc.eff.fence.missing_fields", "sircc: eff.fence node %lld missing fields", (long long)node_id);
       return false;
     }
-    JsonValue* flags = json_obj_get(n->fields, "flags");
+    JsonValue* flags = json_obj_get_sym(n->fields, JSON_KEY_FLAGS);
     const char* mode = NULL;
-    if (flags && flags->type == JSON_OBJECT) mode = json_get_string(json_obj_get(flags, "mode"));
-    if (!mode) mode = json_get_string(json_obj_get(n->fields, "mode"));
+    if (flags && flags->type == JSON_OBJECT) mode = json_get_string(json_obj_get_sym(flags, JSON_KEY_MODE));
+    if (!mode) mode = json_get_string(json_obj_get_sym(n->fields, JSON_KEY_MODE));
     if (!mode) {
       LOWER_ERR_NODE(f, n, "sircc.eff.fence.mode.missing", "sircc: eff.fence node %lld missing flags.mode", (long long)node_id);
       return false;
@@ -322,7 +322,7 @@ bool lower_stmt(FunctionCtx* f, int64_t node_id) {
   }
 
   if (strcmp(n->tag, "return") == 0) {
-    JsonValue* v = n->fields ? json_obj_get(n->fields, "value") : NULL;
+    JsonValue* v = n->fields ? json_obj_get_sym(n->fields, JSON_KEY_VALUE) : NULL;
     int64_t vid = 0;
     if (!parse_node_ref_id(f->p, v, &vid)) {
       LOWER_ERR_NODE(f, n, "sircc.return.value.ref_bad", "sircc: return node %lld missing value ref", (long long)node_id);
@@ -335,7 +335,7 @@ bool lower_stmt(FunctionCtx* f, int64_t node_id) {
   }
 
   if (strcmp(n->tag, "term.ret") == 0) {
-    JsonValue* v = n->fields ? json_obj_get(n->fields, "value") : NULL;
+    JsonValue* v = n->fields ? json_obj_get_sym(n->fields, JSON_KEY_VALUE) : NULL;
     if (!v) {
       LLVMBuildRetVoid(f->builder);
       return true;
@@ -370,7 +370,7 @@ bool lower_stmt(FunctionCtx* f, int64_t node_id) {
   }
 
   if (strcmp(n->tag, "block") == 0) {
-    JsonValue* stmts = n->fields ? json_obj_get(n->fields, "stmts") : NULL;
+    JsonValue* stmts = n->fields ? json_obj_get_sym(n->fields, JSON_KEY_STMTS) : NULL;
     if (!stmts || stmts->type != JSON_ARRAY) {
       LOWER_ERR_NODE(f, n, "sircc.block.stmts.bad", "sircc: block node %lld missing stmts array", (long long)node_id);
       return false;
@@ -405,7 +405,7 @@ static bool add_block_args(FunctionCtx* f, const NodeRec* origin, LLVMBasicBlock
     return false;
   }
 
-  JsonValue* params = bn->fields ? json_obj_get(bn->fields, "params") : NULL;
+  JsonValue* params = bn->fields ? json_obj_get_sym(bn->fields, JSON_KEY_PARAMS) : NULL;
   size_t pcount = 0;
   if (params) {
     if (params->type != JSON_ARRAY) {
@@ -470,7 +470,7 @@ bool lower_term_cfg(FunctionCtx* f, int64_t node_id) {
       LOWER_ERR_NODE(f, n, "sircc.term.br.missing_fields", "sircc: term.br node %lld missing fields", (long long)node_id);
       return false;
     }
-    JsonValue* to = json_obj_get(n->fields, "to");
+    JsonValue* to = json_obj_get_sym(n->fields, JSON_KEY_TO);
     int64_t bid = 0;
     if (!parse_node_ref_id(f->p, to, &bid)) {
       LOWER_ERR_NODE(f, n, "sircc.term.br.to.ref_bad", "sircc: term.br node %lld missing to ref", (long long)node_id);
@@ -482,7 +482,7 @@ bool lower_term_cfg(FunctionCtx* f, int64_t node_id) {
                      (long long)bid);
       return false;
     }
-    JsonValue* args = json_obj_get(n->fields, "args");
+    JsonValue* args = json_obj_get_sym(n->fields, JSON_KEY_ARGS);
     if (!add_block_args(f, n, LLVMGetInsertBlock(f->builder), bid, args)) return false;
     LLVMBuildBr(f->builder, bb);
     return true;
@@ -495,7 +495,7 @@ bool lower_term_cfg(FunctionCtx* f, int64_t node_id) {
     }
 
     int64_t cond_id = 0;
-    if (!parse_node_ref_id(f->p, json_obj_get(n->fields, "cond"), &cond_id)) {
+    if (!parse_node_ref_id(f->p, json_obj_get_sym(n->fields, JSON_KEY_COND), &cond_id)) {
       LOWER_ERR_NODE(f, n, "sircc.term.condbr.cond.ref_bad", "sircc: %s node %lld missing cond ref", n->tag, (long long)node_id);
       return false;
     }
@@ -506,8 +506,8 @@ bool lower_term_cfg(FunctionCtx* f, int64_t node_id) {
       return false;
     }
 
-    JsonValue* thenb = json_obj_get(n->fields, "then");
-    JsonValue* elseb = json_obj_get(n->fields, "else");
+    JsonValue* thenb = json_obj_get_sym(n->fields, JSON_KEY_THEN);
+    JsonValue* elseb = json_obj_get_sym(n->fields, JSON_KEY_ELSE);
     if (!thenb || thenb->type != JSON_OBJECT || !elseb || elseb->type != JSON_OBJECT) {
       LOWER_ERR_NODE(f, n, "sircc.term.condbr.branches.bad", "sircc: %s node %lld requires then/else objects", n->tag, (long long)node_id);
       return false;
@@ -515,7 +515,7 @@ bool lower_term_cfg(FunctionCtx* f, int64_t node_id) {
 
     int64_t then_id = 0;
     int64_t else_id = 0;
-    if (!parse_node_ref_id(f->p, json_obj_get(thenb, "to"), &then_id) || !parse_node_ref_id(f->p, json_obj_get(elseb, "to"), &else_id)) {
+    if (!parse_node_ref_id(f->p, json_obj_get_sym(thenb, JSON_KEY_TO), &then_id) || !parse_node_ref_id(f->p, json_obj_get_sym(elseb, JSON_KEY_TO), &else_id)) {
       LOWER_ERR_NODE(f, n, "sircc.term.condbr.to.ref_bad", "sircc: %s node %lld then/else missing to ref", n->tag, (long long)node_id);
       return false;
     }
@@ -526,8 +526,8 @@ bool lower_term_cfg(FunctionCtx* f, int64_t node_id) {
       return false;
     }
 
-    JsonValue* then_args = json_obj_get(thenb, "args");
-    JsonValue* else_args = json_obj_get(elseb, "args");
+    JsonValue* then_args = json_obj_get_sym(thenb, JSON_KEY_ARGS);
+    JsonValue* else_args = json_obj_get_sym(elseb, JSON_KEY_ARGS);
     LLVMBasicBlockRef from_bb = LLVMGetInsertBlock(f->builder);
     if (!add_block_args(f, n, from_bb, then_id, then_args)) return false;
     if (!add_block_args(f, n, from_bb, else_id, else_args)) return false;
@@ -542,7 +542,7 @@ bool lower_term_cfg(FunctionCtx* f, int64_t node_id) {
       return false;
     }
     int64_t scrut_id = 0;
-    if (!parse_node_ref_id(f->p, json_obj_get(n->fields, "scrut"), &scrut_id)) {
+    if (!parse_node_ref_id(f->p, json_obj_get_sym(n->fields, JSON_KEY_SCRUT), &scrut_id)) {
       LOWER_ERR_NODE(f, n, "sircc.term.switch.scrut.ref_bad", "sircc: term.switch node %lld missing scrut ref", (long long)node_id);
       return false;
     }
@@ -561,13 +561,13 @@ bool lower_term_cfg(FunctionCtx* f, int64_t node_id) {
       return false;
     }
 
-    JsonValue* def = json_obj_get(n->fields, "default");
+    JsonValue* def = json_obj_get_sym(n->fields, JSON_KEY_DEFAULT);
     if (!def || def->type != JSON_OBJECT) {
       LOWER_ERR_NODE(f, n, "sircc.term.switch.default.missing", "sircc: term.switch node %lld missing default branch", (long long)node_id);
       return false;
     }
     int64_t def_id = 0;
-    if (!parse_node_ref_id(f->p, json_obj_get(def, "to"), &def_id)) {
+    if (!parse_node_ref_id(f->p, json_obj_get_sym(def, JSON_KEY_TO), &def_id)) {
       LOWER_ERR_NODE(f, n, "sircc.term.switch.default.to.ref_bad", "sircc: term.switch default missing to ref");
       return false;
     }
@@ -576,10 +576,10 @@ bool lower_term_cfg(FunctionCtx* f, int64_t node_id) {
       LOWER_ERR_NODE(f, n, "sircc.term.switch.default.target.unknown", "sircc: term.switch default targets unknown block %lld", (long long)def_id);
       return false;
     }
-    JsonValue* def_args = json_obj_get(def, "args");
+    JsonValue* def_args = json_obj_get_sym(def, JSON_KEY_ARGS);
     if (!add_block_args(f, n, LLVMGetInsertBlock(f->builder), def_id, def_args)) return false;
 
-    JsonValue* cases = json_obj_get(n->fields, "cases");
+    JsonValue* cases = json_obj_get_sym(n->fields, JSON_KEY_CASES);
     if (!cases || cases->type != JSON_ARRAY) {
       LOWER_ERR_NODE(f, n, "sircc.term.switch.cases.bad", "sircc: term.switch node %lld missing cases array", (long long)node_id);
       return false;
@@ -592,7 +592,7 @@ bool lower_term_cfg(FunctionCtx* f, int64_t node_id) {
         return false;
       }
       int64_t lit_id = 0;
-      if (!parse_node_ref_id(f->p, json_obj_get(c, "lit"), &lit_id)) {
+      if (!parse_node_ref_id(f->p, json_obj_get_sym(c, JSON_KEY_LIT), &lit_id)) {
         LOWER_ERR_NODE(f, n, "sircc.term.switch.case.lit.ref_bad", "sircc: term.switch case[%zu] missing lit ref", i);
         return false;
       }
@@ -602,14 +602,14 @@ bool lower_term_cfg(FunctionCtx* f, int64_t node_id) {
         return false;
       }
       int64_t litv = 0;
-      if (!json_get_i64(json_obj_get(litn->fields, "value"), &litv)) {
+      if (!json_get_i64(json_obj_get_sym(litn->fields, JSON_KEY_VALUE), &litv)) {
         LOWER_ERR_NODE(f, n, "sircc.term.switch.case.lit.value.bad", "sircc: term.switch case[%zu] lit value must be integer", i);
         return false;
       }
       LLVMValueRef lit = LLVMConstInt(sty, (unsigned long long)litv, 1);
 
       int64_t to_id = 0;
-      if (!parse_node_ref_id(f->p, json_obj_get(c, "to"), &to_id)) {
+      if (!parse_node_ref_id(f->p, json_obj_get_sym(c, JSON_KEY_TO), &to_id)) {
         LOWER_ERR_NODE(f, n, "sircc.term.switch.case.to.ref_bad", "sircc: term.switch case[%zu] missing to ref", i);
         return false;
       }
@@ -620,7 +620,7 @@ bool lower_term_cfg(FunctionCtx* f, int64_t node_id) {
         return false;
       }
 
-      JsonValue* args = json_obj_get(c, "args");
+      JsonValue* args = json_obj_get_sym(c, JSON_KEY_ARGS);
       if (!add_block_args(f, n, LLVMGetInsertBlock(f->builder), to_id, args)) return false;
 
       LLVMAddCase(sw, lit, to_bb);
@@ -634,77 +634,99 @@ bool lower_term_cfg(FunctionCtx* f, int64_t node_id) {
 }
 
 
-bool lower_functions(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod) {
-  // Pass 1: create prototypes
-  for (size_t i = 0; i < p->nodes_cap; i++) {
-    NodeRec* n = p->nodes[i];
-    if (!n) continue;
-    if (strcmp(n->tag, "fn") != 0) continue;
-
-    const char* name = n->fields ? json_get_string(json_obj_get(n->fields, "name")) : NULL;
-    if (!name) {
-      SIRCC_ERR_NODE(p, n, "sircc.fn.name.missing", "sircc: fn node %lld missing fields.name", (long long)n->id);
-      return false;
+void note_lowered_node(SirProgram* p, NodeRec* n) {
+  if (p->lowered_overflow) return;
+  if (p->lowered_len == p->lowered_cap) {
+    const size_t new_cap = p->lowered_cap ? p->lowered_cap * 2 : 256;
+    NodeRec** nn = (NodeRec**)realloc(p->lowered_nodes, new_cap * sizeof(NodeRec*));
+    if (!nn) {
+      p->lowered_overflow = true;
+      return;
     }
-    if (n->type_ref == 0) {
-      SIRCC_ERR_NODE(p, n, "sircc.fn.type_ref.missing", "sircc: fn node %lld missing type_ref", (long long)n->id);
-      return false;
-    }
-    LLVMTypeRef fnty = lower_type(p, ctx, n->type_ref);
-    if (!fnty || LLVMGetTypeKind(fnty) != LLVMFunctionTypeKind) {
-      SIRCC_ERR_NODE(p, n, "sircc.fn.type_ref.bad", "sircc: fn node %lld has invalid function type_ref %lld", (long long)n->id,
-                     (long long)n->type_ref);
-      return false;
-    }
-    LLVMValueRef fn = LLVMAddFunction(mod, name, fnty);
-    const char* linkage = n->fields ? json_get_string(json_obj_get(n->fields, "linkage")) : NULL;
-    if (linkage && strcmp(linkage, "local") == 0) {
-      LLVMSetLinkage(fn, LLVMInternalLinkage);
-    } else if (linkage && strcmp(linkage, "public") == 0) {
-      LLVMSetLinkage(fn, LLVMExternalLinkage);
-    } else if (linkage && *linkage) {
-      SIRCC_ERR_NODE(p, n, "sircc.fn.linkage.bad",
-                     "sircc: fn node %lld has unsupported linkage '%s' (use 'local' or 'public')", (long long)n->id, linkage);
-      return false;
+    p->lowered_nodes = nn;
+    p->lowered_cap = new_cap;
+  }
+  p->lowered_nodes[p->lowered_len++] = n;
+}
+
+static void reset_lowered_node(NodeRec* x) {
+  if (strcmp(x->tag, "fn") == 0) return;
+  if (strncmp(x->tag, "const.", 6) == 0) return;
+  x->llvm_value = NULL;
+  x->resolving = false;
+}
+
+static void reset_lowered_nodes(SirProgram* p, bool full) {
+  if (full || p->lowered_overflow) {
+    for (size_t j = 0; j < p->nodes_cap; j++) {
+      if (p->nodes[j]) reset_lowered_node(p->nodes[j]);
     }
-    n->llvm_value = fn;
+  } else {
+    for (size_t j = 0; j < p->lowered_len; j++) reset_lowered_node(p->lowered_nodes[j]);
+  }
+  p->lowered_len = 0;
+  p->lowered_overflow = false;
+}
+
+bool lower_fn_proto(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod, NodeRec* n) {
+  const char* name = n->fields ? json_get_string(json_obj_get_sym(n->fields, JSON_KEY_NAME)) : NULL;
+  if (!name) {
+    SIRCC_ERR_NODE(p, n, "sircc.fn.name.missing", "sircc: fn node %lld missing fields.name", (long long)n->id);
+    return false;
+  }
+  if (n->type_ref == 0) {
+    SIRCC_ERR_NODE(p, n, "sircc.fn.type_ref.missing", "sircc: fn node %lld missing type_ref", (long long)n->id);
+    return false;
   }
+  LLVMTypeRef fnty = lower_type(p, ctx, n->type_ref);
+  if (!fnty || LLVMGetTypeKind(fnty) != LLVMFunctionTypeKind) {
+    SIRCC_ERR_NODE(p, n, "sircc.fn.type_ref.bad", "sircc: fn node %lld has invalid function type_ref %lld", (long long)n->id,
+                   (long long)n->type_ref);
+    return false;
+  }
+  LLVMValueRef fn = LLVMAddFunction(mod, name, fnty);
+  const char* linkage = n->fields ? json_get_string(json_obj_get_sym(n->fields, JSON_KEY_LINKAGE)) : NULL;
+  if (linkage && strcmp(linkage, "local") == 0) {
+    LLVMSetLinkage(fn, LLVMInternalLinkage);
+  } else if (linkage && strcmp(linkage, "public") == 0) {
+    LLVMSetLinkage(fn, LLVMExternalLinkage);
+  } else if (linkage && *linkage) {
+    SIRCC_ERR_NODE(p, n, "sircc.fn.linkage.bad",
+                   "sircc: fn node %lld has unsupported linkage '%s' (use 'local' or 'public')", (long long)n->id, linkage);
+    return false;
+  }
+  n->llvm_value = fn;
+  return true;
+}
 
-  // Pass 2: lower bodies
+bool lower_fn_protos(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod) {
   for (size_t i = 0; i < p->nodes_cap; i++) {
     NodeRec* n = p->nodes[i];
     if (!n) continue;
     if (strcmp(n->tag, "fn") != 0) continue;
-    LLVMValueRef fn = n->llvm_value;
-    if (!fn) continue;
-
-    // Expression nodes are currently lowered relative to a specific function's builder. Clear any
-    // previous per-node cached values before lowering a new function (constants + fn prototypes are safe).
-    for (size_t j = 0; j < p->nodes_cap; j++) {
-      NodeRec* x = p->nodes[j];
-      if (!x) continue;
-      if (strcmp(x->tag, "fn") == 0) continue;
-      if (strncmp(x->tag, "const.", 6) == 0) continue;
-      x->llvm_value = NULL;
-      x->resolving = false;
-    }
+    if (!lower_fn_proto(p, ctx, mod, n)) return false;
+  }
+  return true;
+}
 
-    JsonValue* paramsv = n->fields ? json_obj_get(n->fields, "params") : NULL;
-    if (!paramsv || paramsv->type != JSON_ARRAY) {
-      SIRCC_ERR_NODE(p, n, "sircc.fn.params.missing", "sircc: fn node %lld missing params array", (long long)n->id);
-      return false;
-    }
+static bool lower_fn_body(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod, NodeRec* n) {
+  LLVMValueRef fn = n->llvm_value;
+  JsonValue* paramsv = n->fields ? json_obj_get_sym(n->fields, JSON_KEY_PARAMS) : NULL;
+  if (!paramsv || paramsv->type != JSON_ARRAY) {
+    SIRCC_ERR_NODE(p, n, "sircc.fn.params.missing", "sircc: fn node %lld missing params array", (long long)n->id);
+    return false;
+  }
 
-    FunctionCtx f = {.p = p, .ctx = ctx, .mod = mod, .builder = NULL, .fn = fn};
+  FunctionCtx f = {.p = p, .ctx = ctx, .mod = mod, .builder = NULL, .fn = fn};
 
-    unsigned param_count = LLVMCountParams(fn);
-    if (paramsv->v.arr.len != (size_t)param_count) {
-      SIRCC_ERR_NODE(p, n, "sircc.fn.params.count_mismatch",
-                     "sircc: fn node %lld param count mismatch: node has %zu, type has %u", (long long)n->id, paramsv->v.arr.len,
-                     param_count);
-      free(f.binds);
-      return false;
-    }
+  unsigned param_count = LLVMCountParams(fn);
+  if (paramsv->v.arr.len != (size_t)param_count) {
+    SIRCC_ERR_NODE(p, n, "sircc.fn.params.count_mismatch",
+                   "sircc: fn node %lld param count mismatch: node has %zu, type has %u", (long long)n->id, paramsv->v.arr.len,
+                   param_count);
+    free(f.binds);
+    return false;
+  }
 
 	    for (unsigned pi = 0; pi < param_count; pi++) {
 		      int64_t pid = 0;
@@ -713,32 +735,33 @@ bool lower_functions(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod) {
 		        free(f.binds);
 		        return false;
 		      }
-      NodeRec* pn = get_node(p, pid);
-      if (!pn || strcmp(pn->tag, "param") != 0) {
-        SIRCC_ERR_NODE(p, n, "sircc.fn.param.not_param", "sircc: fn node %lld param ref %lld is not a param node", (long long)n->id,
-                       (long long)pid);
-        free(f.binds);
-        return false;
-      }
-      const char* pname = pn->fields ? json_get_string(json_obj_get(pn->fields, "name")) : NULL;
-      if (!pname) {
-        SIRCC_ERR_NODE(p, pn, "sircc.param.name.missing", "sircc: param node %lld missing fields.name", (long long)pid);
-        free(f.binds);
-        return false;
-      }
-      LLVMValueRef pv = LLVMGetParam(fn, pi);
-      LLVMSetValueName2(pv, pname, strlen(pname));
-      pn->llvm_value = pv;
-      if (!bind_add(&f, pname, pv)) {
-        SIRCC_ERR_NODE(p, n, "sircc.fn.bind.duplicate", "sircc: duplicate binding for '%s' in fn %lld", pname, (long long)n->id);
-        free(f.binds);
-        return false;
-      }
+    NodeRec* pn = get_node(p, pid);
+    if (!pn || strcmp(pn->tag, "param") != 0) {
+      SIRCC_ERR_NODE(p, n, "sircc.fn.param.not_param", "sircc: fn node %lld param ref %lld is not a param node", (long long)n->id,
+                     (long long)pid);
+      free(f.binds);
+      return false;
+    }
+    const char* pname = pn->fields ? json_get_string(json_obj_get_sym(pn->fields, JSON_KEY_NAME)) : NULL;
+    if (!pname) {
+      SIRCC_ERR_NODE(p, pn, "sircc.param.name.missing", "sircc: param node %lld missing fields.name", (long long)pid);
+      free(f.binds);
+      return false;
+    }
+    LLVMValueRef pv = LLVMGetParam(fn, pi);
+    LLVMSetValueName2(pv, pname, strlen(pname));
+    pn->llvm_value = pv;
+    note_lowered_node(p, pn);
+    if (!bind_add(&f, pname, pv)) {
+      SIRCC_ERR_NODE(p, n, "sircc.fn.bind.duplicate", "sircc: duplicate binding for '%s' in fn %lld", pname, (long long)n->id);
+      free(f.binds);
+      return false;
     }
+  }
 
-    JsonValue* blocks_v = n->fields ? json_obj_get(n->fields, "blocks") : NULL;
-    JsonValue* entry_v = n->fields ? json_obj_get(n->fields, "entry") : NULL;
-    if (blocks_v && blocks_v->type == JSON_ARRAY && entry_v) {
+  JsonValue* blocks_v = n->fields ? json_obj_get_sym(n->fields, JSON_KEY_BLOCKS) : NULL;
+  JsonValue* entry_v = n->fields ? json_obj_get_sym(n->fields, JSON_KEY_ENTRY) : NULL;
+  if (blocks_v && blocks_v->type == JSON_ARRAY && entry_v) {
 	      // CFG form: explicit list of basic blocks + entry.
 	      int64_t entry_id = 0;
 		      if (!parse_node_ref_id(p, entry_v, &entry_id)) {
@@ -747,11 +770,11 @@ bool lower_functions(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod) {
 		        return false;
 		      }
 
-      f.blocks_by_node = (LLVMBasicBlockRef*)calloc(p->nodes_cap, sizeof(LLVMBasicBlockRef));
-      if (!f.blocks_by_node) {
-        free(f.binds);
-        return false;
-      }
+    f.blocks_by_node = (LLVMBasicBlockRef*)calloc(p->nodes_cap, sizeof(LLVMBasicBlockRef));
+    if (!f.blocks_by_node) {
+      free(f.binds);
+      return false;
+    }
 
 		      for (size_t bi = 0; bi < blocks_v->v.arr.len; bi++) {
 		        int64_t bid = 0;
@@ -769,25 +792,25 @@ bool lower_functions(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod) {
 	          free(f.binds);
 	          return false;
 	        }
-        if (bid < 0 || (size_t)bid >= p->nodes_cap) continue;
-        if (!f.blocks_by_node[bid]) {
-          char namebuf[32];
-          snprintf(namebuf, sizeof(namebuf), "B%lld", (long long)bid);
-          f.blocks_by_node[bid] = LLVMAppendBasicBlockInContext(ctx, fn, namebuf);
-        }
+      if (bid < 0 || (size_t)bid >= p->nodes_cap) continue;
+      if (!f.blocks_by_node[bid]) {
+        char namebuf[32];
+        snprintf(namebuf, sizeof(namebuf), "B%lld", (long long)bid);
+        f.blocks_by_node[bid] = LLVMAppendBasicBlockInContext(ctx, fn, namebuf);
       }
+    }
 
-      // Ensure entry exists.
-      if (entry_id < 0 || (size_t)entry_id >= p->nodes_cap || !f.blocks_by_node[entry_id]) {
-        SIRCC_ERR_NODE(p, n, "sircc.fn.entry.not_in_blocks",
-                       "sircc: fn node %lld entry block %lld not in blocks list", (long long)n->id, (long long)entry_id);
-        free(f.blocks_by_node);
-        free(f.binds);
-        return false;
-      }
+    // Ensure entry exists.
+    if (entry_id < 0 || (size_t)entry_id >= p->nodes_cap || !f.blocks_by_node[entry_id]) {
+      SIRCC_ERR_NODE(p, n, "sircc.fn.entry.not_in_blocks",
+                     "sircc: fn node %lld entry block %lld not in blocks list", (long long)n->id, (long long)entry_id);
+      free(f.blocks_by_node);
+      free(f.binds);
+      return false;
+    }
 
-      // Pre-create PHIs for block params so branches can add incoming values regardless of block order.
-      // (Otherwise, a forward branch would see pn->llvm_value == NULL.)
+    // Pre-create PHIs for block params so branches can add incoming values regardless of block order.
+    // (Otherwise, a forward branch would see pn->llvm_value == NULL.)
 	      for (size_t bi = 0; bi < blocks_v->v.arr.len; bi++) {
 	        int64_t bid = 0;
 	        if (!parse_node_ref_id(p, blocks_v->v.arr.items[bi], &bid)) continue;
@@ -795,7 +818,7 @@ bool lower_functions(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod) {
 	        LLVMBasicBlockRef bb = f.blocks_by_node[bid];
 	        if (!bn || !bb || !bn->fields) continue;
 
-        JsonValue* params = json_obj_get(bn->fields, "params");
+      JsonValue* params = json_obj_get_sym(bn->fields, JSON_KEY_PARAMS);
 	        if (!params) continue;
 	        if (params->type != JSON_ARRAY) {
 	          SIRCC_ERR_NODE(p, bn, "sircc.block.params.not_array", "sircc: block %lld params must be an array", (long long)bid);
@@ -804,10 +827,10 @@ bool lower_functions(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod) {
 	          return false;
 	        }
 
-        LLVMBuilderRef b = LLVMCreateBuilderInContext(ctx);
-        LLVMValueRef first = LLVMGetFirstInstruction(bb);
-        if (first) LLVMPositionBuilderBefore(b, first);
-        else LLVMPositionBuilderAtEnd(b, bb);
+      LLVMBuilderRef b = LLVMCreateBuilderInContext(ctx);
+      LLVMValueRef first = LLVMGetFirstInstruction(bb);
+      if (first) LLVMPositionBuilderBefore(b, first);
+      else LLVMPositionBuilderAtEnd(b, bb);
 
 		        for (size_t pi = 0; pi < params->v.arr.len; pi++) {
 		          int64_t pid = 0;
@@ -843,29 +866,30 @@ bool lower_functions(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod) {
 	              free(f.binds);
 	              return false;
 	            }
-            pn->llvm_value = LLVMBuildPhi(b, pty, "bparam");
-          }
+          pn->llvm_value = LLVMBuildPhi(b, pty, "bparam");
+          note_lowered_node(p, pn);
         }
-
-        LLVMDisposeBuilder(b);
       }
 
+      LLVMDisposeBuilder(b);
+    }
+
 	      // Lower blocks in listed order.
 	      for (size_t bi = 0; bi < blocks_v->v.arr.len; bi++) {
 	        int64_t bid = 0;
 	        (void)parse_node_ref_id(p, blocks_v->v.arr.items[bi], &bid);
 	        NodeRec* bn = get_node(p, bid);
 	        LLVMBasicBlockRef bb = f.blocks_by_node[bid];
-        if (!bn || !bb) continue;
+      if (!bn || !bb) continue;
 
-        LLVMBuilderRef builder = LLVMCreateBuilderInContext(ctx);
-        f.builder = builder;
-        LLVMPositionBuilderAtEnd(builder, bb);
+      LLVMBuilderRef builder = LLVMCreateBuilderInContext(ctx);
+      f.builder = builder;
+      LLVMPositionBuilderAtEnd(builder, bb);
 
-        size_t mark = bind_mark(&f);
+      size_t mark = bind_mark(&f);
 
-        // Block params: lowered as PHIs (to be populated by predecessors via branch args).
-        JsonValue* params = bn->fields ? json_obj_get(bn->fields, "params") : NULL;
+      // Block params: lowered as PHIs (to be populated by predecessors via branch args).
+      JsonValue* params = bn->fields ? json_obj_get_sym(bn->fields, JSON_KEY_PARAMS) : NULL;
 	        if (params) {
 	          if (params->type != JSON_ARRAY) {
 	            SIRCC_ERR_NODE(p, bn, "sircc.block.params.not_array", "sircc: block %lld params must be an array", (long long)bid);
@@ -899,8 +923,8 @@ bool lower_functions(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod) {
 	              free(f.binds);
 	              return false;
 	            }
-            const char* bname = pn->fields ? json_get_string(json_obj_get(pn->fields, "name")) : NULL;
-            if (bname) {
+          const char* bname = pn->fields ? json_get_string(json_obj_get_sym(pn->fields, JSON_KEY_NAME)) : NULL;
+          if (bname) {
 	              LLVMSetValueName2(pn->llvm_value, bname, strlen(bname));
 	              if (!bind_add(&f, bname, pn->llvm_value)) {
 	                SIRCC_ERR_NODE(p, n, "sircc.fn.block_param.bind.failed", "sircc: failed to bind block param '%s' in fn %lld", bname,
@@ -910,11 +934,11 @@ bool lower_functions(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod) {
 	                free(f.binds);
 	                return false;
 	              }
-            }
           }
         }
+      }
 
-	        JsonValue* stmts = bn->fields ? json_obj_get(bn->fields, "stmts") : NULL;
+	        JsonValue* stmts = bn->fields ? json_obj_get_sym(bn->fields, JSON_KEY_STMTS) : NULL;
 	        if (!stmts || stmts->type != JSON_ARRAY) {
 	          SIRCC_ERR_NODE(p, bn, "sircc.block.stmts.bad", "sircc: block node %lld missing stmts array", (long long)bid);
 	          LLVMDisposeBuilder(builder);
@@ -922,8 +946,8 @@ bool lower_functions(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod) {
 	          free(f.binds);
 	          return false;
 	        }
-        for (size_t si = 0; si < stmts->v.arr.len; si++) {
-          int64_t sid = 0;
+      for (size_t si = 0; si < stmts->v.arr.len; si++) {
+        int64_t sid = 0;
 	          if (!parse_node_ref_id(p, stmts->v.arr.items[si], &sid)) {
 	            SIRCC_ERR_NODE(p, bn, "sircc.block.stmt.ref_bad", "sircc: block node %lld has non-ref stmt", (long long)bid);
 	            LLVMDisposeBuilder(builder);
@@ -931,14 +955,14 @@ bool lower_functions(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod) {
 	            free(f.binds);
 	            return false;
 	          }
-          if (!lower_stmt(&f, sid)) {
-            LLVMDisposeBuilder(builder);
-            free(f.blocks_by_node);
-            free(f.binds);
-            return false;
-          }
-          if (LLVMGetBasicBlockTerminator(LLVMGetInsertBlock(builder))) break;
+        if (!lower_stmt(&f, sid)) {
+          LLVMDisposeBuilder(builder);
+          free(f.blocks_by_node);
+          free(f.binds);
+          return false;
         }
+        if (LLVMGetBasicBlockTerminator(LLVMGetInsertBlock(builder))) break;
+      }
 
 	        if (!LLVMGetBasicBlockTerminator(bb)) {
 	          SIRCC_ERR_NODE(p, bn, "sircc.block.term.missing", "sircc: block %lld missing terminator", (long long)bid);
@@ -949,65 +973,107 @@ bool lower_functions(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod) {
 	          return false;
 	        }
 
-        LLVMDisposeBuilder(builder);
-        bind_restore(&f, mark);
-        f.builder = NULL;
-      }
-
-      // Ensure entry is first for execution: create a trampoline if needed.
-      LLVMBasicBlockRef first = LLVMGetFirstBasicBlock(fn);
-      if (first != f.blocks_by_node[entry_id]) {
-        LLVMBasicBlockRef tramp = LLVMInsertBasicBlockInContext(ctx, first, "entry");
-        LLVMBuilderRef builder = LLVMCreateBuilderInContext(ctx);
-        LLVMPositionBuilderAtEnd(builder, tramp);
-        LLVMBuildBr(builder, f.blocks_by_node[entry_id]);
-        LLVMDisposeBuilder(builder);
-      }
-
-      free(f.blocks_by_node);
-      free(f.binds);
-      continue;
+      LLVMDisposeBuilder(builder);
+      bind_restore(&f, mark);
+      f.builder = NULL;
     }
 
-    // Legacy form: single entry block with `body:ref`.
-    JsonValue* bodyv = n->fields ? json_obj_get(n->fields, "body") : NULL;
-    int64_t body_id = 0;
-    if (!parse_node_ref_id(p, bodyv, &body_id)) {
-      SIRCC_ERR_NODE(p, n, "sircc.fn.body.ref_bad", "sircc: fn node %lld missing body ref", (long long)n->id);
-      free(f.binds);
-      return false;
+    // Ensure entry is first for execution: create a trampoline if needed.
+    LLVMBasicBlockRef first = LLVMGetFirstBasicBlock(fn);
+    if (first != f.blocks_by_node[entry_id]) {
+      LLVMBasicBlockRef tramp = LLVMInsertBasicBlockInContext(ctx, first, "entry");
+      LLVMBuilderRef builder = LLVMCreateBuilderInContext(ctx);
+      LLVMPositionBuilderAtEnd(builder, tramp);
+      LLVMBuildBr(builder, f.blocks_by_node[entry_id]);
+      LLVMDisposeBuilder(builder);
     }
 
-    LLVMBasicBlockRef entry = LLVMAppendBasicBlockInContext(ctx, fn, "entry");
-    LLVMBuilderRef builder = LLVMCreateBuilderInContext(ctx);
-    f.builder = builder;
-    LLVMPositionBuilderAtEnd(builder, entry);
+    free(f.blocks_by_node);
+    free(f.binds);
+    return true;
+  }
+
+  // Legacy form: single entry block with `body:ref`.
+  JsonValue* bodyv = n->fields ? json_obj_get_sym(n->fields, JSON_KEY_BODY) : NULL;
+  int64_t body_id = 0;
+  if (!parse_node_ref_id(p, bodyv, &body_id)) {
+    SIRCC_ERR_NODE(p, n, "sircc.fn.body.ref_bad", "sircc: fn node %lld missing body ref", (long long)n->id);
+    free(f.binds);
+    return false;
+  }
+
+  LLVMBasicBlockRef entry = LLVMAppendBasicBlockInContext(ctx, fn, "entry");
+  LLVMBuilderRef builder = LLVMCreateBuilderInContext(ctx);
+  f.builder = builder;
+  LLVMPositionBuilderAtEnd(builder, entry);
+
+  if (!lower_stmt(&f, body_id)) {
+    LLVMDisposeBuilder(builder);
+    free(f.binds);
+    return false;
+  }
 
-    if (!lower_stmt(&f, body_id)) {
+  if (!LLVMGetBasicBlockTerminator(LLVMGetInsertBlock(builder))) {
+    // Conservative default: fallthrough returns 0 for integer returns, otherwise void.
+    LLVMTypeRef rty = LLVMGetReturnType(LLVMGlobalGetValueType(fn));
+    if (LLVMGetTypeKind(rty) == LLVMVoidTypeKind) {
+      LLVMBuildRetVoid(builder);
+    } else if (LLVMGetTypeKind(rty) == LLVMIntegerTypeKind) {
+      LLVMBuildRet(builder, LLVMConstInt(rty, 0, 0));
+    } else {
+      SIRCC_ERR_NODE(p, n, "sircc.fn.fallthrough.ret_unsupported",
+                     "sircc: fn %lld has implicit fallthrough with unsupported return type", (long long)n->id);
       LLVMDisposeBuilder(builder);
       free(f.binds);
       return false;
     }
+  }
 
-    if (!LLVMGetBasicBlockTerminator(LLVMGetInsertBlock(builder))) {
-      // Conservative default: fallthrough returns 0 for integer returns, otherwise void.
-      LLVMTypeRef rty = LLVMGetReturnType(LLVMGlobalGetValueType(fn));
-      if (LLVMGetTypeKind(rty) == LLVMVoidTypeKind) {
-        LLVMBuildRetVoid(builder);
-      } else if (LLVMGetTypeKind(rty) == LLVMIntegerTypeKind) {
-        LLVMBuildRet(builder, LLVMConstInt(rty, 0, 0));
-      } else {
-        SIRCC_ERR_NODE(p, n, "sircc.fn.fallthrough.ret_unsupported",
-                       "sircc: fn %lld has implicit fallthrough with unsupported return type", (long long)n->id);
-        LLVMDisposeBuilder(builder);
-        free(f.binds);
-        return false;
-      }
-    }
+  LLVMDisposeBuilder(builder);
+  free(f.binds);
+  return true;
+}
 
-    LLVMDisposeBuilder(builder);
-    free(f.binds);
+bool lower_functions(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod) {
+  if (!lower_fn_protos(p, ctx, mod)) return false;
+
+  bool swept = false;
+  for (size_t i = 0; i < p->nodes_cap; i++) {
+    NodeRec* n = p->nodes[i];
+    if (!n) continue;
+    if (strcmp(n->tag, "fn") != 0) continue;
+    if (!n->llvm_value) continue;
+
+    // Expression nodes are currently lowered relative to a specific function's builder. Clear any
+    // previous per-node cached values before lowering a new function (constants + fn prototypes are safe).
+    // After the first full sweep only nodes noted since the last reset can hold such values.
+    reset_lowered_nodes(p, !swept);
+    swept = true;
+
+    if (!lower_fn_body(p, ctx, mod, n)) return false;
   }
 
   return true;
 }
+
+bool lower_fn_streamed(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod, NodeRec* fn) {
+  // The caller releases fn's segment next, so nothing may keep per-function state past this call.
+  const bool ok = fn->llvm_value && lower_fn_body(p, ctx, mod, fn);
+  reset_lowered_nodes(p, false);
+  return ok;
+}
+
+bool lower_public_syms(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod) {
+  // Outside any function: initializers are const.* nodes, which lower without a builder.
+  FunctionCtx f = {.p = p, .ctx = ctx, .mod = mod, .builder = NULL, .fn = NULL};
+  bool ok = true;
+  for (size_t i = 0; ok && i < p->syms_cap; i++) {
+    SymRec* s = p->syms[i];
+    if (!s || !s->name || !s->linkage || strcmp(s->linkage, "public") != 0) continue;
+    if (!s->kind || (strcmp(s->kind, "var") != 0 && strcmp(s->kind, "const") != 0)) continue;
+    if (LLVMGetNamedGlobal(mod, s->name)) continue;
+    ok = lower_sym_global(&f, s) != NULL;
+  }
+  free(f.binds);
+  return ok;
+}
@@ -187,7 +187,7 @@ static LLVMValueRef call_closure_value(FunctionCtx* f, int64_t callee_id, LLVMVa
 
 static bool eval_branch_operand(FunctionCtx* f, JsonValue* br, LLVMTypeRef want_ty, LLVMValueRef* out) {
   if (!f || !br || br->type != JSON_OBJECT || !out) return false;
-  const char* kind = json_get_string(json_obj_get(br, "kind"));
+  const char* kind = json_get_string(json_obj_get_sym(br, JSON_KEY_KIND));
   if (!kind) {
     err_codef(f->p, "sircc.sem.branch.kind.missing", "sircc: sem branch operand missing kind");
     return false;
@@ -195,7 +195,7 @@ static bool eval_branch_operand(FunctionCtx* f, JsonValue* br, LLVMTypeRef want_
 
   if (strcmp(kind, "val") == 0) {
     int64_t vid = 0;
-    if (!parse_node_ref_id(f->p, json_obj_get(br, "v"), &vid)) return false;
+    if (!parse_node_ref_id(f->p, json_obj_get_sym(br, JSON_KEY_V), &vid)) return false;
     LLVMValueRef v = lower_expr(f, vid);
     if (!v) return false;
     if (want_ty && LLVMTypeOf(v) != want_ty) {
@@ -213,7 +213,7 @@ static bool eval_branch_operand(FunctionCtx* f, JsonValue* br, LLVMTypeRef want_
 
   if (strcmp(kind, "thunk") == 0) {
     int64_t fid = 0;
-    if (!parse_node_ref_id(f->p, json_obj_get(br, "f"), &fid)) return false;
+    if (!parse_node_ref_id(f->p, json_obj_get_sym(br, JSON_KEY_F), &fid)) return false;
     NodeRec* fn = get_node(f->p, fid);
     if (!fn || fn->type_ref == 0) return false;
     TypeRec* t = get_type(f->p, fn->type_ref);
@@ -332,12 +332,13 @@ LLVMValueRef lower_expr(FunctionCtx* f, int64_t node_id) {
     return NULL;
   }
   n->resolving = true;
+  note_lowered_node(f->p, n);
 
   LLVMValueRef out = NULL;
 
   if (strcmp(n->tag, "name") == 0) {
     const char* name = NULL;
-    if (n->fields) name = json_get_string(json_obj_get(n->fields, "name"));
+    if (n->fields) name = json_get_string(json_obj_get_sym(n->fields, JSON_KEY_NAME));
     if (!name) {
       err_codef(f->p, "sircc.name.fields.name.missing", "sircc: name node %lld missing fields.name", (long long)node_id);
       goto done;
@@ -352,7 +353,7 @@ LLVMValueRef lower_expr(FunctionCtx* f, int64_t node_id) {
       err_codef(f->p, "sircc.decl.fn.fields.missing", "sircc: decl.fn node %lld missing fields", (long long)node_id);
       goto done;
     }
-    const char* name = json_get_string(json_obj_get(n->fields, "name"));
+    const char* name = json_get_string(json_obj_get_sym(n->fields, JSON_KEY_NAME));
     if (!name || !is_ident(name)) {
       err_codef(f->p, "sircc.decl.fn.name.bad", "sircc: decl.fn node %lld requires fields.name Ident", (long long)node_id);
       goto done;
@@ -360,7 +361,7 @@ LLVMValueRef lower_expr(FunctionCtx* f, int64_t node_id) {
 
     int64_t sig_id = n->type_ref;
     if (sig_id == 0) {
-      if (!parse_type_ref_id(f->p, json_obj_get(n->fields, "sig"), &sig_id)) {
+      if (!parse_type_ref_id(f->p, json_obj_get_sym(n->fields, JSON_KEY_SIG), &sig_id)) {
         err_codef(f->p, "sircc.decl.fn.sig.missing",
                   "sircc: decl.fn node %lld requires type_ref or fields.sig (fn type ref)", (long long)node_id);
         goto done;
@@ -394,7 +395,7 @@ LLVMValueRef lower_expr(FunctionCtx* f, int64_t node_id) {
       err_codef(f->p, "sircc.cstr.fields.missing", "sircc: cstr node %lld missing fields", (long long)node_id);
       goto done;
     }
-    const char* s = json_get_string(json_obj_get(n->fields, "value"));
+    const char* s = json_get_string(json_obj_get_sym(n->fields, JSON_KEY_VALUE));
     if (!s) {
       err_codef(f->p, "sircc.cstr.value.bad", "sircc: cstr node %lld requires fields.value string", (long long)node_id);
       goto done;
@@ -426,8 +427,8 @@ LLVMValueRef lower_expr(FunctionCtx* f, int64_t node_id) {
   }
 
   if (strcmp(n->tag, "binop.add") == 0) {
-    JsonValue* lhs = n->fields ? json_obj_get(n->fields, "lhs") : NULL;
-    JsonValue* rhs = n->fields ? json_obj_get(n->fields, "rhs") : NULL;
+    JsonValue* lhs = n->fields ? json_obj_get_sym(n->fields, JSON_KEY_LHS) : NULL;
+    JsonValue* rhs = n->fields ? json_obj_get_sym(n->fields, JSON_KEY_RHS) : NULL;
     int64_t lhs_id = 0, rhs_id = 0;
     if (!parse_node_ref_id(f->p, lhs, &lhs_id) || !parse_node_ref_id(f->p, rhs, &rhs_id)) {
       err_codef(f->p, "sircc.binop.add.args.missing", "sircc: binop.add node %lld missing lhs/rhs refs", (long long)node_id);
@@ -445,492 +446,473 @@ LLVMValueRef lower_expr(FunctionCtx* f, int64_t node_id) {
     goto done;
   }
 
-  if (strncmp(n->tag, "i", 1) == 0) {
+  if (sir_node_family(f->p, n) & SIR_NODE_FAM_INT) {
     // Mnemonic-style integer ops: i8.add, i16.sub, i32.mul, etc.
-    const char* dot = strchr(n->tag, '.');
-    if (dot) {
-      char wbuf[8];
-      size_t wlen = (size_t)(dot - n->tag);
-      if (wlen < sizeof(wbuf)) {
-        memcpy(wbuf, n->tag, wlen);
-        wbuf[wlen] = 0;
-        int width = 0;
-          if (sscanf(wbuf, "i%d", &width) == 1 && (width == 8 || width == 16 || width == 32 || width == 64)) {
-            const char* op = dot + 1;
-          JsonValue* args = n->fields ? json_obj_get(n->fields, "args") : NULL;
-          int64_t a_id = 0, b_id = 0;
-          // Extract operands.
-          LLVMValueRef a = NULL;
-          LLVMValueRef b = NULL;
-
-          if (args && args->type == JSON_ARRAY) {
-            if (args->v.arr.len == 1) {
-              if (!parse_node_ref_id(f->p, args->v.arr.items[0], &a_id)) {
-                err_codef(f->p, "sircc.args.ref_bad", "sircc: %s node %lld args must be node refs", n->tag, (long long)node_id);
-                goto done;
-              }
-              a = lower_expr(f, a_id);
-              if (!a) goto done;
-            } else if (args->v.arr.len == 2) {
-              if (!parse_node_ref_id(f->p, args->v.arr.items[0], &a_id) || !parse_node_ref_id(f->p, args->v.arr.items[1], &b_id)) {
-                err_codef(f->p, "sircc.args.ref_bad", "sircc: %s node %lld args must be node refs", n->tag, (long long)node_id);
-                goto done;
-              }
-              a = lower_expr(f, a_id);
-              b = lower_expr(f, b_id);
-              if (!a || !b) goto done;
-            } else {
-              err_codef(f->p, "sircc.args.arity_bad", "sircc: %s node %lld args must have arity 1 or 2", n->tag, (long long)node_id);
-              goto done;
-            }
-          } else {
-            // Back-compat: allow lhs/rhs form for binary operators.
-            JsonValue* lhs = n->fields ? json_obj_get(n->fields, "lhs") : NULL;
-            JsonValue* rhs = n->fields ? json_obj_get(n->fields, "rhs") : NULL;
-            if (parse_node_ref_id(f->p, lhs, &a_id) && parse_node_ref_id(f->p, rhs, &b_id)) {
-              a = lower_expr(f, a_id);
-              b = lower_expr(f, b_id);
-              if (!a || !b) goto done;
-            } else {
-              err_codef(f->p, "sircc.args.missing", "sircc: %s node %lld missing args", n->tag, (long long)node_id);
-              goto done;
-            }
-          }
+    const int width = (int)sir_node_int_width(f->p, n);
+    const char* op = strchr(n->tag, '.') + 1;
+    const int64_t* av = NULL;
+    size_t ac = 0;
+    const SirNodeArgsState ast = sir_node_args(f->p, n, &av, &ac);
+    int64_t a_id = 0, b_id = 0;
+    // Extract operands.
+    LLVMValueRef a = NULL;
+    LLVMValueRef b = NULL;
+
+    if (ast == SIR_NODE_ARGS_OK || ast == SIR_NODE_ARGS_BAD) {
+      if (ac != 1 && ac != 2) {
+        err_codef(f->p, "sircc.args.arity_bad", "sircc: %s node %lld args must have arity 1 or 2", n->tag, (long long)node_id);
+        goto done;
+      }
+      if (ast != SIR_NODE_ARGS_OK) {
+        err_codef(f->p, "sircc.args.ref_bad", "sircc: %s node %lld args must be node refs", n->tag, (long long)node_id);
+        goto done;
+      }
+      a = lower_expr(f, av[0]);
+      if (!a) goto done;
+      if (ac == 2) {
+        b = lower_expr(f, av[1]);
+        if (!b) goto done;
+      }
+    } else {
+      // Back-compat: allow lhs/rhs form for binary operators.
+      JsonValue* lhs = n->fields ? json_obj_get_sym(n->fields, JSON_KEY_LHS) : NULL;
+      JsonValue* rhs = n->fields ? json_obj_get_sym(n->fields, JSON_KEY_RHS) : NULL;
+      if (parse_node_ref_id(f->p, lhs, &a_id) && parse_node_ref_id(f->p, rhs, &b_id)) {
+        a = lower_expr(f, a_id);
+        b = lower_expr(f, b_id);
+        if (!a || !b) goto done;
+      } else {
+        err_codef(f->p, "sircc.args.missing", "sircc: %s node %lld missing args", n->tag, (long long)node_id);
+        goto done;
+      }
+    }
 
-          // Lower ops.
-          if (strcmp(op, "add") == 0) {
-            out = LLVMBuildAdd(f->builder, a, b, "iadd");
-            goto done;
-          }
-          if (strcmp(op, "sub") == 0) {
-            out = LLVMBuildSub(f->builder, a, b, "isub");
-            goto done;
-          }
-          if (strcmp(op, "mul") == 0) {
-            out = LLVMBuildMul(f->builder, a, b, "imul");
-            goto done;
-          }
-          if (strcmp(op, "and") == 0) {
-            out = LLVMBuildAnd(f->builder, a, b, "iand");
-            goto done;
-          }
-          if (strcmp(op, "or") == 0) {
-            out = LLVMBuildOr(f->builder, a, b, "ior");
-            goto done;
-          }
-          if (strcmp(op, "xor") == 0) {
-            out = LLVMBuildXor(f->builder, a, b, "ixor");
-            goto done;
-          }
-          if (strcmp(op, "not") == 0) {
-            out = LLVMBuildNot(f->builder, a, "inot");
-            goto done;
-          }
-          if (strcmp(op, "neg") == 0) {
-            out = LLVMBuildNeg(f->builder, a, "ineg");
-            goto done;
-          }
-          if (strcmp(op, "eqz") == 0) {
-            if (b) {
-              err_codef(f->p, "sircc.args.arity_bad", "sircc: %s node %lld requires 1 arg", n->tag, (long long)node_id);
-              goto done;
-            }
-            LLVMTypeRef aty = LLVMTypeOf(a);
-            if (LLVMGetTypeKind(aty) != LLVMIntegerTypeKind || LLVMGetIntTypeWidth(aty) != (unsigned)width) {
-              err_codef(f->p, "sircc.operand.type_bad", "sircc: %s requires i%d operand", n->tag, width);
-              goto done;
-            }
-            LLVMValueRef zero = LLVMConstInt(aty, 0, 0);
-            out = LLVMBuildICmp(f->builder, LLVMIntEQ, a, zero, "eqz");
-            goto done;
-          }
-          if (strcmp(op, "min.s") == 0 || strcmp(op, "min.u") == 0 || strcmp(op, "max.s") == 0 || strcmp(op, "max.u") == 0) {
-            if (!b) {
-              err_codef(f->p, "sircc.args.arity_bad", "sircc: %s node %lld requires 2 args", n->tag, (long long)node_id);
-              goto done;
-            }
-            LLVMTypeRef aty = LLVMTypeOf(a);
-            LLVMTypeRef bty = LLVMTypeOf(b);
-            if (LLVMGetTypeKind(aty) != LLVMIntegerTypeKind || LLVMGetTypeKind(bty) != LLVMIntegerTypeKind ||
-                LLVMGetIntTypeWidth(aty) != (unsigned)width || LLVMGetIntTypeWidth(bty) != (unsigned)width) {
-              err_codef(f->p, "sircc.operand.type_bad", "sircc: %s requires i%d operands", n->tag, width);
-              goto done;
-            }
-            bool is_min = (strncmp(op, "min.", 4) == 0);
-            bool is_signed = (op[4] == 's');
-            LLVMIntPredicate pred;
-            if (is_min) pred = is_signed ? LLVMIntSLE : LLVMIntULE;
-            else pred = is_signed ? LLVMIntSGE : LLVMIntUGE;
-            LLVMValueRef cmp = LLVMBuildICmp(f->builder, pred, a, b, "minmax.cmp");
-            out = LLVMBuildSelect(f->builder, cmp, a, b, "minmax");
-            goto done;
-          }
-          if (strcmp(op, "shl") == 0 || strcmp(op, "shr.s") == 0 || strcmp(op, "shr.u") == 0) {
-            if (!b) {
-              err_codef(f->p, "sircc.args.arity_bad", "sircc: %s node %lld requires 2 args", n->tag, (long long)node_id);
-              goto done;
-            }
-            LLVMTypeRef xty = LLVMTypeOf(a);
-            if (LLVMGetTypeKind(xty) != LLVMIntegerTypeKind) {
-              err_codef(f->p, "sircc.operand.type_bad", "sircc: %s node %lld requires integer lhs", n->tag, (long long)node_id);
-              goto done;
-            }
+    // Lower ops.
+    if (strcmp(op, "add") == 0) {
+      out = LLVMBuildAdd(f->builder, a, b, "iadd");
+      goto done;
+    }
+    if (strcmp(op, "sub") == 0) {
+      out = LLVMBuildSub(f->builder, a, b, "isub");
+      goto done;
+    }
+    if (strcmp(op, "mul") == 0) {
+      out = LLVMBuildMul(f->builder, a, b, "imul");
+      goto done;
+    }
+    if (strcmp(op, "and") == 0) {
+      out = LLVMBuildAnd(f->builder, a, b, "iand");
+      goto done;
+    }
+    if (strcmp(op, "or") == 0) {
+      out = LLVMBuildOr(f->builder, a, b, "ior");
+      goto done;
+    }
+    if (strcmp(op, "xor") == 0) {
+      out = LLVMBuildXor(f->builder, a, b, "ixor");
+      goto done;
+    }
+    if (strcmp(op, "not") == 0) {
+      out = LLVMBuildNot(f->builder, a, "inot");
+      goto done;
+    }
+    if (strcmp(op, "neg") == 0) {
+      out = LLVMBuildNeg(f->builder, a, "ineg");
+      goto done;
+    }
+    if (strcmp(op, "eqz") == 0) {
+      if (b) {
+        err_codef(f->p, "sircc.args.arity_bad", "sircc: %s node %lld requires 1 arg", n->tag, (long long)node_id);
+        goto done;
+      }
+      LLVMTypeRef aty = LLVMTypeOf(a);
+      if (LLVMGetTypeKind(aty) != LLVMIntegerTypeKind || LLVMGetIntTypeWidth(aty) != (unsigned)width) {
+        err_codef(f->p, "sircc.operand.type_bad", "sircc: %s requires i%d operand", n->tag, width);
+        goto done;
+      }
+      LLVMValueRef zero = LLVMConstInt(aty, 0, 0);
+      out = LLVMBuildICmp(f->builder, LLVMIntEQ, a, zero, "eqz");
+      goto done;
+    }
+    if (strcmp(op, "min.s") == 0 || strcmp(op, "min.u") == 0 || strcmp(op, "max.s") == 0 || strcmp(op, "max.u") == 0) {
+      if (!b) {
+        err_codef(f->p, "sircc.args.arity_bad", "sircc: %s node %lld requires 2 args", n->tag, (long long)node_id);
+        goto done;
+      }
+      LLVMTypeRef aty = LLVMTypeOf(a);
+      LLVMTypeRef bty = LLVMTypeOf(b);
+      if (LLVMGetTypeKind(aty) != LLVMIntegerTypeKind || LLVMGetTypeKind(bty) != LLVMIntegerTypeKind ||
+          LLVMGetIntTypeWidth(aty) != (unsigned)width || LLVMGetIntTypeWidth(bty) != (unsigned)width) {
+        err_codef(f->p, "sircc.operand.type_bad", "sircc: %s requires i%d operands", n->tag, width);
+        goto done;
+      }
+      bool is_min = (strncmp(op, "min.", 4) == 0);
+      bool is_signed = (op[4] == 's');
+      LLVMIntPredicate pred;
+      if (is_min) pred = is_signed ? LLVMIntSLE : LLVMIntULE;
+      else pred = is_signed ? LLVMIntSGE : LLVMIntUGE;
+      LLVMValueRef cmp = LLVMBuildICmp(f->builder, pred, a, b, "minmax.cmp");
+      out = LLVMBuildSelect(f->builder, cmp, a, b, "minmax");
+      goto done;
+    }
+    if (strcmp(op, "shl") == 0 || strcmp(op, "shr.s") == 0 || strcmp(op, "shr.u") == 0) {
+      if (!b) {
+        err_codef(f->p, "sircc.args.arity_bad", "sircc: %s node %lld requires 2 args", n->tag, (long long)node_id);
+        goto done;
+      }
+      LLVMTypeRef xty = LLVMTypeOf(a);
+      if (LLVMGetTypeKind(xty) != LLVMIntegerTypeKind) {
+        err_codef(f->p, "sircc.operand.type_bad", "sircc: %s node %lld requires integer lhs", n->tag, (long long)node_id);
+        goto done;
+      }
 
-            LLVMTypeRef sty = LLVMTypeOf(b);
-            if (LLVMGetTypeKind(sty) != LLVMIntegerTypeKind) {
-              err_codef(f->p, "sircc.operand.type_bad", "sircc: %s node %lld requires integer shift amount", n->tag, (long long)node_id);
-              goto done;
-            }
+      LLVMTypeRef sty = LLVMTypeOf(b);
+      if (LLVMGetTypeKind(sty) != LLVMIntegerTypeKind) {
+        err_codef(f->p, "sircc.operand.type_bad", "sircc: %s node %lld requires integer shift amount", n->tag, (long long)node_id);
+        goto done;
+      }
 
-            LLVMValueRef shift = b;
-            if (LLVMGetIntTypeWidth(sty) != LLVMGetIntTypeWidth(xty)) {
-              shift = build_zext_or_trunc(f->builder, b, xty, "shift.cast");
-            }
-            unsigned mask = (unsigned)(width - 1);
-            LLVMValueRef maskv = LLVMConstInt(xty, mask, 0);
-            shift = LLVMBuildAnd(f->builder, shift, maskv, "shift.mask");
+      LLVMValueRef shift = b;
+      if (LLVMGetIntTypeWidth(sty) != LLVMGetIntTypeWidth(xty)) {
+        shift = build_zext_or_trunc(f->builder, b, xty, "shift.cast");
+      }
+      unsigned mask = (unsigned)(width - 1);
+      LLVMValueRef maskv = LLVMConstInt(xty, mask, 0);
+      shift = LLVMBuildAnd(f->builder, shift, maskv, "shift.mask");
 
-            if (strcmp(op, "shl") == 0) {
-              out = LLVMBuildShl(f->builder, a, shift, "shl");
-              goto done;
-            }
-            if (strcmp(op, "shr.s") == 0) {
-              out = LLVMBuildAShr(f->builder, a, shift, "ashr");
-              goto done;
-            }
-            out = LLVMBuildLShr(f->builder, a, shift, "lshr");
-            goto done;
-          }
+      if (strcmp(op, "shl") == 0) {
+        out = LLVMBuildShl(f->builder, a, shift, "shl");
+        goto done;
+      }
+      if (strcmp(op, "shr.s") == 0) {
+        out = LLVMBuildAShr(f->builder, a, shift, "ashr");
+        goto done;
+      }
+      out = LLVMBuildLShr(f->builder, a, shift, "lshr");
+      goto done;
+    }
 
-          if (strcmp(op, "div.s.trap") == 0 || strcmp(op, "div.u.trap") == 0 || strcmp(op, "rem.s.trap") == 0 ||
-              strcmp(op, "rem.u.trap") == 0) {
-            if (!b) {
-              err_codef(f->p, "sircc.args.arity_bad", "sircc: %s node %lld requires 2 args", n->tag, (long long)node_id);
-              goto done;
-            }
-            LLVMTypeRef aty = LLVMTypeOf(a);
-            LLVMTypeRef bty = LLVMTypeOf(b);
-            if (LLVMGetTypeKind(aty) != LLVMIntegerTypeKind || LLVMGetTypeKind(bty) != LLVMIntegerTypeKind ||
-                LLVMGetIntTypeWidth(aty) != (unsigned)width || LLVMGetIntTypeWidth(bty) != (unsigned)width) {
-              err_codef(f->p, "sircc.operand.type_bad", "sircc: %s requires i%d operands", n->tag, width);
-              goto done;
-            }
-            LLVMValueRef zero = LLVMConstInt(aty, 0, 0);
-            LLVMValueRef b_is_zero = LLVMBuildICmp(f->builder, LLVMIntEQ, b, zero, "b.iszero");
-            LLVMValueRef trap_cond = b_is_zero;
-
-            bool is_div = (strncmp(op, "div.", 4) == 0);
-            bool is_signed = (op[4] == 's');
-            if (is_div && is_signed) {
-              unsigned long long min_bits = 1ULL << (unsigned)(width - 1);
-              LLVMValueRef minv = LLVMConstInt(aty, min_bits, 0);
-              LLVMValueRef neg1 = LLVMConstAllOnes(aty);
-              LLVMValueRef a_is_min = LLVMBuildICmp(f->builder, LLVMIntEQ, a, minv, "a.ismin");
-              LLVMValueRef b_is_neg1 = LLVMBuildICmp(f->builder, LLVMIntEQ, b, neg1, "b.isneg1");
-              LLVMValueRef ov = LLVMBuildAnd(f->builder, a_is_min, b_is_neg1, "div.ov");
-              trap_cond = LLVMBuildOr(f->builder, trap_cond, ov, "trap.cond");
-            }
-            if (!emit_trap_if(f, trap_cond)) goto done;
+    if (strcmp(op, "div.s.trap") == 0 || strcmp(op, "div.u.trap") == 0 || strcmp(op, "rem.s.trap") == 0 ||
+        strcmp(op, "rem.u.trap") == 0) {
+      if (!b) {
+        err_codef(f->p, "sircc.args.arity_bad", "sircc: %s node %lld requires 2 args", n->tag, (long long)node_id);
+        goto done;
+      }
+      LLVMTypeRef aty = LLVMTypeOf(a);
+      LLVMTypeRef bty = LLVMTypeOf(b);
+      if (LLVMGetTypeKind(aty) != LLVMIntegerTypeKind || LLVMGetTypeKind(bty) != LLVMIntegerTypeKind ||
+          LLVMGetIntTypeWidth(aty) != (unsigned)width || LLVMGetIntTypeWidth(bty) != (unsigned)width) {
+        err_codef(f->p, "sircc.operand.type_bad", "sircc: %s requires i%d operands", n->tag, width);
+        goto done;
+      }
+      LLVMValueRef zero = LLVMConstInt(aty, 0, 0);
+      LLVMValueRef b_is_zero = LLVMBuildICmp(f->builder, LLVMIntEQ, b, zero, "b.iszero");
+      LLVMValueRef trap_cond = b_is_zero;
+
+      bool is_div = (strncmp(op, "div.", 4) == 0);
+      bool is_signed = (op[4] == 's');
+      if (is_div && is_signed) {
+        unsigned long long min_bits = 1ULL << (unsigned)(width - 1);
+        LLVMValueRef minv = LLVMConstInt(aty, min_bits, 0);
+        LLVMValueRef neg1 = LLVMConstAllOnes(aty);
+        LLVMValueRef a_is_min = LLVMBuildICmp(f->builder, LLVMIntEQ, a, minv, "a.ismin");
+        LLVMValueRef b_is_neg1 = LLVMBuildICmp(f->builder, LLVMIntEQ, b, neg1, "b.isneg1");
+        LLVMValueRef ov = LLVMBuildAnd(f->builder, a_is_min, b_is_neg1, "div.ov");
+        trap_cond = LLVMBuildOr(f->builder, trap_cond, ov, "trap.cond");
+      }
+      if (!emit_trap_if(f, trap_cond)) goto done;
 
-            if (is_div) {
-              out = is_signed ? LLVMBuildSDiv(f->builder, a, b, "div") : LLVMBuildUDiv(f->builder, a, b, "div");
-            } else {
-              out = is_signed ? LLVMBuildSRem(f->builder, a, b, "rem") : LLVMBuildURem(f->builder, a, b, "rem");
-            }
-            goto done;
-          }
+      if (is_div) {
+        out = is_signed ? LLVMBuildSDiv(f->builder, a, b, "div") : LLVMBuildUDiv(f->builder, a, b, "div");
+      } else {
+        out = is_signed ? LLVMBuildSRem(f->builder, a, b, "rem") : LLVMBuildURem(f->builder, a, b, "rem");
+      }
+      goto done;
+    }
 
-          if (strncmp(op, "trunc_sat_f", 11) == 0) {
-            // iN.trunc_sat_f32.s / iN.trunc_sat_f32.u (and f64.*)
-            if (!args || args->type != JSON_ARRAY || args->v.arr.len != 1) {
-              err_codef(f->p, "sircc.args.bad", "sircc: %s node %lld requires args:[x]", n->tag, (long long)node_id);
-              goto done;
-            }
-            int srcw = 0;
-            char su = 0;
-            if (sscanf(op, "trunc_sat_f%d.%c", &srcw, &su) != 2 || (srcw != 32 && srcw != 64) || (su != 's' && su != 'u')) {
-              err_codef(f->p, "sircc.trunc_sat.form.bad", "sircc: unsupported trunc_sat form '%s' in %s", op, n->tag);
-              goto done;
-            }
-            int64_t x_id = 0;
-            if (!parse_node_ref_id(f->p, args->v.arr.items[0], &x_id)) {
-              err_codef(f->p, "sircc.args.ref_bad", "sircc: %s node %lld arg must be node ref", n->tag, (long long)node_id);
-              goto done;
-            }
-            LLVMValueRef x = lower_expr(f, x_id);
-            if (!x) goto done;
+    if (strncmp(op, "trunc_sat_f", 11) == 0) {
+      // iN.trunc_sat_f32.s / iN.trunc_sat_f32.u (and f64.*)
+      if (ast != SIR_NODE_ARGS_OK || ac != 1) {
+        err_codef(f->p, "sircc.args.bad", "sircc: %s node %lld requires args:[x]", n->tag, (long long)node_id);
+        goto done;
+      }
+      int srcw = 0;
+      char su = 0;
+      if (sscanf(op, "trunc_sat_f%d.%c", &srcw, &su) != 2 || (srcw != 32 && srcw != 64) || (su != 's' && su != 'u')) {
+        err_codef(f->p, "sircc.trunc_sat.form.bad", "sircc: unsupported trunc_sat form '%s' in %s", op, n->tag);
+        goto done;
+      }
+      LLVMValueRef x = lower_expr(f, av[0]);
+      if (!x) goto done;
 
-            LLVMTypeRef ity = LLVMIntTypeInContext(f->ctx, (unsigned)width);
-            LLVMTypeRef fty = (srcw == 32) ? LLVMFloatTypeInContext(f->ctx) : LLVMDoubleTypeInContext(f->ctx);
-            if (LLVMTypeOf(x) != fty) {
-              err_codef(f->p, "sircc.operand.type_bad", "sircc: %s requires f%d operand", n->tag, srcw);
-              goto done;
-            }
-            if (LLVMGetBasicBlockTerminator(LLVMGetInsertBlock(f->builder))) goto done;
-
-            LLVMBasicBlockRef bb_nan = LLVMAppendBasicBlockInContext(f->ctx, f->fn, "sat.nan");
-            LLVMBasicBlockRef bb_chk1 = LLVMAppendBasicBlockInContext(f->ctx, f->fn, "sat.chk1");
-            LLVMBasicBlockRef bb_min = LLVMAppendBasicBlockInContext(f->ctx, f->fn, "sat.min");
-            LLVMBasicBlockRef bb_chk2 = LLVMAppendBasicBlockInContext(f->ctx, f->fn, "sat.chk2");
-            LLVMBasicBlockRef bb_max = LLVMAppendBasicBlockInContext(f->ctx, f->fn, "sat.max");
-            LLVMBasicBlockRef bb_conv = LLVMAppendBasicBlockInContext(f->ctx, f->fn, "sat.conv");
-            LLVMBasicBlockRef bb_merge = LLVMAppendBasicBlockInContext(f->ctx, f->fn, "sat.merge");
-
-            LLVMValueRef isnan = LLVMBuildFCmp(f->builder, LLVMRealUNO, x, x, "isnan");
-            LLVMBuildCondBr(f->builder, isnan, bb_nan, bb_chk1);
-
-            LLVMPositionBuilderAtEnd(f->builder, bb_nan);
-            LLVMValueRef z = LLVMConstInt(ity, 0, 0);
-            LLVMBuildBr(f->builder, bb_merge);
-
-            LLVMPositionBuilderAtEnd(f->builder, bb_chk1);
-            LLVMValueRef min_i = NULL;
-            LLVMValueRef max_i = NULL;
-            if (su == 's') {
-              unsigned long long min_bits = 1ULL << (unsigned)(width - 1);
-              min_i = LLVMConstInt(ity, min_bits, 0);
-              max_i = LLVMConstInt(ity, min_bits - 1ULL, 0);
-              LLVMValueRef min_f = LLVMBuildSIToFP(f->builder, min_i, fty, "min.f");
-              LLVMValueRef too_low = LLVMBuildFCmp(f->builder, LLVMRealOLT, x, min_f, "too_low");
-              LLVMBuildCondBr(f->builder, too_low, bb_min, bb_chk2);
-            } else {
-              min_i = LLVMConstInt(ity, 0, 0);
-              max_i = LLVMConstAllOnes(ity);
-              LLVMValueRef zf = LLVMConstReal(fty, 0.0);
-              LLVMValueRef too_low = LLVMBuildFCmp(f->builder, LLVMRealOLE, x, zf, "too_low");
-              LLVMBuildCondBr(f->builder, too_low, bb_min, bb_chk2);
-            }
+      LLVMTypeRef ity = LLVMIntTypeInContext(f->ctx, (unsigned)width);
+      LLVMTypeRef fty = (srcw == 32) ? LLVMFloatTypeInContext(f->ctx) : LLVMDoubleTypeInContext(f->ctx);
+      if (LLVMTypeOf(x) != fty) {
+        err_codef(f->p, "sircc.operand.type_bad", "sircc: %s requires f%d operand", n->tag, srcw);
+        goto done;
+      }
+      if (LLVMGetBasicBlockTerminator(LLVMGetInsertBlock(f->builder))) goto done;
+
+      LLVMBasicBlockRef bb_nan = LLVMAppendBasicBlockInContext(f->ctx, f->fn, "sat.nan");
+      LLVMBasicBlockRef bb_chk1 = LLVMAppendBasicBlockInContext(f->ctx, f->fn, "sat.chk1");
+      LLVMBasicBlockRef bb_min = LLVMAppendBasicBlockInContext(f->ctx, f->fn, "sat.min");
+      LLVMBasicBlockRef bb_chk2 = LLVMAppendBasicBlockInContext(f->ctx, f->fn, "sat.chk2");
+      LLVMBasicBlockRef bb_max = LLVMAppendBasicBlockInContext(f->ctx, f->fn, "sat.max");
+      LLVMBasicBlockRef bb_conv = LLVMAppendBasicBlockInContext(f->ctx, f->fn, "sat.conv");
+      LLVMBasicBlockRef bb_merge = LLVMAppendBasicBlockInContext(f->ctx, f->fn, "sat.merge");
+
+      LLVMValueRef isnan = LLVMBuildFCmp(f->builder, LLVMRealUNO, x, x, "isnan");
+      LLVMBuildCondBr(f->builder, isnan, bb_nan, bb_chk1);
+
+      LLVMPositionBuilderAtEnd(f->builder, bb_nan);
+      LLVMValueRef z = LLVMConstInt(ity, 0, 0);
+      LLVMBuildBr(f->builder, bb_merge);
+
+      LLVMPositionBuilderAtEnd(f->builder, bb_chk1);
+      LLVMValueRef min_i = NULL;
+      LLVMValueRef max_i = NULL;
+      if (su == 's') {
+        unsigned long long min_bits = 1ULL << (unsigned)(width - 1);
+        min_i = LLVMConstInt(ity, min_bits, 0);
+        max_i = LLVMConstInt(ity, min_bits - 1ULL, 0);
+        LLVMValueRef min_f = LLVMBuildSIToFP(f->builder, min_i, fty, "min.f");
+        LLVMValueRef too_low = LLVMBuildFCmp(f->builder, LLVMRealOLT, x, min_f, "too_low");
+        LLVMBuildCondBr(f->builder, too_low, bb_min, bb_chk2);
+      } else {
+        min_i = LLVMConstInt(ity, 0, 0);
+        max_i = LLVMConstAllOnes(ity);
+        LLVMValueRef zf = LLVMConstReal(fty, 0.0);
+        LLVMValueRef too_low = LLVMBuildFCmp(f->builder, LLVMRealOLE, x, zf, "too_low");
+        LLVMBuildCondBr(f->builder, too_low, bb_min, bb_chk2);
+      }
 
-            LLVMPositionBuilderAtEnd(f->builder, bb_min);
-            LLVMBuildBr(f->builder, bb_merge);
+      LLVMPositionBuilderAtEnd(f->builder, bb_min);
+      LLVMBuildBr(f->builder, bb_merge);
 
-            LLVMPositionBuilderAtEnd(f->builder, bb_chk2);
-            LLVMValueRef max_f = (su == 's') ? LLVMBuildSIToFP(f->builder, max_i, fty, "max.f") : LLVMBuildUIToFP(f->builder, max_i, fty, "max.f");
-            LLVMValueRef too_high = LLVMBuildFCmp(f->builder, LLVMRealOGE, x, max_f, "too_high");
-            LLVMBuildCondBr(f->builder, too_high, bb_max, bb_conv);
+      LLVMPositionBuilderAtEnd(f->builder, bb_chk2);
+      LLVMValueRef max_f = (su == 's') ? LLVMBuildSIToFP(f->builder, max_i, fty, "max.f") : LLVMBuildUIToFP(f->builder, max_i, fty, "max.f");
+      LLVMValueRef too_high = LLVMBuildFCmp(f->builder, LLVMRealOGE, x, max_f, "too_high");
+      LLVMBuildCondBr(f->builder, too_high, bb_max, bb_conv);
 
-            LLVMPositionBuilderAtEnd(f->builder, bb_max);
-            LLVMBuildBr(f->builder, bb_merge);
+      LLVMPositionBuilderAtEnd(f->builder, bb_max);
+      LLVMBuildBr(f->builder, bb_merge);
 
-            LLVMPositionBuilderAtEnd(f->builder, bb_conv);
-            LLVMValueRef conv = (su == 's') ? LLVMBuildFPToSI(f->builder, x, ity, "fptosi") : LLVMBuildFPToUI(f->builder, x, ity, "fptoui");
-            LLVMBuildBr(f->builder, bb_merge);
+      LLVMPositionBuilderAtEnd(f->builder, bb_conv);
+      LLVMValueRef conv = (su == 's') ? LLVMBuildFPToSI(f->builder, x, ity, "fptosi") : LLVMBuildFPToUI(f->builder, x, ity, "fptoui");
+      LLVMBuildBr(f->builder, bb_merge);
 
-            LLVMPositionBuilderAtEnd(f->builder, bb_merge);
-            LLVMValueRef phi = LLVMBuildPhi(f->builder, ity, "trunc_sat");
-            LLVMValueRef inc_vals[4] = {z, min_i, max_i, conv};
-            LLVMBasicBlockRef inc_bbs[4] = {bb_nan, bb_min, bb_max, bb_conv};
-            LLVMAddIncoming(phi, inc_vals, inc_bbs, 4);
-            out = phi;
-            goto done;
-          }
+      LLVMPositionBuilderAtEnd(f->builder, bb_merge);
+      LLVMValueRef phi = LLVMBuildPhi(f->builder, ity, "trunc_sat");
+      LLVMValueRef inc_vals[4] = {z, min_i, max_i, conv};
+      LLVMBasicBlockRef inc_bbs[4] = {bb_nan, bb_min, bb_max, bb_conv};
+      LLVMAddIncoming(phi, inc_vals, inc_bbs, 4);
+      out = phi;
+      goto done;
+    }
 
-          if (strcmp(op, "div.s.sat") == 0 || strcmp(op, "div.u.sat") == 0 || strcmp(op, "rem.s.sat") == 0 ||
-              strcmp(op, "rem.u.sat") == 0) {
-            if (!b) {
-              err_codef(f->p, "sircc.args.arity_bad", "sircc: %s node %lld requires 2 args", n->tag, (long long)node_id);
-              goto done;
-            }
-            LLVMTypeRef aty = LLVMTypeOf(a);
-            LLVMTypeRef bty = LLVMTypeOf(b);
-            if (LLVMGetTypeKind(aty) != LLVMIntegerTypeKind || LLVMGetTypeKind(bty) != LLVMIntegerTypeKind ||
-                LLVMGetIntTypeWidth(aty) != (unsigned)width || LLVMGetIntTypeWidth(bty) != (unsigned)width) {
-              err_codef(f->p, "sircc.operand.type_bad", "sircc: %s requires i%d operands", n->tag, width);
-              goto done;
-            }
-            if (LLVMGetBasicBlockTerminator(LLVMGetInsertBlock(f->builder))) goto done;
-
-            bool is_div = (strncmp(op, "div.", 4) == 0);
-            bool is_signed = (op[4] == 's');
-
-            LLVMBasicBlockRef cur = LLVMGetInsertBlock(f->builder);
-            LLVMBasicBlockRef bb_zero = LLVMAppendBasicBlockInContext(f->ctx, f->fn, "sat.zero");
-            LLVMBasicBlockRef bb_chk = LLVMAppendBasicBlockInContext(f->ctx, f->fn, "sat.chk");
-            LLVMBasicBlockRef bb_norm = LLVMAppendBasicBlockInContext(f->ctx, f->fn, "sat.norm");
-            LLVMBasicBlockRef bb_over = NULL;
-            LLVMBasicBlockRef bb_merge = LLVMAppendBasicBlockInContext(f->ctx, f->fn, "sat.merge");
-
-            LLVMValueRef zero = LLVMConstInt(aty, 0, 0);
-            LLVMValueRef b_is_zero = LLVMBuildICmp(f->builder, LLVMIntEQ, b, zero, "b.iszero");
-            LLVMBuildCondBr(f->builder, b_is_zero, bb_zero, bb_chk);
-
-            // b==0 case: result 0
-            LLVMPositionBuilderAtEnd(f->builder, bb_zero);
-            LLVMBuildBr(f->builder, bb_merge);
-
-            // check overflow (signed div only), otherwise jump to normal
-            LLVMPositionBuilderAtEnd(f->builder, bb_chk);
-            if (is_div && is_signed) {
-              bb_over = LLVMAppendBasicBlockInContext(f->ctx, f->fn, "sat.over");
-              unsigned long long min_bits = 1ULL << (unsigned)(width - 1);
-              LLVMValueRef minv = LLVMConstInt(aty, min_bits, 0);
-              LLVMValueRef neg1 = LLVMConstAllOnes(aty);
-              LLVMValueRef a_is_min = LLVMBuildICmp(f->builder, LLVMIntEQ, a, minv, "a.ismin");
-              LLVMValueRef b_is_neg1 = LLVMBuildICmp(f->builder, LLVMIntEQ, b, neg1, "b.isneg1");
-              LLVMValueRef ov = LLVMBuildAnd(f->builder, a_is_min, b_is_neg1, "div.ov");
-              LLVMBuildCondBr(f->builder, ov, bb_over, bb_norm);
-
-              LLVMPositionBuilderAtEnd(f->builder, bb_over);
-              LLVMBuildBr(f->builder, bb_merge);
-            } else {
-              LLVMBuildBr(f->builder, bb_norm);
-            }
+    if (strcmp(op, "div.s.sat") == 0 || strcmp(op, "div.u.sat") == 0 || strcmp(op, "rem.s.sat") == 0 ||
+        strcmp(op, "rem.u.sat") == 0) {
+      if (!b) {
+        err_codef(f->p, "sircc.args.arity_bad", "sircc: %s node %lld requires 2 args", n->tag, (long long)node_id);
+        goto done;
+      }
+      LLVMTypeRef aty = LLVMTypeOf(a);
+      LLVMTypeRef bty = LLVMTypeOf(b);
+      if (LLVMGetTypeKind(aty) != LLVMIntegerTypeKind || LLVMGetTypeKind(bty) != LLVMIntegerTypeKind ||
+          LLVMGetIntTypeWidth(aty) != (unsigned)width || LLVMGetIntTypeWidth(bty) != (unsigned)width) {
+        err_codef(f->p, "sircc.operand.type_bad", "sircc: %s requires i%d operands", n->tag, width);
+        goto done;
+      }
+      if (LLVMGetBasicBlockTerminator(LLVMGetInsertBlock(f->builder))) goto done;
+
+      bool is_div = (strncmp(op, "div.", 4) == 0);
+      bool is_signed = (op[4] == 's');
+
+      LLVMBasicBlockRef cur = LLVMGetInsertBlock(f->builder);
+      LLVMBasicBlockRef bb_zero = LLVMAppendBasicBlockInContext(f->ctx, f->fn, "sat.zero");
+      LLVMBasicBlockRef bb_chk = LLVMAppendBasicBlockInContext(f->ctx, f->fn, "sat.chk");
+      LLVMBasicBlockRef bb_norm = LLVMAppendBasicBlockInContext(f->ctx, f->fn, "sat.norm");
+      LLVMBasicBlockRef bb_over = NULL;
+      LLVMBasicBlockRef bb_merge = LLVMAppendBasicBlockInContext(f->ctx, f->fn, "sat.merge");
+
+      LLVMValueRef zero = LLVMConstInt(aty, 0, 0);
+      LLVMValueRef b_is_zero = LLVMBuildICmp(f->builder, LLVMIntEQ, b, zero, "b.iszero");
+      LLVMBuildCondBr(f->builder, b_is_zero, bb_zero, bb_chk);
+
+      // b==0 case: result 0
+      LLVMPositionBuilderAtEnd(f->builder, bb_zero);
+      LLVMBuildBr(f->builder, bb_merge);
+
+      // check overflow (signed div only), otherwise jump to normal
+      LLVMPositionBuilderAtEnd(f->builder, bb_chk);
+      if (is_div && is_signed) {
+        bb_over = LLVMAppendBasicBlockInContext(f->ctx, f->fn, "sat.over");
+        unsigned long long min_bits = 1ULL << (unsigned)(width - 1);
+        LLVMValueRef minv = LLVMConstInt(aty, min_bits, 0);
+        LLVMValueRef neg1 = LLVMConstAllOnes(aty);
+        LLVMValueRef a_is_min = LLVMBuildICmp(f->builder, LLVMIntEQ, a, minv, "a.ismin");
+        LLVMValueRef b_is_neg1 = LLVMBuildICmp(f->builder, LLVMIntEQ, b, neg1, "b.isneg1");
+        LLVMValueRef ov = LLVMBuildAnd(f->builder, a_is_min, b_is_neg1, "div.ov");
+        LLVMBuildCondBr(f->builder, ov, bb_over, bb_norm);
+
+        LLVMPositionBuilderAtEnd(f->builder, bb_over);
+        LLVMBuildBr(f->builder, bb_merge);
+      } else {
+        LLVMBuildBr(f->builder, bb_norm);
+      }
 
-            // normal division/rem
-            LLVMPositionBuilderAtEnd(f->builder, bb_norm);
-            LLVMValueRef norm = NULL;
-            if (is_div) {
-              norm = is_signed ? LLVMBuildSDiv(f->builder, a, b, "div") : LLVMBuildUDiv(f->builder, a, b, "div");
-            } else {
-              norm = is_signed ? LLVMBuildSRem(f->builder, a, b, "rem") : LLVMBuildURem(f->builder, a, b, "rem");
-            }
-            LLVMBuildBr(f->builder, bb_merge);
-
-            // merge
-            LLVMPositionBuilderAtEnd(f->builder, bb_merge);
-            LLVMValueRef phi = LLVMBuildPhi(f->builder, aty, "sat");
-            LLVMValueRef inc_vals[3];
-            LLVMBasicBlockRef inc_bbs[3];
-            unsigned inc_n = 0;
-            inc_vals[inc_n] = zero;
-            inc_bbs[inc_n] = bb_zero;
-            inc_n++;
-            if (bb_over) {
-              unsigned long long min_bits = 1ULL << (unsigned)(width - 1);
-              LLVMValueRef minv = LLVMConstInt(aty, min_bits, 0);
-              inc_vals[inc_n] = minv;
-              inc_bbs[inc_n] = bb_over;
-              inc_n++;
-            }
-            inc_vals[inc_n] = norm;
-            inc_bbs[inc_n] = bb_norm;
-            inc_n++;
-            LLVMAddIncoming(phi, inc_vals, inc_bbs, inc_n);
-            (void)cur;
-            out = phi;
-            goto done;
-          }
+      // normal division/rem
+      LLVMPositionBuilderAtEnd(f->builder, bb_norm);
+      LLVMValueRef norm = NULL;
+      if (is_div) {
+        norm = is_signed ? LLVMBuildSDiv(f->builder, a, b, "div") : LLVMBuildUDiv(f->builder, a, b, "div");
+      } else {
+        norm = is_signed ? LLVMBuildSRem(f->builder, a, b, "rem") : LLVMBuildURem(f->builder, a, b, "rem");
+      }
+      LLVMBuildBr(f->builder, bb_merge);
+
+      // merge
+      LLVMPositionBuilderAtEnd(f->builder, bb_merge);
+      LLVMValueRef phi = LLVMBuildPhi(f->builder, aty, "sat");
+      LLVMValueRef inc_vals[3];
+      LLVMBasicBlockRef inc_bbs[3];
+      unsigned inc_n = 0;
+      inc_vals[inc_n] = zero;
+      inc_bbs[inc_n] = bb_zero;
+      inc_n++;
+      if (bb_over) {
+        unsigned long long min_bits = 1ULL << (unsigned)(width - 1);
+        LLVMValueRef minv = LLVMConstInt(aty, min_bits, 0);
+        inc_vals[inc_n] = minv;
+        inc_bbs[inc_n] = bb_over;
+        inc_n++;
+      }
+      inc_vals[inc_n] = norm;
+      inc_bbs[inc_n] = bb_norm;
+      inc_n++;
+      LLVMAddIncoming(phi, inc_vals, inc_bbs, inc_n);
+      (void)cur;
+      out = phi;
+      goto done;
+    }
 
-          if (strcmp(op, "rotl") == 0 || strcmp(op, "rotr") == 0) {
-            if (!b) {
-              err_codef(f->p, "sircc.args.arity_bad", "sircc: %s node %lld requires 2 args", n->tag, (long long)node_id);
-              goto done;
-            }
-            LLVMTypeRef xty = LLVMTypeOf(a);
-            if (LLVMGetTypeKind(xty) != LLVMIntegerTypeKind) {
-              err_codef(f->p, "sircc.operand.type_bad", "sircc: %s node %lld requires integer lhs", n->tag, (long long)node_id);
-              goto done;
-            }
-            LLVMTypeRef sty = LLVMTypeOf(b);
-            if (LLVMGetTypeKind(sty) != LLVMIntegerTypeKind) {
-              err_codef(f->p, "sircc.operand.type_bad", "sircc: %s node %lld requires integer rotate amount", n->tag, (long long)node_id);
-              goto done;
-            }
-            LLVMValueRef amt = b;
-            if (LLVMGetIntTypeWidth(sty) != LLVMGetIntTypeWidth(xty)) {
-              amt = build_zext_or_trunc(f->builder, b, xty, "rot.cast");
-            }
-            unsigned mask = (unsigned)(width - 1);
-            LLVMValueRef maskv = LLVMConstInt(xty, mask, 0);
-            amt = LLVMBuildAnd(f->builder, amt, maskv, "rot.mask");
-
-            char full[32];
-            snprintf(full, sizeof(full), "llvm.%s.i%d", (strcmp(op, "rotl") == 0) ? "fshl" : "fshr", width);
-            LLVMTypeRef params[3] = {xty, xty, xty};
-            LLVMValueRef fn = get_or_declare_intrinsic(f->mod, full, xty, params, 3);
-            LLVMValueRef argv[3] = {a, a, amt};
-            out = LLVMBuildCall2(f->builder, LLVMGlobalGetValueType(fn), fn, argv, 3, "rot");
-            goto done;
-          }
+    if (strcmp(op, "rotl") == 0 || strcmp(op, "rotr") == 0) {
+      if (!b) {
+        err_codef(f->p, "sircc.args.arity_bad", "sircc: %s node %lld requires 2 args", n->tag, (long long)node_id);
+        goto done;
+      }
+      LLVMTypeRef xty = LLVMTypeOf(a);
+      if (LLVMGetTypeKind(xty) != LLVMIntegerTypeKind) {
+        err_codef(f->p, "sircc.operand.type_bad", "sircc: %s node %lld requires integer lhs", n->tag, (long long)node_id);
+        goto done;
+      }
+      LLVMTypeRef sty = LLVMTypeOf(b);
+      if (LLVMGetTypeKind(sty) != LLVMIntegerTypeKind) {
+        err_codef(f->p, "sircc.operand.type_bad", "sircc: %s node %lld requires integer rotate amount", n->tag, (long long)node_id);
+        goto done;
+      }
+      LLVMValueRef amt = b;
+      if (LLVMGetIntTypeWidth(sty) != LLVMGetIntTypeWidth(xty)) {
+        amt = build_zext_or_trunc(f->builder, b, xty, "rot.cast");
+      }
+      unsigned mask = (unsigned)(width - 1);
+      LLVMValueRef maskv = LLVMConstInt(xty, mask, 0);
+      amt = LLVMBuildAnd(f->builder, amt, maskv, "rot.mask");
+
+      char full[32];
+      snprintf(full, sizeof(full), "llvm.%s.i%d", (strcmp(op, "rotl") == 0) ? "fshl" : "fshr", width);
+      LLVMTypeRef params[3] = {xty, xty, xty};
+      LLVMValueRef fn = get_or_declare_intrinsic(f->mod, full, xty, params, 3);
+      LLVMValueRef argv[3] = {a, a, amt};
+      out = LLVMBuildCall2(f->builder, LLVMGlobalGetValueType(fn), fn, argv, 3, "rot");
+      goto done;
+    }
 
-          if (strncmp(op, "cmp.", 4) == 0) {
-            if (!b) {
-              err_codef(f->p, "sircc.args.arity_bad", "sircc: %s node %lld requires 2 args", n->tag, (long long)node_id);
-              goto done;
-            }
-            const char* cc = op + 4;
-            LLVMIntPredicate pred;
-            if (strcmp(cc, "eq") == 0) pred = LLVMIntEQ;
-            else if (strcmp(cc, "ne") == 0) pred = LLVMIntNE;
-            else if (strcmp(cc, "slt") == 0) pred = LLVMIntSLT;
-            else if (strcmp(cc, "sle") == 0) pred = LLVMIntSLE;
-            else if (strcmp(cc, "sgt") == 0) pred = LLVMIntSGT;
-            else if (strcmp(cc, "sge") == 0) pred = LLVMIntSGE;
-            else if (strcmp(cc, "ult") == 0) pred = LLVMIntULT;
-            else if (strcmp(cc, "ule") == 0) pred = LLVMIntULE;
-            else if (strcmp(cc, "ugt") == 0) pred = LLVMIntUGT;
-            else if (strcmp(cc, "uge") == 0) pred = LLVMIntUGE;
-            else {
-              err_codef(f->p, "sircc.cmp.int.cc.bad", "sircc: unsupported integer compare '%s' in %s", cc, n->tag);
-              goto done;
-            }
-            out = LLVMBuildICmp(f->builder, pred, a, b, "icmp");
-            goto done;
-          }
+    if (strncmp(op, "cmp.", 4) == 0) {
+      if (!b) {
+        err_codef(f->p, "sircc.args.arity_bad", "sircc: %s node %lld requires 2 args", n->tag, (long long)node_id);
+        goto done;
+      }
+      const char* cc = op + 4;
+      LLVMIntPredicate pred;
+      if (strcmp(cc, "eq") == 0) pred = LLVMIntEQ;
+      else if (strcmp(cc, "ne") == 0) pred = LLVMIntNE;
+      else if (strcmp(cc, "slt") == 0) pred = LLVMIntSLT;
+      else if (strcmp(cc, "sle") == 0) pred = LLVMIntSLE;
+      else if (strcmp(cc, "sgt") == 0) pred = LLVMIntSGT;
+      else if (strcmp(cc, "sge") == 0) pred = LLVMIntSGE;
+      else if (strcmp(cc, "ult") == 0) pred = LLVMIntULT;
+      else if (strcmp(cc, "ule") == 0) pred = LLVMIntULE;
+      else if (strcmp(cc, "ugt") == 0) pred = LLVMIntUGT;
+      else if (strcmp(cc, "uge") == 0) pred = LLVMIntUGE;
+      else {
+        err_codef(f->p, "sircc.cmp.int.cc.bad", "sircc: unsupported integer compare '%s' in %s", cc, n->tag);
+        goto done;
+      }
+      out = LLVMBuildICmp(f->builder, pred, a, b, "icmp");
+      goto done;
+    }
 
-          if (strcmp(op, "clz") == 0 || strcmp(op, "ctz") == 0) {
-            const char* iname = (strcmp(op, "clz") == 0) ? "llvm.ctlz" : "llvm.cttz";
-            char full[32];
-            snprintf(full, sizeof(full), "%s.i%d", iname, width);
-            LLVMTypeRef ity = LLVMTypeOf(a);
-            LLVMTypeRef i1 = LLVMInt1TypeInContext(f->ctx);
-            LLVMTypeRef params[2] = {ity, i1};
-            LLVMValueRef fn = get_or_declare_intrinsic(f->mod, full, ity, params, 2);
-            LLVMValueRef argsv[2] = {a, LLVMConstInt(i1, 0, 0)};
-            out = LLVMBuildCall2(f->builder, LLVMGlobalGetValueType(fn), fn, argsv, 2, op);
-            goto done;
-          }
+    if (strcmp(op, "clz") == 0 || strcmp(op, "ctz") == 0) {
+      const char* iname = (strcmp(op, "clz") == 0) ? "llvm.ctlz" : "llvm.cttz";
+      char full[32];
+      snprintf(full, sizeof(full), "%s.i%d", iname, width);
+      LLVMTypeRef ity = LLVMTypeOf(a);
+      LLVMTypeRef i1 = LLVMInt1TypeInContext(f->ctx);
+      LLVMTypeRef params[2] = {ity, i1};
+      LLVMValueRef fn = get_or_declare_intrinsic(f->mod, full, ity, params, 2);
+      LLVMValueRef argsv[2] = {a, LLVMConstInt(i1, 0, 0)};
+      out = LLVMBuildCall2(f->builder, LLVMGlobalGetValueType(fn), fn, argsv, 2, op);
+      goto done;
+    }
 
-          if (strcmp(op, "popc") == 0) {
-            char full[32];
-            snprintf(full, sizeof(full), "llvm.ctpop.i%d", width);
-            LLVMTypeRef ity = LLVMTypeOf(a);
-            LLVMTypeRef params[1] = {ity};
-            LLVMValueRef fn = get_or_declare_intrinsic(f->mod, full, ity, params, 1);
-            LLVMValueRef argsv[1] = {a};
-            out = LLVMBuildCall2(f->builder, LLVMGlobalGetValueType(fn), fn, argsv, 1, "popc");
-            goto done;
-          }
+    if (strcmp(op, "popc") == 0) {
+      char full[32];
+      snprintf(full, sizeof(full), "llvm.ctpop.i%d", width);
+      LLVMTypeRef ity = LLVMTypeOf(a);
+      LLVMTypeRef params[1] = {ity};
+      LLVMValueRef fn = get_or_declare_intrinsic(f->mod, full, ity, params, 1);
+      LLVMValueRef argsv[1] = {a};
+      out = LLVMBuildCall2(f->builder, LLVMGlobalGetValueType(fn), fn, argsv, 1, "popc");
+      goto done;
+    }
 
-          if (strncmp(op, "zext.i", 6) == 0 || strncmp(op, "sext.i", 6) == 0 || strncmp(op, "trunc.i", 7) == 0) {
-            int src = 0;
-            bool is_zext = strncmp(op, "zext.i", 6) == 0;
-            bool is_sext = strncmp(op, "sext.i", 6) == 0;
-            bool is_trunc = strncmp(op, "trunc.i", 7) == 0;
-            const char* num = is_trunc ? (op + 7) : (op + 6);
-            if (sscanf(num, "%d", &src) != 1 || !(src == 8 || src == 16 || src == 32 || src == 64)) {
-              err_codef(f->p, "sircc.cast.mnemonic.bad", "sircc: invalid cast mnemonic '%s'", n->tag);
-              goto done;
-            }
+    if (strncmp(op, "zext.i", 6) == 0 || strncmp(op, "sext.i", 6) == 0 || strncmp(op, "trunc.i", 7) == 0) {
+      int src = 0;
+      bool is_zext = strncmp(op, "zext.i", 6) == 0;
+      bool is_sext = strncmp(op, "sext.i", 6) == 0;
+      bool is_trunc = strncmp(op, "trunc.i", 7) == 0;
+      const char* num = is_trunc ? (op + 7) : (op + 6);
+      if (sscanf(num, "%d", &src) != 1 || !(src == 8 || src == 16 || src == 32 || src == 64)) {
+        err_codef(f->p, "sircc.cast.mnemonic.bad", "sircc: invalid cast mnemonic '%s'", n->tag);
+        goto done;
+      }
 
-            if ((is_zext || is_sext) && width <= src) {
-              err_codef(f->p, "sircc.cast.width.bad", "sircc: %s requires dst width > src width", n->tag);
-              goto done;
-            }
-            if (is_trunc && width >= src) {
-              err_codef(f->p, "sircc.cast.width.bad", "sircc: %s requires dst width < src width", n->tag);
-              goto done;
-            }
+      if ((is_zext || is_sext) && width <= src) {
+        err_codef(f->p, "sircc.cast.width.bad", "sircc: %s requires dst width > src width", n->tag);
+        goto done;
+      }
+      if (is_trunc && width >= src) {
+        err_codef(f->p, "sircc.cast.width.bad", "sircc: %s requires dst width < src width", n->tag);
+        goto done;
+      }
 
-            LLVMTypeRef ity = LLVMTypeOf(a);
-            if (LLVMGetTypeKind(ity) != LLVMIntegerTypeKind || (int)LLVMGetIntTypeWidth(ity) != src) {
-              err_codef(f->p, "sircc.cast.operand.type_bad", "sircc: %s requires i%d operand", n->tag, src);
-              goto done;
-            }
-            LLVMTypeRef dst = LLVMIntTypeInContext(f->ctx, (unsigned)width);
-            if (is_zext) out = LLVMBuildZExt(f->builder, a, dst, "zext");
-            else if (is_sext) out = LLVMBuildSExt(f->builder, a, dst, "sext");
-            else out = LLVMBuildTrunc(f->builder, a, dst, "trunc");
-            goto done;
-          }
-        }
+      LLVMTypeRef ity = LLVMTypeOf(a);
+      if (LLVMGetTypeKind(ity) != LLVMIntegerTypeKind || (int)LLVMGetIntTypeWidth(ity) != src) {
+        err_codef(f->p, "sircc.cast.operand.type_bad", "sircc: %s requires i%d operand", n->tag, src);
+        goto done;
       }
+      LLVMTypeRef dst = LLVMIntTypeInContext(f->ctx, (unsigned)width);
+      if (is_zext) out = LLVMBuildZExt(f->builder, a, dst, "zext");
+      else if (is_sext) out = LLVMBuildSExt(f->builder, a, dst, "sext");
+      else out = LLVMBuildTrunc(f->builder, a, dst, "trunc");
+      goto done;
     }
   }
 
   if (strncmp(n->tag, "bool.", 5) == 0) {
     const char* op = n->tag + 5;
-    JsonValue* args = n->fields ? json_obj_get(n->fields, "args") : NULL;
+    JsonValue* args = n->fields ? json_obj_get_sym(n->fields, JSON_KEY_ARGS) : NULL;
     if (!args || args->type != JSON_ARRAY) {
       err_codef(f->p, "sircc.bool.args.missing", "sircc: %s node %lld missing args array", n->tag, (long long)node_id);
       goto done;
@@ -973,7 +955,7 @@ LLVMValueRef lower_expr(FunctionCtx* f, int64_t node_id) {
   }
 
   if (strcmp(n->tag, "select") == 0) {
-    JsonValue* args = n->fields ? json_obj_get(n->fields, "args") : NULL;
+    JsonValue* args = n->fields ? json_obj_get_sym(n->fields, JSON_KEY_ARGS) : NULL;
     if (!args || args->type != JSON_ARRAY || args->v.arr.len != 3) {
       err_codef(f->p, "sircc.select.args.bad", "sircc: select node %lld requires args:[cond, then, else]", (long long)node_id);
       goto done;
@@ -981,7 +963,7 @@ LLVMValueRef lower_expr(FunctionCtx* f, int64_t node_id) {
     int64_t ty_id = 0;
     bool has_ty = false;
     if (n->fields) {
-      JsonValue* tyv = json_obj_get(n->fields, "ty");
+      JsonValue* tyv = json_obj_get_sym(n->fields, JSON_KEY_TY);
       if (tyv && parse_type_ref_id(f->p, tyv, &ty_id)) has_ty = true;
     }
     int64_t c_id = 0, t_id = 0, e_id = 0;
@@ -1026,7 +1008,7 @@ LLVMValueRef lower_expr(FunctionCtx* f, int64_t node_id) {
       err_codef(f->p, "sircc.call.fields.missing", "sircc: call node %lld missing fields", (long long)node_id);
       goto done;
     }
-    JsonValue* callee_v = json_obj_get(n->fields, "callee");
+    JsonValue* callee_v = json_obj_get_sym(n->fields, JSON_KEY_CALLEE);
     int64_t callee_id = 0;
     if (!parse_node_ref_id(f->p, callee_v, &callee_id)) {
       err_codef(f->p, "sircc.call.callee.ref_bad", "sircc: call node %lld missing callee ref", (long long)node_id);
@@ -1040,7 +1022,7 @@ LLVMValueRef lower_expr(FunctionCtx* f, int64_t node_id) {
     }
     LLVMValueRef callee = callee_n->llvm_value;
 
-    JsonValue* args = json_obj_get(n->fields, "args");
+    JsonValue* args = json_obj_get_sym(n->fields, JSON_KEY_ARGS);
     if (!args || args->type != JSON_ARRAY) {
       err_codef(f->p, "sircc.call.args.bad", "sircc: call node %lld missing args array", (long long)node_id);
       goto done;
@@ -1132,7 +1114,7 @@ LLVMValueRef lower_expr(FunctionCtx* f, int64_t node_id) {
     }
 
     int64_t sig_id = 0;
-    if (!parse_type_ref_id(f->p, json_obj_get(n->fields, "sig"), &sig_id)) {
+    if (!parse_type_ref_id(f->p, json_obj_get_sym(n->fields, JSON_KEY_SIG), &sig_id)) {
       err_codef(f->p, "sircc.call.indirect.sig.missing",
                 "sircc: call.indirect node %lld missing fields.sig (fn type ref)", (long long)node_id);
       goto done;
@@ -1144,7 +1126,7 @@ LLVMValueRef lower_expr(FunctionCtx* f, int64_t node_id) {
       goto done;
     }
 
-    JsonValue* args = json_obj_get(n->fields, "args");
+    JsonValue* args = json_obj_get_sym(n->fields, JSON_KEY_ARGS);
     if (!args || args->type != JSON_ARRAY || args->v.arr.len < 1) {
       err_codef(f->p, "sircc.call.indirect.args.bad",
                 "sircc: call.indirect node %lld requires args:[callee_ptr, ...]", (long long)node_id);
@@ -1259,7 +1241,7 @@ LLVMValueRef lower_expr(FunctionCtx* f, int64_t node_id) {
       goto done;
     }
 
-    JsonValue* args = json_obj_get(n->fields, "args");
+    JsonValue* args = json_obj_get_sym(n->fields, JSON_KEY_ARGS);
     if (!args || args->type != JSON_ARRAY || args->v.arr.len < 1) {
       err_codef(f->p, "sircc.call.fun.args_bad", "sircc: call.fun node %lld requires args:[callee, ...]", (long long)node_id);
       goto done;
@@ -1330,7 +1312,7 @@ LLVMValueRef lower_expr(FunctionCtx* f, int64_t node_id) {
       goto done;
     }
 
-    JsonValue* args = json_obj_get(n->fields, "args");
+    JsonValue* args = json_obj_get_sym(n->fields, JSON_KEY_ARGS);
     if (!args || args->type != JSON_ARRAY || args->v.arr.len < 1) {
       err_codef(f->p, "sircc.call.closure.args_bad", "sircc: call.closure node %lld requires args:[callee, ...]", (long long)node_id);
       goto done;
@@ -1407,7 +1389,7 @@ LLVMValueRef lower_expr(FunctionCtx* f, int64_t node_id) {
       want = lower_type(f->p, f->ctx, n->type_ref);
       if (!want) goto done;
     }
-    JsonValue* args = json_obj_get(n->fields, "args");
+    JsonValue* args = json_obj_get_sym(n->fields, JSON_KEY_ARGS);
     if (!args || args->type != JSON_ARRAY || args->v.arr.len != 3) {
       err_codef(f->p, "sircc.sem.if.args_bad",
                 "sircc: sem.if node %lld requires args:[cond, thenBranch, elseBranch]", (long long)node_id);
@@ -1457,7 +1439,7 @@ LLVMValueRef lower_expr(FunctionCtx* f, int64_t node_id) {
       err_codef(f->p, "sircc.sem.sc.missing_fields", "sircc: %s node %lld missing fields", n->tag, (long long)node_id);
       goto done;
     }
-    JsonValue* args = json_obj_get(n->fields, "args");
+    JsonValue* args = json_obj_get_sym(n->fields, JSON_KEY_ARGS);
     if (!args || args->type != JSON_ARRAY || args->v.arr.len != 2) {
       err_codef(f->p, "sircc.sem.sc.args_bad", "sircc: %s node %lld requires args:[lhs, rhsBranch]", n->tag, (long long)node_id);
       goto done;
@@ -1535,7 +1517,7 @@ LLVMValueRef lower_expr(FunctionCtx* f, int64_t node_id) {
       if (!want) goto done;
     }
     int64_t sum_ty_id = 0;
-    if (!parse_type_ref_id(f->p, json_obj_get(n->fields, "sum"), &sum_ty_id)) {
+    if (!parse_type_ref_id(f->p, json_obj_get_sym(n->fields, JSON_KEY_SUM), &sum_ty_id)) {
       err_codef(f->p, "sircc.sem.match_sum.sum_missing",
                 "sircc: sem.match_sum node %lld missing fields.sum (sum type)", (long long)node_id);
       goto done;
@@ -1545,23 +1527,24 @@ LLVMValueRef lower_expr(FunctionCtx* f, int64_t node_id) {
       err_codef(f->p, "sircc.sem.match_sum.sum_bad", "sircc: sem.match_sum fields.sum must reference a sum type");
       goto done;
     }
-    JsonValue* args = json_obj_get(n->fields, "args");
-    if (!args || args->type != JSON_ARRAY || args->v.arr.len != 1) {
+    int64_t arg_ids[1];
+    bool refs_ok = false;
+    if (!sir_node_args_n(f->p, n, 1, arg_ids, &refs_ok)) {
       err_codef(f->p, "sircc.sem.match_sum.args_bad",
                 "sircc: sem.match_sum node %lld requires args:[scrut]", (long long)node_id);
       goto done;
     }
-    int64_t scrut_id = 0;
-    if (!parse_node_ref_id(f->p, args->v.arr.items[0], &scrut_id)) {
+    if (!refs_ok) {
       err_codef(f->p, "sircc.sem.match_sum.scrut_ref_bad", "sircc: sem.match_sum scrut must be node ref");
       goto done;
     }
+    int64_t scrut_id = arg_ids[0];
     LLVMValueRef scrut = lower_expr(f, scrut_id);
     if (!scrut) goto done;
     LLVMValueRef tag = LLVMBuildExtractValue(f->builder, scrut, 0, "tag");
 
-    JsonValue* cases = json_obj_get(n->fields, "cases");
-    JsonValue* def = json_obj_get(n->fields, "default");
+    JsonValue* cases = json_obj_get_sym(n->fields, JSON_KEY_CASES);
+    JsonValue* def = json_obj_get_sym(n->fields, JSON_KEY_DEFAULT);
     if (!cases || cases->type != JSON_ARRAY || !def || def->type != JSON_OBJECT) {
       err_codef(f->p, "sircc.sem.match_sum.cases_bad",
                 "sircc: sem.match_sum node %lld requires fields.cases array and fields.default branch", (long long)node_id);
@@ -1588,7 +1571,7 @@ LLVMValueRef lower_expr(FunctionCtx* f, int64_t node_id) {
         goto done;
       }
       int64_t variant = -1;
-      if (!must_i64(f->p, json_obj_get(co, "variant"), &variant, "sem.match_sum.cases.variant")) goto done;
+      if (!must_i64(f->p, json_obj_get_sym(co, JSON_KEY_VARIANT), &variant, "sem.match_sum.cases.variant")) goto done;
       case_variants[i] = variant;
       char namebuf[32];
       snprintf(namebuf, sizeof(namebuf), "sem.case.%lld", (long long)variant);
@@ -1605,7 +1588,7 @@ LLVMValueRef lower_expr(FunctionCtx* f, int64_t node_id) {
 
     for (size_t i = 0; i < cases->v.arr.len; i++) {
       JsonValue* co = cases->v.arr.items[i];
-      JsonValue* body = json_obj_get(co, "body");
+      JsonValue* body = json_obj_get_sym(co, JSON_KEY_BODY);
       if (!body || body->type != JSON_OBJECT) {
         err_codef(f->p, "sircc.sem.match_sum.case_body_missing",
                   "sircc: sem.match_sum cases[%zu] missing body branch", i);
@@ -1614,11 +1597,11 @@ LLVMValueRef lower_expr(FunctionCtx* f, int64_t node_id) {
       LLVMPositionBuilderAtEnd(f->builder, case_bbs[i]);
 
       // If body is thunk with 1-arg callable, pass payload.
-      const char* kind = json_get_string(json_obj_get(body, "kind"));
+      const char* kind = json_get_string(json_obj_get_sym(body, JSON_KEY_KIND));
       LLVMValueRef v = NULL;
       if (kind && strcmp(kind, "thunk") == 0) {
         int64_t fid = 0;
-        if (!parse_node_ref_id(f->p, json_obj_get(body, "f"), &fid)) goto done;
+        if (!parse_node_ref_id(f->p, json_obj_get_sym(body, JSON_KEY_F), &fid)) goto done;
         NodeRec* fn = get_node(f->p, fid);
         if (!fn || fn->type_ref == 0) goto done;
         TypeRec* t = get_type(f->p, fn->type_ref);
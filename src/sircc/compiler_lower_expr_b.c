@@ -60,6 +60,86 @@ static bool reject_opaque_callable_operand(FunctionCtx* f, int64_t operand_node_
   return false;
 }
 
+// Adds the global for sym `s` (kind var/const) to the module, with its initializer unless extern.
+LLVMValueRef lower_sym_global(FunctionCtx* f, SymRec* s) {
+  const char* name = s->name;
+  if (s->type_ref == 0) {
+    err_codef(f->p, "sircc.sym.global.missing_type_ref", "sircc: sym '%s' missing type_ref for global definition", name);
+    return NULL;
+  }
+  LLVMTypeRef gty = lower_type(f->p, f->ctx, s->type_ref);
+  if (!gty) {
+    err_codef(f->p, "sircc.sym.global.type_ref.bad", "sircc: sym '%s' has invalid type_ref %lld", name,
+              (long long)s->type_ref);
+    return NULL;
+  }
+  LLVMValueRef g = LLVMAddGlobal(f->mod, gty, name);
+
+  const char* linkage = s->linkage;
+  if (linkage && strcmp(linkage, "local") == 0) LLVMSetLinkage(g, LLVMInternalLinkage);
+  else if (linkage && strcmp(linkage, "public") == 0) LLVMSetLinkage(g, LLVMExternalLinkage);
+  else if (linkage && strcmp(linkage, "extern") == 0) LLVMSetLinkage(g, LLVMExternalLinkage);
+  else if (linkage && *linkage) {
+    err_codef(f->p, "sircc.sym.global.linkage.bad",
+              "sircc: sym '%s' has unsupported linkage '%s' (use local/public/extern)", name, linkage);
+    return NULL;
+  }
+
+  if (s->kind && strcmp(s->kind, "const") == 0) {
+    LLVMSetGlobalConstant(g, 1);
+  }
+
+  int64_t size = 0;
+  int64_t align = 0;
+  if (type_size_align(f->p, s->type_ref, &size, &align) && align > 0 && align <= 4096) {
+    LLVMSetAlignment(g, (unsigned)align);
+  }
+
+  if (!linkage || strcmp(linkage, "extern") != 0) {
+    LLVMValueRef init = NULL;
+    if (s->value) {
+      const char* vt = json_get_string(json_obj_get_sym(s->value, JSON_KEY_T));
+      if (vt && strcmp(vt, "num") == 0) {
+        int64_t n0 = 0;
+        (void)json_get_i64(json_obj_get_sym(s->value, JSON_KEY_V), &n0);
+        if (LLVMGetTypeKind(gty) == LLVMIntegerTypeKind) {
+          init = LLVMConstInt(gty, (unsigned long long)n0, 1);
+        } else if (LLVMGetTypeKind(gty) == LLVMPointerTypeKind && n0 == 0) {
+          init = LLVMConstNull(gty);
+        }
+      } else if (vt && strcmp(vt, "ref") == 0) {
+        int64_t cid = 0;
+        if (!parse_node_ref_id(f->p, s->value, &cid)) {
+          err_codef(f->p, "sircc.sym.global.init.ref.bad", "sircc: sym '%s' has invalid initializer ref", name);
+          return NULL;
+        }
+        NodeRec* cn = get_node(f->p, cid);
+        if (!cn || !cn->tag || strncmp(cn->tag, "const.", 6) != 0) {
+          err_codef(f->p, "sircc.sym.global.init.kind.bad", "sircc: sym '%s' initializer must be a const.* node", name);
+          return NULL;
+        }
+        LLVMValueRef cv = lower_expr(f, cid);
+        if (!cv) return NULL;
+        if (!LLVMIsConstant(cv) || LLVMTypeOf(cv) != gty) {
+          err_codef(f->p, "sircc.sym.global.init.type.bad",
+                    "sircc: sym '%s' initializer type mismatch or not constant", name);
+          return NULL;
+        }
+        init = cv;
+      }
+      if (!init) {
+        err_codef(f->p, "sircc.sym.global.init.unsupported",
+                  "sircc: sym '%s' has unsupported global initializer value", name);
+        return NULL;
+      }
+    } else {
+      init = LLVMConstNull(gty);
+    }
+    LLVMSetInitializer(g, init);
+  }
+  return g;
+}
+
 bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef* outp) {
   (void)node_id;
   if (!f || !n || !outp) return false;
@@ -93,7 +173,7 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
         goto done;
       }
 
-      const char* name = json_get_string(json_obj_get(n->fields, "name"));
+      const char* name = json_get_string(json_obj_get_sym(n->fields, JSON_KEY_NAME));
       if (!name || !is_ident(name)) {
         err_codef(f->p, "sircc.fun.sym.name.bad", "sircc: fun.sym node %lld requires fields.name Ident", (long long)node_id);
         goto done;
@@ -120,7 +200,7 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
       if (decl_node) {
         int64_t decl_sig_id = decl_node->type_ref;
         if (decl_sig_id == 0) {
-          if (!parse_type_ref_id(f->p, json_obj_get(decl_node->fields, "sig"), &decl_sig_id)) {
+          if (!parse_type_ref_id(f->p, json_obj_get_sym(decl_node->fields, JSON_KEY_SIG), &decl_sig_id)) {
             err_codef(f->p, "sircc.fun.sym.decl.sig.bad", "sircc: fun.sym '%s' has decl.fn without a signature", name);
             goto done;
           }
@@ -168,16 +248,17 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
         err_codef(f->p, "sircc.fun.cmp.missing_fields", "sircc: %s node %lld missing fields", n->tag, (long long)node_id);
         goto done;
       }
-      JsonValue* args = json_obj_get(n->fields, "args");
-      if (!args || args->type != JSON_ARRAY || args->v.arr.len != 2) {
+      int64_t arg_ids[2];
+      bool refs_ok = false;
+      if (!sir_node_args_n(f->p, n, 2, arg_ids, &refs_ok)) {
         err_codef(f->p, "sircc.fun.cmp.args_bad", "sircc: %s node %lld requires fields.args:[a,b]", n->tag, (long long)node_id);
         goto done;
       }
-      int64_t a_id = 0, b_id = 0;
-      if (!parse_node_ref_id(f->p, args->v.arr.items[0], &a_id) || !parse_node_ref_id(f->p, args->v.arr.items[1], &b_id)) {
+      if (!refs_ok) {
         err_codef(f->p, "sircc.fun.cmp.arg_ref_bad", "sircc: %s node %lld args must be node refs", n->tag, (long long)node_id);
         goto done;
       }
+      int64_t a_id = arg_ids[0], b_id = arg_ids[1];
       LLVMValueRef a = lower_expr(f, a_id);
       LLVMValueRef b = lower_expr(f, b_id);
       if (!a || !b) goto done;
@@ -199,17 +280,17 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
 
   if (strncmp(n->tag, "ptr.", 4) == 0) {
     const char* op = n->tag + 4;
-    JsonValue* args = n->fields ? json_obj_get(n->fields, "args") : NULL;
+    JsonValue* args = n->fields ? json_obj_get_sym(n->fields, JSON_KEY_ARGS) : NULL;
 
     if (strcmp(op, "sym") == 0) {
       const char* name = NULL;
-      if (n->fields) name = json_get_string(json_obj_get(n->fields, "name"));
+      if (n->fields) name = json_get_string(json_obj_get_sym(n->fields, JSON_KEY_NAME));
       if (!name && args && args->type == JSON_ARRAY && args->v.arr.len == 1) {
         int64_t aid = 0;
         if (parse_node_ref_id(f->p, args->v.arr.items[0], &aid)) {
           NodeRec* an = get_node(f->p, aid);
           if (an && strcmp(an->tag, "name") == 0 && an->fields) {
-            name = json_get_string(json_obj_get(an->fields, "name"));
+            name = json_get_string(json_obj_get_sym(an->fields, JSON_KEY_NAME));
           }
         }
       }
@@ -235,80 +316,8 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
                     name);
           goto done;
         }
-        if (s->type_ref == 0) {
-          err_codef(f->p, "sircc.sym.global.missing_type_ref", "sircc: sym '%s' missing type_ref for global definition", name);
-          goto done;
-        }
-        LLVMTypeRef gty = lower_type(f->p, f->ctx, s->type_ref);
-        if (!gty) {
-          err_codef(f->p, "sircc.sym.global.type_ref.bad", "sircc: sym '%s' has invalid type_ref %lld", name,
-                    (long long)s->type_ref);
-          goto done;
-        }
-        g = LLVMAddGlobal(f->mod, gty, name);
-
-        const char* linkage = s->linkage;
-        if (linkage && strcmp(linkage, "local") == 0) LLVMSetLinkage(g, LLVMInternalLinkage);
-        else if (linkage && strcmp(linkage, "public") == 0) LLVMSetLinkage(g, LLVMExternalLinkage);
-        else if (linkage && strcmp(linkage, "extern") == 0) LLVMSetLinkage(g, LLVMExternalLinkage);
-        else if (linkage && *linkage) {
-          err_codef(f->p, "sircc.sym.global.linkage.bad",
-                    "sircc: sym '%s' has unsupported linkage '%s' (use local/public/extern)", name, linkage);
-          goto done;
-        }
-
-        if (s->kind && strcmp(s->kind, "const") == 0) {
-          LLVMSetGlobalConstant(g, 1);
-        }
-
-        int64_t size = 0;
-        int64_t align = 0;
-        if (type_size_align(f->p, s->type_ref, &size, &align) && align > 0 && align <= 4096) {
-          LLVMSetAlignment(g, (unsigned)align);
-        }
-
-        if (!linkage || strcmp(linkage, "extern") != 0) {
-          LLVMValueRef init = NULL;
-          if (s->value) {
-            const char* vt = json_get_string(json_obj_get(s->value, "t"));
-            if (vt && strcmp(vt, "num") == 0) {
-              int64_t n0 = 0;
-              (void)json_get_i64(json_obj_get(s->value, "v"), &n0);
-              if (LLVMGetTypeKind(gty) == LLVMIntegerTypeKind) {
-                init = LLVMConstInt(gty, (unsigned long long)n0, 1);
-              } else if (LLVMGetTypeKind(gty) == LLVMPointerTypeKind && n0 == 0) {
-                init = LLVMConstNull(gty);
-              }
-            } else if (vt && strcmp(vt, "ref") == 0) {
-              int64_t cid = 0;
-              if (!parse_node_ref_id(f->p, s->value, &cid)) {
-                err_codef(f->p, "sircc.sym.global.init.ref.bad", "sircc: sym '%s' has invalid initializer ref", name);
-                goto done;
-              }
-              NodeRec* cn = get_node(f->p, cid);
-              if (!cn || !cn->tag || strncmp(cn->tag, "const.", 6) != 0) {
-                err_codef(f->p, "sircc.sym.global.init.kind.bad", "sircc: sym '%s' initializer must be a const.* node", name);
-                goto done;
-              }
-              LLVMValueRef cv = lower_expr(f, cid);
-              if (!cv) goto done;
-              if (!LLVMIsConstant(cv) || LLVMTypeOf(cv) != gty) {
-                err_codef(f->p, "sircc.sym.global.init.type.bad",
-                          "sircc: sym '%s' initializer type mismatch or not constant", name);
-                goto done;
-              }
-              init = cv;
-            }
-            if (!init) {
-              err_codef(f->p, "sircc.sym.global.init.unsupported",
-                        "sircc: sym '%s' has unsupported global initializer value", name);
-              goto done;
-            }
-          } else {
-            init = LLVMConstNull(gty);
-          }
-          LLVMSetInitializer(g, init);
-        }
+        g = lower_sym_global(f, s);
+        if (!g) goto done;
       }
 
       out = g;
@@ -321,7 +330,7 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
         goto done;
       }
       int64_t ty_id = 0;
-      if (!parse_type_ref_id(f->p, json_obj_get(n->fields, "ty"), &ty_id)) {
+      if (!parse_type_ref_id(f->p, json_obj_get_sym(n->fields, JSON_KEY_TY), &ty_id)) {
         err_codef(f->p, "sircc.ptr.offset.ty.missing", "sircc: %s node %lld missing fields.ty (type ref)", n->tag, (long long)node_id);
         goto done;
       }
@@ -514,7 +523,7 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
       goto done;
     }
     int64_t ty_id = 0;
-    if (!parse_type_ref_id(f->p, json_obj_get(n->fields, "ty"), &ty_id)) {
+    if (!parse_type_ref_id(f->p, json_obj_get_sym(n->fields, JSON_KEY_TY), &ty_id)) {
       err_codef(f->p, "sircc.alloca.ty.missing", "sircc: alloca node %lld missing fields.ty (type ref)", (long long)node_id);
       goto done;
     }
@@ -538,9 +547,9 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
     bool align_present = false;
     bool zero_init = false;
     LLVMValueRef count_val = NULL;
-    JsonValue* flags = json_obj_get(n->fields, "flags");
+    JsonValue* flags = json_obj_get_sym(n->fields, JSON_KEY_FLAGS);
     if (flags && flags->type == JSON_OBJECT) {
-      JsonValue* av = json_obj_get(flags, "align");
+      JsonValue* av = json_obj_get_sym(flags, JSON_KEY_ALIGN);
       if (av) {
         align_present = true;
         if (!json_get_i64(av, &align_i64)) {
@@ -548,12 +557,12 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
           goto done;
         }
       }
-      JsonValue* zv = json_obj_get(flags, "zero");
+      JsonValue* zv = json_obj_get_sym(flags, JSON_KEY_ZERO);
       if (zv && zv->type == JSON_BOOL) zero_init = zv->v.b;
     }
-    JsonValue* countv = (flags && flags->type == JSON_OBJECT) ? json_obj_get(flags, "count") : NULL;
-    if (!countv) countv = json_obj_get(n->fields, "count");
-    JsonValue* alignv = json_obj_get(n->fields, "align");
+    JsonValue* countv = (flags && flags->type == JSON_OBJECT) ? json_obj_get_sym(flags, JSON_KEY_COUNT) : NULL;
+    if (!countv) countv = json_obj_get_sym(n->fields, JSON_KEY_COUNT);
+    JsonValue* alignv = json_obj_get_sym(n->fields, JSON_KEY_ALIGN);
     if (alignv) {
       align_present = true;
       if (!json_get_i64(alignv, &align_i64)) {
@@ -561,7 +570,7 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
         goto done;
       }
     }
-    JsonValue* zerov = json_obj_get(n->fields, "zero");
+    JsonValue* zerov = json_obj_get_sym(n->fields, JSON_KEY_ZERO);
     if (zerov && zerov->type == JSON_BOOL) zero_init = zerov->v.b;
 
     LLVMTypeRef i64 = LLVMInt64TypeInContext(f->ctx);
@@ -657,7 +666,7 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
       err_codef(f->p, "sircc.load.fields.missing", "sircc: %s node %lld missing fields", n->tag, (long long)node_id);
       goto done;
     }
-    JsonValue* addr = json_obj_get(n->fields, "addr");
+    JsonValue* addr = json_obj_get_sym(n->fields, JSON_KEY_ADDR);
     int64_t aid = 0;
     if (!parse_node_ref_id(f->p, addr, &aid)) {
       err_codef(f->p, "sircc.load.addr.ref_bad", "sircc: %s node %lld missing fields.addr ref", n->tag, (long long)node_id);
@@ -684,7 +693,7 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
     if (want_ptr != pty) {
       pval = LLVMBuildBitCast(f->builder, pval, want_ptr, "ld.cast");
     }
-    JsonValue* alignv = json_obj_get(n->fields, "align");
+    JsonValue* alignv = json_obj_get_sym(n->fields, JSON_KEY_ALIGN);
     unsigned align = 1;
     if (alignv) {
       int64_t a = 0;
@@ -705,7 +714,7 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
     if (!emit_trap_if_misaligned(f, pval, align)) goto done;
     out = LLVMBuildLoad2(f->builder, el, pval, "load");
     LLVMSetAlignment(out, align);
-    JsonValue* volv = json_obj_get(n->fields, "vol");
+    JsonValue* volv = json_obj_get_sym(n->fields, JSON_KEY_VOL);
     if (volv && volv->type == JSON_BOOL) LLVMSetVolatile(out, volv->v.b ? 1 : 0);
     if (LLVMGetTypeKind(el) == LLVMFloatTypeKind || LLVMGetTypeKind(el) == LLVMDoubleTypeKind) {
       out = canonicalize_float(f, out);
@@ -717,7 +726,7 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
     int width = (n->tag[1] == '3') ? 32 : 64;
     const char* op = n->tag + 4;
 
-    JsonValue* args = n->fields ? json_obj_get(n->fields, "args") : NULL;
+    JsonValue* args = n->fields ? json_obj_get_sym(n->fields, JSON_KEY_ARGS) : NULL;
     if (!args || args->type != JSON_ARRAY) {
       err_codef(f->p, "sircc.args.missing", "sircc: %s node %lld missing args array", n->tag, (long long)node_id);
       goto done;
@@ -901,18 +910,19 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
         goto done;
       }
 
-      JsonValue* args = json_obj_get(n->fields, "args");
-      if (!args || args->type != JSON_ARRAY || args->v.arr.len != 2) {
+      int64_t arg_ids[2];
+      bool refs_ok = false;
+      if (!sir_node_args_n(f->p, n, 2, arg_ids, &refs_ok)) {
         err_codef(f->p, "sircc.closure.make.args_bad",
                   "sircc: closure.make node %lld requires fields.args:[code, env]", (long long)node_id);
         goto done;
       }
-      int64_t code_id = 0, env_id = 0;
-      if (!parse_node_ref_id(f->p, args->v.arr.items[0], &code_id) || !parse_node_ref_id(f->p, args->v.arr.items[1], &env_id)) {
+      if (!refs_ok) {
         err_codef(f->p, "sircc.closure.make.arg_ref_bad",
                   "sircc: closure.make node %lld args must be node refs", (long long)node_id);
         goto done;
       }
+      int64_t code_id = arg_ids[0], env_id = arg_ids[1];
 
       // Validate code/env types against closure type.
       NodeRec* code_n = get_node(f->p, code_id);
@@ -997,14 +1007,14 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
         goto done;
       }
 
-      const char* name = json_get_string(json_obj_get(n->fields, "name"));
+      const char* name = json_get_string(json_obj_get_sym(n->fields, JSON_KEY_NAME));
       if (!name || !is_ident(name)) {
         err_codef(f->p, "sircc.closure.sym.name.bad",
                   "sircc: closure.sym node %lld requires fields.name Ident", (long long)node_id);
         goto done;
       }
       int64_t env_id = 0;
-      if (!parse_node_ref_id(f->p, json_obj_get(n->fields, "env"), &env_id)) {
+      if (!parse_node_ref_id(f->p, json_obj_get_sym(n->fields, JSON_KEY_ENV), &env_id)) {
         err_codef(f->p, "sircc.closure.sym.env.ref.missing",
                   "sircc: closure.sym node %lld missing fields.env ref", (long long)node_id);
         goto done;
@@ -1072,18 +1082,19 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
         err_codef(f->p, "sircc.closure.access.missing_fields", "sircc: %s node %lld missing fields", n->tag, (long long)node_id);
         goto done;
       }
-      JsonValue* args = json_obj_get(n->fields, "args");
-      if (!args || args->type != JSON_ARRAY || args->v.arr.len != 1) {
+      int64_t arg_ids[1];
+      bool refs_ok = false;
+      if (!sir_node_args_n(f->p, n, 1, arg_ids, &refs_ok)) {
         err_codef(f->p, "sircc.closure.access.args_bad",
                   "sircc: %s node %lld requires fields.args:[c]", n->tag, (long long)node_id);
         goto done;
       }
-      int64_t cid = 0;
-      if (!parse_node_ref_id(f->p, args->v.arr.items[0], &cid)) {
+      if (!refs_ok) {
         err_codef(f->p, "sircc.closure.access.arg_ref_bad",
                   "sircc: %s node %lld arg must be node ref", n->tag, (long long)node_id);
         goto done;
       }
+      int64_t cid = arg_ids[0];
       LLVMValueRef c = lower_expr(f, cid);
       if (!c) goto done;
       unsigned idx = (strcmp(op, "code") == 0) ? 0u : 1u;
@@ -1096,18 +1107,19 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
         err_codef(f->p, "sircc.closure.cmp.missing_fields", "sircc: %s node %lld missing fields", n->tag, (long long)node_id);
         goto done;
       }
-      JsonValue* args = json_obj_get(n->fields, "args");
-      if (!args || args->type != JSON_ARRAY || args->v.arr.len != 2) {
+      int64_t arg_ids[2];
+      bool refs_ok = false;
+      if (!sir_node_args_n(f->p, n, 2, arg_ids, &refs_ok)) {
         err_codef(f->p, "sircc.closure.cmp.args_bad",
                   "sircc: %s node %lld requires fields.args:[a,b]", n->tag, (long long)node_id);
         goto done;
       }
-      int64_t a_id = 0, b_id = 0;
-      if (!parse_node_ref_id(f->p, args->v.arr.items[0], &a_id) || !parse_node_ref_id(f->p, args->v.arr.items[1], &b_id)) {
+      if (!refs_ok) {
         err_codef(f->p, "sircc.closure.cmp.arg_ref_bad",
                   "sircc: %s node %lld args must be node refs", n->tag, (long long)node_id);
         goto done;
       }
+      int64_t a_id = arg_ids[0], b_id = arg_ids[1];
       LLVMValueRef a = lower_expr(f, a_id);
       LLVMValueRef b = lower_expr(f, b_id);
       if (!a || !b) goto done;
@@ -1160,7 +1172,7 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
         goto done;
       }
       int64_t ty_id = 0;
-      if (!parse_type_ref_id(f->p, json_obj_get(n->fields, "ty"), &ty_id)) {
+      if (!parse_type_ref_id(f->p, json_obj_get_sym(n->fields, JSON_KEY_TY), &ty_id)) {
         err_codef(f->p, "sircc.adt.get.missing_ty", "sircc: adt.get node %lld missing fields.ty (sum type)", (long long)node_id);
         goto done;
       }
@@ -1191,16 +1203,17 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
         err_codef(f->p, "sircc.adt.tag.missing_fields", "sircc: adt.tag node %lld missing fields", (long long)node_id);
         goto done;
       }
-      JsonValue* args = json_obj_get(n->fields, "args");
-      if (!args || args->type != JSON_ARRAY || args->v.arr.len != 1) {
+      int64_t arg_ids[1];
+      bool refs_ok = false;
+      if (!sir_node_args_n(f->p, n, 1, arg_ids, &refs_ok)) {
         err_codef(f->p, "sircc.adt.tag.args_bad", "sircc: adt.tag node %lld requires fields.args:[v]", (long long)node_id);
         goto done;
       }
-      int64_t vid = 0;
-      if (!parse_node_ref_id(f->p, args->v.arr.items[0], &vid)) {
+      if (!refs_ok) {
         err_codef(f->p, "sircc.adt.tag.arg_ref_bad", "sircc: adt.tag node %lld arg must be node ref", (long long)node_id);
         goto done;
       }
+      int64_t vid = arg_ids[0];
       LLVMValueRef v = lower_expr(f, vid);
       if (!v) goto done;
       out = LLVMBuildExtractValue(f->builder, v, 0, "tag");
@@ -1212,18 +1225,18 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
         err_codef(f->p, "sircc.adt.is.missing_fields", "sircc: adt.is node %lld missing fields", (long long)node_id);
         goto done;
       }
-      JsonValue* args = json_obj_get(n->fields, "args");
+      JsonValue* args = json_obj_get_sym(n->fields, JSON_KEY_ARGS);
       if (!args || args->type != JSON_ARRAY || args->v.arr.len != 1) {
         err_codef(f->p, "sircc.adt.is.args_bad", "sircc: adt.is node %lld requires fields.args:[v]", (long long)node_id);
         goto done;
       }
-      JsonValue* flags = json_obj_get(n->fields, "flags");
+      JsonValue* flags = json_obj_get_sym(n->fields, JSON_KEY_FLAGS);
       if (!flags || flags->type != JSON_OBJECT) {
         err_codef(f->p, "sircc.adt.is.flags_missing", "sircc: adt.is node %lld missing fields.flags", (long long)node_id);
         goto done;
       }
       int64_t variant = -1;
-      if (!must_i64(f->p, json_obj_get(flags, "variant"), &variant, "adt.is.flags.variant")) goto done;
+      if (!must_i64(f->p, json_obj_get_sym(flags, JSON_KEY_VARIANT), &variant, "adt.is.flags.variant")) goto done;
 
       int64_t vid = 0;
       if (!parse_node_ref_id(f->p, args->v.arr.items[0], &vid)) {
@@ -1263,13 +1276,13 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
         err_codef(f->p, "sircc.adt.make.type_ref.bad", "sircc: adt.make node %lld type_ref must be a sum type", (long long)node_id);
         goto done;
       }
-      JsonValue* flags = json_obj_get(n->fields, "flags");
+      JsonValue* flags = json_obj_get_sym(n->fields, JSON_KEY_FLAGS);
       if (!flags || flags->type != JSON_OBJECT) {
         err_codef(f->p, "sircc.adt.make.flags_missing", "sircc: adt.make node %lld missing fields.flags", (long long)node_id);
         goto done;
       }
       int64_t variant = -1;
-      if (!must_i64(f->p, json_obj_get(flags, "variant"), &variant, "adt.make.flags.variant")) goto done;
+      if (!must_i64(f->p, json_obj_get_sym(flags, JSON_KEY_VARIANT), &variant, "adt.make.flags.variant")) goto done;
 
       LLVMValueRef bad = LLVMConstInt(LLVMInt1TypeInContext(f->ctx),
                                       (variant < 0 || (size_t)variant >= sty->variant_len) ? 1 : 0, 0);
@@ -1278,7 +1291,7 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
 
       int64_t pay_ty_id = sty->variants[(size_t)variant].ty;
 
-      JsonValue* args = json_obj_get(n->fields, "args");
+      JsonValue* args = json_obj_get_sym(n->fields, JSON_KEY_ARGS);
       size_t argc = 0;
       if (args) {
         if (args->type != JSON_ARRAY) {
@@ -1347,7 +1360,7 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
         goto done;
       }
       int64_t sum_ty_id = 0;
-      if (!parse_type_ref_id(f->p, json_obj_get(n->fields, "ty"), &sum_ty_id)) {
+      if (!parse_type_ref_id(f->p, json_obj_get_sym(n->fields, JSON_KEY_TY), &sum_ty_id)) {
         err_codef(f->p, "sircc.adt.get.missing_ty", "sircc: adt.get node %lld missing fields.ty (sum type)", (long long)node_id);
         goto done;
       }
@@ -1357,13 +1370,13 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
                   "sircc: adt.get node %lld fields.ty must reference a sum type", (long long)node_id);
         goto done;
       }
-      JsonValue* flags = json_obj_get(n->fields, "flags");
+      JsonValue* flags = json_obj_get_sym(n->fields, JSON_KEY_FLAGS);
       if (!flags || flags->type != JSON_OBJECT) {
         err_codef(f->p, "sircc.adt.get.flags_missing", "sircc: adt.get node %lld missing fields.flags", (long long)node_id);
         goto done;
       }
       int64_t variant = -1;
-      if (!must_i64(f->p, json_obj_get(flags, "variant"), &variant, "adt.get.flags.variant")) goto done;
+      if (!must_i64(f->p, json_obj_get_sym(flags, JSON_KEY_VARIANT), &variant, "adt.get.flags.variant")) goto done;
 
       LLVMValueRef bad = LLVMConstInt(LLVMInt1TypeInContext(f->ctx),
                                       (variant < 0 || (size_t)variant >= sty->variant_len) ? 1 : 0, 0);
@@ -1377,16 +1390,17 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
         goto done;
       }
 
-      JsonValue* args = json_obj_get(n->fields, "args");
-      if (!args || args->type != JSON_ARRAY || args->v.arr.len != 1) {
+      int64_t arg_ids[1];
+      bool refs_ok = false;
+      if (!sir_node_args_n(f->p, n, 1, arg_ids, &refs_ok)) {
         err_codef(f->p, "sircc.adt.get.args_bad", "sircc: adt.get node %lld requires fields.args:[v]", (long long)node_id);
         goto done;
       }
-      int64_t vid = 0;
-      if (!parse_node_ref_id(f->p, args->v.arr.items[0], &vid)) {
+      if (!refs_ok) {
         err_codef(f->p, "sircc.adt.get.arg_ref_bad", "sircc: adt.get node %lld arg must be node ref", (long long)node_id);
         goto done;
       }
+      int64_t vid = arg_ids[0];
       LLVMValueRef v = lower_expr(f, vid);
       if (!v) goto done;
       LLVMValueRef tag = LLVMBuildExtractValue(f->builder, v, 0, "tag");
@@ -1479,7 +1493,7 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
       }
 
       if (strcmp(tyname, "array") == 0) {
-        JsonValue* elems = json_obj_get(n->fields, "elems");
+        JsonValue* elems = json_obj_get_sym(n->fields, JSON_KEY_ELEMS);
         if (!elems || elems->type != JSON_ARRAY) {
           err_codef(f->p, "sircc.const.array.elems.missing",
                     "sircc: const.array node %lld requires fields.elems array", (long long)node_id);
@@ -1533,7 +1547,7 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
       }
 
       // repeat
-      JsonValue* countv = json_obj_get(n->fields, "count");
+      JsonValue* countv = json_obj_get_sym(n->fields, JSON_KEY_COUNT);
       int64_t count = 0;
       if (!must_i64(f->p, countv, &count, "const.repeat.count")) goto done;
       if (count != tr->len) {
@@ -1542,7 +1556,7 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
                   (long long)tr->len);
         goto done;
       }
-      JsonValue* elemv = json_obj_get(n->fields, "elem");
+      JsonValue* elemv = json_obj_get_sym(n->fields, JSON_KEY_ELEM);
       int64_t eid = 0;
       if (!parse_node_ref_id(f->p, elemv, &eid)) {
         err_codef(f->p, "sircc.const.repeat.elem.ref.bad",
@@ -1617,7 +1631,7 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
         }
       }
 
-      JsonValue* fields = json_obj_get(n->fields, "fields");
+      JsonValue* fields = json_obj_get_sym(n->fields, JSON_KEY_FIELDS);
       if (!fields || fields->type != JSON_ARRAY) {
         err_codef(f->p, "sircc.const.struct.fields.bad",
                   "sircc: const.struct node %lld requires fields.fields array", (long long)node_id);
@@ -1635,7 +1649,7 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
           goto done;
         }
         int64_t i = 0;
-        if (!must_i64(f->p, json_obj_get(fo, "i"), &i, "const.struct.fields[i].i")) {
+        if (!must_i64(f->p, json_obj_get_sym(fo, JSON_KEY_I), &i, "const.struct.fields[i].i")) {
           free(elts);
           goto done;
         }
@@ -1653,7 +1667,7 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
         }
         last_i = i;
         int64_t vid = 0;
-        if (!parse_node_ref_id(f->p, json_obj_get(fo, "v"), &vid)) {
+        if (!parse_node_ref_id(f->p, json_obj_get_sym(fo, JSON_KEY_V), &vid)) {
           err_codef(f->p, "sircc.const.struct.field.value.ref.bad",
                     "sircc: const.struct node %lld fields[%zu].v must be a node ref", (long long)node_id, j);
           free(elts);
@@ -1692,13 +1706,13 @@ bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef
     }
     if (LLVMGetTypeKind(ty) == LLVMIntegerTypeKind) {
       int64_t value = 0;
-      if (!must_i64(f->p, json_obj_get(n->fields, "value"), &value, "const.value")) goto done;
+      if (!must_i64(f->p, json_obj_get_sym(n->fields, JSON_KEY_VALUE), &value, "const.value")) goto done;
       out = LLVMConstInt(ty, (unsigned long long)value, 1);
       goto done;
     }
     if (LLVMGetTypeKind(ty) == LLVMFloatTypeKind || LLVMGetTypeKind(ty) == LLVMDoubleTypeKind) {
       // Prefer exact bit-pattern constants: fields.bits = "0x..." (hex).
-      const char* bits = json_get_string(json_obj_get(n->fields, "bits"));
+      const char* bits = json_get_string(json_obj_get_sym(n->fields, JSON_KEY_BITS));
       if (!bits || strncmp(bits, "0x", 2) != 0) {
         err_codef(f->p, "sircc.const.float.bits.bad", "sircc: const.%s requires fields.bits hex string (0x...)", tyname);
         goto done;
@@ -109,7 +109,7 @@ static JsonValue* jv_make_arr(Arena* a, size_t n) {
 
 static bool lower_sem_if_to_select(SirProgram* p, NodeRec* n) {
   if (!p || !n || !n->fields) return false;
-  JsonValue* args = json_obj_get(n->fields, "args");
+  JsonValue* args = json_obj_get_sym(n->fields, JSON_KEY_ARGS);
   if (!args || args->type != JSON_ARRAY || args->v.arr.len != 3) return false;
 
   JsonValue* cond_ref = args->v.arr.items[0];
@@ -118,8 +118,8 @@ static bool lower_sem_if_to_select(SirProgram* p, NodeRec* n) {
   if (!cond_ref || !br_then || !br_else) return false;
   if (br_then->type != JSON_OBJECT || br_else->type != JSON_OBJECT) return false;
 
-  const char* k_then = json_get_string(json_obj_get(br_then, "kind"));
-  const char* k_else = json_get_string(json_obj_get(br_else, "kind"));
+  const char* k_then = json_get_string(json_obj_get_sym(br_then, JSON_KEY_KIND));
+  const char* k_else = json_get_string(json_obj_get_sym(br_else, JSON_KEY_KIND));
   if (!k_then || !k_else) return false;
 
   if (strcmp(k_then, "val") != 0 || strcmp(k_else, "val") != 0) {
@@ -127,8 +127,8 @@ static bool lower_sem_if_to_select(SirProgram* p, NodeRec* n) {
     return false;
   }
 
-  JsonValue* v_then = json_obj_get(br_then, "v");
-  JsonValue* v_else = json_obj_get(br_else, "v");
+  JsonValue* v_then = json_obj_get_sym(br_then, JSON_KEY_V);
+  JsonValue* v_else = json_obj_get_sym(br_else, JSON_KEY_V);
   if (!v_then || !v_else) return false;
 
   JsonValue* new_args = jv_make_arr(&p->arena, 3);
@@ -147,7 +147,7 @@ static bool lower_sem_if_to_select(SirProgram* p, NodeRec* n) {
     SIRCC_ERR_NODE(p, n, "sircc.oom", "sircc: out of memory");
     return false;
   }
-  new_fields->v.obj.items[0].key = "args";
+  new_fields->v.obj.items[0].key = json_key_name(JSON_KEY_ARGS);
   new_fields->v.obj.items[0].value = new_args;
 
   n->tag = "select";
@@ -170,18 +170,18 @@ static bool parse_branch_operand(SirProgram* p, const JsonValue* v, BranchOperan
   if (!p || !out) return false;
   memset(out, 0, sizeof(*out));
   if (!v || v->type != JSON_OBJECT) return false;
-  const char* k = json_get_string(json_obj_get((JsonValue*)v, "kind"));
+  const char* k = json_get_string(json_obj_get_sym((JsonValue*)v, JSON_KEY_KIND));
   if (!k) return false;
   if (strcmp(k, "val") == 0) {
     int64_t id = 0;
-    if (!parse_node_ref_id(p, json_obj_get((JsonValue*)v, "v"), &id)) return false;
+    if (!parse_node_ref_id(p, json_obj_get_sym((JsonValue*)v, JSON_KEY_V), &id)) return false;
     out->kind = BRANCH_VAL;
     out->node_id = id;
     return true;
   }
   if (strcmp(k, "thunk") == 0) {
     int64_t id = 0;
-    if (!parse_node_ref_id(p, json_obj_get((JsonValue*)v, "f"), &id)) return false;
+    if (!parse_node_ref_id(p, json_obj_get_sym((JsonValue*)v, JSON_KEY_F), &id)) return false;
     out->kind = BRANCH_THUNK;
     out->node_id = id;
     return true;
@@ -214,9 +214,9 @@ static JsonValue* jv_make_node_ref(SirProgram* p, int64_t id) {
   if (!p) return NULL;
   JsonValue* o = jv_make_obj(&p->arena, 2);
   if (!o) return NULL;
-  o->v.obj.items[0].key = "t";
+  o->v.obj.items[0].key = json_key_name(JSON_KEY_T);
   o->v.obj.items[0].value = jv_make_str(&p->arena, "ref");
-  o->v.obj.items[1].key = "id";
+  o->v.obj.items[1].key = json_key_name(JSON_KEY_ID);
   o->v.obj.items[1].value = jv_make_id_value(&p->arena, p, SIR_ID_NODE, id);
   if (!o->v.obj.items[1].value) return NULL;
   return o;
@@ -382,7 +382,7 @@ static bool make_call_thunk(SirProgram* p, int64_t base_id, const char* suffix,
 
   JsonValue* fields = jv_make_obj(&p->arena, 1);
   if (!fields) return false;
-  fields->v.obj.items[0].key = "args";
+  fields->v.obj.items[0].key = json_key_name(JSON_KEY_ARGS);
   fields->v.obj.items[0].value = args;
 
   make_node_stub(p, call_id, tag, result_ty, fields);
@@ -421,7 +421,7 @@ static bool make_call_thunk_with_payload(SirProgram* p, int64_t base_id, const c
 
   JsonValue* fields = jv_make_obj(&p->arena, 1);
   if (!fields) return false;
-  fields->v.obj.items[0].key = "args";
+  fields->v.obj.items[0].key = json_key_name(JSON_KEY_ARGS);
   fields->v.obj.items[0].value = args;
 
   make_node_stub(p, call_id, tag, result_ty, fields);
@@ -457,11 +457,11 @@ static JsonValue* block_fields_with_stmts(SirProgram* p, JsonValue* old_fields,
     }
   }
   if (new_params) {
-    o->v.obj.items[wi].key = "params";
+    o->v.obj.items[wi].key = json_key_name(JSON_KEY_PARAMS);
     o->v.obj.items[wi].value = new_params;
     wi++;
   }
-  o->v.obj.items[wi].key = "stmts";
+  o->v.obj.items[wi].key = json_key_name(JSON_KEY_STMTS);
   o->v.obj.items[wi].value = new_stmts;
   wi++;
   o->v.obj.len = wi;
@@ -490,7 +490,7 @@ static JsonValue* fn_fields_to_cfg(SirProgram* p, JsonValue* old_fields, int64_t
     if (strcmp(k, "blocks") == 0) continue;
     fields->v.obj.items[wi++] = old_fields->v.obj.items[i];
   }
-  fields->v.obj.items[wi].key = "entry";
+  fields->v.obj.items[wi].key = json_key_name(JSON_KEY_ENTRY);
   fields->v.obj.items[wi].value = jv_make_ref(&p->arena, entry_block_id);
   wi++;
   JsonValue* blks = jv_make_arr(&p->arena, block_len);
@@ -499,7 +499,7 @@ static JsonValue* fn_fields_to_cfg(SirProgram* p, JsonValue* old_fields, int64_t
     blks->v.arr.items[i] = jv_make_ref(&p->arena, block_ids[i]);
     if (!blks->v.arr.items[i]) return NULL;
   }
-  fields->v.obj.items[wi].key = "blocks";
+  fields->v.obj.items[wi].key = json_key_name(JSON_KEY_BLOCKS);
   fields->v.obj.items[wi].value = blks;
   wi++;
   fields->v.obj.len = wi;
@@ -530,7 +530,7 @@ static JsonValue* fn_fields_with_blocks(SirProgram* p, JsonValue* old_fields, Js
     const char* k = old_fields->v.obj.items[i].key;
     if (!k) continue;
     if (strcmp(k, "blocks") == 0) {
-      fields->v.obj.items[wi].key = "blocks";
+      fields->v.obj.items[wi].key = json_key_name(JSON_KEY_BLOCKS);
       fields->v.obj.items[wi].value = new_blocks;
       wi++;
       continue;
@@ -543,18 +543,34 @@ static JsonValue* fn_fields_with_blocks(SirProgram* p, JsonValue* old_fields, Js
 
 static bool cfg_fn_append_blocks(SirProgram* p, NodeRec* fn, const int64_t* add_block_ids, size_t add_len) {
   if (!p || !fn || !fn->fields || !add_block_ids || add_len == 0) return false;
-  JsonValue* blocks = json_obj_get(fn->fields, "blocks");
+  JsonValue* blocks = json_obj_get_sym(fn->fields, JSON_KEY_BLOCKS);
   if (!blocks || blocks->type != JSON_ARRAY) return false;
-  JsonValue* new_blocks = jv_make_arr(&p->arena, blocks->v.arr.len + add_len);
+  const size_t len = blocks->v.arr.len;
+
+  // Repeated lowering appends to the same array: grow it geometrically in place.
+  if (blocks == p->hl_blocks_arr && len + add_len <= p->hl_blocks_cap) {
+    for (size_t i = 0; i < add_len; i++) {
+      blocks->v.arr.items[len + i] = jv_make_ref(&p->arena, add_block_ids[i]);
+      if (!blocks->v.arr.items[len + i]) return false;
+    }
+    blocks->v.arr.len = len + add_len;
+    return true;
+  }
+
+  const size_t cap = (len + add_len) * 2;
+  JsonValue* new_blocks = jv_make_arr(&p->arena, cap);
   if (!new_blocks) return false;
-  for (size_t i = 0; i < blocks->v.arr.len; i++) new_blocks->v.arr.items[i] = blocks->v.arr.items[i];
+  for (size_t i = 0; i < len; i++) new_blocks->v.arr.items[i] = blocks->v.arr.items[i];
   for (size_t i = 0; i < add_len; i++) {
-    new_blocks->v.arr.items[blocks->v.arr.len + i] = jv_make_ref(&p->arena, add_block_ids[i]);
-    if (!new_blocks->v.arr.items[blocks->v.arr.len + i]) return false;
+    new_blocks->v.arr.items[len + i] = jv_make_ref(&p->arena, add_block_ids[i]);
+    if (!new_blocks->v.arr.items[len + i]) return false;
   }
+  new_blocks->v.arr.len = len + add_len;
   JsonValue* nf = fn_fields_with_blocks(p, fn->fields, new_blocks);
   if (!nf) return false;
   fn->fields = nf;
+  p->hl_blocks_arr = new_blocks;
+  p->hl_blocks_cap = cap;
   return true;
 }
 
@@ -564,11 +580,11 @@ static bool lower_sem_value_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t sem_n
 
   // Only support non-CFG functions (fields.body) for MVP.
   int64_t body_id = 0;
-  if (!parse_node_ref_id(p, json_obj_get(fn->fields, "body"), &body_id)) return false;
+  if (!parse_node_ref_id(p, json_obj_get_sym(fn->fields, JSON_KEY_BODY), &body_id)) return false;
   NodeRec* body = get_node(p, body_id);
   if (!body || !body->fields) return false;
 
-  JsonValue* stmts = json_obj_get(body->fields, "stmts");
+  JsonValue* stmts = json_obj_get_sym(body->fields, JSON_KEY_STMTS);
   if (!stmts || stmts->type != JSON_ARRAY || stmts->v.arr.len == 0) return false;
 
   // Require last stmt is term.ret/return and returns sem_node_id.
@@ -578,7 +594,7 @@ static bool lower_sem_value_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t sem_n
   NodeRec* term = get_node(p, term_id);
   if (!term || !term->fields || !(strcmp(term->tag, "term.ret") == 0 || strcmp(term->tag, "return") == 0)) return false;
   int64_t got = 0;
-  if (!parse_node_ref_id(p, json_obj_get(term->fields, "value"), &got)) return false;
+  if (!parse_node_ref_id(p, json_obj_get_sym(term->fields, JSON_KEY_VALUE), &got)) return false;
   if (got != sem_node_id) return false;
 
   NodeRec* semn = get_node(p, sem_node_id);
@@ -643,22 +659,22 @@ static bool lower_sem_value_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t sem_n
   JsonValue* then_to = jv_make_obj(&p->arena, 1);
   JsonValue* else_to = jv_make_obj(&p->arena, 1);
   if (!then_to || !else_to) return false;
-  then_to->v.obj.items[0].key = "to";
+  then_to->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   then_to->v.obj.items[0].value = jv_make_ref(&p->arena, join_bid);
-  else_to->v.obj.items[0].key = "to";
+  else_to->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   else_to->v.obj.items[0].value = jv_make_ref(&p->arena, join_bid);
   if (!then_to->v.obj.items[0].value || !else_to->v.obj.items[0].value) return false;
 
   JsonValue* then_fields = jv_make_obj(&p->arena, 2);
   JsonValue* else_fields = jv_make_obj(&p->arena, 2);
   if (!then_fields || !else_fields) return false;
-  then_fields->v.obj.items[0].key = "to";
+  then_fields->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   then_fields->v.obj.items[0].value = jv_make_ref(&p->arena, join_bid);
-  then_fields->v.obj.items[1].key = "args";
+  then_fields->v.obj.items[1].key = json_key_name(JSON_KEY_ARGS);
   then_fields->v.obj.items[1].value = then_args;
-  else_fields->v.obj.items[0].key = "to";
+  else_fields->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   else_fields->v.obj.items[0].value = jv_make_ref(&p->arena, join_bid);
-  else_fields->v.obj.items[1].key = "args";
+  else_fields->v.obj.items[1].key = json_key_name(JSON_KEY_ARGS);
   else_fields->v.obj.items[1].value = else_args;
 
   make_node_stub(p, then_br_id, "term.br", 0, then_fields);
@@ -687,7 +703,7 @@ static bool lower_sem_value_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t sem_n
   // Rewrite the existing term.ret node to return the join param.
   JsonValue* ret_fields = jv_make_obj(&p->arena, 1);
   if (!ret_fields) return false;
-  ret_fields->v.obj.items[0].key = "value";
+  ret_fields->v.obj.items[0].key = json_key_name(JSON_KEY_VALUE);
   ret_fields->v.obj.items[0].value = jv_make_ref(&p->arena, sem_node_id);
   if (!ret_fields->v.obj.items[0].value) return false;
   term->tag = "term.ret";
@@ -714,19 +730,19 @@ static bool lower_sem_value_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t sem_n
   JsonValue* then_obj = jv_make_obj(&p->arena, 1);
   JsonValue* else_obj = jv_make_obj(&p->arena, 1);
   if (!then_obj || !else_obj) return false;
-  then_obj->v.obj.items[0].key = "to";
+  then_obj->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   then_obj->v.obj.items[0].value = jv_make_ref(&p->arena, then_bid);
-  else_obj->v.obj.items[0].key = "to";
+  else_obj->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   else_obj->v.obj.items[0].value = jv_make_ref(&p->arena, else_bid);
   if (!then_obj->v.obj.items[0].value || !else_obj->v.obj.items[0].value) return false;
 
   JsonValue* cbr_fields = jv_make_obj(&p->arena, 3);
   if (!cbr_fields) return false;
-  cbr_fields->v.obj.items[0].key = "cond";
+  cbr_fields->v.obj.items[0].key = json_key_name(JSON_KEY_COND);
   cbr_fields->v.obj.items[0].value = jv_make_ref(&p->arena, cond_id);
-  cbr_fields->v.obj.items[1].key = "then";
+  cbr_fields->v.obj.items[1].key = json_key_name(JSON_KEY_THEN);
   cbr_fields->v.obj.items[1].value = then_obj;
-  cbr_fields->v.obj.items[2].key = "else";
+  cbr_fields->v.obj.items[2].key = json_key_name(JSON_KEY_ELSE);
   cbr_fields->v.obj.items[2].value = else_obj;
   if (!cbr_fields->v.obj.items[0].value) return false;
 
@@ -734,7 +750,7 @@ static bool lower_sem_value_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t sem_n
   new_entry_stmts->v.arr.items[prefix_n] = jv_make_ref(&p->arena, cbr_id);
   if (!new_entry_stmts->v.arr.items[prefix_n]) return false;
 
-  body->fields = block_fields_with_stmts(p, body->fields, new_entry_stmts, json_obj_get(body->fields, "params"));
+  body->fields = block_fields_with_stmts(p, body->fields, new_entry_stmts, json_obj_get_sym(body->fields, JSON_KEY_PARAMS));
   if (!body->fields) return false;
 
   // Rewrite fn to CFG form.
@@ -750,11 +766,11 @@ static bool lower_sem_value_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t sem_n
 
   // Only support non-CFG functions (fields.body) for MVP.
   int64_t body_id = 0;
-  if (!parse_node_ref_id(p, json_obj_get(fn->fields, "body"), &body_id)) return false;
+  if (!parse_node_ref_id(p, json_obj_get_sym(fn->fields, JSON_KEY_BODY), &body_id)) return false;
   NodeRec* body = get_node(p, body_id);
   if (!body || !body->fields) return false;
 
-  JsonValue* stmts = json_obj_get(body->fields, "stmts");
+  JsonValue* stmts = json_obj_get_sym(body->fields, JSON_KEY_STMTS);
   if (!stmts || stmts->type != JSON_ARRAY || stmts->v.arr.len == 0) return false;
 
   // Find the let stmt index.
@@ -772,7 +788,7 @@ static bool lower_sem_value_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t sem_n
 
   NodeRec* letn = get_node(p, let_stmt_id);
   if (!letn || !letn->tag || strcmp(letn->tag, "let") != 0) return false;
-  const char* let_name = letn->fields ? json_get_string(json_obj_get(letn->fields, "name")) : NULL;
+  const char* let_name = letn->fields ? json_get_string(json_obj_get_sym(letn->fields, JSON_KEY_NAME)) : NULL;
   if (!let_name || !*let_name) return false;
 
   NodeRec* semn = get_node(p, sem_node_id);
@@ -797,7 +813,7 @@ static bool lower_sem_value_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t sem_n
   semn->type_ref = result_ty;
   JsonValue* bpf = jv_make_obj(&p->arena, 1);
   if (!bpf) return false;
-  bpf->v.obj.items[0].key = "name";
+  bpf->v.obj.items[0].key = json_key_name(JSON_KEY_NAME);
   bpf->v.obj.items[0].value = jv_make(&p->arena, JSON_STRING);
   if (!bpf->v.obj.items[0].value) return false;
   bpf->v.obj.items[0].value->v.s = arena_strdup(&p->arena, let_name);
@@ -848,13 +864,13 @@ static bool lower_sem_value_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t sem_n
   JsonValue* then_br_fields = jv_make_obj(&p->arena, 2);
   JsonValue* else_br_fields = jv_make_obj(&p->arena, 2);
   if (!then_br_fields || !else_br_fields) return false;
-  then_br_fields->v.obj.items[0].key = "to";
+  then_br_fields->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   then_br_fields->v.obj.items[0].value = jv_make_ref(&p->arena, cont_bid);
-  then_br_fields->v.obj.items[1].key = "args";
+  then_br_fields->v.obj.items[1].key = json_key_name(JSON_KEY_ARGS);
   then_br_fields->v.obj.items[1].value = then_br_args;
-  else_br_fields->v.obj.items[0].key = "to";
+  else_br_fields->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   else_br_fields->v.obj.items[0].value = jv_make_ref(&p->arena, cont_bid);
-  else_br_fields->v.obj.items[1].key = "args";
+  else_br_fields->v.obj.items[1].key = json_key_name(JSON_KEY_ARGS);
   else_br_fields->v.obj.items[1].value = else_br_args;
   if (!then_br_fields->v.obj.items[0].value || !else_br_fields->v.obj.items[0].value) return false;
 
@@ -897,19 +913,19 @@ static bool lower_sem_value_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t sem_n
   JsonValue* then_obj = jv_make_obj(&p->arena, 1);
   JsonValue* else_obj = jv_make_obj(&p->arena, 1);
   if (!then_obj || !else_obj) return false;
-  then_obj->v.obj.items[0].key = "to";
+  then_obj->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   then_obj->v.obj.items[0].value = jv_make_ref(&p->arena, then_bid);
-  else_obj->v.obj.items[0].key = "to";
+  else_obj->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   else_obj->v.obj.items[0].value = jv_make_ref(&p->arena, else_bid);
   if (!then_obj->v.obj.items[0].value || !else_obj->v.obj.items[0].value) return false;
 
   JsonValue* cbr_fields = jv_make_obj(&p->arena, 3);
   if (!cbr_fields) return false;
-  cbr_fields->v.obj.items[0].key = "cond";
+  cbr_fields->v.obj.items[0].key = json_key_name(JSON_KEY_COND);
   cbr_fields->v.obj.items[0].value = jv_make_ref(&p->arena, cond_id);
-  cbr_fields->v.obj.items[1].key = "then";
+  cbr_fields->v.obj.items[1].key = json_key_name(JSON_KEY_THEN);
   cbr_fields->v.obj.items[1].value = then_obj;
-  cbr_fields->v.obj.items[2].key = "else";
+  cbr_fields->v.obj.items[2].key = json_key_name(JSON_KEY_ELSE);
   cbr_fields->v.obj.items[2].value = else_obj;
   if (!cbr_fields->v.obj.items[0].value) return false;
 
@@ -917,7 +933,7 @@ static bool lower_sem_value_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t sem_n
   new_entry_stmts->v.arr.items[let_idx] = jv_make_ref(&p->arena, cbr_id);
   if (!new_entry_stmts->v.arr.items[let_idx]) return false;
 
-  body->fields = block_fields_with_stmts(p, body->fields, new_entry_stmts, json_obj_get(body->fields, "params"));
+  body->fields = block_fields_with_stmts(p, body->fields, new_entry_stmts, json_obj_get_sym(body->fields, JSON_KEY_PARAMS));
   if (!body->fields) return false;
 
   int64_t blks[4] = {body_id, then_bid, else_bid, cont_bid};
@@ -929,11 +945,11 @@ static bool lower_sem_value_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t sem_n
 static bool lower_sem_value_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64_t block_id, int64_t sem_node_id, const char* sem_tag, int64_t cond_id,
                                           const BranchOperand* br_then, const BranchOperand* br_else, int64_t let_stmt_id) {
   if (!p || !fn || !fn->fields) return false;
-  if (!json_obj_get(fn->fields, "entry")) return false;
+  if (!json_obj_get_sym(fn->fields, JSON_KEY_ENTRY)) return false;
 
   NodeRec* blk = get_node(p, block_id);
   if (!blk || !blk->fields || !blk->tag || strcmp(blk->tag, "block") != 0) return false;
-  JsonValue* stmts = json_obj_get(blk->fields, "stmts");
+  JsonValue* stmts = json_obj_get_sym(blk->fields, JSON_KEY_STMTS);
   if (!stmts || stmts->type != JSON_ARRAY || stmts->v.arr.len == 0) return false;
 
   // Find the let stmt index.
@@ -950,7 +966,7 @@ static bool lower_sem_value_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64_t b
 
   NodeRec* letn = get_node(p, let_stmt_id);
   if (!letn || !letn->tag || strcmp(letn->tag, "let") != 0) return false;
-  const char* let_name = letn->fields ? json_get_string(json_obj_get(letn->fields, "name")) : NULL;
+  const char* let_name = letn->fields ? json_get_string(json_obj_get_sym(letn->fields, JSON_KEY_NAME)) : NULL;
   if (!let_name || !*let_name) return false;
 
   NodeRec* semn = get_node(p, sem_node_id);
@@ -970,7 +986,7 @@ static bool lower_sem_value_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64_t b
   semn->type_ref = result_ty;
   JsonValue* bpf = jv_make_obj(&p->arena, 1);
   if (!bpf) return false;
-  bpf->v.obj.items[0].key = "name";
+  bpf->v.obj.items[0].key = json_key_name(JSON_KEY_NAME);
   bpf->v.obj.items[0].value = jv_make(&p->arena, JSON_STRING);
   if (!bpf->v.obj.items[0].value) return false;
   bpf->v.obj.items[0].value->v.s = arena_strdup(&p->arena, let_name);
@@ -1019,13 +1035,13 @@ static bool lower_sem_value_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64_t b
   JsonValue* then_br_fields = jv_make_obj(&p->arena, 2);
   JsonValue* else_br_fields = jv_make_obj(&p->arena, 2);
   if (!then_br_fields || !else_br_fields) return false;
-  then_br_fields->v.obj.items[0].key = "to";
+  then_br_fields->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   then_br_fields->v.obj.items[0].value = jv_make_ref(&p->arena, cont_bid);
-  then_br_fields->v.obj.items[1].key = "args";
+  then_br_fields->v.obj.items[1].key = json_key_name(JSON_KEY_ARGS);
   then_br_fields->v.obj.items[1].value = then_br_args;
-  else_br_fields->v.obj.items[0].key = "to";
+  else_br_fields->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   else_br_fields->v.obj.items[0].value = jv_make_ref(&p->arena, cont_bid);
-  else_br_fields->v.obj.items[1].key = "args";
+  else_br_fields->v.obj.items[1].key = json_key_name(JSON_KEY_ARGS);
   else_br_fields->v.obj.items[1].value = else_br_args;
   if (!then_br_fields->v.obj.items[0].value || !else_br_fields->v.obj.items[0].value) return false;
 
@@ -1068,19 +1084,19 @@ static bool lower_sem_value_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64_t b
   JsonValue* then_obj = jv_make_obj(&p->arena, 1);
   JsonValue* else_obj = jv_make_obj(&p->arena, 1);
   if (!then_obj || !else_obj) return false;
-  then_obj->v.obj.items[0].key = "to";
+  then_obj->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   then_obj->v.obj.items[0].value = jv_make_ref(&p->arena, then_bid);
-  else_obj->v.obj.items[0].key = "to";
+  else_obj->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   else_obj->v.obj.items[0].value = jv_make_ref(&p->arena, else_bid);
   if (!then_obj->v.obj.items[0].value || !else_obj->v.obj.items[0].value) return false;
 
   JsonValue* cbr_fields = jv_make_obj(&p->arena, 3);
   if (!cbr_fields) return false;
-  cbr_fields->v.obj.items[0].key = "cond";
+  cbr_fields->v.obj.items[0].key = json_key_name(JSON_KEY_COND);
   cbr_fields->v.obj.items[0].value = jv_make_ref(&p->arena, cond_id);
-  cbr_fields->v.obj.items[1].key = "then";
+  cbr_fields->v.obj.items[1].key = json_key_name(JSON_KEY_THEN);
   cbr_fields->v.obj.items[1].value = then_obj;
-  cbr_fields->v.obj.items[2].key = "else";
+  cbr_fields->v.obj.items[2].key = json_key_name(JSON_KEY_ELSE);
   cbr_fields->v.obj.items[2].value = else_obj;
   if (!cbr_fields->v.obj.items[0].value) return false;
 
@@ -1088,7 +1104,7 @@ static bool lower_sem_value_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64_t b
   new_entry_stmts->v.arr.items[let_idx] = jv_make_ref(&p->arena, cbr_id);
   if (!new_entry_stmts->v.arr.items[let_idx]) return false;
 
-  blk->fields = block_fields_with_stmts(p, blk->fields, new_entry_stmts, json_obj_get(blk->fields, "params"));
+  blk->fields = block_fields_with_stmts(p, blk->fields, new_entry_stmts, json_obj_get_sym(blk->fields, JSON_KEY_PARAMS));
   if (!blk->fields) return false;
 
   const int64_t add_blks[3] = {then_bid, else_bid, cont_bid};
@@ -1100,11 +1116,11 @@ static bool lower_sem_match_sum_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t m
   if (!p || !fn || !fn->fields) return false;
 
   int64_t body_id = 0;
-  if (!parse_node_ref_id(p, json_obj_get(fn->fields, "body"), &body_id)) return false;
+  if (!parse_node_ref_id(p, json_obj_get_sym(fn->fields, JSON_KEY_BODY), &body_id)) return false;
   NodeRec* body = get_node(p, body_id);
   if (!body || !body->fields) return false;
 
-  JsonValue* stmts = json_obj_get(body->fields, "stmts");
+  JsonValue* stmts = json_obj_get_sym(body->fields, JSON_KEY_STMTS);
   if (!stmts || stmts->type != JSON_ARRAY || stmts->v.arr.len == 0) return false;
 
   // Require last stmt is term.ret/return and returns match_node_id.
@@ -1114,7 +1130,7 @@ static bool lower_sem_match_sum_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t m
   NodeRec* term = get_node(p, term_id);
   if (!term || !term->fields || !(strcmp(term->tag, "term.ret") == 0 || strcmp(term->tag, "return") == 0)) return false;
   int64_t got = 0;
-  if (!parse_node_ref_id(p, json_obj_get(term->fields, "value"), &got)) return false;
+  if (!parse_node_ref_id(p, json_obj_get_sym(term->fields, JSON_KEY_VALUE), &got)) return false;
   if (got != match_node_id) return false;
 
   NodeRec* mn = get_node(p, match_node_id);
@@ -1131,17 +1147,17 @@ static bool lower_sem_match_sum_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t m
   }
 
   int64_t sum_ty_id = 0;
-  if (!parse_type_ref_id(p, json_obj_get(mn->fields, "sum"), &sum_ty_id)) return false;
+  if (!parse_type_ref_id(p, json_obj_get_sym(mn->fields, JSON_KEY_SUM), &sum_ty_id)) return false;
   TypeRec* sty = get_type(p, sum_ty_id);
   if (!sty || sty->kind != TYPE_SUM) return false;
 
-  JsonValue* args = json_obj_get(mn->fields, "args");
+  JsonValue* args = json_obj_get_sym(mn->fields, JSON_KEY_ARGS);
   if (!args || args->type != JSON_ARRAY || args->v.arr.len != 1) return false;
   int64_t scrut_id = 0;
   if (!parse_node_ref_id(p, args->v.arr.items[0], &scrut_id)) return false;
 
-  JsonValue* cases = json_obj_get(mn->fields, "cases");
-  JsonValue* def = json_obj_get(mn->fields, "default");
+  JsonValue* cases = json_obj_get_sym(mn->fields, JSON_KEY_CASES);
+  JsonValue* def = json_obj_get_sym(mn->fields, JSON_KEY_DEFAULT);
   if (!cases || cases->type != JSON_ARRAY || !def || def->type != JSON_OBJECT) return false;
 
   const int64_t i32_ty = find_prim_type_id(p, "i32");
@@ -1172,7 +1188,7 @@ static bool lower_sem_match_sum_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t m
     JsonValue* co = cases->v.arr.items[i];
     if (!co || co->type != JSON_OBJECT) return false;
     int64_t variant = 0;
-    if (!json_get_i64(json_obj_get(co, "variant"), &variant)) return false;
+    if (!json_get_i64(json_obj_get_sym(co, JSON_KEY_VARIANT), &variant)) return false;
     if (variant < 0) return false;
     if (case_bids) {
       char suf[96];
@@ -1186,7 +1202,7 @@ static bool lower_sem_match_sum_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t m
     if (vix >= sty->variant_len) return false;
     const int64_t pay_ty = sty->variants[vix].ty;
 
-    JsonValue* body_br = json_obj_get(co, "body");
+    JsonValue* body_br = json_obj_get_sym(co, JSON_KEY_BODY);
     if (!body_br || body_br->type != JSON_OBJECT) return false;
     BranchOperand br = {0};
     if (!parse_branch_operand(p, body_br, &br)) return false;
@@ -1220,33 +1236,33 @@ static bool lower_sem_match_sum_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t m
         if (!get_args->v.arr.items[0]) return false;
         JsonValue* flags = jv_make_obj(&p->arena, 1);
         if (!flags) return false;
-        flags->v.obj.items[0].key = "variant";
+        flags->v.obj.items[0].key = json_key_name(JSON_KEY_VARIANT);
         JsonValue* vn = jv_make(&p->arena, JSON_NUMBER);
         if (!vn) return false;
         vn->v.i = (int64_t)vix;
         flags->v.obj.items[0].value = vn;
         JsonValue* ty_ref = jv_make_obj(&p->arena, 3);
         if (!ty_ref) return false;
-        ty_ref->v.obj.items[0].key = "t";
+        ty_ref->v.obj.items[0].key = json_key_name(JSON_KEY_T);
         ty_ref->v.obj.items[0].value = jv_make(&p->arena, JSON_STRING);
         if (!ty_ref->v.obj.items[0].value) return false;
         ty_ref->v.obj.items[0].value->v.s = "ref";
-        ty_ref->v.obj.items[1].key = "k";
+        ty_ref->v.obj.items[1].key = json_key_name(JSON_KEY_K);
         ty_ref->v.obj.items[1].value = jv_make(&p->arena, JSON_STRING);
         if (!ty_ref->v.obj.items[1].value) return false;
         ty_ref->v.obj.items[1].value->v.s = "type";
-        ty_ref->v.obj.items[2].key = "id";
+        ty_ref->v.obj.items[2].key = json_key_name(JSON_KEY_ID);
         ty_ref->v.obj.items[2].value = jv_make(&p->arena, JSON_NUMBER);
         if (!ty_ref->v.obj.items[2].value) return false;
         ty_ref->v.obj.items[2].value->v.i = sum_ty_id;
 
         JsonValue* get_fields = jv_make_obj(&p->arena, 3);
         if (!get_fields) return false;
-        get_fields->v.obj.items[0].key = "ty";
+        get_fields->v.obj.items[0].key = json_key_name(JSON_KEY_TY);
         get_fields->v.obj.items[0].value = ty_ref;
-        get_fields->v.obj.items[1].key = "args";
+        get_fields->v.obj.items[1].key = json_key_name(JSON_KEY_ARGS);
         get_fields->v.obj.items[1].value = get_args;
-        get_fields->v.obj.items[2].key = "flags";
+        get_fields->v.obj.items[2].key = json_key_name(JSON_KEY_FLAGS);
         get_fields->v.obj.items[2].value = flags;
         make_node_stub(p, payload_id, "adt.get", pay_ty, get_fields);
       }
@@ -1279,10 +1295,10 @@ static bool lower_sem_match_sum_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t m
 
     JsonValue* br_fields = jv_make_obj(&p->arena, 2);
     if (!br_fields) return false;
-    br_fields->v.obj.items[0].key = "to";
+    br_fields->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
     br_fields->v.obj.items[0].value = jv_make_ref(&p->arena, join_bid);
     if (!br_fields->v.obj.items[0].value) return false;
-    br_fields->v.obj.items[1].key = "args";
+    br_fields->v.obj.items[1].key = json_key_name(JSON_KEY_ARGS);
     br_fields->v.obj.items[1].value = br_args;
 
     make_node_stub(p, br_id, "term.br", 0, br_fields);
@@ -1322,10 +1338,10 @@ static bool lower_sem_match_sum_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t m
   if (!def_br_args->v.arr.items[0]) return false;
   JsonValue* def_br_fields = jv_make_obj(&p->arena, 2);
   if (!def_br_fields) return false;
-  def_br_fields->v.obj.items[0].key = "to";
+  def_br_fields->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   def_br_fields->v.obj.items[0].value = jv_make_ref(&p->arena, join_bid);
   if (!def_br_fields->v.obj.items[0].value) return false;
-  def_br_fields->v.obj.items[1].key = "args";
+  def_br_fields->v.obj.items[1].key = json_key_name(JSON_KEY_ARGS);
   def_br_fields->v.obj.items[1].value = def_br_args;
   make_node_stub(p, def_br_id, "term.br", 0, def_br_fields);
   def_stmts->v.arr.items[def_stmts->v.arr.len - 1] = jv_make_ref(&p->arena, def_br_id);
@@ -1342,7 +1358,7 @@ static bool lower_sem_match_sum_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t m
 
   JsonValue* ret_fields = jv_make_obj(&p->arena, 1);
   if (!ret_fields) return false;
-  ret_fields->v.obj.items[0].key = "value";
+  ret_fields->v.obj.items[0].key = json_key_name(JSON_KEY_VALUE);
   ret_fields->v.obj.items[0].value = jv_make_ref(&p->arena, match_node_id);
   if (!ret_fields->v.obj.items[0].value) return false;
   term->tag = "term.ret";
@@ -1371,7 +1387,7 @@ static bool lower_sem_match_sum_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t m
   if (!tag_args->v.arr.items[0]) return false;
   JsonValue* tag_fields = jv_make_obj(&p->arena, 1);
   if (!tag_fields) return false;
-  tag_fields->v.obj.items[0].key = "args";
+  tag_fields->v.obj.items[0].key = json_key_name(JSON_KEY_ARGS);
   tag_fields->v.obj.items[0].value = tag_args;
   make_node_stub(p, tag_id, "adt.tag", i32_ty, tag_fields);
 
@@ -1386,7 +1402,7 @@ static bool lower_sem_match_sum_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t m
     JsonValue* co = cases->v.arr.items[i];
     if (!co || co->type != JSON_OBJECT) return false;
     int64_t variant = 0;
-    if (!json_get_i64(json_obj_get(co, "variant"), &variant)) return false;
+    if (!json_get_i64(json_obj_get_sym(co, JSON_KEY_VARIANT), &variant)) return false;
     if (variant < 0) return false;
 
     char lsuf[96];
@@ -1395,7 +1411,7 @@ static bool lower_sem_match_sum_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t m
     if (!lit_id) return false;
     JsonValue* lit_fields = jv_make_obj(&p->arena, 1);
     if (!lit_fields) return false;
-    lit_fields->v.obj.items[0].key = "value";
+    lit_fields->v.obj.items[0].key = json_key_name(JSON_KEY_VALUE);
     JsonValue* ln = jv_make(&p->arena, JSON_NUMBER);
     if (!ln) return false;
     ln->v.i = variant;
@@ -1404,10 +1420,10 @@ static bool lower_sem_match_sum_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t m
 
     JsonValue* entry = jv_make_obj(&p->arena, 2);
     if (!entry) return false;
-    entry->v.obj.items[0].key = "lit";
+    entry->v.obj.items[0].key = json_key_name(JSON_KEY_LIT);
     entry->v.obj.items[0].value = jv_make_ref(&p->arena, lit_id);
     if (!entry->v.obj.items[0].value) return false;
-    entry->v.obj.items[1].key = "to";
+    entry->v.obj.items[1].key = json_key_name(JSON_KEY_TO);
     entry->v.obj.items[1].value = jv_make_ref(&p->arena, case_bids[i]);
     if (!entry->v.obj.items[1].value) return false;
     sw_cases->v.arr.items[i] = entry;
@@ -1415,7 +1431,7 @@ static bool lower_sem_match_sum_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t m
 
   JsonValue* sw_def = jv_make_obj(&p->arena, 1);
   if (!sw_def) return false;
-  sw_def->v.obj.items[0].key = "to";
+  sw_def->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   sw_def->v.obj.items[0].value = jv_make_ref(&p->arena, def_bid);
   if (!sw_def->v.obj.items[0].value) return false;
 
@@ -1424,18 +1440,18 @@ static bool lower_sem_match_sum_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t m
 
   JsonValue* sw_fields = jv_make_obj(&p->arena, 3);
   if (!sw_fields) return false;
-  sw_fields->v.obj.items[0].key = "scrut";
+  sw_fields->v.obj.items[0].key = json_key_name(JSON_KEY_SCRUT);
   sw_fields->v.obj.items[0].value = scrut_ref;
-  sw_fields->v.obj.items[1].key = "cases";
+  sw_fields->v.obj.items[1].key = json_key_name(JSON_KEY_CASES);
   sw_fields->v.obj.items[1].value = sw_cases;
-  sw_fields->v.obj.items[2].key = "default";
+  sw_fields->v.obj.items[2].key = json_key_name(JSON_KEY_DEFAULT);
   sw_fields->v.obj.items[2].value = sw_def;
 
   make_node_stub(p, sw_id, "term.switch", 0, sw_fields);
   new_entry_stmts->v.arr.items[prefix_n] = jv_make_ref(&p->arena, sw_id);
   if (!new_entry_stmts->v.arr.items[prefix_n]) return false;
 
-  body->fields = block_fields_with_stmts(p, body->fields, new_entry_stmts, json_obj_get(body->fields, "params"));
+  body->fields = block_fields_with_stmts(p, body->fields, new_entry_stmts, json_obj_get_sym(body->fields, JSON_KEY_PARAMS));
   if (!body->fields) return false;
 
   // Rewrite fn to CFG form.
@@ -1457,11 +1473,11 @@ static bool lower_sem_match_sum_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t m
   if (!p || !fn || !fn->fields) return false;
 
   int64_t body_id = 0;
-  if (!parse_node_ref_id(p, json_obj_get(fn->fields, "body"), &body_id)) return false;
+  if (!parse_node_ref_id(p, json_obj_get_sym(fn->fields, JSON_KEY_BODY), &body_id)) return false;
   NodeRec* body = get_node(p, body_id);
   if (!body || !body->fields) return false;
 
-  JsonValue* stmts = json_obj_get(body->fields, "stmts");
+  JsonValue* stmts = json_obj_get_sym(body->fields, JSON_KEY_STMTS);
   if (!stmts || stmts->type != JSON_ARRAY || stmts->v.arr.len == 0) return false;
 
   // Find the let stmt index.
@@ -1477,7 +1493,7 @@ static bool lower_sem_match_sum_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t m
   if (let_idx == (size_t)-1) return false;
   NodeRec* letn = get_node(p, let_stmt_id);
   if (!letn || !letn->fields || !letn->tag || strcmp(letn->tag, "let") != 0) return false;
-  const char* let_name = json_get_string(json_obj_get(letn->fields, "name"));
+  const char* let_name = json_get_string(json_obj_get_sym(letn->fields, JSON_KEY_NAME));
   if (!let_name || !*let_name) return false;
 
   NodeRec* mn = get_node(p, match_node_id);
@@ -1494,17 +1510,17 @@ static bool lower_sem_match_sum_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t m
   }
 
   int64_t sum_ty_id = 0;
-  if (!parse_type_ref_id(p, json_obj_get(mn->fields, "sum"), &sum_ty_id)) return false;
+  if (!parse_type_ref_id(p, json_obj_get_sym(mn->fields, JSON_KEY_SUM), &sum_ty_id)) return false;
   TypeRec* sty = get_type(p, sum_ty_id);
   if (!sty || sty->kind != TYPE_SUM) return false;
 
-  JsonValue* args = json_obj_get(mn->fields, "args");
+  JsonValue* args = json_obj_get_sym(mn->fields, JSON_KEY_ARGS);
   if (!args || args->type != JSON_ARRAY || args->v.arr.len != 1) return false;
   int64_t scrut_id = 0;
   if (!parse_node_ref_id(p, args->v.arr.items[0], &scrut_id)) return false;
 
-  JsonValue* cases = json_obj_get(mn->fields, "cases");
-  JsonValue* def = json_obj_get(mn->fields, "default");
+  JsonValue* cases = json_obj_get_sym(mn->fields, JSON_KEY_CASES);
+  JsonValue* def = json_obj_get_sym(mn->fields, JSON_KEY_DEFAULT);
   if (!cases || cases->type != JSON_ARRAY || !def || def->type != JSON_OBJECT) return false;
 
   const int64_t i32_ty = find_prim_type_id(p, "i32");
@@ -1518,7 +1534,7 @@ static bool lower_sem_match_sum_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t m
   mn->type_ref = result_ty;
   JsonValue* bpf = jv_make_obj(&p->arena, 1);
   if (!bpf) return false;
-  bpf->v.obj.items[0].key = "name";
+  bpf->v.obj.items[0].key = json_key_name(JSON_KEY_NAME);
   bpf->v.obj.items[0].value = jv_make(&p->arena, JSON_STRING);
   if (!bpf->v.obj.items[0].value) return false;
   bpf->v.obj.items[0].value->v.s = arena_strdup(&p->arena, let_name);
@@ -1564,7 +1580,7 @@ static bool lower_sem_match_sum_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t m
     JsonValue* co = cases->v.arr.items[i];
     if (!co || co->type != JSON_OBJECT) return false;
     int64_t variant = 0;
-    if (!json_get_i64(json_obj_get(co, "variant"), &variant)) return false;
+    if (!json_get_i64(json_obj_get_sym(co, JSON_KEY_VARIANT), &variant)) return false;
     if (variant < 0) return false;
     if (case_bids) {
       char suf[96];
@@ -1578,7 +1594,7 @@ static bool lower_sem_match_sum_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t m
     if (vix >= sty->variant_len) return false;
     const int64_t pay_ty = sty->variants[vix].ty;
 
-    JsonValue* body_br = json_obj_get(co, "body");
+    JsonValue* body_br = json_obj_get_sym(co, JSON_KEY_BODY);
     if (!body_br || body_br->type != JSON_OBJECT) return false;
     BranchOperand br = {0};
     if (!parse_branch_operand(p, body_br, &br)) return false;
@@ -1612,33 +1628,33 @@ static bool lower_sem_match_sum_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t m
         if (!get_args->v.arr.items[0]) return false;
         JsonValue* flags = jv_make_obj(&p->arena, 1);
         if (!flags) return false;
-        flags->v.obj.items[0].key = "variant";
+        flags->v.obj.items[0].key = json_key_name(JSON_KEY_VARIANT);
         JsonValue* vn = jv_make(&p->arena, JSON_NUMBER);
         if (!vn) return false;
         vn->v.i = (int64_t)vix;
         flags->v.obj.items[0].value = vn;
         JsonValue* ty_ref = jv_make_obj(&p->arena, 3);
         if (!ty_ref) return false;
-        ty_ref->v.obj.items[0].key = "t";
+        ty_ref->v.obj.items[0].key = json_key_name(JSON_KEY_T);
         ty_ref->v.obj.items[0].value = jv_make(&p->arena, JSON_STRING);
         if (!ty_ref->v.obj.items[0].value) return false;
         ty_ref->v.obj.items[0].value->v.s = "ref";
-        ty_ref->v.obj.items[1].key = "k";
+        ty_ref->v.obj.items[1].key = json_key_name(JSON_KEY_K);
         ty_ref->v.obj.items[1].value = jv_make(&p->arena, JSON_STRING);
         if (!ty_ref->v.obj.items[1].value) return false;
         ty_ref->v.obj.items[1].value->v.s = "type";
-        ty_ref->v.obj.items[2].key = "id";
+        ty_ref->v.obj.items[2].key = json_key_name(JSON_KEY_ID);
         ty_ref->v.obj.items[2].value = jv_make(&p->arena, JSON_NUMBER);
         if (!ty_ref->v.obj.items[2].value) return false;
         ty_ref->v.obj.items[2].value->v.i = sum_ty_id;
 
         JsonValue* get_fields = jv_make_obj(&p->arena, 3);
         if (!get_fields) return false;
-        get_fields->v.obj.items[0].key = "ty";
+        get_fields->v.obj.items[0].key = json_key_name(JSON_KEY_TY);
         get_fields->v.obj.items[0].value = ty_ref;
-        get_fields->v.obj.items[1].key = "args";
+        get_fields->v.obj.items[1].key = json_key_name(JSON_KEY_ARGS);
         get_fields->v.obj.items[1].value = get_args;
-        get_fields->v.obj.items[2].key = "flags";
+        get_fields->v.obj.items[2].key = json_key_name(JSON_KEY_FLAGS);
         get_fields->v.obj.items[2].value = flags;
         make_node_stub(p, payload_id, "adt.get", pay_ty, get_fields);
       }
@@ -1669,10 +1685,10 @@ static bool lower_sem_match_sum_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t m
     if (!br_args->v.arr.items[0]) return false;
     JsonValue* br_fields = jv_make_obj(&p->arena, 2);
     if (!br_fields) return false;
-    br_fields->v.obj.items[0].key = "to";
+    br_fields->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
     br_fields->v.obj.items[0].value = jv_make_ref(&p->arena, cont_bid);
     if (!br_fields->v.obj.items[0].value) return false;
-    br_fields->v.obj.items[1].key = "args";
+    br_fields->v.obj.items[1].key = json_key_name(JSON_KEY_ARGS);
     br_fields->v.obj.items[1].value = br_args;
     make_node_stub(p, br_id, "term.br", 0, br_fields);
 
@@ -1708,10 +1724,10 @@ static bool lower_sem_match_sum_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t m
   if (!def_br_args->v.arr.items[0]) return false;
   JsonValue* def_br_fields = jv_make_obj(&p->arena, 2);
   if (!def_br_fields) return false;
-  def_br_fields->v.obj.items[0].key = "to";
+  def_br_fields->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   def_br_fields->v.obj.items[0].value = jv_make_ref(&p->arena, cont_bid);
   if (!def_br_fields->v.obj.items[0].value) return false;
-  def_br_fields->v.obj.items[1].key = "args";
+  def_br_fields->v.obj.items[1].key = json_key_name(JSON_KEY_ARGS);
   def_br_fields->v.obj.items[1].value = def_br_args;
   make_node_stub(p, def_br_id, "term.br", 0, def_br_fields);
   def_stmts->v.arr.items[def_stmts->v.arr.len - 1] = jv_make_ref(&p->arena, def_br_id);
@@ -1734,7 +1750,7 @@ static bool lower_sem_match_sum_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t m
   if (!tag_args->v.arr.items[0]) return false;
   JsonValue* tag_fields = jv_make_obj(&p->arena, 1);
   if (!tag_fields) return false;
-  tag_fields->v.obj.items[0].key = "args";
+  tag_fields->v.obj.items[0].key = json_key_name(JSON_KEY_ARGS);
   tag_fields->v.obj.items[0].value = tag_args;
   make_node_stub(p, tag_id, "adt.tag", i32_ty, tag_fields);
 
@@ -1749,7 +1765,7 @@ static bool lower_sem_match_sum_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t m
     JsonValue* co = cases->v.arr.items[i];
     if (!co || co->type != JSON_OBJECT) return false;
     int64_t variant = 0;
-    if (!json_get_i64(json_obj_get(co, "variant"), &variant)) return false;
+    if (!json_get_i64(json_obj_get_sym(co, JSON_KEY_VARIANT), &variant)) return false;
     if (variant < 0) return false;
 
     char lsuf[96];
@@ -1758,7 +1774,7 @@ static bool lower_sem_match_sum_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t m
     if (!lit_id) return false;
     JsonValue* lit_fields = jv_make_obj(&p->arena, 1);
     if (!lit_fields) return false;
-    lit_fields->v.obj.items[0].key = "value";
+    lit_fields->v.obj.items[0].key = json_key_name(JSON_KEY_VALUE);
     JsonValue* ln = jv_make(&p->arena, JSON_NUMBER);
     if (!ln) return false;
     ln->v.i = variant;
@@ -1767,10 +1783,10 @@ static bool lower_sem_match_sum_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t m
 
     JsonValue* entry = jv_make_obj(&p->arena, 2);
     if (!entry) return false;
-    entry->v.obj.items[0].key = "lit";
+    entry->v.obj.items[0].key = json_key_name(JSON_KEY_LIT);
     entry->v.obj.items[0].value = jv_make_ref(&p->arena, lit_id);
     if (!entry->v.obj.items[0].value) return false;
-    entry->v.obj.items[1].key = "to";
+    entry->v.obj.items[1].key = json_key_name(JSON_KEY_TO);
     entry->v.obj.items[1].value = jv_make_ref(&p->arena, case_bids[i]);
     if (!entry->v.obj.items[1].value) return false;
     sw_cases->v.arr.items[i] = entry;
@@ -1778,25 +1794,25 @@ static bool lower_sem_match_sum_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t m
 
   JsonValue* sw_def = jv_make_obj(&p->arena, 1);
   if (!sw_def) return false;
-  sw_def->v.obj.items[0].key = "to";
+  sw_def->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   sw_def->v.obj.items[0].value = jv_make_ref(&p->arena, def_bid);
   if (!sw_def->v.obj.items[0].value) return false;
 
   JsonValue* sw_fields = jv_make_obj(&p->arena, 3);
   if (!sw_fields) return false;
-  sw_fields->v.obj.items[0].key = "scrut";
+  sw_fields->v.obj.items[0].key = json_key_name(JSON_KEY_SCRUT);
   sw_fields->v.obj.items[0].value = jv_make_ref(&p->arena, tag_id);
   if (!sw_fields->v.obj.items[0].value) return false;
-  sw_fields->v.obj.items[1].key = "cases";
+  sw_fields->v.obj.items[1].key = json_key_name(JSON_KEY_CASES);
   sw_fields->v.obj.items[1].value = sw_cases;
-  sw_fields->v.obj.items[2].key = "default";
+  sw_fields->v.obj.items[2].key = json_key_name(JSON_KEY_DEFAULT);
   sw_fields->v.obj.items[2].value = sw_def;
 
   make_node_stub(p, sw_id, "term.switch", 0, sw_fields);
   new_entry_stmts->v.arr.items[let_idx] = jv_make_ref(&p->arena, sw_id);
   if (!new_entry_stmts->v.arr.items[let_idx]) return false;
 
-  body->fields = block_fields_with_stmts(p, body->fields, new_entry_stmts, json_obj_get(body->fields, "params"));
+  body->fields = block_fields_with_stmts(p, body->fields, new_entry_stmts, json_obj_get_sym(body->fields, JSON_KEY_PARAMS));
   if (!body->fields) return false;
 
   const size_t blk_n = 1 + case_n + 2; // entry + cases + default + cont
@@ -1815,11 +1831,11 @@ static bool lower_sem_match_sum_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t m
 
 static bool lower_sem_match_sum_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64_t block_id, int64_t match_node_id, int64_t let_stmt_id) {
   if (!p || !fn || !fn->fields) return false;
-  if (!json_obj_get(fn->fields, "entry")) return false;
+  if (!json_obj_get_sym(fn->fields, JSON_KEY_ENTRY)) return false;
 
   NodeRec* blk = get_node(p, block_id);
   if (!blk || !blk->fields || !blk->tag || strcmp(blk->tag, "block") != 0) return false;
-  JsonValue* stmts = json_obj_get(blk->fields, "stmts");
+  JsonValue* stmts = json_obj_get_sym(blk->fields, JSON_KEY_STMTS);
   if (!stmts || stmts->type != JSON_ARRAY || stmts->v.arr.len == 0) return false;
 
   // Find the let stmt index.
@@ -1836,7 +1852,7 @@ static bool lower_sem_match_sum_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64
 
   NodeRec* letn = get_node(p, let_stmt_id);
   if (!letn || !letn->fields || !letn->tag || strcmp(letn->tag, "let") != 0) return false;
-  const char* let_name = json_get_string(json_obj_get(letn->fields, "name"));
+  const char* let_name = json_get_string(json_obj_get_sym(letn->fields, JSON_KEY_NAME));
   if (!let_name || !*let_name) return false;
 
   NodeRec* mn = get_node(p, match_node_id);
@@ -1845,17 +1861,17 @@ static bool lower_sem_match_sum_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64
   if (result_ty == 0) return false;
 
   int64_t sum_ty_id = 0;
-  if (!parse_type_ref_id(p, json_obj_get(mn->fields, "sum"), &sum_ty_id)) return false;
+  if (!parse_type_ref_id(p, json_obj_get_sym(mn->fields, JSON_KEY_SUM), &sum_ty_id)) return false;
   TypeRec* sty = get_type(p, sum_ty_id);
   if (!sty || sty->kind != TYPE_SUM) return false;
 
-  JsonValue* args = json_obj_get(mn->fields, "args");
+  JsonValue* args = json_obj_get_sym(mn->fields, JSON_KEY_ARGS);
   if (!args || args->type != JSON_ARRAY || args->v.arr.len != 1) return false;
   int64_t scrut_id = 0;
   if (!parse_node_ref_id(p, args->v.arr.items[0], &scrut_id)) return false;
 
-  JsonValue* cases = json_obj_get(mn->fields, "cases");
-  JsonValue* def = json_obj_get(mn->fields, "default");
+  JsonValue* cases = json_obj_get_sym(mn->fields, JSON_KEY_CASES);
+  JsonValue* def = json_obj_get_sym(mn->fields, JSON_KEY_DEFAULT);
   if (!cases || cases->type != JSON_ARRAY || !def || def->type != JSON_OBJECT) return false;
 
   const int64_t i32_ty = find_prim_type_id(p, "i32");
@@ -1866,7 +1882,7 @@ static bool lower_sem_match_sum_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64
   mn->type_ref = result_ty;
   JsonValue* bpf = jv_make_obj(&p->arena, 1);
   if (!bpf) return false;
-  bpf->v.obj.items[0].key = "name";
+  bpf->v.obj.items[0].key = json_key_name(JSON_KEY_NAME);
   bpf->v.obj.items[0].value = jv_make(&p->arena, JSON_STRING);
   if (!bpf->v.obj.items[0].value) return false;
   bpf->v.obj.items[0].value->v.s = arena_strdup(&p->arena, let_name);
@@ -1910,7 +1926,7 @@ static bool lower_sem_match_sum_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64
     JsonValue* co = cases->v.arr.items[i];
     if (!co || co->type != JSON_OBJECT) return false;
     int64_t variant = 0;
-    if (!json_get_i64(json_obj_get(co, "variant"), &variant)) return false;
+    if (!json_get_i64(json_obj_get_sym(co, JSON_KEY_VARIANT), &variant)) return false;
     if (variant < 0) return false;
     if (case_bids) {
       char suf[96];
@@ -1924,7 +1940,7 @@ static bool lower_sem_match_sum_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64
     if (vix >= sty->variant_len) return false;
     const int64_t pay_ty = sty->variants[vix].ty;
 
-    JsonValue* body_br = json_obj_get(co, "body");
+    JsonValue* body_br = json_obj_get_sym(co, JSON_KEY_BODY);
     if (!body_br || body_br->type != JSON_OBJECT) return false;
     BranchOperand br = {0};
     if (!parse_branch_operand(p, body_br, &br)) return false;
@@ -1958,33 +1974,33 @@ static bool lower_sem_match_sum_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64
         if (!get_args->v.arr.items[0]) return false;
         JsonValue* flags = jv_make_obj(&p->arena, 1);
         if (!flags) return false;
-        flags->v.obj.items[0].key = "variant";
+        flags->v.obj.items[0].key = json_key_name(JSON_KEY_VARIANT);
         JsonValue* vn = jv_make(&p->arena, JSON_NUMBER);
         if (!vn) return false;
         vn->v.i = (int64_t)vix;
         flags->v.obj.items[0].value = vn;
         JsonValue* ty_ref = jv_make_obj(&p->arena, 3);
         if (!ty_ref) return false;
-        ty_ref->v.obj.items[0].key = "t";
+        ty_ref->v.obj.items[0].key = json_key_name(JSON_KEY_T);
         ty_ref->v.obj.items[0].value = jv_make(&p->arena, JSON_STRING);
         if (!ty_ref->v.obj.items[0].value) return false;
         ty_ref->v.obj.items[0].value->v.s = "ref";
-        ty_ref->v.obj.items[1].key = "k";
+        ty_ref->v.obj.items[1].key = json_key_name(JSON_KEY_K);
         ty_ref->v.obj.items[1].value = jv_make(&p->arena, JSON_STRING);
         if (!ty_ref->v.obj.items[1].value) return false;
         ty_ref->v.obj.items[1].value->v.s = "type";
-        ty_ref->v.obj.items[2].key = "id";
+        ty_ref->v.obj.items[2].key = json_key_name(JSON_KEY_ID);
         ty_ref->v.obj.items[2].value = jv_make(&p->arena, JSON_NUMBER);
         if (!ty_ref->v.obj.items[2].value) return false;
         ty_ref->v.obj.items[2].value->v.i = sum_ty_id;
 
         JsonValue* get_fields = jv_make_obj(&p->arena, 3);
         if (!get_fields) return false;
-        get_fields->v.obj.items[0].key = "ty";
+        get_fields->v.obj.items[0].key = json_key_name(JSON_KEY_TY);
         get_fields->v.obj.items[0].value = ty_ref;
-        get_fields->v.obj.items[1].key = "args";
+        get_fields->v.obj.items[1].key = json_key_name(JSON_KEY_ARGS);
         get_fields->v.obj.items[1].value = get_args;
-        get_fields->v.obj.items[2].key = "flags";
+        get_fields->v.obj.items[2].key = json_key_name(JSON_KEY_FLAGS);
         get_fields->v.obj.items[2].value = flags;
         make_node_stub(p, payload_id, "adt.get", pay_ty, get_fields);
       }
@@ -2015,10 +2031,10 @@ static bool lower_sem_match_sum_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64
     if (!br_args->v.arr.items[0]) return false;
     JsonValue* br_fields = jv_make_obj(&p->arena, 2);
     if (!br_fields) return false;
-    br_fields->v.obj.items[0].key = "to";
+    br_fields->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
     br_fields->v.obj.items[0].value = jv_make_ref(&p->arena, cont_bid);
     if (!br_fields->v.obj.items[0].value) return false;
-    br_fields->v.obj.items[1].key = "args";
+    br_fields->v.obj.items[1].key = json_key_name(JSON_KEY_ARGS);
     br_fields->v.obj.items[1].value = br_args;
     make_node_stub(p, br_id, "term.br", 0, br_fields);
 
@@ -2054,10 +2070,10 @@ static bool lower_sem_match_sum_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64
   if (!def_br_args->v.arr.items[0]) return false;
   JsonValue* def_br_fields = jv_make_obj(&p->arena, 2);
   if (!def_br_fields) return false;
-  def_br_fields->v.obj.items[0].key = "to";
+  def_br_fields->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   def_br_fields->v.obj.items[0].value = jv_make_ref(&p->arena, cont_bid);
   if (!def_br_fields->v.obj.items[0].value) return false;
-  def_br_fields->v.obj.items[1].key = "args";
+  def_br_fields->v.obj.items[1].key = json_key_name(JSON_KEY_ARGS);
   def_br_fields->v.obj.items[1].value = def_br_args;
   make_node_stub(p, def_br_id, "term.br", 0, def_br_fields);
   def_stmts->v.arr.items[def_stmts->v.arr.len - 1] = jv_make_ref(&p->arena, def_br_id);
@@ -2079,7 +2095,7 @@ static bool lower_sem_match_sum_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64
   if (!tag_args->v.arr.items[0]) return false;
   JsonValue* tag_fields = jv_make_obj(&p->arena, 1);
   if (!tag_fields) return false;
-  tag_fields->v.obj.items[0].key = "args";
+  tag_fields->v.obj.items[0].key = json_key_name(JSON_KEY_ARGS);
   tag_fields->v.obj.items[0].value = tag_args;
   make_node_stub(p, tag_id, "adt.tag", i32_ty, tag_fields);
 
@@ -2092,7 +2108,7 @@ static bool lower_sem_match_sum_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64
     JsonValue* co = cases->v.arr.items[i];
     if (!co || co->type != JSON_OBJECT) return false;
     int64_t variant = 0;
-    if (!json_get_i64(json_obj_get(co, "variant"), &variant)) return false;
+    if (!json_get_i64(json_obj_get_sym(co, JSON_KEY_VARIANT), &variant)) return false;
     if (variant < 0) return false;
 
     char lsuf[96];
@@ -2101,7 +2117,7 @@ static bool lower_sem_match_sum_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64
     if (!lit_id) return false;
     JsonValue* lit_fields = jv_make_obj(&p->arena, 1);
     if (!lit_fields) return false;
-    lit_fields->v.obj.items[0].key = "value";
+    lit_fields->v.obj.items[0].key = json_key_name(JSON_KEY_VALUE);
     JsonValue* ln = jv_make(&p->arena, JSON_NUMBER);
     if (!ln) return false;
     ln->v.i = variant;
@@ -2110,10 +2126,10 @@ static bool lower_sem_match_sum_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64
 
     JsonValue* entry = jv_make_obj(&p->arena, 2);
     if (!entry) return false;
-    entry->v.obj.items[0].key = "lit";
+    entry->v.obj.items[0].key = json_key_name(JSON_KEY_LIT);
     entry->v.obj.items[0].value = jv_make_ref(&p->arena, lit_id);
     if (!entry->v.obj.items[0].value) return false;
-    entry->v.obj.items[1].key = "to";
+    entry->v.obj.items[1].key = json_key_name(JSON_KEY_TO);
     entry->v.obj.items[1].value = jv_make_ref(&p->arena, case_bids[i]);
     if (!entry->v.obj.items[1].value) return false;
     sw_cases->v.arr.items[i] = entry;
@@ -2121,25 +2137,25 @@ static bool lower_sem_match_sum_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64
 
   JsonValue* sw_def = jv_make_obj(&p->arena, 1);
   if (!sw_def) return false;
-  sw_def->v.obj.items[0].key = "to";
+  sw_def->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   sw_def->v.obj.items[0].value = jv_make_ref(&p->arena, def_bid);
   if (!sw_def->v.obj.items[0].value) return false;
 
   JsonValue* sw_fields = jv_make_obj(&p->arena, 3);
   if (!sw_fields) return false;
-  sw_fields->v.obj.items[0].key = "scrut";
+  sw_fields->v.obj.items[0].key = json_key_name(JSON_KEY_SCRUT);
   sw_fields->v.obj.items[0].value = jv_make_ref(&p->arena, tag_id);
   if (!sw_fields->v.obj.items[0].value) return false;
-  sw_fields->v.obj.items[1].key = "cases";
+  sw_fields->v.obj.items[1].key = json_key_name(JSON_KEY_CASES);
   sw_fields->v.obj.items[1].value = sw_cases;
-  sw_fields->v.obj.items[2].key = "default";
+  sw_fields->v.obj.items[2].key = json_key_name(JSON_KEY_DEFAULT);
   sw_fields->v.obj.items[2].value = sw_def;
   make_node_stub(p, sw_id, "term.switch", 0, sw_fields);
 
   new_entry_stmts->v.arr.items[let_idx] = jv_make_ref(&p->arena, sw_id);
   if (!new_entry_stmts->v.arr.items[let_idx]) return false;
 
-  blk->fields = block_fields_with_stmts(p, blk->fields, new_entry_stmts, json_obj_get(blk->fields, "params"));
+  blk->fields = block_fields_with_stmts(p, blk->fields, new_entry_stmts, json_obj_get_sym(blk->fields, JSON_KEY_PARAMS));
   if (!blk->fields) return false;
 
   // Append blocks (cont + cases + default).
@@ -2157,7 +2173,7 @@ static bool lower_sem_match_sum_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64
 
 static bool lower_sem_sc_to_bool_bin(SirProgram* p, NodeRec* n, bool is_and) {
   if (!p || !n || !n->fields) return false;
-  JsonValue* args = json_obj_get(n->fields, "args");
+  JsonValue* args = json_obj_get_sym(n->fields, JSON_KEY_ARGS);
   if (!args || args->type != JSON_ARRAY || args->v.arr.len != 2) return false;
 
   JsonValue* lhs_ref = args->v.arr.items[0];
@@ -2165,14 +2181,14 @@ static bool lower_sem_sc_to_bool_bin(SirProgram* p, NodeRec* n, bool is_and) {
   if (!lhs_ref || !rhs_branch) return false;
   if (rhs_branch->type != JSON_OBJECT) return false;
 
-  const char* k_rhs = json_get_string(json_obj_get(rhs_branch, "kind"));
+  const char* k_rhs = json_get_string(json_obj_get_sym(rhs_branch, JSON_KEY_KIND));
   if (!k_rhs) return false;
   if (strcmp(k_rhs, "val") != 0) {
     // Not applicable: CFG lowering handles thunk RHS (in return-position only for now).
     return false;
   }
 
-  JsonValue* v_rhs = json_obj_get(rhs_branch, "v");
+  JsonValue* v_rhs = json_obj_get_sym(rhs_branch, JSON_KEY_V);
   if (!v_rhs) return false;
 
   JsonValue* new_args = jv_make_arr(&p->arena, 2);
@@ -2190,7 +2206,7 @@ static bool lower_sem_sc_to_bool_bin(SirProgram* p, NodeRec* n, bool is_and) {
     SIRCC_ERR_NODE(p, n, "sircc.oom", "sircc: out of memory");
     return false;
   }
-  new_fields->v.obj.items[0].key = "args";
+  new_fields->v.obj.items[0].key = json_key_name(JSON_KEY_ARGS);
   new_fields->v.obj.items[0].value = new_args;
 
   n->tag = is_and ? "bool.and" : "bool.or";
@@ -2251,8 +2267,52 @@ static bool hoist_let_list_push(SirProgram* p, HoistLetList* l, int64_t id) {
   return true;
 }
 
-static bool hoist_sem_in_slot(SirProgram* p, JsonValue** slot, SemHoistMap* hoisted, HoistLetList* out_lets, uint8_t* visiting,
-                              size_t visiting_cap) {
+// Visited set for hoisting scans, indexed by node id. Starting a scan bumps the generation
+// instead of clearing the array, so a scan costs O(nodes reached) rather than O(nodes_cap).
+typedef struct SemVisitSet {
+  uint32_t* stamp;
+  size_t cap;
+  uint32_t gen;
+} SemVisitSet;
+
+static bool sem_visit_reserve(SemVisitSet* v, size_t need) {
+  if (need <= v->cap) return true;
+  size_t ncap = v->cap ? v->cap : 256;
+  while (ncap < need) ncap *= 2;
+  uint32_t* ns = (uint32_t*)realloc(v->stamp, ncap * sizeof(*ns));
+  if (!ns) return false;
+  memset(ns + v->cap, 0, (ncap - v->cap) * sizeof(*ns));
+  v->stamp = ns;
+  v->cap = ncap;
+  return true;
+}
+
+static void sem_visit_begin(SemVisitSet* v) {
+  if (++v->gen == 0) {
+    if (v->stamp) memset(v->stamp, 0, v->cap * sizeof(*v->stamp));
+    v->gen = 1;
+  }
+}
+
+// Marks `id` visited in the current scan; *out_seen reports whether it already was.
+static bool sem_visit_mark(SemVisitSet* v, int64_t id, bool* out_seen) {
+  *out_seen = false;
+  if (id <= 0) return true;
+  if (!sem_visit_reserve(v, (size_t)id + 1)) return false;
+  if (v->stamp[id] == v->gen) {
+    *out_seen = true;
+    return true;
+  }
+  v->stamp[id] = v->gen;
+  return true;
+}
+
+static void sem_visit_free(SemVisitSet* v) {
+  free(v->stamp);
+  memset(v, 0, sizeof(*v));
+}
+
+static bool hoist_sem_in_slot(SirProgram* p, JsonValue** slot, SemHoistMap* hoisted, HoistLetList* out_lets, SemVisitSet* visit) {
   if (!p || !slot || !*slot) return true;
 
   int64_t ref_id = 0;
@@ -2284,7 +2344,7 @@ static bool hoist_sem_in_slot(SirProgram* p, JsonValue** slot, SemHoistMap* hois
       if (!name_id) return false;
       JsonValue* name_fields = jv_make_obj(&p->arena, 1);
       if (!name_fields) return false;
-      name_fields->v.obj.items[0].key = "name";
+      name_fields->v.obj.items[0].key = json_key_name(JSON_KEY_NAME);
       name_fields->v.obj.items[0].value = jv_make_str(&p->arena, tmp_name);
       if (!name_fields->v.obj.items[0].value) return false;
       make_node_stub(p, name_id, "name", n->type_ref, name_fields);
@@ -2293,10 +2353,10 @@ static bool hoist_sem_in_slot(SirProgram* p, JsonValue** slot, SemHoistMap* hois
       if (!let_id) return false;
       JsonValue* let_fields = jv_make_obj(&p->arena, 2);
       if (!let_fields) return false;
-      let_fields->v.obj.items[0].key = "name";
+      let_fields->v.obj.items[0].key = json_key_name(JSON_KEY_NAME);
       let_fields->v.obj.items[0].value = jv_make_str(&p->arena, tmp_name);
       if (!let_fields->v.obj.items[0].value) return false;
-      let_fields->v.obj.items[1].key = "value";
+      let_fields->v.obj.items[1].key = json_key_name(JSON_KEY_VALUE);
       let_fields->v.obj.items[1].value = *slot; // keep the sem ref
       make_node_stub(p, let_id, "let", 0, let_fields);
 
@@ -2308,18 +2368,21 @@ static bool hoist_sem_in_slot(SirProgram* p, JsonValue** slot, SemHoistMap* hois
       return true;
     }
 
+    // Blocks reached through branch targets are scanned on their own; descending into one
+    // would hoist a successor's sem.* into the current block.
+    if (strcmp(n->tag, "block") == 0) return true;
+
     // Recurse into referenced node fields to find sem nested inside expressions.
-    if (ref_id > 0 && (size_t)ref_id < visiting_cap && visiting) {
-      if (visiting[ref_id]) return true;
-      visiting[ref_id] = 1;
-    }
+    bool seen = false;
+    if (!sem_visit_mark(visit, ref_id, &seen)) return false;
+    if (seen) return true;
     if (n->fields && n->fields->type == JSON_OBJECT) {
       for (size_t i = 0; i < n->fields->v.obj.len; i++) {
-        if (!hoist_sem_in_slot(p, &n->fields->v.obj.items[i].value, hoisted, out_lets, visiting, visiting_cap)) return false;
+        if (!hoist_sem_in_slot(p, &n->fields->v.obj.items[i].value, hoisted, out_lets, visit)) return false;
       }
     } else if (n->fields && n->fields->type == JSON_ARRAY) {
       for (size_t i = 0; i < n->fields->v.arr.len; i++) {
-        if (!hoist_sem_in_slot(p, &n->fields->v.arr.items[i], hoisted, out_lets, visiting, visiting_cap)) return false;
+        if (!hoist_sem_in_slot(p, &n->fields->v.arr.items[i], hoisted, out_lets, visit)) return false;
       }
     }
     return true;
@@ -2327,11 +2390,11 @@ static bool hoist_sem_in_slot(SirProgram* p, JsonValue** slot, SemHoistMap* hois
 
   if ((*slot)->type == JSON_ARRAY) {
     for (size_t i = 0; i < (*slot)->v.arr.len; i++) {
-      if (!hoist_sem_in_slot(p, &(*slot)->v.arr.items[i], hoisted, out_lets, visiting, visiting_cap)) return false;
+      if (!hoist_sem_in_slot(p, &(*slot)->v.arr.items[i], hoisted, out_lets, visit)) return false;
     }
   } else if ((*slot)->type == JSON_OBJECT) {
     for (size_t i = 0; i < (*slot)->v.obj.len; i++) {
-      if (!hoist_sem_in_slot(p, &(*slot)->v.obj.items[i].value, hoisted, out_lets, visiting, visiting_cap)) return false;
+      if (!hoist_sem_in_slot(p, &(*slot)->v.obj.items[i].value, hoisted, out_lets, visit)) return false;
     }
   }
   return true;
@@ -2361,7 +2424,7 @@ static bool sem_parse_while_operands(SirProgram* p, NodeRec* wn, BranchOperand*
   memset(out_cond, 0, sizeof(*out_cond));
   memset(out_body, 0, sizeof(*out_body));
   if (!wn->fields || wn->fields->type != JSON_OBJECT) return false;
-  JsonValue* args = json_obj_get(wn->fields, "args");
+  JsonValue* args = json_obj_get_sym(wn->fields, JSON_KEY_ARGS);
   if (!args || args->type != JSON_ARRAY || args->v.arr.len != 2) return false;
   if (!parse_branch_operand(p, args->v.arr.items[0], out_cond)) return false;
   if (!parse_branch_operand(p, args->v.arr.items[1], out_body)) return false;
@@ -2375,7 +2438,7 @@ static bool make_const_i32(SirProgram* p, int64_t base_id, const char* suf, int6
   if (!cid) return false;
   JsonValue* c_fields = jv_make_obj(&p->arena, 1);
   if (!c_fields) return false;
-  c_fields->v.obj.items[0].key = "value";
+  c_fields->v.obj.items[0].key = json_key_name(JSON_KEY_VALUE);
   JsonValue* lit = jv_make(&p->arena, JSON_NUMBER);
   if (!lit) return false;
   lit->v.i = v;
@@ -2419,7 +2482,7 @@ static bool lower_sem_loop_ctl_in_stmts(SirProgram* p, JsonValue* stmts, size_t
 
   JsonValue* r_fields = jv_make_obj(&p->arena, 1);
   if (!r_fields) return false;
-  r_fields->v.obj.items[0].key = "value";
+  r_fields->v.obj.items[0].key = json_key_name(JSON_KEY_VALUE);
   r_fields->v.obj.items[0].value = jv_make_ref(&p->arena, c_id);
   if (!r_fields->v.obj.items[0].value) return false;
 
@@ -2432,11 +2495,11 @@ static bool lower_sem_loop_ctl_in_stmts(SirProgram* p, JsonValue* stmts, size_t
 static bool lower_sem_defer_in_body_fn(SirProgram* p, NodeRec* fn, int64_t body_id, bool* out_did) {
   if (out_did) *out_did = false;
   if (!p || !fn || !fn->fields) return false;
-  if (json_obj_get(fn->fields, "entry")) return true; // not body-form
+  if (json_obj_get_sym(fn->fields, JSON_KEY_ENTRY)) return true; // not body-form
 
   NodeRec* body = get_node(p, body_id);
   if (!body || !body->fields) return false;
-  JsonValue* stmts = json_obj_get(body->fields, "stmts");
+  JsonValue* stmts = json_obj_get_sym(body->fields, JSON_KEY_STMTS);
   if (!stmts || stmts->type != JSON_ARRAY || stmts->v.arr.len == 0) return true;
 
   // Collect defers and remove sem.defer statements.
@@ -2455,7 +2518,7 @@ static bool lower_sem_defer_in_body_fn(SirProgram* p, NodeRec* fn, int64_t body_
 
     if (strcmp(s->tag, "sem.defer") == 0) {
       if (!s->fields || s->fields->type != JSON_OBJECT) return false;
-      JsonValue* args = json_obj_get(s->fields, "args");
+      JsonValue* args = json_obj_get_sym(s->fields, JSON_KEY_ARGS);
       if (!args || args->type != JSON_ARRAY || args->v.arr.len != 1) return false;
       BranchOperand br = {0};
       if (!parse_branch_operand(p, args->v.arr.items[0], &br)) return false;
@@ -2569,7 +2632,7 @@ static bool lower_sem_defer_in_body_fn(SirProgram* p, NodeRec* fn, int64_t body_
     return false;
   }
   for (size_t i = 0; i < out_len; i++) new_stmts->v.arr.items[i] = out_items[i];
-  body->fields = block_fields_with_stmts(p, body->fields, new_stmts, json_obj_get(body->fields, "params"));
+  body->fields = block_fields_with_stmts(p, body->fields, new_stmts, json_obj_get_sym(body->fields, JSON_KEY_PARAMS));
   if (!body->fields) {
     free(out_items);
     free(kept_items);
@@ -2586,9 +2649,9 @@ static bool lower_sem_defer_in_body_fn(SirProgram* p, NodeRec* fn, int64_t body_
 static bool lower_sem_defer_in_cfg_fn(SirProgram* p, NodeRec* fn, bool* out_did) {
   if (out_did) *out_did = false;
   if (!p || !fn || !fn->fields || fn->fields->type != JSON_OBJECT) return false;
-  if (!json_obj_get(fn->fields, "entry")) return true; // not cfg-form
+  if (!json_obj_get_sym(fn->fields, JSON_KEY_ENTRY)) return true; // not cfg-form
 
-  JsonValue* blocks = json_obj_get(fn->fields, "blocks");
+  JsonValue* blocks = json_obj_get_sym(fn->fields, JSON_KEY_BLOCKS);
   if (!blocks || blocks->type != JSON_ARRAY) return true;
 
   int64_t* defers = NULL;
@@ -2603,7 +2666,7 @@ static bool lower_sem_defer_in_cfg_fn(SirProgram* p, NodeRec* fn, bool* out_did)
     if (!parse_node_ref_id(p, blocks->v.arr.items[bi], &bid)) continue;
     NodeRec* blk = get_node(p, bid);
     if (!blk || !blk->fields || !blk->tag || strcmp(blk->tag, "block") != 0) continue;
-    JsonValue* stmts = json_obj_get(blk->fields, "stmts");
+    JsonValue* stmts = json_obj_get_sym(blk->fields, JSON_KEY_STMTS);
     if (!stmts || stmts->type != JSON_ARRAY) continue;
 
     JsonValue** kept = NULL;
@@ -2617,7 +2680,7 @@ static bool lower_sem_defer_in_cfg_fn(SirProgram* p, NodeRec* fn, bool* out_did)
       NodeRec* s = get_node(p, sid);
       if (s && s->tag && strcmp(s->tag, "sem.defer") == 0) {
         if (!s->fields || s->fields->type != JSON_OBJECT) return false;
-        JsonValue* args = json_obj_get(s->fields, "args");
+        JsonValue* args = json_obj_get_sym(s->fields, JSON_KEY_ARGS);
         if (!args || args->type != JSON_ARRAY || args->v.arr.len != 1) return false;
         BranchOperand br = {0};
         if (!parse_branch_operand(p, args->v.arr.items[0], &br)) return false;
@@ -2665,7 +2728,7 @@ static bool lower_sem_defer_in_cfg_fn(SirProgram* p, NodeRec* fn, bool* out_did)
         return false;
       }
       for (size_t i = 0; i < kept_len; i++) new_stmts->v.arr.items[i] = kept[i];
-      blk->fields = block_fields_with_stmts(p, blk->fields, new_stmts, json_obj_get(blk->fields, "params"));
+      blk->fields = block_fields_with_stmts(p, blk->fields, new_stmts, json_obj_get_sym(blk->fields, JSON_KEY_PARAMS));
       if (!blk->fields) {
         free(kept);
         free(defers);
@@ -2692,7 +2755,7 @@ static bool lower_sem_defer_in_cfg_fn(SirProgram* p, NodeRec* fn, bool* out_did)
     if (!parse_node_ref_id(p, blocks->v.arr.items[bi], &bid)) continue;
     NodeRec* blk = get_node(p, bid);
     if (!blk || !blk->fields || !blk->tag || strcmp(blk->tag, "block") != 0) continue;
-    JsonValue* stmts = json_obj_get(blk->fields, "stmts");
+    JsonValue* stmts = json_obj_get_sym(blk->fields, JSON_KEY_STMTS);
     if (!stmts || stmts->type != JSON_ARRAY || stmts->v.arr.len == 0) continue;
 
     // Only need to inject if the last stmt is a return terminator.
@@ -2774,7 +2837,7 @@ static bool lower_sem_defer_in_cfg_fn(SirProgram* p, NodeRec* fn, bool* out_did)
       return false;
     }
     for (size_t i = 0; i < out_len; i++) new_stmts->v.arr.items[i] = out_items[i];
-    blk->fields = block_fields_with_stmts(p, blk->fields, new_stmts, json_obj_get(blk->fields, "params"));
+    blk->fields = block_fields_with_stmts(p, blk->fields, new_stmts, json_obj_get_sym(blk->fields, JSON_KEY_PARAMS));
     free(out_items);
     if (!blk->fields) {
       free(defers);
@@ -2792,7 +2855,7 @@ static bool sem_scope_collect_defers(SirProgram* p, NodeRec* scope, int64_t void
   if (out_defers) *out_defers = NULL;
   if (out_len) *out_len = 0;
   if (!p || !scope || !scope->fields || scope->fields->type != JSON_OBJECT) return false;
-  JsonValue* defers = json_obj_get(scope->fields, "defers");
+  JsonValue* defers = json_obj_get_sym(scope->fields, JSON_KEY_DEFERS);
   if (!defers || defers->type != JSON_ARRAY) return false;
   int64_t* ids = NULL;
   size_t len = 0;
@@ -2806,13 +2869,13 @@ static bool sem_scope_collect_defers(SirProgram* p, NodeRec* scope, int64_t void
       free(ids);
       return false;
     }
-    const char* k = json_get_string(json_obj_get(d, "kind"));
+    const char* k = json_get_string(json_obj_get_sym(d, JSON_KEY_KIND));
     if (!k || strcmp(k, "thunk") != 0) {
       free(ids);
       return false;
     }
     int64_t fid = 0;
-    if (!parse_node_ref_id(p, json_obj_get(d, "f"), &fid)) {
+    if (!parse_node_ref_id(p, json_obj_get_sym(d, JSON_KEY_F), &fid)) {
       free(ids);
       return false;
     }
@@ -2849,7 +2912,7 @@ static bool lower_sem_scope_in_stmts(SirProgram* p, JsonValue* stmts, size_t sco
   if (!sem_scope_collect_defers(p, scope, void_ty, &defer_fns, &defer_len)) return false;
 
   int64_t body_id = 0;
-  if (!parse_node_ref_id(p, json_obj_get(scope->fields, "body"), &body_id)) {
+  if (!parse_node_ref_id(p, json_obj_get_sym(scope->fields, JSON_KEY_BODY), &body_id)) {
     free(defer_fns);
     return false;
   }
@@ -2858,7 +2921,7 @@ static bool lower_sem_scope_in_stmts(SirProgram* p, JsonValue* stmts, size_t sco
     free(defer_fns);
     return false;
   }
-  JsonValue* bstmts = json_obj_get(body->fields, "stmts");
+  JsonValue* bstmts = json_obj_get_sym(body->fields, JSON_KEY_STMTS);
   if (!bstmts || bstmts->type != JSON_ARRAY) {
     free(defer_fns);
     return false;
@@ -3018,7 +3081,7 @@ static bool lower_sem_while_in_body_fn(SirProgram* p, NodeRec* fn, int64_t body_
   if (!p || !fn || !fn->fields) return false;
   NodeRec* body = get_node(p, body_id);
   if (!body || !body->fields) return false;
-  JsonValue* stmts = json_obj_get(body->fields, "stmts");
+  JsonValue* stmts = json_obj_get_sym(body->fields, JSON_KEY_STMTS);
   if (!stmts || stmts->type != JSON_ARRAY) return false;
 
   NodeRec* wn = get_node(p, while_node_id);
@@ -3064,7 +3127,7 @@ static bool lower_sem_while_in_body_fn(SirProgram* p, NodeRec* fn, int64_t body_
   if (!entry_br_id) return false;
   JsonValue* entry_br_fields = jv_make_obj(&p->arena, 1);
   if (!entry_br_fields) return false;
-  entry_br_fields->v.obj.items[0].key = "to";
+  entry_br_fields->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   entry_br_fields->v.obj.items[0].value = jv_make_ref(&p->arena, header_bid);
   if (!entry_br_fields->v.obj.items[0].value) return false;
   make_node_stub(p, entry_br_id, "term.br", 0, entry_br_fields);
@@ -3074,7 +3137,7 @@ static bool lower_sem_while_in_body_fn(SirProgram* p, NodeRec* fn, int64_t body_
   for (size_t i = 0; i < prefix_n; i++) entry_stmts->v.arr.items[i] = stmts->v.arr.items[i];
   entry_stmts->v.arr.items[prefix_n] = jv_make_ref(&p->arena, entry_br_id);
   if (!entry_stmts->v.arr.items[prefix_n]) return false;
-  body->fields = block_fields_with_stmts(p, body->fields, entry_stmts, json_obj_get(body->fields, "params"));
+  body->fields = block_fields_with_stmts(p, body->fields, entry_stmts, json_obj_get_sym(body->fields, JSON_KEY_PARAMS));
   if (!body->fields) return false;
 
   int64_t cond_call_id = 0;
@@ -3084,18 +3147,18 @@ static bool lower_sem_while_in_body_fn(SirProgram* p, NodeRec* fn, int64_t body_
   JsonValue* h_then = jv_make_obj(&p->arena, 1);
   JsonValue* h_else = jv_make_obj(&p->arena, 1);
   if (!h_then || !h_else) return false;
-  h_then->v.obj.items[0].key = "to";
+  h_then->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   h_then->v.obj.items[0].value = jv_make_ref(&p->arena, loop_bid);
-  h_else->v.obj.items[0].key = "to";
+  h_else->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   h_else->v.obj.items[0].value = jv_make_ref(&p->arena, cont_bid);
   if (!h_then->v.obj.items[0].value || !h_else->v.obj.items[0].value) return false;
   JsonValue* header_cbr_fields = jv_make_obj(&p->arena, 3);
   if (!header_cbr_fields) return false;
-  header_cbr_fields->v.obj.items[0].key = "cond";
+  header_cbr_fields->v.obj.items[0].key = json_key_name(JSON_KEY_COND);
   header_cbr_fields->v.obj.items[0].value = jv_make_ref(&p->arena, cond_call_id);
-  header_cbr_fields->v.obj.items[1].key = "then";
+  header_cbr_fields->v.obj.items[1].key = json_key_name(JSON_KEY_THEN);
   header_cbr_fields->v.obj.items[1].value = h_then;
-  header_cbr_fields->v.obj.items[2].key = "else";
+  header_cbr_fields->v.obj.items[2].key = json_key_name(JSON_KEY_ELSE);
   header_cbr_fields->v.obj.items[2].value = h_else;
   if (!header_cbr_fields->v.obj.items[0].value) return false;
   make_node_stub(p, header_cbr_id, "term.cbr", 0, header_cbr_fields);
@@ -3122,7 +3185,7 @@ static bool lower_sem_while_in_body_fn(SirProgram* p, NodeRec* fn, int64_t body_
   if (!cmp_args->v.arr.items[0] || !cmp_args->v.arr.items[1]) return false;
   JsonValue* cmp_fields = jv_make_obj(&p->arena, 1);
   if (!cmp_fields) return false;
-  cmp_fields->v.obj.items[0].key = "args";
+  cmp_fields->v.obj.items[0].key = json_key_name(JSON_KEY_ARGS);
   cmp_fields->v.obj.items[0].value = cmp_args;
   make_node_stub(p, cmp_id, "i32.cmp.eq", cmp_bool_ty, cmp_fields);
 
@@ -3131,18 +3194,18 @@ static bool lower_sem_while_in_body_fn(SirProgram* p, NodeRec* fn, int64_t body_
   JsonValue* b_then = jv_make_obj(&p->arena, 1);
   JsonValue* b_else = jv_make_obj(&p->arena, 1);
   if (!b_then || !b_else) return false;
-  b_then->v.obj.items[0].key = "to";
+  b_then->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   b_then->v.obj.items[0].value = jv_make_ref(&p->arena, header_bid);
-  b_else->v.obj.items[0].key = "to";
+  b_else->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   b_else->v.obj.items[0].value = jv_make_ref(&p->arena, cont_bid);
   if (!b_then->v.obj.items[0].value || !b_else->v.obj.items[0].value) return false;
   JsonValue* body_cbr_fields = jv_make_obj(&p->arena, 3);
   if (!body_cbr_fields) return false;
-  body_cbr_fields->v.obj.items[0].key = "cond";
+  body_cbr_fields->v.obj.items[0].key = json_key_name(JSON_KEY_COND);
   body_cbr_fields->v.obj.items[0].value = jv_make_ref(&p->arena, cmp_id);
-  body_cbr_fields->v.obj.items[1].key = "then";
+  body_cbr_fields->v.obj.items[1].key = json_key_name(JSON_KEY_THEN);
   body_cbr_fields->v.obj.items[1].value = b_then;
-  body_cbr_fields->v.obj.items[2].key = "else";
+  body_cbr_fields->v.obj.items[2].key = json_key_name(JSON_KEY_ELSE);
   body_cbr_fields->v.obj.items[2].value = b_else;
   if (!body_cbr_fields->v.obj.items[0].value) return false;
   make_node_stub(p, body_cbr_id, "term.cbr", 0, body_cbr_fields);
@@ -3169,10 +3232,10 @@ static bool lower_sem_while_in_body_fn(SirProgram* p, NodeRec* fn, int64_t body_
 
 static bool lower_sem_while_in_cfg_fn(SirProgram* p, NodeRec* fn, int64_t block_id, size_t while_stmt_idx, int64_t while_node_id) {
   if (!p || !fn || !fn->fields) return false;
-  if (!json_obj_get(fn->fields, "entry")) return false;
+  if (!json_obj_get_sym(fn->fields, JSON_KEY_ENTRY)) return false;
   NodeRec* blk = get_node(p, block_id);
   if (!blk || !blk->fields) return false;
-  JsonValue* stmts = json_obj_get(blk->fields, "stmts");
+  JsonValue* stmts = json_obj_get_sym(blk->fields, JSON_KEY_STMTS);
   if (!stmts || stmts->type != JSON_ARRAY) return false;
 
   NodeRec* wn = get_node(p, while_node_id);
@@ -3214,7 +3277,7 @@ static bool lower_sem_while_in_cfg_fn(SirProgram* p, NodeRec* fn, int64_t block_
   if (!entry_br_id) return false;
   JsonValue* entry_br_fields = jv_make_obj(&p->arena, 1);
   if (!entry_br_fields) return false;
-  entry_br_fields->v.obj.items[0].key = "to";
+  entry_br_fields->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   entry_br_fields->v.obj.items[0].value = jv_make_ref(&p->arena, header_bid);
   if (!entry_br_fields->v.obj.items[0].value) return false;
   make_node_stub(p, entry_br_id, "term.br", 0, entry_br_fields);
@@ -3224,7 +3287,7 @@ static bool lower_sem_while_in_cfg_fn(SirProgram* p, NodeRec* fn, int64_t block_
   for (size_t i = 0; i < prefix_n; i++) entry_stmts->v.arr.items[i] = stmts->v.arr.items[i];
   entry_stmts->v.arr.items[prefix_n] = jv_make_ref(&p->arena, entry_br_id);
   if (!entry_stmts->v.arr.items[prefix_n]) return false;
-  blk->fields = block_fields_with_stmts(p, blk->fields, entry_stmts, json_obj_get(blk->fields, "params"));
+  blk->fields = block_fields_with_stmts(p, blk->fields, entry_stmts, json_obj_get_sym(blk->fields, JSON_KEY_PARAMS));
   if (!blk->fields) return false;
 
   int64_t cond_call_id = 0;
@@ -3234,18 +3297,18 @@ static bool lower_sem_while_in_cfg_fn(SirProgram* p, NodeRec* fn, int64_t block_
   JsonValue* h_then = jv_make_obj(&p->arena, 1);
   JsonValue* h_else = jv_make_obj(&p->arena, 1);
   if (!h_then || !h_else) return false;
-  h_then->v.obj.items[0].key = "to";
+  h_then->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   h_then->v.obj.items[0].value = jv_make_ref(&p->arena, loop_bid);
-  h_else->v.obj.items[0].key = "to";
+  h_else->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   h_else->v.obj.items[0].value = jv_make_ref(&p->arena, cont_bid);
   if (!h_then->v.obj.items[0].value || !h_else->v.obj.items[0].value) return false;
   JsonValue* header_cbr_fields = jv_make_obj(&p->arena, 3);
   if (!header_cbr_fields) return false;
-  header_cbr_fields->v.obj.items[0].key = "cond";
+  header_cbr_fields->v.obj.items[0].key = json_key_name(JSON_KEY_COND);
   header_cbr_fields->v.obj.items[0].value = jv_make_ref(&p->arena, cond_call_id);
-  header_cbr_fields->v.obj.items[1].key = "then";
+  header_cbr_fields->v.obj.items[1].key = json_key_name(JSON_KEY_THEN);
   header_cbr_fields->v.obj.items[1].value = h_then;
-  header_cbr_fields->v.obj.items[2].key = "else";
+  header_cbr_fields->v.obj.items[2].key = json_key_name(JSON_KEY_ELSE);
   header_cbr_fields->v.obj.items[2].value = h_else;
   if (!header_cbr_fields->v.obj.items[0].value) return false;
   make_node_stub(p, header_cbr_id, "term.cbr", 0, header_cbr_fields);
@@ -3272,7 +3335,7 @@ static bool lower_sem_while_in_cfg_fn(SirProgram* p, NodeRec* fn, int64_t block_
   if (!cmp_args->v.arr.items[0] || !cmp_args->v.arr.items[1]) return false;
   JsonValue* cmp_fields = jv_make_obj(&p->arena, 1);
   if (!cmp_fields) return false;
-  cmp_fields->v.obj.items[0].key = "args";
+  cmp_fields->v.obj.items[0].key = json_key_name(JSON_KEY_ARGS);
   cmp_fields->v.obj.items[0].value = cmp_args;
   make_node_stub(p, cmp_id, "i32.cmp.eq", cmp_bool_ty, cmp_fields);
 
@@ -3281,18 +3344,18 @@ static bool lower_sem_while_in_cfg_fn(SirProgram* p, NodeRec* fn, int64_t block_
   JsonValue* b_then = jv_make_obj(&p->arena, 1);
   JsonValue* b_else = jv_make_obj(&p->arena, 1);
   if (!b_then || !b_else) return false;
-  b_then->v.obj.items[0].key = "to";
+  b_then->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   b_then->v.obj.items[0].value = jv_make_ref(&p->arena, header_bid);
-  b_else->v.obj.items[0].key = "to";
+  b_else->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   b_else->v.obj.items[0].value = jv_make_ref(&p->arena, cont_bid);
   if (!b_then->v.obj.items[0].value || !b_else->v.obj.items[0].value) return false;
   JsonValue* body_cbr_fields = jv_make_obj(&p->arena, 3);
   if (!body_cbr_fields) return false;
-  body_cbr_fields->v.obj.items[0].key = "cond";
+  body_cbr_fields->v.obj.items[0].key = json_key_name(JSON_KEY_COND);
   body_cbr_fields->v.obj.items[0].value = jv_make_ref(&p->arena, cmp_id);
-  body_cbr_fields->v.obj.items[1].key = "then";
+  body_cbr_fields->v.obj.items[1].key = json_key_name(JSON_KEY_THEN);
   body_cbr_fields->v.obj.items[1].value = b_then;
-  body_cbr_fields->v.obj.items[2].key = "else";
+  body_cbr_fields->v.obj.items[2].key = json_key_name(JSON_KEY_ELSE);
   body_cbr_fields->v.obj.items[2].value = b_else;
   if (!body_cbr_fields->v.obj.items[0].value) return false;
   make_node_stub(p, body_cbr_id, "term.cbr", 0, body_cbr_fields);
@@ -3321,10 +3384,10 @@ static bool lower_sem_switch_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t swit
   if (!p || !fn || !fn->fields) return false;
 
   int64_t body_id = 0;
-  if (!parse_node_ref_id(p, json_obj_get(fn->fields, "body"), &body_id)) return false;
+  if (!parse_node_ref_id(p, json_obj_get_sym(fn->fields, JSON_KEY_BODY), &body_id)) return false;
   NodeRec* body = get_node(p, body_id);
   if (!body || !body->fields) return false;
-  JsonValue* stmts = json_obj_get(body->fields, "stmts");
+  JsonValue* stmts = json_obj_get_sym(body->fields, JSON_KEY_STMTS);
   if (!stmts || stmts->type != JSON_ARRAY || stmts->v.arr.len == 0) return false;
 
   // Require last stmt is term.ret/return and returns switch_node_id.
@@ -3334,7 +3397,7 @@ static bool lower_sem_switch_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t swit
   NodeRec* term = get_node(p, term_id);
   if (!term || !term->fields || !(strcmp(term->tag, "term.ret") == 0 || strcmp(term->tag, "return") == 0)) return false;
   int64_t got = 0;
-  if (!parse_node_ref_id(p, json_obj_get(term->fields, "value"), &got)) return false;
+  if (!parse_node_ref_id(p, json_obj_get_sym(term->fields, JSON_KEY_VALUE), &got)) return false;
   if (got != switch_node_id) return false;
 
   NodeRec* sn = get_node(p, switch_node_id);
@@ -3350,13 +3413,13 @@ static bool lower_sem_switch_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t swit
     return false;
   }
 
-  JsonValue* args = json_obj_get(sn->fields, "args");
+  JsonValue* args = json_obj_get_sym(sn->fields, JSON_KEY_ARGS);
   if (!args || args->type != JSON_ARRAY || args->v.arr.len != 1) return false;
   int64_t scrut_id = 0;
   if (!parse_node_ref_id(p, args->v.arr.items[0], &scrut_id)) return false;
 
-  JsonValue* cases = json_obj_get(sn->fields, "cases");
-  JsonValue* def = json_obj_get(sn->fields, "default");
+  JsonValue* cases = json_obj_get_sym(sn->fields, JSON_KEY_CASES);
+  JsonValue* def = json_obj_get_sym(sn->fields, JSON_KEY_DEFAULT);
   if (!cases || cases->type != JSON_ARRAY || !def || def->type != JSON_OBJECT) return false;
 
   // Reuse switch node id as join bparam.
@@ -3381,8 +3444,8 @@ static bool lower_sem_switch_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t swit
     JsonValue* co = cases->v.arr.items[i];
     if (!co || co->type != JSON_OBJECT) return false;
     int64_t lit_id = 0;
-    if (!parse_node_ref_id(p, json_obj_get(co, "lit"), &lit_id)) return false;
-    JsonValue* bodyb = json_obj_get(co, "body");
+    if (!parse_node_ref_id(p, json_obj_get_sym(co, JSON_KEY_LIT), &lit_id)) return false;
+    JsonValue* bodyb = json_obj_get_sym(co, JSON_KEY_BODY);
     if (!bodyb || bodyb->type != JSON_OBJECT) return false;
     BranchOperand br = {0};
     if (!parse_branch_operand(p, bodyb, &br)) return false;
@@ -3419,9 +3482,9 @@ static bool lower_sem_switch_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t swit
     if (!br_args->v.arr.items[0]) return false;
     JsonValue* br_fields = jv_make_obj(&p->arena, 2);
     if (!br_fields) return false;
-    br_fields->v.obj.items[0].key = "to";
+    br_fields->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
     br_fields->v.obj.items[0].value = jv_make_ref(&p->arena, join_bid);
-    br_fields->v.obj.items[1].key = "args";
+    br_fields->v.obj.items[1].key = json_key_name(JSON_KEY_ARGS);
     br_fields->v.obj.items[1].value = br_args;
     if (!br_fields->v.obj.items[0].value) return false;
     make_node_stub(p, br_id, "term.br", 0, br_fields);
@@ -3458,9 +3521,9 @@ static bool lower_sem_switch_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t swit
   if (!def_br_args->v.arr.items[0]) return false;
   JsonValue* def_br_fields = jv_make_obj(&p->arena, 2);
   if (!def_br_fields) return false;
-  def_br_fields->v.obj.items[0].key = "to";
+  def_br_fields->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   def_br_fields->v.obj.items[0].value = jv_make_ref(&p->arena, join_bid);
-  def_br_fields->v.obj.items[1].key = "args";
+  def_br_fields->v.obj.items[1].key = json_key_name(JSON_KEY_ARGS);
   def_br_fields->v.obj.items[1].value = def_br_args;
   if (!def_br_fields->v.obj.items[0].value) return false;
   make_node_stub(p, def_br_id, "term.br", 0, def_br_fields);
@@ -3479,7 +3542,7 @@ static bool lower_sem_switch_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t swit
   if (!ret_id) return false;
   JsonValue* r_fields = jv_make_obj(&p->arena, 1);
   if (!r_fields) return false;
-  r_fields->v.obj.items[0].key = "value";
+  r_fields->v.obj.items[0].key = json_key_name(JSON_KEY_VALUE);
   r_fields->v.obj.items[0].value = jv_make_ref(&p->arena, switch_node_id);
   if (!r_fields->v.obj.items[0].value) return false;
   make_node_stub(p, ret_id, "term.ret", 0, r_fields);
@@ -3497,7 +3560,7 @@ static bool lower_sem_switch_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t swit
 
   JsonValue* def_obj = jv_make_obj(&p->arena, 1);
   if (!def_obj) return false;
-  def_obj->v.obj.items[0].key = "to";
+  def_obj->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   def_obj->v.obj.items[0].value = jv_make_ref(&p->arena, def_bid);
   if (!def_obj->v.obj.items[0].value) return false;
 
@@ -3506,12 +3569,12 @@ static bool lower_sem_switch_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t swit
   for (size_t i = 0; i < case_n; i++) {
     JsonValue* co = cases->v.arr.items[i];
     int64_t lit_id = 0;
-    (void)parse_node_ref_id(p, json_obj_get(co, "lit"), &lit_id);
+    (void)parse_node_ref_id(p, json_obj_get_sym(co, JSON_KEY_LIT), &lit_id);
     JsonValue* cobj = jv_make_obj(&p->arena, 2);
     if (!cobj) return false;
-    cobj->v.obj.items[0].key = "lit";
+    cobj->v.obj.items[0].key = json_key_name(JSON_KEY_LIT);
     cobj->v.obj.items[0].value = jv_make_ref(&p->arena, lit_id);
-    cobj->v.obj.items[1].key = "to";
+    cobj->v.obj.items[1].key = json_key_name(JSON_KEY_TO);
     cobj->v.obj.items[1].value = jv_make_ref(&p->arena, case_bids ? case_bids[i] : 0);
     if (!cobj->v.obj.items[0].value || !cobj->v.obj.items[1].value) return false;
     sw_cases->v.arr.items[i] = cobj;
@@ -3519,11 +3582,11 @@ static bool lower_sem_switch_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t swit
 
   JsonValue* sw_fields = jv_make_obj(&p->arena, 3);
   if (!sw_fields) return false;
-  sw_fields->v.obj.items[0].key = "scrut";
+  sw_fields->v.obj.items[0].key = json_key_name(JSON_KEY_SCRUT);
   sw_fields->v.obj.items[0].value = jv_make_ref(&p->arena, scrut_id);
-  sw_fields->v.obj.items[1].key = "default";
+  sw_fields->v.obj.items[1].key = json_key_name(JSON_KEY_DEFAULT);
   sw_fields->v.obj.items[1].value = def_obj;
-  sw_fields->v.obj.items[2].key = "cases";
+  sw_fields->v.obj.items[2].key = json_key_name(JSON_KEY_CASES);
   sw_fields->v.obj.items[2].value = sw_cases;
   if (!sw_fields->v.obj.items[0].value) return false;
   make_node_stub(p, sw_id, "term.switch", 0, sw_fields);
@@ -3534,7 +3597,7 @@ static bool lower_sem_switch_to_cfg_ret(SirProgram* p, NodeRec* fn, int64_t swit
   for (size_t i = 0; i + 1 < stmts->v.arr.len; i++) new_stmts->v.arr.items[i] = stmts->v.arr.items[i];
   new_stmts->v.arr.items[stmts->v.arr.len - 1] = jv_make_ref(&p->arena, sw_id);
   if (!new_stmts->v.arr.items[stmts->v.arr.len - 1]) return false;
-  body->fields = block_fields_with_stmts(p, body->fields, new_stmts, json_obj_get(body->fields, "params"));
+  body->fields = block_fields_with_stmts(p, body->fields, new_stmts, json_obj_get_sym(body->fields, JSON_KEY_PARAMS));
   if (!body->fields) return false;
 
   // Convert function to CFG.
@@ -3555,11 +3618,11 @@ static bool lower_sem_switch_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t swit
   if (!p || !fn || !fn->fields) return false;
 
   int64_t body_id = 0;
-  if (!parse_node_ref_id(p, json_obj_get(fn->fields, "body"), &body_id)) return false;
+  if (!parse_node_ref_id(p, json_obj_get_sym(fn->fields, JSON_KEY_BODY), &body_id)) return false;
   NodeRec* body = get_node(p, body_id);
   if (!body || !body->fields) return false;
 
-  JsonValue* stmts = json_obj_get(body->fields, "stmts");
+  JsonValue* stmts = json_obj_get_sym(body->fields, JSON_KEY_STMTS);
   if (!stmts || stmts->type != JSON_ARRAY || stmts->v.arr.len == 0) return false;
 
   // Find the let stmt index.
@@ -3576,7 +3639,7 @@ static bool lower_sem_switch_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t swit
 
   NodeRec* letn = get_node(p, let_stmt_id);
   if (!letn || !letn->fields || !letn->tag || strcmp(letn->tag, "let") != 0) return false;
-  const char* let_name = json_get_string(json_obj_get(letn->fields, "name"));
+  const char* let_name = json_get_string(json_obj_get_sym(letn->fields, JSON_KEY_NAME));
   if (!let_name || !*let_name) return false;
 
   NodeRec* sw = get_node(p, switch_node_id);
@@ -3592,13 +3655,13 @@ static bool lower_sem_switch_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t swit
     return false;
   }
 
-  JsonValue* args = json_obj_get(sw->fields, "args");
+  JsonValue* args = json_obj_get_sym(sw->fields, JSON_KEY_ARGS);
   if (!args || args->type != JSON_ARRAY || args->v.arr.len != 1) return false;
   int64_t scrut_id = 0;
   if (!parse_node_ref_id(p, args->v.arr.items[0], &scrut_id)) return false;
 
-  JsonValue* cases = json_obj_get(sw->fields, "cases");
-  JsonValue* def = json_obj_get(sw->fields, "default");
+  JsonValue* cases = json_obj_get_sym(sw->fields, JSON_KEY_CASES);
+  JsonValue* def = json_obj_get_sym(sw->fields, JSON_KEY_DEFAULT);
   if (!cases || cases->type != JSON_ARRAY || !def || def->type != JSON_OBJECT) return false;
 
   // Reuse switch node id as the continuation bparam (strip sem.* from output).
@@ -3606,7 +3669,7 @@ static bool lower_sem_switch_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t swit
   sw->type_ref = result_ty;
   JsonValue* bpf = jv_make_obj(&p->arena, 1);
   if (!bpf) return false;
-  bpf->v.obj.items[0].key = "name";
+  bpf->v.obj.items[0].key = json_key_name(JSON_KEY_NAME);
   bpf->v.obj.items[0].value = jv_make(&p->arena, JSON_STRING);
   if (!bpf->v.obj.items[0].value) return false;
   bpf->v.obj.items[0].value->v.s = arena_strdup(&p->arena, let_name);
@@ -3650,7 +3713,7 @@ static bool lower_sem_switch_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t swit
   for (size_t i = 0; i < case_n; i++) {
     JsonValue* co = cases->v.arr.items[i];
     if (!co || co->type != JSON_OBJECT) return false;
-    JsonValue* body_br = json_obj_get(co, "body");
+    JsonValue* body_br = json_obj_get_sym(co, JSON_KEY_BODY);
     if (!body_br || body_br->type != JSON_OBJECT) return false;
     BranchOperand br = {0};
     if (!parse_branch_operand(p, body_br, &br)) return false;
@@ -3671,9 +3734,9 @@ static bool lower_sem_switch_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t swit
     if (!br_args->v.arr.items[0]) return false;
     JsonValue* br_fields = jv_make_obj(&p->arena, 2);
     if (!br_fields) return false;
-    br_fields->v.obj.items[0].key = "to";
+    br_fields->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
     br_fields->v.obj.items[0].value = jv_make_ref(&p->arena, cont_bid);
-    br_fields->v.obj.items[1].key = "args";
+    br_fields->v.obj.items[1].key = json_key_name(JSON_KEY_ARGS);
     br_fields->v.obj.items[1].value = br_args;
     if (!br_fields->v.obj.items[0].value) return false;
     make_node_stub(p, br_id, "term.br", 0, br_fields);
@@ -3703,9 +3766,9 @@ static bool lower_sem_switch_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t swit
   if (!def_args->v.arr.items[0]) return false;
   JsonValue* def_br_fields = jv_make_obj(&p->arena, 2);
   if (!def_br_fields) return false;
-  def_br_fields->v.obj.items[0].key = "to";
+  def_br_fields->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   def_br_fields->v.obj.items[0].value = jv_make_ref(&p->arena, cont_bid);
-  def_br_fields->v.obj.items[1].key = "args";
+  def_br_fields->v.obj.items[1].key = json_key_name(JSON_KEY_ARGS);
   def_br_fields->v.obj.items[1].value = def_args;
   if (!def_br_fields->v.obj.items[0].value) return false;
   make_node_stub(p, def_br_id, "term.br", 0, def_br_fields);
@@ -3726,29 +3789,29 @@ static bool lower_sem_switch_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t swit
   for (size_t i = 0; i < case_n; i++) {
     JsonValue* co = cases->v.arr.items[i];
     int64_t lit_id = 0;
-    (void)parse_node_ref_id(p, json_obj_get(co, "lit"), &lit_id);
+    (void)parse_node_ref_id(p, json_obj_get_sym(co, JSON_KEY_LIT), &lit_id);
     JsonValue* entry = jv_make_obj(&p->arena, 2);
     if (!entry) return false;
-    entry->v.obj.items[0].key = "lit";
+    entry->v.obj.items[0].key = json_key_name(JSON_KEY_LIT);
     entry->v.obj.items[0].value = jv_make_ref(&p->arena, lit_id);
-    entry->v.obj.items[1].key = "to";
+    entry->v.obj.items[1].key = json_key_name(JSON_KEY_TO);
     entry->v.obj.items[1].value = jv_make_ref(&p->arena, case_bids[i]);
     if (!entry->v.obj.items[0].value || !entry->v.obj.items[1].value) return false;
     sw_cases->v.arr.items[i] = entry;
   }
   JsonValue* sw_def = jv_make_obj(&p->arena, 1);
   if (!sw_def) return false;
-  sw_def->v.obj.items[0].key = "to";
+  sw_def->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   sw_def->v.obj.items[0].value = jv_make_ref(&p->arena, def_bid);
   if (!sw_def->v.obj.items[0].value) return false;
 
   JsonValue* sw_fields = jv_make_obj(&p->arena, 3);
   if (!sw_fields) return false;
-  sw_fields->v.obj.items[0].key = "scrut";
+  sw_fields->v.obj.items[0].key = json_key_name(JSON_KEY_SCRUT);
   sw_fields->v.obj.items[0].value = jv_make_ref(&p->arena, scrut_id);
-  sw_fields->v.obj.items[1].key = "cases";
+  sw_fields->v.obj.items[1].key = json_key_name(JSON_KEY_CASES);
   sw_fields->v.obj.items[1].value = sw_cases;
-  sw_fields->v.obj.items[2].key = "default";
+  sw_fields->v.obj.items[2].key = json_key_name(JSON_KEY_DEFAULT);
   sw_fields->v.obj.items[2].value = sw_def;
   if (!sw_fields->v.obj.items[0].value) return false;
   make_node_stub(p, sw_term_id, "term.switch", 0, sw_fields);
@@ -3758,7 +3821,7 @@ static bool lower_sem_switch_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t swit
   for (size_t i = 0; i < let_idx; i++) new_entry_stmts->v.arr.items[i] = stmts->v.arr.items[i];
   new_entry_stmts->v.arr.items[let_idx] = jv_make_ref(&p->arena, sw_term_id);
   if (!new_entry_stmts->v.arr.items[let_idx]) return false;
-  body->fields = block_fields_with_stmts(p, body->fields, new_entry_stmts, json_obj_get(body->fields, "params"));
+  body->fields = block_fields_with_stmts(p, body->fields, new_entry_stmts, json_obj_get_sym(body->fields, JSON_KEY_PARAMS));
   if (!body->fields) return false;
 
   const size_t blk_n = 1 + case_n + 2; // entry + cases + default + cont
@@ -3776,11 +3839,11 @@ static bool lower_sem_switch_to_cfg_let(SirProgram* p, NodeRec* fn, int64_t swit
 
 static bool lower_sem_switch_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64_t block_id, int64_t switch_node_id, int64_t let_stmt_id) {
   if (!p || !fn || !fn->fields) return false;
-  if (!json_obj_get(fn->fields, "entry")) return false;
+  if (!json_obj_get_sym(fn->fields, JSON_KEY_ENTRY)) return false;
 
   NodeRec* blk = get_node(p, block_id);
   if (!blk || !blk->fields || !blk->tag || strcmp(blk->tag, "block") != 0) return false;
-  JsonValue* stmts = json_obj_get(blk->fields, "stmts");
+  JsonValue* stmts = json_obj_get_sym(blk->fields, JSON_KEY_STMTS);
   if (!stmts || stmts->type != JSON_ARRAY || stmts->v.arr.len == 0) return false;
 
   // Find the let stmt index.
@@ -3797,7 +3860,7 @@ static bool lower_sem_switch_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64_t
 
   NodeRec* letn = get_node(p, let_stmt_id);
   if (!letn || !letn->fields || !letn->tag || strcmp(letn->tag, "let") != 0) return false;
-  const char* let_name = json_get_string(json_obj_get(letn->fields, "name"));
+  const char* let_name = json_get_string(json_obj_get_sym(letn->fields, JSON_KEY_NAME));
   if (!let_name || !*let_name) return false;
 
   NodeRec* sw = get_node(p, switch_node_id);
@@ -3805,13 +3868,13 @@ static bool lower_sem_switch_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64_t
   const int64_t result_ty = sw->type_ref;
   if (result_ty == 0) return false;
 
-  JsonValue* args = json_obj_get(sw->fields, "args");
+  JsonValue* args = json_obj_get_sym(sw->fields, JSON_KEY_ARGS);
   if (!args || args->type != JSON_ARRAY || args->v.arr.len != 1) return false;
   int64_t scrut_id = 0;
   if (!parse_node_ref_id(p, args->v.arr.items[0], &scrut_id)) return false;
 
-  JsonValue* cases = json_obj_get(sw->fields, "cases");
-  JsonValue* def = json_obj_get(sw->fields, "default");
+  JsonValue* cases = json_obj_get_sym(sw->fields, JSON_KEY_CASES);
+  JsonValue* def = json_obj_get_sym(sw->fields, JSON_KEY_DEFAULT);
   if (!cases || cases->type != JSON_ARRAY || !def || def->type != JSON_OBJECT) return false;
 
   // Reuse switch node id as the continuation bparam.
@@ -3819,7 +3882,7 @@ static bool lower_sem_switch_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64_t
   sw->type_ref = result_ty;
   JsonValue* bpf = jv_make_obj(&p->arena, 1);
   if (!bpf) return false;
-  bpf->v.obj.items[0].key = "name";
+  bpf->v.obj.items[0].key = json_key_name(JSON_KEY_NAME);
   bpf->v.obj.items[0].value = jv_make(&p->arena, JSON_STRING);
   if (!bpf->v.obj.items[0].value) return false;
   bpf->v.obj.items[0].value->v.s = arena_strdup(&p->arena, let_name);
@@ -3860,7 +3923,7 @@ static bool lower_sem_switch_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64_t
   for (size_t i = 0; i < case_n; i++) {
     JsonValue* co = cases->v.arr.items[i];
     if (!co || co->type != JSON_OBJECT) return false;
-    JsonValue* body_br = json_obj_get(co, "body");
+    JsonValue* body_br = json_obj_get_sym(co, JSON_KEY_BODY);
     if (!body_br || body_br->type != JSON_OBJECT) return false;
     BranchOperand br = {0};
     if (!parse_branch_operand(p, body_br, &br)) return false;
@@ -3881,9 +3944,9 @@ static bool lower_sem_switch_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64_t
     if (!br_args->v.arr.items[0]) return false;
     JsonValue* br_fields = jv_make_obj(&p->arena, 2);
     if (!br_fields) return false;
-    br_fields->v.obj.items[0].key = "to";
+    br_fields->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
     br_fields->v.obj.items[0].value = jv_make_ref(&p->arena, cont_bid);
-    br_fields->v.obj.items[1].key = "args";
+    br_fields->v.obj.items[1].key = json_key_name(JSON_KEY_ARGS);
     br_fields->v.obj.items[1].value = br_args;
     if (!br_fields->v.obj.items[0].value) return false;
     make_node_stub(p, br_id, "term.br", 0, br_fields);
@@ -3912,9 +3975,9 @@ static bool lower_sem_switch_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64_t
   if (!def_args->v.arr.items[0]) return false;
   JsonValue* def_br_fields = jv_make_obj(&p->arena, 2);
   if (!def_br_fields) return false;
-  def_br_fields->v.obj.items[0].key = "to";
+  def_br_fields->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   def_br_fields->v.obj.items[0].value = jv_make_ref(&p->arena, cont_bid);
-  def_br_fields->v.obj.items[1].key = "args";
+  def_br_fields->v.obj.items[1].key = json_key_name(JSON_KEY_ARGS);
   def_br_fields->v.obj.items[1].value = def_args;
   if (!def_br_fields->v.obj.items[0].value) return false;
   make_node_stub(p, def_br_id, "term.br", 0, def_br_fields);
@@ -3933,28 +3996,28 @@ static bool lower_sem_switch_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64_t
   for (size_t i = 0; i < case_n; i++) {
     JsonValue* co = cases->v.arr.items[i];
     int64_t lit_id = 0;
-    (void)parse_node_ref_id(p, json_obj_get(co, "lit"), &lit_id);
+    (void)parse_node_ref_id(p, json_obj_get_sym(co, JSON_KEY_LIT), &lit_id);
     JsonValue* entry = jv_make_obj(&p->arena, 2);
     if (!entry) return false;
-    entry->v.obj.items[0].key = "lit";
+    entry->v.obj.items[0].key = json_key_name(JSON_KEY_LIT);
     entry->v.obj.items[0].value = jv_make_ref(&p->arena, lit_id);
-    entry->v.obj.items[1].key = "to";
+    entry->v.obj.items[1].key = json_key_name(JSON_KEY_TO);
     entry->v.obj.items[1].value = jv_make_ref(&p->arena, case_bids[i]);
     if (!entry->v.obj.items[0].value || !entry->v.obj.items[1].value) return false;
     sw_cases->v.arr.items[i] = entry;
   }
   JsonValue* sw_def = jv_make_obj(&p->arena, 1);
   if (!sw_def) return false;
-  sw_def->v.obj.items[0].key = "to";
+  sw_def->v.obj.items[0].key = json_key_name(JSON_KEY_TO);
   sw_def->v.obj.items[0].value = jv_make_ref(&p->arena, def_bid);
   if (!sw_def->v.obj.items[0].value) return false;
   JsonValue* sw_fields = jv_make_obj(&p->arena, 3);
   if (!sw_fields) return false;
-  sw_fields->v.obj.items[0].key = "scrut";
+  sw_fields->v.obj.items[0].key = json_key_name(JSON_KEY_SCRUT);
   sw_fields->v.obj.items[0].value = jv_make_ref(&p->arena, scrut_id);
-  sw_fields->v.obj.items[1].key = "cases";
+  sw_fields->v.obj.items[1].key = json_key_name(JSON_KEY_CASES);
   sw_fields->v.obj.items[1].value = sw_cases;
-  sw_fields->v.obj.items[2].key = "default";
+  sw_fields->v.obj.items[2].key = json_key_name(JSON_KEY_DEFAULT);
   sw_fields->v.obj.items[2].value = sw_def;
   if (!sw_fields->v.obj.items[0].value) return false;
   make_node_stub(p, sw_term_id, "term.switch", 0, sw_fields);
@@ -3964,7 +4027,7 @@ static bool lower_sem_switch_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64_t
   for (size_t i = 0; i < let_idx; i++) new_stmts->v.arr.items[i] = stmts->v.arr.items[i];
   new_stmts->v.arr.items[let_idx] = jv_make_ref(&p->arena, sw_term_id);
   if (!new_stmts->v.arr.items[let_idx]) return false;
-  blk->fields = block_fields_with_stmts(p, blk->fields, new_stmts, json_obj_get(blk->fields, "params"));
+  blk->fields = block_fields_with_stmts(p, blk->fields, new_stmts, json_obj_get_sym(blk->fields, JSON_KEY_PARAMS));
   if (!blk->fields) return false;
 
   int64_t add[128];
@@ -3976,21 +4039,67 @@ static bool lower_sem_switch_to_cfg_let_cfg(SirProgram* p, NodeRec* fn, int64_t
   return true;
 }
 
-static bool hoist_sem_uses_in_body_fn(SirProgram* p, NodeRec* fn, bool* out_did) {
+// Per-function CFG worklist for lower_sem_nodes, indexed by block node id. A block becomes
+// hoist-clean once a hoisting scan found nothing in it, stmt-clean once the statement-position
+// lowering pass did, and lower-clean once the whole lowering scan did; blocks before `from` are
+// lower-clean. Lowerings rewrite only the block they split and the blocks they append (sem.defer
+// rewrites the whole fn), so only those are requeued. An appended block cut out of the split
+// block's statements keeps what was already known about them.
+enum {
+  SEM_BLK_HOIST_CLEAN = 1,
+  SEM_BLK_STMT_CLEAN = 2,
+  SEM_BLK_LOWER_CLEAN = 4,
+};
+
+typedef struct SemCfgWork {
+  uint8_t* state;
+  size_t cap;
+  size_t from;
+} SemCfgWork;
+
+static uint8_t sem_work_state(const SemCfgWork* w, int64_t bid) {
+  return (bid > 0 && (size_t)bid < w->cap) ? w->state[bid] : 0;
+}
+
+static bool sem_work_set(SemCfgWork* w, int64_t bid, uint8_t st) {
+  if (bid <= 0) return true;
+  if ((size_t)bid >= w->cap) {
+    if (!st) return true;
+    size_t ncap = w->cap ? w->cap : 256;
+    while (ncap <= (size_t)bid) ncap *= 2;
+    uint8_t* ns = (uint8_t*)realloc(w->state, ncap);
+    if (!ns) return false;
+    memset(ns + w->cap, 0, ncap - w->cap);
+    w->state = ns;
+    w->cap = ncap;
+  }
+  w->state[bid] = st;
+  return true;
+}
+
+static void sem_work_reset(SemCfgWork* w) {
+  if (w->state) memset(w->state, 0, w->cap);
+  w->from = 0;
+}
+
+static void sem_work_free(SemCfgWork* w) {
+  free(w->state);
+  memset(w, 0, sizeof(*w));
+}
+
+static bool hoist_sem_uses_in_body_fn(SirProgram* p, NodeRec* fn, SemVisitSet* visit, bool* out_did) {
   if (out_did) *out_did = false;
   if (!p || !fn || !fn->fields || fn->fields->type != JSON_OBJECT) return false;
-  if (json_obj_get(fn->fields, "entry")) return true; // not body-form
+  if (json_obj_get_sym(fn->fields, JSON_KEY_ENTRY)) return true; // not body-form
 
   int64_t body_id = 0;
-  if (!parse_node_ref_id(p, json_obj_get(fn->fields, "body"), &body_id)) return true;
+  if (!parse_node_ref_id(p, json_obj_get_sym(fn->fields, JSON_KEY_BODY), &body_id)) return true;
   NodeRec* body = get_node(p, body_id);
   if (!body || !body->fields) return true;
-  JsonValue* stmts = json_obj_get(body->fields, "stmts");
+  JsonValue* stmts = json_obj_get_sym(body->fields, JSON_KEY_STMTS);
   if (!stmts || stmts->type != JSON_ARRAY || stmts->v.arr.len == 0) return true;
 
-  uint8_t* visiting = (uint8_t*)arena_alloc(&p->arena, p->nodes_cap ? p->nodes_cap : 1);
-  if (!visiting) return false;
-  memset(visiting, 0, p->nodes_cap ? p->nodes_cap : 1);
+  sem_visit_begin(visit);
 
   HoistLetList lets = {0};
   SemHoistMap hoisted = {0};
@@ -4008,15 +4117,15 @@ static bool hoist_sem_uses_in_body_fn(SirProgram* p, NodeRec* fn, bool* out_did)
     if (strcmp(s->tag, "let") == 0) {
       // Recurse into the RHS node (and its children) without rewriting the let.value ref itself.
       int64_t vid = 0;
-      if (parse_node_ref_id(p, json_obj_get(s->fields, "value"), &vid)) {
+      if (parse_node_ref_id(p, json_obj_get_sym(s->fields, JSON_KEY_VALUE), &vid)) {
         NodeRec* v = get_node(p, vid);
         if (v && v->fields) {
-          if (!hoist_sem_in_slot(p, &v->fields, &hoisted, &lets, visiting, p->nodes_cap)) return false;
+          if (!hoist_sem_in_slot(p, &v->fields, &hoisted, &lets, visit)) return false;
         }
       }
     } else if (s->fields->type == JSON_OBJECT) {
       for (size_t i = 0; i < s->fields->v.obj.len; i++) {
-        if (!hoist_sem_in_slot(p, &s->fields->v.obj.items[i].value, &hoisted, &lets, visiting, p->nodes_cap)) return false;
+        if (!hoist_sem_in_slot(p, &s->fields->v.obj.items[i].value, &hoisted, &lets, visit)) return false;
       }
     }
 
@@ -4036,7 +4145,7 @@ static bool hoist_sem_uses_in_body_fn(SirProgram* p, NodeRec* fn, bool* out_did)
     JsonValue* new_stmts = jv_make_arr(&p->arena, vec.len);
     if (!new_stmts) return false;
     for (size_t i = 0; i < vec.len; i++) new_stmts->v.arr.items[i] = vec.items[i];
-    body->fields = block_fields_with_stmts(p, body->fields, new_stmts, json_obj_get(body->fields, "params"));
+    body->fields = block_fields_with_stmts(p, body->fields, new_stmts, json_obj_get_sym(body->fields, JSON_KEY_PARAMS));
     if (!body->fields) return false;
     if (out_did) *out_did = true;
   }
@@ -4047,27 +4156,27 @@ static bool hoist_sem_uses_in_body_fn(SirProgram* p, NodeRec* fn, bool* out_did)
   return true;
 }
 
-static bool hoist_sem_uses_in_cfg_fn(SirProgram* p, NodeRec* fn, bool* out_did) {
+// With a worklist, only blocks not yet hoist-clean are scanned; `w == NULL` scans every block.
+static bool hoist_sem_uses_in_cfg_fn(SirProgram* p, NodeRec* fn, SemCfgWork* w, SemVisitSet* visit, bool* out_did) {
   if (out_did) *out_did = false;
   if (!p || !fn || !fn->fields || fn->fields->type != JSON_OBJECT) return false;
-  if (!json_obj_get(fn->fields, "entry")) return true;
+  if (!json_obj_get_sym(fn->fields, JSON_KEY_ENTRY)) return true;
 
-  JsonValue* blocks = json_obj_get(fn->fields, "blocks");
+  JsonValue* blocks = json_obj_get_sym(fn->fields, JSON_KEY_BLOCKS);
   if (!blocks || blocks->type != JSON_ARRAY) return true;
 
-  for (size_t bi = 0; bi < blocks->v.arr.len; bi++) {
+  for (size_t bi = w ? w->from : 0; bi < blocks->v.arr.len; bi++) {
     bool blk_did = false;
     int64_t bid = 0;
     if (!parse_node_ref_id(p, blocks->v.arr.items[bi], &bid)) continue;
+    if (w && (sem_work_state(w, bid) & SEM_BLK_HOIST_CLEAN)) continue;
     NodeRec* blk = get_node(p, bid);
     if (!blk || !blk->fields || !blk->tag || strcmp(blk->tag, "block") != 0) continue;
 
-    JsonValue* stmts = json_obj_get(blk->fields, "stmts");
+    JsonValue* stmts = json_obj_get_sym(blk->fields, JSON_KEY_STMTS);
     if (!stmts || stmts->type != JSON_ARRAY) continue;
 
-    uint8_t* visiting = (uint8_t*)arena_alloc(&p->arena, p->nodes_cap ? p->nodes_cap : 1);
-    if (!visiting) return false;
-    memset(visiting, 0, p->nodes_cap ? p->nodes_cap : 1);
+    sem_visit_begin(visit);
 
     HoistLetList lets = {0};
     SemHoistMap hoisted = {0};
@@ -4081,15 +4190,15 @@ static bool hoist_sem_uses_in_cfg_fn(SirProgram* p, NodeRec* fn, bool* out_did)
 
       if (strcmp(s->tag, "let") == 0) {
         int64_t vid = 0;
-        if (parse_node_ref_id(p, json_obj_get(s->fields, "value"), &vid)) {
+        if (parse_node_ref_id(p, json_obj_get_sym(s->fields, JSON_KEY_VALUE), &vid)) {
           NodeRec* v = get_node(p, vid);
           if (v && v->fields) {
-            if (!hoist_sem_in_slot(p, &v->fields, &hoisted, &lets, visiting, p->nodes_cap)) return false;
+            if (!hoist_sem_in_slot(p, &v->fields, &hoisted, &lets, visit)) return false;
           }
         }
       } else if (s->fields->type == JSON_OBJECT) {
         for (size_t i = 0; i < s->fields->v.obj.len; i++) {
-          if (!hoist_sem_in_slot(p, &s->fields->v.obj.items[i].value, &hoisted, &lets, visiting, p->nodes_cap)) return false;
+          if (!hoist_sem_in_slot(p, &s->fields->v.obj.items[i].value, &hoisted, &lets, visit)) return false;
         }
       }
 
@@ -4105,13 +4214,13 @@ static bool hoist_sem_uses_in_cfg_fn(SirProgram* p, NodeRec* fn, bool* out_did)
     }
 
     // Hoist sem uses inside the terminator (append lets to stmts tail).
-    JsonValue* term_ref = json_obj_get(blk->fields, "term");
+    JsonValue* term_ref = json_obj_get_sym(blk->fields, JSON_KEY_TERM);
     if (term_ref) {
       int64_t tid = 0;
       if (parse_node_ref_id(p, term_ref, &tid)) {
         NodeRec* t = get_node(p, tid);
         if (t && t->fields) {
-          if (!hoist_sem_in_slot(p, &t->fields, &hoisted, &lets, visiting, p->nodes_cap)) return false;
+          if (!hoist_sem_in_slot(p, &t->fields, &hoisted, &lets, visit)) return false;
         }
       }
     }
@@ -4127,9 +4236,11 @@ static bool hoist_sem_uses_in_cfg_fn(SirProgram* p, NodeRec* fn, bool* out_did)
       JsonValue* new_stmts = jv_make_arr(&p->arena, vec.len);
       if (!new_stmts) return false;
       for (size_t i = 0; i < vec.len; i++) new_stmts->v.arr.items[i] = vec.items[i];
-      blk->fields = block_fields_with_stmts(p, blk->fields, new_stmts, json_obj_get(blk->fields, "params"));
+      blk->fields = block_fields_with_stmts(p, blk->fields, new_stmts, json_obj_get_sym(blk->fields, JSON_KEY_PARAMS));
       if (!blk->fields) return false;
       if (out_did) *out_did = true;
+    } else if (w && !sem_work_set(w, bid, SEM_BLK_HOIST_CLEAN)) {
+      return false;
     }
 
     free(vec.items);
@@ -4143,13 +4254,13 @@ static bool hoist_sem_uses_in_cfg_fn(SirProgram* p, NodeRec* fn, bool* out_did)
 static bool lower_one_sem_in_body_fn(SirProgram* p, NodeRec* fn, bool* out_did) {
   if (out_did) *out_did = false;
   if (!p || !fn || !fn->fields || fn->fields->type != JSON_OBJECT) return false;
-  if (json_obj_get(fn->fields, "entry")) return true; // not body-form
+  if (json_obj_get_sym(fn->fields, JSON_KEY_ENTRY)) return true; // not body-form
 
   int64_t body_id = 0;
-  if (!parse_node_ref_id(p, json_obj_get(fn->fields, "body"), &body_id)) return true;
+  if (!parse_node_ref_id(p, json_obj_get_sym(fn->fields, JSON_KEY_BODY), &body_id)) return true;
   NodeRec* body = get_node(p, body_id);
   if (!body || !body->fields) return true;
-  JsonValue* stmts = json_obj_get(body->fields, "stmts");
+  JsonValue* stmts = json_obj_get_sym(body->fields, JSON_KEY_STMTS);
   if (!stmts || stmts->type != JSON_ARRAY || stmts->v.arr.len == 0) return true;
 
   // Statement-position lowering: sem.while / sem.break / sem.continue.
@@ -4197,13 +4308,13 @@ static bool lower_one_sem_in_body_fn(SirProgram* p, NodeRec* fn, bool* out_did)
     if (!s || !s->tag || strcmp(s->tag, "let") != 0) continue;
     if (!s->fields || s->fields->type != JSON_OBJECT) continue;
     int64_t vid = 0;
-    if (!parse_node_ref_id(p, json_obj_get(s->fields, "value"), &vid)) continue;
+    if (!parse_node_ref_id(p, json_obj_get_sym(s->fields, JSON_KEY_VALUE), &vid)) continue;
     NodeRec* v = get_node(p, vid);
     if (!v || !v->tag) continue;
     if (strncmp(v->tag, "sem.", 4) != 0) continue;
 
     if (strcmp(v->tag, "sem.if") == 0) {
-      JsonValue* args = json_obj_get(v->fields, "args");
+      JsonValue* args = json_obj_get_sym(v->fields, JSON_KEY_ARGS);
       if (!args || args->type != JSON_ARRAY || args->v.arr.len != 3) continue;
       int64_t cond_id = 0;
       if (!parse_node_ref_id(p, args->v.arr.items[0], &cond_id)) continue;
@@ -4227,7 +4338,7 @@ static bool lower_one_sem_in_body_fn(SirProgram* p, NodeRec* fn, bool* out_did)
     }
 
     if (strcmp(v->tag, "sem.and_sc") == 0 || strcmp(v->tag, "sem.or_sc") == 0) {
-      JsonValue* args = json_obj_get(v->fields, "args");
+      JsonValue* args = json_obj_get_sym(v->fields, JSON_KEY_ARGS);
       if (!args || args->type != JSON_ARRAY || args->v.arr.len != 2) continue;
       int64_t lhs_id = 0;
       if (!parse_node_ref_id(p, args->v.arr.items[0], &lhs_id)) continue;
@@ -4241,7 +4352,7 @@ static bool lower_one_sem_in_body_fn(SirProgram* p, NodeRec* fn, bool* out_did)
       if (!c_id) return false;
       JsonValue* c_fields = jv_make_obj(&p->arena, 1);
       if (!c_fields) return false;
-      c_fields->v.obj.items[0].key = "value";
+      c_fields->v.obj.items[0].key = json_key_name(JSON_KEY_VALUE);
       JsonValue* lit = jv_make(&p->arena, JSON_NUMBER);
       if (!lit) return false;
       const bool is_and = (strcmp(v->tag, "sem.and_sc") == 0);
@@ -4273,12 +4384,12 @@ static bool lower_one_sem_in_body_fn(SirProgram* p, NodeRec* fn, bool* out_did)
   if (!term || !term->fields) return true;
   if (!(strcmp(term->tag, "term.ret") == 0 || strcmp(term->tag, "return") == 0)) return true;
   int64_t rid = 0;
-  if (!parse_node_ref_id(p, json_obj_get(term->fields, "value"), &rid)) return true;
+  if (!parse_node_ref_id(p, json_obj_get_sym(term->fields, JSON_KEY_VALUE), &rid)) return true;
   NodeRec* rnode = get_node(p, rid);
   if (!rnode || !rnode->tag) return true;
 
   if (strcmp(rnode->tag, "sem.if") == 0) {
-    JsonValue* args = json_obj_get(rnode->fields, "args");
+    JsonValue* args = json_obj_get_sym(rnode->fields, JSON_KEY_ARGS);
     if (!args || args->type != JSON_ARRAY || args->v.arr.len != 3) return true;
     int64_t cond_id = 0;
     if (!parse_node_ref_id(p, args->v.arr.items[0], &cond_id)) return true;
@@ -4302,7 +4413,7 @@ static bool lower_one_sem_in_body_fn(SirProgram* p, NodeRec* fn, bool* out_did)
   }
 
   if (strcmp(rnode->tag, "sem.and_sc") == 0 || strcmp(rnode->tag, "sem.or_sc") == 0) {
-    JsonValue* args = json_obj_get(rnode->fields, "args");
+    JsonValue* args = json_obj_get_sym(rnode->fields, JSON_KEY_ARGS);
     if (!args || args->type != JSON_ARRAY || args->v.arr.len != 2) return true;
     int64_t lhs_id = 0;
     if (!parse_node_ref_id(p, args->v.arr.items[0], &lhs_id)) return true;
@@ -4316,7 +4427,7 @@ static bool lower_one_sem_in_body_fn(SirProgram* p, NodeRec* fn, bool* out_did)
     if (!c_id) return false;
     JsonValue* c_fields = jv_make_obj(&p->arena, 1);
     if (!c_fields) return false;
-    c_fields->v.obj.items[0].key = "value";
+    c_fields->v.obj.items[0].key = json_key_name(JSON_KEY_VALUE);
     JsonValue* lit = jv_make(&p->arena, JSON_NUMBER);
     if (!lit) return false;
     const bool is_and = (strcmp(rnode->tag, "sem.and_sc") == 0);
@@ -4342,134 +4453,204 @@ static bool lower_one_sem_in_body_fn(SirProgram* p, NodeRec* fn, bool* out_did)
   return true;
 }
 
-static bool lower_one_sem_in_cfg_fn(SirProgram* p, NodeRec* fn, bool* out_did) {
+// Lowers the first sem.* found in block `bid`. Lowerings only rewrite `bid` and append new
+// blocks, except sem.defer, which rewrites every block of the fn (*out_whole_fn). The
+// statement-position pass is skipped when `stmt_clean`; *out_stmt_clean reports that it found
+// nothing, i.e. any lowering done was let-position.
+static bool lower_one_sem_in_cfg_block(SirProgram* p, NodeRec* fn, int64_t bid, bool stmt_clean, bool* out_did, bool* out_whole_fn,
+                                       bool* out_stmt_clean) {
   if (out_did) *out_did = false;
-  if (!p || !fn || !fn->fields || fn->fields->type != JSON_OBJECT) return false;
-  if (!json_obj_get(fn->fields, "entry")) return true;
-
-  JsonValue* blocks = json_obj_get(fn->fields, "blocks");
-  if (!blocks || blocks->type != JSON_ARRAY) return true;
-
-  for (size_t bi = 0; bi < blocks->v.arr.len; bi++) {
-    int64_t bid = 0;
-    if (!parse_node_ref_id(p, blocks->v.arr.items[bi], &bid)) continue;
-    NodeRec* blk = get_node(p, bid);
-    if (!blk || !blk->fields || !blk->tag || strcmp(blk->tag, "block") != 0) continue;
-    JsonValue* stmts = json_obj_get(blk->fields, "stmts");
-    if (!stmts || stmts->type != JSON_ARRAY || stmts->v.arr.len == 0) continue;
+  if (out_whole_fn) *out_whole_fn = false;
+  if (out_stmt_clean) *out_stmt_clean = false;
+  NodeRec* blk = get_node(p, bid);
+  if (!blk || !blk->fields || !blk->tag || strcmp(blk->tag, "block") != 0) return true;
+  JsonValue* stmts = json_obj_get_sym(blk->fields, JSON_KEY_STMTS);
+  if (!stmts || stmts->type != JSON_ARRAY || stmts->v.arr.len == 0) return true;
 
-    // Statement-position lowering in CFG blocks.
-    for (size_t si = 0; si < stmts->v.arr.len; si++) {
-      int64_t sid = 0;
-      if (!parse_node_ref_id(p, stmts->v.arr.items[si], &sid)) continue;
-      NodeRec* s = get_node(p, sid);
-      if (!s || !s->tag) continue;
-      if (strcmp(s->tag, "sem.scope") == 0) {
-        bool did = false;
-        if (!lower_sem_scope_in_stmts(p, stmts, si, sid, &did)) return false;
-        if (did) {
-          if (out_did) *out_did = true;
-          return true;
-        }
-      }
-      if (strcmp(s->tag, "sem.defer") == 0) {
-        bool did = false;
-        if (!lower_sem_defer_in_cfg_fn(p, fn, &did)) return false;
-        if (did) {
-          if (out_did) *out_did = true;
-          return true;
-        }
-      }
-      if (strcmp(s->tag, "sem.while") == 0) {
-        if (!lower_sem_while_in_cfg_fn(p, fn, bid, si, sid)) return false;
+  // Statement-position lowering in CFG blocks.
+  for (size_t si = 0; !stmt_clean && si < stmts->v.arr.len; si++) {
+    int64_t sid = 0;
+    if (!parse_node_ref_id(p, stmts->v.arr.items[si], &sid)) continue;
+    NodeRec* s = get_node(p, sid);
+    if (!s || !s->tag) continue;
+    if (strcmp(s->tag, "sem.scope") == 0) {
+      bool did = false;
+      if (!lower_sem_scope_in_stmts(p, stmts, si, sid, &did)) return false;
+      if (did) {
         if (out_did) *out_did = true;
         return true;
       }
-      if (strcmp(s->tag, "sem.break") == 0 || strcmp(s->tag, "sem.continue") == 0) {
-        bool did = false;
-        if (!lower_sem_loop_ctl_in_stmts(p, stmts, si, sid, &did)) return false;
-        if (did) {
-          if (out_did) *out_did = true;
-          return true;
-        }
-      }
     }
-
-    for (size_t si = 0; si < stmts->v.arr.len; si++) {
-      int64_t sid = 0;
-      if (!parse_node_ref_id(p, stmts->v.arr.items[si], &sid)) continue;
-      NodeRec* s = get_node(p, sid);
-      if (!s || !s->tag || strcmp(s->tag, "let") != 0) continue;
-      if (!s->fields || s->fields->type != JSON_OBJECT) continue;
-      int64_t vid = 0;
-      if (!parse_node_ref_id(p, json_obj_get(s->fields, "value"), &vid)) continue;
-      NodeRec* v = get_node(p, vid);
-      if (!v || !v->tag) continue;
-      if (strncmp(v->tag, "sem.", 4) != 0) continue;
-
-      if (strcmp(v->tag, "sem.if") == 0) {
-        JsonValue* args = json_obj_get(v->fields, "args");
-        if (!args || args->type != JSON_ARRAY || args->v.arr.len != 3) continue;
-        int64_t cond_id = 0;
-        if (!parse_node_ref_id(p, args->v.arr.items[0], &cond_id)) continue;
-        BranchOperand bt = {0}, be = {0};
-        if (!parse_branch_operand(p, args->v.arr.items[1], &bt) || !parse_branch_operand(p, args->v.arr.items[2], &be)) continue;
-        if (!lower_sem_value_to_cfg_let_cfg(p, fn, bid, vid, "sem.if", cond_id, &bt, &be, sid)) return false;
+    if (strcmp(s->tag, "sem.defer") == 0) {
+      bool did = false;
+      if (!lower_sem_defer_in_cfg_fn(p, fn, &did)) return false;
+      if (did) {
         if (out_did) *out_did = true;
+        if (out_whole_fn) *out_whole_fn = true;
         return true;
       }
-
-      if (strcmp(v->tag, "sem.match_sum") == 0) {
-        if (!lower_sem_match_sum_to_cfg_let_cfg(p, fn, bid, vid, sid)) return false;
+    }
+    if (strcmp(s->tag, "sem.while") == 0) {
+      if (!lower_sem_while_in_cfg_fn(p, fn, bid, si, sid)) return false;
+      if (out_did) *out_did = true;
+      return true;
+    }
+    if (strcmp(s->tag, "sem.break") == 0 || strcmp(s->tag, "sem.continue") == 0) {
+      bool did = false;
+      if (!lower_sem_loop_ctl_in_stmts(p, stmts, si, sid, &did)) return false;
+      if (did) {
         if (out_did) *out_did = true;
         return true;
       }
+    }
+  }
+  if (out_stmt_clean) *out_stmt_clean = true;
 
-      if (strcmp(v->tag, "sem.switch") == 0) {
-        if (!lower_sem_switch_to_cfg_let_cfg(p, fn, bid, vid, sid)) return false;
-        if (out_did) *out_did = true;
-        return true;
+  for (size_t si = 0; si < stmts->v.arr.len; si++) {
+    int64_t sid = 0;
+    if (!parse_node_ref_id(p, stmts->v.arr.items[si], &sid)) continue;
+    NodeRec* s = get_node(p, sid);
+    if (!s || !s->tag || strcmp(s->tag, "let") != 0) continue;
+    if (!s->fields || s->fields->type != JSON_OBJECT) continue;
+    int64_t vid = 0;
+    if (!parse_node_ref_id(p, json_obj_get_sym(s->fields, JSON_KEY_VALUE), &vid)) continue;
+    NodeRec* v = get_node(p, vid);
+    if (!v || !v->tag) continue;
+    if (strncmp(v->tag, "sem.", 4) != 0) continue;
+
+    if (strcmp(v->tag, "sem.if") == 0) {
+      JsonValue* args = json_obj_get_sym(v->fields, JSON_KEY_ARGS);
+      if (!args || args->type != JSON_ARRAY || args->v.arr.len != 3) continue;
+      int64_t cond_id = 0;
+      if (!parse_node_ref_id(p, args->v.arr.items[0], &cond_id)) continue;
+      BranchOperand bt = {0}, be = {0};
+      if (!parse_branch_operand(p, args->v.arr.items[1], &bt) || !parse_branch_operand(p, args->v.arr.items[2], &be)) continue;
+      if (!lower_sem_value_to_cfg_let_cfg(p, fn, bid, vid, "sem.if", cond_id, &bt, &be, sid)) return false;
+      if (out_did) *out_did = true;
+      return true;
+    }
+
+    if (strcmp(v->tag, "sem.match_sum") == 0) {
+      if (!lower_sem_match_sum_to_cfg_let_cfg(p, fn, bid, vid, sid)) return false;
+      if (out_did) *out_did = true;
+      return true;
+    }
+
+    if (strcmp(v->tag, "sem.switch") == 0) {
+      if (!lower_sem_switch_to_cfg_let_cfg(p, fn, bid, vid, sid)) return false;
+      if (out_did) *out_did = true;
+      return true;
+    }
+
+    if (strcmp(v->tag, "sem.and_sc") == 0 || strcmp(v->tag, "sem.or_sc") == 0) {
+      JsonValue* args = json_obj_get_sym(v->fields, JSON_KEY_ARGS);
+      if (!args || args->type != JSON_ARRAY || args->v.arr.len != 2) continue;
+      int64_t lhs_id = 0;
+      if (!parse_node_ref_id(p, args->v.arr.items[0], &lhs_id)) continue;
+      BranchOperand rhs = {0};
+      if (!parse_branch_operand(p, args->v.arr.items[1], &rhs)) continue;
+
+      NodeRec* lhsn = get_node(p, lhs_id);
+      const int64_t bool_ty = lhsn ? lhsn->type_ref : 0;
+      if (!bool_ty) continue;
+      const int64_t c_id = alloc_node_id_from_str(p, derived_id(p, SIR_ID_NODE, vid, "sc.const"), "sc const id");
+      if (!c_id) return false;
+      JsonValue* c_fields = jv_make_obj(&p->arena, 1);
+      if (!c_fields) return false;
+      c_fields->v.obj.items[0].key = json_key_name(JSON_KEY_VALUE);
+      JsonValue* lit = jv_make(&p->arena, JSON_NUMBER);
+      if (!lit) return false;
+      const bool is_and = (strcmp(v->tag, "sem.and_sc") == 0);
+      lit->v.i = is_and ? 0 : 1;
+      c_fields->v.obj.items[0].value = lit;
+      make_node_stub(p, c_id, "const.bool", bool_ty, c_fields);
+
+      BranchOperand bt = {0}, be = {0};
+      if (is_and) {
+        bt = rhs;
+        be.kind = BRANCH_VAL;
+        be.node_id = c_id;
+      } else {
+        bt.kind = BRANCH_VAL;
+        bt.node_id = c_id;
+        be = rhs;
       }
+      if (!lower_sem_value_to_cfg_let_cfg(p, fn, bid, vid, v->tag, lhs_id, &bt, &be, sid)) return false;
+      if (out_did) *out_did = true;
+      return true;
+    }
+  }
+  return true;
+}
 
-      if (strcmp(v->tag, "sem.and_sc") == 0 || strcmp(v->tag, "sem.or_sc") == 0) {
-        JsonValue* args = json_obj_get(v->fields, "args");
-        if (!args || args->type != JSON_ARRAY || args->v.arr.len != 2) continue;
-        int64_t lhs_id = 0;
-        if (!parse_node_ref_id(p, args->v.arr.items[0], &lhs_id)) continue;
-        BranchOperand rhs = {0};
-        if (!parse_branch_operand(p, args->v.arr.items[1], &rhs)) continue;
-
-        NodeRec* lhsn = get_node(p, lhs_id);
-        const int64_t bool_ty = lhsn ? lhsn->type_ref : 0;
-        if (!bool_ty) continue;
-        const int64_t c_id = alloc_node_id_from_str(p, derived_id(p, SIR_ID_NODE, vid, "sc.const"), "sc const id");
-        if (!c_id) return false;
-        JsonValue* c_fields = jv_make_obj(&p->arena, 1);
-        if (!c_fields) return false;
-        c_fields->v.obj.items[0].key = "value";
-        JsonValue* lit = jv_make(&p->arena, JSON_NUMBER);
-        if (!lit) return false;
-        const bool is_and = (strcmp(v->tag, "sem.and_sc") == 0);
-        lit->v.i = is_and ? 0 : 1;
-        c_fields->v.obj.items[0].value = lit;
-        make_node_stub(p, c_id, "const.bool", bool_ty, c_fields);
-
-        BranchOperand bt = {0}, be = {0};
-        if (is_and) {
-          bt = rhs;
-          be.kind = BRANCH_VAL;
-          be.node_id = c_id;
-        } else {
-          bt.kind = BRANCH_VAL;
-          bt.node_id = c_id;
-          be = rhs;
-        }
-        if (!lower_sem_value_to_cfg_let_cfg(p, fn, bid, vid, v->tag, lhs_id, &bt, &be, sid)) return false;
-        if (out_did) *out_did = true;
-        return true;
+// True if block `bid` holds a contiguous run of `old_stmts` (and no terminator other than
+// `old_term`), i.e. it was cut out of the block being split rather than built from new nodes.
+static bool sem_block_cut_from(SirProgram* p, int64_t bid, const JsonValue* old_stmts, const JsonValue* old_term) {
+  NodeRec* blk = get_node(p, bid);
+  if (!blk || !blk->fields || !blk->tag || strcmp(blk->tag, "block") != 0) return false;
+  JsonValue* stmts = json_obj_get_sym(blk->fields, JSON_KEY_STMTS);
+  if (!stmts || stmts->type != JSON_ARRAY || !old_stmts || old_stmts->type != JSON_ARRAY) return false;
+  JsonValue* term = json_obj_get_sym(blk->fields, JSON_KEY_TERM);
+  if (term && term != old_term) return false;
+  const size_t n = stmts->v.arr.len;
+  if (n == 0) return true;
+  for (size_t off = 0; off + n <= old_stmts->v.arr.len; off++) {
+    if (old_stmts->v.arr.items[off] != stmts->v.arr.items[0]) continue;
+    return memcmp(&old_stmts->v.arr.items[off], stmts->v.arr.items, n * sizeof(*stmts->v.arr.items)) == 0;
+  }
+  return false;
+}
+
+// Lowers the first sem.* in block order. With a worklist, lower-clean blocks are skipped, blocks
+// found empty are marked lower-clean, and the rewritten/appended blocks are requeued; `w == NULL`
+// scans every block.
+static bool lower_one_sem_in_cfg_fn(SirProgram* p, NodeRec* fn, SemCfgWork* w, bool* out_did) {
+  if (out_did) *out_did = false;
+  if (!p || !fn || !fn->fields || fn->fields->type != JSON_OBJECT) return false;
+  if (!json_obj_get_sym(fn->fields, JSON_KEY_ENTRY)) return true;
+
+  JsonValue* blocks = json_obj_get_sym(fn->fields, JSON_KEY_BLOCKS);
+  if (!blocks || blocks->type != JSON_ARRAY) return true;
+
+  for (size_t bi = w ? w->from : 0; bi < blocks->v.arr.len; bi++) {
+    int64_t bid = 0;
+    if (!parse_node_ref_id(p, blocks->v.arr.items[bi], &bid)) continue;
+    const uint8_t st = w ? sem_work_state(w, bid) : 0;
+    if (st & SEM_BLK_LOWER_CLEAN) continue;
+
+    NodeRec* blk = get_node(p, bid);
+    JsonValue* old_stmts = (blk && blk->fields) ? json_obj_get_sym(blk->fields, JSON_KEY_STMTS) : NULL;
+    JsonValue* old_term = (blk && blk->fields) ? json_obj_get_sym(blk->fields, JSON_KEY_TERM) : NULL;
+    const size_t old_len = blocks->v.arr.len;
+    bool did = false;
+    bool whole_fn = false;
+    bool stmt_clean = false;
+    if (!lower_one_sem_in_cfg_block(p, fn, bid, (st & SEM_BLK_STMT_CLEAN) != 0, &did, &whole_fn, &stmt_clean)) return false;
+    if (!did) {
+      if (w && !sem_work_set(w, bid, st | SEM_BLK_LOWER_CLEAN)) return false;
+      continue;
+    }
+
+    if (w && whole_fn) {
+      sem_work_reset(w);
+    } else if (w) {
+      // Everything before `bi` was found lower-clean on the way here.
+      w->from = bi;
+      if (!sem_work_set(w, bid, 0)) return false;
+      const uint8_t cut_st = (uint8_t)((st & SEM_BLK_HOIST_CLEAN) | (stmt_clean ? SEM_BLK_STMT_CLEAN : 0));
+      JsonValue* nb = json_obj_get_sym(fn->fields, JSON_KEY_BLOCKS);
+      const size_t new_len = (nb && nb->type == JSON_ARRAY) ? nb->v.arr.len : old_len;
+      for (size_t i = old_len; i < new_len; i++) {
+        int64_t add_id = 0;
+        if (!parse_node_ref_id(p, nb->v.arr.items[i], &add_id)) continue;
+        const bool cut = cut_st && sem_block_cut_from(p, add_id, old_stmts, old_term);
+        if (!sem_work_set(w, add_id, cut ? cut_st : 0)) return false;
       }
     }
+    if (out_did) *out_did = true;
+    return true;
   }
+  if (w) w->from = blocks->v.arr.len;
   return true;
 }
 
@@ -4496,27 +4677,45 @@ static bool lower_sem_nodes(SirProgram* p) {
   }
 
   // 2) Handle remaining sem.* by iteratively lowering per-function until fixed point.
+  //    CFG-form functions keep a worklist of blocks that may still hold sem.*, so each lowering
+  //    only rescans the blocks it rewrote or appended. The lowering order is unchanged: the
+  //    first dirty block in block order is also the first block holding a lowerable sem.*.
+  SemVisitSet visit = {0};
+  SemCfgWork work = {0};
+  bool ok = false;
   for (size_t i = 0; i < p->nodes_cap; i++) {
     NodeRec* fn = p->nodes ? p->nodes[i] : NULL;
     if (!fn || !fn->tag || strcmp(fn->tag, "fn") != 0) continue;
     if (!fn->fields || fn->fields->type != JSON_OBJECT) continue;
 
+    sem_work_reset(&work);
     for (;;) {
       bool did = false;
       // First, hoist sem.* used in expression positions into lets so the lowering pass
       // can treat them uniformly.
-      if (json_obj_get(fn->fields, "entry")) {
-        if (!hoist_sem_uses_in_cfg_fn(p, fn, &did)) return false;
+      if (json_obj_get_sym(fn->fields, JSON_KEY_ENTRY)) {
+        if (!hoist_sem_uses_in_cfg_fn(p, fn, &work, &visit, &did)) goto done;
         if (did) continue;
-        if (!lower_one_sem_in_cfg_fn(p, fn, &did)) return false;
+        if (!lower_one_sem_in_cfg_fn(p, fn, &work, &did)) goto done;
+        if (did) continue;
+        // Worklist drained: confirm with one full scan before declaring the fixed point.
+        if (!hoist_sem_uses_in_cfg_fn(p, fn, NULL, &visit, &did)) goto done;
+        if (!did && !lower_one_sem_in_cfg_fn(p, fn, NULL, &did)) goto done;
+        if (did) sem_work_reset(&work);
       } else {
-        if (!hoist_sem_uses_in_body_fn(p, fn, &did)) return false;
+        if (!hoist_sem_uses_in_body_fn(p, fn, &visit, &did)) goto done;
         if (did) continue;
-        if (!lower_one_sem_in_body_fn(p, fn, &did)) return false;
+        if (!lower_one_sem_in_body_fn(p, fn, &did)) goto done;
       }
       if (!did) break;
     }
   }
+  ok = true;
+
+done:
+  sem_visit_free(&visit);
+  sem_work_free(&work);
+  if (!ok) return false;
 
   // 3) If any sem.* remains, we don't know how to lower it yet.
   for (size_t i = 0; i < p->nodes_cap; i++) {
@@ -44,12 +44,17 @@ bool bind_add(FunctionCtx* f, const char* name, LLVMValueRef v);
 LLVMValueRef bind_get(FunctionCtx* f, const char* name);
 size_t bind_mark(FunctionCtx* f);
 void bind_restore(FunctionCtx* f, size_t mark);
+// Records that `n` now carries a value scoped to the function being lowered.
+void note_lowered_node(SirProgram* p, NodeRec* n);
 
 // Lowering entrypoints used by lower_functions.
 LLVMValueRef lower_expr(FunctionCtx* f, int64_t node_id);
 bool lower_stmt(FunctionCtx* f, int64_t node_id);
 bool lower_term_cfg(FunctionCtx* f, int64_t node_id);
 
+// Adds the module global for sym `s` (kind var/const); ptr.sym does so on first use.
+LLVMValueRef lower_sym_global(FunctionCtx* f, SymRec* s);
+
 // Internal helper: second half of lower_expr dispatch.
 bool lower_expr_part_b(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef* out);
 
@@ -139,17 +139,17 @@ bool lower_expr_simd(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef*
       LOWER_ERR_NODE(f, n, "sircc.vec.shuffle.missing_fields", "sircc: vec.shuffle node %lld missing fields", (long long)node_id);
       return false;
     }
-    JsonValue* args = json_obj_get(n->fields, "args");
+    JsonValue* args = json_obj_get_sym(n->fields, JSON_KEY_ARGS);
     if (!args || args->type != JSON_ARRAY || args->v.arr.len != 2) {
       LOWER_ERR_NODE(f, n, "sircc.vec.shuffle.args.bad", "sircc: vec.shuffle node %lld requires args:[a, b]", (long long)node_id);
       return false;
     }
-    JsonValue* flags = json_obj_get(n->fields, "flags");
+    JsonValue* flags = json_obj_get_sym(n->fields, JSON_KEY_FLAGS);
     if (!flags || flags->type != JSON_OBJECT) {
       LOWER_ERR_NODE(f, n, "sircc.vec.shuffle.flags.bad", "sircc: vec.shuffle node %lld requires fields.flags object", (long long)node_id);
       return false;
     }
-    JsonValue* idxs = json_obj_get(flags, "idx");
+    JsonValue* idxs = json_obj_get_sym(flags, JSON_KEY_IDX);
     if (!idxs || idxs->type != JSON_ARRAY) {
       LOWER_ERR_NODE(f, n, "sircc.vec.shuffle.idx.bad", "sircc: vec.shuffle node %lld requires flags.idx array", (long long)node_id);
       return false;
@@ -239,16 +239,17 @@ bool lower_expr_simd(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef*
       LOWER_ERR_NODE(f, n, "sircc.vec.splat.missing_fields", "sircc: vec.splat node %lld missing fields", (long long)node_id);
       return false;
     }
-    JsonValue* args = json_obj_get(n->fields, "args");
-    if (!args || args->type != JSON_ARRAY || args->v.arr.len != 1) {
+    int64_t arg_ids[1];
+    bool refs_ok = false;
+    if (!sir_node_args_n(f->p, n, 1, arg_ids, &refs_ok)) {
       LOWER_ERR_NODE(f, n, "sircc.vec.splat.args.bad", "sircc: vec.splat node %lld requires args:[x]", (long long)node_id);
       return false;
     }
-    int64_t xid = 0;
-    if (!parse_node_ref_id(f->p, args->v.arr.items[0], &xid)) {
+    if (!refs_ok) {
       LOWER_ERR_NODE(f, n, "sircc.vec.splat.args.ref_bad", "sircc: vec.splat node %lld args[0] must be a node ref", (long long)node_id);
       return false;
     }
+    int64_t xid = arg_ids[0];
     LLVMValueRef x = lower_expr(f, xid);
     if (!x) return false;
 
@@ -291,7 +292,7 @@ bool lower_expr_simd(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef*
       LOWER_ERR_NODE(f, n, "sircc.vec.op.missing_fields", "sircc: %s node %lld missing fields", n->tag, (long long)node_id);
       return false;
     }
-    JsonValue* args = json_obj_get(n->fields, "args");
+    JsonValue* args = json_obj_get_sym(n->fields, JSON_KEY_ARGS);
     if (!args || args->type != JSON_ARRAY) {
       LOWER_ERR_NODE(f, n, "sircc.vec.op.args.bad", "sircc: %s node %lld requires fields.args array", n->tag, (long long)node_id);
       return false;
@@ -567,16 +568,17 @@ bool lower_expr_simd(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef*
       LOWER_ERR_NODE(f, n, "sircc.vec.extract.missing_fields", "sircc: vec.extract node %lld missing fields", (long long)node_id);
       return false;
     }
-    JsonValue* args = json_obj_get(n->fields, "args");
-    if (!args || args->type != JSON_ARRAY || args->v.arr.len != 2) {
+    int64_t arg_ids[2];
+    bool refs_ok = false;
+    if (!sir_node_args_n(f->p, n, 2, arg_ids, &refs_ok)) {
       LOWER_ERR_NODE(f, n, "sircc.vec.extract.args.bad", "sircc: vec.extract node %lld requires args:[v, idx]", (long long)node_id);
       return false;
     }
-    int64_t vid = 0, idxid = 0;
-    if (!parse_node_ref_id(f->p, args->v.arr.items[0], &vid) || !parse_node_ref_id(f->p, args->v.arr.items[1], &idxid)) {
+    if (!refs_ok) {
       LOWER_ERR_NODE(f, n, "sircc.vec.extract.args.ref_bad", "sircc: vec.extract node %lld args must be node refs", (long long)node_id);
       return false;
     }
+    int64_t vid = arg_ids[0], idxid = arg_ids[1];
     NodeRec* vn = get_node(f->p, vid);
     if (!vn || vn->type_ref == 0) {
       LOWER_ERR_NODE(f, n, "sircc.vec.extract.v.missing_type", "sircc: vec.extract node %lld v must have a vec type_ref", (long long)node_id);
@@ -629,7 +631,7 @@ bool lower_expr_simd(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef*
       LOWER_ERR_NODE(f, n, "sircc.vec.replace.missing_fields", "sircc: vec.replace node %lld missing fields", (long long)node_id);
       return false;
     }
-    JsonValue* args = json_obj_get(n->fields, "args");
+    JsonValue* args = json_obj_get_sym(n->fields, JSON_KEY_ARGS);
     if (!args || args->type != JSON_ARRAY || args->v.arr.len != 3) {
       LOWER_ERR_NODE(f, n, "sircc.vec.replace.args.bad", "sircc: vec.replace node %lld requires args:[v, idx, x]", (long long)node_id);
       return false;
@@ -688,7 +690,7 @@ bool lower_expr_simd(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef*
       return false;
     }
     int64_t aid = 0;
-    if (!parse_node_ref_id(f->p, json_obj_get(n->fields, "addr"), &aid)) {
+    if (!parse_node_ref_id(f->p, json_obj_get_sym(n->fields, JSON_KEY_ADDR), &aid)) {
       LOWER_ERR_NODE(f, n, "sircc.load.vec.addr.ref_bad", "sircc: load.vec node %lld missing fields.addr ref", (long long)node_id);
       return false;
     }
@@ -706,7 +708,7 @@ bool lower_expr_simd(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef*
     if (want_ptr != pty) pval = LLVMBuildBitCast(f->builder, pval, want_ptr, "ldv.cast");
 
     unsigned align = 1;
-    JsonValue* alignv = json_obj_get(n->fields, "align");
+    JsonValue* alignv = json_obj_get_sym(n->fields, JSON_KEY_ALIGN);
     if (alignv) {
       int64_t a = 0;
       if (!json_get_i64(alignv, &a) || a <= 0 || a > (int64_t)UINT_MAX) {
@@ -723,7 +725,7 @@ bool lower_expr_simd(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef*
 
     LLVMValueRef out = LLVMBuildLoad2(f->builder, vec_llvm, pval, "loadv");
     LLVMSetAlignment(out, align);
-    JsonValue* volv = json_obj_get(n->fields, "vol");
+    JsonValue* volv = json_obj_get_sym(n->fields, JSON_KEY_VOL);
     if (volv && volv->type == JSON_BOOL) LLVMSetVolatile(out, volv->v.b ? 1 : 0);
     out = canonicalize_float_vec(f, out, vec, lane);
     *outp = out;
@@ -737,7 +739,7 @@ bool lower_expr_simd(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef*
     }
     int64_t from_id = 0;
     int64_t to_id = 0;
-    if (!parse_type_ref_id(f->p, json_obj_get(n->fields, "from"), &from_id) || !parse_type_ref_id(f->p, json_obj_get(n->fields, "to"), &to_id)) {
+    if (!parse_type_ref_id(f->p, json_obj_get_sym(n->fields, JSON_KEY_FROM), &from_id) || !parse_type_ref_id(f->p, json_obj_get_sym(n->fields, JSON_KEY_TO), &to_id)) {
       LOWER_ERR_NODE(f, n, "sircc.vec.bitcast.from_to.bad", "sircc: vec.bitcast node %lld requires fields.from and fields.to type refs",
                      (long long)node_id);
       return false;
@@ -750,16 +752,17 @@ bool lower_expr_simd(FunctionCtx* f, int64_t node_id, NodeRec* n, LLVMValueRef*
       LOWER_ERR_NODE(f, n, "sircc.vec.bitcast.type.bad", "sircc: vec.bitcast node %lld from/to must be vec types", (long long)node_id);
       return false;
     }
-    JsonValue* args = json_obj_get(n->fields, "args");
-    if (!args || args->type != JSON_ARRAY || args->v.arr.len != 1) {
+    int64_t arg_ids[1];
+    bool refs_ok = false;
+    if (!sir_node_args_n(f->p, n, 1, arg_ids, &refs_ok)) {
       LOWER_ERR_NODE(f, n, "sircc.vec.bitcast.args.bad", "sircc: vec.bitcast node %lld requires args:[v]", (long long)node_id);
       return false;
     }
-    int64_t vid = 0;
-    if (!parse_node_ref_id(f->p, args->v.arr.items[0], &vid)) {
+    if (!refs_ok) {
       LOWER_ERR_NODE(f, n, "sircc.vec.bitcast.args.ref_bad", "sircc: vec.bitcast node %lld args[0] must be a node ref", (long long)node_id);
       return false;
     }
+    int64_t vid = arg_ids[0];
     LLVMValueRef v = lower_expr(f, vid);
     if (!v) return false;
 
@@ -793,7 +796,7 @@ bool lower_stmt_simd(FunctionCtx* f, int64_t node_id, NodeRec* n) {
       return false;
     }
     int64_t aid = 0, vid = 0;
-    if (!parse_node_ref_id(f->p, json_obj_get(n->fields, "addr"), &aid) || !parse_node_ref_id(f->p, json_obj_get(n->fields, "value"), &vid)) {
+    if (!parse_node_ref_id(f->p, json_obj_get_sym(n->fields, JSON_KEY_ADDR), &aid) || !parse_node_ref_id(f->p, json_obj_get_sym(n->fields, JSON_KEY_VALUE), &vid)) {
       LOWER_ERR_NODE(f, n, "sircc.store.vec.addr_value.ref_bad", "sircc: store.vec node %lld requires fields.addr and fields.value refs",
                      (long long)node_id);
       return false;
@@ -803,7 +806,7 @@ bool lower_stmt_simd(FunctionCtx* f, int64_t node_id, NodeRec* n) {
     NodeRec* vn = get_node(f->p, vid);
     if (vn && vn->type_ref) vec_ty_id = vn->type_ref;
     if (vec_ty_id == 0) {
-      parse_type_ref_id(f->p, json_obj_get(n->fields, "ty"), &vec_ty_id);
+      parse_type_ref_id(f->p, json_obj_get_sym(n->fields, JSON_KEY_TY), &vec_ty_id);
     }
     if (vec_ty_id == 0) {
       LOWER_ERR_NODE(f, n, "sircc.store.vec.missing_type", "sircc: store.vec node %lld requires a vec type (value.type_ref or fields.ty)",
@@ -833,7 +836,7 @@ bool lower_stmt_simd(FunctionCtx* f, int64_t node_id, NodeRec* n) {
     if (want_ptr != pty) pval = LLVMBuildBitCast(f->builder, pval, want_ptr, "stv.cast");
 
     unsigned align = 1;
-    JsonValue* alignv = json_obj_get(n->fields, "align");
+    JsonValue* alignv = json_obj_get_sym(n->fields, JSON_KEY_ALIGN);
     if (alignv) {
       int64_t a = 0;
       if (!json_get_i64(alignv, &a) || a <= 0 || a > (int64_t)UINT_MAX) {
@@ -852,7 +855,7 @@ bool lower_stmt_simd(FunctionCtx* f, int64_t node_id, NodeRec* n) {
 
     LLVMValueRef st = LLVMBuildStore(f->builder, vval, pval);
     LLVMSetAlignment(st, align);
-    JsonValue* volv = json_obj_get(n->fields, "vol");
+    JsonValue* volv = json_obj_get_sym(n->fields, JSON_KEY_VOL);
     if (volv && volv->type == JSON_BOOL) LLVMSetVolatile(st, volv->v.b ? 1 : 0);
     return true;
   }
@@ -0,0 +1,315 @@
+// SPDX-FileCopyrightText: 2026 Frogfish
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "compiler_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct TagName {
+  const char* name;
+  SirNodeTag tag;
+} TagName;
+
+// Sorted by name (strcmp order); looked up with bsearch.
+static const TagName k_tag_names[] = {
+    {"block", SIR_NODE_BLOCK},
+    {"bparam", SIR_NODE_BPARAM},
+    {"call", SIR_NODE_CALL},
+    {"call.closure", SIR_NODE_CALL_CLOSURE},
+    {"call.fun", SIR_NODE_CALL_FUN},
+    {"call.indirect", SIR_NODE_CALL_INDIRECT},
+    {"const.i64", SIR_NODE_CONST_I64},
+    {"cstr", SIR_NODE_CSTR},
+    {"decl.fn", SIR_NODE_DECL_FN},
+    {"fn", SIR_NODE_FN},
+    {"i32.zext.i8", SIR_NODE_I32_ZEXT_I8},
+    {"let", SIR_NODE_LET},
+    {"load.i16", SIR_NODE_LOAD_I16},
+    {"load.i32", SIR_NODE_LOAD_I32},
+    {"load.i64", SIR_NODE_LOAD_I64},
+    {"load.i8", SIR_NODE_LOAD_I8},
+    {"load.ptr", SIR_NODE_LOAD_PTR},
+    {"load.vec", SIR_NODE_LOAD_VEC},
+    {"mem.copy", SIR_NODE_MEM_COPY},
+    {"mem.fill", SIR_NODE_MEM_FILL},
+    {"name", SIR_NODE_NAME},
+    {"param", SIR_NODE_PARAM},
+    {"ptr.add", SIR_NODE_PTR_ADD},
+    {"ptr.from_i64", SIR_NODE_PTR_FROM_I64},
+    {"ptr.offset", SIR_NODE_PTR_OFFSET},
+    {"ptr.sym", SIR_NODE_PTR_SYM},
+    {"return", SIR_NODE_RETURN},
+    {"sem.and_sc", SIR_NODE_SEM_AND_SC},
+    {"sem.break", SIR_NODE_SEM_BREAK},
+    {"sem.cond", SIR_NODE_SEM_COND},
+    {"sem.continue", SIR_NODE_SEM_CONTINUE},
+    {"sem.defer", SIR_NODE_SEM_DEFER},
+    {"sem.if", SIR_NODE_SEM_IF},
+    {"sem.match_sum", SIR_NODE_SEM_MATCH_SUM},
+    {"sem.or_sc", SIR_NODE_SEM_OR_SC},
+    {"sem.scope", SIR_NODE_SEM_SCOPE},
+    {"sem.switch", SIR_NODE_SEM_SWITCH},
+    {"sem.while", SIR_NODE_SEM_WHILE},
+    {"store.i16", SIR_NODE_STORE_I16},
+    {"store.i32", SIR_NODE_STORE_I32},
+    {"store.i64", SIR_NODE_STORE_I64},
+    {"store.i8", SIR_NODE_STORE_I8},
+    {"store.vec", SIR_NODE_STORE_VEC},
+    {"term.br", SIR_NODE_TERM_BR},
+    {"term.cbr", SIR_NODE_TERM_CBR},
+    {"term.condbr", SIR_NODE_TERM_CONDBR},
+    {"term.ret", SIR_NODE_TERM_RET},
+    {"term.switch", SIR_NODE_TERM_SWITCH},
+    {"term.unreachable", SIR_NODE_TERM_UNREACHABLE},
+    {"vec.add", SIR_NODE_VEC_ADD},
+    {"vec.and", SIR_NODE_VEC_AND},
+    {"vec.bitcast", SIR_NODE_VEC_BITCAST},
+    {"vec.extract", SIR_NODE_VEC_EXTRACT},
+    {"vec.mul", SIR_NODE_VEC_MUL},
+    {"vec.not", SIR_NODE_VEC_NOT},
+    {"vec.or", SIR_NODE_VEC_OR},
+    {"vec.replace", SIR_NODE_VEC_REPLACE},
+    {"vec.select", SIR_NODE_VEC_SELECT},
+    {"vec.shuffle", SIR_NODE_VEC_SHUFFLE},
+    {"vec.splat", SIR_NODE_VEC_SPLAT},
+    {"vec.sub", SIR_NODE_VEC_SUB},
+    {"vec.xor", SIR_NODE_VEC_XOR},
+};
+
+static int tag_name_cmp(const void* key, const void* elem) {
+  return strcmp((const char*)key, ((const TagName*)elem)->name);
+}
+
+static SirNodeTag classify_tag(const char* tag) {
+  if (!tag) return SIR_NODE_OTHER;
+  const TagName* t =
+      (const TagName*)bsearch(tag, k_tag_names, sizeof(k_tag_names) / sizeof(k_tag_names[0]), sizeof(k_tag_names[0]), tag_name_cmp);
+  return t ? t->tag : SIR_NODE_OTHER;
+}
+
+static unsigned classify_family(const char* tag, unsigned* out_width) {
+  *out_width = 0;
+  if (!tag) return 0;
+  if (strncmp(tag, "vec.", 4) == 0 || strcmp(tag, "load.vec") == 0 || strcmp(tag, "store.vec") == 0) return SIR_NODE_FAM_VEC;
+  if (strcmp(tag, "call.fun") == 0 || strncmp(tag, "fun.", 4) == 0) return SIR_NODE_FAM_FUN;
+  if (strcmp(tag, "call.closure") == 0 || strncmp(tag, "closure.", 8) == 0) return SIR_NODE_FAM_CLOSURE;
+  if (strncmp(tag, "adt.", 4) == 0) return SIR_NODE_FAM_ADT;
+  if (strncmp(tag, "sem.", 4) == 0) return SIR_NODE_FAM_SEM;
+  if (strncmp(tag, "term.", 5) == 0) return SIR_NODE_FAM_TERM;
+  if (tag[0] == 'i') {
+    unsigned w = 0;
+    if (strncmp(tag, "i8.", 3) == 0) w = 8;
+    else if (strncmp(tag, "i16.", 4) == 0) w = 16;
+    else if (strncmp(tag, "i32.", 4) == 0) w = 32;
+    else if (strncmp(tag, "i64.", 4) == 0) w = 64;
+    if (w) {
+      *out_width = w;
+      return SIR_NODE_FAM_INT;
+    }
+  }
+  return 0;
+}
+
+// Resolves a node ref without reporting anything. Entries that fail are marked
+// SIR_NODE_ARGS_BAD and sir_node_args replays parse_node_ref_id on them, so id
+// diagnostics are still reported where the consumer asks for the args.
+bool sir_node_ref_quiet(SirProgram* p, const JsonValue* v, int64_t* out_id) {
+  if (!v || v->type != JSON_OBJECT) return false;
+  const char* ts = json_get_string(json_obj_get_sym(v, JSON_KEY_T));
+  if (!ts || strcmp(ts, "ref") != 0) return false;
+  const char* k = json_get_string(json_obj_get_sym(v, JSON_KEY_K));
+  if (k && strcmp(k, "node") != 0) return false;
+  const JsonValue* idv = json_obj_get_sym(v, JSON_KEY_ID);
+  int64_t i = 0;
+  if (json_get_i64((JsonValue*)idv, &i)) {
+    if (i < 0) return false;
+  } else {
+    const char* s = json_get_string((JsonValue*)idv);
+    if (!s || !*s) return false;
+  }
+  return sir_intern_id(p, SIR_ID_NODE, idv, out_id, "node ref");
+}
+
+static bool ops_reserve(SirNodeTable* t, size_t extra) {
+  if (t->ops_len + extra <= t->ops_cap) return true;
+  size_t ncap = t->ops_cap ? t->ops_cap : 256;
+  while (ncap < t->ops_len + extra) ncap *= 2;
+  int64_t* nops = (int64_t*)realloc(t->ops, ncap * sizeof(int64_t));
+  if (!nops) return false;
+  t->ops = nops;
+  t->ops_cap = ncap;
+  return true;
+}
+
+void sir_nodes_free(SirProgram* p) {
+  if (!p) return;
+  SirNodeTable* t = &p->node_tab;
+  free(t->tag);
+  free(t->family);
+  free(t->int_width);
+  free(t->args_state);
+  free(t->has_value);
+  free(t->args_off);
+  free(t->args_len);
+  free(t->name);
+  free(t->value);
+  free(t->src_tag);
+  free(t->src_fields);
+  free(t->ops);
+  memset(t, 0, sizeof(*t));
+}
+
+bool sir_nodes_build(SirProgram* p) {
+  if (!p) return false;
+  sir_nodes_free(p);
+  SirNodeTable* t = &p->node_tab;
+  const size_t n = p->nodes_cap;
+  if (n == 0) return true;
+
+  t->tag = (uint8_t*)calloc(n, sizeof(uint8_t));
+  t->family = (uint8_t*)calloc(n, sizeof(uint8_t));
+  t->int_width = (uint8_t*)calloc(n, sizeof(uint8_t));
+  t->args_state = (uint8_t*)calloc(n, sizeof(uint8_t));
+  t->has_value = (uint8_t*)calloc(n, sizeof(uint8_t));
+  t->args_off = (uint32_t*)calloc(n, sizeof(uint32_t));
+  t->args_len = (uint32_t*)calloc(n, sizeof(uint32_t));
+  t->name = (const char**)calloc(n, sizeof(const char*));
+  t->value = (int64_t*)calloc(n, sizeof(int64_t));
+  t->src_tag = (const char**)calloc(n, sizeof(const char*));
+  t->src_fields = (const void**)calloc(n, sizeof(const void*));
+  if (!t->tag || !t->family || !t->int_width || !t->args_state || !t->has_value || !t->args_off || !t->args_len || !t->name ||
+      !t->value || !t->src_tag || !t->src_fields) {
+    sir_nodes_free(p);
+    return false;
+  }
+  t->len = n;
+
+  for (size_t i = 0; i < n; i++) {
+    const NodeRec* nr = p->nodes[i];
+    if (!nr) continue;
+    unsigned width = 0;
+    t->tag[i] = (uint8_t)classify_tag(nr->tag);
+    t->family[i] = (uint8_t)classify_family(nr->tag, &width);
+    t->int_width[i] = (uint8_t)width;
+    t->src_tag[i] = nr->tag;
+    t->src_fields[i] = nr->fields;
+    if (!nr->fields || nr->fields->type != JSON_OBJECT) continue;
+
+    t->name[i] = json_get_string(json_obj_get_sym(nr->fields, JSON_KEY_NAME));
+    if (json_get_i64(json_obj_get_sym(nr->fields, JSON_KEY_VALUE), &t->value[i])) t->has_value[i] = 1;
+
+    const JsonValue* args = json_obj_get_sym(nr->fields, JSON_KEY_ARGS);
+    if (!args) continue;
+    t->args_state[i] = SIR_NODE_ARGS_NOT_ARRAY;
+    if (args->type != JSON_ARRAY) continue;
+    t->args_state[i] = SIR_NODE_ARGS_BAD;
+    const size_t len = args->v.arr.len;
+    if (len > UINT32_MAX || t->ops_len + len > UINT32_MAX) continue;
+    t->args_len[i] = (uint32_t)len;
+    if (!ops_reserve(t, len)) {
+      sir_nodes_free(p);
+      return false;
+    }
+    bool ok = true;
+    for (size_t k = 0; k < len && ok; k++) ok = sir_node_ref_quiet(p, args->v.arr.items[k], &t->ops[t->ops_len + k]);
+    if (!ok) continue;
+    t->args_off[i] = (uint32_t)t->ops_len;
+    t->args_state[i] = SIR_NODE_ARGS_OK;
+    t->ops_len += len;
+  }
+  return true;
+}
+
+static bool entry_fresh(const SirProgram* p, const NodeRec* n) {
+  const SirNodeTable* t = &p->node_tab;
+  if (!n || n->id < 0 || (size_t)n->id >= t->len) return false;
+  return t->src_tag[n->id] == n->tag && t->src_fields[n->id] == (const void*)n->fields;
+}
+
+SirNodeTag sir_node_tag(SirProgram* p, const NodeRec* n) {
+  if (!n) return SIR_NODE_OTHER;
+  if (entry_fresh(p, n)) return (SirNodeTag)p->node_tab.tag[n->id];
+  return classify_tag(n->tag);
+}
+
+unsigned sir_node_family(SirProgram* p, const NodeRec* n) {
+  if (!n) return 0;
+  if (entry_fresh(p, n)) return p->node_tab.family[n->id];
+  unsigned width = 0;
+  return classify_family(n->tag, &width);
+}
+
+unsigned sir_node_int_width(SirProgram* p, const NodeRec* n) {
+  if (!n) return 0;
+  if (entry_fresh(p, n)) return p->node_tab.int_width[n->id];
+  unsigned width = 0;
+  (void)classify_family(n->tag, &width);
+  return width;
+}
+
+SirNodeArgsState sir_node_args(SirProgram* p, const NodeRec* n, const int64_t** out_ids, size_t* out_len) {
+  if (out_ids) *out_ids = NULL;
+  if (out_len) *out_len = 0;
+  if (!n || !out_ids || !out_len) return SIR_NODE_ARGS_ABSENT;
+  if (entry_fresh(p, n)) {
+    const SirNodeTable* t = &p->node_tab;
+    const SirNodeArgsState st = (SirNodeArgsState)t->args_state[n->id];
+    if (st == SIR_NODE_ARGS_ABSENT || st == SIR_NODE_ARGS_NOT_ARRAY) return st;
+    *out_len = t->args_len[n->id];
+    if (st == SIR_NODE_ARGS_OK) {
+      *out_ids = t->ops + t->args_off[n->id];
+      return st;
+    }
+  }
+
+  // Stale or undecodable: go through the JSON (and its diagnostics).
+  const JsonValue* args = (n->fields && n->fields->type == JSON_OBJECT) ? json_obj_get_sym(n->fields, JSON_KEY_ARGS) : NULL;
+  if (!args) return SIR_NODE_ARGS_ABSENT;
+  if (args->type != JSON_ARRAY) return SIR_NODE_ARGS_NOT_ARRAY;
+  const size_t len = args->v.arr.len;
+  *out_len = len;
+  int64_t* ids = len ? (int64_t*)arena_alloc(&p->arena, len * sizeof(int64_t)) : NULL;
+  if (len && !ids) return SIR_NODE_ARGS_BAD;
+  for (size_t k = 0; k < len; k++) {
+    if (!parse_node_ref_id(p, args->v.arr.items[k], &ids[k])) return SIR_NODE_ARGS_BAD;
+  }
+  *out_ids = ids;
+  return SIR_NODE_ARGS_OK;
+}
+
+bool sir_node_args_n(SirProgram* p, const NodeRec* n, size_t want, int64_t* out, bool* out_refs_ok) {
+  if (out_refs_ok) *out_refs_ok = false;
+  if (!n || !out || !out_refs_ok) return false;
+  if (entry_fresh(p, n)) {
+    const SirNodeTable* t = &p->node_tab;
+    const SirNodeArgsState st = (SirNodeArgsState)t->args_state[n->id];
+    if (st != SIR_NODE_ARGS_OK && st != SIR_NODE_ARGS_BAD) return false;
+    if (t->args_len[n->id] != want) return false;
+  }
+  const int64_t* ids = NULL;
+  size_t len = 0;
+  const SirNodeArgsState st = sir_node_args(p, n, &ids, &len);
+  if ((st != SIR_NODE_ARGS_OK && st != SIR_NODE_ARGS_BAD) || len != want) return false;
+  if (st == SIR_NODE_ARGS_OK) {
+    memcpy(out, ids, want * sizeof(int64_t));
+    *out_refs_ok = true;
+  }
+  return true;
+}
+
+const char* sir_node_name(SirProgram* p, const NodeRec* n) {
+  if (!n) return NULL;
+  if (entry_fresh(p, n)) return p->node_tab.name[n->id];
+  return (n->fields && n->fields->type == JSON_OBJECT) ? json_get_string(json_obj_get_sym(n->fields, JSON_KEY_NAME)) : NULL;
+}
+
+bool sir_node_value_i64(SirProgram* p, const NodeRec* n, int64_t* out) {
+  if (!n || !out) return false;
+  if (entry_fresh(p, n)) {
+    if (!p->node_tab.has_value[n->id]) return false;
+    *out = p->node_tab.value[n->id];
+    return true;
+  }
+  return n->fields && n->fields->type == JSON_OBJECT && json_get_i64(json_obj_get_sym(n->fields, JSON_KEY_VALUE), out);
+}
@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: 2026 Frogfish
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Decoded node table.
+//
+// `NodeRec` keeps the raw JSON (`tag` string + `fields` object) because SIR-HL
+// lowering rewrites nodes in that form. Validation and the backends instead read
+// a per-node decode built once after parsing (and again after HL lowering):
+// a tag enum, family bits, resolved `fields.args` node ids, `fields.name` and an
+// integer `fields.value`. The table is struct-of-arrays indexed by node id.
+//
+// Every entry remembers the `tag`/`fields` pointers it was decoded from; if a
+// node has been rewritten since, the accessors decode it on the fly instead, so
+// the table is a cache and never a second source of truth.
+
+typedef enum SirNodeTag {
+  SIR_NODE_OTHER = 0, // a valid tag this table does not enumerate; compare n->tag
+
+  SIR_NODE_FN,
+  SIR_NODE_BLOCK,
+  SIR_NODE_PARAM,
+  SIR_NODE_BPARAM,
+  SIR_NODE_NAME,
+  SIR_NODE_DECL_FN,
+  SIR_NODE_CSTR,
+  SIR_NODE_LET,
+  SIR_NODE_RETURN,
+
+  SIR_NODE_CALL,
+  SIR_NODE_CALL_INDIRECT,
+  SIR_NODE_CALL_FUN,
+  SIR_NODE_CALL_CLOSURE,
+
+  SIR_NODE_PTR_SYM,
+  SIR_NODE_PTR_ADD,
+  SIR_NODE_PTR_OFFSET,
+  SIR_NODE_PTR_FROM_I64,
+  SIR_NODE_CONST_I64,
+
+  SIR_NODE_LOAD_I8,
+  SIR_NODE_LOAD_I16,
+  SIR_NODE_LOAD_I32,
+  SIR_NODE_LOAD_I64,
+  SIR_NODE_LOAD_PTR,
+  SIR_NODE_STORE_I8,
+  SIR_NODE_STORE_I16,
+  SIR_NODE_STORE_I32,
+  SIR_NODE_STORE_I64,
+  SIR_NODE_MEM_FILL,
+  SIR_NODE_MEM_COPY,
+  SIR_NODE_I32_ZEXT_I8,
+
+  SIR_NODE_TERM_BR,
+  SIR_NODE_TERM_CBR,
+  SIR_NODE_TERM_CONDBR,
+  SIR_NODE_TERM_SWITCH,
+  SIR_NODE_TERM_RET,
+  SIR_NODE_TERM_UNREACHABLE,
+
+  SIR_NODE_SEM_IF,
+  SIR_NODE_SEM_COND,
+  SIR_NODE_SEM_AND_SC,
+  SIR_NODE_SEM_OR_SC,
+  SIR_NODE_SEM_MATCH_SUM,
+  SIR_NODE_SEM_SWITCH,
+  SIR_NODE_SEM_WHILE,
+  SIR_NODE_SEM_DEFER,
+  SIR_NODE_SEM_SCOPE,
+  SIR_NODE_SEM_BREAK,
+  SIR_NODE_SEM_CONTINUE,
+
+  SIR_NODE_VEC_SPLAT,
+  SIR_NODE_VEC_EXTRACT,
+  SIR_NODE_VEC_REPLACE,
+  SIR_NODE_VEC_SHUFFLE,
+  SIR_NODE_VEC_BITCAST,
+  SIR_NODE_VEC_SELECT,
+  SIR_NODE_VEC_ADD,
+  SIR_NODE_VEC_SUB,
+  SIR_NODE_VEC_MUL,
+  SIR_NODE_VEC_AND,
+  SIR_NODE_VEC_OR,
+  SIR_NODE_VEC_XOR,
+  SIR_NODE_VEC_NOT,
+  SIR_NODE_LOAD_VEC,
+  SIR_NODE_STORE_VEC,
+
+  SIR_NODE_TAG_COUNT,
+} SirNodeTag;
+
+// Tag families (prefix classes), as bits.
+enum {
+  SIR_NODE_FAM_VEC = 1u << 0,     // vec.*, load.vec, store.vec
+  SIR_NODE_FAM_FUN = 1u << 1,     // call.fun, fun.*
+  SIR_NODE_FAM_CLOSURE = 1u << 2, // call.closure, closure.*
+  SIR_NODE_FAM_ADT = 1u << 3,     // adt.*
+  SIR_NODE_FAM_SEM = 1u << 4,     // sem.*
+  SIR_NODE_FAM_TERM = 1u << 5,    // term.*
+  SIR_NODE_FAM_INT = 1u << 6,     // i8/i16/i32/i64.* (width in int_width)
+};
+
+typedef struct SirNodeTable {
+  size_t len; // entries; node ids >= len are decoded on demand
+
+  uint8_t* tag;      // SirNodeTag
+  uint8_t* family;   // SIR_NODE_FAM_* bits
+  uint8_t* int_width; // 8/16/32/64 for SIR_NODE_FAM_INT, else 0
+  uint8_t* args_state; // SIR_NODE_ARGS_*
+  uint8_t* has_value;  // fields.value is an integer
+  uint32_t* args_off;  // into ops
+  uint32_t* args_len;  // element count (also for SIR_NODE_ARGS_BAD)
+  const char** name;   // fields.name when a string
+  int64_t* value;      // fields.value when has_value
+
+  const char** src_tag;      // NodeRec.tag the entry was decoded from
+  const void** src_fields;   // NodeRec.fields the entry was decoded from
+
+  int64_t* ops; // resolved operand ids (all nodes' args, back to back)
+  size_t ops_len;
+  size_t ops_cap;
+} SirNodeTable;
+
+typedef enum SirNodeArgsState {
+  SIR_NODE_ARGS_ABSENT = 0,    // no fields.args
+  SIR_NODE_ARGS_OK = 1,        // every element resolved to a node id
+  SIR_NODE_ARGS_BAD = 2,       // an array, but some element is not a node ref
+  SIR_NODE_ARGS_NOT_ARRAY = 3, // fields.args is not an array
+} SirNodeArgsState;
+
+struct SirProgram;
+struct NodeRec;
+struct JsonValue;
+
+// (Re)decodes every node. Returns false on OOM.
+bool sir_nodes_build(struct SirProgram* p);
+void sir_nodes_free(struct SirProgram* p);
+
+SirNodeTag sir_node_tag(struct SirProgram* p, const struct NodeRec* n);
+unsigned sir_node_family(struct SirProgram* p, const struct NodeRec* n);
+unsigned sir_node_int_width(struct SirProgram* p, const struct NodeRec* n);
+
+// Resolved `fields.args`. On SIR_NODE_ARGS_OK, `*out_ids` holds `*out_len` node ids.
+// On SIR_NODE_ARGS_BAD, `*out_len` is the array length and any id diagnostics have
+// been reported as parse_node_ref_id would; callers then emit their own arity/ref
+// error exactly as before.
+SirNodeArgsState sir_node_args(struct SirProgram* p, const struct NodeRec* n, const int64_t** out_ids, size_t* out_len);
+
+// Fixed-arity form: true when fields.args is an array of exactly `want` elements;
+// `*out_refs_ok` then says whether they all resolved (ids in `out[0..want)`). Id
+// diagnostics are only reported once the arity matched, as the JSON walk did.
+bool sir_node_args_n(struct SirProgram* p, const struct NodeRec* n, size_t want, int64_t* out, bool* out_refs_ok);
+
+// Resolves `v` as a node ref without reporting anything (false when it is not one).
+bool sir_node_ref_quiet(struct SirProgram* p, const struct JsonValue* v, int64_t* out_id);
+
+const char* sir_node_name(struct SirProgram* p, const struct NodeRec* n);
+bool sir_node_value_i64(struct SirProgram* p, const struct NodeRec* n, int64_t* out);
@@ -111,14 +111,14 @@ static bool validate_value(SirProgram* p, const JsonValue* v, const char* what)
     err_codef(p, "sircc.schema.value.not_object", "sircc: %s must be an object value", what);
     return false;
   }
-  const char* t = json_get_string(json_obj_get(v, "t"));
+  const char* t = json_get_string(json_obj_get_sym(v, JSON_KEY_T));
   if (!t) {
     err_codef(p, "sircc.schema.value.missing_t", "sircc: %s missing string field 't'", what);
     return false;
   }
 
   if (strcmp(t, "sym") == 0 || strcmp(t, "lbl") == 0 || strcmp(t, "reg") == 0) {
-    const char* name = json_get_string(json_obj_get(v, "v"));
+    const char* name = json_get_string(json_obj_get_sym(v, JSON_KEY_V));
     if (!name || !is_ident(name)) {
       err_codef(p, "sircc.schema.value.ident.bad", "sircc: %s %s.v must be an Ident", what, t);
       return false;
@@ -127,14 +127,14 @@ static bool validate_value(SirProgram* p, const JsonValue* v, const char* what)
   }
   if (strcmp(t, "num") == 0) {
     int64_t n = 0;
-    if (!json_get_i64(json_obj_get(v, "v"), &n)) {
+    if (!json_get_i64(json_obj_get_sym(v, JSON_KEY_V), &n)) {
       err_codef(p, "sircc.schema.value.num.bad", "sircc: %s num.v must be an integer", what);
       return false;
     }
     return true;
   }
   if (strcmp(t, "str") == 0) {
-    const char* s = json_get_string(json_obj_get(v, "v"));
+    const char* s = json_get_string(json_obj_get_sym(v, JSON_KEY_V));
     if (!s) {
       err_codef(p, "sircc.schema.value.str.bad", "sircc: %s str.v must be a string", what);
       return false;
@@ -142,19 +142,19 @@ static bool validate_value(SirProgram* p, const JsonValue* v, const char* what)
     return true;
   }
   if (strcmp(t, "mem") == 0) {
-    const JsonValue* base = json_obj_get(v, "base");
+    const JsonValue* base = json_obj_get_sym(v, JSON_KEY_BASE);
     if (!base || base->type != JSON_OBJECT) {
       err_codef(p, "sircc.schema.value.mem.base.bad", "sircc: %s mem.base must be an object", what);
       return false;
     }
-    const char* bt = json_get_string(json_obj_get(base, "t"));
+    const char* bt = json_get_string(json_obj_get_sym(base, JSON_KEY_T));
     if (!bt || (strcmp(bt, "reg") != 0 && strcmp(bt, "sym") != 0)) {
       err_codef(p, "sircc.schema.value.mem.base.bad", "sircc: %s mem.base must be reg or sym", what);
       return false;
     }
     if (!validate_value(p, base, what)) return false;
 
-    JsonValue* disp = json_obj_get(v, "disp");
+    JsonValue* disp = json_obj_get_sym(v, JSON_KEY_DISP);
     if (disp) {
       int64_t d = 0;
       if (!json_get_i64(disp, &d)) {
@@ -162,7 +162,7 @@ static bool validate_value(SirProgram* p, const JsonValue* v, const char* what)
         return false;
       }
     }
-    JsonValue* size = json_obj_get(v, "size");
+    JsonValue* size = json_obj_get_sym(v, JSON_KEY_SIZE);
     if (size) {
       int64_t s = 0;
       if (!json_get_i64(size, &s) || !(s == 1 || s == 2 || s == 4 || s == 8 || s == 16)) {
@@ -174,13 +174,13 @@ static bool validate_value(SirProgram* p, const JsonValue* v, const char* what)
   }
   if (strcmp(t, "ref") == 0) {
     int64_t id = 0;
-    const JsonValue* idv = json_obj_get(v, "id");
+    const JsonValue* idv = json_obj_get_sym(v, JSON_KEY_ID);
     const char* ids = json_get_string(idv);
     if (!json_get_i64(idv, &id) && !(ids && *ids)) {
       err_codef(p, "sircc.schema.value.ref.bad", "sircc: %s ref.id must be an integer or string", what);
       return false;
     }
-    JsonValue* k = json_obj_get(v, "k");
+    JsonValue* k = json_obj_get_sym(v, JSON_KEY_K);
     if (k) {
       const char* ks = json_get_string(k);
       if (!ks || (strcmp(ks, "sym") != 0 && strcmp(ks, "type") != 0 && strcmp(ks, "node") != 0)) {
@@ -271,7 +271,7 @@ static bool note_pending_feature_use(SirProgram* p, const char* mnemonic, const
   return true;
 }
 
-static bool parse_env_u64(const char* name, uint64_t* out) {
+bool parse_env_u64(const char* name, uint64_t* out) {
   if (!name || !out) return false;
   const char* s = getenv(name);
   if (!s || !*s) return false;
@@ -339,26 +339,26 @@ static bool parse_meta_record(SirProgram* p, const SirccOptions* opt, JsonValue*
   static const char* const keys[] = {"ir", "k", "producer", "ts", "unit", "id", "ext"};
   if (!require_only_keys(p, obj, keys, sizeof(keys) / sizeof(keys[0]), "meta record")) return false;
 
-  JsonValue* unit = json_obj_get(obj, "unit");
+  JsonValue* unit = json_obj_get_sym(obj, JSON_KEY_UNIT);
   if (unit) p->unit_name = json_get_string(unit);
 
-  JsonValue* ext = json_obj_get(obj, "ext");
+  JsonValue* ext = json_obj_get_sym(obj, JSON_KEY_EXT);
   if (ext && ext->type == JSON_OBJECT) {
     // Convention (sircc-defined): ext.target.triple (string)
-    JsonValue* target = json_obj_get(ext, "target");
+    JsonValue* target = json_obj_get_sym(ext, JSON_KEY_TARGET);
     if (target && target->type == JSON_OBJECT) {
-      const char* triple = json_get_string(json_obj_get(target, "triple"));
+      const char* triple = json_get_string(json_obj_get_sym(target, JSON_KEY_TRIPLE));
       if (triple && !(opt && opt->target_triple)) p->target_triple = triple;
 
       // Optional LLVM codegen tuning knobs (passed through to LLVM target machine creation).
-      const char* cpu = json_get_string(json_obj_get(target, "cpu"));
+      const char* cpu = json_get_string(json_obj_get_sym(target, JSON_KEY_CPU));
       if (cpu && *cpu) p->target_cpu = cpu;
-      const char* features = json_get_string(json_obj_get(target, "features"));
+      const char* features = json_get_string(json_obj_get_sym(target, JSON_KEY_FEATURES));
       if (features && *features) p->target_features = features;
 
       // Optional explicit target contract overrides (used for determinism / cross-target verification).
       // If provided, these must match the LLVM ABI for the chosen triple (when compiling).
-      JsonValue* ptrBitsV = json_obj_get(target, "ptrBits");
+      JsonValue* ptrBitsV = json_obj_get_sym(target, JSON_KEY_PTR_BITS);
       if (ptrBitsV) {
         int64_t ptrBits = 0;
         if (!must_i64(p, ptrBitsV, &ptrBits, "meta.ext.target.ptrBits")) return false;
@@ -371,7 +371,7 @@ static bool parse_meta_record(SirProgram* p, const SirccOptions* opt, JsonValue*
         p->target_ptrbits_override = true;
       }
 
-      const char* endian = json_get_string(json_obj_get(target, "endian"));
+      const char* endian = json_get_string(json_obj_get_sym(target, JSON_KEY_ENDIAN));
       if (endian && *endian) {
         if (strcmp(endian, "le") == 0) p->target_big_endian = false;
         else if (strcmp(endian, "be") == 0) p->target_big_endian = true;
@@ -382,7 +382,7 @@ static bool parse_meta_record(SirProgram* p, const SirccOptions* opt, JsonValue*
         p->target_endian_override = true;
       }
 
-      const char* structAlign = json_get_string(json_obj_get(target, "structAlign"));
+      const char* structAlign = json_get_string(json_obj_get_sym(target, JSON_KEY_STRUCT_ALIGN));
       if (structAlign && *structAlign) {
         if (strcmp(structAlign, "max") != 0 && strcmp(structAlign, "packed1") != 0) {
           err_codef(p, "sircc.meta.target.structAlign.bad", "sircc: meta.ext.target.structAlign must be 'max' or 'packed1'");
@@ -392,7 +392,7 @@ static bool parse_meta_record(SirProgram* p, const SirccOptions* opt, JsonValue*
         p->target_structalign_override = true;
       }
 
-      JsonValue* intAlign = json_obj_get(target, "intAlign");
+      JsonValue* intAlign = json_obj_get_sym(target, JSON_KEY_INT_ALIGN);
       if (intAlign && intAlign->type == JSON_OBJECT) {
         struct {
           const char* key;
@@ -417,7 +417,7 @@ static bool parse_meta_record(SirProgram* p, const SirccOptions* opt, JsonValue*
         }
       }
 
-      JsonValue* floatAlign = json_obj_get(target, "floatAlign");
+      JsonValue* floatAlign = json_obj_get_sym(target, JSON_KEY_FLOAT_ALIGN);
       if (floatAlign && floatAlign->type == JSON_OBJECT) {
         struct {
           const char* key;
@@ -443,7 +443,7 @@ static bool parse_meta_record(SirProgram* p, const SirccOptions* opt, JsonValue*
     }
 
     // Convention (sircc-defined): ext.features (array of strings)
-    JsonValue* features = json_obj_get(ext, "features");
+    JsonValue* features = json_obj_get_sym(ext, JSON_KEY_FEATURES);
     if (features && features->type == JSON_ARRAY) {
       for (size_t i = 0; i < features->v.arr.len; i++) {
         const char* f = json_get_string(features->v.arr.items[i]);
@@ -464,7 +464,7 @@ static bool parse_src_record(SirProgram* p, JsonValue* obj) {
   if (!require_only_keys(p, obj, keys, sizeof(keys) / sizeof(keys[0]), "src record")) return false;
 
   int64_t id = 0;
-  if (!sir_intern_id(p, SIR_ID_SRC, json_obj_get(obj, "id"), &id, "src.id")) return false;
+  if (!sir_intern_id(p, SIR_ID_SRC, json_obj_get_sym(obj, JSON_KEY_ID), &id, "src.id")) return false;
   if (!ensure_src_slot(p, id)) return false;
   if (p->srcs[id]) {
     err_codef(p, "sircc.schema.duplicate_id", "sircc: duplicate src id %lld", (long long)id);
@@ -472,23 +472,23 @@ static bool parse_src_record(SirProgram* p, JsonValue* obj) {
   }
 
   int64_t line = 0;
-  if (!must_i64(p, json_obj_get(obj, "line"), &line, "src.line")) return false;
+  if (!must_i64(p, json_obj_get_sym(obj, JSON_KEY_LINE), &line, "src.line")) return false;
 
   SrcRec* sr = (SrcRec*)arena_alloc(&p->arena, sizeof(SrcRec));
   if (!sr) return false;
   sr->id = id;
-  sr->file = json_get_string(json_obj_get(obj, "file"));
+  sr->file = json_get_string(json_obj_get_sym(obj, JSON_KEY_FILE));
   sr->line = line;
   sr->col = 0;
   sr->end_line = 0;
   sr->end_col = 0;
-  sr->text = json_get_string(json_obj_get(obj, "text"));
+  sr->text = json_get_string(json_obj_get_sym(obj, JSON_KEY_TEXT));
 
-  JsonValue* col = json_obj_get(obj, "col");
+  JsonValue* col = json_obj_get_sym(obj, JSON_KEY_COL);
   if (col) (void)must_i64(p, col, &sr->col, "src.col");
-  JsonValue* end_line = json_obj_get(obj, "end_line");
+  JsonValue* end_line = json_obj_get_sym(obj, JSON_KEY_END_LINE);
   if (end_line) (void)must_i64(p, end_line, &sr->end_line, "src.end_line");
-  JsonValue* end_col = json_obj_get(obj, "end_col");
+  JsonValue* end_col = json_obj_get_sym(obj, JSON_KEY_END_COL);
   if (end_col) (void)must_i64(p, end_col, &sr->end_col, "src.end_col");
 
   if ((sr->end_line && !sr->end_col) || (sr->end_col && !sr->end_line)) {
@@ -516,7 +516,7 @@ static bool parse_sym_record(SirProgram* p, JsonValue* obj) {
   if (!require_only_keys(p, obj, keys, sizeof(keys) / sizeof(keys[0]), "sym record")) return false;
 
   int64_t id = 0;
-  if (!sir_intern_id(p, SIR_ID_SYM, json_obj_get(obj, "id"), &id, "sym.id")) return false;
+  if (!sir_intern_id(p, SIR_ID_SYM, json_obj_get_sym(obj, JSON_KEY_ID), &id, "sym.id")) return false;
   if (!ensure_sym_slot(p, id)) return false;
   if (p->syms[id]) {
     err_codef(p, "sircc.schema.duplicate_id", "sircc: duplicate sym id %lld", (long long)id);
@@ -526,9 +526,9 @@ static bool parse_sym_record(SirProgram* p, JsonValue* obj) {
   SymRec* s = (SymRec*)arena_alloc(&p->arena, sizeof(SymRec));
   if (!s) return false;
   s->id = id;
-  s->name = must_string(p, json_obj_get(obj, "name"), "sym.name");
-  s->kind = must_string(p, json_obj_get(obj, "kind"), "sym.kind");
-  s->linkage = json_get_string(json_obj_get(obj, "linkage"));
+  s->name = must_string(p, json_obj_get_sym(obj, JSON_KEY_NAME), "sym.name");
+  s->kind = must_string(p, json_obj_get_sym(obj, JSON_KEY_KIND), "sym.kind");
+  s->linkage = json_get_string(json_obj_get_sym(obj, JSON_KEY_LINKAGE));
   s->type_ref = 0;
   s->value = NULL;
   if (!s->name || !s->kind) return false;
@@ -537,11 +537,11 @@ static bool parse_sym_record(SirProgram* p, JsonValue* obj) {
     return false;
   }
 
-  JsonValue* tr = json_obj_get(obj, "type_ref");
+  JsonValue* tr = json_obj_get_sym(obj, JSON_KEY_TYPE_REF);
   if (tr) {
     if (!sir_intern_id(p, SIR_ID_TYPE, tr, &s->type_ref, "sym.type_ref")) return false;
   }
-  JsonValue* v = json_obj_get(obj, "value");
+  JsonValue* v = json_obj_get_sym(obj, JSON_KEY_VALUE);
   if (v) {
     if (!validate_value(p, v, "sym.value")) return false;
     s->value = v;
@@ -562,7 +562,7 @@ static bool parse_ext_record(SirProgram* p, JsonValue* obj) {
 static bool parse_label_record(SirProgram* p, JsonValue* obj) {
   static const char* const keys[] = {"ir", "k", "name", "loc", "id"};
   if (!require_only_keys(p, obj, keys, sizeof(keys) / sizeof(keys[0]), "label record")) return false;
-  const char* name = must_string(p, json_obj_get(obj, "name"), "label.name");
+  const char* name = must_string(p, json_obj_get_sym(obj, JSON_KEY_NAME), "label.name");
   if (!name) return false;
   if (!is_ident(name)) {
     err_codef(p, "sircc.schema.ident.bad", "sircc: label.name must be an Ident");
@@ -574,8 +574,8 @@ static bool parse_label_record(SirProgram* p, JsonValue* obj) {
 static bool parse_instr_record(SirProgram* p, const SirccOptions* opt, JsonValue* obj) {
   static const char* const keys[] = {"ir", "k", "m", "ops", "src_ref", "loc", "id"};
   if (!require_only_keys(p, obj, keys, sizeof(keys) / sizeof(keys[0]), "instr record")) return false;
-  if (!must_string(p, json_obj_get(obj, "m"), "instr.m")) return false;
-  JsonValue* ops = json_obj_get(obj, "ops");
+  if (!must_string(p, json_obj_get_sym(obj, JSON_KEY_M), "instr.m")) return false;
+  JsonValue* ops = json_obj_get_sym(obj, JSON_KEY_OPS);
   if (!ops || ops->type != JSON_ARRAY) {
     err_codef(p, "sircc.schema.instr.ops.not_array", "sircc: expected array for instr.ops");
     return false;
@@ -583,7 +583,7 @@ static bool parse_instr_record(SirProgram* p, const SirccOptions* opt, JsonValue
   for (size_t i = 0; i < ops->v.arr.len; i++) {
     if (!validate_value(p, ops->v.arr.items[i], "instr operand")) return false;
   }
-  const char* m = json_get_string(json_obj_get(obj, "m"));
+  const char* m = json_get_string(json_obj_get_sym(obj, JSON_KEY_M));
   const char* need = required_feature_for_mnemonic(m);
   if (need && !has_feature(p, need)) {
     // Defer feature checks until end-of-parse, so meta.ext.features can appear anywhere in the stream.
@@ -598,8 +598,8 @@ static bool parse_instr_record(SirProgram* p, const SirccOptions* opt, JsonValue
 static bool parse_dir_record(SirProgram* p, JsonValue* obj) {
   static const char* const keys[] = {"ir", "k", "d", "name", "args", "section", "sig", "src_ref", "loc", "id"};
   if (!require_only_keys(p, obj, keys, sizeof(keys) / sizeof(keys[0]), "dir record")) return false;
-  if (!must_string(p, json_obj_get(obj, "d"), "dir.d")) return false;
-  JsonValue* args = json_obj_get(obj, "args");
+  if (!must_string(p, json_obj_get_sym(obj, JSON_KEY_D), "dir.d")) return false;
+  JsonValue* args = json_obj_get_sym(obj, JSON_KEY_ARGS);
   if (!args || args->type != JSON_ARRAY) {
     err_codef(p, "sircc.schema.dir.args.not_array", "sircc: expected array for dir.args");
     return false;
@@ -616,8 +616,8 @@ static bool parse_type_record(SirProgram* p, JsonValue* obj) {
   if (!require_only_keys(p, obj, keys, sizeof(keys) / sizeof(keys[0]), "type record")) return false;
 
   int64_t id = 0;
-  if (!sir_intern_id(p, SIR_ID_TYPE, json_obj_get(obj, "id"), &id, "type.id")) return false;
-  const char* kind = must_string(p, json_obj_get(obj, "kind"), "type.kind");
+  if (!sir_intern_id(p, SIR_ID_TYPE, json_obj_get_sym(obj, JSON_KEY_ID), &id, "type.id")) return false;
+  const char* kind = must_string(p, json_obj_get_sym(obj, JSON_KEY_KIND), "type.kind");
   if (!kind) return false;
   if (!ensure_type_slot(p, id)) return false;
   if (p->types[id]) {
@@ -631,7 +631,7 @@ static bool parse_type_record(SirProgram* p, JsonValue* obj) {
   tr->kind = TYPE_INVALID;
   tr->of = 0;
   tr->len = 0;
-  tr->name = json_get_string(json_obj_get(obj, "name"));
+  tr->name = json_get_string(json_obj_get_sym(obj, JSON_KEY_NAME));
   tr->ret = 0;
   tr->params = NULL;
   tr->param_len = 0;
@@ -648,22 +648,22 @@ static bool parse_type_record(SirProgram* p, JsonValue* obj) {
 
   if (strcmp(kind, "prim") == 0) {
     tr->kind = TYPE_PRIM;
-    tr->prim = must_string(p, json_obj_get(obj, "prim"), "type.prim");
+    tr->prim = must_string(p, json_obj_get_sym(obj, JSON_KEY_PRIM), "type.prim");
     if (!tr->prim) return false;
   } else if (strcmp(kind, "ptr") == 0) {
     tr->kind = TYPE_PTR;
-    if (!sir_intern_id(p, SIR_ID_TYPE, json_obj_get(obj, "of"), &tr->of, "type.of")) return false;
+    if (!sir_intern_id(p, SIR_ID_TYPE, json_obj_get_sym(obj, JSON_KEY_OF), &tr->of, "type.of")) return false;
   } else if (strcmp(kind, "array") == 0) {
     tr->kind = TYPE_ARRAY;
-    if (!sir_intern_id(p, SIR_ID_TYPE, json_obj_get(obj, "of"), &tr->of, "type.of")) return false;
-    if (!must_i64(p, json_obj_get(obj, "len"), &tr->len, "type.len")) return false;
+    if (!sir_intern_id(p, SIR_ID_TYPE, json_obj_get_sym(obj, JSON_KEY_OF), &tr->of, "type.of")) return false;
+    if (!must_i64(p, json_obj_get_sym(obj, JSON_KEY_LEN), &tr->len, "type.len")) return false;
     if (tr->len < 0) {
       err_codef(p, "sircc.type.array.len.bad", "sircc: type.array len must be >= 0");
       return false;
     }
   } else if (strcmp(kind, "fn") == 0) {
     tr->kind = TYPE_FN;
-    JsonValue* params = json_obj_get(obj, "params");
+    JsonValue* params = json_obj_get_sym(obj, JSON_KEY_PARAMS);
     if (!params || params->type != JSON_ARRAY) {
       err_codef(p, "sircc.type.fn.params.not_array", "sircc: expected array for type.params");
       return false;
@@ -676,12 +676,12 @@ static bool parse_type_record(SirProgram* p, JsonValue* obj) {
       if (!sir_intern_id(p, SIR_ID_TYPE, params->v.arr.items[i], &pid, "type.params[i]")) return false;
       tr->params[i] = pid;
     }
-    if (!sir_intern_id(p, SIR_ID_TYPE, json_obj_get(obj, "ret"), &tr->ret, "type.ret")) return false;
-    JsonValue* va = json_obj_get(obj, "varargs");
+    if (!sir_intern_id(p, SIR_ID_TYPE, json_obj_get_sym(obj, JSON_KEY_RET), &tr->ret, "type.ret")) return false;
+    JsonValue* va = json_obj_get_sym(obj, JSON_KEY_VARARGS);
     if (va && va->type == JSON_BOOL) tr->varargs = va->v.b;
   } else if (strcmp(kind, "struct") == 0) {
     tr->kind = TYPE_STRUCT;
-    JsonValue* fields = json_obj_get(obj, "fields");
+    JsonValue* fields = json_obj_get_sym(obj, JSON_KEY_FIELDS);
     if (!fields || fields->type != JSON_ARRAY) {
       err_codef(p, "sircc.type.struct.fields.not_array", "sircc: expected array for type.fields");
       return false;
@@ -698,33 +698,33 @@ static bool parse_type_record(SirProgram* p, JsonValue* obj) {
         err_codef(p, "sircc.type.struct.field.bad", "sircc: type.fields[%zu] must be an object", i);
         return false;
       }
-      const char* fname = must_string(p, json_obj_get(fo, "name"), "type.fields[i].name");
+      const char* fname = must_string(p, json_obj_get_sym(fo, JSON_KEY_NAME), "type.fields[i].name");
       if (!fname || !is_ident(fname)) {
         err_codef(p, "sircc.schema.ident.bad", "sircc: type.fields[%zu].name must be an Ident", i);
         return false;
       }
       int64_t fty = 0;
-      if (!sir_intern_id(p, SIR_ID_TYPE, json_obj_get(fo, "type_ref"), &fty, "type.fields[i].type_ref")) return false;
+      if (!sir_intern_id(p, SIR_ID_TYPE, json_obj_get_sym(fo, JSON_KEY_TYPE_REF), &fty, "type.fields[i].type_ref")) return false;
       tr->fields[i] = (TypeFieldRec){.name = fname, .type_ref = fty};
     }
   } else if (strcmp(kind, "fun") == 0) {
     tr->kind = TYPE_FUN;
-    if (!sir_intern_id(p, SIR_ID_TYPE, json_obj_get(obj, "sig"), &tr->sig, "type.sig")) return false;
+    if (!sir_intern_id(p, SIR_ID_TYPE, json_obj_get_sym(obj, JSON_KEY_SIG), &tr->sig, "type.sig")) return false;
   } else if (strcmp(kind, "closure") == 0) {
     tr->kind = TYPE_CLOSURE;
-    if (!sir_intern_id(p, SIR_ID_TYPE, json_obj_get(obj, "callSig"), &tr->call_sig, "type.callSig")) return false;
-    if (!sir_intern_id(p, SIR_ID_TYPE, json_obj_get(obj, "env"), &tr->env_ty, "type.env")) return false;
+    if (!sir_intern_id(p, SIR_ID_TYPE, json_obj_get_sym(obj, JSON_KEY_CALL_SIG), &tr->call_sig, "type.callSig")) return false;
+    if (!sir_intern_id(p, SIR_ID_TYPE, json_obj_get_sym(obj, JSON_KEY_ENV), &tr->env_ty, "type.env")) return false;
   } else if (strcmp(kind, "vec") == 0) {
     tr->kind = TYPE_VEC;
-    if (!sir_intern_id(p, SIR_ID_TYPE, json_obj_get(obj, "lane"), &tr->lane_ty, "type.lane")) return false;
-    if (!must_i64(p, json_obj_get(obj, "lanes"), &tr->lanes, "type.lanes")) return false;
+    if (!sir_intern_id(p, SIR_ID_TYPE, json_obj_get_sym(obj, JSON_KEY_LANE), &tr->lane_ty, "type.lane")) return false;
+    if (!must_i64(p, json_obj_get_sym(obj, JSON_KEY_LANES), &tr->lanes, "type.lanes")) return false;
     if (tr->lanes <= 0) {
       err_codef(p, "sircc.type.vec.lanes.bad", "sircc: type.vec lanes must be > 0");
       return false;
     }
   } else if (strcmp(kind, "sum") == 0) {
     tr->kind = TYPE_SUM;
-    JsonValue* vars = json_obj_get(obj, "variants");
+    JsonValue* vars = json_obj_get_sym(obj, JSON_KEY_VARIANTS);
     if (!vars || vars->type != JSON_ARRAY) {
       err_codef(p, "sircc.type.sum.variants.not_array", "sircc: expected array for type.variants");
       return false;
@@ -741,13 +741,13 @@ static bool parse_type_record(SirProgram* p, JsonValue* obj) {
         err_codef(p, "sircc.type.sum.variant.bad", "sircc: type.variants[%zu] must be an object", i);
         return false;
       }
-      const char* vname = json_get_string(json_obj_get(vo, "name"));
+      const char* vname = json_get_string(json_obj_get_sym(vo, JSON_KEY_NAME));
       if (vname && *vname && !is_ident(vname)) {
         err_codef(p, "sircc.schema.ident.bad", "sircc: type.variants[%zu].name must be an Ident", i);
         return false;
       }
       int64_t vty = 0;
-      JsonValue* tyv = json_obj_get(vo, "ty");
+      JsonValue* tyv = json_obj_get_sym(vo, JSON_KEY_TY);
       if (tyv) {
         if (!sir_intern_id(p, SIR_ID_TYPE, tyv, &vty, "type.variants[i].ty")) return false;
       }
@@ -767,17 +767,17 @@ static bool parse_node_record(SirProgram* p, JsonValue* obj) {
   if (!require_only_keys(p, obj, keys, sizeof(keys) / sizeof(keys[0]), "node record")) return false;
 
   int64_t id = 0;
-  if (!sir_intern_id(p, SIR_ID_NODE, json_obj_get(obj, "id"), &id, "node.id")) return false;
-  const char* tag = must_string(p, json_obj_get(obj, "tag"), "node.tag");
+  if (!sir_intern_id(p, SIR_ID_NODE, json_obj_get_sym(obj, JSON_KEY_ID), &id, "node.id")) return false;
+  const char* tag = must_string(p, json_obj_get_sym(obj, JSON_KEY_TAG), "node.tag");
   if (!tag) return false;
 
   int64_t type_ref = 0;
-  JsonValue* tr = json_obj_get(obj, "type_ref");
+  JsonValue* tr = json_obj_get_sym(obj, JSON_KEY_TYPE_REF);
   if (tr) {
     if (!sir_intern_id(p, SIR_ID_TYPE, tr, &type_ref, "node.type_ref")) return false;
   }
 
-  JsonValue* fields = json_obj_get(obj, "fields");
+  JsonValue* fields = json_obj_get_sym(obj, JSON_KEY_FIELDS);
   if (fields && fields->type != JSON_OBJECT) {
     err_codef(p, "sircc.schema.node.fields.not_object", "sircc: expected object for node.fields");
     return false;
@@ -802,6 +802,111 @@ static bool parse_node_record(SirProgram* p, JsonValue* obj) {
   return true;
 }
 
+void parse_record_begin(SirProgram* p, const char* path, size_t line_no) {
+  p->cur_path = path;
+  p->cur_line = line_no;
+  p->cur_kind = NULL;
+  p->cur_rec_id = -1;
+  p->cur_rec_tag = NULL;
+  p->cur_src_ref = -1;
+  p->cur_loc.unit = NULL;
+  p->cur_loc.line = 0;
+  p->cur_loc.col = 0;
+}
+
+bool parse_record(SirProgram* p, const SirccOptions* opt, JsonValue* root) {
+  if (!must_obj(p, root, "record")) return false;
+
+  const char* ir = must_string(p, json_obj_get_sym(root, JSON_KEY_IR), "record.ir");
+  const char* k = must_string(p, json_obj_get_sym(root, JSON_KEY_K), "record.k");
+  if (!ir || !k) return false;
+  p->cur_kind = k;
+
+  // Best-effort record metadata for diagnostics.
+  JsonValue* idv = json_obj_get_sym(root, JSON_KEY_ID);
+  if (idv) (void)json_get_i64(idv, &p->cur_rec_id);
+  if (strcmp(k, "node") == 0) p->cur_rec_tag = json_get_string(json_obj_get_sym(root, JSON_KEY_TAG));
+  else if (strcmp(k, "instr") == 0) p->cur_rec_tag = json_get_string(json_obj_get_sym(root, JSON_KEY_M));
+  else if (strcmp(k, "dir") == 0) p->cur_rec_tag = json_get_string(json_obj_get_sym(root, JSON_KEY_D));
+
+  JsonValue* src_ref = json_obj_get_sym(root, JSON_KEY_SRC_REF);
+  if (src_ref) {
+    int64_t sid = -1;
+    if (!sir_intern_id(p, SIR_ID_SRC, src_ref, &sid, "src_ref")) return false;
+    p->cur_src_ref = sid;
+  }
+  JsonValue* loc = json_obj_get_sym(root, JSON_KEY_LOC);
+  if (loc && loc->type == JSON_OBJECT) {
+    int64_t l = 0;
+    JsonValue* linev = json_obj_get_sym(loc, JSON_KEY_LINE);
+    if (linev && json_get_i64(linev, &l) && l > 0) {
+      p->cur_loc.line = l;
+      int64_t c = 0;
+      JsonValue* colv = json_obj_get_sym(loc, JSON_KEY_COL);
+      if (colv && json_get_i64(colv, &c) && c > 0) p->cur_loc.col = c;
+      p->cur_loc.unit = json_get_string(json_obj_get_sym(loc, JSON_KEY_UNIT));
+    }
+  }
+
+  if (strcmp(ir, "sir-v1.0") != 0) {
+    err_codef(p, "sircc.schema.ir.unsupported", "sircc: unsupported ir '%s' (expected sir-v1.0)", ir);
+    return false;
+  }
+
+  if (strcmp(k, "meta") == 0) {
+    if (!parse_meta_record(p, opt, root)) return false;
+    if (opt && opt->dump_records) fprintf(stderr, "%s:%zu: meta\n", p->cur_path, p->cur_line);
+    return true;
+  }
+  if (strcmp(k, "src") == 0) {
+    if (!parse_src_record(p, root)) return false;
+    if (opt && opt->dump_records) fprintf(stderr, "%s:%zu: src\n", p->cur_path, p->cur_line);
+    return true;
+  }
+  if (strcmp(k, "diag") == 0) {
+    if (!parse_diag_record(p, root)) return false;
+    if (opt && opt->dump_records) fprintf(stderr, "%s:%zu: diag\n", p->cur_path, p->cur_line);
+    return true;
+  }
+  if (strcmp(k, "sym") == 0) {
+    if (!parse_sym_record(p, root)) return false;
+    if (opt && opt->dump_records) fprintf(stderr, "%s:%zu: sym\n", p->cur_path, p->cur_line);
+    return true;
+  }
+  if (strcmp(k, "type") == 0) {
+    if (!parse_type_record(p, root)) return false;
+    if (opt && opt->dump_records) fprintf(stderr, "%s:%zu: type\n", p->cur_path, p->cur_line);
+    return true;
+  }
+  if (strcmp(k, "node") == 0) {
+    if (!parse_node_record(p, root)) return false;
+    if (opt && opt->dump_records) fprintf(stderr, "%s:%zu: node\n", p->cur_path, p->cur_line);
+    return true;
+  }
+  if (strcmp(k, "ext") == 0) {
+    if (!parse_ext_record(p, root)) return false;
+    if (opt && opt->dump_records) fprintf(stderr, "%s:%zu: ext\n", p->cur_path, p->cur_line);
+    return true;
+  }
+  if (strcmp(k, "label") == 0) {
+    if (!parse_label_record(p, root)) return false;
+    if (opt && opt->dump_records) fprintf(stderr, "%s:%zu: label\n", p->cur_path, p->cur_line);
+    return true;
+  }
+  if (strcmp(k, "instr") == 0) {
+    if (!parse_instr_record(p, opt, root)) return false;
+    return true;
+  }
+  if (strcmp(k, "dir") == 0) {
+    if (!parse_dir_record(p, root)) return false;
+    if (opt && opt->dump_records) fprintf(stderr, "%s:%zu: dir\n", p->cur_path, p->cur_line);
+    return true;
+  }
+
+  err_codef(p, "sircc.schema.record_kind.unknown", "sircc: unknown record kind '%s'", k);
+  return false;
+}
+
 static bool parse_program_file(SirProgram* p, const SirccOptions* opt, const char* path, size_t max_line_bytes, size_t max_records,
                                size_t* records, char** line, size_t* cap, size_t* len) {
   if (!p || !path || !records || !line || !cap || !len) return false;
@@ -824,16 +929,7 @@ static bool parse_program_file(SirProgram* p, const SirccOptions* opt, const cha
       return false;
     }
 
-    p->cur_path = path;
-    p->cur_line = line_no;
-    p->cur_kind = NULL;
-    p->cur_rec_id = -1;
-    p->cur_rec_tag = NULL;
-    p->cur_src_ref = -1;
-    p->cur_loc.unit = NULL;
-    p->cur_loc.line = 0;
-    p->cur_loc.col = 0;
-
+    parse_record_begin(p, path, line_no);
     JsonError jerr = {0};
     JsonValue* root = NULL;
     if (!json_parse(&p->arena, *line, &root, &jerr)) {
@@ -841,137 +937,10 @@ static bool parse_program_file(SirProgram* p, const SirccOptions* opt, const cha
       fclose(f);
       return false;
     }
-    if (!must_obj(p, root, "record")) {
-      fclose(f);
-      return false;
-    }
-
-    const char* ir = must_string(p, json_obj_get(root, "ir"), "record.ir");
-    const char* k = must_string(p, json_obj_get(root, "k"), "record.k");
-    if (!ir || !k) {
-      fclose(f);
-      return false;
-    }
-    p->cur_kind = k;
-
-    // Best-effort record metadata for diagnostics.
-    JsonValue* idv = json_obj_get(root, "id");
-    if (idv) (void)json_get_i64(idv, &p->cur_rec_id);
-    if (strcmp(k, "node") == 0) p->cur_rec_tag = json_get_string(json_obj_get(root, "tag"));
-    else if (strcmp(k, "instr") == 0) p->cur_rec_tag = json_get_string(json_obj_get(root, "m"));
-    else if (strcmp(k, "dir") == 0) p->cur_rec_tag = json_get_string(json_obj_get(root, "d"));
-
-    JsonValue* src_ref = json_obj_get(root, "src_ref");
-    if (src_ref) {
-      int64_t sid = -1;
-      if (!sir_intern_id(p, SIR_ID_SRC, src_ref, &sid, "src_ref")) {
-        fclose(f);
-        return false;
-      }
-      p->cur_src_ref = sid;
-    }
-    JsonValue* loc = json_obj_get(root, "loc");
-    if (loc && loc->type == JSON_OBJECT) {
-      int64_t l = 0;
-      JsonValue* linev = json_obj_get(loc, "line");
-      if (linev && json_get_i64(linev, &l) && l > 0) {
-        p->cur_loc.line = l;
-        int64_t c = 0;
-        JsonValue* colv = json_obj_get(loc, "col");
-        if (colv && json_get_i64(colv, &c) && c > 0) p->cur_loc.col = c;
-        p->cur_loc.unit = json_get_string(json_obj_get(loc, "unit"));
-      }
-    }
-
-    if (strcmp(ir, "sir-v1.0") != 0) {
-      err_codef(p, "sircc.schema.ir.unsupported", "sircc: unsupported ir '%s' (expected sir-v1.0)", ir);
+    if (!parse_record(p, opt, root)) {
       fclose(f);
       return false;
     }
-
-    if (strcmp(k, "meta") == 0) {
-      if (!parse_meta_record(p, opt, root)) {
-        fclose(f);
-        return false;
-      }
-      if (opt && opt->dump_records) fprintf(stderr, "%s:%zu: meta\n", p->cur_path, p->cur_line);
-      continue;
-    }
-    if (strcmp(k, "src") == 0) {
-      if (!parse_src_record(p, root)) {
-        fclose(f);
-        return false;
-      }
-      if (opt && opt->dump_records) fprintf(stderr, "%s:%zu: src\n", p->cur_path, p->cur_line);
-      continue;
-    }
-    if (strcmp(k, "diag") == 0) {
-      if (!parse_diag_record(p, root)) {
-        fclose(f);
-        return false;
-      }
-      if (opt && opt->dump_records) fprintf(stderr, "%s:%zu: diag\n", p->cur_path, p->cur_line);
-      continue;
-    }
-    if (strcmp(k, "sym") == 0) {
-      if (!parse_sym_record(p, root)) {
-        fclose(f);
-        return false;
-      }
-      if (opt && opt->dump_records) fprintf(stderr, "%s:%zu: sym\n", p->cur_path, p->cur_line);
-      continue;
-    }
-    if (strcmp(k, "type") == 0) {
-      if (!parse_type_record(p, root)) {
-        fclose(f);
-        return false;
-      }
-      if (opt && opt->dump_records) fprintf(stderr, "%s:%zu: type\n", p->cur_path, p->cur_line);
-      continue;
-    }
-    if (strcmp(k, "node") == 0) {
-      if (!parse_node_record(p, root)) {
-        fclose(f);
-        return false;
-      }
-      if (opt && opt->dump_records) fprintf(stderr, "%s:%zu: node\n", p->cur_path, p->cur_line);
-      continue;
-    }
-    if (strcmp(k, "ext") == 0) {
-      if (!parse_ext_record(p, root)) {
-        fclose(f);
-        return false;
-      }
-      if (opt && opt->dump_records) fprintf(stderr, "%s:%zu: ext\n", p->cur_path, p->cur_line);
-      continue;
-    }
-    if (strcmp(k, "label") == 0) {
-      if (!parse_label_record(p, root)) {
-        fclose(f);
-        return false;
-      }
-      if (opt && opt->dump_records) fprintf(stderr, "%s:%zu: label\n", p->cur_path, p->cur_line);
-      continue;
-    }
-    if (strcmp(k, "instr") == 0) {
-      if (!parse_instr_record(p, opt, root)) {
-        fclose(f);
-        return false;
-      }
-      continue;
-    }
-    if (strcmp(k, "dir") == 0) {
-      if (!parse_dir_record(p, root)) {
-        fclose(f);
-        return false;
-      }
-      if (opt && opt->dump_records) fprintf(stderr, "%s:%zu: dir\n", p->cur_path, p->cur_line);
-      continue;
-    }
-
-    err_codef(p, "sircc.schema.record_kind.unknown", "sircc: unknown record kind '%s'", k);
-    fclose(f);
-    return false;
   }
   fclose(f);
   if (too_long) {
@@ -982,14 +951,7 @@ static bool parse_program_file(SirProgram* p, const SirccOptions* opt, const cha
   return true;
 }
 
-bool parse_program(SirProgram* p, const SirccOptions* opt, const char* input_path) {
-  p->cur_path = input_path;
-  p->cur_line = 0;
-
-  char* line = NULL;
-  size_t cap = 0;
-  size_t len = 0;
-
+void parse_limits(size_t* out_max_line_bytes, size_t* out_max_records) {
   // Safety limits to keep JSONL ingestion robust under adversarial inputs.
   // These defaults are intentionally high; override via env vars if needed:
   //   SIRCC_MAX_LINE_BYTES, SIRCC_MAX_RECORDS.
@@ -1003,27 +965,11 @@ bool parse_program(SirProgram* p, const SirccOptions* opt, const char* input_pat
   (void)parse_env_u64("SIRCC_MAX_RECORDS", &max_records_u64);
   if (max_line_bytes == 0) max_line_bytes = 16u * 1024u * 1024u;
   if (max_records_u64 == 0) max_records_u64 = 5ull * 1000ull * 1000ull;
-  size_t max_records = (max_records_u64 > (uint64_t)SIZE_MAX) ? SIZE_MAX : (size_t)max_records_u64;
-  size_t records = 0;
-
-  if (opt && opt->prelude_paths && opt->prelude_paths_len) {
-    for (size_t i = 0; i < opt->prelude_paths_len; i++) {
-      const char* path = opt->prelude_paths[i];
-      if (!path || !*path) continue;
-      if (!parse_program_file(p, opt, path, max_line_bytes, max_records, &records, &line, &cap, &len)) {
-        free(line);
-        return false;
-      }
-    }
-  }
-
-  if (!parse_program_file(p, opt, input_path, max_line_bytes, max_records, &records, &line, &cap, &len)) {
-    free(line);
-    return false;
-  }
-
-  free(line);
+  *out_max_line_bytes = max_line_bytes;
+  *out_max_records = (max_records_u64 > (uint64_t)SIZE_MAX) ? SIZE_MAX : (size_t)max_records_u64;
+}
 
+bool parse_check_pending_features(SirProgram* p) {
   for (size_t i = 0; i < p->pending_features_len; i++) {
     const PendingFeatureUse* u = &p->pending_features[i];
     if (!u->need || !u->mnemonic) continue;
@@ -1043,6 +989,38 @@ bool parse_program(SirProgram* p, const SirccOptions* opt, const char* input_pat
     err_codef(p, "sircc.feature.gate", "sircc: mnemonic '%s' requires feature %s (enable via meta.ext.features)", u->mnemonic, u->need);
     return false;
   }
-
   return true;
 }
+
+bool parse_program(SirProgram* p, const SirccOptions* opt, const char* input_path) {
+  p->cur_path = input_path;
+  p->cur_line = 0;
+
+  char* line = NULL;
+  size_t cap = 0;
+  size_t len = 0;
+
+  size_t max_line_bytes = 0;
+  size_t max_records = 0;
+  parse_limits(&max_line_bytes, &max_records);
+  size_t records = 0;
+
+  if (opt && opt->prelude_paths && opt->prelude_paths_len) {
+    for (size_t i = 0; i < opt->prelude_paths_len; i++) {
+      const char* path = opt->prelude_paths[i];
+      if (!path || !*path) continue;
+      if (!parse_program_file(p, opt, path, max_line_bytes, max_records, &records, &line, &cap, &len)) {
+        free(line);
+        return false;
+      }
+    }
+  }
+
+  if (!parse_program_file(p, opt, input_path, max_line_bytes, max_records, &records, &line, &cap, &len)) {
+    free(line);
+    return false;
+  }
+
+  free(line);
+  return parse_check_pending_features(p);
+}
@@ -0,0 +1,640 @@
+// SPDX-FileCopyrightText: 2026 Frogfish
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "compiler_internal.h"
+
+#include <llvm-c/Analysis.h>
+#include <llvm-c/Core.h>
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Streaming compile (--stream).
+//
+// The input is read twice and never held as a whole. The scan keeps every record that is not a
+// node resident, as well as fn and decl.fn nodes; for other nodes it only remembers which segment
+// defines them, what they refer to and whether another segment refers to them. A segment is the
+// run of node records up to and including a fn node, or up to the end of a file, which is how
+// producers lay out a function body. The replay then loads one segment at a time into a scratch
+// arena, validates it, lowers its fn and drops it again. Nodes shared between segments are "kept",
+// together with the nodes they refer to: they are parsed into the long-lived arena and stay
+// loaded. If one of them is used before its definition (or by a sym initializer), all kept nodes
+// are loaded before the replay starts, which stays correct for any record order but only bounds
+// memory for producers that define nodes before using them.
+//
+// Lowered functions accumulate in one module that is written to a temporary object every
+// SIRCC_STREAM_CHUNK_BYTES of node records (64 MiB by default). With more than one object, local
+// fns and sym globals are promoted to hidden `<name>.sircc.stream` symbols, and each global is
+// defined by the first object that uses it and declared by the others.
+
+#define STREAM_DEFINED 1u
+#define STREAM_FWD 2u  // referenced before its definition, from segment seg[id]
+#define STREAM_KEEP 4u // parsed into the long-lived arena and never released
+#define STREAM_RESIDENT 8u // fn / decl.fn: loaded by the scan (its refs are only needed in its own segment)
+
+typedef struct SirStream {
+  Arena parked; // whichever of the scratch / long-lived arenas is not installed as p->arena
+  bool scratch; // p->arena is the scratch arena
+
+  uint8_t* flags; // per node id: STREAM_*
+  uint32_t* seg;  // per node id: defining segment (or first referencing one while STREAM_FWD)
+  size_t* ref_off; // per node id: its node refs are refs[ref_off .. ref_off + ref_len)
+  uint32_t* ref_len;
+  size_t ids_cap;
+  int64_t* refs;
+  size_t refs_len;
+  size_t refs_cap;
+  uint32_t cur_seg;
+  bool preload;
+
+  NodeRec** fns;   // fn nodes in input order
+  bool* chunk_end; // per fns[i]: write the module out after lowering it
+  size_t fns_len;
+  size_t fns_cap;
+  size_t fn_next;
+  size_t chunks;
+  uint64_t chunk_bytes;
+  uint64_t acc_bytes;
+
+  NodeRec** set; // nodes of the segment being replayed
+  size_t set_len;
+  size_t set_cap;
+
+  char* line;
+  size_t line_cap;
+  size_t max_line_bytes;
+  size_t max_records;
+  size_t records;
+
+  // stream_emit_objs
+  bool lowering;
+  LLVMContextRef ctx;
+  LLVMModuleRef mod;
+  const char* triple;
+  bool* sym_defined; // per sym id: an earlier object defines its global
+  char** objs;
+  size_t objs_len;
+  size_t objs_cap;
+} SirStream;
+
+typedef struct StreamPass {
+  bool (*line)(SirProgram* p, SirStream* s, const char* line, size_t len, JsonValue* root);
+  bool (*file_end)(SirProgram* p, SirStream* s);
+} StreamPass;
+
+static void use_scratch(SirProgram* p, SirStream* s) {
+  if (s->scratch) return;
+  Arena a = p->arena;
+  p->arena = s->parked;
+  s->parked = a;
+  s->scratch = true;
+  p->keep_arena = &s->parked;
+}
+
+static void use_keep(SirProgram* p, SirStream* s) {
+  if (!s->scratch) return;
+  Arena a = p->arena;
+  p->arena = s->parked;
+  s->parked = a;
+  s->scratch = false;
+  p->keep_arena = NULL;
+}
+
+static void drop_scratch(SirProgram* p, SirStream* s) {
+  Arena* a = s->scratch ? &p->arena : &s->parked;
+  arena_free(a);
+  arena_init(a);
+}
+
+static bool oom(SirProgram* p) {
+  bump_exit_code(p, SIRCC_EXIT_INTERNAL);
+  err_codef(p, "sircc.oom", "sircc: out of memory");
+  return false;
+}
+
+static bool ids_reserve(SirStream* s, int64_t id) {
+  if (id < 0) return false;
+  if ((size_t)id < s->ids_cap) return true;
+  size_t cap = s->ids_cap ? s->ids_cap : 1024;
+  while (cap <= (size_t)id) cap *= 2;
+  uint8_t* flags = (uint8_t*)realloc(s->flags, cap);
+  if (!flags) return false;
+  s->flags = flags;
+  uint32_t* seg = (uint32_t*)realloc(s->seg, cap * sizeof(uint32_t));
+  if (!seg) return false;
+  s->seg = seg;
+  size_t* ref_off = (size_t*)realloc(s->ref_off, cap * sizeof(size_t));
+  if (!ref_off) return false;
+  s->ref_off = ref_off;
+  uint32_t* ref_len = (uint32_t*)realloc(s->ref_len, cap * sizeof(uint32_t));
+  if (!ref_len) return false;
+  s->ref_len = ref_len;
+  const size_t more = cap - s->ids_cap;
+  memset(s->flags + s->ids_cap, 0, more);
+  memset(s->seg + s->ids_cap, 0, more * sizeof(uint32_t));
+  memset(s->ref_off + s->ids_cap, 0, more * sizeof(size_t));
+  memset(s->ref_len + s->ids_cap, 0, more * sizeof(uint32_t));
+  s->ids_cap = cap;
+  return true;
+}
+
+static bool is_node_record(const JsonValue* root) {
+  const char* k = json_get_string(json_obj_get_sym(root, JSON_KEY_K));
+  return k && strcmp(k, "node") == 0;
+}
+
+// Node id of a record that the scan already accepted.
+static int64_t record_node_id(SirProgram* p, const JsonValue* root) {
+  int64_t id = 0;
+  (void)sir_intern_id(p, SIR_ID_NODE, json_obj_get_sym(root, JSON_KEY_ID), &id, "node.id");
+  return id;
+}
+
+// Parses `line` again into the long-lived arena and records it.
+static bool record_kept(SirProgram* p, SirStream* s, const char* line, const SirccOptions* opt, JsonValue** out_root) {
+  use_keep(p, s);
+  JsonError jerr = {0};
+  JsonValue* root = NULL;
+  const bool ok = json_parse(&p->arena, line, &root, &jerr) && parse_record(p, opt, root);
+  use_scratch(p, s);
+  if (out_root) *out_root = root;
+  return ok;
+}
+
+// ---- scan ----
+
+// `from` is the referencing segment, 0 for a sym initializer (used from any segment).
+static bool note_ref(SirStream* s, int64_t id, uint32_t from) {
+  if (!ids_reserve(s, id)) return false;
+  if (from != 0) {
+    if (s->refs_len == s->refs_cap) {
+      const size_t cap = s->refs_cap ? s->refs_cap * 2 : 4096;
+      int64_t* refs = (int64_t*)realloc(s->refs, cap * sizeof(int64_t));
+      if (!refs) return false;
+      s->refs = refs;
+      s->refs_cap = cap;
+    }
+    s->refs[s->refs_len++] = id;
+  }
+  uint8_t f = s->flags[id];
+  if (from == 0) {
+    f |= STREAM_KEEP;
+    s->preload = true;
+  } else if (f & (STREAM_DEFINED | STREAM_FWD)) {
+    if (s->seg[id] != from) f |= STREAM_KEEP;
+  } else {
+    f |= STREAM_FWD;
+    s->seg[id] = from;
+  }
+  s->flags[id] = f;
+  return true;
+}
+
+static void note_def(SirStream* s, int64_t id, bool resident) {
+  uint8_t f = s->flags[id];
+  if ((f & STREAM_FWD) && s->seg[id] != s->cur_seg) f |= STREAM_KEEP;
+  if ((f & STREAM_KEEP) && !resident) s->preload = true; // already needed by an earlier segment
+  if (resident) f |= STREAM_KEEP | STREAM_RESIDENT;
+  f = (uint8_t)((f & ~STREAM_FWD) | STREAM_DEFINED);
+  s->flags[id] = f;
+  s->seg[id] = s->cur_seg;
+}
+
+static bool scan_refs(SirProgram* p, SirStream* s, const JsonValue* v, uint32_t from) {
+  if (!v) return true;
+  if (v->type == JSON_ARRAY) {
+    for (size_t i = 0; i < v->v.arr.len; i++) {
+      if (!scan_refs(p, s, v->v.arr.items[i], from)) return false;
+    }
+    return true;
+  }
+  if (v->type != JSON_OBJECT) return true;
+  int64_t id = 0;
+  if (sir_node_ref_quiet(p, v, &id)) return note_ref(s, id, from);
+  for (size_t i = 0; i < v->v.obj.len; i++) {
+    if (!scan_refs(p, s, v->v.obj.items[i].value, from)) return false;
+  }
+  return true;
+}
+
+static bool fns_push(SirStream* s, NodeRec* fn) {
+  if (s->fns_len == s->fns_cap) {
+    const size_t cap = s->fns_cap ? s->fns_cap * 2 : 64;
+    NodeRec** fns = (NodeRec**)realloc(s->fns, cap * sizeof(NodeRec*));
+    if (!fns) return false;
+    s->fns = fns;
+    bool* ends = (bool*)realloc(s->chunk_end, cap * sizeof(bool));
+    if (!ends) return false;
+    s->chunk_end = ends;
+    s->fns_cap = cap;
+  }
+  s->chunk_end[s->fns_len] = false;
+  s->fns[s->fns_len++] = fn;
+  return true;
+}
+
+static bool scan_line(SirProgram* p, SirStream* s, const char* line, size_t len, JsonValue* root) {
+  const char* k = json_get_string(json_obj_get_sym(root, JSON_KEY_K));
+  const bool node = k && strcmp(k, "node") == 0;
+  const char* tag = node ? json_get_string(json_obj_get_sym(root, JSON_KEY_TAG)) : NULL;
+  const bool is_fn = tag && strcmp(tag, "fn") == 0;
+  const bool resident = !node || is_fn || (tag && strcmp(tag, "decl.fn") == 0);
+
+  bool ok = resident ? record_kept(p, s, line, p->opt, &root) : parse_record(p, p->opt, root);
+  if (ok && !node) {
+    if (strcmp(k, "sym") == 0 && !scan_refs(p, s, json_obj_get_sym(root, JSON_KEY_VALUE), 0)) ok = oom(p);
+  } else if (ok) {
+    const int64_t id = record_node_id(p, root);
+    if (!ids_reserve(s, id)) {
+      ok = oom(p);
+    } else if (s->flags[id] & STREAM_DEFINED) {
+      err_codef(p, "sircc.schema.duplicate_id", "sircc: duplicate node id %lld", (long long)id);
+      ok = false;
+    } else {
+      NodeRec* n = p->nodes[id];
+      if (!resident) p->nodes[id] = NULL;
+      note_def(s, id, resident);
+      const size_t refs_from = s->refs_len;
+      if (!scan_refs(p, s, root, s->cur_seg)) ok = oom(p);
+      s->ref_off[id] = refs_from;
+      s->ref_len[id] = (uint32_t)(s->refs_len - refs_from);
+
+      s->acc_bytes += len;
+      if (ok && is_fn) {
+        if (!fns_push(s, n)) ok = oom(p);
+        else if (s->acc_bytes >= s->chunk_bytes) {
+          s->chunk_end[s->fns_len - 1] = true;
+          s->acc_bytes = 0;
+        }
+        s->cur_seg++;
+      }
+    }
+  }
+  drop_scratch(p, s);
+  return ok;
+}
+
+static bool scan_file_end(SirProgram* p, SirStream* s) {
+  (void)p;
+  s->cur_seg++;
+  return true;
+}
+
+// A kept node is lowered outside its own segment, so everything it refers to must stay loaded too.
+static bool keep_closure(SirStream* s) {
+  int64_t* work = (int64_t*)malloc((s->ids_cap ? s->ids_cap : 1) * sizeof(int64_t));
+  if (!work) return false;
+  size_t len = 0;
+  for (size_t id = 0; id < s->ids_cap; id++) {
+    const uint8_t f = s->flags[id];
+    if ((f & STREAM_KEEP) && (f & STREAM_DEFINED) && !(f & STREAM_RESIDENT)) work[len++] = (int64_t)id;
+  }
+  while (len) {
+    const int64_t id = work[--len];
+    for (uint32_t i = 0; i < s->ref_len[id]; i++) {
+      const int64_t to = s->refs[s->ref_off[id] + i];
+      if (s->flags[to] & STREAM_KEEP) continue;
+      s->flags[to] |= STREAM_KEEP;
+      if (s->flags[to] & STREAM_DEFINED) work[len++] = to;
+    }
+  }
+  free(work);
+  return true;
+}
+
+// ---- preload / replay ----
+
+static bool preload_line(SirProgram* p, SirStream* s, const char* line, size_t len, JsonValue* root) {
+  (void)len;
+  bool ok = true;
+  if (is_node_record(root)) {
+    const int64_t id = record_node_id(p, root);
+    if ((s->flags[id] & STREAM_KEEP) && !p->nodes[id]) ok = record_kept(p, s, line, NULL, NULL);
+  }
+  drop_scratch(p, s);
+  return ok;
+}
+
+static bool preload_file_end(SirProgram* p, SirStream* s) {
+  (void)p;
+  (void)s;
+  return true;
+}
+
+static bool open_module(SirProgram* p, SirStream* s) {
+  s->mod = LLVMModuleCreateWithNameInContext("sir", s->ctx);
+  return init_target_for_module(p, s->mod, s->triple) && lower_fn_protos(p, s->ctx, s->mod);
+}
+
+static bool promote(LLVMValueRef v) {
+  static const char sfx[] = ".sircc.stream";
+  size_t n = 0;
+  const char* nm = LLVMGetValueName2(v, &n);
+  char* name = (char*)malloc(n + sizeof(sfx));
+  if (!name) return false;
+  memcpy(name, nm, n);
+  memcpy(name + n, sfx, sizeof(sfx));
+  LLVMSetValueName2(v, name, n + sizeof(sfx) - 1);
+  free(name);
+  LLVMSetLinkage(v, LLVMExternalLinkage);
+  LLVMSetVisibility(v, LLVMHiddenVisibility);
+  return true;
+}
+
+// Links the module up with the objects written before and after it.
+static bool finish_module(SirProgram* p, SirStream* s) {
+  const bool promoting = s->chunks > 1;
+  for (LLVMValueRef fn = LLVMGetFirstFunction(s->mod); fn; fn = LLVMGetNextFunction(fn)) {
+    if (promoting && LLVMGetLinkage(fn) == LLVMInternalLinkage && !promote(fn)) return oom(p);
+    if (LLVMCountBasicBlocks(fn) == 0) LLVMSetLinkage(fn, LLVMExternalLinkage); // lowered into another object
+  }
+  for (size_t i = 0; i < p->syms_cap; i++) {
+    const SymRec* sym = p->syms[i];
+    if (!sym || !sym->name) continue;
+    LLVMValueRef g = LLVMGetNamedGlobal(s->mod, sym->name);
+    if (!g || !LLVMGetInitializer(g)) continue;
+    if (promoting && LLVMGetLinkage(g) == LLVMInternalLinkage && !promote(g)) return oom(p);
+    if (!s->sym_defined[i]) {
+      s->sym_defined[i] = true;
+    } else if (!declare_global(s->mod, g)) {
+      return oom(p);
+    }
+  }
+  return true;
+}
+
+static bool flush_module(SirProgram* p, SirStream* s) {
+  if (!s->mod && !open_module(p, s)) return false;
+  bool ok = finish_module(p, s);
+
+  char* verr = NULL;
+  if (ok && LLVMVerifyModule(s->mod, LLVMReturnStatusAction, &verr) != 0) {
+    err_codef(p, "sircc.llvm.verify_failed", "sircc: LLVM verification failed: %s", verr ? verr : "(unknown)");
+    ok = false;
+  }
+  LLVMDisposeMessage(verr);
+  ok = ok && optimize_module(p, s->mod, s->triple);
+
+  char tmp_obj[4096];
+  if (ok && !make_tmp_obj(tmp_obj, sizeof(tmp_obj))) {
+    bump_exit_code(p, SIRCC_EXIT_INTERNAL);
+    err_codef(p, "sircc.tmp_obj.create_failed", "sircc: failed to create temporary object path");
+    ok = false;
+  }
+  if (ok && s->objs_len == s->objs_cap) {
+    const size_t cap = s->objs_cap ? s->objs_cap * 2 : 8;
+    char** objs = (char**)realloc(s->objs, cap * sizeof(char*));
+    if (objs) {
+      s->objs = objs;
+      s->objs_cap = cap;
+    }
+  }
+  if (ok) {
+    char* path = s->objs_len < s->objs_cap ? strdup(tmp_obj) : NULL;
+    if (!path) {
+      remove(tmp_obj);
+      ok = oom(p);
+    } else {
+      s->objs[s->objs_len++] = path; // unlinked by free_obj_paths, also on failure
+      ok = emit_module_obj(p, s->mod, s->triple, path);
+    }
+  }
+
+  LLVMDisposeModule(s->mod);
+  s->mod = NULL;
+  for (size_t i = 0; i < p->nodes_cap; i++) {
+    if (!p->nodes[i]) continue;
+    p->nodes[i]->llvm_value = NULL;
+    p->nodes[i]->resolving = false;
+  }
+  return ok;
+}
+
+static bool segment_end(SirProgram* p, SirStream* s, NodeRec* fn) {
+  // The set is checked and lowered as a whole; don't point diagnostics at its last line.
+  parse_record_begin(p, p->cur_path, 0);
+
+  bool ok = validate_node_set(p, s->set, s->set_len);
+  if (ok && fn && s->lowering) {
+    if (!s->mod) ok = open_module(p, s);
+    ok = ok && lower_fn_streamed(p, s->ctx, s->mod, fn);
+    if (ok && s->fn_next < s->fns_len && s->chunk_end[s->fn_next]) ok = flush_module(p, s);
+  }
+  if (fn) s->fn_next++;
+
+  for (size_t i = 0; i < s->set_len; i++) {
+    const int64_t id = s->set[i]->id;
+    if (!(s->flags[id] & STREAM_KEEP)) p->nodes[id] = NULL;
+  }
+  s->set_len = 0;
+  drop_scratch(p, s);
+  return ok;
+}
+
+static bool replay_line(SirProgram* p, SirStream* s, const char* line, size_t len, JsonValue* root) {
+  (void)len;
+  if (!is_node_record(root)) return true; // resident since the scan
+  const int64_t id = record_node_id(p, root);
+  NodeRec* n = p->nodes[id];
+  if (!n) {
+    const bool ok = (s->flags[id] & STREAM_KEEP) ? record_kept(p, s, line, NULL, NULL) : parse_record(p, NULL, root);
+    if (!ok) return false;
+    n = p->nodes[id];
+  }
+  if (s->set_len == s->set_cap) {
+    const size_t cap = s->set_cap ? s->set_cap * 2 : 256;
+    NodeRec** set = (NodeRec**)realloc(s->set, cap * sizeof(NodeRec*));
+    if (!set) return oom(p);
+    s->set = set;
+    s->set_cap = cap;
+  }
+  s->set[s->set_len++] = n;
+  return strcmp(n->tag, "fn") == 0 ? segment_end(p, s, n) : true;
+}
+
+static bool replay_file_end(SirProgram* p, SirStream* s) {
+  if (s->set_len) return segment_end(p, s, NULL);
+  drop_scratch(p, s);
+  return true;
+}
+
+// ---- driver ----
+
+static bool stream_file(SirProgram* p, SirStream* s, const StreamPass* pass, const char* path) {
+  FILE* f = fopen(path, "rb");
+  if (!f) {
+    err_codef(p, "sircc.io.open_failed", "sircc: failed to open: %s", strerror(errno));
+    return false;
+  }
+
+  size_t line_no = 0;
+  size_t len = 0;
+  bool too_long = false;
+  bool ok = true;
+  while (ok && read_line(f, &s->line, &s->line_cap, &len, s->max_line_bytes, &too_long)) {
+    line_no++;
+    if (len == 0 || is_blank_line(s->line)) continue;
+    s->records++;
+    if (s->max_records && s->records > s->max_records) {
+      err_codef(p, "sircc.limit.records", "sircc: input exceeded record limit (%zu) (override via SIRCC_MAX_RECORDS)",
+                s->max_records);
+      ok = false;
+      break;
+    }
+
+    parse_record_begin(p, path, line_no);
+    use_scratch(p, s);
+    JsonError jerr = {0};
+    JsonValue* root = NULL;
+    if (!json_parse(&p->arena, s->line, &root, &jerr)) {
+      err_codef(p, "sircc.json.parse_error", "sircc: JSON parse error at column %zu: %s", jerr.offset + 1, jerr.msg ? jerr.msg : "unknown");
+      ok = false;
+      break;
+    }
+    ok = pass->line(p, s, s->line, len, root);
+  }
+  fclose(f);
+  if (ok && too_long) {
+    err_codef(p, "sircc.limit.line_too_long", "sircc: JSONL line exceeded limit (%zu bytes) (override via SIRCC_MAX_LINE_BYTES)",
+              s->max_line_bytes);
+    ok = false;
+  }
+  return ok && pass->file_end(p, s);
+}
+
+static bool stream_pass(SirProgram* p, SirStream* s, const StreamPass* pass) {
+  const SirccOptions* opt = p->opt;
+  s->records = 0;
+  bool ok = true;
+  if (opt->prelude_paths && opt->prelude_paths_len) {
+    for (size_t i = 0; ok && i < opt->prelude_paths_len; i++) {
+      const char* path = opt->prelude_paths[i];
+      if (!path || !*path) continue;
+      ok = stream_file(p, s, pass, path);
+    }
+  }
+  ok = ok && stream_file(p, s, pass, opt->input_path);
+  use_keep(p, s);
+  return ok;
+}
+
+static bool stream_unsupported(SirProgram* p, const char* what) {
+  err_codef(p, "sircc.stream.unsupported", "sircc: --stream does not support %s", what);
+  return false;
+}
+
+bool stream_parse_program(SirProgram* p) {
+  const SirccOptions* opt = p->opt;
+  p->cur_path = opt->input_path;
+  p->cur_line = 0;
+
+  if (opt->lower_hl) return stream_unsupported(p, "--lower-hl");
+  if (opt->jobs > 1) return stream_unsupported(p, "-j");
+  if (!opt->verify_only && opt->emit != SIRCC_EMIT_EXE) {
+    return stream_unsupported(p, "--emit-llvm/--emit-obj/--emit-zasm (it links an executable or runs --verify-only)");
+  }
+
+  SirStream* s = (SirStream*)calloc(1, sizeof(SirStream));
+  if (!s) return oom(p);
+  p->stream = s;
+  arena_init(&s->parked);
+  s->cur_seg = 1;
+  s->chunk_bytes = 64ull * 1024ull * 1024ull;
+  uint64_t chunk_bytes = 0;
+  if (parse_env_u64("SIRCC_STREAM_CHUNK_BYTES", &chunk_bytes) && chunk_bytes) s->chunk_bytes = chunk_bytes;
+  parse_limits(&s->max_line_bytes, &s->max_records);
+
+  static const StreamPass scan = {scan_line, scan_file_end};
+  if (!stream_pass(p, s, &scan)) return false;
+  if (s->fns_len) s->chunk_end[s->fns_len - 1] = true;
+  for (size_t i = 0; i < s->fns_len; i++) s->chunks += s->chunk_end[i] ? 1u : 0u;
+  if (!keep_closure(s)) return oom(p);
+  free(s->refs);
+  free(s->ref_off);
+  free(s->ref_len);
+  s->refs = NULL;
+  s->ref_off = NULL;
+  s->ref_len = NULL;
+
+  parse_record_begin(p, opt->input_path, 0);
+  if (!parse_check_pending_features(p)) return false;
+  if (p->feat_sem_v1 && !opt->verify_only) {
+    return stream_unsupported(p, "sem:v1 codegen (legalize with --lower-hl --emit-sir-core first)");
+  }
+
+  static const StreamPass preload = {preload_line, preload_file_end};
+  if (s->preload && !stream_pass(p, s, &preload)) return false;
+  parse_record_begin(p, opt->input_path, 0);
+  return true;
+}
+
+bool stream_verify(SirProgram* p) {
+  SirStream* s = p->stream;
+  static const StreamPass replay = {replay_line, replay_file_end};
+  s->lowering = false;
+  s->fn_next = 0;
+  const bool ok = stream_pass(p, s, &replay);
+  parse_record_begin(p, p->opt->input_path, 0);
+  return ok;
+}
+
+bool stream_emit_objs(SirProgram* p, const char* triple, char*** out_paths, size_t* out_len) {
+  SirStream* s = p->stream;
+  *out_paths = NULL;
+  *out_len = 0;
+  s->sym_defined = (bool*)calloc(p->syms_cap ? p->syms_cap : 1, sizeof(bool));
+  if (!s->sym_defined) return oom(p);
+
+  static const StreamPass replay = {replay_line, replay_file_end};
+  s->lowering = true;
+  s->fn_next = 0;
+  s->triple = triple;
+  s->ctx = LLVMContextCreate();
+  bool ok = stream_pass(p, s, &replay);
+  parse_record_begin(p, p->opt->input_path, 0);
+  if (ok && (s->mod || !s->objs_len)) ok = flush_module(p, s); // unit without fns: still one (empty) object
+  if (s->mod) {
+    LLVMDisposeModule(s->mod);
+    s->mod = NULL;
+  }
+  for (size_t i = 0; i < p->nodes_cap; i++) {
+    if (p->nodes[i]) p->nodes[i]->llvm_value = NULL;
+  }
+  for (size_t i = 0; i < p->types_cap; i++) {
+    if (p->types[i]) p->types[i]->llvm = NULL;
+  }
+  LLVMContextDispose(s->ctx);
+  s->ctx = NULL;
+
+  if (!ok) return false;
+  *out_paths = s->objs;
+  *out_len = s->objs_len;
+  s->objs = NULL;
+  s->objs_len = 0;
+  s->objs_cap = 0;
+  return true;
+}
+
+void stream_free(SirProgram* p) {
+  SirStream* s = p->stream;
+  if (!s) return;
+  use_keep(p, s);
+  free_obj_paths(s->objs, s->objs_len);
+  free(s->flags);
+  free(s->seg);
+  free(s->ref_off);
+  free(s->ref_len);
+  free(s->refs);
+  free(s->fns);
+  free(s->chunk_end);
+  free(s->set);
+  free(s->line);
+  free(s->sym_defined);
+  arena_free(&s->parked);
+  free(s);
+  p->stream = NULL;
+}
@@ -3,8 +3,105 @@
 
 #include "compiler_internal.h"
 
+#include <stdlib.h>
 #include <string.h>
 
+static uint64_t name_hash(const char* s) {
+  // FNV-1a 64-bit
+  uint64_t h = 1469598103934665603ull;
+  for (const unsigned char* c = (const unsigned char*)s; *c; c++) {
+    h ^= (uint64_t)*c;
+    h *= 1099511628211ull;
+  }
+  return h ? h : 1; // 0 marks an empty slot
+}
+
+static bool namemap_grow(SirNameMap* m) {
+  const size_t new_cap = m->cap ? m->cap * 2 : 64;
+  SirNameMapEntry* ne = (SirNameMapEntry*)calloc(new_cap, sizeof(SirNameMapEntry));
+  if (!ne) return false;
+  for (size_t i = 0; i < m->cap; i++) {
+    const SirNameMapEntry* e = &m->entries[i];
+    if (!e->hash) continue;
+    size_t idx = (size_t)e->hash & (new_cap - 1);
+    while (ne[idx].hash) idx = (idx + 1) & (new_cap - 1);
+    ne[idx] = *e;
+  }
+  free(m->entries);
+  m->entries = ne;
+  m->cap = new_cap;
+  return true;
+}
+
+// Inserts name -> rec unless the name is already present (callers insert in id order).
+static bool namemap_put_first(SirNameMap* m, const char* name, void* rec) {
+  if ((m->len + 1) * 10 >= m->cap * 7) {
+    if (!namemap_grow(m)) return false;
+  }
+  const uint64_t h = name_hash(name);
+  size_t idx = (size_t)h & (m->cap - 1);
+  for (;;) {
+    SirNameMapEntry* e = &m->entries[idx];
+    if (!e->hash) {
+      *e = (SirNameMapEntry){.hash = h, .name = name, .rec = rec};
+      m->len++;
+      return true;
+    }
+    if (e->hash == h && strcmp(e->name, name) == 0) return true;
+    idx = (idx + 1) & (m->cap - 1);
+  }
+}
+
+static void* namemap_get(const SirNameMap* m, const char* name) {
+  if (!m->cap) return NULL;
+  const uint64_t h = name_hash(name);
+  size_t idx = (size_t)h & (m->cap - 1);
+  for (;;) {
+    const SirNameMapEntry* e = &m->entries[idx];
+    if (!e->hash) return NULL;
+    if (e->hash == h && strcmp(e->name, name) == 0) return e->rec;
+    idx = (idx + 1) & (m->cap - 1);
+  }
+}
+
+static void namemap_free(SirNameMap* m) {
+  free(m->entries);
+  memset(m, 0, sizeof(*m));
+}
+
+void sir_names_free(SirProgram* p) {
+  if (!p) return;
+  namemap_free(&p->fn_by_name);
+  namemap_free(&p->decl_fn_by_name);
+  namemap_free(&p->sym_by_name);
+  p->names_built = false;
+}
+
+bool sir_names_build(SirProgram* p) {
+  if (!p) return false;
+  sir_names_free(p);
+  for (size_t i = 0; i < p->syms_cap; i++) {
+    SymRec* s = p->syms[i];
+    if (!s || !s->name) continue;
+    if (!namemap_put_first(&p->sym_by_name, s->name, s)) goto oom;
+  }
+  for (size_t i = 0; i < p->nodes_cap; i++) {
+    NodeRec* n = p->nodes[i];
+    if (!n || !n->tag || !n->fields) continue;
+    const SirNodeTag t = sir_node_tag(p, n);
+    if (t != SIR_NODE_FN && t != SIR_NODE_DECL_FN) continue;
+    const char* nm = sir_node_name(p, n);
+    if (!nm) continue;
+    if (!namemap_put_first(t == SIR_NODE_FN ? &p->fn_by_name : &p->decl_fn_by_name, nm, n)) goto oom;
+  }
+  p->names_built = true;
+  return true;
+
+oom:
+  sir_names_free(p);
+  return false;
+}
+
 TypeRec* get_type(SirProgram* p, int64_t id) {
   if (id < 0 || (size_t)id >= p->types_cap) return NULL;
   return p->types[id];
@@ -17,6 +114,7 @@ SymRec* get_sym(SirProgram* p, int64_t id) {
 
 SymRec* find_sym_by_name(SirProgram* p, const char* name) {
   if (!p || !name) return NULL;
+  if (p->names_built) return (SymRec*)namemap_get(&p->sym_by_name, name);
   for (size_t i = 0; i < p->syms_cap; i++) {
     SymRec* s = p->syms[i];
     if (!s || !s->name) continue;
@@ -32,10 +130,11 @@ NodeRec* get_node(SirProgram* p, int64_t id) {
 
 NodeRec* find_fn_node_by_name(SirProgram* p, const char* name) {
   if (!p || !name) return NULL;
+  if (p->names_built) return (NodeRec*)namemap_get(&p->fn_by_name, name);
   for (size_t i = 0; i < p->nodes_cap; i++) {
     NodeRec* n = p->nodes[i];
     if (!n || !n->tag || strcmp(n->tag, "fn") != 0 || !n->fields) continue;
-    const char* nm = json_get_string(json_obj_get(n->fields, "name"));
+    const char* nm = json_get_string(json_obj_get_sym(n->fields, JSON_KEY_NAME));
     if (!nm) continue;
     if (strcmp(nm, name) == 0) return n;
   }
@@ -44,10 +143,11 @@ NodeRec* find_fn_node_by_name(SirProgram* p, const char* name) {
 
 NodeRec* find_decl_fn_node_by_name(SirProgram* p, const char* name) {
   if (!p || !name) return NULL;
+  if (p->names_built) return (NodeRec*)namemap_get(&p->decl_fn_by_name, name);
   for (size_t i = 0; i < p->nodes_cap; i++) {
     NodeRec* n = p->nodes[i];
     if (!n || !n->tag || strcmp(n->tag, "decl.fn") != 0 || !n->fields) continue;
-    const char* nm = json_get_string(json_obj_get(n->fields, "name"));
+    const char* nm = json_get_string(json_obj_get_sym(n->fields, JSON_KEY_NAME));
     if (!nm) continue;
     if (strcmp(nm, name) == 0) return n;
   }
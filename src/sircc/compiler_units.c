@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: 2026 Frogfish
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "compiler_internal.h"
+#include "compiler_lower_hl.h"
+
+#include <llvm-c/Core.h>
+#include <llvm-c/Linker.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+// Multi-unit compile: `sircc a.sir.jsonl b.sir.jsonl ... -o out`.
+//
+// Each extra unit is parsed, validated and lowered on its own (ids are per unit), with the
+// preludes, into a module in the first unit's LLVM context. The modules are then linked in
+// process with LLVM's IR linker: public fns and syms resolve across units, local ones are renamed
+// apart on collision, and the rest of the pipeline (-O, -j, --emit-*, the final link) runs once on
+// the linked module. Units are lowered one after another; -j N parallelizes the linked module.
+
+typedef struct UnitsLinkDiag {
+  char msg[1024];
+  bool error;
+} UnitsLinkDiag;
+
+static void link_diag(LLVMDiagnosticInfoRef di, void* ctx) {
+  UnitsLinkDiag* d = (UnitsLinkDiag*)ctx;
+  if (LLVMGetDiagInfoSeverity(di) != LLVMDSError || d->error) return;
+  char* desc = LLVMGetDiagInfoDescription(di);
+  snprintf(d->msg, sizeof(d->msg), "%s", desc ? desc : "(unknown)");
+  LLVMDisposeMessage(desc);
+  d->error = true;
+}
+
+bool units_check_options(SirProgram* p) {
+  const SirccOptions* opt = p->opt;
+  if (!opt->extra_input_paths_len) return true;
+  const char* what = NULL;
+  if (opt->stream) what = "--stream";
+  else if (opt->cache_dir) what = "--cache-dir";
+  else if (opt->lower_hl) what = "--lower-hl";
+  else if (opt->emit == SIRCC_EMIT_ZASM_IR && !opt->verify_only) what = "--emit-zasm";
+  if (!what) return true;
+  err_codef(p, "sircc.units.unsupported", "sircc: %s takes a single input (got %zu)", what, opt->extra_input_paths_len + 1);
+  return false;
+}
+
+// Parses and validates one extra unit into `q` (and lowers sem:v1 when `lower`).
+static bool unit_front(SirProgram* q, const char* path, bool lower) {
+  if (!parse_program(q, q->opt, path)) return false;
+  if (!sir_nodes_build(q) || !sir_names_build(q)) {
+    bump_exit_code(q, SIRCC_EXIT_INTERNAL);
+    err_codef(q, "sircc.oom", "sircc: out of memory decoding nodes");
+    return false;
+  }
+  if (!validate_program(q)) return false;
+  if (lower && q->feat_sem_v1) {
+    if (!lower_hl_in_place(q)) return false;
+    if (!sir_nodes_build(q) || !sir_names_build(q)) {
+      bump_exit_code(q, SIRCC_EXIT_INTERNAL);
+      err_codef(q, "sircc.oom", "sircc: out of memory decoding nodes");
+      return false;
+    }
+  }
+  // As for the first unit: later errors should not point at the unit's last line.
+  q->cur_path = path;
+  q->cur_line = 0;
+  q->cur_src_ref = -1;
+  q->cur_loc.unit = NULL;
+  q->cur_loc.line = 0;
+  q->cur_loc.col = 0;
+  return true;
+}
+
+static void unit_done(SirProgram* p, SirProgram* q, bool ok) {
+  if (!ok) bump_exit_code(p, q->exit_code);
+  program_free(q);
+}
+
+bool units_verify(SirProgram* p) {
+  const SirccOptions* opt = p->opt;
+  bool ok = true;
+  for (size_t i = 0; i < opt->extra_input_paths_len; i++) {
+    SirProgram q;
+    program_init(&q, opt);
+    const bool unit_ok = unit_front(&q, opt->extra_input_paths[i], false);
+    unit_done(p, &q, unit_ok);
+    ok = ok && unit_ok;
+  }
+  return ok;
+}
+
+bool units_link(SirProgram* p, LLVMContextRef ctx, LLVMModuleRef mod, const char* triple) {
+  const SirccOptions* opt = p->opt;
+  if (!opt->extra_input_paths_len) return true;
+  if (!lower_public_syms(p, ctx, mod)) return false;
+  for (size_t i = 0; i < opt->extra_input_paths_len; i++) {
+    const char* path = opt->extra_input_paths[i];
+    SirProgram q;
+    program_init(&q, opt);
+    bool ok = unit_front(&q, path, true);
+    if (ok && !opt->target_triple && q.target_triple && strcmp(q.target_triple, triple) != 0) {
+      err_codef(&q, "sircc.units.triple_mismatch", "sircc: unit targets %s, but %s targets %s", q.target_triple,
+                opt->input_path, triple);
+      ok = false;
+    }
+
+    LLVMModuleRef unit = ok ? LLVMModuleCreateWithNameInContext(path, ctx) : NULL;
+    ok = ok && init_target_for_module(&q, unit, triple) && lower_functions(&q, ctx, unit) &&
+         lower_public_syms(&q, ctx, unit);
+    if (ok) {
+      // The IR linker reports conflicts (e.g. a public fn defined by two units) to the context.
+      UnitsLinkDiag diag = {{0}, false};
+      LLVMDiagnosticHandler prev = LLVMContextGetDiagnosticHandler(ctx);
+      void* prev_ctx = LLVMContextGetDiagnosticContext(ctx);
+      LLVMContextSetDiagnosticHandler(ctx, link_diag, &diag);
+      const bool failed = LLVMLinkModules2(mod, unit) != 0; // consumes `unit`
+      LLVMContextSetDiagnosticHandler(ctx, prev, prev_ctx);
+      unit = NULL;
+      if (failed) {
+        (void)sir_diag_push(&q, NULL, -1, NULL); // about the unit, not its last record
+        err_codef(&q, "sircc.units.link_failed", "sircc: failed to link unit: %s", diag.error ? diag.msg : "(unknown)");
+        ok = false;
+      }
+    }
+    if (unit) LLVMDisposeModule(unit);
+    unit_done(p, &q, ok);
+    if (!ok) return false;
+  }
+  return true;
+}
@@ -30,20 +30,19 @@ static int64_t find_prim_type_id(SirProgram* p, const char* prim) {
 static const char* ptr_sym_name_from_node(SirProgram* p, NodeRec* n) {
   if (!p || !n) return NULL;
   if (!n->fields || n->fields->type != JSON_OBJECT) return NULL;
-  const char* name = json_get_string(json_obj_get(n->fields, "name"));
+  const char* name = sir_node_name(p, n);
   if (name) return name;
-  JsonValue* args = json_obj_get(n->fields, "args");
-  if (!args || args->type != JSON_ARRAY || args->v.arr.len != 1) return NULL;
-  int64_t aid = 0;
-  if (!parse_node_ref_id(p, args->v.arr.items[0], &aid)) return NULL;
-  NodeRec* an = get_node(p, aid);
-  if (!an || !an->fields || strcmp(an->tag, "name") != 0) return NULL;
-  return json_get_string(json_obj_get(an->fields, "name"));
+  const int64_t* av = NULL;
+  size_t ac = 0;
+  if (sir_node_args(p, n, &av, &ac) != SIR_NODE_ARGS_OK || ac != 1) return NULL;
+  NodeRec* an = get_node(p, av[0]);
+  if (!an || !an->fields || sir_node_tag(p, an) != SIR_NODE_NAME) return NULL;
+  return sir_node_name(p, an);
 }
 
 static bool validate_ptr_sym_node(SirProgram* p, NodeRec* n) {
   if (!p || !n) return false;
-  if (strcmp(n->tag, "ptr.sym") != 0) return true;
+  if (sir_node_tag(p, n) != SIR_NODE_PTR_SYM) return true;
 
   SirDiagSaved saved = sir_diag_push_node(p, n);
   const char* name = ptr_sym_name_from_node(p, n);
@@ -114,11 +113,11 @@ static bool validate_cstr_node(SirProgram* p, NodeRec* n);
 static bool validate_fun_node(SirProgram* p, NodeRec* n) {
   if (!p || !n) return false;
   if (!p->feat_fun_v1) return true;
-  if (!(strcmp(n->tag, "call.fun") == 0 || strncmp(n->tag, "fun.", 4) == 0)) return true;
+  if (!(sir_node_family(p, n) & SIR_NODE_FAM_FUN)) return true;
 
   SirDiagSaved saved = sir_diag_push_node(p, n);
 
-  JsonValue* args = (n->fields && n->fields->type == JSON_OBJECT) ? json_obj_get(n->fields, "args") : NULL;
+  JsonValue* args = (n->fields && n->fields->type == JSON_OBJECT) ? json_obj_get_sym(n->fields, JSON_KEY_ARGS) : NULL;
 
   if (strcmp(n->tag, "call.fun") == 0) {
     if (!n->fields) {
@@ -207,7 +206,7 @@ static bool validate_fun_node(SirProgram* p, NodeRec* n) {
       err_codef(p, "sircc.fun.sym.sig.bad", "sircc: fun.sym node %lld fun.sig must reference a fn type", (long long)n->id);
       goto bad;
     }
-    const char* name = json_get_string(json_obj_get(n->fields, "name"));
+    const char* name = json_get_string(json_obj_get_sym(n->fields, JSON_KEY_NAME));
     if (!name || !is_ident(name)) {
       err_codef(p, "sircc.fun.sym.name.bad", "sircc: fun.sym node %lld requires fields.name Ident", (long long)n->id);
       goto bad;
@@ -226,7 +225,7 @@ static bool validate_fun_node(SirProgram* p, NodeRec* n) {
     if (decl_node) {
       int64_t decl_sig_id = decl_node->type_ref;
       if (decl_sig_id == 0) {
-        if (!parse_type_ref_id(p, json_obj_get(decl_node->fields, "sig"), &decl_sig_id)) {
+        if (!parse_type_ref_id(p, json_obj_get_sym(decl_node->fields, JSON_KEY_SIG), &decl_sig_id)) {
           err_codef(p, "sircc.fun.sym.decl.sig.bad", "sircc: fun.sym '%s' has decl.fn without a signature", name);
           goto bad;
         }
@@ -287,7 +286,7 @@ ok:
 
 static bool validate_call_indirect_node(SirProgram* p, NodeRec* n) {
   if (!p || !n) return false;
-  if (strcmp(n->tag, "call.indirect") != 0) return true;
+  if (sir_node_tag(p, n) != SIR_NODE_CALL_INDIRECT) return true;
 
   SirDiagSaved saved = sir_diag_push_node(p, n);
 
@@ -297,7 +296,7 @@ static bool validate_call_indirect_node(SirProgram* p, NodeRec* n) {
   }
 
   int64_t sig_id = 0;
-  if (!parse_type_ref_id(p, json_obj_get(n->fields, "sig"), &sig_id)) {
+  if (!parse_type_ref_id(p, json_obj_get_sym(n->fields, JSON_KEY_SIG), &sig_id)) {
     err_codef(p, "sircc.call.indirect.sig.missing", "sircc: call.indirect node %lld missing fields.sig (fn type ref)", (long long)n->id);
     goto bad;
   }
@@ -307,7 +306,7 @@ static bool validate_call_indirect_node(SirProgram* p, NodeRec* n) {
     goto bad;
   }
 
-  JsonValue* args = json_obj_get(n->fields, "args");
+  JsonValue* args = json_obj_get_sym(n->fields, JSON_KEY_ARGS);
   if (!args || args->type != JSON_ARRAY || args->v.arr.len < 1) {
     err_codef(p, "sircc.call.indirect.args.bad", "sircc: call.indirect node %lld requires args:[callee_ptr, ...]", (long long)n->id);
     goto bad;
@@ -399,7 +398,7 @@ ok:
 
 static bool validate_ptr_cast_node(SirProgram* p, NodeRec* n) {
   if (!p || !n) return false;
-  if (strcmp(n->tag, "ptr.from_i64") != 0) return true;
+  if (sir_node_tag(p, n) != SIR_NODE_PTR_FROM_I64) return true;
 
   if (p->opt && p->opt->verify_strict) {
     SirDiagSaved saved = sir_diag_push_node(p, n);
@@ -425,11 +424,11 @@ static bool validate_ptr_cast_node(SirProgram* p, NodeRec* n) {
 static bool validate_closure_node(SirProgram* p, NodeRec* n) {
   if (!p || !n) return false;
   if (!p->feat_closure_v1) return true;
-  if (!(strcmp(n->tag, "call.closure") == 0 || strncmp(n->tag, "closure.", 8) == 0)) return true;
+  if (!(sir_node_family(p, n) & SIR_NODE_FAM_CLOSURE)) return true;
 
   SirDiagSaved saved = sir_diag_push_node(p, n);
 
-  JsonValue* args = (n->fields && n->fields->type == JSON_OBJECT) ? json_obj_get(n->fields, "args") : NULL;
+  JsonValue* args = (n->fields && n->fields->type == JSON_OBJECT) ? json_obj_get_sym(n->fields, JSON_KEY_ARGS) : NULL;
 
   if (strcmp(n->tag, "call.closure") == 0) {
     if (!n->fields) {
@@ -565,13 +564,13 @@ static bool validate_closure_node(SirProgram* p, NodeRec* n) {
       err_codef(p, "sircc.closure.sym.type_ref.bad", "sircc: closure.sym node %lld type_ref must be a closure type", (long long)n->id);
       goto bad;
     }
-    const char* name = json_get_string(json_obj_get(n->fields, "name"));
+    const char* name = json_get_string(json_obj_get_sym(n->fields, JSON_KEY_NAME));
     if (!name || !is_ident(name)) {
       err_codef(p, "sircc.closure.sym.name.bad", "sircc: closure.sym node %lld requires fields.name Ident", (long long)n->id);
       goto bad;
     }
     int64_t env_id = 0;
-    if (!parse_node_ref_id(p, json_obj_get(n->fields, "env"), &env_id)) {
+    if (!parse_node_ref_id(p, json_obj_get_sym(n->fields, JSON_KEY_ENV), &env_id)) {
       err_codef(p, "sircc.closure.sym.env.ref.missing", "sircc: closure.sym node %lld missing fields.env ref", (long long)n->id);
       goto bad;
     }
@@ -688,7 +687,7 @@ ok:
 static bool validate_adt_node(SirProgram* p, NodeRec* n) {
   if (!p || !n) return false;
   if (!p->feat_adt_v1) return true;
-  if (strncmp(n->tag, "adt.", 4) != 0) return true;
+  if (!(sir_node_family(p, n) & SIR_NODE_FAM_ADT)) return true;
 
   SirDiagSaved saved = sir_diag_push_node(p, n);
 
@@ -698,8 +697,8 @@ static bool validate_adt_node(SirProgram* p, NodeRec* n) {
   }
 
   const char* op = n->tag + 4;
-  JsonValue* args = json_obj_get(n->fields, "args");
-  JsonValue* flags = json_obj_get(n->fields, "flags");
+  JsonValue* args = json_obj_get_sym(n->fields, JSON_KEY_ARGS);
+  JsonValue* flags = json_obj_get_sym(n->fields, JSON_KEY_FLAGS);
 
   if (strcmp(op, "tag") == 0) {
     if (!args || args->type != JSON_ARRAY || args->v.arr.len != 1) {
@@ -732,7 +731,7 @@ static bool validate_adt_node(SirProgram* p, NodeRec* n) {
       goto bad;
     }
     int64_t variant = 0;
-    if (!must_i64(p, json_obj_get(flags, "variant"), &variant, "adt.is.flags.variant")) goto bad;
+    if (!must_i64(p, json_obj_get_sym(flags, JSON_KEY_VARIANT), &variant, "adt.is.flags.variant")) goto bad;
     int64_t vid = 0;
     if (!parse_node_ref_id(p, args->v.arr.items[0], &vid)) {
       err_codef(p, "sircc.adt.is.arg_ref_bad", "sircc: adt.is node %lld arg must be node ref", (long long)n->id);
@@ -757,7 +756,7 @@ static bool validate_adt_node(SirProgram* p, NodeRec* n) {
       goto bad;
     }
     int64_t variant = -1;
-    if (!must_i64(p, json_obj_get(flags, "variant"), &variant, "adt.make.flags.variant")) goto bad;
+    if (!must_i64(p, json_obj_get_sym(flags, JSON_KEY_VARIANT), &variant, "adt.make.flags.variant")) goto bad;
     int64_t eff = (variant < 0 || (size_t)variant >= sty->variant_len) ? 0 : variant;
     int64_t pay_ty_id = (sty->variant_len && (size_t)eff < sty->variant_len) ? sty->variants[(size_t)eff].ty : 0;
 
@@ -798,7 +797,7 @@ static bool validate_adt_node(SirProgram* p, NodeRec* n) {
 
   if (strcmp(op, "get") == 0) {
     int64_t sum_ty_id = 0;
-    if (!parse_type_ref_id(p, json_obj_get(n->fields, "ty"), &sum_ty_id)) {
+    if (!parse_type_ref_id(p, json_obj_get_sym(n->fields, JSON_KEY_TY), &sum_ty_id)) {
       err_codef(p, "sircc.adt.get.missing_ty", "sircc: adt.get node %lld missing fields.ty (sum type)", (long long)n->id);
       goto bad;
     }
@@ -812,7 +811,7 @@ static bool validate_adt_node(SirProgram* p, NodeRec* n) {
       goto bad;
     }
     int64_t variant = -1;
-    if (!must_i64(p, json_obj_get(flags, "variant"), &variant, "adt.get.flags.variant")) goto bad;
+    if (!must_i64(p, json_obj_get_sym(flags, JSON_KEY_VARIANT), &variant, "adt.get.flags.variant")) goto bad;
     int64_t eff = (variant < 0 || (size_t)variant >= sty->variant_len) ? 0 : variant;
     int64_t pay_ty_id = (sty->variant_len && (size_t)eff < sty->variant_len) ? sty->variants[(size_t)eff].ty : 0;
     if (pay_ty_id == 0) {
@@ -854,14 +853,14 @@ static bool branch_result_type(SirProgram* p, JsonValue* br, int64_t want_ty_id,
                                int64_t* out_ty) {
   if (!p || !br || br->type != JSON_OBJECT || !out_ty) return false;
   *out_ty = 0;
-  const char* kind = json_get_string(json_obj_get(br, "kind"));
+  const char* kind = json_get_string(json_obj_get_sym(br, JSON_KEY_KIND));
   if (!kind) {
     err_codef(p, "sircc.sem.branch.kind.missing", "sircc: sem branch operand missing kind");
     return false;
   }
   if (strcmp(kind, "val") == 0) {
     int64_t vid = 0;
-    if (!parse_node_ref_id(p, json_obj_get(br, "v"), &vid)) return false;
+    if (!parse_node_ref_id(p, json_obj_get_sym(br, JSON_KEY_V), &vid)) return false;
     NodeRec* v = get_node(p, vid);
     if (!v || v->type_ref == 0) {
       err_codef(p, "sircc.sem.branch.val.type_mismatch", "sircc: branch value missing type_ref");
@@ -877,7 +876,7 @@ static bool branch_result_type(SirProgram* p, JsonValue* br, int64_t want_ty_id,
   }
   if (strcmp(kind, "thunk") == 0) {
     int64_t fid = 0;
-    if (!parse_node_ref_id(p, json_obj_get(br, "f"), &fid)) return false;
+    if (!parse_node_ref_id(p, json_obj_get_sym(br, JSON_KEY_F), &fid)) return false;
     NodeRec* fn = get_node(p, fid);
     if (!fn || fn->type_ref == 0) return false;
     TypeRec* t = get_type(p, fn->type_ref);
@@ -937,7 +936,7 @@ static bool branch_result_type(SirProgram* p, JsonValue* br, int64_t want_ty_id,
 static bool validate_sem_node(SirProgram* p, NodeRec* n) {
   if (!p || !n) return false;
   if (!p->feat_sem_v1) return true;
-  if (strncmp(n->tag, "sem.", 4) != 0) return true;
+  if (!(sir_node_family(p, n) & SIR_NODE_FAM_SEM)) return true;
 
   SirDiagSaved saved = sir_diag_push_node(p, n);
 
@@ -954,7 +953,7 @@ static bool validate_sem_node(SirProgram* p, NodeRec* n) {
     goto bad;
   }
 
-  JsonValue* args = json_obj_get(n->fields, "args");
+  JsonValue* args = json_obj_get_sym(n->fields, JSON_KEY_ARGS);
 
   if (strcmp(n->tag, "sem.if") == 0 || strcmp(n->tag, "sem.cond") == 0) {
     if (!args || args->type != JSON_ARRAY || args->v.arr.len != 3) {
@@ -1023,7 +1022,7 @@ static bool validate_sem_node(SirProgram* p, NodeRec* n) {
 
   if (strcmp(n->tag, "sem.match_sum") == 0) {
     int64_t sum_ty_id = 0;
-    if (!parse_type_ref_id(p, json_obj_get(n->fields, "sum"), &sum_ty_id)) {
+    if (!parse_type_ref_id(p, json_obj_get_sym(n->fields, JSON_KEY_SUM), &sum_ty_id)) {
       err_codef(p, "sircc.sem.match_sum.sum_missing", "sircc: sem.match_sum node %lld missing fields.sum (sum type)", (long long)n->id);
       goto bad;
     }
@@ -1047,8 +1046,8 @@ static bool validate_sem_node(SirProgram* p, NodeRec* n) {
       goto bad;
     }
 
-    JsonValue* cases = json_obj_get(n->fields, "cases");
-    JsonValue* def = json_obj_get(n->fields, "default");
+    JsonValue* cases = json_obj_get_sym(n->fields, JSON_KEY_CASES);
+    JsonValue* def = json_obj_get_sym(n->fields, JSON_KEY_DEFAULT);
     if (!cases || cases->type != JSON_ARRAY || !def || def->type != JSON_OBJECT) {
       err_codef(p, "sircc.sem.match_sum.cases_bad",
                 "sircc: sem.match_sum node %lld requires fields.cases array and fields.default branch", (long long)n->id);
@@ -1067,8 +1066,8 @@ static bool validate_sem_node(SirProgram* p, NodeRec* n) {
         goto bad;
       }
       int64_t variant = 0;
-      if (!must_i64(p, json_obj_get(co, "variant"), &variant, "sem.match_sum.cases.variant")) goto bad;
-      JsonValue* body = json_obj_get(co, "body");
+      if (!must_i64(p, json_obj_get_sym(co, JSON_KEY_VARIANT), &variant, "sem.match_sum.cases.variant")) goto bad;
+      JsonValue* body = json_obj_get_sym(co, JSON_KEY_BODY);
       if (!body || body->type != JSON_OBJECT) {
         err_codef(p, "sircc.sem.match_sum.case_body_missing", "sircc: sem.match_sum cases[%zu] missing body branch", i);
         goto bad;
@@ -1108,8 +1107,8 @@ static bool validate_sem_node(SirProgram* p, NodeRec* n) {
       goto bad;
     }
 
-    JsonValue* cases = json_obj_get(n->fields, "cases");
-    JsonValue* def = json_obj_get(n->fields, "default");
+    JsonValue* cases = json_obj_get_sym(n->fields, JSON_KEY_CASES);
+    JsonValue* def = json_obj_get_sym(n->fields, JSON_KEY_DEFAULT);
     if (!cases || cases->type != JSON_ARRAY || !def || def->type != JSON_OBJECT) {
       err_codef(p, "sircc.sem.switch.cases_bad", "sircc: sem.switch node %lld requires fields.cases array and fields.default branch",
                 (long long)n->id);
@@ -1128,7 +1127,7 @@ static bool validate_sem_node(SirProgram* p, NodeRec* n) {
         goto bad;
       }
       int64_t lit_id = 0;
-      if (!parse_node_ref_id(p, json_obj_get(co, "lit"), &lit_id)) {
+      if (!parse_node_ref_id(p, json_obj_get_sym(co, JSON_KEY_LIT), &lit_id)) {
         err_codef(p, "sircc.sem.switch.case_lit.ref_bad", "sircc: sem.switch cases[%zu] missing lit ref", i);
         goto bad;
       }
@@ -1141,7 +1140,7 @@ static bool validate_sem_node(SirProgram* p, NodeRec* n) {
         err_codef(p, "sircc.sem.switch.case_lit.type_mismatch", "sircc: sem.switch cases[%zu] lit type mismatch", i);
         goto bad;
       }
-      JsonValue* body = json_obj_get(co, "body");
+      JsonValue* body = json_obj_get_sym(co, JSON_KEY_BODY);
       if (!body || body->type != JSON_OBJECT) {
         err_codef(p, "sircc.sem.switch.case_body_missing", "sircc: sem.switch cases[%zu] missing body branch", i);
         goto bad;
@@ -1171,8 +1170,8 @@ static bool validate_sem_node(SirProgram* p, NodeRec* n) {
       err_codef(p, "sircc.sem.while.body.kind_bad", "sircc: sem.while body must be kind:'thunk'");
       goto bad;
     }
-    const char* ck = json_get_string(json_obj_get(args->v.arr.items[0], "kind"));
-    const char* bk = json_get_string(json_obj_get(args->v.arr.items[1], "kind"));
+    const char* ck = json_get_string(json_obj_get_sym(args->v.arr.items[0], JSON_KEY_KIND));
+    const char* bk = json_get_string(json_obj_get_sym(args->v.arr.items[1], JSON_KEY_KIND));
     if (!ck || strcmp(ck, "thunk") != 0) {
       err_codef(p, "sircc.sem.while.cond.kind_bad", "sircc: sem.while cond must be kind:'thunk'");
       goto bad;
@@ -1205,7 +1204,7 @@ static bool validate_sem_node(SirProgram* p, NodeRec* n) {
       err_codef(p, "sircc.sem.defer.thunk.bad", "sircc: sem.defer thunk operand must be an object");
       goto bad;
     }
-    const char* k = json_get_string(json_obj_get(args->v.arr.items[0], "kind"));
+    const char* k = json_get_string(json_obj_get_sym(args->v.arr.items[0], JSON_KEY_KIND));
     if (!k || strcmp(k, "thunk") != 0) {
       err_codef(p, "sircc.sem.defer.thunk.kind_bad", "sircc: sem.defer requires kind:'thunk'");
       goto bad;
@@ -1224,8 +1223,8 @@ static bool validate_sem_node(SirProgram* p, NodeRec* n) {
     // Shape:
     //   fields.defers: [ thunk(void), ... ]
     //   fields.body: ref(block)  (a purely structural block to inline)
-    JsonValue* defers = json_obj_get(n->fields, "defers");
-    JsonValue* body = json_obj_get(n->fields, "body");
+    JsonValue* defers = json_obj_get_sym(n->fields, JSON_KEY_DEFERS);
+    JsonValue* body = json_obj_get_sym(n->fields, JSON_KEY_BODY);
     if (!defers || defers->type != JSON_ARRAY || !body) {
       err_codef(p, "sircc.sem.scope.fields_bad", "sircc: sem.scope node %lld requires fields.defers (array) and fields.body (block ref)",
                 (long long)n->id);
@@ -1245,11 +1244,11 @@ static bool validate_sem_node(SirProgram* p, NodeRec* n) {
       err_codef(p, "sircc.sem.scope.body.bad_fields", "sircc: sem.scope body block missing fields");
       goto bad;
     }
-    if (json_obj_get(bn->fields, "params")) {
+    if (json_obj_get_sym(bn->fields, JSON_KEY_PARAMS)) {
       err_codef(p, "sircc.sem.scope.body.params_unsupported", "sircc: sem.scope body block params are not supported");
       goto bad;
     }
-    JsonValue* bstmts = json_obj_get(bn->fields, "stmts");
+    JsonValue* bstmts = json_obj_get_sym(bn->fields, JSON_KEY_STMTS);
     if (!bstmts || bstmts->type != JSON_ARRAY) {
       err_codef(p, "sircc.sem.scope.body.stmts_bad", "sircc: sem.scope body block must have stmts array");
       goto bad;
@@ -1266,7 +1265,7 @@ static bool validate_sem_node(SirProgram* p, NodeRec* n) {
         err_codef(p, "sircc.sem.scope.defer.bad", "sircc: sem.scope defers[%zu] must be thunk operand object", i);
         goto bad;
       }
-      const char* k = json_get_string(json_obj_get(d, "kind"));
+      const char* k = json_get_string(json_obj_get_sym(d, JSON_KEY_KIND));
       if (!k || strcmp(k, "thunk") != 0) {
         err_codef(p, "sircc.sem.scope.defer.kind_bad", "sircc: sem.scope defers[%zu] must be kind:'thunk'", i);
         goto bad;
@@ -1320,12 +1319,12 @@ static int64_t find_bool_vec_type_id(SirProgram* p, int64_t lanes) {
 static bool validate_simd_node(SirProgram* p, NodeRec* n) {
   if (!p || !n) return false;
   if (!p->feat_simd_v1) return true;
-  if (!(strncmp(n->tag, "vec.", 4) == 0 || strcmp(n->tag, "load.vec") == 0 || strcmp(n->tag, "store.vec") == 0)) return true;
+  if (!(sir_node_family(p, n) & SIR_NODE_FAM_VEC)) return true;
 
   SirDiagSaved saved = sir_diag_push_node(p, n);
 
   // Helper: fetch args array.
-  JsonValue* args = (n->fields && n->fields->type == JSON_OBJECT) ? json_obj_get(n->fields, "args") : NULL;
+  JsonValue* args = (n->fields && n->fields->type == JSON_OBJECT) ? json_obj_get_sym(n->fields, JSON_KEY_ARGS) : NULL;
 
   if (strcmp(n->tag, "vec.splat") == 0) {
     if (n->type_ref == 0) {
@@ -1449,8 +1448,8 @@ static bool validate_simd_node(SirProgram* p, NodeRec* n) {
       err_codef(p, "sircc.vec.shuffle.ab.type.bad", "sircc: vec.shuffle node %lld requires a,b of the same vec type", (long long)n->id);
       goto bad;
     }
-    JsonValue* flags = json_obj_get(n->fields, "flags");
-    JsonValue* idxs = (flags && flags->type == JSON_OBJECT) ? json_obj_get(flags, "idx") : NULL;
+    JsonValue* flags = json_obj_get_sym(n->fields, JSON_KEY_FLAGS);
+    JsonValue* idxs = (flags && flags->type == JSON_OBJECT) ? json_obj_get_sym(flags, JSON_KEY_IDX) : NULL;
     if (!idxs || idxs->type != JSON_ARRAY || idxs->v.arr.len != (size_t)vec->lanes) {
       err_codef(p, "sircc.vec.shuffle.idx.len_bad", "sircc: vec.shuffle node %lld flags.idx length must equal lanes", (long long)n->id);
       goto bad;
@@ -1470,7 +1469,7 @@ static bool validate_simd_node(SirProgram* p, NodeRec* n) {
       err_codef(p, "sircc.load.vec.type.bad", "sircc: load.vec node %lld type_ref must be a vec type", (long long)n->id);
       goto bad;
     }
-    JsonValue* addr = n->fields ? json_obj_get(n->fields, "addr") : NULL;
+    JsonValue* addr = n->fields ? json_obj_get_sym(n->fields, JSON_KEY_ADDR) : NULL;
     int64_t aid = 0;
     if (!parse_node_ref_id(p, addr, &aid)) {
       err_codef(p, "sircc.load.vec.addr.ref_bad", "sircc: load.vec node %lld missing fields.addr ref", (long long)n->id);
@@ -1492,8 +1491,8 @@ static bool validate_simd_node(SirProgram* p, NodeRec* n) {
   }
 
   if (strcmp(n->tag, "store.vec") == 0) {
-    JsonValue* addr = n->fields ? json_obj_get(n->fields, "addr") : NULL;
-    JsonValue* val = n->fields ? json_obj_get(n->fields, "value") : NULL;
+    JsonValue* addr = n->fields ? json_obj_get_sym(n->fields, JSON_KEY_ADDR) : NULL;
+    JsonValue* val = n->fields ? json_obj_get_sym(n->fields, JSON_KEY_VALUE) : NULL;
     int64_t aid = 0, vid = 0;
     if (!parse_node_ref_id(p, addr, &aid) || !parse_node_ref_id(p, val, &vid)) {
       err_codef(p, "sircc.store.vec.addr_value.ref_bad", "sircc: store.vec node %lld requires fields.addr and fields.value refs", (long long)n->id);
@@ -1514,7 +1513,7 @@ static bool validate_simd_node(SirProgram* p, NodeRec* n) {
     NodeRec* v = get_node(p, vid);
     int64_t vec_ty = v ? v->type_ref : 0;
     if (vec_ty == 0) {
-      (void)parse_type_ref_id(p, n->fields ? json_obj_get(n->fields, "ty") : NULL, &vec_ty);
+      (void)parse_type_ref_id(p, n->fields ? json_obj_get_sym(n->fields, JSON_KEY_TY) : NULL, &vec_ty);
     }
     if (!vec_ty || !is_vec_type_id(p, vec_ty, NULL, NULL)) {
       err_codef(p, "sircc.store.vec.type.bad", "sircc: store.vec node %lld requires vec type (value.type_ref or fields.ty)", (long long)n->id);
@@ -1533,7 +1532,7 @@ static bool validate_simd_node(SirProgram* p, NodeRec* n) {
       goto bad;
     }
     int64_t from_id = 0, to_id = 0;
-    if (!parse_type_ref_id(p, json_obj_get(n->fields, "from"), &from_id) || !parse_type_ref_id(p, json_obj_get(n->fields, "to"), &to_id)) {
+    if (!parse_type_ref_id(p, json_obj_get_sym(n->fields, JSON_KEY_FROM), &from_id) || !parse_type_ref_id(p, json_obj_get_sym(n->fields, JSON_KEY_TO), &to_id)) {
       err_codef(p, "sircc.vec.bitcast.from_to.bad", "sircc: vec.bitcast node %lld requires fields.from and fields.to type refs", (long long)n->id);
       goto bad;
     }
@@ -1611,24 +1610,25 @@ bad:
   return false;
 }
 
-bool validate_program(SirProgram* p) {
+// fn record and CFG checks over `nodes` (NULL entries skipped).
+static bool validate_fn_nodes(SirProgram* p, NodeRec* const* nodes, size_t len) {
   // Core fn record validation (runs for --verify-only too).
-  for (size_t i = 0; i < p->nodes_cap; i++) {
-    NodeRec* n = p->nodes[i];
+  for (size_t i = 0; i < len; i++) {
+    NodeRec* n = nodes[i];
     if (!n) continue;
-    if (strcmp(n->tag, "fn") != 0) continue;
+    if (sir_node_tag(p, n) != SIR_NODE_FN) continue;
     if (!n->fields || n->fields->type != JSON_OBJECT) {
       SIRCC_ERR_NODE(p, n, "sircc.fn.fields.missing", "sircc: fn node %lld missing fields", (long long)n->id);
       return false;
     }
 
-    const char* name = json_get_string(json_obj_get(n->fields, "name"));
+    const char* name = json_get_string(json_obj_get_sym(n->fields, JSON_KEY_NAME));
     if (!name || !*name) {
       SIRCC_ERR_NODE(p, n, "sircc.fn.name.missing", "sircc: fn node %lld missing fields.name", (long long)n->id);
       return false;
     }
 
-    const char* linkage = json_get_string(json_obj_get(n->fields, "linkage"));
+    const char* linkage = json_get_string(json_obj_get_sym(n->fields, JSON_KEY_LINKAGE));
     if (linkage && *linkage) {
       if (strcmp(linkage, "local") != 0 && strcmp(linkage, "public") != 0) {
         SIRCC_ERR_NODE(p, n, "sircc.fn.linkage.bad",
@@ -1643,18 +1643,22 @@ bool validate_program(SirProgram* p) {
   }
 
   // Validate CFG-form functions even under --verify-only.
-  for (size_t i = 0; i < p->nodes_cap; i++) {
-    NodeRec* n = p->nodes[i];
+  for (size_t i = 0; i < len; i++) {
+    NodeRec* n = nodes[i];
     if (!n) continue;
-    if (strcmp(n->tag, "fn") != 0) continue;
+    if (sir_node_tag(p, n) != SIR_NODE_FN) continue;
     if (!n->fields) continue;
-    JsonValue* blocks = json_obj_get(n->fields, "blocks");
-    JsonValue* entry = json_obj_get(n->fields, "entry");
+    JsonValue* blocks = json_obj_get_sym(n->fields, JSON_KEY_BLOCKS);
+    JsonValue* entry = json_obj_get_sym(n->fields, JSON_KEY_ENTRY);
     if (blocks || entry) {
       if (!validate_cfg_fn(p, n)) return false;
     }
   }
 
+  return true;
+}
+
+bool validate_program_decls(SirProgram* p) {
   // Feature gates for node-based streams (meta.ext.features can appear anywhere, so do this post-parse).
   if (p->feat_closure_v1 && !p->feat_fun_v1) {
     err_codef(p, "sircc.feature.dep", "sircc: feature closure:v1 requires fun:v1");
@@ -1752,40 +1756,46 @@ bool validate_program(SirProgram* p) {
     if (!validate_data_pack(p)) return false;
   }
 
-  for (size_t i = 0; i < p->nodes_cap; i++) {
-    NodeRec* n = p->nodes[i];
+  return true;
+}
+
+// Per-node feature gates and semantic checks over `nodes` (NULL entries skipped).
+static bool validate_nodes(SirProgram* p, NodeRec* const* nodes, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    NodeRec* n = nodes[i];
     if (!n) continue;
-    if ((strncmp(n->tag, "vec.", 4) == 0 || strcmp(n->tag, "load.vec") == 0 || strcmp(n->tag, "store.vec") == 0) && !p->feat_simd_v1) {
+    const unsigned fam = sir_node_family(p, n);
+    if ((fam & SIR_NODE_FAM_VEC) && !p->feat_simd_v1) {
       SirDiagSaved saved = sir_diag_push_node(p, n);
       err_codef(p, "sircc.feature.gate", "sircc: mnemonic '%s' requires feature simd:v1 (enable via meta.ext.features)", n->tag);
       sir_diag_pop(p, saved);
       return false;
     }
-    if ((strcmp(n->tag, "call.fun") == 0 || strncmp(n->tag, "fun.", 4) == 0) && !p->feat_fun_v1) {
+    if ((fam & SIR_NODE_FAM_FUN) && !p->feat_fun_v1) {
       SirDiagSaved saved = sir_diag_push_node(p, n);
       err_codef(p, "sircc.feature.gate", "sircc: mnemonic '%s' requires feature fun:v1 (enable via meta.ext.features)", n->tag);
       sir_diag_pop(p, saved);
       return false;
     }
-    if ((strcmp(n->tag, "call.closure") == 0 || strncmp(n->tag, "closure.", 8) == 0) && !p->feat_closure_v1) {
+    if ((fam & SIR_NODE_FAM_CLOSURE) && !p->feat_closure_v1) {
       SirDiagSaved saved = sir_diag_push_node(p, n);
       err_codef(p, "sircc.feature.gate", "sircc: mnemonic '%s' requires feature closure:v1 (enable via meta.ext.features)", n->tag);
       sir_diag_pop(p, saved);
       return false;
     }
-    if ((strncmp(n->tag, "adt.", 4) == 0) && !p->feat_adt_v1) {
+    if ((fam & SIR_NODE_FAM_ADT) && !p->feat_adt_v1) {
       SirDiagSaved saved = sir_diag_push_node(p, n);
       err_codef(p, "sircc.feature.gate", "sircc: mnemonic '%s' requires feature adt:v1 (enable via meta.ext.features)", n->tag);
       sir_diag_pop(p, saved);
       return false;
     }
-    if ((strncmp(n->tag, "sem.", 4) == 0) && !p->feat_sem_v1) {
+    if ((fam & SIR_NODE_FAM_SEM) && !p->feat_sem_v1) {
       SirDiagSaved saved = sir_diag_push_node(p, n);
       err_codef(p, "sircc.feature.gate", "sircc: mnemonic '%s' requires feature sem:v1 (enable via meta.ext.features)", n->tag);
       sir_diag_pop(p, saved);
       return false;
     }
-    if (strcmp(n->tag, "sem.match_sum") == 0 && p->feat_sem_v1 && !p->feat_adt_v1) {
+    if (sir_node_tag(p, n) == SIR_NODE_SEM_MATCH_SUM && p->feat_sem_v1 && !p->feat_adt_v1) {
       SirDiagSaved saved = sir_diag_push_node(p, n);
       err_codef(p, "sircc.feature.dep", "sircc: sem.match_sum requires adt:v1");
       sir_diag_pop(p, saved);
@@ -1795,16 +1805,16 @@ bool validate_program(SirProgram* p) {
 
   // SIMD semantic checks (close the "verify-only vs lowering" delta).
   if (p->feat_simd_v1) {
-    for (size_t i = 0; i < p->nodes_cap; i++) {
-      NodeRec* n = p->nodes[i];
+    for (size_t i = 0; i < len; i++) {
+      NodeRec* n = nodes[i];
       if (!n) continue;
       if (!validate_simd_node(p, n)) return false;
     }
   }
 
   // Base semantic checks.
-  for (size_t i = 0; i < p->nodes_cap; i++) {
-    NodeRec* n = p->nodes[i];
+  for (size_t i = 0; i < len; i++) {
+    NodeRec* n = nodes[i];
     if (!n) continue;
     if (!validate_ptr_sym_node(p, n)) return false;
     if (!validate_ptr_cast_node(p, n)) return false;
@@ -1814,29 +1824,29 @@ bool validate_program(SirProgram* p) {
 
   // fun/closure/adt/sem semantic checks (close the "verify-only vs lowering" delta).
   if (p->feat_fun_v1) {
-    for (size_t i = 0; i < p->nodes_cap; i++) {
-      NodeRec* n = p->nodes[i];
+    for (size_t i = 0; i < len; i++) {
+      NodeRec* n = nodes[i];
       if (!n) continue;
       if (!validate_fun_node(p, n)) return false;
     }
   }
   if (p->feat_closure_v1) {
-    for (size_t i = 0; i < p->nodes_cap; i++) {
-      NodeRec* n = p->nodes[i];
+    for (size_t i = 0; i < len; i++) {
+      NodeRec* n = nodes[i];
       if (!n) continue;
       if (!validate_closure_node(p, n)) return false;
     }
   }
   if (p->feat_adt_v1) {
-    for (size_t i = 0; i < p->nodes_cap; i++) {
-      NodeRec* n = p->nodes[i];
+    for (size_t i = 0; i < len; i++) {
+      NodeRec* n = nodes[i];
       if (!n) continue;
       if (!validate_adt_node(p, n)) return false;
     }
   }
   if (p->feat_sem_v1) {
-    for (size_t i = 0; i < p->nodes_cap; i++) {
-      NodeRec* n = p->nodes[i];
+    for (size_t i = 0; i < len; i++) {
+      NodeRec* n = nodes[i];
       if (!n) continue;
       if (!validate_sem_node(p, n)) return false;
     }
@@ -1845,6 +1855,14 @@ bool validate_program(SirProgram* p) {
   return true;
 }
 
+bool validate_node_set(SirProgram* p, NodeRec* const* nodes, size_t len) {
+  return validate_fn_nodes(p, nodes, len) && validate_nodes(p, nodes, len);
+}
+
+bool validate_program(SirProgram* p) {
+  return validate_fn_nodes(p, p->nodes, p->nodes_cap) && validate_program_decls(p) && validate_nodes(p, p->nodes, p->nodes_cap);
+}
+
 static TypeRec* find_type_by_name_kind(SirProgram* p, const char* name, TypeKind want_kind) {
   if (!p || !name || !*name) return NULL;
   TypeRec* found = NULL;
@@ -1871,7 +1889,7 @@ static bool is_ptr_to_prim(SirProgram* p, int64_t type_id, const char* prim) {
 
 static bool validate_cstr_node(SirProgram* p, NodeRec* n) {
   if (!p || !n || !n->tag) return false;
-  if (strcmp(n->tag, "cstr") != 0) return true;
+  if (sir_node_tag(p, n) != SIR_NODE_CSTR) return true;
 
   // `cstr` is a convenience literal node. Under data:v1 + strict mode, require that its
   // type_ref is explicitly the canonical `cstr` type so producers don't accidentally use
@@ -2016,7 +2034,7 @@ static bool validate_data_pack(SirProgram* p) {
 static size_t block_param_count(SirProgram* p, int64_t block_id) {
   NodeRec* b = get_node(p, block_id);
   if (!b || strcmp(b->tag, "block") != 0 || !b->fields) return 0;
-  JsonValue* params = json_obj_get(b->fields, "params");
+  JsonValue* params = json_obj_get_sym(b->fields, JSON_KEY_PARAMS);
   if (!params) return 0;
   if (params->type != JSON_ARRAY) return (size_t)-1;
   return params->v.arr.len;
@@ -2030,7 +2048,7 @@ static bool validate_block_params(SirProgram* p, int64_t block_id) {
     sir_diag_pop(p, saved);
     return false;
   }
-  JsonValue* params = b->fields ? json_obj_get(b->fields, "params") : NULL;
+  JsonValue* params = b->fields ? json_obj_get_sym(b->fields, JSON_KEY_PARAMS) : NULL;
   if (!params) return true;
   if (params->type != JSON_ARRAY) {
     SirDiagSaved saved = sir_diag_push_node(p, b);
@@ -2125,7 +2143,7 @@ static bool validate_terminator(SirProgram* p, int64_t term_id) {
       return false;
     }
     int64_t to_id = 0;
-    if (!parse_node_ref_id(p, json_obj_get(t->fields, "to"), &to_id)) {
+    if (!parse_node_ref_id(p, json_obj_get_sym(t->fields, JSON_KEY_TO), &to_id)) {
       err_codef(p, "sircc.cfg.term.br.missing_to", "sircc: term.br missing to ref");
       sir_diag_pop(p, saved);
       return false;
@@ -2134,7 +2152,7 @@ static bool validate_terminator(SirProgram* p, int64_t term_id) {
       sir_diag_pop(p, saved);
       return false;
     }
-    bool ok = validate_branch_args(p, to_id, json_obj_get(t->fields, "args"));
+    bool ok = validate_branch_args(p, to_id, json_obj_get_sym(t->fields, JSON_KEY_ARGS));
     sir_diag_pop(p, saved);
     return ok;
   }
@@ -2146,7 +2164,7 @@ static bool validate_terminator(SirProgram* p, int64_t term_id) {
       return false;
     }
     int64_t cond_id = 0;
-    if (!parse_node_ref_id(p, json_obj_get(t->fields, "cond"), &cond_id)) {
+    if (!parse_node_ref_id(p, json_obj_get_sym(t->fields, JSON_KEY_COND), &cond_id)) {
       err_codef(p, "sircc.cfg.term.cbr.missing_cond", "sircc: %s missing cond ref", t->tag);
       sir_diag_pop(p, saved);
       return false;
@@ -2156,15 +2174,15 @@ static bool validate_terminator(SirProgram* p, int64_t term_id) {
       sir_diag_pop(p, saved);
       return false;
     }
-    JsonValue* thenb = json_obj_get(t->fields, "then");
-    JsonValue* elseb = json_obj_get(t->fields, "else");
+    JsonValue* thenb = json_obj_get_sym(t->fields, JSON_KEY_THEN);
+    JsonValue* elseb = json_obj_get_sym(t->fields, JSON_KEY_ELSE);
     if (!thenb || thenb->type != JSON_OBJECT || !elseb || elseb->type != JSON_OBJECT) {
       err_codef(p, "sircc.cfg.term.cbr.missing_branches", "sircc: %s requires then/else objects", t->tag);
       sir_diag_pop(p, saved);
       return false;
     }
     int64_t then_id = 0, else_id = 0;
-    if (!parse_node_ref_id(p, json_obj_get(thenb, "to"), &then_id) || !parse_node_ref_id(p, json_obj_get(elseb, "to"), &else_id)) {
+    if (!parse_node_ref_id(p, json_obj_get_sym(thenb, JSON_KEY_TO), &then_id) || !parse_node_ref_id(p, json_obj_get_sym(elseb, JSON_KEY_TO), &else_id)) {
       err_codef(p, "sircc.cfg.term.cbr.missing_to", "sircc: %s then/else missing to ref", t->tag);
       sir_diag_pop(p, saved);
       return false;
@@ -2173,11 +2191,11 @@ static bool validate_terminator(SirProgram* p, int64_t term_id) {
       sir_diag_pop(p, saved);
       return false;
     }
-    if (!validate_branch_args(p, then_id, json_obj_get(thenb, "args"))) {
+    if (!validate_branch_args(p, then_id, json_obj_get_sym(thenb, JSON_KEY_ARGS))) {
       sir_diag_pop(p, saved);
       return false;
     }
-    if (!validate_branch_args(p, else_id, json_obj_get(elseb, "args"))) {
+    if (!validate_branch_args(p, else_id, json_obj_get_sym(elseb, JSON_KEY_ARGS))) {
       sir_diag_pop(p, saved);
       return false;
     }
@@ -2192,7 +2210,7 @@ static bool validate_terminator(SirProgram* p, int64_t term_id) {
       return false;
     }
     int64_t scrut_id = 0;
-    if (!parse_node_ref_id(p, json_obj_get(t->fields, "scrut"), &scrut_id)) {
+    if (!parse_node_ref_id(p, json_obj_get_sym(t->fields, JSON_KEY_SCRUT), &scrut_id)) {
       err_codef(p, "sircc.cfg.term.switch.missing_scrut", "sircc: term.switch missing scrut ref");
       sir_diag_pop(p, saved);
       return false;
@@ -2203,14 +2221,14 @@ static bool validate_terminator(SirProgram* p, int64_t term_id) {
       sir_diag_pop(p, saved);
       return false;
     }
-    JsonValue* def = json_obj_get(t->fields, "default");
+    JsonValue* def = json_obj_get_sym(t->fields, JSON_KEY_DEFAULT);
     if (!def || def->type != JSON_OBJECT) {
       err_codef(p, "sircc.cfg.term.switch.missing_default", "sircc: term.switch missing default branch");
       sir_diag_pop(p, saved);
       return false;
     }
     int64_t def_id = 0;
-    if (!parse_node_ref_id(p, json_obj_get(def, "to"), &def_id)) {
+    if (!parse_node_ref_id(p, json_obj_get_sym(def, JSON_KEY_TO), &def_id)) {
       err_codef(p, "sircc.cfg.term.switch.default.missing_to", "sircc: term.switch default missing to ref");
       sir_diag_pop(p, saved);
       return false;
@@ -2219,11 +2237,11 @@ static bool validate_terminator(SirProgram* p, int64_t term_id) {
       sir_diag_pop(p, saved);
       return false;
     }
-    if (!validate_branch_args(p, def_id, json_obj_get(def, "args"))) {
+    if (!validate_branch_args(p, def_id, json_obj_get_sym(def, JSON_KEY_ARGS))) {
       sir_diag_pop(p, saved);
       return false;
     }
-    JsonValue* cases = json_obj_get(t->fields, "cases");
+    JsonValue* cases = json_obj_get_sym(t->fields, JSON_KEY_CASES);
     if (!cases || cases->type != JSON_ARRAY) {
       err_codef(p, "sircc.cfg.term.switch.cases.not_array", "sircc: term.switch missing cases array");
       sir_diag_pop(p, saved);
@@ -2237,7 +2255,7 @@ static bool validate_terminator(SirProgram* p, int64_t term_id) {
         return false;
       }
       int64_t to_id = 0;
-      if (!parse_node_ref_id(p, json_obj_get(c, "to"), &to_id)) {
+      if (!parse_node_ref_id(p, json_obj_get_sym(c, JSON_KEY_TO), &to_id)) {
         err_codef(p, "sircc.cfg.term.switch.case.missing_to", "sircc: term.switch case[%zu] missing to ref", i);
         sir_diag_pop(p, saved);
         return false;
@@ -2246,12 +2264,12 @@ static bool validate_terminator(SirProgram* p, int64_t term_id) {
         sir_diag_pop(p, saved);
         return false;
       }
-      if (!validate_branch_args(p, to_id, json_obj_get(c, "args"))) {
+      if (!validate_branch_args(p, to_id, json_obj_get_sym(c, JSON_KEY_ARGS))) {
         sir_diag_pop(p, saved);
         return false;
       }
       int64_t lit_id = 0;
-      if (!parse_node_ref_id(p, json_obj_get(c, "lit"), &lit_id)) {
+      if (!parse_node_ref_id(p, json_obj_get_sym(c, JSON_KEY_LIT), &lit_id)) {
         err_codef(p, "sircc.cfg.term.switch.case.missing_lit", "sircc: term.switch case[%zu] missing lit ref", i);
         sir_diag_pop(p, saved);
         return false;
@@ -2273,8 +2291,8 @@ static bool validate_terminator(SirProgram* p, int64_t term_id) {
 
 static bool validate_cfg_fn(SirProgram* p, NodeRec* fn) {
   SirDiagSaved saved = sir_diag_push_node(p, fn);
-  JsonValue* blocks = json_obj_get(fn->fields, "blocks");
-  JsonValue* entry = json_obj_get(fn->fields, "entry");
+  JsonValue* blocks = json_obj_get_sym(fn->fields, JSON_KEY_BLOCKS);
+  JsonValue* entry = json_obj_get_sym(fn->fields, JSON_KEY_ENTRY);
   if (!blocks || blocks->type != JSON_ARRAY || !entry) {
     err_codef(p, "sircc.cfg.fn.missing_fields", "sircc: fn %lld CFG form requires fields.blocks (array) and fields.entry (ref)",
               (long long)fn->id);
@@ -2330,7 +2348,7 @@ static bool validate_cfg_fn(SirProgram* p, NodeRec* fn) {
       sir_diag_pop(p, saved);
       return false;
     }
-    JsonValue* stmts = b->fields ? json_obj_get(b->fields, "stmts") : NULL;
+    JsonValue* stmts = b->fields ? json_obj_get_sym(b->fields, JSON_KEY_STMTS) : NULL;
     if (!stmts || stmts->type != JSON_ARRAY || stmts->v.arr.len == 0) {
       SirDiagSaved bsaved = sir_diag_push_node(p, b);
       err_codef(p, "sircc.cfg.block.stmts.not_array", "sircc: block %lld must have non-empty stmts array", (long long)bid);
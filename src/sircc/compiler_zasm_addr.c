@@ -43,9 +43,9 @@ static bool mul_checked_i64(SirProgram* p, int64_t a, int64_t b, int64_t* out) {
 static bool is_const_i64(SirProgram* p, int64_t node_id, int64_t* out) {
   if (!p || !out) return false;
   NodeRec* n = get_node(p, node_id);
-  if (!n || strcmp(n->tag, "const.i64") != 0 || !n->fields) return false;
+  if (!n || sir_node_tag(p, n) != SIR_NODE_CONST_I64 || !n->fields) return false;
   int64_t v = 0;
-  if (!must_i64(p, json_obj_get(n->fields, "value"), &v, "const.value")) return false;
+  if (!must_i64(p, json_obj_get_sym(n->fields, JSON_KEY_VALUE), &v, "const.value")) return false;
   *out = v;
   return true;
 }
@@ -85,8 +85,8 @@ bool zasm_lower_addr_to_mem(
     return true;
   }
 
-  if (strcmp(n->tag, "ptr.sym") == 0) {
-    const char* name = n->fields ? json_get_string(json_obj_get(n->fields, "name")) : NULL;
+  if (sir_node_tag(p, n) == SIR_NODE_PTR_SYM) {
+    const char* name = n->fields ? json_get_string(json_obj_get_sym(n->fields, JSON_KEY_NAME)) : NULL;
     if (!name) {
       errf(p, "sircc: zasm: ptr.sym node %lld missing fields.name", (long long)addr_id);
       return false;
@@ -97,7 +97,7 @@ bool zasm_lower_addr_to_mem(
     return true;
   }
 
-  if (strcmp(n->tag, "name") == 0) {
+  if (sir_node_tag(p, n) == SIR_NODE_NAME) {
     ZasmOp op = {0};
     if (!zasm_lower_value_to_op(p, strs, strs_len, allocas, allocas_len, names, names_len, bps, bps_len, addr_id, &op)) return false;
     if (op.k == ZOP_SYM) {
@@ -109,17 +109,18 @@ bool zasm_lower_addr_to_mem(
     return false;
   }
 
-  if (strcmp(n->tag, "ptr.add") == 0) {
-    JsonValue* args = n->fields ? json_obj_get(n->fields, "args") : NULL;
-    if (!args || args->type != JSON_ARRAY || args->v.arr.len != 2) {
+  if (sir_node_tag(p, n) == SIR_NODE_PTR_ADD) {
+    int64_t arg_ids[2];
+    bool refs_ok = false;
+    if (!sir_node_args_n(p, n, 2, arg_ids, &refs_ok)) {
       errf(p, "sircc: zasm: ptr.add node %lld requires args:[base, off]", (long long)addr_id);
       return false;
     }
-    int64_t base_id = 0, off_id = 0;
-    if (!parse_node_ref_id(p, args->v.arr.items[0], &base_id) || !parse_node_ref_id(p, args->v.arr.items[1], &off_id)) {
+    if (!refs_ok) {
       errf(p, "sircc: zasm: ptr.add node %lld args must be node refs", (long long)addr_id);
       return false;
     }
+    int64_t base_id = arg_ids[0], off_id = arg_ids[1];
     int64_t off = 0;
     if (!is_const_i64(p, off_id, &off)) {
       errf(p, "sircc: zasm: ptr.add offset must be const.i64 (node %lld)", (long long)off_id);
@@ -135,22 +136,23 @@ bool zasm_lower_addr_to_mem(
     return true;
   }
 
-  if (strcmp(n->tag, "ptr.offset") == 0) {
+  if (sir_node_tag(p, n) == SIR_NODE_PTR_OFFSET) {
     int64_t ty_id = 0;
-    if (!parse_type_ref_id(p, n->fields ? json_obj_get(n->fields, "ty") : NULL, &ty_id)) {
+    if (!parse_type_ref_id(p, n->fields ? json_obj_get_sym(n->fields, JSON_KEY_TY) : NULL, &ty_id)) {
       errf(p, "sircc: zasm: ptr.offset node %lld missing fields.ty type ref", (long long)addr_id);
       return false;
     }
-    JsonValue* args = n->fields ? json_obj_get(n->fields, "args") : NULL;
-    if (!args || args->type != JSON_ARRAY || args->v.arr.len != 2) {
+    int64_t arg_ids[2];
+    bool refs_ok = false;
+    if (!sir_node_args_n(p, n, 2, arg_ids, &refs_ok)) {
       errf(p, "sircc: zasm: ptr.offset node %lld requires args:[base, idx]", (long long)addr_id);
       return false;
     }
-    int64_t base_id = 0, idx_id = 0;
-    if (!parse_node_ref_id(p, args->v.arr.items[0], &base_id) || !parse_node_ref_id(p, args->v.arr.items[1], &idx_id)) {
+    if (!refs_ok) {
       errf(p, "sircc: zasm: ptr.offset node %lld args must be node refs", (long long)addr_id);
       return false;
     }
+    int64_t base_id = arg_ids[0], idx_id = arg_ids[1];
     int64_t idx = 0;
     if (!is_const_i64(p, idx_id, &idx)) {
       errf(p, "sircc: zasm: ptr.offset idx must be const.i64 (node %lld)", (long long)idx_id);
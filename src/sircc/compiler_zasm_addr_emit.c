@@ -74,9 +74,9 @@ static bool emit_load_slot_into_reg(FILE* out, const char* dst_reg, const char*
 static bool is_const_i64(SirProgram* p, int64_t node_id, int64_t* out) {
   if (!p || !out) return false;
   NodeRec* n = get_node(p, node_id);
-  if (!n || strcmp(n->tag, "const.i64") != 0 || !n->fields) return false;
+  if (!n || sir_node_tag(p, n) != SIR_NODE_CONST_I64 || !n->fields) return false;
   int64_t v = 0;
-  if (!must_i64(p, json_obj_get(n->fields, "value"), &v, "const.value")) return false;
+  if (!must_i64(p, json_obj_get_sym(n->fields, JSON_KEY_VALUE), &v, "const.value")) return false;
   *out = v;
   return true;
 }
@@ -131,8 +131,8 @@ static bool try_lower_addr_const(
     return true;
   }
 
-  if (strcmp(n->tag, "ptr.sym") == 0) {
-    const char* name = n->fields ? json_get_string(json_obj_get(n->fields, "name")) : NULL;
+  if (sir_node_tag(p, n) == SIR_NODE_PTR_SYM) {
+    const char* name = n->fields ? json_get_string(json_obj_get_sym(n->fields, JSON_KEY_NAME)) : NULL;
     if (!name) return false;
     out_base->k = ZOP_SYM;
     out_base->s = name;
@@ -140,7 +140,7 @@ static bool try_lower_addr_const(
     return true;
   }
 
-  if (strcmp(n->tag, "name") == 0) {
+  if (sir_node_tag(p, n) == SIR_NODE_NAME) {
     ZasmOp op = {0};
     if (!zasm_lower_value_to_op(p, strs, strs_len, allocas, allocas_len, names, names_len, bps, bps_len, addr_id, &op)) return false;
     if (op.k != ZOP_SYM) return false;
@@ -149,8 +149,8 @@ static bool try_lower_addr_const(
     return true;
   }
 
-  if (strcmp(n->tag, "ptr.add") == 0) {
-    JsonValue* args = n->fields ? json_obj_get(n->fields, "args") : NULL;
+  if (sir_node_tag(p, n) == SIR_NODE_PTR_ADD) {
+    JsonValue* args = n->fields ? json_obj_get_sym(n->fields, JSON_KEY_ARGS) : NULL;
     if (!args || args->type != JSON_ARRAY || args->v.arr.len != 2) return false;
     int64_t base_id = 0, off_id = 0;
     if (!parse_node_ref_id(p, args->v.arr.items[0], &base_id) || !parse_node_ref_id(p, args->v.arr.items[1], &off_id)) return false;
@@ -166,10 +166,10 @@ static bool try_lower_addr_const(
     return true;
   }
 
-  if (strcmp(n->tag, "ptr.offset") == 0) {
+  if (sir_node_tag(p, n) == SIR_NODE_PTR_OFFSET) {
     int64_t ty_id = 0;
-    if (!parse_type_ref_id(p, n->fields ? json_obj_get(n->fields, "ty") : NULL, &ty_id)) return false;
-    JsonValue* args = n->fields ? json_obj_get(n->fields, "args") : NULL;
+    if (!parse_type_ref_id(p, n->fields ? json_obj_get_sym(n->fields, JSON_KEY_TY) : NULL, &ty_id)) return false;
+    JsonValue* args = n->fields ? json_obj_get_sym(n->fields, JSON_KEY_ARGS) : NULL;
     if (!args || args->type != JSON_ARRAY || args->v.arr.len != 2) return false;
     int64_t base_id = 0, idx_id = 0;
     if (!parse_node_ref_id(p, args->v.arr.items[0], &base_id) || !parse_node_ref_id(p, args->v.arr.items[1], &idx_id)) return false;
@@ -248,23 +248,24 @@ static bool materialize_addr_into_hl(
     return false;
   }
 
-  if (strcmp(n->tag, "name") == 0) {
+  if (sir_node_tag(p, n) == SIR_NODE_NAME) {
     return materialize_value_i64_into_reg(out, p, strs, strs_len, allocas, allocas_len, names, names_len, bps, bps_len, addr_id, "HL", io_line);
   }
 
-  if (strcmp(n->tag, "ptr.add") == 0) {
-    JsonValue* args = n->fields ? json_obj_get(n->fields, "args") : NULL;
-    if (!args || args->type != JSON_ARRAY || args->v.arr.len != 2) {
+  if (sir_node_tag(p, n) == SIR_NODE_PTR_ADD) {
+    int64_t arg_ids[2];
+    bool refs_ok = false;
+    if (!sir_node_args_n(p, n, 2, arg_ids, &refs_ok)) {
       zasm_err_node_codef(p, addr_id, n->tag, "sircc.zasm.addr.ptr_add.bad_args",
                           "sircc: zasm: ptr.add node %lld requires args:[base, off]", (long long)addr_id);
       return false;
     }
-    int64_t base_id = 0, off_id = 0;
-    if (!parse_node_ref_id(p, args->v.arr.items[0], &base_id) || !parse_node_ref_id(p, args->v.arr.items[1], &off_id)) {
+    if (!refs_ok) {
       zasm_err_node_codef(p, addr_id, n->tag, "sircc.zasm.addr.ptr_add.bad_args", "sircc: zasm: ptr.add node %lld args must be node refs",
                           (long long)addr_id);
       return false;
     }
+    int64_t base_id = arg_ids[0], off_id = arg_ids[1];
 
     if (!materialize_addr_into_hl(out, p, strs, strs_len, allocas, allocas_len, names, names_len, bps, bps_len, base_id, io_line)) return false;
     if (!materialize_value_i64_into_reg(out, p, strs, strs_len, allocas, allocas_len, names, names_len, bps, bps_len, off_id, "DE", io_line))
@@ -274,25 +275,26 @@ static bool materialize_addr_into_hl(
     return true;
   }
 
-  if (strcmp(n->tag, "ptr.offset") == 0) {
+  if (sir_node_tag(p, n) == SIR_NODE_PTR_OFFSET) {
     int64_t ty_id = 0;
-    if (!parse_type_ref_id(p, n->fields ? json_obj_get(n->fields, "ty") : NULL, &ty_id)) {
+    if (!parse_type_ref_id(p, n->fields ? json_obj_get_sym(n->fields, JSON_KEY_TY) : NULL, &ty_id)) {
       zasm_err_node_codef(p, addr_id, n->tag, "sircc.zasm.addr.ptr_offset.missing_ty",
                           "sircc: zasm: ptr.offset node %lld missing fields.ty type ref", (long long)addr_id);
       return false;
     }
-    JsonValue* args = n->fields ? json_obj_get(n->fields, "args") : NULL;
-    if (!args || args->type != JSON_ARRAY || args->v.arr.len != 2) {
+    int64_t arg_ids[2];
+    bool refs_ok = false;
+    if (!sir_node_args_n(p, n, 2, arg_ids, &refs_ok)) {
       zasm_err_node_codef(p, addr_id, n->tag, "sircc.zasm.addr.ptr_offset.bad_args",
                           "sircc: zasm: ptr.offset node %lld requires args:[base, idx]", (long long)addr_id);
       return false;
     }
-    int64_t base_id = 0, idx_id = 0;
-    if (!parse_node_ref_id(p, args->v.arr.items[0], &base_id) || !parse_node_ref_id(p, args->v.arr.items[1], &idx_id)) {
+    if (!refs_ok) {
       zasm_err_node_codef(p, addr_id, n->tag, "sircc.zasm.addr.ptr_offset.bad_args",
                           "sircc: zasm: ptr.offset node %lld args must be node refs", (long long)addr_id);
       return false;
     }
+    int64_t base_id = arg_ids[0], idx_id = arg_ids[1];
 
     // Base -> HL, then preserve into DE.
     if (!materialize_addr_into_hl(out, p, strs, strs_len, allocas, allocas_len, names, names_len, bps, bps_len, base_id, io_line)) return false;
@@ -239,7 +239,7 @@ static bool emit_binop_into_hl(
     int64_t width_bytes,
     int64_t* io_line) {
   if (!out || !p || !vn || !vn->fields || !io_line) return false;
-  JsonValue* args = json_obj_get(vn->fields, "args");
+  JsonValue* args = json_obj_get_sym(vn->fields, JSON_KEY_ARGS);
   if (!args || args->type != JSON_ARRAY || args->v.arr.len != 2) {
     errf(p, "sircc: zasm: %s node %lld requires args:[a,b]", vn->tag, (long long)vn->id);
     return false;
@@ -418,9 +418,9 @@ static bool emit_zir_nonterm_stmt(
     int64_t* io_line) {
   if (!out || !p || !names || !name_len || !name_cap || !tmps || !tmp_len || !tmp_cap || !s || !io_line) return false;
 
-  if (strcmp(s->tag, "let") == 0) {
-    const char* bind_name = s->fields ? json_get_string(json_obj_get(s->fields, "name")) : NULL;
-    JsonValue* v = s->fields ? json_obj_get(s->fields, "value") : NULL;
+  if (sir_node_tag(p, s) == SIR_NODE_LET) {
+    const char* bind_name = s->fields ? json_get_string(json_obj_get_sym(s->fields, JSON_KEY_NAME)) : NULL;
+    JsonValue* v = s->fields ? json_obj_get_sym(s->fields, JSON_KEY_VALUE) : NULL;
     int64_t vid = 0;
     if (!parse_node_ref_id(p, v, &vid)) {
       errf(p, "sircc: zasm: let node %lld missing fields.value ref", (long long)s->id);
@@ -432,7 +432,7 @@ static bool emit_zir_nonterm_stmt(
       return false;
     }
 
-    if (strcmp(vn->tag, "call") == 0 || strcmp(vn->tag, "call.indirect") == 0) {
+    if (sir_node_tag(p, vn) == SIR_NODE_CALL || sir_node_tag(p, vn) == SIR_NODE_CALL_INDIRECT) {
       zasm_regcache_clear_all();
       if (!zasm_emit_call_stmt(out, p, strs, strs_len, allocas, allocas_len, *names, *name_len, bps, bps_len, vid, io_line)) return false;
       zasm_regcache_clear_all();
@@ -453,19 +453,19 @@ static bool emit_zir_nonterm_stmt(
       int64_t width = 0;
       const char* m = NULL;
       const char* dst_reg = NULL;
-      if (strcmp(vn->tag, "load.i8") == 0) {
+      if (sir_node_tag(p, vn) == SIR_NODE_LOAD_I8) {
         width = 1;
         m = "LD8U";
         dst_reg = "A";
-      } else if (strcmp(vn->tag, "load.i16") == 0) {
+      } else if (sir_node_tag(p, vn) == SIR_NODE_LOAD_I16) {
         width = 2;
         m = "LD16U";
         dst_reg = "HL";
-      } else if (strcmp(vn->tag, "load.i32") == 0) {
+      } else if (sir_node_tag(p, vn) == SIR_NODE_LOAD_I32) {
         width = 4;
         m = "LD32U64";
         dst_reg = "HL";
-      } else if (strcmp(vn->tag, "load.i64") == 0 || strcmp(vn->tag, "load.ptr") == 0) {
+      } else if (sir_node_tag(p, vn) == SIR_NODE_LOAD_I64 || sir_node_tag(p, vn) == SIR_NODE_LOAD_PTR) {
         width = 8;
         m = "LD64";
         dst_reg = "HL";
@@ -475,7 +475,7 @@ static bool emit_zir_nonterm_stmt(
       }
 
       int64_t addr_id = 0;
-      JsonValue* av = vn->fields ? json_obj_get(vn->fields, "addr") : NULL;
+      JsonValue* av = vn->fields ? json_obj_get_sym(vn->fields, JSON_KEY_ADDR) : NULL;
       if (!parse_node_ref_id(p, av, &addr_id)) {
         errf(p, "sircc: zasm: %s node %lld requires fields.addr node ref", vn->tag, (long long)vn->id);
         return false;
@@ -554,7 +554,7 @@ static bool emit_zir_nonterm_stmt(
         return false;
       }
 
-      JsonValue* args = vn->fields ? json_obj_get(vn->fields, "args") : NULL;
+      JsonValue* args = vn->fields ? json_obj_get_sym(vn->fields, JSON_KEY_ARGS) : NULL;
       if (!args || args->type != JSON_ARRAY || args->v.arr.len != 1) {
         errf(p, "sircc: zasm: %s node %lld requires args:[x]", vn->tag, (long long)vn->id);
         return false;
@@ -601,14 +601,14 @@ static bool emit_zir_nonterm_stmt(
     return true;
   }
 
-  if (strcmp(s->tag, "mem.fill") == 0) {
+  if (sir_node_tag(p, s) == SIR_NODE_MEM_FILL) {
     zasm_regcache_clear_all();
     if (!zasm_emit_mem_fill_stmt(out, p, strs, strs_len, allocas, allocas_len, *names, *name_len, bps, bps_len, s, io_line)) return false;
     zasm_regcache_clear_all();
     return true;
   }
 
-  if (strcmp(s->tag, "mem.copy") == 0) {
+  if (sir_node_tag(p, s) == SIR_NODE_MEM_COPY) {
     zasm_regcache_clear_all();
     if (!zasm_emit_mem_copy_stmt(out, p, strs, strs_len, allocas, allocas_len, *names, *name_len, bps, bps_len, s, io_line)) return false;
     zasm_regcache_clear_all();
@@ -732,7 +732,7 @@ static bool emit_cfg_branch_args(
   if (!out || !p || !bps || !bp_len || !bp_cap || !line) return false;
 
   NodeRec* to_blk = get_node(p, to_id);
-  JsonValue* to_params = (to_blk && to_blk->fields) ? json_obj_get(to_blk->fields, "params") : NULL;
+  JsonValue* to_params = (to_blk && to_blk->fields) ? json_obj_get_sym(to_blk->fields, JSON_KEY_PARAMS) : NULL;
   if (!to_params || to_params->type != JSON_ARRAY || to_params->v.arr.len != args->v.arr.len) {
     errf(p, "sircc: zasm: branch args must match destination block params");
     return false;
@@ -866,10 +866,10 @@ bool emit_zasm_v11(SirProgram* p, const char* out_path) {
   fprintf(out, "}\n\n");
 
   // CFG-form zir_main: fields.entry + fields.blocks (minimal subset).
-  JsonValue* entryv = zir_main->fields ? json_obj_get(zir_main->fields, "entry") : NULL;
+  JsonValue* entryv = zir_main->fields ? json_obj_get_sym(zir_main->fields, JSON_KEY_ENTRY) : NULL;
   int64_t entry_id = 0;
   if (entryv && parse_node_ref_id(p, entryv, &entry_id)) {
-    JsonValue* blocks = json_obj_get(zir_main->fields, "blocks");
+    JsonValue* blocks = json_obj_get_sym(zir_main->fields, JSON_KEY_BLOCKS);
     if (!blocks || blocks->type != JSON_ARRAY || blocks->v.arr.len == 0) {
       fclose(out);
       free(strs);
@@ -908,7 +908,7 @@ bool emit_zasm_v11(SirProgram* p, const char* out_path) {
       }
       block_ids[bi] = bid;
       NodeRec* b = get_node(p, bid);
-      if (!b || strcmp(b->tag, "block") != 0 || !b->fields) {
+      if (!b || sir_node_tag(p, b) != SIR_NODE_BLOCK || !b->fields) {
         fclose(out);
         free(strs);
         free(allocas);
@@ -920,7 +920,7 @@ bool emit_zasm_v11(SirProgram* p, const char* out_path) {
         return false;
       }
       // Collect/allocate slots for block params (bparam) so term.br args can store into them.
-      JsonValue* params = json_obj_get(b->fields, "params");
+      JsonValue* params = json_obj_get_sym(b->fields, JSON_KEY_PARAMS);
       if (params && params->type == JSON_ARRAY) {
         for (size_t pi = 0; pi < params->v.arr.len; pi++) {
           int64_t pid = 0;
@@ -937,7 +937,7 @@ bool emit_zasm_v11(SirProgram* p, const char* out_path) {
             return false;
           }
           NodeRec* pn = get_node(p, pid);
-          if (!pn || strcmp(pn->tag, "bparam") != 0) {
+          if (!pn || sir_node_tag(p, pn) != SIR_NODE_BPARAM) {
             fclose(out);
             free(strs);
             free(allocas);
@@ -988,7 +988,7 @@ bool emit_zasm_v11(SirProgram* p, const char* out_path) {
 
         int64_t bid = block_ids[bi];
         NodeRec* b = get_node(p, bid);
-        if (!b || strcmp(b->tag, "block") != 0 || !b->fields) {
+        if (!b || sir_node_tag(p, b) != SIR_NODE_BLOCK || !b->fields) {
           fclose(out);
           free(strs);
           free(allocas);
@@ -1020,7 +1020,7 @@ bool emit_zasm_v11(SirProgram* p, const char* out_path) {
       fprintf(out, "}\n");
       zasm_regcache_clear_all();
 
-      JsonValue* stmts = json_obj_get(b->fields, "stmts");
+      JsonValue* stmts = json_obj_get_sym(b->fields, JSON_KEY_STMTS);
       if (!stmts || stmts->type != JSON_ARRAY) {
         fclose(out);
         free(strs);
@@ -1061,7 +1061,7 @@ bool emit_zasm_v11(SirProgram* p, const char* out_path) {
         }
         zasm_set_about_node(sid, s->tag);
 
-        if (strncmp(s->tag, "term.", 5) != 0 && strcmp(s->tag, "return") != 0) {
+        if (strncmp(s->tag, "term.", 5) != 0 && sir_node_tag(p, s) != SIR_NODE_RETURN) {
           if (!emit_zir_nonterm_stmt(
                   out, p, strs, strs_len, allocas, allocas_len, &names, &name_len, &name_cap, bps, bp_len, &tmps, &tmp_len, &tmp_cap, s,
                   &line)) {
@@ -1080,8 +1080,8 @@ bool emit_zasm_v11(SirProgram* p, const char* out_path) {
 
         zasm_regcache_clear_all();
 
-        if (strcmp(s->tag, "term.ret") == 0 || strcmp(s->tag, "return") == 0) {
-          JsonValue* rv = s->fields ? json_obj_get(s->fields, "value") : NULL;
+        if (sir_node_tag(p, s) == SIR_NODE_TERM_RET || sir_node_tag(p, s) == SIR_NODE_RETURN) {
+          JsonValue* rv = s->fields ? json_obj_get_sym(s->fields, JSON_KEY_VALUE) : NULL;
           int64_t rid = 0;
           if (rv && parse_node_ref_id(p, rv, &rid)) {
             zasm_regcache_clear_all();
@@ -1115,9 +1115,9 @@ bool emit_zasm_v11(SirProgram* p, const char* out_path) {
           break;
         }
 
-        if (strcmp(s->tag, "term.br") == 0) {
+        if (sir_node_tag(p, s) == SIR_NODE_TERM_BR) {
           int64_t to_id = 0;
-          if (!parse_node_ref_id(p, s->fields ? json_obj_get(s->fields, "to") : NULL, &to_id)) {
+          if (!parse_node_ref_id(p, s->fields ? json_obj_get_sym(s->fields, JSON_KEY_TO) : NULL, &to_id)) {
             fclose(out);
             free(strs);
             free(allocas);
@@ -1129,10 +1129,10 @@ bool emit_zasm_v11(SirProgram* p, const char* out_path) {
             return false;
           }
 
-          JsonValue* args = json_obj_get(s->fields, "args");
+          JsonValue* args = json_obj_get_sym(s->fields, JSON_KEY_ARGS);
           if (args && args->type == JSON_ARRAY && args->v.arr.len) {
             NodeRec* to_blk = get_node(p, to_id);
-            JsonValue* to_params = (to_blk && to_blk->fields) ? json_obj_get(to_blk->fields, "params") : NULL;
+            JsonValue* to_params = (to_blk && to_blk->fields) ? json_obj_get_sym(to_blk->fields, JSON_KEY_PARAMS) : NULL;
             if (!to_params || to_params->type != JSON_ARRAY || to_params->v.arr.len != args->v.arr.len) {
               fclose(out);
               free(strs);
@@ -1262,9 +1262,9 @@ bool emit_zasm_v11(SirProgram* p, const char* out_path) {
           break;
         }
 
-	        if (strcmp(s->tag, "term.cbr") == 0 || strcmp(s->tag, "term.condbr") == 0) {
+	        if (sir_node_tag(p, s) == SIR_NODE_TERM_CBR || sir_node_tag(p, s) == SIR_NODE_TERM_CONDBR) {
 	          int64_t cond_id = 0;
-	          if (!parse_node_ref_id(p, json_obj_get(s->fields, "cond"), &cond_id)) {
+	          if (!parse_node_ref_id(p, json_obj_get_sym(s->fields, JSON_KEY_COND), &cond_id)) {
 	            fclose(out);
 	            free(strs);
 	            free(allocas);
@@ -1274,13 +1274,13 @@ bool emit_zasm_v11(SirProgram* p, const char* out_path) {
 	            errf(p, "sircc: zasm: %s node %lld missing fields.cond ref", s->tag, (long long)s->id);
 	            return false;
 	          }
-          JsonValue* thenv = json_obj_get(s->fields, "then");
-          JsonValue* elsev = json_obj_get(s->fields, "else");
-          JsonValue* then_args = thenv ? json_obj_get(thenv, "args") : NULL;
-	          JsonValue* else_args = elsev ? json_obj_get(elsev, "args") : NULL;
+          JsonValue* thenv = json_obj_get_sym(s->fields, JSON_KEY_THEN);
+          JsonValue* elsev = json_obj_get_sym(s->fields, JSON_KEY_ELSE);
+          JsonValue* then_args = thenv ? json_obj_get_sym(thenv, JSON_KEY_ARGS) : NULL;
+	          JsonValue* else_args = elsev ? json_obj_get_sym(elsev, JSON_KEY_ARGS) : NULL;
 	          int64_t then_id = 0, else_id = 0;
-	          if (!parse_node_ref_id(p, thenv ? json_obj_get(thenv, "to") : NULL, &then_id) ||
-	              !parse_node_ref_id(p, elsev ? json_obj_get(elsev, "to") : NULL, &else_id)) {
+	          if (!parse_node_ref_id(p, thenv ? json_obj_get_sym(thenv, JSON_KEY_TO) : NULL, &then_id) ||
+	              !parse_node_ref_id(p, elsev ? json_obj_get_sym(elsev, JSON_KEY_TO) : NULL, &else_id)) {
 	            fclose(out);
 	            free(strs);
 	            free(allocas);
@@ -1306,7 +1306,7 @@ bool emit_zasm_v11(SirProgram* p, const char* out_path) {
           }
           const char* cmp_m = zasm_cmp_set_mnemonic_for_node_tag(c->tag);
           if (cmp_m) {
-            JsonValue* args = c->fields ? json_obj_get(c->fields, "args") : NULL;
+            JsonValue* args = c->fields ? json_obj_get_sym(c->fields, JSON_KEY_ARGS) : NULL;
             if (!args || args->type != JSON_ARRAY || args->v.arr.len != 2) {
               fclose(out);
               free(strs);
@@ -1563,7 +1563,7 @@ bool emit_zasm_v11(SirProgram* p, const char* out_path) {
   fprintf(out, "}\n");
   zasm_regcache_clear_all();
 
-  JsonValue* bodyv = zir_main->fields ? json_obj_get(zir_main->fields, "body") : NULL;
+  JsonValue* bodyv = zir_main->fields ? json_obj_get_sym(zir_main->fields, JSON_KEY_BODY) : NULL;
   int64_t body_id = 0;
   if (!parse_node_ref_id(p, bodyv, &body_id)) {
     fclose(out);
@@ -1574,7 +1574,7 @@ bool emit_zasm_v11(SirProgram* p, const char* out_path) {
     return false;
   }
   NodeRec* body = get_node(p, body_id);
-  if (!body || strcmp(body->tag, "block") != 0 || !body->fields) {
+  if (!body || sir_node_tag(p, body) != SIR_NODE_BLOCK || !body->fields) {
     fclose(out);
     free(strs);
     free(allocas);
@@ -1582,7 +1582,7 @@ bool emit_zasm_v11(SirProgram* p, const char* out_path) {
     errf(p, "sircc: zasm: zir_main body must be a block node");
     return false;
   }
-  JsonValue* stmts = json_obj_get(body->fields, "stmts");
+  JsonValue* stmts = json_obj_get_sym(body->fields, JSON_KEY_STMTS);
   if (!stmts || stmts->type != JSON_ARRAY) {
     fclose(out);
     free(strs);
@@ -1615,7 +1615,7 @@ bool emit_zasm_v11(SirProgram* p, const char* out_path) {
     }
     zasm_set_about_node(sid, s->tag);
 
-    if (strcmp(s->tag, "term.ret") != 0 && strcmp(s->tag, "return") != 0) {
+    if (sir_node_tag(p, s) != SIR_NODE_TERM_RET && sir_node_tag(p, s) != SIR_NODE_RETURN) {
       if (!emit_zir_nonterm_stmt(
               out, p, strs, strs_len, allocas, allocas_len, &names, &name_len, &name_cap, bps, bp_len, &tmps, &tmp_len, &tmp_cap, s,
               &line)) {
@@ -1631,8 +1631,8 @@ bool emit_zasm_v11(SirProgram* p, const char* out_path) {
       continue;
     }
 
-    if (strcmp(s->tag, "term.ret") == 0 || strcmp(s->tag, "return") == 0) {
-      JsonValue* rv = s->fields ? json_obj_get(s->fields, "value") : NULL;
+    if (sir_node_tag(p, s) == SIR_NODE_TERM_RET || sir_node_tag(p, s) == SIR_NODE_RETURN) {
+      JsonValue* rv = s->fields ? json_obj_get_sym(s->fields, JSON_KEY_VALUE) : NULL;
       int64_t rid = 0;
       if (rv && parse_node_ref_id(p, rv, &rid)) {
         zasm_regcache_clear_all();
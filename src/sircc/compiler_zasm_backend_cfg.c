@@ -42,7 +42,7 @@ bool emit_cfg_branch_args(
   if (!out || !p || !bps || !bp_len || !bp_cap || !line) return false;
 
   NodeRec* to_blk = get_node(p, to_id);
-  JsonValue* to_params = (to_blk && to_blk->fields) ? json_obj_get(to_blk->fields, "params") : NULL;
+  JsonValue* to_params = (to_blk && to_blk->fields) ? json_obj_get_sym(to_blk->fields, JSON_KEY_PARAMS) : NULL;
   if (!to_params || to_params->type != JSON_ARRAY || to_params->v.arr.len != args->v.arr.len) {
     errf(p, "sircc: zasm: branch args must match destination block params");
     return false;
@@ -27,7 +27,7 @@ static bool emit_binop_into_hl(
     int64_t width_bytes,
     int64_t* io_line) {
   if (!out || !p || !vn || !vn->fields || !io_line) return false;
-  JsonValue* args = json_obj_get(vn->fields, "args");
+  JsonValue* args = json_obj_get_sym(vn->fields, JSON_KEY_ARGS);
   if (!args || args->type != JSON_ARRAY || args->v.arr.len != 2) {
     errf(p, "sircc: zasm: %s node %lld requires args:[a,b]", vn->tag, (long long)vn->id);
     return false;
@@ -97,13 +97,13 @@ bool emit_zir_nonterm_stmt(
   if (!out || !p || !names || !name_len || !name_cap || !s || !io_line) return false;
   zasm_set_about_node(s->id, s->tag);
 
-  if (strcmp(s->tag, "let") == 0) {
+  if (sir_node_tag(p, s) == SIR_NODE_LET) {
     // let: fields.name (str), fields.value (ref).
     const char* bind_name = NULL;
-    JsonValue* nv = s->fields ? json_obj_get(s->fields, "name") : NULL;
+    JsonValue* nv = s->fields ? json_obj_get_sym(s->fields, JSON_KEY_NAME) : NULL;
     if (nv && nv->type == JSON_STRING) bind_name = nv->v.s;
     int64_t vid = 0;
-    JsonValue* vv = s->fields ? json_obj_get(s->fields, "value") : NULL;
+    JsonValue* vv = s->fields ? json_obj_get_sym(s->fields, JSON_KEY_VALUE) : NULL;
     if (!parse_node_ref_id(p, vv, &vid)) {
       errf(p, "sircc: zasm: let node %lld requires fields.value node ref", (long long)s->id);
       return false;
@@ -135,19 +135,19 @@ bool emit_zir_nonterm_stmt(
       int64_t width = 0;
       const char* m = NULL;
       const char* dst_reg = NULL;
-      if (strcmp(vn->tag, "load.i8") == 0) {
+      if (sir_node_tag(p, vn) == SIR_NODE_LOAD_I8) {
         width = 1;
         m = "LD8U";
         dst_reg = "A";
-      } else if (strcmp(vn->tag, "load.i16") == 0) {
+      } else if (sir_node_tag(p, vn) == SIR_NODE_LOAD_I16) {
         width = 2;
         m = "LD16U";
         dst_reg = "HL";
-      } else if (strcmp(vn->tag, "load.i32") == 0) {
+      } else if (sir_node_tag(p, vn) == SIR_NODE_LOAD_I32) {
         width = 4;
         m = "LD32U64";
         dst_reg = "HL";
-      } else if (strcmp(vn->tag, "load.i64") == 0 || strcmp(vn->tag, "load.ptr") == 0) {
+      } else if (sir_node_tag(p, vn) == SIR_NODE_LOAD_I64 || sir_node_tag(p, vn) == SIR_NODE_LOAD_PTR) {
         width = 8;
         m = "LD64";
         dst_reg = "HL";
@@ -157,7 +157,7 @@ bool emit_zir_nonterm_stmt(
       }
 
       int64_t addr_id = 0;
-      JsonValue* av = vn->fields ? json_obj_get(vn->fields, "addr") : NULL;
+      JsonValue* av = vn->fields ? json_obj_get_sym(vn->fields, JSON_KEY_ADDR) : NULL;
       if (!parse_node_ref_id(p, av, &addr_id)) {
         errf(p, "sircc: zasm: %s node %lld requires fields.addr node ref", vn->tag, (long long)vn->id);
         return false;
@@ -234,7 +234,7 @@ bool emit_zir_nonterm_stmt(
         return false;
       }
 
-      JsonValue* args = vn->fields ? json_obj_get(vn->fields, "args") : NULL;
+      JsonValue* args = vn->fields ? json_obj_get_sym(vn->fields, JSON_KEY_ARGS) : NULL;
       if (!args || args->type != JSON_ARRAY || args->v.arr.len != 1) {
         errf(p, "sircc: zasm: %s node %lld requires args:[x]", vn->tag, (long long)vn->id);
         return false;
@@ -281,14 +281,14 @@ bool emit_zir_nonterm_stmt(
     return true;
   }
 
-  if (strcmp(s->tag, "mem.fill") == 0) {
+  if (sir_node_tag(p, s) == SIR_NODE_MEM_FILL) {
     zasm_regcache_clear_all();
     if (!zasm_emit_mem_fill_stmt(out, p, strs, strs_len, allocas, allocas_len, *names, *name_len, bps, bps_len, s, io_line)) return false;
     zasm_regcache_clear_all();
     return true;
   }
 
-  if (strcmp(s->tag, "mem.copy") == 0) {
+  if (sir_node_tag(p, s) == SIR_NODE_MEM_COPY) {
     zasm_regcache_clear_all();
     if (!zasm_emit_mem_copy_stmt(out, p, strs, strs_len, allocas, allocas_len, *names, *name_len, bps, bps_len, s, io_line)) return false;
     zasm_regcache_clear_all();
@@ -14,8 +14,8 @@ NodeRec* zasm_find_fn(SirProgram* p, const char* name) {
   for (size_t i = 0; i < p->nodes_cap; i++) {
     NodeRec* n = p->nodes[i];
     if (!n) continue;
-    if (strcmp(n->tag, "fn") != 0) continue;
-    const char* nm = n->fields ? json_get_string(json_obj_get(n->fields, "name")) : NULL;
+    if (sir_node_tag(p, n) != SIR_NODE_FN) continue;
+    const char* nm = n->fields ? json_get_string(json_obj_get_sym(n->fields, JSON_KEY_NAME)) : NULL;
     if (nm && strcmp(nm, name) == 0) return n;
   }
   return NULL;
@@ -47,9 +47,9 @@ bool zasm_collect_cstrs(SirProgram* p, ZasmStr** out_strs, size_t* out_len) {
   for (size_t i = 0; i < p->nodes_cap; i++) {
     NodeRec* n = p->nodes[i];
     if (!n) continue;
-    if (strcmp(n->tag, "cstr") != 0) continue;
+    if (sir_node_tag(p, n) != SIR_NODE_CSTR) continue;
     if (!n->fields) continue;
-    const char* s = json_get_string(json_obj_get(n->fields, "value"));
+    const char* s = json_get_string(json_obj_get_sym(n->fields, JSON_KEY_VALUE));
     if (!s) continue;
 
     if (len == cap) {
@@ -179,8 +179,8 @@ bool zasm_collect_decl_fns(SirProgram* p, const char*** out_names, size_t* out_l
   for (size_t i = 0; i < p->nodes_cap; i++) {
     NodeRec* n = p->nodes[i];
     if (!n) continue;
-    if (strcmp(n->tag, "decl.fn") != 0) continue;
-    const char* name = n->fields ? json_get_string(json_obj_get(n->fields, "name")) : NULL;
+    if (sir_node_tag(p, n) != SIR_NODE_DECL_FN) continue;
+    const char* name = n->fields ? json_get_string(json_obj_get_sym(n->fields, JSON_KEY_NAME)) : NULL;
     if (!name) continue;
 
     bool seen = false;
@@ -112,7 +112,7 @@ bool zasm_emit_call_stmt(
   NodeRec* n = get_node(p, call_id);
   if (!n || !n->fields) return false;
 
-  JsonValue* args = json_obj_get(n->fields, "args");
+  JsonValue* args = json_obj_get_sym(n->fields, JSON_KEY_ARGS);
   if (!args || args->type != JSON_ARRAY || args->v.arr.len < 1) {
     zasm_err_node_codef(p, call_id, n->tag, "sircc.zasm.call.bad_args", "sircc: zasm: %s node %lld missing args array", n->tag,
                         (long long)call_id);
@@ -212,19 +212,19 @@ bool zasm_emit_store_stmt(
   int64_t width = 0;
   const char* mnemonic = NULL;
   const char* value_reg = NULL;
-  if (strcmp(s->tag, "store.i8") == 0) {
+  if (sir_node_tag(p, s) == SIR_NODE_STORE_I8) {
     width = 1;
     mnemonic = "ST8";
     value_reg = "A";
-  } else if (strcmp(s->tag, "store.i16") == 0) {
+  } else if (sir_node_tag(p, s) == SIR_NODE_STORE_I16) {
     width = 2;
     mnemonic = "ST16";
     value_reg = "HL";
-  } else if (strcmp(s->tag, "store.i32") == 0) {
+  } else if (sir_node_tag(p, s) == SIR_NODE_STORE_I32) {
     width = 4;
     mnemonic = "ST32";
     value_reg = "HL";
-  } else if (strcmp(s->tag, "store.i64") == 0) {
+  } else if (sir_node_tag(p, s) == SIR_NODE_STORE_I64) {
     width = 8;
     mnemonic = "ST64";
     value_reg = "HL";
@@ -235,8 +235,8 @@ bool zasm_emit_store_stmt(
 
   int64_t addr_id = 0;
   int64_t value_id = 0;
-  JsonValue* av = json_obj_get(s->fields, "addr");
-  JsonValue* vv = json_obj_get(s->fields, "value");
+  JsonValue* av = json_obj_get_sym(s->fields, JSON_KEY_ADDR);
+  JsonValue* vv = json_obj_get_sym(s->fields, JSON_KEY_VALUE);
   if (!parse_node_ref_id(p, av, &addr_id) || !parse_node_ref_id(p, vv, &value_id)) {
     errf(p, "sircc: zasm: %s node %lld requires fields.addr/value node refs", s->tag, (long long)s->id);
     return false;
@@ -299,7 +299,7 @@ bool zasm_emit_mem_fill_stmt(
     NodeRec* s,
     int64_t* io_line) {
   if (!out || !p || !s || !s->fields || !io_line) return false;
-  JsonValue* args = json_obj_get(s->fields, "args");
+  JsonValue* args = json_obj_get_sym(s->fields, JSON_KEY_ARGS);
   if (!args || args->type != JSON_ARRAY || args->v.arr.len != 3) {
     errf(p, "sircc: zasm: mem.fill node %lld requires args:[dst, byte, len]", (long long)s->id);
     return false;
@@ -360,7 +360,7 @@ bool zasm_emit_mem_copy_stmt(
     NodeRec* s,
     int64_t* io_line) {
   if (!out || !p || !s || !s->fields || !io_line) return false;
-  JsonValue* args = json_obj_get(s->fields, "args");
+  JsonValue* args = json_obj_get_sym(s->fields, JSON_KEY_ARGS);
   if (!args || args->type != JSON_ARRAY || args->v.arr.len != 3) {
     errf(p, "sircc: zasm: mem.copy node %lld requires args:[dst, src, len]", (long long)s->id);
     return false;
@@ -423,8 +423,8 @@ bool zasm_emit_ret_value_to_hl(
     return false;
   }
 
-  if (strcmp(v->tag, "i32.zext.i8") == 0) {
-    JsonValue* args = v->fields ? json_obj_get(v->fields, "args") : NULL;
+  if (sir_node_tag(p, v) == SIR_NODE_I32_ZEXT_I8) {
+    JsonValue* args = v->fields ? json_obj_get_sym(v->fields, JSON_KEY_ARGS) : NULL;
     if (!args || args->type != JSON_ARRAY || args->v.arr.len != 1) {
       errf(p, "sircc: zasm: i32.zext.i8 node %lld requires args:[x]", (long long)value_id);
       return false;
@@ -440,9 +440,9 @@ bool zasm_emit_ret_value_to_hl(
       return false;
     }
 
-    if (strcmp(x->tag, "load.i8") == 0) {
+    if (sir_node_tag(p, x) == SIR_NODE_LOAD_I8) {
       int64_t addr_id = 0;
-      JsonValue* av = x->fields ? json_obj_get(x->fields, "addr") : NULL;
+      JsonValue* av = x->fields ? json_obj_get_sym(x->fields, JSON_KEY_ADDR) : NULL;
       if (!parse_node_ref_id(p, av, &addr_id)) {
         errf(p, "sircc: zasm: load.i8 node %lld requires fields.addr node ref", (long long)x_id);
         return false;
@@ -472,9 +472,9 @@ bool zasm_emit_ret_value_to_hl(
     return emit_ld(out, "HL", &z, (*io_line)++);
   }
 
-  if (strcmp(v->tag, "load.i8") == 0) {
+  if (sir_node_tag(p, v) == SIR_NODE_LOAD_I8) {
     int64_t addr_id = 0;
-    JsonValue* av = v->fields ? json_obj_get(v->fields, "addr") : NULL;
+    JsonValue* av = v->fields ? json_obj_get_sym(v->fields, JSON_KEY_ADDR) : NULL;
     if (!parse_node_ref_id(p, av, &addr_id)) {
       errf(p, "sircc: zasm: load.i8 node %lld requires fields.addr node ref", (long long)value_id);
       return false;
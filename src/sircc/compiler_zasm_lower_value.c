@@ -35,7 +35,7 @@ bool zasm_lower_value_to_op(
       return false;
     }
     int64_t v = 0;
-    if (!must_i64(p, json_obj_get(n->fields, "value"), &v, "const.value")) return false;
+    if (!must_i64(p, json_obj_get_sym(n->fields, JSON_KEY_VALUE), &v, "const.value")) return false;
     out->k = ZOP_NUM;
     out->n = v;
     return true;
@@ -53,7 +53,7 @@ bool zasm_lower_value_to_op(
     return true;
   }
 
-  if (strcmp(n->tag, "bparam") == 0) {
+  if (sir_node_tag(p, n) == SIR_NODE_BPARAM) {
     for (size_t i = 0; i < bps_len; i++) {
       if (bps[i].node_id == node_id) {
         out->k = ZOP_SLOT;
@@ -67,7 +67,7 @@ bool zasm_lower_value_to_op(
     return false;
   }
 
-  if (strcmp(n->tag, "cstr") == 0) {
+  if (sir_node_tag(p, n) == SIR_NODE_CSTR) {
     const char* sym = zasm_sym_for_str(strs, strs_len, node_id);
     if (!sym) {
       zasm_err_node_codef(p, node_id, n->tag, "sircc.zasm.mapping.missing", "sircc: zasm: missing cstr symbol mapping for node %lld",
@@ -79,8 +79,8 @@ bool zasm_lower_value_to_op(
     return true;
   }
 
-  if (strcmp(n->tag, "decl.fn") == 0) {
-    const char* name = n->fields ? json_get_string(json_obj_get(n->fields, "name")) : NULL;
+  if (sir_node_tag(p, n) == SIR_NODE_DECL_FN) {
+    const char* name = n->fields ? json_get_string(json_obj_get_sym(n->fields, JSON_KEY_NAME)) : NULL;
     if (!name) {
       zasm_err_node_codef(p, node_id, n->tag, "sircc.zasm.node.missing_field",
                           "sircc: zasm: decl.fn node %lld missing fields.name", (long long)node_id);
@@ -91,9 +91,9 @@ bool zasm_lower_value_to_op(
     return true;
   }
 
-  if (strcmp(n->tag, "ptr.sym") == 0) {
+  if (sir_node_tag(p, n) == SIR_NODE_PTR_SYM) {
     const char* name = NULL;
-    if (n->fields) name = json_get_string(json_obj_get(n->fields, "name"));
+    if (n->fields) name = json_get_string(json_obj_get_sym(n->fields, JSON_KEY_NAME));
     if (!name) {
       zasm_err_node_codef(p, node_id, n->tag, "sircc.zasm.node.missing_field",
                           "sircc: zasm: ptr.sym node %lld missing fields.name", (long long)node_id);
@@ -111,12 +111,12 @@ bool zasm_lower_value_to_op(
       return false;
     }
     int64_t ty_id = 0;
-    if (!parse_type_ref_id(p, json_obj_get(n->fields, "ty"), &ty_id)) {
+    if (!parse_type_ref_id(p, json_obj_get_sym(n->fields, JSON_KEY_TY), &ty_id)) {
       zasm_err_node_codef(p, node_id, n->tag, "sircc.zasm.node.missing_field", "sircc: zasm: %s node %lld missing fields.ty (type ref)",
                           n->tag, (long long)node_id);
       return false;
     }
-    JsonValue* args = json_obj_get(n->fields, "args");
+    JsonValue* args = json_obj_get_sym(n->fields, JSON_KEY_ARGS);
     if (!args || args->type != JSON_ARRAY || args->v.arr.len != 0) {
       zasm_err_node_codef(p, node_id, n->tag, "sircc.zasm.value.bad_args", "sircc: zasm: %s node %lld requires args:[]", n->tag,
                           (long long)node_id);
@@ -142,18 +142,19 @@ bool zasm_lower_value_to_op(
     if (dot) {
       const char* op = dot + 1;
       if (strncmp(op, "zext.i", 6) == 0 || strncmp(op, "sext.i", 6) == 0 || strncmp(op, "trunc.i", 7) == 0) {
-        JsonValue* args = n->fields ? json_obj_get(n->fields, "args") : NULL;
-        if (!args || args->type != JSON_ARRAY || args->v.arr.len != 1) {
+        int64_t arg_ids[1];
+        bool refs_ok = false;
+        if (!sir_node_args_n(p, n, 1, arg_ids, &refs_ok)) {
           zasm_err_node_codef(p, node_id, n->tag, "sircc.zasm.value.bad_args", "sircc: zasm: %s node %lld requires args:[x]", n->tag,
                               (long long)node_id);
           return false;
         }
-        int64_t x_id = 0;
-        if (!parse_node_ref_id(p, args->v.arr.items[0], &x_id)) {
+        if (!refs_ok) {
           zasm_err_node_codef(p, node_id, n->tag, "sircc.zasm.value.bad_args", "sircc: zasm: %s node %lld arg must be node ref", n->tag,
                               (long long)node_id);
           return false;
         }
+        int64_t x_id = arg_ids[0];
         ZasmOp x = {0};
         if (!zasm_lower_value_to_op(p, strs, strs_len, allocas, allocas_len, names, names_len, bps, bps_len, x_id, &x)) return false;
         if (x.k != ZOP_NUM) {
@@ -197,23 +198,24 @@ bool zasm_lower_value_to_op(
   }
 
   if (strcmp(n->tag, "ptr.to_i64") == 0) {
-    JsonValue* args = n->fields ? json_obj_get(n->fields, "args") : NULL;
-    if (!args || args->type != JSON_ARRAY || args->v.arr.len != 1) {
+    int64_t arg_ids[1];
+    bool refs_ok = false;
+    if (!sir_node_args_n(p, n, 1, arg_ids, &refs_ok)) {
       zasm_err_node_codef(p, node_id, n->tag, "sircc.zasm.value.bad_args",
                           "sircc: zasm: ptr.to_i64 node %lld requires args:[x]", (long long)node_id);
       return false;
     }
-    int64_t x_id = 0;
-    if (!parse_node_ref_id(p, args->v.arr.items[0], &x_id)) {
+    if (!refs_ok) {
       zasm_err_node_codef(p, node_id, n->tag, "sircc.zasm.value.bad_args",
                           "sircc: zasm: ptr.to_i64 node %lld arg must be node ref", (long long)node_id);
       return false;
     }
+    int64_t x_id = arg_ids[0];
     return zasm_lower_value_to_op(p, strs, strs_len, allocas, allocas_len, names, names_len, bps, bps_len, x_id, out);
   }
 
-  if (strcmp(n->tag, "name") == 0) {
-    const char* name = n->fields ? json_get_string(json_obj_get(n->fields, "name")) : NULL;
+  if (sir_node_tag(p, n) == SIR_NODE_NAME) {
+    const char* name = n->fields ? json_get_string(json_obj_get_sym(n->fields, JSON_KEY_NAME)) : NULL;
     if (!name) {
       zasm_err_node_codef(p, node_id, n->tag, "sircc.zasm.node.missing_field", "sircc: zasm: name node %lld missing fields.name",
                           (long long)node_id);
@@ -9,13 +9,225 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define JSON_SCAN_ISA "avx2"
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define JSON_SCAN_ISA "sse2"
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define JSON_SCAN_ISA "neon"
+#else
+#define JSON_SCAN_ISA "scalar"
+#endif
+
+// Indexed mode (simdjson "stage 1" style): before parsing, one vector pass over
+// the input builds two bitmaps, one bit per byte: bytes that are not JSON
+// whitespace, and quote/backslash bytes. The recursive-descent parser below is
+// unchanged except that skip_ws and the string body loop jump with a
+// count-trailing-zeros over those bitmaps instead of stepping byte by byte, and
+// strings without escapes are copied straight out of the input. Both
+// bitmaps are independent of string state, so every jump lands on exactly the
+// byte the scalar loop would have stopped at and error offsets are identical.
+#define JSON_SCAN_AUTO_MIN 64u     // shorter inputs are parsed without an index
+#define JSON_SCAN_STACK_WORDS 64u  // bitmap words kept on the stack (4 KiB input)
+
 typedef struct Parser {
   Arena* arena;
   const char* s;
   size_t i;
   JsonError* err;
+
+  // Indexed mode only (NULL otherwise); bits at or past `len` are meaningless.
+  size_t len;
+  size_t words;
+  const uint64_t* nonws;   // not ' ', '\n', '\r', '\t'
+  const uint64_t* special; // '"' or '\\'
 } Parser;
 
+static unsigned ctz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (unsigned)__builtin_ctzll(x);
+#else
+  unsigned n = 0;
+  while (!(x & 1u)) {
+    x >>= 1;
+    n++;
+  }
+  return n;
+#endif
+}
+
+// First set bit at or after `i`, or `len` when there is none before the end.
+static size_t next_bit(const Parser* p, const uint64_t* bits, size_t i) {
+  if (i >= p->len) return p->len;
+  size_t w = i >> 6;
+  uint64_t x = bits[w] & (~0ull << (i & 63u));
+  while (!x) {
+    if (++w >= p->words) return p->len;
+    x = bits[w];
+  }
+  const size_t at = (w << 6) + ctz64(x);
+  return at < p->len ? at : p->len;
+}
+
+// Classifies one 64-byte block: *ws gets whitespace bytes, *qb quotes/backslashes.
+static void scan_block(const unsigned char* b, uint64_t* ws, uint64_t* qb) {
+#if defined(__AVX2__)
+  uint64_t w = 0, q = 0;
+  for (unsigned k = 0; k < 2; k++) {
+    const __m256i v = _mm256_loadu_si256((const __m256i*)(const void*)(b + 32u * k));
+    const __m256i sp = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')));
+    const __m256i cr = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t')));
+    const __m256i qs = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\')));
+    w |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_or_si256(sp, cr)) << (32u * k);
+    q |= (uint64_t)(uint32_t)_mm256_movemask_epi8(qs) << (32u * k);
+  }
+  *ws = w;
+  *qb = q;
+#elif defined(__SSE2__) || defined(_M_X64)
+  uint64_t w = 0, q = 0;
+  for (unsigned k = 0; k < 4; k++) {
+    const __m128i v = _mm_loadu_si128((const __m128i*)(const void*)(b + 16u * k));
+    const __m128i sp = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+    const __m128i cr = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+    const __m128i qs = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+    w |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_or_si128(sp, cr)) << (16u * k);
+    q |= (uint64_t)(uint16_t)_mm_movemask_epi8(qs) << (16u * k);
+  }
+  *ws = w;
+  *qb = q;
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+  static const uint8_t weights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+  const uint8x16_t bitw = vld1q_u8(weights);
+  uint8x16_t wm[4], qm[4];
+  for (unsigned k = 0; k < 4; k++) {
+    const uint8x16_t v = vld1q_u8(b + 16u * k);
+    const uint8x16_t sp = vorrq_u8(vceqq_u8(v, vdupq_n_u8(' ')), vceqq_u8(v, vdupq_n_u8('\n')));
+    const uint8x16_t cr = vorrq_u8(vceqq_u8(v, vdupq_n_u8('\r')), vceqq_u8(v, vdupq_n_u8('\t')));
+    const uint8x16_t qs = vorrq_u8(vceqq_u8(v, vdupq_n_u8('"')), vceqq_u8(v, vdupq_n_u8('\\')));
+    wm[k] = vandq_u8(vorrq_u8(sp, cr), bitw);
+    qm[k] = vandq_u8(qs, bitw);
+  }
+  // Pairwise adds fold each lane group of 8 weighted bytes into one mask byte.
+  uint8x16_t ws0 = vpaddq_u8(vpaddq_u8(wm[0], wm[1]), vpaddq_u8(wm[2], wm[3]));
+  uint8x16_t qb0 = vpaddq_u8(vpaddq_u8(qm[0], qm[1]), vpaddq_u8(qm[2], qm[3]));
+  ws0 = vpaddq_u8(ws0, ws0);
+  qb0 = vpaddq_u8(qb0, qb0);
+  *ws = vgetq_lane_u64(vreinterpretq_u64_u8(ws0), 0);
+  *qb = vgetq_lane_u64(vreinterpretq_u64_u8(qb0), 0);
+#else
+  uint64_t w = 0, q = 0;
+  for (unsigned k = 0; k < 64; k++) {
+    const unsigned char c = b[k];
+    if (c == ' ' || c == '\n' || c == '\r' || c == '\t') w |= 1ull << k;
+    if (c == '"' || c == '\\') q |= 1ull << k;
+  }
+  *ws = w;
+  *qb = q;
+#endif
+}
+
+// Fills `bits` (2 * words entries: nonws then special) for s[0..len).
+static void scan_index(const char* s, size_t len, size_t words, uint64_t* bits) {
+  const unsigned char* u = (const unsigned char*)s;
+  const size_t full = len / 64u;
+  uint64_t ws = 0, qb = 0;
+  for (size_t w = 0; w < full; w++) {
+    scan_block(u + 64u * w, &ws, &qb);
+    bits[w] = ~ws;
+    bits[words + w] = qb;
+  }
+  if (full < words) {
+    unsigned char tail[64];
+    memset(tail, 0, sizeof(tail));
+    memcpy(tail, u + 64u * full, len - 64u * full);
+    scan_block(tail, &ws, &qb);
+    bits[full] = ~ws;
+    bits[words + full] = qb;
+  }
+}
+
+const char* json_scan_isa(void) {
+  return JSON_SCAN_ISA;
+}
+
+// Interned keys: one static object holds every well-known key, so "is this an
+// interned key" is a range check and two interned keys are equal iff their
+// pointers are.
+#define JSON_KEY(name, kw) char name[sizeof(kw)];
+static const struct JsonKeyPool {
+#include "json_keys.def"
+} json_key_pool = {
+#undef JSON_KEY
+#define JSON_KEY(name, kw) kw,
+#include "json_keys.def"
+};
+#undef JSON_KEY
+
+#define JSON_KEY(name, kw) json_key_pool.name,
+static const char* const json_key_names[JSON_KEYS_COUNT] = {
+    NULL,
+#include "json_keys.def"
+};
+#undef JSON_KEY
+
+typedef struct json_ph_key {
+  const char* name;
+  uint32_t len;
+  uint32_t id;
+} json_ph_key_t;
+
+typedef struct json_ph_table {
+  const int32_t* disp;
+  const json_ph_key_t* keys;
+  uint32_t n;
+} json_ph_table_t;
+
+// Generated at configure time by src/sircc/tools/gen_tag_table.py.
+#include "json_keys.generated.h"
+
+static uint32_t json_ph_hash(uint32_t seed, const char* s, size_t n) {
+  // FNV-1a 32-bit (seeded basis) + fmix32; must match gen_tag_table.py.
+  uint32_t h = 0x811C9DC5u ^ seed;
+  for (size_t i = 0; i < n; i++) {
+    h ^= (uint32_t)(uint8_t)s[i];
+    h *= 0x01000193u;
+  }
+  h ^= h >> 16;
+  h *= 0x85EBCA6Bu;
+  h ^= h >> 13;
+  h *= 0xC2B2AE35u;
+  h ^= h >> 16;
+  return h;
+}
+
+static JsonKey key_lookup_n(const char* s, size_t len) {
+  const json_ph_table_t* t = &json_key_ph;
+  const int32_t d = t->disp[json_ph_hash(0, s, len) % t->n];
+  const uint32_t slot = (d < 0) ? (uint32_t)(-(d + 1)) : json_ph_hash((uint32_t)d, s, len) % t->n;
+  const json_ph_key_t* k = &t->keys[slot];
+  if (k->len != len || memcmp(k->name, s, len) != 0) return JSON_KEY_NONE;
+  return (JsonKey)k->id;
+}
+
+static bool key_is_interned(const char* k) {
+  const uintptr_t u = (uintptr_t)k;
+  const uintptr_t lo = (uintptr_t)&json_key_pool;
+  return u >= lo && u < lo + sizeof(json_key_pool);
+}
+
+JsonKey json_key_lookup(const char* s) {
+  if (!s) return JSON_KEY_NONE;
+  return key_lookup_n(s, strlen(s));
+}
+
+const char* json_key_name(JsonKey key) {
+  if ((unsigned)key >= (unsigned)JSON_KEYS_COUNT) return NULL;
+  return json_key_names[key];
+}
+
 static void set_err(Parser* p, const char* msg) {
   if (p->err && !p->err->msg) {
     p->err->offset = p->i;
@@ -24,6 +236,10 @@ static void set_err(Parser* p, const char* msg) {
 }
 
 static void skip_ws(Parser* p) {
+  if (p->nonws) {
+    if (p->i < p->len) p->i = next_bit(p, p->nonws, p->i);
+    return;
+  }
   while (p->s[p->i] && (p->s[p->i] == ' ' || p->s[p->i] == '\n' || p->s[p->i] == '\r' ||
                         p->s[p->i] == '\t')) {
     p->i++;
@@ -98,6 +314,24 @@ static bool parse_string(Parser* p, JsonValue** out) {
     return false;
   }
 
+  if (p->special) {
+    // No escape before the closing quote: copy the body straight out of the input.
+    const size_t j = next_bit(p, p->special, p->i);
+    if (j < p->len && p->s[j] == '"') {
+      const size_t n = j - p->i;
+      char* s = (char*)arena_alloc(p->arena, n + 1);
+      if (!s) return false;
+      memcpy(s, p->s + p->i, n);
+      s[n] = 0;
+      p->i = j + 1;
+      JsonValue* str = make(p, JSON_STRING);
+      if (!str) return false;
+      str->v.s = s;
+      *out = str;
+      return true;
+    }
+  }
+
   // Decode into a temporary buffer and then arena-dup.
   size_t cap = 64;
   size_t len = 0;
@@ -105,6 +339,26 @@ static bool parse_string(Parser* p, JsonValue** out) {
   if (!tmp) return false;
 
   while (p->s[p->i]) {
+    if (p->special) {
+      // Copy the run up to the next quote/backslash (or the end) in one go.
+      const size_t j = next_bit(p, p->special, p->i);
+      if (j > p->i) {
+        const size_t run = j - p->i;
+        if (len + run + 2 > cap) {
+          size_t new_cap = cap * 2;
+          while (len + run + 2 > new_cap) new_cap *= 2;
+          char* bigger = (char*)arena_alloc(p->arena, new_cap);
+          if (!bigger) return false;
+          memcpy(bigger, tmp, len);
+          tmp = bigger;
+          cap = new_cap;
+        }
+        memcpy(tmp + len, p->s + p->i, run);
+        len += run;
+        p->i = j;
+        if (!p->s[p->i]) break;
+      }
+    }
     char c = p->s[p->i++];
     if (c == '"') break;
     if (c == '\\') {
@@ -189,6 +443,33 @@ void json_write_escaped(FILE* out, const char* s) {
   fputc('"', out);
 }
 
+// Object keys: well-known keys resolve to their interned pointer straight from
+// the input, without decoding a copy first.
+static bool parse_key(Parser* p, const char** out) {
+  if (p->s[p->i] == '"') {
+    const size_t start = p->i + 1;
+    size_t j = start;
+    if (p->special) {
+      j = next_bit(p, p->special, start);
+    } else {
+      while (p->s[j] && p->s[j] != '"' && p->s[j] != '\\') j++;
+    }
+    if (p->s[j] == '"') {
+      const JsonKey sym = key_lookup_n(p->s + start, j - start);
+      if (sym != JSON_KEY_NONE) {
+        p->i = j + 1;
+        *out = json_key_names[sym];
+        return true;
+      }
+    }
+  }
+  JsonValue* keyv = NULL;
+  if (!parse_string(p, &keyv)) return false;
+  const JsonKey sym = json_key_lookup(keyv->v.s);
+  *out = (sym != JSON_KEY_NONE) ? json_key_names[sym] : keyv->v.s;
+  return true;
+}
+
 static bool parse_array(Parser* p, JsonValue** out) {
   if (!consume(p, '[')) {
     set_err(p, "expected '['");
@@ -262,9 +543,8 @@ static bool parse_object(Parser* p, JsonValue** out) {
 
   while (true) {
     skip_ws(p);
-    JsonValue* keyv = NULL;
-    if (!parse_string(p, &keyv)) return false;
-    const char* key = keyv->v.s;
+    const char* key = NULL;
+    if (!parse_key(p, &key)) return false;
     skip_ws(p);
     if (!consume(p, ':')) {
       set_err(p, "expected ':'");
@@ -333,19 +613,46 @@ static bool parse_value(Parser* p, JsonValue** out) {
   return false;
 }
 
-bool json_parse(Arena* arena, const char* input, JsonValue** out, JsonError* err) {
+bool json_parse_mode(Arena* arena, const char* input, JsonParseMode mode, JsonValue** out, JsonError* err) {
   if (err) {
     err->msg = NULL;
     err->offset = 0;
   }
   Parser p = {.arena = arena, .s = input, .i = 0, .err = err};
-  if (!parse_value(&p, out)) return false;
-  skip_ws(&p);
-  if (p.s[p.i] != 0) {
-    set_err(&p, "trailing characters");
-    return false;
+
+  uint64_t stack_bits[2 * JSON_SCAN_STACK_WORDS];
+  uint64_t* heap_bits = NULL;
+  if (mode != JSON_PARSE_SCALAR) {
+    const size_t len = strlen(input);
+    if (mode == JSON_PARSE_INDEXED || len >= JSON_SCAN_AUTO_MIN) {
+      const size_t words = len / 64u + 1u;
+      uint64_t* bits = stack_bits;
+      if (words > JSON_SCAN_STACK_WORDS) bits = heap_bits = (uint64_t*)malloc(2 * words * sizeof(uint64_t));
+      if (bits) {
+        scan_index(input, len, words, bits);
+        p.len = len;
+        p.words = words;
+        p.nonws = bits;
+        p.special = bits + words;
+      }
+      // Without scratch memory the scalar walk gives the same result.
+    }
   }
-  return true;
+
+  bool ok = parse_value(&p, out);
+  if (ok) {
+    skip_ws(&p);
+    if (p.s[p.i] != 0) {
+      set_err(&p, "trailing characters");
+      ok = false;
+    }
+  }
+  free(heap_bits);
+  return ok;
+}
+
+bool json_parse(Arena* arena, const char* input, JsonValue** out, JsonError* err) {
+  return json_parse_mode(arena, input, JSON_PARSE_AUTO, out, err);
 }
 
 static JsonValue* obj_get_impl(const JsonValue* obj, const char* key) {
@@ -360,6 +667,19 @@ JsonValue* json_obj_get(const JsonValue* obj, const char* key) {
   return obj_get_impl(obj, key);
 }
 
+JsonValue* json_obj_get_sym(const JsonValue* obj, JsonKey key) {
+  if (!obj || obj->type != JSON_OBJECT) return NULL;
+  const char* want = json_key_name(key);
+  if (!want) return NULL;
+  for (size_t i = 0; i < obj->v.obj.len; i++) {
+    const char* k = obj->v.obj.items[i].key;
+    if (k == want) return obj->v.obj.items[i].value;
+    // Keys set by hand (not via json_parse or json_key_name) still match by content.
+    if (!key_is_interned(k) && strcmp(k, want) == 0) return obj->v.obj.items[i].value;
+  }
+  return NULL;
+}
+
 bool json_obj_has_only_keys(const JsonValue* obj, const char* const* keys, size_t key_count, const char** out_bad) {
   if (out_bad) *out_bad = NULL;
   if (!obj || obj->type != JSON_OBJECT) return false;
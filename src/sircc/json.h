@@ -52,9 +52,36 @@ typedef struct JsonError {
   const char* msg;
 } JsonError;
 
+typedef enum JsonParseMode {
+  JSON_PARSE_AUTO = 0, // indexed for inputs of 64 bytes or more, scalar below
+  JSON_PARSE_SCALAR,   // byte-at-a-time recursive descent
+  JSON_PARSE_INDEXED,  // vector pre-scan (whitespace/quote/backslash bitmaps), then descent
+} JsonParseMode;
+
+// Parses a NUL-terminated JSON text. All modes build the same tree and report the
+// same error offset and message for the same input.
 bool json_parse(Arena* arena, const char* input, JsonValue** out, JsonError* err);
+bool json_parse_mode(Arena* arena, const char* input, JsonParseMode mode, JsonValue** out, JsonError* err);
+// Instruction set used by JSON_PARSE_INDEXED ("avx2", "sse2", "neon" or "scalar").
+const char* json_scan_isa(void);
+
+// Well-known object keys (json_keys.def). json_parse stores these keys as the
+// canonical json_key_name() pointers.
+#define JSON_KEY(name, kw) JSON_KEY_##name,
+typedef enum JsonKey {
+  JSON_KEY_NONE = 0,
+#include "json_keys.def"
+  JSON_KEYS_COUNT, // number of JsonKey values (not a key)
+} JsonKey;
+#undef JSON_KEY
 
 JsonValue* json_obj_get(const JsonValue* obj, const char* key);
+// Same as json_obj_get(obj, json_key_name(key)), matching interned keys by pointer.
+JsonValue* json_obj_get_sym(const JsonValue* obj, JsonKey key);
+// Canonical spelling of `key` (NULL for JSON_KEY_NONE); use it when building objects.
+const char* json_key_name(JsonKey key);
+// JSON_KEY_NONE when `s` is not a well-known key.
+JsonKey json_key_lookup(const char* s);
 bool json_obj_has_only_keys(const JsonValue* obj, const char* const* keys, size_t key_count, const char** out_bad);
 const char* json_get_string(const JsonValue* v);
 bool json_get_i64(const JsonValue* v, int64_t* out);
@@ -116,6 +116,11 @@ static void usage(FILE* out) {
           "\n"
           "Usage:\n"
           "  sircc <input.sir.jsonl> -o <output> [--emit-llvm|--emit-obj|--emit-zasm] [--clang <path>] [--target-triple <triple>]\n"
+          "  sircc <input.sir.jsonl> -o <output> [-O0|-O1|-O2|-O3|-Os|-Oz] [--emit-llvm-pre-opt]\n"
+          "  sircc <input.sir.jsonl> -o <output> -j N [-O2 ...]\n"
+          "  sircc <a.sir.jsonl> <b.sir.jsonl>... -o <output> [-O2 ...]\n"
+          "  sircc --stream <input.sir.jsonl> -o <output> [-O2 ...]\n"
+          "  sircc --cache-dir <dir> <input.sir.jsonl> -o <output> [-O2 ...]\n"
           "  sircc <input.sir.jsonl> -o <output.zasm.jsonl> --emit-zasm [--emit-zasm-map <map.jsonl>]\n"
           "  sircc [--prelude <prelude.sir.jsonl>]... <input.sir.jsonl> ...\n"
           "  sircc [--prelude-builtin data_v1|zabi25_min]... <input.sir.jsonl> ...\n"
@@ -133,6 +138,23 @@ static void usage(FILE* out) {
           "  sircc --require-target-contract ...\n"
           "  sircc --version\n"
           "\n"
+          "Inputs:\n"
+          "  Each input is a separate unit with its own ids; units are linked into one module before -O,\n"
+          "  -j and --emit-*, so public fns and syms resolve across them (not with --stream, --cache-dir,\n"
+          "  --lower-hl or --emit-zasm)\n"
+          "\n"
+          "Optimization:\n"
+          "  -O0..-O3, -Os, -Oz Run LLVM's <ON> pipeline before codegen, split per partition under -j N\n"
+          "                     (default: no IR passes)\n"
+          "  --emit-llvm-pre-opt Like --emit-llvm, but write the IR before the optimization pipeline\n"
+          "  -j N, --jobs N     With N > 1, split -O: inline the whole module, then finish optimizing (and\n"
+          "                     codegen) per partition of functions on N threads. Partitions do not depend\n"
+          "                     on N, so output is identical for every N > 1 (default 1: one module)\n"
+          "  --stream           Read the input twice and keep one function's nodes loaded at a time; objects\n"
+          "                     are written every SIRCC_STREAM_CHUNK_BYTES of nodes (executables and --verify-only)\n"
+          "  --cache-dir DIR    Keep an object per group of functions in DIR, keyed by their content, and\n"
+          "                     only recompile groups whose functions changed (executables only)\n"
+          "\n"
           "Lowering:\n"
           "  --lower-hl         Lower supported SIR-HL into Core SIR (no codegen)\n"
           "  --lower-only       Alias for --lower-hl\n"
@@ -162,6 +184,8 @@ int main(int argc, char** argv) {
   size_t prelude_paths_len = 0;
   char prelude_builtin_bufs[32][4096];
   size_t prelude_builtin_bufs_len = 0;
+  const char* extra_input_paths[255];
+  size_t extra_input_paths_len = 0;
 
   SirccOptions opt = {
       .argv0 = (argc > 0) ? argv[0] : NULL,
@@ -348,6 +372,54 @@ int main(int argc, char** argv) {
       opt.emit = SIRCC_EMIT_LLVM_IR;
       continue;
     }
+    if (strcmp(a, "--emit-llvm-pre-opt") == 0) {
+      opt.emit = SIRCC_EMIT_LLVM_IR;
+      opt.emit_llvm_pre_opt = true;
+      continue;
+    }
+    if (a[0] == '-' && a[1] == 'O') {
+      if (strcmp(a, "-O0") == 0) opt.opt_level = SIRCC_OPT_O0;
+      else if (strcmp(a, "-O1") == 0) opt.opt_level = SIRCC_OPT_O1;
+      else if (strcmp(a, "-O2") == 0) opt.opt_level = SIRCC_OPT_O2;
+      else if (strcmp(a, "-O3") == 0) opt.opt_level = SIRCC_OPT_O3;
+      else if (strcmp(a, "-Os") == 0) opt.opt_level = SIRCC_OPT_OS;
+      else if (strcmp(a, "-Oz") == 0) opt.opt_level = SIRCC_OPT_OZ;
+      else {
+        fprintf(stderr, "sircc: invalid optimization level: %s\n", a);
+        return SIRCC_EXIT_USAGE;
+      }
+      continue;
+    }
+    if (strcmp(a, "-j") == 0 || strcmp(a, "--jobs") == 0 || (a[0] == '-' && a[1] == 'j' && a[2])) {
+      const char* v = a + 2;
+      if (!a[2] || a[1] == '-') {
+        if (i + 1 >= argc) {
+          usage(stderr);
+          return SIRCC_EXIT_USAGE;
+        }
+        v = argv[++i];
+      }
+      char* end = NULL;
+      long n = strtol(v, &end, 10);
+      if (!end || end == v || *end != 0 || n < 1 || n > 1024) {
+        fprintf(stderr, "sircc: invalid -j value: %s\n", v);
+        return SIRCC_EXIT_USAGE;
+      }
+      opt.jobs = (int)n;
+      continue;
+    }
+    if (strcmp(a, "--stream") == 0) {
+      opt.stream = true;
+      continue;
+    }
+    if (strcmp(a, "--cache-dir") == 0) {
+      if (i + 1 >= argc) {
+        usage(stderr);
+        return SIRCC_EXIT_USAGE;
+      }
+      opt.cache_dir = argv[++i];
+      continue;
+    }
     if (strcmp(a, "--emit-obj") == 0) {
       opt.emit = SIRCC_EMIT_OBJ;
       continue;
@@ -469,10 +541,12 @@ int main(int argc, char** argv) {
       opt.input_path = a;
       continue;
     }
-
-    fprintf(stderr, "sircc: unexpected argument: %s\n", a);
-    usage(stderr);
-    return SIRCC_EXIT_USAGE;
+    // Further inputs are separate units, compiled and linked with the first.
+    if (extra_input_paths_len >= (sizeof(extra_input_paths) / sizeof(extra_input_paths[0]))) {
+      fprintf(stderr, "sircc: too many inputs (max=%zu)\n", sizeof(extra_input_paths) / sizeof(extra_input_paths[0]) + 1);
+      return SIRCC_EXIT_USAGE;
+    }
+    extra_input_paths[extra_input_paths_len++] = a;
   }
 
   if (opt.print_target) {
@@ -490,6 +564,10 @@ int main(int argc, char** argv) {
     opt.prelude_paths = prelude_paths;
     opt.prelude_paths_len = prelude_paths_len;
   }
+  if (extra_input_paths_len) {
+    opt.extra_input_paths = extra_input_paths;
+    opt.extra_input_paths_len = extra_input_paths_len;
+  }
 
   if (print_support) {
     SirccSupportFormat sf = SIRCC_SUPPORT_TEXT;
@@ -0,0 +1,66 @@
+# Expects:
+#   -DSIRCC=<path to sircc>
+#   -DINPUT=<sir.jsonl>
+#   -DWORK=<scratch dir (cache dir, edited input, executables)>
+#   -DEXPECT=<exit code>
+# Optional:
+#   -DEDIT_FROM=<text> -DEDIT_TO=<text> -DEDIT_EXPECT=<exit code> -DEDIT_REUSED=<"reused N of M">
+#
+# Builds INPUT twice with --cache-dir (the second build must reuse every object), then once more
+# with EDIT_FROM replaced by EDIT_TO.
+
+if(NOT DEFINED SIRCC)
+  message(FATAL_ERROR "cache_reuse.cmake: missing -DSIRCC")
+endif()
+if(NOT DEFINED INPUT OR NOT DEFINED WORK OR NOT DEFINED EXPECT)
+  message(FATAL_ERROR "cache_reuse.cmake: missing -DINPUT, -DWORK or -DEXPECT")
+endif()
+
+file(REMOVE_RECURSE "${WORK}")
+file(MAKE_DIRECTORY "${WORK}")
+
+function(build_and_run input exe want_rc want_err)
+  execute_process(
+    COMMAND "${SIRCC}" --verbose --cache-dir "${WORK}/cache" "${input}" -o "${exe}"
+    RESULT_VARIABLE rc
+    OUTPUT_VARIABLE out
+    ERROR_VARIABLE err
+  )
+  if(NOT rc EQUAL 0)
+    message(FATAL_ERROR "sircc compile failed (rc=${rc})\n${out}\n${err}")
+  endif()
+  if(NOT "${want_err}" STREQUAL "")
+    string(FIND "${err}" "${want_err}" idx)
+    if(idx EQUAL -1)
+      message(FATAL_ERROR "stderr did not contain '${want_err}'\nstderr:\n${err}")
+    endif()
+  endif()
+  execute_process(COMMAND "${exe}" RESULT_VARIABLE run_rc)
+  if(NOT run_rc EQUAL want_rc)
+    message(FATAL_ERROR "unexpected exit code for ${exe}: got ${run_rc}, want ${want_rc}")
+  endif()
+endfunction()
+
+build_and_run("${INPUT}" "${WORK}/cold.exe" "${EXPECT}" "reused 0 of")
+build_and_run("${INPUT}" "${WORK}/warm.exe" "${EXPECT}" "")
+
+# Every object of the first build is reused by the second.
+execute_process(
+  COMMAND "${SIRCC}" --verbose --cache-dir "${WORK}/cache" "${INPUT}" -o "${WORK}/warm.exe"
+  ERROR_VARIABLE err
+)
+string(REGEX MATCH "reused ([0-9]+) of ([0-9]+)" m "${err}")
+if(NOT m OR NOT CMAKE_MATCH_1 EQUAL CMAKE_MATCH_2)
+  message(FATAL_ERROR "expected every cached object to be reused\nstderr:\n${err}")
+endif()
+
+if(DEFINED EDIT_FROM)
+  file(READ "${INPUT}" text)
+  string(FIND "${text}" "${EDIT_FROM}" idx)
+  if(idx EQUAL -1)
+    message(FATAL_ERROR "cache_reuse.cmake: '${EDIT_FROM}' not found in ${INPUT}")
+  endif()
+  string(REPLACE "${EDIT_FROM}" "${EDIT_TO}" text "${text}")
+  file(WRITE "${WORK}/edited.sir.jsonl" "${text}")
+  build_and_run("${WORK}/edited.sir.jsonl" "${WORK}/edited.exe" "${EDIT_EXPECT}" "${EDIT_REUSED}")
+endif()
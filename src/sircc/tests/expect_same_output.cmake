@@ -0,0 +1,40 @@
+# Runs sircc twice and expects byte-identical output files.
+# Expects:
+#   -DSIRCC=<path to sircc>
+#   -DARGS_A=<cmake list of args, first run>
+#   -DOUT_A=<output file of the first run>
+#   -DARGS_B=<cmake list of args, second run>
+#   -DOUT_B=<output file of the second run>
+
+if(NOT DEFINED SIRCC)
+  message(FATAL_ERROR "expect_same_output.cmake: missing -DSIRCC")
+endif()
+foreach(k ARGS_A OUT_A ARGS_B OUT_B)
+  if(NOT DEFINED ${k})
+    message(FATAL_ERROR "expect_same_output.cmake: missing -D${k}")
+  endif()
+endforeach()
+
+foreach(run A B)
+  file(REMOVE "${OUT_${run}}")
+  execute_process(
+    COMMAND ${SIRCC} ${ARGS_${run}}
+    RESULT_VARIABLE rc
+    OUTPUT_VARIABLE out
+    ERROR_VARIABLE err
+  )
+  if(NOT rc EQUAL 0)
+    message(FATAL_ERROR "run ${run} failed (rc=${rc})\nstdout:\n${out}\nstderr:\n${err}")
+  endif()
+  if(NOT EXISTS "${OUT_${run}}")
+    message(FATAL_ERROR "expected output file to exist: ${OUT_${run}}")
+  endif()
+endforeach()
+
+execute_process(
+  COMMAND ${CMAKE_COMMAND} -E compare_files "${OUT_A}" "${OUT_B}"
+  RESULT_VARIABLE same_rc
+)
+if(NOT same_rc EQUAL 0)
+  message(FATAL_ERROR "outputs differ: ${OUT_A} vs ${OUT_B}")
+endif()
@@ -0,0 +1,167 @@
+#!/usr/bin/env python3
+"""
+Perfect-hash table generator for closed keyword sets.
+
+Input:  an X-macro .def (lines: FAMILY(NAME, "keyword")), e.g.
+        src/sem/sir_jsonl_tags.def or src/sircc/json_keys.def
+Output: a C header with, per family, a displacement table and a key table that
+        `sirj_ph_lookup()` in sir_jsonl.c (or `json_key_lookup()` in json.c)
+        resolves with one probe plus one string compare (hash-and-displace,
+        Hanov style). `--type-prefix` names the key/table C types.
+
+The hash must stay in sync with `sirj_ph_hash()` in sir_jsonl.c and
+`json_ph_hash()` in json.c:
+  32-bit FNV-1a with the basis xored by the seed, finished with fmix32.
+
+No dependencies beyond the Python standard library.
+"""
+
+from __future__ import annotations
+
+import argparse
+import pathlib
+import re
+import sys
+
+FNV_BASIS = 0x811C9DC5
+FNV_PRIME = 0x01000193
+MAX_SEED = 1 << 20
+
+LINE_RE = re.compile(r'^\s*([A-Z][A-Z0-9_]*)\(\s*([A-Z][A-Z0-9_]*)\s*,\s*"([^"\\]+)"\s*\)\s*$')
+
+
+def ph_hash(seed: int, s: bytes) -> int:
+    h = (FNV_BASIS ^ seed) & 0xFFFFFFFF
+    for b in s:
+        h ^= b
+        h = (h * FNV_PRIME) & 0xFFFFFFFF
+    # murmur3 fmix32: spread the seed into the low bits used by `% n`.
+    h ^= h >> 16
+    h = (h * 0x85EBCA6B) & 0xFFFFFFFF
+    h ^= h >> 13
+    h = (h * 0xC2B2AE35) & 0xFFFFFFFF
+    h ^= h >> 16
+    return h
+
+
+def parse_def(path: pathlib.Path) -> dict[str, list[tuple[str, str]]]:
+    fams: dict[str, list[tuple[str, str]]] = {}
+    for lineno, raw in enumerate(path.read_text(encoding="utf-8").splitlines(), 1):
+        line = raw.strip()
+        if not line or line.startswith("//"):
+            continue
+        m = LINE_RE.match(line)
+        if not m:
+            raise SystemExit(f"{path}:{lineno}: unrecognized line: {raw!r}")
+        fam, name, kw = m.group(1), m.group(2), m.group(3)
+        fams.setdefault(fam, []).append((name, kw))
+    for fam, items in fams.items():
+        names = [n for n, _ in items]
+        kws = [k for _, k in items]
+        if len(set(names)) != len(names):
+            raise SystemExit(f"{path}: duplicate enum name in {fam}")
+        if len(set(kws)) != len(kws):
+            raise SystemExit(f"{path}: duplicate keyword in {fam}")
+    return fams
+
+
+def build_table(keys: list[bytes]) -> tuple[list[int], list[int]]:
+    """Returns (disp, slot_of_key). disp[b] >= 0 is a seed, < 0 encodes a direct slot."""
+    n = len(keys)
+    buckets: list[list[int]] = [[] for _ in range(n)]
+    for i, k in enumerate(keys):
+        buckets[ph_hash(0, k) % n].append(i)
+
+    disp = [0] * n
+    slot_of_key = [-1] * n
+    taken = [False] * n
+
+    order = sorted(range(n), key=lambda b: len(buckets[b]), reverse=True)
+    for b in order:
+        items = buckets[b]
+        if len(items) <= 1:
+            break
+        seed = 1
+        while True:
+            if seed >= MAX_SEED:
+                raise SystemExit("gen_tag_table: no displacement found (hash too weak for key set)")
+            slots = [ph_hash(seed, keys[i]) % n for i in items]
+            if len(set(slots)) == len(slots) and not any(taken[s] for s in slots):
+                break
+            seed += 1
+        disp[b] = seed
+        for i, s in zip(items, slots):
+            taken[s] = True
+            slot_of_key[i] = s
+
+    free = [s for s in range(n) if not taken[s]]
+    for b in order:
+        items = buckets[b]
+        if len(items) != 1:
+            continue
+        s = free.pop()
+        taken[s] = True
+        slot_of_key[items[0]] = s
+        disp[b] = -s - 1
+
+    return disp, slot_of_key
+
+
+def lookup(disp: list[int], slots: list[bytes], k: bytes) -> int:
+    n = len(disp)
+    d = disp[ph_hash(0, k) % n]
+    return -d - 1 if d < 0 else ph_hash(d, k) % n
+
+
+def emit(fams: dict[str, list[tuple[str, str]]], def_name: str, tp: str) -> str:
+    out: list[str] = []
+    out.append(f"// Generated by src/sircc/tools/gen_tag_table.py from {def_name}. Do not edit.")
+    out.append("//")
+    out.append(f"// Requires {tp}_key_t / {tp}_table_t and the family enums to be declared first.")
+    out.append("")
+    for fam, items in fams.items():
+        pre = fam.lower()
+        keys = [kw.encode("utf-8") for _, kw in items]
+        disp, slot_of_key = build_table(keys)
+        by_slot: list[tuple[str, str] | None] = [None] * len(keys)
+        for i, s in enumerate(slot_of_key):
+            by_slot[s] = items[i]
+        for i, k in enumerate(keys):
+            if lookup(disp, [], k) != slot_of_key[i]:
+                raise SystemExit(f"gen_tag_table: self-check failed for {k!r}")
+
+        out.append(f"// {fam}: {len(keys)} keywords")
+        out.append(f"static const int32_t {pre}_ph_disp[{len(keys)}] = {{")
+        for j in range(0, len(disp), 12):
+            out.append("  " + ", ".join(str(d) for d in disp[j : j + 12]) + ",")
+        out.append("};")
+        out.append(f"static const {tp}_key_t {pre}_ph_keys[{len(keys)}] = {{")
+        for ent in by_slot:
+            assert ent is not None
+            name, kw = ent
+            out.append(f'  {{"{kw}", {len(kw.encode("utf-8"))}u, {fam}_{name}}},')
+        out.append("};")
+        out.append(f"static const {tp}_table_t {pre}_ph = {{{pre}_ph_disp, {pre}_ph_keys, {len(keys)}u}};")
+        out.append("")
+    return "\n".join(out)
+
+
+def main(argv: list[str]) -> int:
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument("--def", dest="def_path", required=True, help="path to the keyword .def")
+    ap.add_argument("--out", required=True, help="generated header path")
+    ap.add_argument("--type-prefix", default="sirj_ph", help="C type prefix for <prefix>_key_t / <prefix>_table_t")
+    args = ap.parse_args(argv)
+
+    def_path = pathlib.Path(args.def_path)
+    text = emit(parse_def(def_path), def_path.name, args.type_prefix)
+    out = pathlib.Path(args.out)
+    if out.exists() and out.read_text(encoding="utf-8") == text:
+        return 0
+    out.parent.mkdir(parents=True, exist_ok=True)
+    out.write_text(text, encoding="utf-8")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -1,7 +1,12 @@
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE // MAP_ANONYMOUS
+#endif
+
 #include "guest_mem.h"
 
-#include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 static uint32_t align_up_u32(uint32_t x, uint32_t a) {
   if (a == 0) return x;
@@ -15,10 +20,12 @@ bool sem_guest_mem_init(sem_guest_mem_t* m, uint32_t cap, uint64_t base) {
   if (base == 0) return false;
   memset(m, 0, sizeof(*m));
 
-  uint8_t* buf = (uint8_t*)calloc(1, cap);
-  if (!buf) return false;
+  // Anonymous pages: zeroed lazily and page-aligned, so host files can be mapped over
+  // page-aligned guest regions (sem_guest_mem_map_file).
+  void* buf = mmap(NULL, (size_t)cap, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (buf == MAP_FAILED) return false;
 
-  m->buf = buf;
+  m->buf = (uint8_t*)buf;
   m->cap = cap;
   m->brk = 0;
   m->base = base;
@@ -27,10 +34,21 @@ bool sem_guest_mem_init(sem_guest_mem_t* m, uint32_t cap, uint64_t base) {
 
 void sem_guest_mem_dispose(sem_guest_mem_t* m) {
   if (!m) return;
-  free(m->buf);
+  if (m->buf) (void)munmap(m->buf, (size_t)m->cap);
   memset(m, 0, sizeof(*m));
 }
 
+void sem_guest_mem_reset(sem_guest_mem_t* m) {
+  if (!m || !m->buf) return;
+  // Small heaps are cheaper to clear in place than to remap.
+  if (m->brk <= 256u * 1024u) {
+    memset(m->buf, 0, m->brk);
+  } else {
+    (void)mmap(m->buf, (size_t)m->cap, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+  }
+  m->brk = 0;
+}
+
 static bool sem_guest_bounds(const sem_guest_mem_t* m, zi_ptr_t ptr, zi_size32_t len, uint32_t* out_off) {
   if (!m || !m->buf) return false;
   if (ptr == 0) return false;
@@ -89,3 +107,35 @@ int32_t sem_guest_free(sem_guest_mem_t* m, zi_ptr_t ptr) {
   return 0;
 }
 
+
+static uint32_t page_size(void) {
+  const long pg = sysconf(_SC_PAGESIZE);
+  return (pg > 0 && pg <= 0x10000) ? (uint32_t)pg : 4096u;
+}
+
+zi_ptr_t sem_guest_mem_map_file(sem_guest_mem_t* m, int fd, zi_size32_t len) {
+  if (!m || !m->buf || fd < 0 || len == 0) return 0;
+  const uint32_t pg = page_size();
+  const uint64_t span = ((uint64_t)len + pg - 1u) & ~(uint64_t)(pg - 1u);
+  if (span > 0xFFFFFFFFull) return 0;
+  const uint32_t brk0 = m->brk;
+  const zi_ptr_t ptr = sem_guest_alloc(m, (zi_size32_t)span, pg);
+  if (!ptr) return 0;
+  uint8_t* at = m->buf + (ptr - m->base);
+  if (((uintptr_t)at & (uintptr_t)(pg - 1u)) != 0 ||
+      mmap(at, (size_t)span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+    m->brk = brk0;
+    return 0;
+  }
+  return ptr;
+}
+
+void sem_guest_mem_unmap_file(sem_guest_mem_t* m, zi_ptr_t ptr, zi_size32_t len) {
+  if (!m || !m->buf || !ptr || len == 0) return;
+  const uint32_t pg = page_size();
+  const uint64_t span = ((uint64_t)len + pg - 1u) & ~(uint64_t)(pg - 1u);
+  uint32_t off = 0;
+  if (!sem_guest_bounds(m, ptr, (zi_size32_t)span, &off)) return;
+  // Back to zeroed anonymous memory; the range stays valid (the allocator never reuses it).
+  (void)mmap(m->buf + off, (size_t)span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+}
@@ -13,11 +13,15 @@ typedef struct sem_guest_mem {
   uint64_t base;
 } sem_guest_mem_t;
 
-// Initializes guest memory to a zeroed heap of `cap` bytes.
+// Initializes guest memory to a zeroed heap of `cap` bytes (anonymous, page-aligned).
 // Guest pointers are offsets from `base` (base != 0).
 bool sem_guest_mem_init(sem_guest_mem_t* m, uint32_t cap, uint64_t base);
 void sem_guest_mem_dispose(sem_guest_mem_t* m);
 
+// Returns the arena to its freshly initialized state (all zero, nothing allocated)
+// without giving up the mapping; cost scales with what the last run touched.
+void sem_guest_mem_reset(sem_guest_mem_t* m);
+
 // Maps guest memory into host pointers for copying.
 bool sem_guest_mem_map_ro(const sem_guest_mem_t* m, zi_ptr_t ptr, zi_size32_t len, const uint8_t** out);
 bool sem_guest_mem_map_rw(sem_guest_mem_t* m, zi_ptr_t ptr, zi_size32_t len, uint8_t** out);
@@ -26,3 +30,11 @@ bool sem_guest_mem_map_rw(sem_guest_mem_t* m, zi_ptr_t ptr, zi_size32_t len, uin
 zi_ptr_t sem_guest_alloc(sem_guest_mem_t* m, zi_size32_t size, zi_size32_t align);
 int32_t sem_guest_free(sem_guest_mem_t* m, zi_ptr_t ptr);
 
+
+// Maps the first `len` bytes of the open file `fd` copy-on-write into a fresh
+// page-aligned guest region and returns its guest pointer (0 on failure). Guest stores
+// land in private pages and never reach the file.
+zi_ptr_t sem_guest_mem_map_file(sem_guest_mem_t* m, int fd, zi_size32_t len);
+
+// Replaces a region returned by sem_guest_mem_map_file with zeroed memory.
+void sem_guest_mem_unmap_file(sem_guest_mem_t* m, zi_ptr_t ptr, zi_size32_t len);
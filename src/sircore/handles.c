@@ -3,81 +3,101 @@
 #include <stdlib.h>
 #include <string.h>
 
-bool sem_handles_init(sem_handles_t* hs, uint32_t cap) {
+bool sem_handles_init(sem_handles_t* hs, uint32_t max) {
   if (!hs) return false;
-  if (cap < 4) return false;
+  if (max < 4) return false;
+  if (max > SEM_HANDLES_MAX) max = SEM_HANDLES_MAX;
   memset(hs, 0, sizeof(*hs));
 
-  sem_handle_entry_t* entries = (sem_handle_entry_t*)calloc(cap, sizeof(*entries));
-  if (!entries) return false;
+  const uint32_t cap = max < 16u ? max : 16u;
+  sem_handle_slot_t* slots = (sem_handle_slot_t*)calloc(cap, sizeof(*slots));
+  if (!slots) return false;
 
-  hs->entries = entries;
+  hs->slots = slots;
   hs->cap = cap;
-  hs->next = 3;
+  hs->max = max;
+  hs->count = SEM_HANDLE_RESERVED;
   return true;
 }
 
 void sem_handles_dispose(sem_handles_t* hs) {
   if (!hs) return;
-  free(hs->entries);
+  free(hs->slots);
   memset(hs, 0, sizeof(*hs));
 }
 
-static bool is_valid_index(const sem_handles_t* hs, zi_handle_t h, uint32_t* out_i) {
-  if (!hs || !hs->entries) return false;
+static zi_handle_t make_handle(uint32_t i, uint32_t gen) {
+  return (zi_handle_t)((gen << SEM_HANDLE_INDEX_BITS) | i);
+}
+
+// Decodes `h` to the index of its slot; false for malformed or stale handles.
+static bool slot_index(const sem_handles_t* hs, zi_handle_t h, uint32_t* out_i) {
+  if (!hs || !hs->slots) return false;
   if (h < 0) return false;
-  const uint32_t i = (uint32_t)h;
-  if (i >= hs->cap) return false;
+  const uint32_t i = (uint32_t)h & SEM_HANDLE_INDEX_MASK;
+  const uint32_t gen = (uint32_t)h >> SEM_HANDLE_INDEX_BITS;
+  if (i >= hs->count) return false;
+  if (hs->slots[i].gen != gen) return false;
   if (out_i) *out_i = i;
   return true;
 }
 
 bool sem_handle_install(sem_handles_t* hs, zi_handle_t h, sem_handle_entry_t e) {
-  uint32_t i = 0;
-  if (!is_valid_index(hs, h, &i)) return false;
-  hs->entries[i] = e;
+  if (!hs || !hs->slots) return false;
+  if (h < 0 || (uint32_t)h >= SEM_HANDLE_RESERVED) return false;
+  hs->slots[h].e = e;
   return true;
 }
 
 zi_handle_t sem_handle_alloc(sem_handles_t* hs, sem_handle_entry_t e) {
-  if (!hs || !hs->entries) return -10;
+  if (!hs || !hs->slots) return -10;
 
-  for (uint32_t attempt = 0; attempt < hs->cap; attempt++) {
-    const zi_handle_t h = hs->next;
-    hs->next++;
-    if (hs->next >= (zi_handle_t)hs->cap) hs->next = 3;
-
-    uint32_t i = 0;
-    if (!is_valid_index(hs, h, &i)) continue;
-    if (hs->entries[i].ops != NULL) continue;
-    hs->entries[i] = e;
-    return h;
+  uint32_t i = 0;
+  if (hs->free_head) {
+    i = hs->free_head - 1u;
+    hs->free_head = hs->slots[i].next_free;
+    hs->slots[i].next_free = 0;
+  } else {
+    if (hs->count >= hs->max) return -8;
+    if (hs->count == hs->cap) {
+      uint32_t cap = hs->cap * 2u;
+      if (cap > hs->max) cap = hs->max;
+      sem_handle_slot_t* slots = (sem_handle_slot_t*)realloc(hs->slots, (size_t)cap * sizeof(*slots));
+      if (!slots) return -8;
+      memset(slots + hs->cap, 0, (size_t)(cap - hs->cap) * sizeof(*slots));
+      hs->slots = slots;
+      hs->cap = cap;
+    }
+    i = hs->count++;
   }
-  return -8;
+  hs->slots[i].e = e;
+  return make_handle(i, hs->slots[i].gen);
 }
 
 bool sem_handle_lookup(const sem_handles_t* hs, zi_handle_t h, sem_handle_entry_t* out) {
   if (!out) return false;
   uint32_t i = 0;
-  if (!is_valid_index(hs, h, &i)) return false;
-  if (!hs->entries[i].ops) return false;
-  *out = hs->entries[i];
+  if (!slot_index(hs, h, &i)) return false;
+  if (!hs->slots[i].e.ops) return false;
+  *out = hs->slots[i].e;
   return true;
 }
 
 bool sem_handle_release(sem_handles_t* hs, zi_handle_t h) {
   uint32_t i = 0;
-  if (!is_valid_index(hs, h, &i)) return false;
-  if (!hs->entries[i].ops) return false;
-  if (h == 0 || h == 1 || h == 2) return false;
-  memset(&hs->entries[i], 0, sizeof(hs->entries[i]));
+  if (!slot_index(hs, h, &i)) return false;
+  if (!hs->slots[i].e.ops) return false;
+  if (i < SEM_HANDLE_RESERVED) return false;
+  memset(&hs->slots[i].e, 0, sizeof(hs->slots[i].e));
+  hs->slots[i].gen = (hs->slots[i].gen + 1u) & SEM_HANDLE_GEN_MASK;
+  hs->slots[i].next_free = hs->free_head;
+  hs->free_head = i + 1u;
   return true;
 }
 
 uint32_t sem_handle_hflags(const sem_handles_t* hs, zi_handle_t h) {
   uint32_t i = 0;
-  if (!is_valid_index(hs, h, &i)) return 0;
-  if (!hs->entries[i].ops) return 0;
-  return hs->entries[i].hflags;
+  if (!slot_index(hs, h, &i)) return 0;
+  if (!hs->slots[i].e.ops) return 0;
+  return hs->slots[i].e.hflags;
 }
-
@@ -18,6 +18,13 @@ typedef struct sem_handle_ops {
   int32_t (*read)(void* ctx, sem_guest_mem_t* mem, zi_ptr_t dst_ptr, zi_size32_t cap);
   int32_t (*write)(void* ctx, sem_guest_mem_t* mem, zi_ptr_t src_ptr, zi_size32_t len);
   int32_t (*end)(void* ctx, sem_guest_mem_t* mem);
+
+  // Optional host-side paths used by handle-to-handle transfers (no guest memory).
+  // host_fd returns a descriptor the kernel may copy through directly (after flushing
+  // any buffered output), or -1; read_host/write_host move bytes through host buffers.
+  int (*host_fd)(void* ctx);
+  int32_t (*read_host)(void* ctx, uint8_t* dst, uint32_t cap);
+  int32_t (*write_host)(void* ctx, const uint8_t* src, uint32_t len);
 } sem_handle_ops_t;
 
 typedef struct sem_handle_entry {
@@ -26,15 +33,37 @@ typedef struct sem_handle_entry {
   uint32_t hflags;
 } sem_handle_entry_t;
 
+// Handle values are (generation << SEM_HANDLE_INDEX_BITS) | slot index. Releasing a
+// handle bumps its slot's generation, so a stale handle never reaches the slot's next
+// owner. 0/1/2 (stdio) are installed, never allocated, and never released.
+#define SEM_HANDLE_INDEX_BITS 20u
+#define SEM_HANDLE_INDEX_MASK ((1u << SEM_HANDLE_INDEX_BITS) - 1u)
+#define SEM_HANDLE_GEN_MASK 0x7FFu // 11 bits: handles stay positive int32
+#define SEM_HANDLES_MAX (1u << SEM_HANDLE_INDEX_BITS)
+#define SEM_HANDLE_RESERVED 3u
+
+typedef struct sem_handle_slot {
+  sem_handle_entry_t e;
+  uint32_t gen;
+  uint32_t next_free; // slot index + 1 of the next free slot (0: end of list)
+} sem_handle_slot_t;
+
+// Slots grow on demand up to `max`; released slots go on a LIFO free list, so alloc,
+// lookup and release are O(1) and the sequence of handle values depends only on the
+// sequence of calls (tapes replay identically).
 typedef struct sem_handles {
-  sem_handle_entry_t* entries;
-  uint32_t cap;
-  zi_handle_t next;
+  sem_handle_slot_t* slots;
+  uint32_t count; // slots handed out so far (live or free)
+  uint32_t cap;   // slots allocated
+  uint32_t max;   // live handle limit, including the reserved ones
+  uint32_t free_head;
 } sem_handles_t;
 
-bool sem_handles_init(sem_handles_t* hs, uint32_t cap);
+// `max` bounds the number of slots (at most SEM_HANDLES_MAX); storage starts small.
+bool sem_handles_init(sem_handles_t* hs, uint32_t max);
 void sem_handles_dispose(sem_handles_t* hs);
 
+// Installs one of the reserved handles (h < SEM_HANDLE_RESERVED).
 bool sem_handle_install(sem_handles_t* hs, zi_handle_t h, sem_handle_entry_t e);
 zi_handle_t sem_handle_alloc(sem_handles_t* hs, sem_handle_entry_t e);
 bool sem_handle_lookup(const sem_handles_t* hs, zi_handle_t h, sem_handle_entry_t* out);
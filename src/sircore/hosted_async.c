@@ -0,0 +1,335 @@
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE // pread, pwrite
+#endif
+
+#include "hosted_async.h"
+
+#include "sem_host.h"
+#include "zcl1.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+enum {
+  ZI_E_INVALID = -1,
+  ZI_E_BOUNDS = -2,
+  ZI_E_NOENT = -3,
+  ZI_E_DENIED = -4,
+  ZI_E_CLOSED = -5,
+  ZI_E_AGAIN = -6,
+  ZI_E_NOSYS = -7,
+  ZI_E_OOM = -8,
+  ZI_E_IO = -9,
+  ZI_E_INTERNAL = -10,
+};
+
+enum {
+  SUBMIT_HDR = 28, // kind, pad[3], handle, offset, user_data, len
+  POLL_ENTRY_HDR = 16,
+};
+
+typedef struct async_op {
+  struct async_op* next;
+  uint64_t user_data;
+  uint64_t offset;
+  uint8_t* data; // write payload, or the read buffer
+  uint32_t len;
+  int32_t result;
+  int fd; // dup of the handle's descriptor, owned by the op
+  uint8_t kind;
+} async_op_t;
+
+typedef struct async_queue {
+  async_op_t* head;
+  async_op_t* tail;
+  uint32_t count;
+} async_queue_t;
+
+struct sir_hosted_async {
+  pthread_mutex_t mu;
+  pthread_cond_t work_cv; // submit queue non-empty, or stopping
+  pthread_cond_t done_cv; // an op completed
+  async_queue_t submitted;
+  async_queue_t done;
+  uint32_t outstanding; // submitted and not yet handed back by POLL
+  uint32_t workers;
+  uint32_t started;
+  pthread_t* threads;
+  bool stopping;
+};
+
+static void queue_push(async_queue_t* q, async_op_t* op) {
+  op->next = NULL;
+  if (q->tail) q->tail->next = op;
+  else q->head = op;
+  q->tail = op;
+  q->count++;
+}
+
+static async_op_t* queue_pop(async_queue_t* q) {
+  async_op_t* op = q->head;
+  if (!op) return NULL;
+  q->head = op->next;
+  if (!q->head) q->tail = NULL;
+  q->count--;
+  return op;
+}
+
+static void op_free(async_op_t* op) {
+  if (!op) return;
+  if (op->fd >= 0) (void)close(op->fd);
+  free(op->data);
+  free(op);
+}
+
+static int32_t map_errno_to_zi(int e) {
+  switch (e) {
+    case EAGAIN:
+#if defined(EWOULDBLOCK) && (EWOULDBLOCK != EAGAIN)
+    case EWOULDBLOCK:
+#endif
+      return ZI_E_AGAIN;
+    case EBADF:
+      return ZI_E_CLOSED;
+    case EACCES:
+    case EPERM:
+      return ZI_E_DENIED;
+    case EISDIR:
+    case EINVAL:
+      return ZI_E_INVALID;
+    case ENOMEM:
+      return ZI_E_OOM;
+    default:
+      return ZI_E_IO;
+  }
+}
+
+static void op_run(async_op_t* op) {
+  ssize_t n = 0;
+  const bool current = op->offset == SIR_ASYNC_OFF_CURRENT;
+  do {
+    if (op->kind == SIR_ASYNC_READ) {
+      n = current ? read(op->fd, op->data, op->len) : pread(op->fd, op->data, op->len, (off_t)op->offset);
+    } else {
+      n = current ? write(op->fd, op->data, op->len) : pwrite(op->fd, op->data, op->len, (off_t)op->offset);
+    }
+  } while (n < 0 && errno == EINTR);
+  op->result = n < 0 ? map_errno_to_zi(errno) : (int32_t)n;
+  // The descriptor is not needed past this point; close it here, not at POLL time.
+  (void)close(op->fd);
+  op->fd = -1;
+}
+
+static void* worker_main(void* arg) {
+  sir_hosted_async_t* a = (sir_hosted_async_t*)arg;
+  pthread_mutex_lock(&a->mu);
+  for (;;) {
+    while (!a->submitted.head && !a->stopping) pthread_cond_wait(&a->work_cv, &a->mu);
+    async_op_t* op = queue_pop(&a->submitted);
+    if (!op) break; // stopping and drained
+    pthread_mutex_unlock(&a->mu);
+    op_run(op);
+    pthread_mutex_lock(&a->mu);
+    queue_push(&a->done, op);
+    pthread_cond_broadcast(&a->done_cv);
+  }
+  pthread_mutex_unlock(&a->mu);
+  return NULL;
+}
+
+// Called with `mu` held. Starts the pool on first use; on failure the already started
+// workers keep serving and, with none at all, ops run inline.
+static void ensure_workers(sir_hosted_async_t* a) {
+  if (a->started || a->workers == 0) return;
+  a->threads = (pthread_t*)calloc(a->workers, sizeof(*a->threads));
+  if (!a->threads) {
+    a->workers = 0;
+    return;
+  }
+  for (uint32_t i = 0; i < a->workers; i++) {
+    if (pthread_create(&a->threads[i], NULL, worker_main, a) != 0) break;
+    a->started++;
+  }
+  if (a->started == 0) {
+    free(a->threads);
+    a->threads = NULL;
+    a->workers = 0;
+  }
+}
+
+sir_hosted_async_t* sir_hosted_async_new(uint32_t workers) {
+  sir_hosted_async_t* a = (sir_hosted_async_t*)calloc(1, sizeof(*a));
+  if (!a) return NULL;
+  if (pthread_mutex_init(&a->mu, NULL) != 0) {
+    free(a);
+    return NULL;
+  }
+  if (pthread_cond_init(&a->work_cv, NULL) != 0) {
+    pthread_mutex_destroy(&a->mu);
+    free(a);
+    return NULL;
+  }
+  if (pthread_cond_init(&a->done_cv, NULL) != 0) {
+    pthread_cond_destroy(&a->work_cv);
+    pthread_mutex_destroy(&a->mu);
+    free(a);
+    return NULL;
+  }
+  a->workers = workers;
+  return a;
+}
+
+void sir_hosted_async_free(sir_hosted_async_t* a) {
+  if (!a) return;
+  pthread_mutex_lock(&a->mu);
+  a->stopping = true;
+  pthread_cond_broadcast(&a->work_cv);
+  pthread_mutex_unlock(&a->mu);
+  for (uint32_t i = 0; i < a->started; i++) (void)pthread_join(a->threads[i], NULL);
+  free(a->threads);
+
+  async_op_t* op = NULL;
+  while ((op = queue_pop(&a->submitted)) != NULL) op_free(op);
+  while ((op = queue_pop(&a->done)) != NULL) op_free(op);
+  pthread_cond_destroy(&a->done_cv);
+  pthread_cond_destroy(&a->work_cv);
+  pthread_mutex_destroy(&a->mu);
+  free(a);
+}
+
+static uint64_t read_u64le(const uint8_t* p) {
+  return (uint64_t)zcl1_read_u32le(p) | ((uint64_t)zcl1_read_u32le(p + 4) << 32);
+}
+
+static void write_u64le(uint8_t* p, uint64_t v) {
+  zcl1_write_u32le(p, (uint32_t)(v & 0xFFFFFFFFu));
+  zcl1_write_u32le(p + 4, (uint32_t)(v >> 32));
+}
+
+static int32_t write_error(uint8_t* resp, uint32_t resp_cap, const zcl1_hdr_t* rh, const char* trace, const char* msg) {
+  uint8_t payload[256];
+  uint32_t payload_len = 0;
+  if (!zcl1_write_error_payload(payload, (uint32_t)sizeof(payload), trace, msg, "", &payload_len)) return SEM_ZI_E_INTERNAL;
+  uint32_t out_len = 0;
+  if (!zcl1_write(resp, resp_cap, rh->op, rh->rid, 0, payload, payload_len, &out_len)) return SEM_ZI_E_BOUNDS;
+  return (int32_t)out_len;
+}
+
+static int32_t async_submit(sir_hosted_async_t* a, const sem_handles_t* hs, const zcl1_hdr_t* rh, const uint8_t* p, uint8_t* resp,
+                            uint32_t resp_cap) {
+  if (rh->payload_len < SUBMIT_HDR) return write_error(resp, resp_cap, rh, "sem.async.invalid", "ASYNC_SUBMIT payload too short");
+  const uint8_t kind = p[0];
+  const zi_handle_t h = (zi_handle_t)zcl1_read_u32le(p + 4);
+  const uint32_t len = zcl1_read_u32le(p + 24);
+  if (kind != SIR_ASYNC_READ && kind != SIR_ASYNC_WRITE) {
+    return write_error(resp, resp_cap, rh, "sem.async.invalid", "unknown ASYNC_SUBMIT kind");
+  }
+  if (len > SIR_ASYNC_MAX_LEN) return write_error(resp, resp_cap, rh, "sem.async.invalid", "ASYNC_SUBMIT len too large");
+  const uint32_t want = SUBMIT_HDR + (kind == SIR_ASYNC_WRITE ? len : 0u);
+  if (rh->payload_len != want) return write_error(resp, resp_cap, rh, "sem.async.invalid", "ASYNC_SUBMIT payload size mismatch");
+
+  sem_handle_entry_t e;
+  if (!sem_handle_lookup(hs, h, &e) || !e.ops) return write_error(resp, resp_cap, rh, "sem.async.closed", "unknown handle");
+  const uint32_t need_flag = kind == SIR_ASYNC_READ ? ZI_H_READABLE : ZI_H_WRITABLE;
+  if ((e.hflags & need_flag) == 0) return write_error(resp, resp_cap, rh, "sem.async.denied", "handle does not allow this direction");
+  const int host_fd = e.ops->host_fd ? e.ops->host_fd(e.ctx) : -1;
+  if (host_fd < 0) return write_error(resp, resp_cap, rh, "sem.async.nosys", "handle has no host descriptor");
+
+  pthread_mutex_lock(&a->mu);
+  const uint32_t outstanding = a->outstanding;
+  pthread_mutex_unlock(&a->mu);
+  if (outstanding >= SIR_ASYNC_MAX_OUTSTANDING) return write_error(resp, resp_cap, rh, "sem.async.again", "too many outstanding ops");
+
+  async_op_t* op = (async_op_t*)calloc(1, sizeof(*op));
+  if (!op) return SEM_ZI_E_INTERNAL;
+  op->kind = kind;
+  op->user_data = read_u64le(p + 16);
+  op->offset = read_u64le(p + 8);
+  op->len = len;
+  op->fd = -1;
+  if (len) {
+    op->data = (uint8_t*)malloc(len);
+    if (!op->data) {
+      op_free(op);
+      return write_error(resp, resp_cap, rh, "sem.async.oom", "out of memory");
+    }
+    if (kind == SIR_ASYNC_WRITE) memcpy(op->data, p + SUBMIT_HDR, len);
+  }
+  // The op owns its own descriptor, so zi_end on the handle cannot pull it out from under a worker.
+  op->fd = dup(host_fd);
+  if (op->fd < 0) {
+    op_free(op);
+    return write_error(resp, resp_cap, rh, "sem.async.io", "dup failed");
+  }
+
+  uint8_t payload[4];
+  pthread_mutex_lock(&a->mu);
+  ensure_workers(a);
+  a->outstanding++;
+  if (a->started) {
+    queue_push(&a->submitted, op);
+    pthread_cond_signal(&a->work_cv);
+  } else {
+    op_run(op);
+    queue_push(&a->done, op);
+  }
+  zcl1_write_u32le(payload, a->outstanding);
+  pthread_mutex_unlock(&a->mu);
+
+  uint32_t out_len = 0;
+  if (!zcl1_write(resp, resp_cap, rh->op, rh->rid, 1, payload, sizeof(payload), &out_len)) return SEM_ZI_E_BOUNDS;
+  return (int32_t)out_len;
+}
+
+static int32_t async_poll(sir_hosted_async_t* a, const zcl1_hdr_t* rh, const uint8_t* p, uint8_t* resp, uint32_t resp_cap) {
+  if (rh->payload_len != 8) return write_error(resp, resp_cap, rh, "sem.async.invalid", "ASYNC_POLL payload must be 8 bytes");
+  // Read the request before writing anything: the guest may reuse one buffer for both.
+  const uint32_t min_complete = zcl1_read_u32le(p);
+  const uint32_t max_complete = zcl1_read_u32le(p + 4);
+  if (resp_cap < ZCL1_HDR_SIZE + 8u) return SEM_ZI_E_BOUNDS;
+
+  pthread_mutex_lock(&a->mu);
+  const uint32_t wait_for = min_complete < a->outstanding ? min_complete : a->outstanding;
+  while (a->done.count < wait_for) pthread_cond_wait(&a->done_cv, &a->mu);
+
+  uint32_t out = ZCL1_HDR_SIZE + 8u;
+  uint32_t count = 0;
+  while (a->done.head && (max_complete == 0 || count < max_complete)) {
+    async_op_t* op = a->done.head;
+    const uint32_t data_len = (op->kind == SIR_ASYNC_READ && op->result > 0) ? (uint32_t)op->result : 0u;
+    if (resp_cap - out < POLL_ENTRY_HDR || resp_cap - out - POLL_ENTRY_HDR < data_len) break; // stays queued
+    (void)queue_pop(&a->done);
+    write_u64le(resp + out, op->user_data);
+    zcl1_write_u32le(resp + out + 8, (uint32_t)op->result);
+    zcl1_write_u32le(resp + out + 12, data_len);
+    if (data_len) memcpy(resp + out + POLL_ENTRY_HDR, op->data, data_len);
+    out += POLL_ENTRY_HDR + data_len;
+    count++;
+    a->outstanding--;
+    op_free(op);
+  }
+  const uint32_t outstanding = a->outstanding;
+  pthread_mutex_unlock(&a->mu);
+
+  // Entries already sit where the payload goes; write the header alone and patch its length.
+  uint32_t hdr_len = 0;
+  if (!zcl1_write(resp, ZCL1_HDR_SIZE, rh->op, rh->rid, 1, NULL, 0, &hdr_len)) return SEM_ZI_E_INTERNAL;
+  zcl1_write_u32le(resp + 20, out - ZCL1_HDR_SIZE);
+  zcl1_write_u32le(resp + ZCL1_HDR_SIZE, count);
+  zcl1_write_u32le(resp + ZCL1_HDR_SIZE + 4, outstanding);
+  return (int32_t)out;
+}
+
+int32_t sir_hosted_async_ctl(sir_hosted_async_t* a, const sem_handles_t* hs, const uint8_t* req, uint32_t req_len, uint8_t* resp,
+                             uint32_t resp_cap) {
+  zcl1_hdr_t rh = {0};
+  const uint8_t* payload = NULL;
+  if (!zcl1_parse(req, req_len, &rh, &payload)) return SEM_ZI_E_INVALID;
+  if (rh.op != SIR_ASYNC_OP_SUBMIT && rh.op != SIR_ASYNC_OP_POLL) return SEM_ZI_E_NOSYS;
+  if (!a || !hs) return SEM_ZI_E_INTERNAL;
+  if (rh.op == SIR_ASYNC_OP_SUBMIT) return async_submit(a, hs, &rh, payload, resp, resp_cap);
+  return async_poll(a, &rh, payload, resp, resp_cap);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "handles.h"
+
+// Async file I/O for the hosted runtime (`async:default` cap), driven through zi_ctl.
+//
+// ASYNC_SUBMIT (op=1001) queues one read or write on a handle that exposes a host
+// descriptor (file/fs handles); submit many at once by wrapping them in BATCH (op=1000).
+//
+//   request payload  u8 kind (1 read, 2 write), u8 pad[3], i32 handle, u64 offset,
+//                    u64 user_data, u32 len, u8 data[len] (writes only)
+//   response payload u32 outstanding
+//
+// `offset` is absolute (pread/pwrite); SIR_ASYNC_OFF_CURRENT uses the descriptor's
+// position instead. Write data is copied at submit time, so the guest may reuse its
+// buffer immediately.
+//
+// ASYNC_POLL (op=1002) hands back finished operations in completion order:
+//
+//   request payload  u32 min_complete (block until this many are ready, capped at the
+//                    number outstanding; 0 = never block), u32 max_complete (0 = no limit)
+//   response payload u32 count, u32 outstanding,
+//                    {u64 user_data, i32 result, u32 data_len, u8 data[data_len]}[count]
+//
+// `result` is bytes transferred or a ZI_E_* code; read data travels in the response
+// (never written into guest memory behind the guest's back), and completions that do
+// not fit in resp_cap stay queued. Because every byte crosses the zi_ctl boundary,
+// zi_ctl tapes capture submissions, completion order and data, and replay is
+// deterministic without touching files.
+
+enum {
+  SIR_ASYNC_OP_SUBMIT = 1001,
+  SIR_ASYNC_OP_POLL = 1002,
+};
+
+enum {
+  SIR_ASYNC_READ = 1,
+  SIR_ASYNC_WRITE = 2,
+};
+
+#define SIR_ASYNC_OFF_CURRENT UINT64_MAX
+#define SIR_ASYNC_MAX_OUTSTANDING 1024u
+#define SIR_ASYNC_MAX_LEN (1u << 20)
+#define SIR_ASYNC_DEFAULT_WORKERS 4u
+
+typedef struct sir_hosted_async sir_hosted_async_t;
+
+// `workers == 0` runs every operation inline at submit time (no threads); the same
+// fallback is used when worker threads cannot be started. Threads start on first submit.
+sir_hosted_async_t* sir_hosted_async_new(uint32_t workers);
+
+// Waits for in-flight operations, then frees everything (queued completions are dropped).
+void sir_hosted_async_free(sir_hosted_async_t* a);
+
+// zi_ctl entry for the two ops above (host pointers). Returns the response length, a
+// negative ZI_E_* transport error, or SEM_ZI_E_NOSYS for ops it does not own.
+int32_t sir_hosted_async_ctl(sir_hosted_async_t* a, const sem_handles_t* hs, const uint8_t* req, uint32_t req_len, uint8_t* resp,
+                             uint32_t resp_cap);
@@ -4,6 +4,7 @@
 #include <fcntl.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 enum {
@@ -21,6 +22,8 @@ enum {
 
 typedef struct {
   int fd;
+  zi_ptr_t map_ptr; // ZI_FILE_O_MAP region (0: none)
+  zi_size32_t map_len;
 } sir_fd_stream;
 
 static int32_t map_errno_to_zi(int e) {
@@ -74,10 +77,31 @@ static int32_t fd_write(void* ctx, sem_guest_mem_t* mem, zi_ptr_t src_ptr, zi_si
   return (int32_t)n;
 }
 
+static int fd_host_fd(void* ctx) {
+  sir_fd_stream* s = (sir_fd_stream*)ctx;
+  return s ? s->fd : -1;
+}
+
+static int32_t fd_read_host(void* ctx, uint8_t* dst, uint32_t cap) {
+  sir_fd_stream* s = (sir_fd_stream*)ctx;
+  if (!s) return ZI_E_INTERNAL;
+  const ssize_t n = read(s->fd, dst, (size_t)cap);
+  if (n < 0) return map_errno_to_zi(errno);
+  return (int32_t)n;
+}
+
+static int32_t fd_write_host(void* ctx, const uint8_t* src, uint32_t len) {
+  sir_fd_stream* s = (sir_fd_stream*)ctx;
+  if (!s) return ZI_E_INTERNAL;
+  const ssize_t n = write(s->fd, src, (size_t)len);
+  if (n < 0) return map_errno_to_zi(errno);
+  return (int32_t)n;
+}
+
 static int32_t fd_end(void* ctx, sem_guest_mem_t* mem) {
-  (void)mem;
   sir_fd_stream* s = (sir_fd_stream*)ctx;
   if (!s) return 0;
+  if (s->map_ptr) sem_guest_mem_unmap_file(mem, s->map_ptr, s->map_len);
   if (s->fd >= 0) {
     (void)close(s->fd);
     s->fd = -1;
@@ -90,6 +114,9 @@ static const sem_handle_ops_t fd_ops = {
     .read = fd_read,
     .write = fd_write,
     .end = fd_end,
+    .host_fd = fd_host_fd,
+    .read_host = fd_read_host,
+    .write_host = fd_write_host,
 };
 
 void sir_hosted_file_fs_init(sir_hosted_file_fs_t* fs, sir_hosted_file_fs_cfg_t cfg) {
@@ -217,17 +244,52 @@ zi_handle_t sir_hosted_file_fs_open_from_params(sir_hosted_file_fs_t* fs, sem_ha
   if (of & ZI_FILE_O_APPEND) flags |= O_APPEND;
   if ((of & (ZI_FILE_O_TRUNC | ZI_FILE_O_APPEND)) && !want_w) return (zi_handle_t)ZI_E_INVALID;
 
+  // ZI_FILE_O_MAP: read-only files only; params carry u64 out_ptr at +20 that receives
+  // {u64 region_ptr, u32 region_len}.
+  const int want_map = (of & ZI_FILE_O_MAP) != 0;
+  uint8_t* map_out = NULL;
+  if (want_map) {
+    if (want_w || (of & ZI_FILE_O_CREATE) || params_len < 28u) return (zi_handle_t)ZI_E_INVALID;
+    const zi_ptr_t out_ptr = (zi_ptr_t)u64le(p + 20);
+    if (!sem_guest_mem_map_rw(mem, out_ptr, 12u, &map_out) || !map_out) return (zi_handle_t)ZI_E_BOUNDS;
+  }
+
   const mode_t mode = (mode_t)(create_mode ? create_mode : 0644);
   int fd = -1;
   const int rr = open_under_root(fs->cfg.fs_root, path_bytes, path_len, flags, mode, &fd);
   if (rr != 1) return (zi_handle_t)((rr == 0) ? ZI_E_DENIED : rr);
 
+  zi_ptr_t map_ptr = 0;
+  zi_size32_t map_len = 0;
+  if (want_map) {
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+      (void)close(fd);
+      return (zi_handle_t)ZI_E_INVALID;
+    }
+    if ((uint64_t)st.st_size > 0xFFFFFFFFull) {
+      (void)close(fd);
+      return (zi_handle_t)ZI_E_OOM;
+    }
+    map_len = (zi_size32_t)st.st_size;
+    if (map_len) {
+      map_ptr = sem_guest_mem_map_file(mem, fd, map_len);
+      if (!map_ptr) {
+        (void)close(fd);
+        return (zi_handle_t)ZI_E_OOM;
+      }
+    }
+  }
+
   sir_fd_stream* s = (sir_fd_stream*)calloc(1, sizeof(*s));
   if (!s) {
+    sem_guest_mem_unmap_file(mem, map_ptr, map_len);
     (void)close(fd);
     return (zi_handle_t)ZI_E_OOM;
   }
   s->fd = fd;
+  s->map_ptr = map_ptr;
+  s->map_len = map_len;
 
   uint32_t hflags = ZI_H_ENDABLE;
   if (want_r) hflags |= ZI_H_READABLE;
@@ -235,10 +297,16 @@ zi_handle_t sir_hosted_file_fs_open_from_params(sir_hosted_file_fs_t* fs, sem_ha
 
   const zi_handle_t h = sem_handle_alloc(hs, (sem_handle_entry_t){.ops = &fd_ops, .ctx = s, .hflags = hflags});
   if (h < 0) {
+    sem_guest_mem_unmap_file(mem, map_ptr, map_len);
     (void)close(fd);
     free(s);
     return h;
   }
+  if (map_out) {
+    // Written last: the guest sees a region only for a handle it owns.
+    for (int i = 0; i < 8; i++) map_out[i] = (uint8_t)(((uint64_t)map_ptr >> (8 * i)) & 0xffu);
+    for (int i = 0; i < 4; i++) map_out[8 + i] = (uint8_t)((map_len >> (8 * i)) & 0xffu);
+  }
   return h;
 }
 
@@ -11,6 +11,10 @@ enum {
   ZI_FILE_O_CREATE = 1u << 2,
   ZI_FILE_O_TRUNC = 1u << 3,
   ZI_FILE_O_APPEND = 1u << 4,
+  // Also map the file copy-on-write into guest memory (read-only opens). The params
+  // blob grows to 28 bytes: u64 out_ptr at +20 receives {u64 region_ptr, u32 region_len}.
+  // The region is valid until the handle is ended; an empty file yields {0, 0}.
+  ZI_FILE_O_MAP = 1u << 5,
 };
 
 typedef struct sir_hosted_file_fs_cfg {
@@ -1,3 +1,7 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // copy_file_range
+#endif
+
 #include "hosted_zabi.h"
 
 #include "hosted_file_fs.h"
@@ -6,6 +10,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#endif
 
 enum {
   ZI_E_INVALID = -1,
@@ -95,15 +104,37 @@ uint32_t sir_zi_handle_hflags(sir_hosted_zabi_t* rt, zi_handle_t h) {
   return sem_handle_hflags(&rt->handles, h);
 }
 
+// Guest stdout is buffered here (not in the FILE) so flush points are explicit:
+// the buffer drains when full, on '\n' in line mode, on zi_end, before stdin reads
+// (line mode), before writes to stderr or telemetry, and on flush/dispose. Every drain
+// ends with fflush, so nothing stays behind in the FILE between drains.
+#define SIR_STDIO_BUF_CAP (64u * 1024u)
+
 typedef struct sir_stdio_stream {
   FILE* f;
+  sir_stdio_buffering_t mode; // never AUTO once installed
+  uint8_t* buf;               // allocated on first buffered write
+  uint32_t len;
+  struct sir_stdio_stream* out; // stdout stream to drain first (stdin/stderr only)
+  bool input;
 } sir_stdio_stream_t;
 
+static bool stdio_drain(sir_stdio_stream_t* s) {
+  if (!s || !s->f || s->len == 0) return true;
+  const size_t n = fwrite(s->buf, 1, (size_t)s->len, s->f);
+  const bool ok = (n == (size_t)s->len);
+  s->len = 0;
+  return (fflush(s->f) == 0) && ok;
+}
+
 static int32_t stdio_read(void* ctx, sem_guest_mem_t* mem, zi_ptr_t dst_ptr, zi_size32_t cap) {
   sir_stdio_stream_t* s = (sir_stdio_stream_t*)ctx;
   if (!s || !s->f) return ZI_E_INTERNAL;
   if (cap == 0) return 0;
 
+  // Interactive guests: a prompt written without '\n' must be visible before we block.
+  if (s->out && s->out->mode == SIR_STDIO_BUF_LINE && !stdio_drain(s->out)) return ZI_E_INTERNAL;
+
   uint8_t* dst = NULL;
   if (!sem_guest_mem_map_rw(mem, dst_ptr, cap, &dst) || !dst) return ZI_E_BOUNDS;
   const size_t n = fread(dst, 1, (size_t)cap, s->f);
@@ -111,6 +142,28 @@ static int32_t stdio_read(void* ctx, sem_guest_mem_t* mem, zi_ptr_t dst_ptr, zi_
   return (int32_t)n;
 }
 
+static int32_t stdio_put(sir_stdio_stream_t* s, const uint8_t* src, uint32_t len) {
+  if (s->out && !stdio_drain(s->out)) return ZI_E_INTERNAL;
+
+  if (s->mode != SIR_STDIO_BUF_NONE && !s->buf) {
+    s->buf = (uint8_t*)malloc(SIR_STDIO_BUF_CAP);
+    if (!s->buf) s->mode = SIR_STDIO_BUF_NONE;
+  }
+  if (s->mode == SIR_STDIO_BUF_NONE || len >= SIR_STDIO_BUF_CAP) {
+    if (!stdio_drain(s)) return ZI_E_INTERNAL;
+    const size_t n = fwrite(src, 1, (size_t)len, s->f);
+    if (n < (size_t)len) return ZI_E_INTERNAL;
+    (void)fflush(s->f);
+    return (int32_t)n;
+  }
+
+  if (len > SIR_STDIO_BUF_CAP - s->len && !stdio_drain(s)) return ZI_E_INTERNAL;
+  memcpy(s->buf + s->len, src, len);
+  s->len += len;
+  if (s->mode == SIR_STDIO_BUF_LINE && memchr(src, '\n', len) && !stdio_drain(s)) return ZI_E_INTERNAL;
+  return (int32_t)len;
+}
+
 static int32_t stdio_write(void* ctx, sem_guest_mem_t* mem, zi_ptr_t src_ptr, zi_size32_t len) {
   sir_stdio_stream_t* s = (sir_stdio_stream_t*)ctx;
   if (!s || !s->f) return ZI_E_INTERNAL;
@@ -118,16 +171,39 @@ static int32_t stdio_write(void* ctx, sem_guest_mem_t* mem, zi_ptr_t src_ptr, zi
 
   const uint8_t* src = NULL;
   if (!sem_guest_mem_map_ro(mem, src_ptr, len, &src) || !src) return ZI_E_BOUNDS;
-  const size_t n = fwrite(src, 1, (size_t)len, s->f);
-  if (n < (size_t)len) return ZI_E_INTERNAL;
-  (void)fflush(s->f);
+  return stdio_put(s, src, len);
+}
+
+static int stdio_host_fd(void* ctx) {
+  sir_stdio_stream_t* s = (sir_stdio_stream_t*)ctx;
+  // stdin may hold read-ahead in its FILE; only output streams expose the descriptor.
+  if (!s || !s->f || s->input) return -1;
+  if (s->out && !stdio_drain(s->out)) return -1;
+  if (!stdio_drain(s) || fflush(s->f) != 0) return -1;
+  return fileno(s->f);
+}
+
+static int32_t stdio_read_host(void* ctx, uint8_t* dst, uint32_t cap) {
+  sir_stdio_stream_t* s = (sir_stdio_stream_t*)ctx;
+  if (!s || !s->f) return ZI_E_INTERNAL;
+  if (s->out && s->out->mode == SIR_STDIO_BUF_LINE && !stdio_drain(s->out)) return ZI_E_INTERNAL;
+  const size_t n = fread(dst, 1, (size_t)cap, s->f);
+  if (n == 0 && ferror(s->f)) return ZI_E_INTERNAL;
   return (int32_t)n;
 }
 
+static int32_t stdio_write_host(void* ctx, const uint8_t* src, uint32_t len) {
+  sir_stdio_stream_t* s = (sir_stdio_stream_t*)ctx;
+  if (!s || !s->f) return ZI_E_INTERNAL;
+  if (len == 0) return 0;
+  return stdio_put(s, src, len);
+}
+
 static int32_t stdio_end(void* ctx, sem_guest_mem_t* mem) {
   (void)mem;
   sir_stdio_stream_t* s = (sir_stdio_stream_t*)ctx;
   if (!s) return 0;
+  if (!stdio_drain(s)) return ZI_E_INTERNAL;
   if (s->f) (void)fflush(s->f);
   return 0;
 }
@@ -136,6 +212,9 @@ static const sem_handle_ops_t stdio_ops = {
     .read = stdio_read,
     .write = stdio_write,
     .end = stdio_end,
+    .host_fd = stdio_host_fd,
+    .read_host = stdio_read_host,
+    .write_host = stdio_write_host,
 };
 
 static bool str_eq_bytes(const char* s, const uint8_t* b, uint32_t n) {
@@ -163,13 +242,28 @@ bool sir_hosted_zabi_init(sir_hosted_zabi_t* rt, sir_hosted_zabi_cfg_t cfg) {
   return true;
 }
 
+static sir_stdio_stream_t* stdio_stream(sir_hosted_zabi_t* rt, zi_handle_t h) {
+  sem_handle_entry_t e;
+  if (!sem_handle_lookup(&rt->handles, h, &e) || e.ops != &stdio_ops) return NULL;
+  return (sir_stdio_stream_t*)e.ctx;
+}
+
+bool sir_hosted_zabi_flush(sir_hosted_zabi_t* rt) {
+  if (!rt) return false;
+  return stdio_drain(stdio_stream(rt, 1));
+}
+
 void sir_hosted_zabi_dispose(sir_hosted_zabi_t* rt) {
   if (!rt) return;
 
-  sem_handle_entry_t e;
-  if (sem_handle_lookup(&rt->handles, 0, &e)) free(e.ctx);
-  if (sem_handle_lookup(&rt->handles, 1, &e)) free(e.ctx);
-  if (sem_handle_lookup(&rt->handles, 2, &e)) free(e.ctx);
+  (void)sir_hosted_zabi_flush(rt);
+  sir_hosted_async_free(rt->async);
+  for (zi_handle_t h = 0; h < 3; h++) {
+    sir_stdio_stream_t* s = stdio_stream(rt, h);
+    if (!s) continue;
+    free(s->buf);
+    free(s);
+  }
 
   sem_handles_dispose(&rt->handles);
   if (rt->owns_mem && rt->mem) {
@@ -219,12 +313,63 @@ int32_t sir_zi_end(sir_hosted_zabi_t* rt, zi_handle_t h) {
   return r;
 }
 
+// Kernel-side copy between descriptors; returns bytes moved, or -1 when the pair is
+// not supported (the caller falls back to a host buffer).
+static int64_t transfer_kernel(int dst_fd, int src_fd, uint32_t len) {
+#if defined(__linux__)
+  ssize_t n = copy_file_range(src_fd, NULL, dst_fd, NULL, (size_t)len, 0);
+  if (n >= 0) return (int64_t)n;
+  n = sendfile(dst_fd, src_fd, NULL, (size_t)len);
+  if (n >= 0) return (int64_t)n;
+#else
+  (void)dst_fd;
+  (void)src_fd;
+  (void)len;
+#endif
+  return -1;
+}
+
+int32_t sir_zi_transfer(sir_hosted_zabi_t* rt, zi_handle_t dst, zi_handle_t src, zi_size32_t len) {
+  if (!rt) return ZI_E_INTERNAL;
+  sem_handle_entry_t d;
+  sem_handle_entry_t r;
+  if (!sem_handle_lookup(&rt->handles, src, &r) || !r.ops || (r.hflags & ZI_H_READABLE) == 0) return ZI_E_NOSYS;
+  if (!sem_handle_lookup(&rt->handles, dst, &d) || !d.ops || (d.hflags & ZI_H_WRITABLE) == 0) return ZI_E_NOSYS;
+  if (!r.ops->read_host || !d.ops->write_host) return ZI_E_NOSYS;
+  if (len == 0) return 0;
+  if (len > 0x7FFFFFFFu) len = 0x7FFFFFFFu;
+
+  const int src_fd = r.ops->host_fd ? r.ops->host_fd(r.ctx) : -1;
+  const int dst_fd = (src_fd >= 0 && d.ops->host_fd) ? d.ops->host_fd(d.ctx) : -1;
+  if (src_fd >= 0 && dst_fd >= 0) {
+    const int64_t n = transfer_kernel(dst_fd, src_fd, len);
+    if (n >= 0) return (int32_t)n;
+  }
+
+  // One bounce chunk through host memory. Short writes are retried until the chunk is
+  // out; bytes read from `src` cannot be put back, so a failed write fails the call even
+  // after a partial write instead of returning a count that silently drops the rest.
+  uint8_t tmp[16384];
+  const uint32_t want = len < (uint32_t)sizeof(tmp) ? len : (uint32_t)sizeof(tmp);
+  const int32_t n = r.ops->read_host(r.ctx, tmp, want);
+  if (n <= 0) return n;
+  uint32_t off = 0;
+  while (off < (uint32_t)n) {
+    const int32_t w = d.ops->write_host(d.ctx, tmp + off, (uint32_t)n - off);
+    if (w < 0) return w;
+    if (w == 0) return ZI_E_IO;
+    off += (uint32_t)w;
+  }
+  return n;
+}
+
 int32_t sir_zi_telemetry(sir_hosted_zabi_t* rt, zi_ptr_t topic_ptr, zi_size32_t topic_len, zi_ptr_t msg_ptr, zi_size32_t msg_len) {
   if (!rt) return ZI_E_INTERNAL;
   const uint8_t* topic = NULL;
   const uint8_t* msg = NULL;
   if (topic_len && (!sem_guest_mem_map_ro(rt->mem, topic_ptr, topic_len, &topic) || !topic)) return ZI_E_BOUNDS;
   if (msg_len && (!sem_guest_mem_map_ro(rt->mem, msg_ptr, msg_len, &msg) || !msg)) return ZI_E_BOUNDS;
+  (void)sir_hosted_zabi_flush(rt);
   fprintf(stderr, "telemetry[%.*s]: %.*s\n", (int)topic_len, (const char*)topic, (int)msg_len, (const char*)msg);
   return 0;
 }
@@ -289,6 +434,12 @@ zi_handle_t sir_zi_cap_open(sir_hosted_zabi_t* rt, zi_ptr_t req_ptr) {
   return (zi_handle_t)ZI_E_DENIED;
 }
 
+// zi_ctl ops beyond what sem_host answers itself.
+static int32_t async_ctl(void* user, const uint8_t* req, uint32_t req_len, uint8_t* resp, uint32_t resp_cap) {
+  sir_hosted_zabi_t* rt = (sir_hosted_zabi_t*)user;
+  return sir_hosted_async_ctl(rt->async, &rt->handles, req, req_len, resp, resp_cap);
+}
+
 bool sir_hosted_zabi_init_with_mem(sir_hosted_zabi_t* rt, sem_guest_mem_t* mem, sir_hosted_zabi_cfg_t cfg) {
   if (!rt || !mem) return false;
   memset(rt, 0, sizeof(*rt));
@@ -296,14 +447,27 @@ bool sir_hosted_zabi_init_with_mem(sir_hosted_zabi_t* rt, sem_guest_mem_t* mem,
   rt->mem = mem;
   rt->owns_mem = false;
 
-  if (!sem_handles_init(&rt->handles, 4096)) {
+  if (!sem_handles_init(&rt->handles, SEM_HANDLES_MAX)) {
     return false;
   }
 
   rt->abi_version = cfg.abi_version ? cfg.abi_version : 0x00020005u;
   rt->fs_root = (cfg.fs_root && cfg.fs_root[0] != '\0') ? cfg.fs_root : NULL;
 
-  sem_host_init(&rt->ctl_host, (sem_host_cfg_t){.caps = cfg.caps, .cap_count = cfg.cap_count});
+  for (uint32_t i = 0; i < cfg.cap_count; i++) {
+    const sem_cap_t* c = &cfg.caps[i];
+    if (!c->kind || !c->name || strcmp(c->kind, "async") != 0 || strcmp(c->name, "default") != 0) continue;
+    rt->async = sir_hosted_async_new(cfg.async_inline ? 0u : (cfg.async_workers ? cfg.async_workers : SIR_ASYNC_DEFAULT_WORKERS));
+    if (!rt->async) {
+      sem_handles_dispose(&rt->handles);
+      return false;
+    }
+    break;
+  }
+  sem_host_init(&rt->ctl_host, (sem_host_cfg_t){.caps = cfg.caps,
+                                                .cap_count = cfg.cap_count,
+                                                .ext = rt->async ? async_ctl : NULL,
+                                                .ext_user = rt});
 
   sir_stdio_stream_t* in = (sir_stdio_stream_t*)calloc(1, sizeof(*in));
   sir_stdio_stream_t* out = (sir_stdio_stream_t*)calloc(1, sizeof(*out));
@@ -312,12 +476,24 @@ bool sir_hosted_zabi_init_with_mem(sir_hosted_zabi_t* rt, sem_guest_mem_t* mem,
     free(in);
     free(out);
     free(err);
+    sir_hosted_async_free(rt->async);
     sem_handles_dispose(&rt->handles);
     return false;
   }
-  in->f = stdin;
-  out->f = stdout;
-  err->f = stderr;
+  in->f = cfg.stdin_f ? cfg.stdin_f : stdin;
+  out->f = cfg.stdout_f ? cfg.stdout_f : stdout;
+  err->f = cfg.stderr_f ? cfg.stderr_f : stderr;
+
+  out->mode = cfg.stdout_buffering;
+  if (out->mode == SIR_STDIO_BUF_AUTO) {
+    const int fd = fileno(out->f);
+    out->mode = (fd >= 0 && isatty(fd)) ? SIR_STDIO_BUF_LINE : SIR_STDIO_BUF_FULL;
+  }
+  in->mode = SIR_STDIO_BUF_NONE;
+  in->out = out;
+  in->input = true;
+  err->mode = SIR_STDIO_BUF_NONE;
+  err->out = out;
 
   (void)sem_handle_install(&rt->handles, 0,
                            (sem_handle_entry_t){.ops = &stdio_ops, .ctx = in, .hflags = ZI_H_READABLE | ZI_H_ENDABLE});
@@ -2,9 +2,11 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdio.h>
 
 #include "guest_mem.h"
 #include "handles.h"
+#include "hosted_async.h"
 #include "sem_host.h"
 
 // Hosted zABI-ish runtime core used by emulators/tools/VM.
@@ -27,8 +29,18 @@ typedef struct sir_hosted_zabi {
   sem_host_t ctl_host; // zi_ctl ops (e.g. CAPS_LIST)
   uint32_t abi_version;
   const char* fs_root;
+  sir_hosted_async_t* async; // async:default queue (zi_ctl ASYNC_SUBMIT/POLL), NULL without the cap
 } sir_hosted_zabi_t;
 
+// Buffering of guest stdout (handle 1). stdin and stderr are never buffered; a write to
+// stderr drains stdout first so the two interleave in program order.
+typedef enum sir_stdio_buffering {
+  SIR_STDIO_BUF_AUTO = 0, // LINE when stdout is a TTY, FULL otherwise
+  SIR_STDIO_BUF_NONE = 1, // flush on every zi_write
+  SIR_STDIO_BUF_LINE = 2, // flush on '\n'
+  SIR_STDIO_BUF_FULL = 3, // flush when the buffer fills
+} sir_stdio_buffering_t;
+
 typedef struct sir_hosted_zabi_cfg {
   uint32_t abi_version;   // e.g. 0x00020005
   uint32_t guest_mem_cap; // bytes
@@ -40,11 +52,28 @@ typedef struct sir_hosted_zabi_cfg {
 
   // Optional: enable file/fs sandbox.
   const char* fs_root;
+
+  // Optional: streams behind guest handles 0/1/2 (NULL = process stdin/stdout/stderr).
+  // Not owned by the runtime; lets embedders feed/capture guest stdio per run.
+  FILE* stdin_f;
+  FILE* stdout_f;
+  FILE* stderr_f;
+  sir_stdio_buffering_t stdout_buffering;
+
+  // Worker threads behind the async:default cap (0 = SIR_ASYNC_DEFAULT_WORKERS);
+  // `async_inline` runs every op at submit time instead.
+  uint32_t async_workers;
+  bool async_inline;
 } sir_hosted_zabi_cfg_t;
 
 bool sir_hosted_zabi_init(sir_hosted_zabi_t* rt, sir_hosted_zabi_cfg_t cfg);
+// Flushes buffered guest output first and waits for in-flight async ops.
 void sir_hosted_zabi_dispose(sir_hosted_zabi_t* rt);
 
+// Writes out buffered guest stdout. Call before reporting a trap or anything else that
+// must appear after the guest's output. Returns false if the write failed.
+bool sir_hosted_zabi_flush(sir_hosted_zabi_t* rt);
+
 // Initializes using an externally owned guest memory arena.
 bool sir_hosted_zabi_init_with_mem(sir_hosted_zabi_t* rt, sem_guest_mem_t* mem, sir_hosted_zabi_cfg_t cfg);
 
@@ -56,6 +85,11 @@ int32_t sir_zi_write(sir_hosted_zabi_t* rt, zi_handle_t h, zi_ptr_t src_ptr, zi_
 int32_t sir_zi_end(sir_hosted_zabi_t* rt, zi_handle_t h);
 zi_ptr_t sir_zi_alloc(sir_hosted_zabi_t* rt, zi_size32_t size);
 int32_t sir_zi_free(sir_hosted_zabi_t* rt, zi_ptr_t ptr);
+// Moves up to `len` bytes from `src` to `dst` without touching guest memory: kernel
+// copy (copy_file_range/sendfile) between file descriptors where available, one host
+// buffer chunk otherwise. Returns bytes moved (0 at EOF of `src`) or a ZI_E_* error;
+// a write error is reported even if part of the chunk was already written.
+int32_t sir_zi_transfer(sir_hosted_zabi_t* rt, zi_handle_t dst, zi_handle_t src, zi_size32_t len);
 int32_t sir_zi_telemetry(sir_hosted_zabi_t* rt, zi_ptr_t topic_ptr, zi_size32_t topic_len, zi_ptr_t msg_ptr, zi_size32_t msg_len);
 
 // --- zABI caps extension (hosted) ---
@@ -61,9 +61,67 @@ static int32_t sem_write_error(uint8_t* resp, uint32_t resp_cap, uint16_t op, ui
   return (int32_t)resp_len;
 }
 
+static int32_t sem_zi_ctl_one(const sem_host_t* h, const uint8_t* req, uint32_t req_len, uint8_t* resp, uint32_t resp_cap,
+                              bool in_batch);
+
+// BATCH: sub-responses are written in place after the response header, each as
+// {i32 rc, u32 len, frame[len]}; a sub that fails at the transport level (rc < 0, e.g. its
+// response did not fit) gets len 0 and the batch goes on.
+static int32_t sem_zi_ctl_batch(const sem_host_t* h, const zcl1_hdr_t* rh, const uint8_t* payload, uint8_t* resp, uint32_t resp_cap) {
+  if (rh->payload_len < 4) {
+    return sem_write_error(resp, resp_cap, rh->op, rh->rid, "sem.zi_ctl.invalid", "BATCH payload must start with a count", "");
+  }
+  const uint32_t n = zcl1_read_u32le(payload);
+  if (n > SEM_ZI_CTL_BATCH_MAX) {
+    return sem_write_error(resp, resp_cap, rh->op, rh->rid, "sem.zi_ctl.invalid", "BATCH has too many sub-requests", "");
+  }
+  // Validate the framing up front so a malformed batch runs nothing.
+  uint32_t off = 4;
+  for (uint32_t i = 0; i < n; i++) {
+    if (rh->payload_len - off < 4 || rh->payload_len - off - 4 < zcl1_read_u32le(payload + off)) {
+      return sem_write_error(resp, resp_cap, rh->op, rh->rid, "sem.zi_ctl.invalid", "BATCH sub-request overruns the payload", "");
+    }
+    off += 4 + zcl1_read_u32le(payload + off);
+  }
+  if (off != rh->payload_len) {
+    return sem_write_error(resp, resp_cap, rh->op, rh->rid, "sem.zi_ctl.invalid", "BATCH payload has trailing bytes", "");
+  }
+  // Sub-requests are read while sub-responses are written; the buffers must not overlap.
+  // The error frame is safe to write either way: nothing reads the request after it.
+  const uintptr_t req_lo = (uintptr_t)payload;
+  const uintptr_t resp_lo = (uintptr_t)resp;
+  if (req_lo < resp_lo + resp_cap && resp_lo < req_lo + rh->payload_len) {
+    return sem_write_error(resp, resp_cap, rh->op, rh->rid, "sem.zi_ctl.invalid", "BATCH request and response buffers overlap", "");
+  }
+  if (resp_cap < ZCL1_HDR_SIZE + 4u) return SEM_ZI_E_BOUNDS;
+
+  uint32_t out = ZCL1_HDR_SIZE + 4u;
+  off = 4;
+  for (uint32_t i = 0; i < n; i++) {
+    const uint32_t sub_len = zcl1_read_u32le(payload + off);
+    const uint8_t* sub = payload + off + 4;
+    off += 4 + sub_len;
+    if (resp_cap - out < 8u) return SEM_ZI_E_BOUNDS;
+    const int32_t rc = sem_zi_ctl_one(h, sub, sub_len, resp + out + 8, resp_cap - out - 8u, true);
+    zcl1_write_u32le(resp + out, (uint32_t)rc);
+    zcl1_write_u32le(resp + out + 4, rc > 0 ? (uint32_t)rc : 0);
+    out += 8u + (rc > 0 ? (uint32_t)rc : 0);
+  }
+
+  // Header last: the sub-responses already sit where the payload goes.
+  uint32_t hdr_len = 0;
+  if (!zcl1_write(resp, ZCL1_HDR_SIZE, rh->op, rh->rid, 1, NULL, 0, &hdr_len)) return SEM_ZI_E_INTERNAL;
+  zcl1_write_u32le(resp + 20, out - ZCL1_HDR_SIZE);
+  zcl1_write_u32le(resp + ZCL1_HDR_SIZE, n);
+  return (int32_t)out;
+}
+
 int32_t sem_zi_ctl(void* user, const uint8_t* req, uint32_t req_len, uint8_t* resp, uint32_t resp_cap) {
-  const sem_host_t* h = (const sem_host_t*)user;
+  return sem_zi_ctl_one((const sem_host_t*)user, req, req_len, resp, resp_cap, false);
+}
 
+static int32_t sem_zi_ctl_one(const sem_host_t* h, const uint8_t* req, uint32_t req_len, uint8_t* resp, uint32_t resp_cap,
+                              bool in_batch) {
   zcl1_hdr_t rh = {0};
   const uint8_t* payload = NULL;
   if (!zcl1_parse(req, req_len, &rh, &payload)) {
@@ -74,6 +132,13 @@ int32_t sem_zi_ctl(void* user, const uint8_t* req, uint32_t req_len, uint8_t* re
     return SEM_ZI_E_INVALID;
   }
 
+  if (rh.op == SEM_ZI_CTL_OP_BATCH) {
+    if (in_batch) {
+      return sem_write_error(resp, resp_cap, rh.op, rh.rid, "sem.zi_ctl.invalid", "BATCH cannot be nested", "");
+    }
+    return sem_zi_ctl_batch(h, &rh, payload, resp, resp_cap);
+  }
+
   if (rh.op == SEM_ZI_CTL_OP_CAPS_LIST) {
     if (rh.payload_len != 0) {
       return sem_write_error(resp, resp_cap, rh.op, rh.rid, "sem.zi_ctl.invalid", "CAPS_LIST payload must be empty", "");
@@ -91,6 +156,11 @@ int32_t sem_zi_ctl(void* user, const uint8_t* req, uint32_t req_len, uint8_t* re
     return (int32_t)out_len;
   }
 
+  if (h && h->cfg.ext) {
+    const int32_t rc = h->cfg.ext(h->cfg.ext_user, req, req_len, resp, resp_cap);
+    if (rc != SEM_ZI_E_NOSYS) return rc;
+  }
+
   return sem_write_error(resp, resp_cap, rh.op, rh.rid, "sem.zi_ctl.nosys", "unsupported zi_ctl op", "");
 }
 
@@ -98,3 +168,26 @@ bool sem_build_caps_list_req(uint32_t rid, uint8_t* out, uint32_t cap, uint32_t*
   return zcl1_write(out, cap, SEM_ZI_CTL_OP_CAPS_LIST, rid, 0, NULL, 0, out_len);
 }
 
+bool sem_build_batch_req(uint32_t rid, const uint8_t* const* subs, const uint32_t* sub_lens, uint32_t n, uint8_t* out, uint32_t cap,
+                         uint32_t* out_len) {
+  if (!out || !out_len || (n && (!subs || !sub_lens)) || n > SEM_ZI_CTL_BATCH_MAX) return false;
+  uint64_t need = (uint64_t)ZCL1_HDR_SIZE + 4u;
+  for (uint32_t i = 0; i < n; i++) need += 4u + (uint64_t)sub_lens[i];
+  if (need > (uint64_t)cap) return false;
+
+  uint32_t off = ZCL1_HDR_SIZE;
+  zcl1_write_u32le(out + off, n);
+  off += 4;
+  for (uint32_t i = 0; i < n; i++) {
+    zcl1_write_u32le(out + off, sub_lens[i]);
+    off += 4;
+    if (sub_lens[i]) memcpy(out + off, subs[i], sub_lens[i]);
+    off += sub_lens[i];
+  }
+  // The payload is already in place; write the header alone and patch its length.
+  uint32_t hdr_len = 0;
+  if (!zcl1_write(out, ZCL1_HDR_SIZE, SEM_ZI_CTL_OP_BATCH, rid, 0, NULL, 0, &hdr_len)) return false;
+  zcl1_write_u32le(out + 20, off - ZCL1_HDR_SIZE);
+  *out_len = off;
+  return true;
+}
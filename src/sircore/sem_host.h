@@ -13,6 +13,11 @@ enum {
 
 enum {
   SEM_ZI_CTL_OP_CAPS_LIST = 1,
+  SEM_ZI_CTL_OP_BATCH = 1000, // N sub-requests in one call (zi_ctl.md §4.2)
+};
+
+enum {
+  SEM_ZI_CTL_BATCH_MAX = 256,
 };
 
 enum {
@@ -29,9 +34,16 @@ typedef struct sem_cap {
   uint32_t meta_len;
 } sem_cap_t;
 
+// Handles ops the host does not know (tool range); returns SEM_ZI_E_NOSYS to decline.
+typedef int32_t (*sem_zi_ctl_ext_fn)(void* user, const uint8_t* req, uint32_t req_len, uint8_t* resp, uint32_t resp_cap);
+
 typedef struct sem_host_cfg {
   const sem_cap_t* caps;
   uint32_t cap_count;
+
+  // Optional: consulted for unknown ops, including BATCH sub-requests.
+  sem_zi_ctl_ext_fn ext;
+  void* ext_user;
 } sem_host_cfg_t;
 
 typedef struct sem_host {
@@ -44,3 +56,7 @@ int32_t sem_zi_ctl(void* user, const uint8_t* req, uint32_t req_len, uint8_t* re
 
 bool sem_build_caps_list_req(uint32_t rid, uint8_t* out, uint32_t cap, uint32_t* out_len);
 
+// Packs `n` complete ZCL1 request frames into one BATCH request.
+bool sem_build_batch_req(uint32_t rid, const uint8_t* const* subs, const uint32_t* sub_lens, uint32_t n, uint8_t* out, uint32_t cap,
+                         uint32_t* out_len);
+
@@ -6,6 +6,11 @@
 #include <string.h>
 #include <limits.h>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 static bool is_pow2_u32(uint32_t x);
 
 enum {
@@ -80,6 +85,17 @@ struct sir_module_builder {
 typedef struct sir_module_impl {
   sir_module_t pub;
   struct sir_pool_block* pool_head;
+
+  // Type/sym tables replaced by sir_mb_func_commit. A running module may still point
+  // into them, so they are only freed with the module.
+  void** retired;
+  uint32_t retired_n;
+  uint32_t retired_cap;
+
+  // Set for modules loaded by sir_module_load_image: types/insts/blobs live in
+  // this read-only mapping; only funcs/syms/globals are heap arrays.
+  void* image;
+  size_t image_len;
 } sir_module_impl_t;
 
 static sir_module_impl_t* module_impl_from_pub(sir_module_t* m) {
@@ -363,6 +379,13 @@ bool sir_mb_func_set_sig(sir_module_builder_t* b, sir_func_id_t f, sir_sig_t sig
   return true;
 }
 
+bool sir_mb_func_set_lazy(sir_module_builder_t* b, sir_func_id_t f, bool lazy) {
+  if (!b) return false;
+  if (f == 0 || f > b->funcs.n) return false;
+  b->funcs.p[f - 1].lazy = lazy;
+  return true;
+}
+
 void sir_mb_set_src(sir_module_builder_t* b, uint32_t node_id, uint32_t line) {
   if (!b) return;
   b->cur_src_node_id = node_id;
@@ -1240,6 +1263,14 @@ void sir_module_free(sir_module_t* m) {
   if (!impl) return;
 
   const sir_module_t* pub = &impl->pub;
+  if (impl->image) {
+    free((void*)pub->funcs);
+    free((void*)pub->globals);
+    free((void*)pub->syms);
+    munmap(impl->image, impl->image_len);
+    free(impl);
+    return;
+  }
   if (pub->funcs) {
     for (uint32_t fi = 0; fi < pub->func_count; fi++) {
       free((void*)pub->funcs[fi].insts);
@@ -1249,6 +1280,8 @@ void sir_module_free(sir_module_t* m) {
   free((void*)pub->globals);
   free((void*)pub->syms);
   free((void*)pub->types);
+  for (uint32_t i = 0; i < impl->retired_n; i++) free(impl->retired[i]);
+  free(impl->retired);
   sir_pool_block_t* pb = (sir_pool_block_t*)impl->pool_head;
   while (pb) {
     sir_pool_block_t* next = pb->next;
@@ -1258,6 +1291,488 @@ void sir_module_free(sir_module_t* m) {
   free(impl);
 }
 
+static bool module_retire(sir_module_impl_t* impl, const void* p) {
+  if (!p) return true;
+  if (impl->retired_n == impl->retired_cap) {
+    const uint32_t ncap = impl->retired_cap ? impl->retired_cap * 2u : 8u;
+    void** np = (void**)realloc(impl->retired, (size_t)ncap * sizeof(*np));
+    if (!np) return false;
+    impl->retired = np;
+    impl->retired_cap = ncap;
+  }
+  impl->retired[impl->retired_n++] = (void*)p;
+  return true;
+}
+
+bool sir_mb_func_commit(sir_module_builder_t* b, sir_module_t* m, sir_func_id_t f, sir_validate_diag_t* out) {
+  if (out) memset(out, 0, sizeof(*out));
+  if (!b || !m) return false;
+  if (f == 0 || f > b->funcs.n || f > m->func_count) return false;
+  sir_func_t* mf = (sir_func_t*)&m->funcs[f - 1];
+  if (!mf->lazy) return false;
+  // Globals are allocated once at run start; a lazy body cannot add new ones.
+  if (b->globals.n != m->global_count) return false;
+  sir_module_impl_t* impl = module_impl_from_pub(m);
+
+  // Lowering the body may have interned new types/syms; republish the tables. Tables only
+  // grow (existing ids keep their entries), and the old copies stay alive with `m`.
+  if (b->types.n != m->type_count) {
+    sir_type_t* types = (sir_type_t*)dup_mem(b->types.p, (size_t)b->types.n * sizeof(sir_type_t));
+    if (!types) return false;
+    if (!module_retire(impl, m->types)) {
+      free(types);
+      return false;
+    }
+    m->types = types;
+    m->type_count = b->types.n;
+  }
+  if (b->syms.n != m->sym_count) {
+    sir_sym_t* syms = (sir_sym_t*)dup_mem(b->syms.p, (size_t)b->syms.n * sizeof(sir_sym_t));
+    if (!syms) return false;
+    if (!module_retire(impl, m->syms)) {
+      free(syms);
+      return false;
+    }
+    m->syms = syms;
+    m->sym_count = b->syms.n;
+  }
+
+  // Pool blocks allocated since finalize back the new body/syms; hand them over.
+  if (b->pool.head) {
+    struct sir_pool_block** tail = &impl->pool_head;
+    while (*tail) tail = &((sir_pool_block_t*)*tail)->next;
+    *tail = b->pool.head;
+    b->pool.head = NULL;
+    b->pool.cur = NULL;
+  }
+
+  // Install the body and validate it; the builder keeps its buffer until it passes, so
+  // an invalid body is never left runnable.
+  sir_dyn_insts_t* d = &b->func_insts[f - 1];
+  mf->insts = d->p;
+  mf->inst_count = d->n;
+  mf->value_count = b->funcs.p[f - 1].value_count;
+  mf->lazy = false;
+  if (!sir_module_validate_func_ex(m, f, out)) {
+    mf->insts = NULL;
+    mf->inst_count = 0;
+    mf->lazy = true;
+    return false;
+  }
+  *d = (sir_dyn_insts_t){0};
+  b->funcs.p[f - 1].lazy = false;
+  return true;
+}
+
+// Module images (.sirm).
+//
+// Layout: header, then 16-byte aligned sections (types, syms, globals, funcs,
+// insts, blob). Every pointer in the module is stored as a u32 offset into the
+// blob (0 == NULL). Types and the instruction array are used in place from a
+// read-only mapping: instruction operands stay offsets (sir_module_t.blob) and are
+// resolved on use, so loading never touches the instruction pages.
+#define SIRM_ENDIAN_TAG 0x01020304u
+
+typedef struct sirm_header {
+  char magic[4]; // "SIRM"
+  uint32_t version;
+  uint32_t endian_tag;
+  uint16_t ptr_size;
+  uint16_t inst_size;
+  uint32_t entry;
+  uint32_t type_count;
+  uint32_t sym_count;
+  uint32_t global_count;
+  uint32_t func_count;
+  uint32_t inst_count;
+  uint32_t reserved;
+  uint64_t types_off;
+  uint64_t syms_off;
+  uint64_t globals_off;
+  uint64_t funcs_off;
+  uint64_t insts_off;
+  uint64_t blob_off;
+  uint64_t blob_size;
+  uint64_t file_size;
+} sirm_header_t;
+
+typedef struct sirm_sym {
+  uint32_t kind;
+  uint32_t name;
+  uint32_t params;
+  uint32_t param_count;
+  uint32_t results;
+  uint32_t result_count;
+} sirm_sym_t;
+
+typedef struct sirm_global {
+  uint32_t name;
+  uint32_t size;
+  uint32_t align;
+  uint32_t init;
+  uint32_t init_len;
+} sirm_global_t;
+
+typedef struct sirm_func {
+  uint32_t name;
+  uint32_t inst_first;
+  uint32_t inst_count;
+  uint32_t value_count;
+  uint32_t params;
+  uint32_t param_count;
+  uint32_t results;
+  uint32_t result_count;
+} sirm_func_t;
+
+typedef struct sirm_blob {
+  uint8_t* p;
+  size_t n;
+  size_t cap;
+  bool failed;
+} sirm_blob_t;
+
+static uint64_t sirm_align16(uint64_t x) { return (x + 15u) & ~(uint64_t)15u; }
+
+// Appends `len` bytes (4-byte aligned) and returns their offset; NULL maps to 0.
+static uint32_t sirm_blob_put(sirm_blob_t* b, const void* data, size_t len) {
+  if (!data || b->failed) return 0;
+  const size_t off = (b->n + 3u) & ~(size_t)3u;
+  if (off + len > UINT32_MAX) {
+    b->failed = true;
+    return 0;
+  }
+  if (off + len > b->cap) {
+    size_t cap = b->cap ? b->cap : 4096;
+    while (cap < off + len) cap *= 2;
+    uint8_t* np = (uint8_t*)realloc(b->p, cap);
+    if (!np) {
+      b->failed = true;
+      return 0;
+    }
+    b->p = np;
+    b->cap = cap;
+  }
+  memset(b->p + b->n, 0, off - b->n);
+  if (len) memcpy(b->p + off, data, len);
+  b->n = off + len;
+  return (uint32_t)off;
+}
+
+static uint32_t sirm_blob_put_cstr(sirm_blob_t* b, const char* s) {
+  return s ? sirm_blob_put(b, s, strlen(s) + 1) : 0;
+}
+
+static const void* sirm_off_ptr(uintptr_t off) { return (const void*)off; }
+
+// Rewrites the out-of-line pointers of `i` (a copy) as blob offsets.
+static void sirm_inst_to_image(sirm_blob_t* b, sir_inst_t* i) {
+  switch (i->k) {
+    case SIR_INST_CONST_BYTES:
+      i->u.const_bytes.bytes = (const uint8_t*)sirm_off_ptr(sirm_blob_put(b, i->u.const_bytes.bytes, i->u.const_bytes.len));
+      break;
+    case SIR_INST_BR: {
+      const size_t n = (size_t)i->u.br.arg_count * sizeof(sir_val_id_t);
+      i->u.br.src_slots = (const sir_val_id_t*)sirm_off_ptr(sirm_blob_put(b, i->u.br.src_slots, n));
+      i->u.br.dst_slots = (const sir_val_id_t*)sirm_off_ptr(sirm_blob_put(b, i->u.br.dst_slots, n));
+      break;
+    }
+    case SIR_INST_SWITCH: {
+      const size_t n = (size_t)i->u.sw.case_count * sizeof(uint32_t);
+      i->u.sw.case_lits = (const int32_t*)sirm_off_ptr(sirm_blob_put(b, i->u.sw.case_lits, n));
+      i->u.sw.case_target = (const uint32_t*)sirm_off_ptr(sirm_blob_put(b, i->u.sw.case_target, n));
+      break;
+    }
+    case SIR_INST_CALL_EXTERN:
+      i->u.call_extern.args =
+          (const sir_val_id_t*)sirm_off_ptr(sirm_blob_put(b, i->u.call_extern.args, (size_t)i->u.call_extern.arg_count * sizeof(sir_val_id_t)));
+      break;
+    case SIR_INST_CALL_FUNC:
+      i->u.call_func.args =
+          (const sir_val_id_t*)sirm_off_ptr(sirm_blob_put(b, i->u.call_func.args, (size_t)i->u.call_func.arg_count * sizeof(sir_val_id_t)));
+      break;
+    case SIR_INST_CALL_FUNC_PTR:
+      i->u.call_func_ptr.args = (const sir_val_id_t*)sirm_off_ptr(
+          sirm_blob_put(b, i->u.call_func_ptr.args, (size_t)i->u.call_func_ptr.arg_count * sizeof(sir_val_id_t)));
+      break;
+    default:
+      break;
+  }
+}
+
+static bool sirm_write_section(FILE* f, uint64_t* pos, uint64_t off, const void* data, size_t len) {
+  static const uint8_t zeros[16] = {0};
+  while (*pos < off) {
+    const size_t pad = (size_t)(off - *pos);
+    const size_t n = pad < sizeof(zeros) ? pad : sizeof(zeros);
+    if (fwrite(zeros, 1, n, f) != n) return false;
+    *pos += n;
+  }
+  if (len && fwrite(data, 1, len, f) != len) return false;
+  *pos += len;
+  return true;
+}
+
+bool sir_module_write_image(const sir_module_t* m, const char* path) {
+  if (!m || !path) return false;
+
+  uint64_t inst_total = 0;
+  for (uint32_t fi = 0; fi < m->func_count; fi++) {
+    if (m->funcs[fi].lazy) return false;
+    inst_total += m->funcs[fi].inst_count;
+  }
+  if (inst_total > UINT32_MAX) return false;
+
+  sirm_blob_t blob = {0};
+  // Reserve offset 0 so it can stand for NULL.
+  (void)sirm_blob_put(&blob, "\0\0\0\0\0\0\0", 8);
+
+  sirm_sym_t* syms = (sirm_sym_t*)calloc(m->sym_count ? m->sym_count : 1, sizeof(*syms));
+  sirm_global_t* globals = (sirm_global_t*)calloc(m->global_count ? m->global_count : 1, sizeof(*globals));
+  sirm_func_t* funcs = (sirm_func_t*)calloc(m->func_count ? m->func_count : 1, sizeof(*funcs));
+  sir_inst_t* insts = (sir_inst_t*)calloc(inst_total ? (size_t)inst_total : 1, sizeof(*insts));
+  bool ok = syms && globals && funcs && insts;
+
+  for (uint32_t i = 0; ok && i < m->sym_count; i++) {
+    const sir_sym_t* s = &m->syms[i];
+    syms[i] = (sirm_sym_t){
+        .kind = (uint32_t)s->kind,
+        .name = sirm_blob_put_cstr(&blob, s->name),
+        .params = sirm_blob_put(&blob, s->sig.params, (size_t)s->sig.param_count * sizeof(sir_type_id_t)),
+        .param_count = s->sig.param_count,
+        .results = sirm_blob_put(&blob, s->sig.results, (size_t)s->sig.result_count * sizeof(sir_type_id_t)),
+        .result_count = s->sig.result_count,
+    };
+  }
+  for (uint32_t i = 0; ok && i < m->global_count; i++) {
+    const sir_global_t* g = &m->globals[i];
+    globals[i] = (sirm_global_t){
+        .name = sirm_blob_put_cstr(&blob, g->name),
+        .size = g->size,
+        .align = g->align,
+        .init = sirm_blob_put(&blob, g->init_bytes, g->init_len),
+        .init_len = g->init_len,
+    };
+  }
+  uint32_t next_inst = 0;
+  for (uint32_t fi = 0; ok && fi < m->func_count; fi++) {
+    const sir_func_t* f = &m->funcs[fi];
+    funcs[fi] = (sirm_func_t){
+        .name = sirm_blob_put_cstr(&blob, f->name),
+        .inst_first = next_inst,
+        .inst_count = f->inst_count,
+        .value_count = f->value_count,
+        .params = sirm_blob_put(&blob, f->sig.params, (size_t)f->sig.param_count * sizeof(sir_type_id_t)),
+        .param_count = f->sig.param_count,
+        .results = sirm_blob_put(&blob, f->sig.results, (size_t)f->sig.result_count * sizeof(sir_type_id_t)),
+        .result_count = f->sig.result_count,
+    };
+    for (uint32_t ip = 0; ip < f->inst_count; ip++) {
+      sir_inst_t* i = &insts[next_inst++];
+      memcpy(i, &f->insts[ip], sizeof(*i));
+      sirm_inst_to_image(&blob, i);
+    }
+  }
+  if (blob.failed) ok = false;
+
+  sirm_header_t h;
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, "SIRM", 4);
+  h.version = SIR_MODULE_IMAGE_VERSION;
+  h.endian_tag = SIRM_ENDIAN_TAG;
+  h.ptr_size = (uint16_t)sizeof(void*);
+  h.inst_size = (uint16_t)sizeof(sir_inst_t);
+  h.entry = m->entry;
+  h.type_count = m->type_count;
+  h.sym_count = m->sym_count;
+  h.global_count = m->global_count;
+  h.func_count = m->func_count;
+  h.inst_count = (uint32_t)inst_total;
+  h.types_off = sirm_align16(sizeof(h));
+  h.syms_off = sirm_align16(h.types_off + (uint64_t)m->type_count * sizeof(sir_type_t));
+  h.globals_off = sirm_align16(h.syms_off + (uint64_t)m->sym_count * sizeof(sirm_sym_t));
+  h.funcs_off = sirm_align16(h.globals_off + (uint64_t)m->global_count * sizeof(sirm_global_t));
+  h.insts_off = sirm_align16(h.funcs_off + (uint64_t)m->func_count * sizeof(sirm_func_t));
+  h.blob_off = sirm_align16(h.insts_off + inst_total * sizeof(sir_inst_t));
+  h.blob_size = blob.n;
+  h.file_size = h.blob_off + h.blob_size;
+
+  FILE* f = ok ? fopen(path, "wb") : NULL;
+  if (f) {
+    uint64_t pos = sizeof(h);
+    ok = fwrite(&h, 1, sizeof(h), f) == sizeof(h) &&
+         sirm_write_section(f, &pos, h.types_off, m->types, (size_t)m->type_count * sizeof(sir_type_t)) &&
+         sirm_write_section(f, &pos, h.syms_off, syms, (size_t)m->sym_count * sizeof(sirm_sym_t)) &&
+         sirm_write_section(f, &pos, h.globals_off, globals, (size_t)m->global_count * sizeof(sirm_global_t)) &&
+         sirm_write_section(f, &pos, h.funcs_off, funcs, (size_t)m->func_count * sizeof(sirm_func_t)) &&
+         sirm_write_section(f, &pos, h.insts_off, insts, (size_t)inst_total * sizeof(sir_inst_t)) &&
+         sirm_write_section(f, &pos, h.blob_off, blob.p, blob.n);
+    if (fclose(f) != 0) ok = false;
+    if (!ok) remove(path);
+  } else {
+    ok = false;
+  }
+
+  free(insts);
+  free(funcs);
+  free(globals);
+  free(syms);
+  free(blob.p);
+  return ok;
+}
+
+// Resolves a blob offset to `len` bytes; offset 0 is NULL and only valid when
+// nothing was stored there.
+static bool sirm_blob_ref(const uint8_t* blob, uint64_t blob_size, uintptr_t off, uint64_t len, const void** out) {
+  if (off == 0) {
+    *out = NULL;
+    return true;
+  }
+  if ((off & 3u) != 0 || off > blob_size || len > blob_size - off) return false;
+  *out = blob + off;
+  return true;
+}
+
+static bool sirm_blob_cstr(const uint8_t* blob, uint64_t blob_size, uint32_t off, const char** out) {
+  if (off == 0) {
+    *out = NULL;
+    return true;
+  }
+  if (off >= blob_size || !memchr(blob + off, 0, (size_t)(blob_size - off))) return false;
+  *out = (const char*)(blob + off);
+  return true;
+}
+
+static bool sirm_sig_from_image(const uint8_t* blob, uint64_t blob_size, uint32_t params, uint32_t param_count, uint32_t results,
+                                uint32_t result_count, sir_sig_t* out) {
+  const void* p = NULL;
+  const void* r = NULL;
+  if (!sirm_blob_ref(blob, blob_size, params, (uint64_t)param_count * sizeof(sir_type_id_t), &p)) return false;
+  if (!sirm_blob_ref(blob, blob_size, results, (uint64_t)result_count * sizeof(sir_type_id_t), &r)) return false;
+  if ((param_count && !p) || (result_count && !r)) return false;
+  *out = (sir_sig_t){.params = (const sir_type_id_t*)p, .param_count = param_count, .results = (const sir_type_id_t*)r, .result_count = result_count};
+  return true;
+}
+
+static bool sirm_section_ok(const sirm_header_t* h, uint64_t off, uint64_t count, uint64_t elem, uint64_t align) {
+  if (off % align) return false;
+  if (off < sizeof(*h) || off > h->file_size) return false;
+  return count <= (h->file_size - off) / elem;
+}
+
+sir_module_t* sir_module_load_image(const char* path) {
+  if (!path) return NULL;
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0) return NULL;
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(sirm_header_t)) {
+    close(fd);
+    return NULL;
+  }
+  const size_t len = (size_t)st.st_size;
+  // Read-only: nothing in the image is patched on load, so every page stays shared
+  // with the page cache and is only faulted in when used.
+  void* map = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) return NULL;
+
+  const uint8_t* base = (const uint8_t*)map;
+  sirm_header_t h;
+  memcpy(&h, base, sizeof(h));
+  bool ok = memcmp(h.magic, "SIRM", 4) == 0 && h.version == SIR_MODULE_IMAGE_VERSION && h.endian_tag == SIRM_ENDIAN_TAG &&
+            h.ptr_size == sizeof(void*) && h.inst_size == sizeof(sir_inst_t) && h.file_size == (uint64_t)len;
+  ok = ok && sirm_section_ok(&h, h.types_off, h.type_count, sizeof(sir_type_t), 4) &&
+       sirm_section_ok(&h, h.syms_off, h.sym_count, sizeof(sirm_sym_t), 4) &&
+       sirm_section_ok(&h, h.globals_off, h.global_count, sizeof(sirm_global_t), 4) &&
+       sirm_section_ok(&h, h.funcs_off, h.func_count, sizeof(sirm_func_t), 4) &&
+       sirm_section_ok(&h, h.insts_off, h.inst_count, sizeof(sir_inst_t), 16) && sirm_section_ok(&h, h.blob_off, h.blob_size, 1, 16) &&
+       h.blob_off + h.blob_size == h.file_size;
+  if (!ok || h.func_count == 0 || h.entry == 0 || h.entry > h.func_count) {
+    munmap(map, len);
+    return NULL;
+  }
+
+  const uint8_t* blob = base + h.blob_off;
+  const sirm_sym_t* isyms = (const sirm_sym_t*)(base + h.syms_off);
+  const sirm_global_t* iglobals = (const sirm_global_t*)(base + h.globals_off);
+  const sirm_func_t* ifuncs = (const sirm_func_t*)(base + h.funcs_off);
+  const sir_inst_t* insts = (const sir_inst_t*)(base + h.insts_off);
+
+  sir_module_impl_t* impl = (sir_module_impl_t*)calloc(1, sizeof(*impl));
+  sir_sym_t* syms = h.sym_count ? (sir_sym_t*)calloc(h.sym_count, sizeof(*syms)) : NULL;
+  sir_global_t* globals = h.global_count ? (sir_global_t*)calloc(h.global_count, sizeof(*globals)) : NULL;
+  sir_func_t* funcs = (sir_func_t*)calloc(h.func_count, sizeof(*funcs));
+  ok = impl && funcs && (syms || !h.sym_count) && (globals || !h.global_count);
+
+  for (uint32_t i = 0; ok && i < h.sym_count; i++) {
+    const sirm_sym_t* s = &isyms[i];
+    syms[i].kind = (sir_sym_kind_t)s->kind;
+    ok = sirm_blob_cstr(blob, h.blob_size, s->name, &syms[i].name) &&
+         sirm_sig_from_image(blob, h.blob_size, s->params, s->param_count, s->results, s->result_count, &syms[i].sig);
+  }
+  for (uint32_t i = 0; ok && i < h.global_count; i++) {
+    const sirm_global_t* g = &iglobals[i];
+    const void* init = NULL;
+    ok = sirm_blob_cstr(blob, h.blob_size, g->name, &globals[i].name) && sirm_blob_ref(blob, h.blob_size, g->init, g->init_len, &init) &&
+         (init || !g->init_len);
+    globals[i].size = g->size;
+    globals[i].align = g->align;
+    globals[i].init_bytes = (const uint8_t*)init;
+    globals[i].init_len = g->init_len;
+  }
+  for (uint32_t fi = 0; ok && fi < h.func_count; fi++) {
+    const sirm_func_t* f = &ifuncs[fi];
+    if (f->inst_first > h.inst_count || f->inst_count > h.inst_count - f->inst_first) {
+      ok = false;
+      break;
+    }
+    ok = sirm_blob_cstr(blob, h.blob_size, f->name, &funcs[fi].name) &&
+         sirm_sig_from_image(blob, h.blob_size, f->params, f->param_count, f->results, f->result_count, &funcs[fi].sig);
+    funcs[fi].insts = f->inst_count ? insts + f->inst_first : NULL;
+    funcs[fi].inst_count = f->inst_count;
+    funcs[fi].value_count = f->value_count;
+  }
+
+  if (!ok) {
+    free(funcs);
+    free(globals);
+    free(syms);
+    free(impl);
+    munmap(map, len);
+    return NULL;
+  }
+
+  impl->image = map;
+  impl->image_len = len;
+  impl->pub = (sir_module_t){
+      .types = h.type_count ? (const sir_type_t*)(base + h.types_off) : NULL,
+      .type_count = h.type_count,
+      .syms = syms,
+      .sym_count = h.sym_count,
+      .globals = globals,
+      .global_count = h.global_count,
+      .funcs = funcs,
+      .func_count = h.func_count,
+      .entry = h.entry,
+      .blob = blob,
+      .blob_size = h.blob_size,
+  };
+  return &impl->pub;
+}
+
+static inline const void* inst_ref(const sir_module_t* m, const void* ref) {
+  return (m->blob && ref) ? (const void*)(m->blob + (uintptr_t)ref) : ref;
+}
+
+const void* sir_module_inst_ref(const sir_module_t* m, const void* ref) { return m ? inst_ref(m, ref) : ref; }
+
+// Like inst_ref, but NULL when an image offset does not fit `len` bytes in the blob.
+static const void* validate_ref(const sir_module_t* m, const void* ref, uint64_t len) {
+  if (!m->blob || !ref) return ref;
+  const uintptr_t off = (uintptr_t)ref;
+  if ((off & 3u) != 0 || off > m->blob_size || len > m->blob_size - off) return NULL;
+  return m->blob + off;
+}
+
 // Validator context for filling sir_module_validate_ex diagnostics.
 typedef struct sir__validate_ctx {
   const char* code;
@@ -1266,8 +1781,9 @@ typedef struct sir__validate_ctx {
   const sir_inst_t* inst;
 } sir__validate_ctx_t;
 
-static sir_validate_diag_t* sir__validate_out_diag = NULL;
-static sir__validate_ctx_t sir__validate_ctx = {0};
+// Thread-local so independent modules can be validated concurrently (sem --check -j).
+static _Thread_local sir_validate_diag_t* sir__validate_out_diag = NULL;
+static _Thread_local sir__validate_ctx_t sir__validate_ctx = {0};
 
 static void sir__validate_note(const char* code, sir_func_id_t fid, uint32_t ip, const sir_inst_t* inst) {
   sir__validate_ctx.code = code;
@@ -1326,565 +1842,581 @@ static bool set_errf(char* err, size_t cap, const char* fmt, uint32_t a, uint32_
   return wrote;
 }
 
-bool sir_module_validate(const sir_module_t* m, char* err, size_t err_cap) {
-  sir__validate_note("sir.validate.module", 0, 0, NULL);
-  if (!m) {
-    set_err(err, err_cap, "module is null");
-    return false;
-  }
-  if (m->func_count == 0 || !m->funcs) {
-    set_err(err, err_cap, "module has no funcs");
-    return false;
-  }
-  if (m->entry == 0 || m->entry > m->func_count) {
-    set_errf(err, err_cap, "entry out of range (%u > %u)", m->entry, m->func_count);
-    return false;
-  }
-
-  sir__validate_note("sir.validate.type", 0, 0, NULL);
-  if (m->type_count && !m->types) {
-    set_err(err, err_cap, "type_count set but types is null");
-    return false;
-  }
-  for (uint32_t ti = 0; ti < m->type_count; ti++) {
-    if (m->types[ti].prim == SIR_PRIM_INVALID) {
-      set_errf(err, err_cap, "invalid prim type at index %u of %u", ti + 1, m->type_count);
-      return false;
-    }
-  }
-
-  sir__validate_note("sir.validate.sym", 0, 0, NULL);
-  if (m->sym_count && !m->syms) {
-    set_err(err, err_cap, "sym_count set but syms is null");
+static bool validate_func(const sir_module_t* m, uint32_t fi, char* err, size_t err_cap) {
+  const sir_func_t* f = &m->funcs[fi];
+  const sir_func_id_t fid = (sir_func_id_t)(fi + 1);
+  sir__validate_note("sir.validate.func", fid, 0, NULL);
+  if (!f->name || f->name[0] == '\0') {
+    set_errf(err, err_cap, "func name missing at index %u of %u", fi + 1, m->func_count);
     return false;
   }
-  for (uint32_t si = 0; si < m->sym_count; si++) {
-    const sir_sym_t* s = &m->syms[si];
-    if (s->kind != SIR_SYM_EXTERN_FN) {
-      set_errf(err, err_cap, "invalid sym kind at index %u of %u", si + 1, m->sym_count);
-      return false;
-    }
-    if (!s->name || s->name[0] == '\0') {
-      set_errf(err, err_cap, "sym name missing at index %u of %u", si + 1, m->sym_count);
-      return false;
-    }
-    if (s->sig.param_count && !s->sig.params) {
-      set_errf(err, err_cap, "sym params missing at index %u of %u", si + 1, m->sym_count);
-      return false;
-    }
-    if (s->sig.result_count && !s->sig.results) {
-      set_errf(err, err_cap, "sym results missing at index %u of %u", si + 1, m->sym_count);
-      return false;
-    }
-    for (uint32_t pi = 0; pi < s->sig.param_count; pi++) {
-      const sir_type_id_t tid = s->sig.params[pi];
-      if (tid == 0 || tid > m->type_count) {
-        set_errf(err, err_cap, "sym param type out of range (%u > %u)", (uint32_t)tid, m->type_count);
-        return false;
-      }
-    }
-    for (uint32_t ri = 0; ri < s->sig.result_count; ri++) {
-      const sir_type_id_t tid = s->sig.results[ri];
-      if (tid == 0 || tid > m->type_count) {
-        set_errf(err, err_cap, "sym result type out of range (%u > %u)", (uint32_t)tid, m->type_count);
-        return false;
-      }
-    }
-  }
-
-  sir__validate_note("sir.validate.global", 0, 0, NULL);
-  if (m->global_count && !m->globals) {
-    set_err(err, err_cap, "global_count set but globals is null");
+  if (f->inst_count && !f->insts) {
+    set_errf(err, err_cap, "func insts missing at index %u of %u", fi + 1, m->func_count);
     return false;
   }
-  for (uint32_t gi = 0; gi < m->global_count; gi++) {
-    const sir_global_t* g = &m->globals[gi];
-    if (!g->name || g->name[0] == '\0') {
-      set_errf(err, err_cap, "global name missing at index %u of %u", gi + 1, m->global_count);
-      return false;
-    }
-    if (g->size == 0) {
-      set_errf(err, err_cap, "global size must be >0 at index %u of %u", gi + 1, m->global_count);
-      return false;
-    }
-    if (g->align == 0) {
-      set_errf(err, err_cap, "global align must be >0 at index %u of %u", gi + 1, m->global_count);
-      return false;
-    }
-    if (g->init_len > g->size) {
-      set_errf(err, err_cap, "global init_len out of range at index %u of %u", gi + 1, m->global_count);
-      return false;
-    }
-    if (g->init_len && !g->init_bytes) {
-      set_errf(err, err_cap, "global init_bytes missing at index %u of %u", gi + 1, m->global_count);
-      return false;
-    }
-  }
-
-  for (uint32_t fi = 0; fi < m->func_count; fi++) {
-    const sir_func_t* f = &m->funcs[fi];
-    const sir_func_id_t fid = (sir_func_id_t)(fi + 1);
-    sir__validate_note("sir.validate.func", fid, 0, NULL);
-    if (!f->name || f->name[0] == '\0') {
-      set_errf(err, err_cap, "func name missing at index %u of %u", fi + 1, m->func_count);
-      return false;
-    }
-    if (f->inst_count && !f->insts) {
-      set_errf(err, err_cap, "func insts missing at index %u of %u", fi + 1, m->func_count);
-      return false;
-    }
-    const uint32_t vc = f->value_count;
-    for (uint32_t ii = 0; ii < f->inst_count; ii++) {
-      const sir_inst_t* inst = &f->insts[ii];
-      sir__validate_note("sir.validate.inst", fid, ii, inst);
-      switch (inst->k) {
-        case SIR_INST_CONST_I1:
-          if (inst->u.const_i1.dst >= vc) {
-            set_errf(err, err_cap, "const_i1 dst out of range (%u >= %u)", inst->u.const_i1.dst, vc);
-            return false;
-          }
-          if (inst->u.const_i1.v > 1) {
-            set_err(err, err_cap, "const_i1 value must be 0 or 1");
-            return false;
-          }
-          break;
-        case SIR_INST_CONST_I8:
-          if (inst->u.const_i8.dst >= vc) {
-            set_errf(err, err_cap, "const_i8 dst out of range (%u >= %u)", inst->u.const_i8.dst, vc);
-            return false;
-          }
-          break;
-        case SIR_INST_CONST_I16:
-          if (inst->u.const_i16.dst >= vc) {
-            set_errf(err, err_cap, "const_i16 dst out of range (%u >= %u)", inst->u.const_i16.dst, vc);
-            return false;
-          }
-          break;
-        case SIR_INST_CONST_I32:
-          if (inst->u.const_i32.dst >= vc) {
-            set_errf(err, err_cap, "const_i32 dst out of range (%u >= %u)", inst->u.const_i32.dst, vc);
-            return false;
-          }
-          break;
-        case SIR_INST_CONST_I64:
-          if (inst->u.const_i64.dst >= vc) {
-            set_errf(err, err_cap, "const_i64 dst out of range (%u >= %u)", inst->u.const_i64.dst, vc);
-            return false;
-          }
-          break;
-        case SIR_INST_CONST_BOOL:
-          if (inst->u.const_bool.dst >= vc) {
-            set_errf(err, err_cap, "const_bool dst out of range (%u >= %u)", inst->u.const_bool.dst, vc);
-            return false;
-          }
-          if (inst->u.const_bool.v > 1) {
-            set_err(err, err_cap, "const_bool value must be 0 or 1");
-            return false;
-          }
-          break;
-        case SIR_INST_CONST_F32:
-          if (inst->u.const_f32.dst >= vc) {
-            set_errf(err, err_cap, "const_f32 dst out of range (%u >= %u)", inst->u.const_f32.dst, vc);
-            return false;
-          }
-          break;
-        case SIR_INST_CONST_F64:
-          if (inst->u.const_f64.dst >= vc) {
-            set_errf(err, err_cap, "const_f64 dst out of range (%u >= %u)", inst->u.const_f64.dst, vc);
-            return false;
-          }
-          break;
-        case SIR_INST_CONST_PTR:
-          if (inst->u.const_ptr.dst >= vc) {
-            set_errf(err, err_cap, "const_ptr dst out of range (%u >= %u)", inst->u.const_ptr.dst, vc);
-            return false;
-          }
-          break;
-        case SIR_INST_CONST_PTR_NULL:
-          if (inst->u.const_null.dst >= vc) {
-            set_errf(err, err_cap, "const_null dst out of range (%u >= %u)", inst->u.const_null.dst, vc);
-            return false;
-          }
-          break;
-        case SIR_INST_CONST_BYTES:
-          if (inst->u.const_bytes.dst_ptr >= vc || inst->u.const_bytes.dst_len >= vc) {
-            set_err(err, err_cap, "const_bytes dst out of range");
-            return false;
-          }
-          if (inst->u.const_bytes.len && !inst->u.const_bytes.bytes) {
-            set_err(err, err_cap, "const_bytes has len but no bytes");
-            return false;
-          }
-          break;
-        case SIR_INST_I32_ADD:
-          if (inst->u.i32_add.dst >= vc || inst->u.i32_add.a >= vc || inst->u.i32_add.b >= vc) {
-            set_err(err, err_cap, "i32_add operand out of range");
-            return false;
-          }
-          break;
-        case SIR_INST_I32_SUB:
-        case SIR_INST_I32_MUL:
-        case SIR_INST_I32_AND:
-        case SIR_INST_I32_OR:
-        case SIR_INST_I32_XOR:
-        case SIR_INST_I32_SHL:
-        case SIR_INST_I32_SHR_S:
-        case SIR_INST_I32_SHR_U:
-        case SIR_INST_I32_DIV_S_SAT:
-        case SIR_INST_I32_DIV_S_TRAP:
-        case SIR_INST_I32_DIV_U_SAT:
-        case SIR_INST_I32_REM_S_SAT:
-        case SIR_INST_I32_REM_U_SAT:
-          if (inst->u.i32_add.dst >= vc || inst->u.i32_add.a >= vc || inst->u.i32_add.b >= vc) {
-            set_err(err, err_cap, "i32_bin operand out of range");
-            return false;
-          }
-          break;
-        case SIR_INST_I32_NOT:
-        case SIR_INST_I32_NEG:
-          if (inst->u.i32_un.dst >= vc || inst->u.i32_un.x >= vc) {
-            set_err(err, err_cap, "i32_un operand out of range");
-            return false;
-          }
-          break;
-        case SIR_INST_I32_CMP_EQ:
-          if (inst->u.i32_cmp_eq.dst >= vc || inst->u.i32_cmp_eq.a >= vc || inst->u.i32_cmp_eq.b >= vc) {
-            set_err(err, err_cap, "i32_cmp_eq operand out of range");
-            return false;
-          }
-          break;
-        case SIR_INST_I32_CMP_NE:
-        case SIR_INST_I32_CMP_SLT:
-        case SIR_INST_I32_CMP_SLE:
-        case SIR_INST_I32_CMP_SGT:
-        case SIR_INST_I32_CMP_SGE:
-        case SIR_INST_I32_CMP_ULT:
-        case SIR_INST_I32_CMP_ULE:
-        case SIR_INST_I32_CMP_UGT:
-        case SIR_INST_I32_CMP_UGE:
-          if (inst->u.i32_cmp_eq.dst >= vc || inst->u.i32_cmp_eq.a >= vc || inst->u.i32_cmp_eq.b >= vc) {
-            set_err(err, err_cap, "i32_cmp operand out of range");
-            return false;
-          }
-          break;
-        case SIR_INST_F32_CMP_UEQ:
-        case SIR_INST_F64_CMP_OLT:
-          if (inst->u.f_cmp.dst >= vc || inst->u.f_cmp.a >= vc || inst->u.f_cmp.b >= vc) {
-            set_err(err, err_cap, "f_cmp operand out of range");
-            return false;
-          }
-          break;
-        case SIR_INST_GLOBAL_ADDR:
-          if (inst->u.global_addr.dst >= vc) {
-            set_err(err, err_cap, "global_addr dst out of range");
-            return false;
-          }
-          if (inst->u.global_addr.gid == 0 || inst->u.global_addr.gid > m->global_count) {
-            set_err(err, err_cap, "global_addr gid out of range");
-            return false;
-          }
-          break;
-        case SIR_INST_PTR_OFFSET:
-          if (inst->u.ptr_offset.dst >= vc || inst->u.ptr_offset.base >= vc || inst->u.ptr_offset.index >= vc) {
-            set_err(err, err_cap, "ptr_offset operand out of range");
-            return false;
-          }
-          if (inst->u.ptr_offset.scale == 0) {
-            set_err(err, err_cap, "ptr_offset scale must be >0");
-            return false;
-          }
-          break;
-        case SIR_INST_PTR_ADD:
-          if (inst->u.ptr_add.dst >= vc || inst->u.ptr_add.base >= vc || inst->u.ptr_add.off >= vc) {
-            set_err(err, err_cap, "ptr_add operand out of range");
-            return false;
-          }
-          break;
-        case SIR_INST_PTR_SUB:
-          if (inst->u.ptr_sub.dst >= vc || inst->u.ptr_sub.base >= vc || inst->u.ptr_sub.off >= vc) {
-            set_err(err, err_cap, "ptr_sub operand out of range");
-            return false;
-          }
-          break;
-        case SIR_INST_PTR_CMP_EQ:
-        case SIR_INST_PTR_CMP_NE:
-          if (inst->u.ptr_cmp.dst >= vc || inst->u.ptr_cmp.a >= vc || inst->u.ptr_cmp.b >= vc) {
-            set_err(err, err_cap, "ptr_cmp operand out of range");
-            return false;
-          }
-          break;
-        case SIR_INST_PTR_TO_I64:
-          if (inst->u.ptr_to_i64.dst >= vc || inst->u.ptr_to_i64.x >= vc) {
-            set_err(err, err_cap, "ptr_to_i64 operand out of range");
-            return false;
-          }
-          break;
-        case SIR_INST_PTR_FROM_I64:
-          if (inst->u.ptr_from_i64.dst >= vc || inst->u.ptr_from_i64.x >= vc) {
-            set_err(err, err_cap, "ptr_from_i64 operand out of range");
-            return false;
-          }
-          break;
-        case SIR_INST_BOOL_NOT:
-          if (inst->u.bool_not.dst >= vc || inst->u.bool_not.x >= vc) {
-            set_err(err, err_cap, "bool_not operand out of range");
-            return false;
-          }
-          break;
-        case SIR_INST_BOOL_AND:
-        case SIR_INST_BOOL_OR:
-        case SIR_INST_BOOL_XOR:
-          if (inst->u.bool_bin.dst >= vc || inst->u.bool_bin.a >= vc || inst->u.bool_bin.b >= vc) {
-            set_err(err, err_cap, "bool_bin operand out of range");
-            return false;
-          }
-          break;
-        case SIR_INST_I32_TRUNC_I64:
-          if (inst->u.i32_trunc_i64.dst >= vc || inst->u.i32_trunc_i64.x >= vc) {
-            set_err(err, err_cap, "i32_trunc_i64 operand out of range");
-            return false;
-          }
-          break;
-        case SIR_INST_I32_ZEXT_I8:
-          if (inst->u.i32_zext_i8.dst >= vc || inst->u.i32_zext_i8.x >= vc) {
-            set_err(err, err_cap, "i32_zext_i8 operand out of range");
-            return false;
-          }
-          break;
-        case SIR_INST_I32_ZEXT_I16:
-          if (inst->u.i32_zext_i16.dst >= vc || inst->u.i32_zext_i16.x >= vc) {
-            set_err(err, err_cap, "i32_zext_i16 operand out of range");
-            return false;
-          }
-          break;
-        case SIR_INST_I64_ZEXT_I32:
-          if (inst->u.i64_zext_i32.dst >= vc || inst->u.i64_zext_i32.x >= vc) {
-            set_err(err, err_cap, "i64_zext_i32 operand out of range");
-            return false;
-          }
-          break;
-        case SIR_INST_SELECT:
-          if (inst->u.select.dst >= vc || inst->u.select.cond >= vc || inst->u.select.a >= vc || inst->u.select.b >= vc) {
-            set_err(err, err_cap, "select operand out of range");
-            return false;
-          }
-          break;
-        case SIR_INST_BR:
-          if (inst->u.br.target_ip >= f->inst_count) {
-            set_err(err, err_cap, "br target_ip out of range");
-            return false;
-          }
-          if (inst->u.br.arg_count) {
-            if (!inst->u.br.src_slots || !inst->u.br.dst_slots) {
-              set_err(err, err_cap, "br arg_count set but slot arrays are null");
-              return false;
-            }
-            for (uint32_t ai = 0; ai < inst->u.br.arg_count; ai++) {
-              if (inst->u.br.src_slots[ai] >= vc || inst->u.br.dst_slots[ai] >= vc) {
-                set_err(err, err_cap, "br arg slot out of range");
-                return false;
-              }
-            }
-          }
-          break;
-        case SIR_INST_CBR:
-          if (inst->u.cbr.cond >= vc) {
-            set_err(err, err_cap, "cbr cond out of range");
-            return false;
-          }
-          if (inst->u.cbr.then_ip >= f->inst_count || inst->u.cbr.else_ip >= f->inst_count) {
-            set_err(err, err_cap, "cbr target_ip out of range");
-            return false;
-          }
-          break;
-        case SIR_INST_SWITCH:
-          if (inst->u.sw.scrut >= vc) {
-            set_err(err, err_cap, "switch scrut out of range");
+  // Lazy funcs have no body until their loader runs; sir_module_validate_func_ex
+  // checks the body at that point.
+  if (f->lazy) return true;
+  const uint32_t vc = f->value_count;
+  for (uint32_t ii = 0; ii < f->inst_count; ii++) {
+    const sir_inst_t* inst = &f->insts[ii];
+    sir__validate_note("sir.validate.inst", fid, ii, inst);
+    switch (inst->k) {
+      case SIR_INST_CONST_I1:
+        if (inst->u.const_i1.dst >= vc) {
+          set_errf(err, err_cap, "const_i1 dst out of range (%u >= %u)", inst->u.const_i1.dst, vc);
+          return false;
+        }
+        if (inst->u.const_i1.v > 1) {
+          set_err(err, err_cap, "const_i1 value must be 0 or 1");
+          return false;
+        }
+        break;
+      case SIR_INST_CONST_I8:
+        if (inst->u.const_i8.dst >= vc) {
+          set_errf(err, err_cap, "const_i8 dst out of range (%u >= %u)", inst->u.const_i8.dst, vc);
+          return false;
+        }
+        break;
+      case SIR_INST_CONST_I16:
+        if (inst->u.const_i16.dst >= vc) {
+          set_errf(err, err_cap, "const_i16 dst out of range (%u >= %u)", inst->u.const_i16.dst, vc);
+          return false;
+        }
+        break;
+      case SIR_INST_CONST_I32:
+        if (inst->u.const_i32.dst >= vc) {
+          set_errf(err, err_cap, "const_i32 dst out of range (%u >= %u)", inst->u.const_i32.dst, vc);
+          return false;
+        }
+        break;
+      case SIR_INST_CONST_I64:
+        if (inst->u.const_i64.dst >= vc) {
+          set_errf(err, err_cap, "const_i64 dst out of range (%u >= %u)", inst->u.const_i64.dst, vc);
+          return false;
+        }
+        break;
+      case SIR_INST_CONST_BOOL:
+        if (inst->u.const_bool.dst >= vc) {
+          set_errf(err, err_cap, "const_bool dst out of range (%u >= %u)", inst->u.const_bool.dst, vc);
+          return false;
+        }
+        if (inst->u.const_bool.v > 1) {
+          set_err(err, err_cap, "const_bool value must be 0 or 1");
+          return false;
+        }
+        break;
+      case SIR_INST_CONST_F32:
+        if (inst->u.const_f32.dst >= vc) {
+          set_errf(err, err_cap, "const_f32 dst out of range (%u >= %u)", inst->u.const_f32.dst, vc);
+          return false;
+        }
+        break;
+      case SIR_INST_CONST_F64:
+        if (inst->u.const_f64.dst >= vc) {
+          set_errf(err, err_cap, "const_f64 dst out of range (%u >= %u)", inst->u.const_f64.dst, vc);
+          return false;
+        }
+        break;
+      case SIR_INST_CONST_PTR:
+        if (inst->u.const_ptr.dst >= vc) {
+          set_errf(err, err_cap, "const_ptr dst out of range (%u >= %u)", inst->u.const_ptr.dst, vc);
+          return false;
+        }
+        break;
+      case SIR_INST_CONST_PTR_NULL:
+        if (inst->u.const_null.dst >= vc) {
+          set_errf(err, err_cap, "const_null dst out of range (%u >= %u)", inst->u.const_null.dst, vc);
+          return false;
+        }
+        break;
+      case SIR_INST_CONST_BYTES:
+        if (inst->u.const_bytes.dst_ptr >= vc || inst->u.const_bytes.dst_len >= vc) {
+          set_err(err, err_cap, "const_bytes dst out of range");
+          return false;
+        }
+        if (inst->u.const_bytes.len && !validate_ref(m, inst->u.const_bytes.bytes, inst->u.const_bytes.len)) {
+          set_err(err, err_cap, "const_bytes has len but no bytes");
+          return false;
+        }
+        break;
+      case SIR_INST_I32_ADD:
+        if (inst->u.i32_add.dst >= vc || inst->u.i32_add.a >= vc || inst->u.i32_add.b >= vc) {
+          set_err(err, err_cap, "i32_add operand out of range");
+          return false;
+        }
+        break;
+      case SIR_INST_I32_SUB:
+      case SIR_INST_I32_MUL:
+      case SIR_INST_I32_AND:
+      case SIR_INST_I32_OR:
+      case SIR_INST_I32_XOR:
+      case SIR_INST_I32_SHL:
+      case SIR_INST_I32_SHR_S:
+      case SIR_INST_I32_SHR_U:
+      case SIR_INST_I32_DIV_S_SAT:
+      case SIR_INST_I32_DIV_S_TRAP:
+      case SIR_INST_I32_DIV_U_SAT:
+      case SIR_INST_I32_REM_S_SAT:
+      case SIR_INST_I32_REM_U_SAT:
+        if (inst->u.i32_add.dst >= vc || inst->u.i32_add.a >= vc || inst->u.i32_add.b >= vc) {
+          set_err(err, err_cap, "i32_bin operand out of range");
+          return false;
+        }
+        break;
+      case SIR_INST_I32_NOT:
+      case SIR_INST_I32_NEG:
+        if (inst->u.i32_un.dst >= vc || inst->u.i32_un.x >= vc) {
+          set_err(err, err_cap, "i32_un operand out of range");
+          return false;
+        }
+        break;
+      case SIR_INST_I32_CMP_EQ:
+        if (inst->u.i32_cmp_eq.dst >= vc || inst->u.i32_cmp_eq.a >= vc || inst->u.i32_cmp_eq.b >= vc) {
+          set_err(err, err_cap, "i32_cmp_eq operand out of range");
+          return false;
+        }
+        break;
+      case SIR_INST_I32_CMP_NE:
+      case SIR_INST_I32_CMP_SLT:
+      case SIR_INST_I32_CMP_SLE:
+      case SIR_INST_I32_CMP_SGT:
+      case SIR_INST_I32_CMP_SGE:
+      case SIR_INST_I32_CMP_ULT:
+      case SIR_INST_I32_CMP_ULE:
+      case SIR_INST_I32_CMP_UGT:
+      case SIR_INST_I32_CMP_UGE:
+        if (inst->u.i32_cmp_eq.dst >= vc || inst->u.i32_cmp_eq.a >= vc || inst->u.i32_cmp_eq.b >= vc) {
+          set_err(err, err_cap, "i32_cmp operand out of range");
+          return false;
+        }
+        break;
+      case SIR_INST_F32_CMP_UEQ:
+      case SIR_INST_F64_CMP_OLT:
+        if (inst->u.f_cmp.dst >= vc || inst->u.f_cmp.a >= vc || inst->u.f_cmp.b >= vc) {
+          set_err(err, err_cap, "f_cmp operand out of range");
+          return false;
+        }
+        break;
+      case SIR_INST_GLOBAL_ADDR:
+        if (inst->u.global_addr.dst >= vc) {
+          set_err(err, err_cap, "global_addr dst out of range");
+          return false;
+        }
+        if (inst->u.global_addr.gid == 0 || inst->u.global_addr.gid > m->global_count) {
+          set_err(err, err_cap, "global_addr gid out of range");
+          return false;
+        }
+        break;
+      case SIR_INST_PTR_OFFSET:
+        if (inst->u.ptr_offset.dst >= vc || inst->u.ptr_offset.base >= vc || inst->u.ptr_offset.index >= vc) {
+          set_err(err, err_cap, "ptr_offset operand out of range");
+          return false;
+        }
+        if (inst->u.ptr_offset.scale == 0) {
+          set_err(err, err_cap, "ptr_offset scale must be >0");
+          return false;
+        }
+        break;
+      case SIR_INST_PTR_ADD:
+        if (inst->u.ptr_add.dst >= vc || inst->u.ptr_add.base >= vc || inst->u.ptr_add.off >= vc) {
+          set_err(err, err_cap, "ptr_add operand out of range");
+          return false;
+        }
+        break;
+      case SIR_INST_PTR_SUB:
+        if (inst->u.ptr_sub.dst >= vc || inst->u.ptr_sub.base >= vc || inst->u.ptr_sub.off >= vc) {
+          set_err(err, err_cap, "ptr_sub operand out of range");
+          return false;
+        }
+        break;
+      case SIR_INST_PTR_CMP_EQ:
+      case SIR_INST_PTR_CMP_NE:
+        if (inst->u.ptr_cmp.dst >= vc || inst->u.ptr_cmp.a >= vc || inst->u.ptr_cmp.b >= vc) {
+          set_err(err, err_cap, "ptr_cmp operand out of range");
+          return false;
+        }
+        break;
+      case SIR_INST_PTR_TO_I64:
+        if (inst->u.ptr_to_i64.dst >= vc || inst->u.ptr_to_i64.x >= vc) {
+          set_err(err, err_cap, "ptr_to_i64 operand out of range");
+          return false;
+        }
+        break;
+      case SIR_INST_PTR_FROM_I64:
+        if (inst->u.ptr_from_i64.dst >= vc || inst->u.ptr_from_i64.x >= vc) {
+          set_err(err, err_cap, "ptr_from_i64 operand out of range");
+          return false;
+        }
+        break;
+      case SIR_INST_BOOL_NOT:
+        if (inst->u.bool_not.dst >= vc || inst->u.bool_not.x >= vc) {
+          set_err(err, err_cap, "bool_not operand out of range");
+          return false;
+        }
+        break;
+      case SIR_INST_BOOL_AND:
+      case SIR_INST_BOOL_OR:
+      case SIR_INST_BOOL_XOR:
+        if (inst->u.bool_bin.dst >= vc || inst->u.bool_bin.a >= vc || inst->u.bool_bin.b >= vc) {
+          set_err(err, err_cap, "bool_bin operand out of range");
+          return false;
+        }
+        break;
+      case SIR_INST_I32_TRUNC_I64:
+        if (inst->u.i32_trunc_i64.dst >= vc || inst->u.i32_trunc_i64.x >= vc) {
+          set_err(err, err_cap, "i32_trunc_i64 operand out of range");
+          return false;
+        }
+        break;
+      case SIR_INST_I32_ZEXT_I8:
+        if (inst->u.i32_zext_i8.dst >= vc || inst->u.i32_zext_i8.x >= vc) {
+          set_err(err, err_cap, "i32_zext_i8 operand out of range");
+          return false;
+        }
+        break;
+      case SIR_INST_I32_ZEXT_I16:
+        if (inst->u.i32_zext_i16.dst >= vc || inst->u.i32_zext_i16.x >= vc) {
+          set_err(err, err_cap, "i32_zext_i16 operand out of range");
+          return false;
+        }
+        break;
+      case SIR_INST_I64_ZEXT_I32:
+        if (inst->u.i64_zext_i32.dst >= vc || inst->u.i64_zext_i32.x >= vc) {
+          set_err(err, err_cap, "i64_zext_i32 operand out of range");
+          return false;
+        }
+        break;
+      case SIR_INST_SELECT:
+        if (inst->u.select.dst >= vc || inst->u.select.cond >= vc || inst->u.select.a >= vc || inst->u.select.b >= vc) {
+          set_err(err, err_cap, "select operand out of range");
+          return false;
+        }
+        break;
+      case SIR_INST_BR:
+        if (inst->u.br.target_ip >= f->inst_count) {
+          set_err(err, err_cap, "br target_ip out of range");
+          return false;
+        }
+        if (inst->u.br.arg_count) {
+          const uint64_t n = (uint64_t)inst->u.br.arg_count * sizeof(sir_val_id_t);
+          const sir_val_id_t* src = (const sir_val_id_t*)validate_ref(m, inst->u.br.src_slots, n);
+          const sir_val_id_t* dst = (const sir_val_id_t*)validate_ref(m, inst->u.br.dst_slots, n);
+          if (!src || !dst) {
+            set_err(err, err_cap, "br arg_count set but slot arrays are null");
             return false;
           }
-          if (inst->u.sw.case_count) {
-            if (!inst->u.sw.case_lits || !inst->u.sw.case_target) {
-              set_err(err, err_cap, "switch case_count set but arrays are null");
+          for (uint32_t ai = 0; ai < inst->u.br.arg_count; ai++) {
+            if (src[ai] >= vc || dst[ai] >= vc) {
+              set_err(err, err_cap, "br arg slot out of range");
               return false;
             }
-            for (uint32_t ci = 0; ci < inst->u.sw.case_count; ci++) {
-              if (inst->u.sw.case_target[ci] >= f->inst_count) {
-                set_err(err, err_cap, "switch case target_ip out of range");
-                return false;
-              }
-            }
-          }
-          if (inst->u.sw.default_ip >= f->inst_count) {
-            set_err(err, err_cap, "switch default_ip out of range");
-            return false;
-          }
-          break;
-        case SIR_INST_MEM_COPY:
-          if (inst->u.mem_copy.dst >= vc || inst->u.mem_copy.src >= vc || inst->u.mem_copy.len >= vc) {
-            set_err(err, err_cap, "mem.copy operand out of range");
-            return false;
-          }
-          break;
-        case SIR_INST_MEM_FILL:
-          if (inst->u.mem_fill.dst >= vc || inst->u.mem_fill.byte >= vc || inst->u.mem_fill.len >= vc) {
-            set_err(err, err_cap, "mem.fill operand out of range");
-            return false;
-          }
-          break;
-        case SIR_INST_ALLOCA:
-          if (inst->u.alloca_.dst >= vc) {
-            set_err(err, err_cap, "alloca dst out of range");
-            return false;
-          }
-          if (inst->u.alloca_.size == 0) {
-            set_err(err, err_cap, "alloca size must be >0");
-            return false;
-          }
-          break;
-        case SIR_INST_STORE_I8:
-        case SIR_INST_STORE_I16:
-        case SIR_INST_STORE_I32:
-        case SIR_INST_STORE_I64:
-        case SIR_INST_STORE_PTR:
-        case SIR_INST_STORE_F32:
-        case SIR_INST_STORE_F64:
-          if (inst->u.store.addr >= vc || inst->u.store.value >= vc) {
-            set_err(err, err_cap, "store operand out of range");
-            return false;
           }
-          if (!is_pow2_u32(inst->u.store.align)) {
-            set_err(err, err_cap, "store align must be a power of two");
-            return false;
-          }
-          break;
-        case SIR_INST_LOAD_I8:
-        case SIR_INST_LOAD_I16:
-        case SIR_INST_LOAD_I32:
-        case SIR_INST_LOAD_I64:
-        case SIR_INST_LOAD_PTR:
-        case SIR_INST_LOAD_F32:
-        case SIR_INST_LOAD_F64:
-          if (inst->u.load.addr >= vc || inst->u.load.dst >= vc) {
-            set_err(err, err_cap, "load operand out of range");
-            return false;
-          }
-          if (!is_pow2_u32(inst->u.load.align)) {
-            set_err(err, err_cap, "load align must be a power of two");
-            return false;
-          }
-          break;
-        case SIR_INST_CALL_EXTERN: {
-          const sir_sym_id_t callee = inst->u.call_extern.callee;
-          if (callee == 0 || callee > m->sym_count) {
-            set_err(err, err_cap, "call_extern callee out of range");
-            return false;
-          }
-          const sir_sym_t* s = &m->syms[callee - 1];
-          if (inst->u.call_extern.arg_count && !inst->u.call_extern.args) {
-            set_err(err, err_cap, "call_extern arg_count set but args is null");
-            return false;
-          }
-          if (inst->u.call_extern.arg_count != s->sig.param_count) {
-            set_err(err, err_cap, "call_extern arg_count does not match signature");
-            return false;
-          }
-          if (inst->result_count != s->sig.result_count) {
-            set_err(err, err_cap, "call_extern result_count does not match signature");
+        }
+        break;
+      case SIR_INST_CBR:
+        if (inst->u.cbr.cond >= vc) {
+          set_err(err, err_cap, "cbr cond out of range");
+          return false;
+        }
+        if (inst->u.cbr.then_ip >= f->inst_count || inst->u.cbr.else_ip >= f->inst_count) {
+          set_err(err, err_cap, "cbr target_ip out of range");
+          return false;
+        }
+        break;
+      case SIR_INST_SWITCH:
+        if (inst->u.sw.scrut >= vc) {
+          set_err(err, err_cap, "switch scrut out of range");
+          return false;
+        }
+        if (inst->u.sw.case_count) {
+          const uint64_t n = (uint64_t)inst->u.sw.case_count * sizeof(uint32_t);
+          const uint32_t* tgt = (const uint32_t*)validate_ref(m, inst->u.sw.case_target, n);
+          if (!validate_ref(m, inst->u.sw.case_lits, n) || !tgt) {
+            set_err(err, err_cap, "switch case_count set but arrays are null");
             return false;
           }
-          for (uint32_t ai = 0; ai < inst->u.call_extern.arg_count; ai++) {
-            if (inst->u.call_extern.args[ai] >= vc) {
-              set_err(err, err_cap, "call_extern arg out of range");
-              return false;
-            }
-          }
-          for (uint8_t ri = 0; ri < inst->result_count; ri++) {
-            if (inst->results[ri] >= vc) {
-              set_err(err, err_cap, "call_extern result out of range");
+          for (uint32_t ci = 0; ci < inst->u.sw.case_count; ci++) {
+            if (tgt[ci] >= f->inst_count) {
+              set_err(err, err_cap, "switch case target_ip out of range");
               return false;
             }
           }
-          break;
         }
-        case SIR_INST_CALL_FUNC: {
-          const sir_func_id_t callee = inst->u.call_func.callee;
-          if (callee == 0 || callee > m->func_count) {
-            set_err(err, err_cap, "call_func callee out of range");
-            return false;
-          }
-          const sir_func_t* cf = &m->funcs[callee - 1];
-          if (inst->u.call_func.arg_count && !inst->u.call_func.args) {
-            set_err(err, err_cap, "call_func arg_count set but args is null");
-            return false;
-          }
-          if (inst->u.call_func.arg_count != cf->sig.param_count) {
-            set_err(err, err_cap, "call_func arg_count does not match callee signature");
+        if (inst->u.sw.default_ip >= f->inst_count) {
+          set_err(err, err_cap, "switch default_ip out of range");
+          return false;
+        }
+        break;
+      case SIR_INST_MEM_COPY:
+        if (inst->u.mem_copy.dst >= vc || inst->u.mem_copy.src >= vc || inst->u.mem_copy.len >= vc) {
+          set_err(err, err_cap, "mem.copy operand out of range");
+          return false;
+        }
+        break;
+      case SIR_INST_MEM_FILL:
+        if (inst->u.mem_fill.dst >= vc || inst->u.mem_fill.byte >= vc || inst->u.mem_fill.len >= vc) {
+          set_err(err, err_cap, "mem.fill operand out of range");
+          return false;
+        }
+        break;
+      case SIR_INST_ALLOCA:
+        if (inst->u.alloca_.dst >= vc) {
+          set_err(err, err_cap, "alloca dst out of range");
+          return false;
+        }
+        if (inst->u.alloca_.size == 0) {
+          set_err(err, err_cap, "alloca size must be >0");
+          return false;
+        }
+        break;
+      case SIR_INST_STORE_I8:
+      case SIR_INST_STORE_I16:
+      case SIR_INST_STORE_I32:
+      case SIR_INST_STORE_I64:
+      case SIR_INST_STORE_PTR:
+      case SIR_INST_STORE_F32:
+      case SIR_INST_STORE_F64:
+        if (inst->u.store.addr >= vc || inst->u.store.value >= vc) {
+          set_err(err, err_cap, "store operand out of range");
+          return false;
+        }
+        if (!is_pow2_u32(inst->u.store.align)) {
+          set_err(err, err_cap, "store align must be a power of two");
+          return false;
+        }
+        break;
+      case SIR_INST_LOAD_I8:
+      case SIR_INST_LOAD_I16:
+      case SIR_INST_LOAD_I32:
+      case SIR_INST_LOAD_I64:
+      case SIR_INST_LOAD_PTR:
+      case SIR_INST_LOAD_F32:
+      case SIR_INST_LOAD_F64:
+        if (inst->u.load.addr >= vc || inst->u.load.dst >= vc) {
+          set_err(err, err_cap, "load operand out of range");
+          return false;
+        }
+        if (!is_pow2_u32(inst->u.load.align)) {
+          set_err(err, err_cap, "load align must be a power of two");
+          return false;
+        }
+        break;
+      case SIR_INST_CALL_EXTERN: {
+        const sir_sym_id_t callee = inst->u.call_extern.callee;
+        if (callee == 0 || callee > m->sym_count) {
+          set_err(err, err_cap, "call_extern callee out of range");
+          return false;
+        }
+        const sir_sym_t* s = &m->syms[callee - 1];
+        const sir_val_id_t* args = (const sir_val_id_t*)validate_ref(m, inst->u.call_extern.args, (uint64_t)inst->u.call_extern.arg_count * sizeof(sir_val_id_t));
+        if (inst->u.call_extern.arg_count && !args) {
+          set_err(err, err_cap, "call_extern arg_count set but args is null");
+          return false;
+        }
+        if (inst->u.call_extern.arg_count != s->sig.param_count) {
+          set_err(err, err_cap, "call_extern arg_count does not match signature");
+          return false;
+        }
+        if (inst->result_count != s->sig.result_count) {
+          set_err(err, err_cap, "call_extern result_count does not match signature");
+          return false;
+        }
+        for (uint32_t ai = 0; ai < inst->u.call_extern.arg_count; ai++) {
+          if (args[ai] >= vc) {
+            set_err(err, err_cap, "call_extern arg out of range");
             return false;
           }
-          if (inst->result_count != cf->sig.result_count) {
-            set_err(err, err_cap, "call_func result_count does not match callee signature");
+        }
+        for (uint8_t ri = 0; ri < inst->result_count; ri++) {
+          if (inst->results[ri] >= vc) {
+            set_err(err, err_cap, "call_extern result out of range");
             return false;
           }
-          for (uint32_t ai = 0; ai < inst->u.call_func.arg_count; ai++) {
-            if (inst->u.call_func.args[ai] >= vc) {
-              set_err(err, err_cap, "call_func arg out of range");
-              return false;
-            }
-          }
-          for (uint8_t ri = 0; ri < inst->result_count; ri++) {
-            if (inst->results[ri] >= vc) {
-              set_err(err, err_cap, "call_func result out of range");
-              return false;
-            }
-          }
-          break;
         }
-        case SIR_INST_CALL_FUNC_PTR: {
-          if (inst->u.call_func_ptr.callee_ptr >= vc) {
-            set_err(err, err_cap, "call_func_ptr callee_ptr out of range");
+        break;
+      }
+      case SIR_INST_CALL_FUNC: {
+        const sir_func_id_t callee = inst->u.call_func.callee;
+        if (callee == 0 || callee > m->func_count) {
+          set_err(err, err_cap, "call_func callee out of range");
+          return false;
+        }
+        const sir_func_t* cf = &m->funcs[callee - 1];
+        const sir_val_id_t* args = (const sir_val_id_t*)validate_ref(m, inst->u.call_func.args, (uint64_t)inst->u.call_func.arg_count * sizeof(sir_val_id_t));
+        if (inst->u.call_func.arg_count && !args) {
+          set_err(err, err_cap, "call_func arg_count set but args is null");
+          return false;
+        }
+        if (inst->u.call_func.arg_count != cf->sig.param_count) {
+          set_err(err, err_cap, "call_func arg_count does not match callee signature");
+          return false;
+        }
+        if (inst->result_count != cf->sig.result_count) {
+          set_err(err, err_cap, "call_func result_count does not match callee signature");
+          return false;
+        }
+        for (uint32_t ai = 0; ai < inst->u.call_func.arg_count; ai++) {
+          if (args[ai] >= vc) {
+            set_err(err, err_cap, "call_func arg out of range");
             return false;
           }
-          if (inst->u.call_func_ptr.arg_count && !inst->u.call_func_ptr.args) {
-            set_err(err, err_cap, "call_func_ptr arg_count set but args is null");
+        }
+        for (uint8_t ri = 0; ri < inst->result_count; ri++) {
+          if (inst->results[ri] >= vc) {
+            set_err(err, err_cap, "call_func result out of range");
             return false;
           }
-          for (uint32_t ai = 0; ai < inst->u.call_func_ptr.arg_count; ai++) {
-            if (inst->u.call_func_ptr.args[ai] >= vc) {
-              set_err(err, err_cap, "call_func_ptr arg out of range");
-              return false;
-            }
-          }
-          for (uint8_t ri = 0; ri < inst->result_count; ri++) {
-            if (inst->results[ri] >= vc) {
-              set_err(err, err_cap, "call_func_ptr result out of range");
-              return false;
-            }
-          }
-          break;
         }
-        case SIR_INST_RET:
-          break;
-        case SIR_INST_RET_VAL:
-          if (inst->u.ret_val.value >= vc) {
-            set_err(err, err_cap, "ret_val value out of range");
+        break;
+      }
+      case SIR_INST_CALL_FUNC_PTR: {
+        if (inst->u.call_func_ptr.callee_ptr >= vc) {
+          set_err(err, err_cap, "call_func_ptr callee_ptr out of range");
+          return false;
+        }
+        const sir_val_id_t* args = (const sir_val_id_t*)validate_ref(m, inst->u.call_func_ptr.args, (uint64_t)inst->u.call_func_ptr.arg_count * sizeof(sir_val_id_t));
+        if (inst->u.call_func_ptr.arg_count && !args) {
+          set_err(err, err_cap, "call_func_ptr arg_count set but args is null");
+          return false;
+        }
+        for (uint32_t ai = 0; ai < inst->u.call_func_ptr.arg_count; ai++) {
+          if (args[ai] >= vc) {
+            set_err(err, err_cap, "call_func_ptr arg out of range");
             return false;
           }
-          break;
-        case SIR_INST_EXIT:
-          break;
-        case SIR_INST_EXIT_VAL:
-          if (inst->u.exit_val.code >= vc) {
-            set_err(err, err_cap, "exit_val code out of range");
+        }
+        for (uint8_t ri = 0; ri < inst->result_count; ri++) {
+          if (inst->results[ri] >= vc) {
+            set_err(err, err_cap, "call_func_ptr result out of range");
             return false;
           }
-          break;
-        default:
-          set_err(err, err_cap, "unknown instruction kind");
+        }
+        break;
+      }
+      case SIR_INST_RET:
+        break;
+      case SIR_INST_RET_VAL:
+        if (inst->u.ret_val.value >= vc) {
+          set_err(err, err_cap, "ret_val value out of range");
           return false;
+        }
+        break;
+      case SIR_INST_EXIT:
+        break;
+      case SIR_INST_EXIT_VAL:
+        if (inst->u.exit_val.code >= vc) {
+          set_err(err, err_cap, "exit_val code out of range");
+          return false;
+        }
+        break;
+      default:
+        set_err(err, err_cap, "unknown instruction kind");
+        return false;
+    }
+  }
+  return true;
+}
+
+bool sir_module_validate(const sir_module_t* m, char* err, size_t err_cap) {
+  sir__validate_note("sir.validate.module", 0, 0, NULL);
+  if (!m) {
+    set_err(err, err_cap, "module is null");
+    return false;
+  }
+  if (m->func_count == 0 || !m->funcs) {
+    set_err(err, err_cap, "module has no funcs");
+    return false;
+  }
+  if (m->entry == 0 || m->entry > m->func_count) {
+    set_errf(err, err_cap, "entry out of range (%u > %u)", m->entry, m->func_count);
+    return false;
+  }
+
+  sir__validate_note("sir.validate.type", 0, 0, NULL);
+  if (m->type_count && !m->types) {
+    set_err(err, err_cap, "type_count set but types is null");
+    return false;
+  }
+  for (uint32_t ti = 0; ti < m->type_count; ti++) {
+    if (m->types[ti].prim == SIR_PRIM_INVALID) {
+      set_errf(err, err_cap, "invalid prim type at index %u of %u", ti + 1, m->type_count);
+      return false;
+    }
+  }
+
+  sir__validate_note("sir.validate.sym", 0, 0, NULL);
+  if (m->sym_count && !m->syms) {
+    set_err(err, err_cap, "sym_count set but syms is null");
+    return false;
+  }
+  for (uint32_t si = 0; si < m->sym_count; si++) {
+    const sir_sym_t* s = &m->syms[si];
+    if (s->kind != SIR_SYM_EXTERN_FN) {
+      set_errf(err, err_cap, "invalid sym kind at index %u of %u", si + 1, m->sym_count);
+      return false;
+    }
+    if (!s->name || s->name[0] == '\0') {
+      set_errf(err, err_cap, "sym name missing at index %u of %u", si + 1, m->sym_count);
+      return false;
+    }
+    if (s->sig.param_count && !s->sig.params) {
+      set_errf(err, err_cap, "sym params missing at index %u of %u", si + 1, m->sym_count);
+      return false;
+    }
+    if (s->sig.result_count && !s->sig.results) {
+      set_errf(err, err_cap, "sym results missing at index %u of %u", si + 1, m->sym_count);
+      return false;
+    }
+    for (uint32_t pi = 0; pi < s->sig.param_count; pi++) {
+      const sir_type_id_t tid = s->sig.params[pi];
+      if (tid == 0 || tid > m->type_count) {
+        set_errf(err, err_cap, "sym param type out of range (%u > %u)", (uint32_t)tid, m->type_count);
+        return false;
+      }
+    }
+    for (uint32_t ri = 0; ri < s->sig.result_count; ri++) {
+      const sir_type_id_t tid = s->sig.results[ri];
+      if (tid == 0 || tid > m->type_count) {
+        set_errf(err, err_cap, "sym result type out of range (%u > %u)", (uint32_t)tid, m->type_count);
+        return false;
       }
     }
   }
 
+  sir__validate_note("sir.validate.global", 0, 0, NULL);
+  if (m->global_count && !m->globals) {
+    set_err(err, err_cap, "global_count set but globals is null");
+    return false;
+  }
+  for (uint32_t gi = 0; gi < m->global_count; gi++) {
+    const sir_global_t* g = &m->globals[gi];
+    if (!g->name || g->name[0] == '\0') {
+      set_errf(err, err_cap, "global name missing at index %u of %u", gi + 1, m->global_count);
+      return false;
+    }
+    if (g->size == 0) {
+      set_errf(err, err_cap, "global size must be >0 at index %u of %u", gi + 1, m->global_count);
+      return false;
+    }
+    if (g->align == 0) {
+      set_errf(err, err_cap, "global align must be >0 at index %u of %u", gi + 1, m->global_count);
+      return false;
+    }
+    if (g->init_len > g->size) {
+      set_errf(err, err_cap, "global init_len out of range at index %u of %u", gi + 1, m->global_count);
+      return false;
+    }
+    if (g->init_len && !g->init_bytes) {
+      set_errf(err, err_cap, "global init_bytes missing at index %u of %u", gi + 1, m->global_count);
+      return false;
+    }
+  }
+
+  for (uint32_t fi = 0; fi < m->func_count; fi++) {
+    if (!validate_func(m, fi, err, err_cap)) return false;
+  }
+
   if (err && err_cap) err[0] = '\0';
   return true;
 }
@@ -1899,6 +2431,22 @@ bool sir_module_validate_ex(const sir_module_t* m, sir_validate_diag_t* out) {
   return ok;
 }
 
+bool sir_module_validate_func_ex(const sir_module_t* m, sir_func_id_t fid, sir_validate_diag_t* out) {
+  sir_validate_diag_t* prev = sir__validate_out_diag;
+  sir__validate_out_diag = out;
+  if (out) memset(out, 0, sizeof(*out));
+  bool ok = false;
+  sir__validate_note("sir.validate.func", fid, 0, NULL);
+  if (!m || !m->funcs || fid == 0 || fid > m->func_count) {
+    set_err(NULL, 0, "func id out of range");
+  } else {
+    ok = validate_func(m, fid - 1, NULL, 0);
+  }
+  sir__validate_out_diag = prev;
+  if (ok && out) memset(out, 0, sizeof(*out));
+  return ok;
+}
+
 static const sir_sym_t* sym_at(const sir_module_t* m, sir_sym_id_t id) {
   if (!m) return NULL;
   if (id == 0 || id > m->sym_count) return NULL;
@@ -1914,7 +2462,7 @@ static int32_t exec_call_extern(const sir_module_t* m, sem_guest_mem_t* mem, sir
 
   // MVP: dispatch by name to zABI primitives.
   const char* nm = s->name;
-  const sir_val_id_t* args = inst->u.call_extern.args;
+  const sir_val_id_t* args = (const sir_val_id_t*)inst_ref(m, inst->u.call_extern.args);
   const uint32_t n = inst->u.call_extern.arg_count;
 
   sir_val_id_t r0 = 0;
@@ -1985,6 +2533,27 @@ static int32_t exec_call_extern(const sir_module_t* m, sem_guest_mem_t* mem, sir
     return 0;
   }
 
+  if (strcmp(nm, "zi_transfer") == 0) {
+    if (!host.v.zi_transfer) return ZI_E_NOSYS;
+    if (n != 3) return ZI_E_INVALID;
+    const sir_val_id_t a0 = args[0], a1 = args[1], a2 = args[2];
+    if (a0 >= val_count || a1 >= val_count || a2 >= val_count) return ZI_E_BOUNDS;
+    const sir_value_t d = vals[a0];
+    const sir_value_t s = vals[a1];
+    const sir_value_t l = vals[a2];
+    if (d.kind != SIR_VAL_I32 || s.kind != SIR_VAL_I32) return ZI_E_INVALID;
+    const int64_t ll = (l.kind == SIR_VAL_I64) ? l.u.i64 : (l.kind == SIR_VAL_I32) ? (int64_t)l.u.i32 : (int64_t)-1;
+    if (l.kind != SIR_VAL_I64 && l.kind != SIR_VAL_I32) return ZI_E_INVALID;
+    if (ll < 0 || ll > 0x7FFFFFFFll) return ZI_E_INVALID;
+    const int32_t rc = host.v.zi_transfer(host.user, (zi_handle_t)d.u.i32, (zi_handle_t)s.u.i32, (zi_size32_t)ll);
+    if (sink && sink->on_hostcall) sink->on_hostcall(sink->user, m, fid, ip, nm, rc);
+    if (rc < 0) return rc;
+    if (inst->result_count == 1) {
+      vals[r0] = (sir_value_t){.kind = SIR_VAL_I32, .u.i32 = rc};
+    }
+    return 0;
+  }
+
   if (strcmp(nm, "zi_alloc") == 0) {
     if (!host.v.zi_alloc) return ZI_E_NOSYS;
     if (n != 1) return ZI_E_INVALID;
@@ -2043,11 +2612,77 @@ static int32_t exec_call_extern(const sir_module_t* m, sem_guest_mem_t* mem, sir
   return ZI_E_NOSYS;
 }
 
+// Live call frame. Frames link innermost -> outermost through `parent` so a checkpoint
+// can walk the C-recursive call stack without unwinding it.
 typedef struct sir_frame {
-  const sir_func_t* f;
+  const struct sir_frame* parent;
+  sir_func_id_t fid;
+  uint32_t ip; // instruction being executed (outer frames: their pending call)
   sir_value_t* vals;
+  uint32_t val_count;
 } sir_frame_t;
 
+// State shared by all frames of one run.
+// sir_module_run_lazy: the module being run, taken mutably so that bodies can be
+// committed into it, and the loader that commits them.
+typedef struct sir_exec_lazy {
+  sir_module_t* m;
+  sir_func_loader_fn load;
+  void* user;
+} sir_exec_lazy_t;
+
+typedef struct sir_exec_run {
+  const sir_exec_lazy_t* lazy; // NULL: calling a lazy func fails with ZI_E_NOSYS
+  const zi_ptr_t* globals;
+  uint32_t global_count;
+  const sir_frame_t* top;
+  uint32_t frame_count;
+  uint64_t steps;   // instructions started so far
+  uint64_t next_ck; // step count of the next checkpoint (UINT64_MAX: none)
+  uint64_t max_steps; // stop with ZI_E_AGAIN when steps reaches this (UINT64_MAX: no limit)
+  uint64_t next_stop; // min(next_ck, max_steps): the only per-step check in exec_body
+  const sir_exec_checkpoint_t* ck;
+  uint64_t allocs;      // host heap allocations made by the executor
+  uint64_t alloc_bytes;
+  uint32_t max_frames;  // deepest frame_count reached
+} sir_exec_run_t;
+
+static void exec_note_alloc(sir_exec_run_t* run, size_t bytes) {
+  run->allocs++;
+  run->alloc_bytes += bytes;
+}
+
+static void exec_push_frame(sir_exec_run_t* run) {
+  if (++run->frame_count > run->max_frames) run->max_frames = run->frame_count;
+}
+
+static void exec_checkpoint(const sir_module_t* m, const sem_guest_mem_t* mem, sir_exec_run_t* run) {
+  run->next_ck += run->ck->every_steps;
+  sir_exec_frame_t* frames = (sir_exec_frame_t*)calloc(run->frame_count, sizeof(*frames));
+  bool keep = frames != NULL;
+  if (frames) {
+    exec_note_alloc(run, (size_t)run->frame_count * sizeof(*frames));
+    uint32_t k = run->frame_count;
+    for (const sir_frame_t* fr = run->top; fr && k; fr = fr->parent) {
+      k--;
+      frames[k] = (sir_exec_frame_t){.fid = fr->fid, .ip = fr->ip, .vals = fr->vals, .val_count = fr->val_count};
+    }
+    const sir_exec_snapshot_t s = {
+        .steps = run->steps, .frames = frames, .frame_count = run->frame_count, .globals = run->globals, .global_count = run->global_count};
+    keep = run->ck->on_checkpoint(run->ck->user, m, mem, &s);
+    free(frames);
+  }
+  if (!keep) run->next_ck = UINT64_MAX;
+}
+
+// Called when steps reaches next_stop. Returns false when the step budget is spent.
+static bool exec_stop(const sir_module_t* m, const sem_guest_mem_t* mem, sir_exec_run_t* run) {
+  if (run->steps == run->next_ck) exec_checkpoint(m, mem, run);
+  if (run->steps == run->max_steps) return false;
+  run->next_stop = run->next_ck < run->max_steps ? run->next_ck : run->max_steps;
+  return true;
+}
+
 static bool f32_is_nan_bits(uint32_t bits) {
   const uint32_t exp = bits & 0x7F800000u;
   const uint32_t frac = bits & 0x007FFFFFu;
@@ -2072,12 +2707,12 @@ static bool is_pow2_u32(uint32_t x) {
   return x != 0u && (x & (x - 1u)) == 0u;
 }
 
-static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, const zi_ptr_t* globals, uint32_t global_count,
-                         sir_func_id_t fid, const sir_value_t* args, uint32_t arg_count, sir_value_t* out_results, uint32_t out_result_count,
+static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, sir_exec_run_t* run, sir_func_id_t fid,
+                         const sir_value_t* args, uint32_t arg_count, sir_value_t* out_results, uint32_t out_result_count,
                          uint32_t depth, const sir_exec_event_sink_t* sink);
 
-static int32_t exec_call_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, const zi_ptr_t* globals, uint32_t global_count,
-                              const sir_inst_t* inst, sir_value_t* vals, uint32_t val_count, uint32_t depth, const sir_exec_event_sink_t* sink) {
+static int32_t exec_call_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, sir_exec_run_t* run, const sir_inst_t* inst,
+                              sir_value_t* vals, uint32_t val_count, uint32_t depth, const sir_exec_event_sink_t* sink) {
   if (!m || !inst || !vals) return ZI_E_INTERNAL;
   const sir_func_id_t fid = inst->u.call_func.callee;
   if (fid == 0 || fid > m->func_count) return ZI_E_NOENT;
@@ -2088,8 +2723,9 @@ static int32_t exec_call_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_h
 
   if (inst->u.call_func.arg_count > 16) return ZI_E_INVALID;
   sir_value_t argv[16];
+  const sir_val_id_t* args = (const sir_val_id_t*)inst_ref(m, inst->u.call_func.args);
   for (uint32_t i = 0; i < inst->u.call_func.arg_count; i++) {
-    const sir_val_id_t a = inst->u.call_func.args[i];
+    const sir_val_id_t a = args[i];
     if (a >= val_count) return ZI_E_BOUNDS;
     argv[i] = vals[a];
   }
@@ -2097,7 +2733,7 @@ static int32_t exec_call_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_h
   sir_value_t resv[2];
   memset(resv, 0, sizeof(resv));
   const int32_t rc =
-      exec_func(m, mem, host, globals, global_count, fid, argv, inst->u.call_func.arg_count, resv, inst->result_count, depth + 1, sink);
+      exec_func(m, mem, host, run, fid, argv, inst->u.call_func.arg_count, resv, inst->result_count, depth + 1, sink);
   // Propagate errors and process-exit requests.
   if (rc != 0) return rc;
   for (uint8_t ri = 0; ri < inst->result_count; ri++) {
@@ -2120,128 +2756,75 @@ static bool decode_tagged_fid(zi_ptr_t p, sir_func_id_t* out_fid) {
   return true;
 }
 
-static int32_t exec_call_func_ptr(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, const zi_ptr_t* globals, uint32_t global_count,
-                                  const sir_inst_t* inst, sir_value_t* vals, uint32_t val_count, uint32_t depth, const sir_exec_event_sink_t* sink) {
+static int32_t exec_call_func_ptr(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, sir_exec_run_t* run, const sir_inst_t* inst,
+                                  sir_value_t* vals, uint32_t val_count, uint32_t depth, const sir_exec_event_sink_t* sink) {
   if (!m || !inst || !vals) return ZI_E_INTERNAL;
   const sir_val_id_t callee_slot = inst->u.call_func_ptr.callee_ptr;
   if (callee_slot >= val_count) return ZI_E_BOUNDS;
   const sir_value_t cv = vals[callee_slot];
-  if (cv.kind != SIR_VAL_PTR) return ZI_E_INVALID;
-
-  sir_func_id_t fid = 0;
-  if (!decode_tagged_fid(cv.u.ptr, &fid)) return ZI_E_INVALID;
-  if (fid == 0 || fid > m->func_count) return ZI_E_NOENT;
-
-  const sir_func_t* cf = &m->funcs[fid - 1];
-  if (inst->u.call_func_ptr.arg_count != cf->sig.param_count) return ZI_E_INVALID;
-  if (inst->result_count != cf->sig.result_count) return ZI_E_INVALID;
-
-  if (inst->u.call_func_ptr.arg_count > 16) return ZI_E_INVALID;
-  sir_value_t argv[16];
-  for (uint32_t i = 0; i < inst->u.call_func_ptr.arg_count; i++) {
-    const sir_val_id_t a = inst->u.call_func_ptr.args[i];
-    if (a >= val_count) return ZI_E_BOUNDS;
-    argv[i] = vals[a];
-  }
-
-  sir_value_t resv[2];
-  memset(resv, 0, sizeof(resv));
-  const int32_t rc =
-      exec_func(m, mem, host, globals, global_count, fid, argv, inst->u.call_func_ptr.arg_count, resv, inst->result_count, depth + 1, sink);
-  if (rc != 0) return rc;
-  for (uint8_t ri = 0; ri < inst->result_count; ri++) {
-    const sir_val_id_t dst = inst->results[ri];
-    if (dst >= val_count) return ZI_E_BOUNDS;
-    vals[dst] = resv[ri];
-  }
-  return 0;
-}
-
-static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, const zi_ptr_t* globals, uint32_t global_count,
-                         sir_func_id_t fid, const sir_value_t* args, uint32_t arg_count, sir_value_t* out_results, uint32_t out_result_count,
-                         uint32_t depth, const sir_exec_event_sink_t* sink) {
-  if (!m) return ZI_E_INTERNAL;
-  if (depth > 1024) return ZI_E_INTERNAL;
-  if (fid == 0 || fid > m->func_count) return ZI_E_NOENT;
-
-  const sir_func_t* f = &m->funcs[fid - 1];
-  if (!(args == NULL && arg_count == 0 && fid == m->entry) && arg_count != f->sig.param_count) return ZI_E_INVALID;
-  if (out_result_count != f->sig.result_count) return ZI_E_INVALID;
-
-  if (f->value_count > 1u << 20) return ZI_E_INVALID;
-  sir_value_t* vals = (sir_value_t*)calloc(f->value_count, sizeof(*vals));
-  if (!vals) return ZI_E_OOM;
-
-  if (args == NULL && arg_count == 0 && fid == m->entry) {
-    // Default-initialize entry params to zero (DX convenience).
-    for (uint32_t i = 0; i < f->sig.param_count; i++) {
-      if (i >= f->value_count) {
-        free(vals);
-        return ZI_E_BOUNDS;
-      }
-      const sir_type_id_t tid = f->sig.params ? f->sig.params[i] : 0;
-      if (tid == 0 || tid > m->type_count) {
-        free(vals);
-        return ZI_E_INVALID;
-      }
-      const sir_prim_type_t prim = m->types[tid - 1].prim;
-      switch (prim) {
-        case SIR_PRIM_VOID:
-          free(vals);
-          return ZI_E_INVALID;
-        case SIR_PRIM_I1:
-          vals[i] = (sir_value_t){.kind = SIR_VAL_I1, .u.u1 = 0};
-          break;
-        case SIR_PRIM_I8:
-          vals[i] = (sir_value_t){.kind = SIR_VAL_I8, .u.u8 = 0};
-          break;
-        case SIR_PRIM_I16:
-          vals[i] = (sir_value_t){.kind = SIR_VAL_I16, .u.u16 = 0};
-          break;
-        case SIR_PRIM_I32:
-          vals[i] = (sir_value_t){.kind = SIR_VAL_I32, .u.i32 = 0};
-          break;
-        case SIR_PRIM_I64:
-          vals[i] = (sir_value_t){.kind = SIR_VAL_I64, .u.i64 = 0};
-          break;
-        case SIR_PRIM_PTR:
-          vals[i] = (sir_value_t){.kind = SIR_VAL_PTR, .u.ptr = 0};
-          break;
-        case SIR_PRIM_BOOL:
-          vals[i] = (sir_value_t){.kind = SIR_VAL_BOOL, .u.b = 0};
-          break;
-        case SIR_PRIM_F32:
-          vals[i] = (sir_value_t){.kind = SIR_VAL_F32, .u.f32_bits = 0};
-          break;
-        case SIR_PRIM_F64:
-          vals[i] = (sir_value_t){.kind = SIR_VAL_F64, .u.f64_bits = 0};
-          break;
-        default:
-          free(vals);
-          return ZI_E_INVALID;
-      }
-    }
-  } else {
-    for (uint32_t i = 0; i < arg_count; i++) {
-      if (i >= f->value_count) {
-        free(vals);
-        return ZI_E_BOUNDS;
-      }
-      vals[i] = args[i];
-    }
+  if (cv.kind != SIR_VAL_PTR) return ZI_E_INVALID;
+
+  sir_func_id_t fid = 0;
+  if (!decode_tagged_fid(cv.u.ptr, &fid)) return ZI_E_INVALID;
+  if (fid == 0 || fid > m->func_count) return ZI_E_NOENT;
+
+  const sir_func_t* cf = &m->funcs[fid - 1];
+  if (inst->u.call_func_ptr.arg_count != cf->sig.param_count) return ZI_E_INVALID;
+  if (inst->result_count != cf->sig.result_count) return ZI_E_INVALID;
+
+  if (inst->u.call_func_ptr.arg_count > 16) return ZI_E_INVALID;
+  sir_value_t argv[16];
+  const sir_val_id_t* args = (const sir_val_id_t*)inst_ref(m, inst->u.call_func_ptr.args);
+  for (uint32_t i = 0; i < inst->u.call_func_ptr.arg_count; i++) {
+    const sir_val_id_t a = args[i];
+    if (a >= val_count) return ZI_E_BOUNDS;
+    argv[i] = vals[a];
+  }
+
+  sir_value_t resv[2];
+  memset(resv, 0, sizeof(resv));
+  const int32_t rc =
+      exec_func(m, mem, host, run, fid, argv, inst->u.call_func_ptr.arg_count, resv, inst->result_count, depth + 1, sink);
+  if (rc != 0) return rc;
+  for (uint8_t ri = 0; ri < inst->result_count; ri++) {
+    const sir_val_id_t dst = inst->results[ri];
+    if (dst >= val_count) return ZI_E_BOUNDS;
+    vals[dst] = resv[ri];
   }
+  return 0;
+}
+
+static int32_t load_lazy_func(const sir_exec_run_t* run, sir_func_id_t fid) {
+  if (!run->lazy) return ZI_E_NOSYS;
+  const int32_t rc = run->lazy->load(run->lazy->user, run->lazy->m, fid);
+  if (rc < 0) return rc;
+  // The body was validated by sir_mb_func_commit; a loader that did not commit is a bug.
+  return run->lazy->m->funcs[fid - 1].lazy ? ZI_E_INTERNAL : 0;
+}
+
+static int32_t exec_body(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, sir_exec_run_t* run, sir_frame_t* fr,
+                         uint32_t start_ip, sir_value_t* out_results, uint32_t out_result_count, uint32_t depth,
+                         const sir_exec_event_sink_t* sink) {
+  const sir_func_id_t fid = fr->fid;
+  const sir_func_t* f = &m->funcs[fid - 1];
+  sir_value_t* vals = fr->vals;
+  const zi_ptr_t* globals = run->globals;
+  const uint32_t global_count = run->global_count;
+  // Frame ips are only read by checkpoints (outer frames: their pending call).
+  const bool track_ip = run->ck != NULL;
 
-  for (uint32_t ip = 0; ip < f->inst_count;) {
+  for (uint32_t ip = start_ip; ip < f->inst_count;) {
     const sir_inst_t* i = &f->insts[ip];
+    if (track_ip) fr->ip = ip;
+    if (run->steps == run->next_stop && !exec_stop(m, mem, run)) return ZI_E_AGAIN;
+    run->steps++;
     if (sink && sink->on_step) sink->on_step(sink->user, m, fid, ip, i->k);
     switch (i->k) {
       case SIR_INST_CONST_I1:
         if (i->u.const_i1.dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         if (i->u.const_i1.v > 1) {
-          free(vals);
           return ZI_E_INVALID;
         }
         vals[i->u.const_i1.dst] = (sir_value_t){.kind = SIR_VAL_I1, .u.u1 = i->u.const_i1.v};
@@ -2249,7 +2832,6 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         break;
       case SIR_INST_CONST_I8:
         if (i->u.const_i8.dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         vals[i->u.const_i8.dst] = (sir_value_t){.kind = SIR_VAL_I8, .u.u8 = i->u.const_i8.v};
@@ -2257,7 +2839,6 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         break;
       case SIR_INST_CONST_I16:
         if (i->u.const_i16.dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         vals[i->u.const_i16.dst] = (sir_value_t){.kind = SIR_VAL_I16, .u.u16 = i->u.const_i16.v};
@@ -2265,7 +2846,6 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         break;
       case SIR_INST_CONST_I32:
         if (i->u.const_i32.dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         vals[i->u.const_i32.dst] = (sir_value_t){.kind = SIR_VAL_I32, .u.i32 = i->u.const_i32.v};
@@ -2273,7 +2853,6 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         break;
       case SIR_INST_CONST_I64:
         if (i->u.const_i64.dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         vals[i->u.const_i64.dst] = (sir_value_t){.kind = SIR_VAL_I64, .u.i64 = i->u.const_i64.v};
@@ -2281,11 +2860,9 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         break;
       case SIR_INST_CONST_BOOL:
         if (i->u.const_bool.dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         if (i->u.const_bool.v > 1) {
-          free(vals);
           return ZI_E_INVALID;
         }
         vals[i->u.const_bool.dst] = (sir_value_t){.kind = SIR_VAL_BOOL, .u.b = i->u.const_bool.v};
@@ -2293,7 +2870,6 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         break;
       case SIR_INST_CONST_F32:
         if (i->u.const_f32.dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         vals[i->u.const_f32.dst] = (sir_value_t){.kind = SIR_VAL_F32, .u.f32_bits = f32_canon_bits(i->u.const_f32.bits)};
@@ -2301,7 +2877,6 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         break;
       case SIR_INST_CONST_F64:
         if (i->u.const_f64.dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         vals[i->u.const_f64.dst] = (sir_value_t){.kind = SIR_VAL_F64, .u.f64_bits = f64_canon_bits(i->u.const_f64.bits)};
@@ -2309,7 +2884,6 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         break;
       case SIR_INST_CONST_PTR:
         if (i->u.const_ptr.dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         vals[i->u.const_ptr.dst] = (sir_value_t){.kind = SIR_VAL_PTR, .u.ptr = i->u.const_ptr.v};
@@ -2317,7 +2891,6 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         break;
       case SIR_INST_CONST_PTR_NULL:
         if (i->u.const_null.dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         vals[i->u.const_null.dst] = (sir_value_t){.kind = SIR_VAL_PTR, .u.ptr = 0};
@@ -2325,25 +2898,21 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         break;
       case SIR_INST_CONST_BYTES: {
         if (!host.v.zi_alloc) {
-          free(vals);
           return ZI_E_NOSYS;
         }
         if (i->u.const_bytes.dst_ptr >= f->value_count || i->u.const_bytes.dst_len >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const zi_ptr_t p = host.v.zi_alloc(host.user, (zi_size32_t)i->u.const_bytes.len);
         if (!p && i->u.const_bytes.len) {
-          free(vals);
           return ZI_E_OOM;
         }
         if (i->u.const_bytes.len) {
           uint8_t* w = NULL;
           if (!sem_guest_mem_map_rw(mem, p, (zi_size32_t)i->u.const_bytes.len, &w) || !w) {
-            free(vals);
             return ZI_E_BOUNDS;
           }
-          memcpy(w, i->u.const_bytes.bytes, i->u.const_bytes.len);
+          memcpy(w, inst_ref(m, i->u.const_bytes.bytes), i->u.const_bytes.len);
         }
         vals[i->u.const_bytes.dst_ptr] = (sir_value_t){.kind = SIR_VAL_PTR, .u.ptr = p};
         vals[i->u.const_bytes.dst_len] = (sir_value_t){.kind = SIR_VAL_I64, .u.i64 = (int64_t)i->u.const_bytes.len};
@@ -2355,13 +2924,11 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_val_id_t b = i->u.i32_add.b;
         const sir_val_id_t dst = i->u.i32_add.dst;
         if (a >= f->value_count || b >= f->value_count || dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t av = vals[a];
         const sir_value_t bv = vals[b];
         if (av.kind != SIR_VAL_I32 || bv.kind != SIR_VAL_I32) {
-          free(vals);
           return ZI_E_INVALID;
         }
         vals[dst] = (sir_value_t){.kind = SIR_VAL_I32, .u.i32 = (int32_t)(av.u.i32 + bv.u.i32)};
@@ -2390,12 +2957,10 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
           const sir_val_id_t xv = i->u.i32_un.x;
           dst = i->u.i32_un.dst;
           if (xv >= f->value_count || dst >= f->value_count) {
-            free(vals);
             return ZI_E_BOUNDS;
           }
           const sir_value_t av = vals[xv];
           if (av.kind != SIR_VAL_I32) {
-            free(vals);
             return ZI_E_INVALID;
           }
           x = av.u.i32;
@@ -2405,13 +2970,11 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
           const sir_val_id_t b = i->u.i32_add.b;
           dst = i->u.i32_add.dst;
           if (a >= f->value_count || b >= f->value_count || dst >= f->value_count) {
-            free(vals);
             return ZI_E_BOUNDS;
           }
           const sir_value_t av = vals[a];
           const sir_value_t bv = vals[b];
           if (av.kind != SIR_VAL_I32 || bv.kind != SIR_VAL_I32) {
-            free(vals);
             return ZI_E_INVALID;
           }
           x = av.u.i32;
@@ -2462,7 +3025,6 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
             break;
           case SIR_INST_I32_DIV_S_TRAP:
             if (y == 0 || (x == INT32_MIN && y == -1)) {
-              free(vals);
               return 255 + 1;
             }
             r = (int32_t)(x / y);
@@ -2481,7 +3043,6 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
             else r = (int32_t)((uint32_t)x % (uint32_t)y);
             break;
           default:
-            free(vals);
             return ZI_E_INTERNAL;
         }
         vals[dst] = (sir_value_t){.kind = SIR_VAL_I32, .u.i32 = r};
@@ -2493,13 +3054,11 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_val_id_t b = i->u.i32_cmp_eq.b;
         const sir_val_id_t dst = i->u.i32_cmp_eq.dst;
         if (a >= f->value_count || b >= f->value_count || dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t av = vals[a];
         const sir_value_t bv = vals[b];
         if (av.kind != SIR_VAL_I32 || bv.kind != SIR_VAL_I32) {
-          free(vals);
           return ZI_E_INVALID;
         }
         vals[dst] = (sir_value_t){.kind = SIR_VAL_BOOL, .u.b = (uint8_t)(av.u.i32 == bv.u.i32)};
@@ -2519,13 +3078,11 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_val_id_t b = i->u.i32_cmp_eq.b;
         const sir_val_id_t dst = i->u.i32_cmp_eq.dst;
         if (a >= f->value_count || b >= f->value_count || dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t av = vals[a];
         const sir_value_t bv = vals[b];
         if (av.kind != SIR_VAL_I32 || bv.kind != SIR_VAL_I32) {
-          free(vals);
           return ZI_E_INVALID;
         }
         const int32_t x = av.u.i32;
@@ -2560,7 +3117,6 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
             r = ((uint32_t)x >= (uint32_t)y);
             break;
           default:
-            free(vals);
             return ZI_E_INTERNAL;
         }
         vals[dst] = (sir_value_t){.kind = SIR_VAL_BOOL, .u.b = (uint8_t)(r ? 1 : 0)};
@@ -2572,13 +3128,11 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_val_id_t b = i->u.f_cmp.b;
         const sir_val_id_t dst = i->u.f_cmp.dst;
         if (a >= f->value_count || b >= f->value_count || dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t av = vals[a];
         const sir_value_t bv = vals[b];
         if (av.kind != SIR_VAL_F32 || bv.kind != SIR_VAL_F32) {
-          free(vals);
           return ZI_E_INVALID;
         }
         const bool nan_a = f32_is_nan_bits(av.u.f32_bits);
@@ -2596,13 +3150,11 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_val_id_t b = i->u.f_cmp.b;
         const sir_val_id_t dst = i->u.f_cmp.dst;
         if (a >= f->value_count || b >= f->value_count || dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t av = vals[a];
         const sir_value_t bv = vals[b];
         if (av.kind != SIR_VAL_F64 || bv.kind != SIR_VAL_F64) {
-          free(vals);
           return ZI_E_INVALID;
         }
         const bool nan_a = f64_is_nan_bits(av.u.f64_bits);
@@ -2619,11 +3171,9 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_global_id_t gid = i->u.global_addr.gid;
         const sir_val_id_t dst = i->u.global_addr.dst;
         if (dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         if (!globals || gid == 0 || gid > global_count) {
-          free(vals);
           return ZI_E_NOENT;
         }
         vals[dst] = (sir_value_t){.kind = SIR_VAL_PTR, .u.ptr = globals[gid - 1]};
@@ -2635,20 +3185,17 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_val_id_t index_id = i->u.ptr_offset.index;
         const sir_val_id_t dst = i->u.ptr_offset.dst;
         if (base_id >= f->value_count || index_id >= f->value_count || dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t bv = vals[base_id];
         const sir_value_t iv = vals[index_id];
         if (bv.kind != SIR_VAL_PTR) {
-          free(vals);
           return ZI_E_INVALID;
         }
         int64_t idx = 0;
         if (iv.kind == SIR_VAL_I64) idx = iv.u.i64;
         else if (iv.kind == SIR_VAL_I32) idx = iv.u.i32;
         else {
-          free(vals);
           return ZI_E_INVALID;
         }
         const uint64_t base = (uint64_t)bv.u.ptr;
@@ -2662,20 +3209,17 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_val_id_t off_id = i->u.ptr_add.off;
         const sir_val_id_t dst = i->u.ptr_add.dst;
         if (base_id >= f->value_count || off_id >= f->value_count || dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t bv = vals[base_id];
         const sir_value_t ov = vals[off_id];
         if (bv.kind != SIR_VAL_PTR) {
-          free(vals);
           return ZI_E_INVALID;
         }
         int64_t off = 0;
         if (ov.kind == SIR_VAL_I64) off = ov.u.i64;
         else if (ov.kind == SIR_VAL_I32) off = ov.u.i32;
         else {
-          free(vals);
           return ZI_E_INVALID;
         }
         const uint64_t base = (uint64_t)bv.u.ptr;
@@ -2688,20 +3232,17 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_val_id_t off_id = i->u.ptr_sub.off;
         const sir_val_id_t dst = i->u.ptr_sub.dst;
         if (base_id >= f->value_count || off_id >= f->value_count || dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t bv = vals[base_id];
         const sir_value_t ov = vals[off_id];
         if (bv.kind != SIR_VAL_PTR) {
-          free(vals);
           return ZI_E_INVALID;
         }
         int64_t off = 0;
         if (ov.kind == SIR_VAL_I64) off = ov.u.i64;
         else if (ov.kind == SIR_VAL_I32) off = ov.u.i32;
         else {
-          free(vals);
           return ZI_E_INVALID;
         }
         const uint64_t base = (uint64_t)bv.u.ptr;
@@ -2715,13 +3256,11 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_val_id_t b = i->u.ptr_cmp.b;
         const sir_val_id_t dst = i->u.ptr_cmp.dst;
         if (a >= f->value_count || b >= f->value_count || dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t av = vals[a];
         const sir_value_t bv = vals[b];
         if (av.kind != SIR_VAL_PTR || bv.kind != SIR_VAL_PTR) {
-          free(vals);
           return ZI_E_INVALID;
         }
         const bool eq = (av.u.ptr == bv.u.ptr);
@@ -2734,12 +3273,10 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_val_id_t x = i->u.ptr_to_i64.x;
         const sir_val_id_t dst = i->u.ptr_to_i64.dst;
         if (x >= f->value_count || dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t xv = vals[x];
         if (xv.kind != SIR_VAL_PTR) {
-          free(vals);
           return ZI_E_INVALID;
         }
         vals[dst] = (sir_value_t){.kind = SIR_VAL_I64, .u.i64 = (int64_t)(uint64_t)xv.u.ptr};
@@ -2750,7 +3287,6 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_val_id_t x = i->u.ptr_from_i64.x;
         const sir_val_id_t dst = i->u.ptr_from_i64.dst;
         if (x >= f->value_count || dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t xv = vals[x];
@@ -2758,7 +3294,6 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         if (xv.kind == SIR_VAL_I64) bits = (uint64_t)xv.u.i64;
         else if (xv.kind == SIR_VAL_I32) bits = (uint64_t)(uint32_t)xv.u.i32;
         else {
-          free(vals);
           return ZI_E_INVALID;
         }
         vals[dst] = (sir_value_t){.kind = SIR_VAL_PTR, .u.ptr = (zi_ptr_t)bits};
@@ -2769,12 +3304,10 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_val_id_t x = i->u.bool_not.x;
         const sir_val_id_t dst = i->u.bool_not.dst;
         if (x >= f->value_count || dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t xv = vals[x];
         if (xv.kind != SIR_VAL_BOOL) {
-          free(vals);
           return ZI_E_INVALID;
         }
         vals[dst] = (sir_value_t){.kind = SIR_VAL_BOOL, .u.b = (uint8_t)(xv.u.b ? 0 : 1)};
@@ -2788,13 +3321,11 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_val_id_t b = i->u.bool_bin.b;
         const sir_val_id_t dst = i->u.bool_bin.dst;
         if (a >= f->value_count || b >= f->value_count || dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t av = vals[a];
         const sir_value_t bv = vals[b];
         if (av.kind != SIR_VAL_BOOL || bv.kind != SIR_VAL_BOOL) {
-          free(vals);
           return ZI_E_INVALID;
         }
         const uint8_t ax = (uint8_t)(av.u.b ? 1 : 0);
@@ -2811,12 +3342,10 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_val_id_t x = i->u.i32_trunc_i64.x;
         const sir_val_id_t dst = i->u.i32_trunc_i64.dst;
         if (x >= f->value_count || dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t xv = vals[x];
         if (xv.kind != SIR_VAL_I64) {
-          free(vals);
           return ZI_E_INVALID;
         }
         vals[dst] = (sir_value_t){.kind = SIR_VAL_I32, .u.i32 = (int32_t)(uint32_t)xv.u.i64};
@@ -2827,12 +3356,10 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_val_id_t x = i->u.i32_zext_i8.x;
         const sir_val_id_t dst = i->u.i32_zext_i8.dst;
         if (x >= f->value_count || dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t xv = vals[x];
         if (xv.kind != SIR_VAL_I8) {
-          free(vals);
           return ZI_E_INVALID;
         }
         vals[dst] = (sir_value_t){.kind = SIR_VAL_I32, .u.i32 = (int32_t)(uint32_t)xv.u.u8};
@@ -2843,12 +3370,10 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_val_id_t x = i->u.i32_zext_i16.x;
         const sir_val_id_t dst = i->u.i32_zext_i16.dst;
         if (x >= f->value_count || dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t xv = vals[x];
         if (xv.kind != SIR_VAL_I16) {
-          free(vals);
           return ZI_E_INVALID;
         }
         vals[dst] = (sir_value_t){.kind = SIR_VAL_I32, .u.i32 = (int32_t)(uint32_t)xv.u.u16};
@@ -2859,12 +3384,10 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_val_id_t x = i->u.i64_zext_i32.x;
         const sir_val_id_t dst = i->u.i64_zext_i32.dst;
         if (x >= f->value_count || dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t xv = vals[x];
         if (xv.kind != SIR_VAL_I32) {
-          free(vals);
           return ZI_E_INVALID;
         }
         vals[dst] = (sir_value_t){.kind = SIR_VAL_I64, .u.i64 = (int64_t)(uint64_t)(uint32_t)xv.u.i32};
@@ -2877,12 +3400,10 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_val_id_t b = i->u.select.b;
         const sir_val_id_t dst = i->u.select.dst;
         if (cond >= f->value_count || a >= f->value_count || b >= f->value_count || dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t cv = vals[cond];
         if (cv.kind != SIR_VAL_BOOL) {
-          free(vals);
           return ZI_E_INVALID;
         }
         vals[dst] = cv.u.b ? vals[a] : vals[b];
@@ -2892,10 +3413,9 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
       case SIR_INST_BR:
         if (i->u.br.arg_count) {
           const uint32_t n = i->u.br.arg_count;
-          const sir_val_id_t* src = i->u.br.src_slots;
-          const sir_val_id_t* dst = i->u.br.dst_slots;
+          const sir_val_id_t* src = (const sir_val_id_t*)inst_ref(m, i->u.br.src_slots);
+          const sir_val_id_t* dst = (const sir_val_id_t*)inst_ref(m, i->u.br.dst_slots);
           if (!src || !dst) {
-            free(vals);
             return ZI_E_INVALID;
           }
 
@@ -2904,16 +3424,15 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
           if (n > (uint32_t)(sizeof(tmp_small) / sizeof(tmp_small[0]))) {
             tmp = (sir_value_t*)malloc((size_t)n * sizeof(*tmp));
             if (!tmp) {
-              free(vals);
               return ZI_E_OOM;
             }
+            exec_note_alloc(run, (size_t)n * sizeof(*tmp));
           }
 
           for (uint32_t ai = 0; ai < n; ai++) {
             const sir_val_id_t s = src[ai];
             if (s >= f->value_count) {
               if (tmp != tmp_small) free(tmp);
-              free(vals);
               return ZI_E_BOUNDS;
             }
             tmp[ai] = vals[s];
@@ -2922,7 +3441,6 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
             const sir_val_id_t d = dst[ai];
             if (d >= f->value_count) {
               if (tmp != tmp_small) free(tmp);
-              free(vals);
               return ZI_E_BOUNDS;
             }
             vals[d] = tmp[ai];
@@ -2935,12 +3453,10 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
       case SIR_INST_CBR: {
         const sir_val_id_t cvid = i->u.cbr.cond;
         if (cvid >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t cv = vals[cvid];
         if (cv.kind != SIR_VAL_BOOL) {
-          free(vals);
           return ZI_E_INVALID;
         }
         ip = cv.u.b ? i->u.cbr.then_ip : i->u.cbr.else_ip;
@@ -2949,19 +3465,16 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
       case SIR_INST_SWITCH: {
         const sir_val_id_t sid = i->u.sw.scrut;
         if (sid >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t sv = vals[sid];
         if (sv.kind != SIR_VAL_I32) {
-          free(vals);
           return ZI_E_INVALID;
         }
         const uint32_t n = i->u.sw.case_count;
-        const int32_t* lits = i->u.sw.case_lits;
-        const uint32_t* tgt = i->u.sw.case_target;
+        const int32_t* lits = (const int32_t*)inst_ref(m, i->u.sw.case_lits);
+        const uint32_t* tgt = (const uint32_t*)inst_ref(m, i->u.sw.case_target);
         if (n && (!lits || !tgt)) {
-          free(vals);
           return ZI_E_INVALID;
         }
         uint32_t next_ip = i->u.sw.default_ip;
@@ -2979,25 +3492,21 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_val_id_t src_id = i->u.mem_copy.src;
         const sir_val_id_t len_id = i->u.mem_copy.len;
         if (dst_id >= f->value_count || src_id >= f->value_count || len_id >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t dv = vals[dst_id];
         const sir_value_t sv = vals[src_id];
         const sir_value_t lv = vals[len_id];
         if (dv.kind != SIR_VAL_PTR || sv.kind != SIR_VAL_PTR) {
-          free(vals);
           return ZI_E_INVALID;
         }
         int64_t ll = 0;
         if (lv.kind == SIR_VAL_I64) ll = lv.u.i64;
         else if (lv.kind == SIR_VAL_I32) ll = lv.u.i32;
         else {
-          free(vals);
           return ZI_E_INVALID;
         }
         if (ll < 0 || ll > 0x7FFFFFFFll) {
-          free(vals);
           return ZI_E_INVALID;
         }
         const uint32_t n = (uint32_t)ll;
@@ -3013,7 +3522,6 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
           const zi_ptr_t sa_end = (zi_ptr_t)(sa + (zi_ptr_t)n);
           const bool overlap = (da < sa_end) && (sa < da_end);
           if (overlap) {
-            free(vals);
             // deterministic trap (align with term.trap in SEM: exit code 255)
             return 256;
           }
@@ -3022,11 +3530,9 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const uint8_t* r = NULL;
         uint8_t* w = NULL;
         if (!sem_guest_mem_map_ro(mem, sv.u.ptr, (zi_size32_t)n, &r) || !r) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         if (!sem_guest_mem_map_rw(mem, dv.u.ptr, (zi_size32_t)n, &w) || !w) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         memmove(w, r, n);
@@ -3038,32 +3544,27 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_val_id_t byte_id = i->u.mem_fill.byte;
         const sir_val_id_t len_id = i->u.mem_fill.len;
         if (dst_id >= f->value_count || byte_id >= f->value_count || len_id >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t dv = vals[dst_id];
         const sir_value_t bv = vals[byte_id];
         const sir_value_t lv = vals[len_id];
         if (dv.kind != SIR_VAL_PTR) {
-          free(vals);
           return ZI_E_INVALID;
         }
         uint8_t byte = 0;
         if (bv.kind == SIR_VAL_I8) byte = bv.u.u8;
         else if (bv.kind == SIR_VAL_I32) byte = (uint8_t)bv.u.i32;
         else {
-          free(vals);
           return ZI_E_INVALID;
         }
         int64_t ll = 0;
         if (lv.kind == SIR_VAL_I64) ll = lv.u.i64;
         else if (lv.kind == SIR_VAL_I32) ll = lv.u.i32;
         else {
-          free(vals);
           return ZI_E_INVALID;
         }
         if (ll < 0 || ll > 0x7FFFFFFFll) {
-          free(vals);
           return ZI_E_INVALID;
         }
         const uint32_t n = (uint32_t)ll;
@@ -3073,7 +3574,6 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         }
         uint8_t* w = NULL;
         if (!sem_guest_mem_map_rw(mem, dv.u.ptr, (zi_size32_t)n, &w) || !w) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         memset(w, (int)byte, n);
@@ -3083,12 +3583,10 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
       case SIR_INST_ALLOCA: {
         const sir_val_id_t dst = i->u.alloca_.dst;
         if (dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const zi_ptr_t p = sem_guest_alloc(mem, (zi_size32_t)i->u.alloca_.size, (zi_size32_t)i->u.alloca_.align);
         if (!p) {
-          free(vals);
           return ZI_E_OOM;
         }
         vals[dst] = (sir_value_t){.kind = SIR_VAL_PTR, .u.ptr = p};
@@ -3103,23 +3601,19 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_val_id_t a = i->u.store.addr;
         const sir_val_id_t v = i->u.store.value;
         if (a >= f->value_count || v >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t av = vals[a];
         if (av.kind != SIR_VAL_PTR) {
-          free(vals);
           return ZI_E_INVALID;
         }
         const uint32_t align = i->u.store.align ? i->u.store.align : 1u;
         if (!is_pow2_u32(align)) {
-          free(vals);
           return ZI_E_INVALID;
         }
         if (align > 1u) {
           const uint64_t addr = (uint64_t)av.u.ptr;
           if ((addr & (uint64_t)(align - 1u)) != 0ull) {
-            free(vals);
             return 256;
           }
         }
@@ -3131,7 +3625,6 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         else size = (uint32_t)sizeof(zi_ptr_t);
         uint8_t* w = NULL;
         if (!sem_guest_mem_map_rw(mem, av.u.ptr, (zi_size32_t)size, &w) || !w) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         if (sink && sink->on_mem) sink->on_mem(sink->user, m, fid, ip, SIR_MEM_WRITE, av.u.ptr, size);
@@ -3139,7 +3632,6 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
           const sir_value_t vv = vals[v];
           const uint8_t b = (vv.kind == SIR_VAL_I8) ? vv.u.u8 : (vv.kind == SIR_VAL_I32) ? (uint8_t)vv.u.i32 : 0;
           if (vv.kind != SIR_VAL_I8 && vv.kind != SIR_VAL_I32) {
-            free(vals);
             return ZI_E_INVALID;
           }
           memcpy(w, &b, 1);
@@ -3151,28 +3643,24 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
           else if (vv.kind == SIR_VAL_I32) x = (uint16_t)(uint32_t)vv.u.i32;
           else if (vv.kind == SIR_VAL_I64) x = (uint16_t)(uint64_t)vv.u.i64;
           else {
-            free(vals);
             return ZI_E_INVALID;
           }
           memcpy(w, &x, 2);
         } else if (i->k == SIR_INST_STORE_I32) {
           const sir_value_t vv = vals[v];
           if (vv.kind != SIR_VAL_I32) {
-            free(vals);
             return ZI_E_INVALID;
           }
           memcpy(w, &vv.u.i32, 4);
         } else if (i->k == SIR_INST_STORE_I64) {
           const sir_value_t vv = vals[v];
           if (vv.kind != SIR_VAL_I64) {
-            free(vals);
             return ZI_E_INVALID;
           }
           memcpy(w, &vv.u.i64, 8);
         } else {
           const sir_value_t vv = vals[v];
           if (vv.kind != SIR_VAL_PTR) {
-            free(vals);
             return ZI_E_INVALID;
           }
           memcpy(w, &vv.u.ptr, sizeof(vv.u.ptr));
@@ -3185,44 +3673,37 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_val_id_t a = i->u.store.addr;
         const sir_val_id_t v = i->u.store.value;
         if (a >= f->value_count || v >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t av = vals[a];
         if (av.kind != SIR_VAL_PTR) {
-          free(vals);
           return ZI_E_INVALID;
         }
         const uint32_t align = i->u.store.align ? i->u.store.align : 1u;
         if (!is_pow2_u32(align)) {
-          free(vals);
           return ZI_E_INVALID;
         }
         if (align > 1u) {
           const uint64_t addr = (uint64_t)av.u.ptr;
           if ((addr & (uint64_t)(align - 1u)) != 0ull) {
-            free(vals);
             return 256;
           }
         }
         const uint32_t size = (i->k == SIR_INST_STORE_F32) ? 4u : 8u;
         uint8_t* w = NULL;
         if (!sem_guest_mem_map_rw(mem, av.u.ptr, (zi_size32_t)size, &w) || !w) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         if (sink && sink->on_mem) sink->on_mem(sink->user, m, fid, ip, SIR_MEM_WRITE, av.u.ptr, size);
         const sir_value_t vv = vals[v];
         if (i->k == SIR_INST_STORE_F32) {
           if (vv.kind != SIR_VAL_F32) {
-            free(vals);
             return ZI_E_INVALID;
           }
           const uint32_t bits = f32_canon_bits(vv.u.f32_bits);
           memcpy(w, &bits, 4);
         } else {
           if (vv.kind != SIR_VAL_F64) {
-            free(vals);
             return ZI_E_INVALID;
           }
           const uint64_t bits = f64_canon_bits(vv.u.f64_bits);
@@ -3239,23 +3720,19 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_val_id_t a = i->u.load.addr;
         const sir_val_id_t dst = i->u.load.dst;
         if (a >= f->value_count || dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t av = vals[a];
         if (av.kind != SIR_VAL_PTR) {
-          free(vals);
           return ZI_E_INVALID;
         }
         const uint32_t align = i->u.load.align ? i->u.load.align : 1u;
         if (!is_pow2_u32(align)) {
-          free(vals);
           return ZI_E_INVALID;
         }
         if (align > 1u) {
           const uint64_t addr = (uint64_t)av.u.ptr;
           if ((addr & (uint64_t)(align - 1u)) != 0ull) {
-            free(vals);
             return 256;
           }
         }
@@ -3267,7 +3744,6 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         else size = (uint32_t)sizeof(zi_ptr_t);
         const uint8_t* r = NULL;
         if (!sem_guest_mem_map_ro(mem, av.u.ptr, (zi_size32_t)size, &r) || !r) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         if (sink && sink->on_mem) sink->on_mem(sink->user, m, fid, ip, SIR_MEM_READ, av.u.ptr, size);
@@ -3300,30 +3776,25 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
         const sir_val_id_t a = i->u.load.addr;
         const sir_val_id_t dst = i->u.load.dst;
         if (a >= f->value_count || dst >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t av = vals[a];
         if (av.kind != SIR_VAL_PTR) {
-          free(vals);
           return ZI_E_INVALID;
         }
         const uint32_t align = i->u.load.align ? i->u.load.align : 1u;
         if (!is_pow2_u32(align)) {
-          free(vals);
           return ZI_E_INVALID;
         }
         if (align > 1u) {
           const uint64_t addr = (uint64_t)av.u.ptr;
           if ((addr & (uint64_t)(align - 1u)) != 0ull) {
-            free(vals);
             return 256;
           }
         }
         const uint32_t size = (i->k == SIR_INST_LOAD_F32) ? 4u : 8u;
         const uint8_t* r = NULL;
         if (!sem_guest_mem_map_ro(mem, av.u.ptr, (zi_size32_t)size, &r) || !r) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         if (sink && sink->on_mem) sink->on_mem(sink->user, m, fid, ip, SIR_MEM_READ, av.u.ptr, size);
@@ -3342,51 +3813,42 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
       case SIR_INST_CALL_EXTERN: {
         const int32_t r = exec_call_extern(m, mem, host, fid, ip, sink, i, vals, f->value_count);
         if (r < 0) {
-          free(vals);
           return r;
         }
         ip++;
         break;
       }
       case SIR_INST_CALL_FUNC: {
-        const int32_t r = exec_call_func(m, mem, host, globals, global_count, i, vals, f->value_count, depth, sink);
-        if (r < 0) {
-          free(vals);
-          return r;
+        const int32_t r = exec_call_func(m, mem, host, run, i, vals, f->value_count, depth, sink);
+        if (r != 0) {
+          return r; // error, or an exit/trap requested by the callee
         }
         ip++;
         break;
       }
       case SIR_INST_CALL_FUNC_PTR: {
-        const int32_t r = exec_call_func_ptr(m, mem, host, globals, global_count, i, vals, f->value_count, depth, sink);
-        if (r < 0) {
-          free(vals);
-          return r;
+        const int32_t r = exec_call_func_ptr(m, mem, host, run, i, vals, f->value_count, depth, sink);
+        if (r != 0) {
+          return r; // error, or an exit/trap requested by the callee
         }
         ip++;
         break;
       }
       case SIR_INST_RET:
         if (out_results && out_result_count) {
-          free(vals);
           return ZI_E_INVALID;
         }
-        free(vals);
         return 0;
       case SIR_INST_RET_VAL:
         if (out_result_count != 1 || !out_results) {
-          free(vals);
           return ZI_E_INVALID;
         }
         if (i->u.ret_val.value >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         out_results[0] = vals[i->u.ret_val.value];
-        free(vals);
         return 0;
       case SIR_INST_EXIT:
-        free(vals);
         if (i->u.exit_.code < 0) return ZI_E_INVALID;
         if (i->u.exit_.code == INT32_MAX) return ZI_E_INVALID;
         // Encode "process exit requested" as rc+1 so callers can distinguish from
@@ -3395,38 +3857,118 @@ static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t
       case SIR_INST_EXIT_VAL: {
         const sir_val_id_t cv = i->u.exit_val.code;
         if (cv >= f->value_count) {
-          free(vals);
           return ZI_E_BOUNDS;
         }
         const sir_value_t v = vals[cv];
         if (v.kind == SIR_VAL_I32) {
-          free(vals);
           if (v.u.i32 < 0) return ZI_E_INVALID;
           if (v.u.i32 == INT32_MAX) return ZI_E_INVALID;
           return v.u.i32 + 1;
         }
         if (v.kind == SIR_VAL_I64) {
           if (v.u.i64 < INT32_MIN || v.u.i64 > INT32_MAX) {
-            free(vals);
             return ZI_E_INVALID;
           }
-          free(vals);
           if (v.u.i64 < 0 || v.u.i64 == INT32_MAX) return ZI_E_INVALID;
           return (int32_t)v.u.i64 + 1;
         }
-        {
-          free(vals);
-          return ZI_E_INVALID;
-        }
+        return ZI_E_INVALID;
       }
       default:
+        return ZI_E_INVALID;
+    }
+  }
+
+  return 0;
+}
+
+static int32_t exec_func(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, sir_exec_run_t* run, sir_func_id_t fid,
+                         const sir_value_t* args, uint32_t arg_count, sir_value_t* out_results, uint32_t out_result_count,
+                         uint32_t depth, const sir_exec_event_sink_t* sink) {
+  if (!m) return ZI_E_INTERNAL;
+  if (depth > 1024) return ZI_E_INTERNAL;
+  if (fid == 0 || fid > m->func_count) return ZI_E_NOENT;
+
+  const sir_func_t* f = &m->funcs[fid - 1];
+  if (f->lazy) {
+    const int32_t lr = load_lazy_func(run, fid);
+    if (lr < 0) return lr;
+  }
+  if (!(args == NULL && arg_count == 0 && fid == m->entry) && arg_count != f->sig.param_count) return ZI_E_INVALID;
+  if (out_result_count != f->sig.result_count) return ZI_E_INVALID;
+
+  if (f->value_count > 1u << 20) return ZI_E_INVALID;
+  sir_value_t* vals = (sir_value_t*)calloc(f->value_count, sizeof(*vals));
+  if (!vals) return ZI_E_OOM;
+  exec_note_alloc(run, (size_t)f->value_count * sizeof(*vals));
+
+  if (args == NULL && arg_count == 0 && fid == m->entry) {
+    // Default-initialize entry params to zero (DX convenience).
+    for (uint32_t i = 0; i < f->sig.param_count; i++) {
+      if (i >= f->value_count) {
+        free(vals);
+        return ZI_E_BOUNDS;
+      }
+      const sir_type_id_t tid = f->sig.params ? f->sig.params[i] : 0;
+      if (tid == 0 || tid > m->type_count) {
         free(vals);
         return ZI_E_INVALID;
+      }
+      const sir_prim_type_t prim = m->types[tid - 1].prim;
+      switch (prim) {
+        case SIR_PRIM_VOID:
+          free(vals);
+          return ZI_E_INVALID;
+        case SIR_PRIM_I1:
+          vals[i] = (sir_value_t){.kind = SIR_VAL_I1, .u.u1 = 0};
+          break;
+        case SIR_PRIM_I8:
+          vals[i] = (sir_value_t){.kind = SIR_VAL_I8, .u.u8 = 0};
+          break;
+        case SIR_PRIM_I16:
+          vals[i] = (sir_value_t){.kind = SIR_VAL_I16, .u.u16 = 0};
+          break;
+        case SIR_PRIM_I32:
+          vals[i] = (sir_value_t){.kind = SIR_VAL_I32, .u.i32 = 0};
+          break;
+        case SIR_PRIM_I64:
+          vals[i] = (sir_value_t){.kind = SIR_VAL_I64, .u.i64 = 0};
+          break;
+        case SIR_PRIM_PTR:
+          vals[i] = (sir_value_t){.kind = SIR_VAL_PTR, .u.ptr = 0};
+          break;
+        case SIR_PRIM_BOOL:
+          vals[i] = (sir_value_t){.kind = SIR_VAL_BOOL, .u.b = 0};
+          break;
+        case SIR_PRIM_F32:
+          vals[i] = (sir_value_t){.kind = SIR_VAL_F32, .u.f32_bits = 0};
+          break;
+        case SIR_PRIM_F64:
+          vals[i] = (sir_value_t){.kind = SIR_VAL_F64, .u.f64_bits = 0};
+          break;
+        default:
+          free(vals);
+          return ZI_E_INVALID;
+      }
+    }
+  } else {
+    for (uint32_t i = 0; i < arg_count; i++) {
+      if (i >= f->value_count) {
+        free(vals);
+        return ZI_E_BOUNDS;
+      }
+      vals[i] = args[i];
     }
   }
 
+  sir_frame_t fr = {.parent = run->top, .fid = fid, .ip = 0, .vals = vals, .val_count = f->value_count};
+  run->top = &fr;
+  exec_push_frame(run);
+  const int32_t rc = exec_body(m, mem, host, run, &fr, 0, out_results, out_result_count, depth, sink);
+  run->top = fr.parent;
+  run->frame_count--;
   free(vals);
-  return 0;
+  return rc;
 }
 
 const char* sir_inst_kind_name(sir_inst_kind_t k) {
@@ -3608,15 +4150,111 @@ int32_t sir_module_run(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t h
   return sir_module_run_ex(m, mem, host, NULL);
 }
 
-int32_t sir_module_run_ex(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, const sir_exec_event_sink_t* sink) {
+// Re-enters the frames of a snapshot from the outermost one down: each outer frame
+// waits on its pending call, stores the results, and continues after it.
+static int32_t exec_resume_frame(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, sir_exec_run_t* run,
+                                 const sir_exec_snapshot_t* from, uint32_t k, sir_value_t* out_results, uint32_t out_result_count,
+                                 const sir_exec_event_sink_t* sink) {
+  const sir_exec_frame_t* sf = &from->frames[k];
+  const sir_func_t* f = &m->funcs[sf->fid - 1];
+  if (out_result_count != f->sig.result_count) return ZI_E_INVALID;
+
+  sir_value_t* vals = (sir_value_t*)calloc(f->value_count, sizeof(*vals));
+  if (!vals) return ZI_E_OOM;
+  exec_note_alloc(run, (size_t)f->value_count * sizeof(*vals));
+  memcpy(vals, sf->vals, (size_t)f->value_count * sizeof(*vals));
+
+  sir_frame_t fr = {.parent = run->top, .fid = sf->fid, .ip = sf->ip, .vals = vals, .val_count = f->value_count};
+  run->top = &fr;
+  exec_push_frame(run);
+  uint32_t ip = sf->ip;
+  int32_t rc = 0;
+  if (k + 1 < from->frame_count) {
+    const sir_inst_t* inst = &f->insts[ip];
+    sir_value_t resv[2];
+    memset(resv, 0, sizeof(resv));
+    rc = exec_resume_frame(m, mem, host, run, from, k + 1, resv, inst->result_count, sink);
+    for (uint8_t ri = 0; rc == 0 && ri < inst->result_count; ri++) {
+      const sir_val_id_t dst = inst->results[ri];
+      if (dst >= f->value_count) rc = ZI_E_BOUNDS;
+      else vals[dst] = resv[ri];
+    }
+    ip++;
+  }
+  if (rc == 0) rc = exec_body(m, mem, host, run, &fr, ip, out_results, out_result_count, k, sink);
+  run->top = fr.parent;
+  run->frame_count--;
+  free(vals);
+  return rc;
+}
+
+static bool resume_snapshot_fits(const sir_module_t* m, const sir_exec_snapshot_t* s) {
+  if (!s->frames || s->frame_count == 0 || s->frame_count > 1024) return false;
+  if (s->global_count != m->global_count || (s->global_count && !s->globals)) return false;
+  if (s->frames[0].fid != m->entry) return false;
+  for (uint32_t k = 0; k < s->frame_count; k++) {
+    const sir_exec_frame_t* sf = &s->frames[k];
+    if (sf->fid == 0 || sf->fid > m->func_count) return false;
+    const sir_func_t* f = &m->funcs[sf->fid - 1];
+    if (f->lazy || sf->ip >= f->inst_count || sf->val_count != f->value_count) return false;
+    if (f->value_count && !sf->vals) return false;
+    if (k + 1 == s->frame_count) continue;
+    // Outer frames must be parked on a call into the next frame.
+    const sir_inst_t* inst = &f->insts[sf->ip];
+    const sir_func_id_t next = s->frames[k + 1].fid;
+    if (inst->k == SIR_INST_CALL_FUNC) {
+      if (inst->u.call_func.callee != next) return false;
+    } else if (inst->k == SIR_INST_CALL_FUNC_PTR) {
+      const sir_val_id_t slot = inst->u.call_func_ptr.callee_ptr;
+      sir_func_id_t fid = 0;
+      if (slot >= sf->val_count || sf->vals[slot].kind != SIR_VAL_PTR || !decode_tagged_fid(sf->vals[slot].u.ptr, &fid) || fid != next) {
+        return false;
+      }
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void exec_report(const sir_exec_run_t* run, sir_exec_stats_t* out) {
+  if (!out) return;
+  *out = (sir_exec_stats_t){
+      .steps = run->steps, .host_allocs = run->allocs, .host_alloc_bytes = run->alloc_bytes, .max_frames = run->max_frames};
+}
+
+static int32_t exec_run(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, const sir_exec_event_sink_t* sink,
+                        const sir_exec_checkpoint_t* ck, const sir_exec_snapshot_t* from, uint64_t max_steps, bool validated,
+                        const sir_exec_lazy_t* lazy, sir_exec_stats_t* stats) {
+  if (stats) memset(stats, 0, sizeof(*stats));
   if (!m || !mem) return ZI_E_INTERNAL;
   char err[160];
-  if (!sir_module_validate(m, err, sizeof(err))) return ZI_E_INVALID;
+  if (!validated && !sir_module_validate(m, err, sizeof(err))) return ZI_E_INVALID;
+
+  sir_exec_run_t run = {
+      .lazy = lazy, .global_count = m->global_count, .next_ck = UINT64_MAX, .max_steps = max_steps ? max_steps : UINT64_MAX};
+  if (ck && ck->on_checkpoint && ck->every_steps) {
+    run.ck = ck;
+    run.next_ck = ck->every_steps;
+  }
+
+  if (from) {
+    if (!resume_snapshot_fits(m, from)) return ZI_E_INVALID;
+    run.globals = from->globals;
+    run.steps = from->steps;
+    if (run.ck) run.next_ck = (from->steps / ck->every_steps + 1u) * ck->every_steps;
+    run.next_stop = run.next_ck < run.max_steps ? run.next_ck : run.max_steps;
+    const int32_t r = exec_resume_frame(m, mem, host, &run, from, 0, NULL, 0, sink);
+    exec_report(&run, stats);
+    if (r > 0) return r - 1;
+    return r;
+  }
 
   zi_ptr_t* globals = NULL;
   if (m->global_count) {
     globals = (zi_ptr_t*)calloc(m->global_count, sizeof(*globals));
     if (!globals) return ZI_E_OOM;
+    exec_note_alloc(&run, (size_t)m->global_count * sizeof(*globals));
     for (uint32_t i = 0; i < m->global_count; i++) {
       const sir_global_t* g = &m->globals[i];
       const zi_ptr_t p = sem_guest_alloc(mem, (zi_size32_t)g->size, (zi_size32_t)g->align);
@@ -3637,9 +4275,49 @@ int32_t sir_module_run_ex(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_
       }
     }
   }
+  run.globals = globals;
+  run.next_stop = run.next_ck < run.max_steps ? run.next_ck : run.max_steps;
 
-  const int32_t r = exec_func(m, mem, host, globals, m->global_count, m->entry, NULL, 0, NULL, 0, 0, sink);
+  const int32_t r = exec_func(m, mem, host, &run, m->entry, NULL, 0, NULL, 0, 0, sink);
   free(globals);
+  exec_report(&run, stats);
   if (r > 0) return r - 1;
   return r;
 }
+
+int32_t sir_module_run_ex(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, const sir_exec_event_sink_t* sink) {
+  return exec_run(m, mem, host, sink, NULL, NULL, 0, false, NULL, NULL);
+}
+
+int32_t sir_module_run_bounded(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, const sir_exec_event_sink_t* sink,
+                               uint64_t max_steps) {
+  return exec_run(m, mem, host, sink, NULL, NULL, max_steps, false, NULL, NULL);
+}
+
+int32_t sir_module_run_measured(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, const sir_exec_event_sink_t* sink,
+                                uint64_t max_steps, sir_exec_stats_t* out) {
+  return exec_run(m, mem, host, sink, NULL, NULL, max_steps, false, NULL, out);
+}
+
+int32_t sir_module_run_validated(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, const sir_exec_event_sink_t* sink,
+                                 uint64_t max_steps, sir_exec_stats_t* out) {
+  return exec_run(m, mem, host, sink, NULL, NULL, max_steps, true, NULL, out);
+}
+
+int32_t sir_module_run_lazy(sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, const sir_exec_event_sink_t* sink,
+                            sir_func_loader_fn load, void* user) {
+  if (!load) return ZI_E_INTERNAL;
+  const sir_exec_lazy_t lazy = {.m = m, .load = load, .user = user};
+  return exec_run(m, mem, host, sink, NULL, NULL, 0, true, &lazy, NULL);
+}
+
+int32_t sir_module_run_checkpointed(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, const sir_exec_event_sink_t* sink,
+                                    const sir_exec_checkpoint_t* ck) {
+  return exec_run(m, mem, host, sink, ck, NULL, 0, false, NULL, NULL);
+}
+
+int32_t sir_module_resume(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, const sir_exec_event_sink_t* sink,
+                          const sir_exec_checkpoint_t* ck, const sir_exec_snapshot_t* from) {
+  if (!from) return ZI_E_INVALID;
+  return exec_run(m, mem, host, sink, ck, from, 0, false, NULL, NULL);
+}
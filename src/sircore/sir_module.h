@@ -174,7 +174,7 @@ typedef enum sir_inst_kind {
   SIR_INST_STORE_F64,
   SIR_INST_LOAD_F32,
   SIR_INST_LOAD_F64,
-  SIR_INST_CALL_EXTERN, // currently supports zi_write/zi_end/zi_alloc/zi_free/zi_telemetry
+  SIR_INST_CALL_EXTERN, // currently supports zi_read/zi_write/zi_end/zi_alloc/zi_free/zi_telemetry/zi_transfer
   SIR_INST_CALL_FUNC,
   // Calls an in-module function via a tagged function pointer value:
   //   ptr = 0xF000... | fid  (same encoding used by sem's fun.sym)
@@ -234,7 +234,7 @@ typedef struct sir_inst {
       sir_val_id_t dst;
     } const_null;
     struct {
-      const uint8_t* bytes; // module-owned
+      const uint8_t* bytes; // module-owned; read via sir_module_inst_ref
       uint32_t len;
       sir_val_id_t dst_ptr;
       sir_val_id_t dst_len;
@@ -324,8 +324,8 @@ typedef struct sir_inst {
     } select;
     struct {
       uint32_t target_ip;
-      const sir_val_id_t* src_slots; // module-owned; len=arg_count
-      const sir_val_id_t* dst_slots; // module-owned; len=arg_count
+      const sir_val_id_t* src_slots; // module-owned; len=arg_count; read via sir_module_inst_ref
+      const sir_val_id_t* dst_slots; // module-owned; len=arg_count; read via sir_module_inst_ref
       uint32_t arg_count;
     } br;
     struct {
@@ -335,8 +335,8 @@ typedef struct sir_inst {
     } cbr;
     struct {
       sir_val_id_t scrut;
-      const int32_t* case_lits;    // module-owned; len=case_count
-      const uint32_t* case_target; // module-owned; len=case_count
+      const int32_t* case_lits;    // module-owned; len=case_count; read via sir_module_inst_ref
+      const uint32_t* case_target; // module-owned; len=case_count; read via sir_module_inst_ref
       uint32_t case_count;
       uint32_t default_ip;
     } sw;
@@ -368,17 +368,17 @@ typedef struct sir_inst {
     } load;
     struct {
       sir_sym_id_t callee;
-      const sir_val_id_t* args; // module-owned
+      const sir_val_id_t* args; // module-owned; read via sir_module_inst_ref
       uint32_t arg_count;
     } call_extern;
     struct {
       sir_func_id_t callee;
-      const sir_val_id_t* args; // module-owned
+      const sir_val_id_t* args; // module-owned; read via sir_module_inst_ref
       uint32_t arg_count;
     } call_func;
     struct {
       sir_val_id_t callee_ptr;   // SIR_VAL_PTR holding a tagged fid
-      const sir_val_id_t* args;  // module-owned
+      const sir_val_id_t* args;  // module-owned; read via sir_module_inst_ref
       uint32_t arg_count;
     } call_func_ptr;
     struct {
@@ -403,6 +403,7 @@ typedef struct sir_func {
   uint32_t inst_count;
   uint32_t value_count;       // number of value slots (0..N-1), for executor table sizing
   sir_sig_t sig;              // points into module-owned arrays (0 or 1 result for MVP)
+  bool lazy;                  // body not lowered yet; filled by the module's func loader on first call
 } sir_func_t;
 
 typedef struct sir_module {
@@ -419,8 +420,18 @@ typedef struct sir_module {
   uint32_t func_count;
 
   sir_func_id_t entry; // 1-based id into funcs (0 is invalid)
+
+  // Set for modules loaded by sir_module_load_image: the out-of-line instruction
+  // operands (const_bytes, br slots, switch cases, call args) hold byte offsets into
+  // this blob (0 == NULL) instead of pointers. NULL for built modules.
+  const uint8_t* blob;
+  uint64_t blob_size;
 } sir_module_t;
 
+// Resolves an out-of-line operand of an instruction in `m` (see sir_module_t.blob).
+// Validation checks that every offset of an image module lies inside its blob.
+const void* sir_module_inst_ref(const sir_module_t* m, const void* ref);
+
 // Execution events (optional).
 // Used by frontends (sem/instrument) to build trace/coverage/profiling without forking the VM.
 typedef enum sir_mem_event_kind {
@@ -460,6 +471,11 @@ bool sir_mb_func_set_entry(sir_module_builder_t* b, sir_func_id_t f);
 bool sir_mb_func_set_value_count(sir_module_builder_t* b, sir_func_id_t f, uint32_t value_count);
 bool sir_mb_func_set_sig(sir_module_builder_t* b, sir_func_id_t f, sir_sig_t sig);
 
+// Lazy bodies: mark `f` as having no body at finalize time. After finalize, the
+// frontend may keep emitting into the same builder (from a func loader) and then
+// move the body into the module with sir_mb_func_commit.
+bool sir_mb_func_set_lazy(sir_module_builder_t* b, sir_func_id_t f, bool lazy);
+
 bool sir_mb_emit_const_i1(sir_module_builder_t* b, sir_func_id_t f, sir_val_id_t dst, bool v);
 bool sir_mb_emit_const_i32(sir_module_builder_t* b, sir_func_id_t f, sir_val_id_t dst, int32_t v);
 bool sir_mb_emit_const_i64(sir_module_builder_t* b, sir_func_id_t f, sir_val_id_t dst, int64_t v);
@@ -566,6 +582,38 @@ sir_module_t* sir_mb_finalize(sir_module_builder_t* b);
 // Free a finalized module (returned by sir_mb_finalize). Safe to pass NULL.
 void sir_module_free(sir_module_t* m);
 
+// Move the body emitted for lazy func `f` (since `m` was finalized from `b`) into `m`,
+// along with any types/syms and pool data added meanwhile, and validate it: this is the
+// only check a lazy body gets. Clears `lazy` on success. Returns false on OOM, if `f` is
+// not lazy, if globals were added after finalize, or if the body is invalid (then `out`,
+// when provided, holds the validator diagnostic and `f` stays lazy).
+struct sir_validate_diag;
+bool sir_mb_func_commit(sir_module_builder_t* b, sir_module_t* m, sir_func_id_t f, struct sir_validate_diag* out);
+
+// Func loader for lazy funcs (see sir_module_run_lazy): called by the executor before the
+// first call of a func with `lazy` set. Must commit the body (sir_mb_func_commit) and
+// return 0, or return a negative ZI_E_* to abort execution.
+typedef int32_t (*sir_func_loader_fn)(void* user, sir_module_t* m, sir_func_id_t fid);
+
+// Binary module images (.sirm).
+//
+// A finalized module can be written to a versioned image and loaded back via mmap,
+// skipping the frontend entirely. Images are a cache format, not an interchange
+// format: they are tied to SIR_MODULE_IMAGE_VERSION and to the host's pointer size,
+// byte order and sir_inst_t layout, and load fails cleanly on any mismatch.
+#define SIR_MODULE_IMAGE_VERSION 3u
+
+// Write `m` to `path`. Fails for modules with lazy funcs. Returns false on I/O error.
+bool sir_module_write_image(const sir_module_t* m, const char* path);
+
+// Map an image written by sir_module_write_image. Returns NULL if the file is missing,
+// truncated, from another image version/host layout, or has out-of-range offsets in
+// its funcs/syms/globals. Instructions are used in place from a read-only mapping, so
+// their operand offsets are only checked by validation: image contents are untrusted,
+// and callers must validate the module before running it.
+// The result is freed with sir_module_free.
+sir_module_t* sir_module_load_image(const char* path);
+
 // Validate a module for basic semantic/structural invariants.
 // Returns true if valid; on failure, writes a short message into `err` when provided.
 bool sir_module_validate(const sir_module_t* m, char* err, size_t err_cap);
@@ -586,6 +634,10 @@ typedef struct sir_validate_diag {
 // Returns true if valid; on failure, fills `out` when provided.
 bool sir_module_validate_ex(const sir_module_t* m, sir_validate_diag_t* out);
 
+// Validate a single function body (module-level checks are not repeated).
+// sir_mb_func_commit runs it on each lazy body; sir_module_validate skips lazy bodies.
+bool sir_module_validate_func_ex(const sir_module_t* m, sir_func_id_t fid, sir_validate_diag_t* out);
+
 // Execution: run module entry function.
 // Returns exit code (>=0) or negative ZI_E_*.
 int32_t sir_module_run(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host);
@@ -593,3 +645,73 @@ int32_t sir_module_run(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t h
 // Execution with an optional event sink.
 // The sink callbacks are best-effort and must not affect execution.
 int32_t sir_module_run_ex(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, const sir_exec_event_sink_t* sink);
+
+// Like sir_module_run_ex, but gives up with ZI_E_AGAIN once `max_steps` instructions
+// have run (0 = no limit). Lets fuzzers and other batch drivers bound runaway guests.
+int32_t sir_module_run_bounded(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, const sir_exec_event_sink_t* sink,
+                               uint64_t max_steps);
+
+// Executor counters for one run (guest heap use is mem->brk afterwards).
+typedef struct sir_exec_stats {
+  uint64_t steps;            // instructions retired
+  uint64_t host_allocs;      // host heap allocations made by the executor (frames, globals table)
+  uint64_t host_alloc_bytes;
+  uint32_t max_frames;       // deepest call nesting
+} sir_exec_stats_t;
+
+// Like sir_module_run_bounded, filling `out` (may be NULL) however the run ends.
+int32_t sir_module_run_measured(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, const sir_exec_event_sink_t* sink,
+                                uint64_t max_steps, sir_exec_stats_t* out);
+
+// Like sir_module_run_measured for a module the caller has already accepted with
+// sir_module_validate and not modified since: skips the per-run validation, so batch
+// drivers (fuzzing, benchmarking) validate once and then run the module many times.
+int32_t sir_module_run_validated(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, const sir_exec_event_sink_t* sink,
+                                 uint64_t max_steps, sir_exec_stats_t* out);
+
+// Runs a module with lazy funcs, already accepted by sir_module_validate (which skips
+// lazy bodies), calling `load` before the first call of each lazy func. The module is
+// taken mutably because bodies (and the types/syms they add) are committed into it while
+// it runs; tables only grow, and replaced copies live until sir_module_free. The other
+// run functions fail with ZI_E_NOSYS when they reach a lazy func.
+int32_t sir_module_run_lazy(sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, const sir_exec_event_sink_t* sink,
+                            sir_func_loader_fn load, void* user);
+
+// Checkpoint/resume (optional).
+// A snapshot is the interpreter state at an instruction boundary: frames[0] is the entry
+// frame and frames[frame_count-1] the innermost one, whose ip is the next instruction to
+// execute; every outer frame is parked on its pending call.func/call.func_ptr. Guest
+// memory is not part of the snapshot (the caller owns `mem`).
+typedef struct sir_exec_frame {
+  sir_func_id_t fid;
+  uint32_t ip;
+  const sir_value_t* vals; // val_count == value_count of fid
+  uint32_t val_count;
+} sir_exec_frame_t;
+
+typedef struct sir_exec_snapshot {
+  uint64_t steps; // instructions executed before this point
+  const sir_exec_frame_t* frames;
+  uint32_t frame_count;
+  const zi_ptr_t* globals; // guest address of each module global
+  uint32_t global_count;
+} sir_exec_snapshot_t;
+
+typedef struct sir_exec_checkpoint {
+  void* user;
+  uint64_t every_steps; // snapshot whenever steps reaches a non-zero multiple (0 = never)
+  // Called before the instruction at the snapshot point executes; the snapshot is only
+  // valid during the call. Returning false stops further checkpoints (the run goes on).
+  bool (*on_checkpoint)(void* user, const sir_module_t* m, const sem_guest_mem_t* mem, const sir_exec_snapshot_t* s);
+} sir_exec_checkpoint_t;
+
+// Like sir_module_run_ex, taking periodic snapshots through `ck` (may be NULL).
+int32_t sir_module_run_checkpointed(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, const sir_exec_event_sink_t* sink,
+                                    const sir_exec_checkpoint_t* ck);
+
+// Continues a run from `from` instead of starting at the entry function. `mem` must
+// already hold the guest memory of the snapshot point (globals are not re-initialized).
+// Step numbering, and the checkpoint cadence when `ck` is set, continue from from->steps.
+// Returns ZI_E_INVALID when the snapshot does not describe a reachable state of `m`.
+int32_t sir_module_resume(const sir_module_t* m, sem_guest_mem_t* mem, sir_host_t host, const sir_exec_event_sink_t* sink,
+                          const sir_exec_checkpoint_t* ck, const sir_exec_snapshot_t* from);
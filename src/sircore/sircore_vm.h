@@ -29,6 +29,10 @@ typedef struct sir_host_vtable {
 
   int32_t (*zi_telemetry)(void* user, zi_ptr_t topic_ptr, zi_size32_t topic_len, zi_ptr_t msg_ptr, zi_size32_t msg_len);
 
+  // Optional host-side handle-to-handle copy (may be NULL): moves up to `len` bytes
+  // from `src` to `dst` without going through guest memory.
+  int32_t (*zi_transfer)(void* user, zi_handle_t dst, zi_handle_t src, zi_size32_t len);
+
   // Optional caps model (may be NULL).
   int32_t (*zi_cap_count)(void* user);
   int32_t (*zi_cap_get_size)(void* user, int32_t index);
@@ -0,0 +1,187 @@
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE // mkstemp
+#endif
+
+#include "sir_module.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <unistd.h>
+
+static int fail(const char* msg) {
+  fprintf(stderr, "sircore_unit: %s\n", msg);
+  return 1;
+}
+
+static bool same_u32s(const uint32_t* a, const uint32_t* b, uint32_t n) {
+  if (n == 0) return true;
+  return a && b && memcmp(a, b, (size_t)n * sizeof(uint32_t)) == 0;
+}
+
+static bool same_sig(sir_sig_t a, sir_sig_t b) {
+  return a.param_count == b.param_count && a.result_count == b.result_count && same_u32s(a.params, b.params, a.param_count) &&
+         same_u32s(a.results, b.results, a.result_count);
+}
+
+static bool same_str(const char* a, const char* b) {
+  if (!a || !b) return a == b;
+  return strcmp(a, b) == 0;
+}
+
+// Operand arrays are pointers in `ma` and blob offsets in an image module.
+static bool same_inst(const sir_module_t* ma, const sir_inst_t* a, const sir_module_t* mb, const sir_inst_t* b) {
+#define REF(m, p) sir_module_inst_ref((m), (p))
+  if (a->k != b->k || a->result_count != b->result_count || a->src_node_id != b->src_node_id || a->src_line != b->src_line) return false;
+  for (uint8_t i = 0; i < a->result_count; i++) {
+    if (a->results[i] != b->results[i]) return false;
+  }
+  switch (a->k) {
+    case SIR_INST_CONST_I32:
+      return a->u.const_i32.v == b->u.const_i32.v && a->u.const_i32.dst == b->u.const_i32.dst;
+    case SIR_INST_CONST_BYTES:
+      return a->u.const_bytes.len == b->u.const_bytes.len && memcmp(REF(ma, a->u.const_bytes.bytes), REF(mb, b->u.const_bytes.bytes), a->u.const_bytes.len) == 0 &&
+             a->u.const_bytes.dst_ptr == b->u.const_bytes.dst_ptr && a->u.const_bytes.dst_len == b->u.const_bytes.dst_len;
+    case SIR_INST_BR:
+      return a->u.br.target_ip == b->u.br.target_ip && a->u.br.arg_count == b->u.br.arg_count &&
+             same_u32s(REF(ma, a->u.br.src_slots), REF(mb, b->u.br.src_slots), a->u.br.arg_count) &&
+             same_u32s(REF(ma, a->u.br.dst_slots), REF(mb, b->u.br.dst_slots), a->u.br.arg_count);
+    case SIR_INST_SWITCH:
+      return a->u.sw.scrut == b->u.sw.scrut && a->u.sw.case_count == b->u.sw.case_count && a->u.sw.default_ip == b->u.sw.default_ip &&
+             same_u32s(REF(ma, a->u.sw.case_lits), REF(mb, b->u.sw.case_lits), a->u.sw.case_count) &&
+             same_u32s(REF(ma, a->u.sw.case_target), REF(mb, b->u.sw.case_target), a->u.sw.case_count);
+    case SIR_INST_CALL_FUNC:
+      return a->u.call_func.callee == b->u.call_func.callee && a->u.call_func.arg_count == b->u.call_func.arg_count &&
+             same_u32s(REF(ma, a->u.call_func.args), REF(mb, b->u.call_func.args), a->u.call_func.arg_count);
+    default:
+      return true;
+  }
+#undef REF
+}
+
+static sir_module_t* build_module(void) {
+  sir_module_builder_t* b = sir_mb_new();
+  if (!b) return NULL;
+  const sir_type_id_t ty_i32 = sir_mb_type_prim(b, SIR_PRIM_I32);
+  const sir_type_id_t ty_ptr = sir_mb_type_prim(b, SIR_PRIM_PTR);
+  const sir_type_id_t ty_i64 = sir_mb_type_prim(b, SIR_PRIM_I64);
+  const sir_type_id_t wp[] = {ty_i32, ty_ptr, ty_i64};
+  const sir_type_id_t wr[] = {ty_i32};
+  bool ok = ty_i32 && ty_ptr && ty_i64;
+  ok = ok && sir_mb_sym_extern_fn(b, "zi_write", (sir_sig_t){.params = wp, .param_count = 3, .results = wr, .result_count = 1});
+  const uint8_t init[] = {1, 2, 3, 4};
+  ok = ok && sir_mb_global(b, "g", 8, 8, init, sizeof(init));
+
+  const sir_type_id_t hp[] = {ty_i32};
+  const sir_func_id_t helper = ok ? sir_mb_func_begin(b, "helper") : 0;
+  ok = ok && helper && sir_mb_func_set_sig(b, helper, (sir_sig_t){.params = hp, .param_count = 1, .results = wr, .result_count = 1});
+  ok = ok && sir_mb_func_set_value_count(b, helper, 2);
+  sir_mb_set_src(b, 42, 7);
+  ok = ok && sir_mb_emit_const_i32(b, helper, 1, 1) && sir_mb_emit_i32_add(b, helper, 1, 0, 1) && sir_mb_emit_ret_val(b, helper, 1);
+  sir_mb_clear_src(b);
+
+  const sir_func_id_t main_f = ok ? sir_mb_func_begin(b, "main") : 0;
+  ok = ok && main_f && sir_mb_func_set_entry(b, main_f) && sir_mb_func_set_value_count(b, main_f, 5);
+  const sir_val_id_t call_args[] = {0};
+  const sir_val_id_t call_res[] = {1};
+  const int32_t lits[] = {4};
+  const uint32_t targets[] = {4};
+  const sir_val_id_t br_src[] = {1};
+  const sir_val_id_t br_dst[] = {4};
+  ok = ok && sir_mb_emit_const_i32(b, main_f, 0, 3);
+  ok = ok && sir_mb_emit_call_func_res(b, main_f, helper, call_args, 1, call_res, 1);
+  ok = ok && sir_mb_emit_const_bytes(b, main_f, 2, 3, (const uint8_t*)"hi", 2);
+  ok = ok && sir_mb_emit_switch(b, main_f, 1, lits, targets, 1, 5, NULL);
+  ok = ok && sir_mb_emit_br_args(b, main_f, 5, br_src, br_dst, 1, NULL);
+  ok = ok && sir_mb_emit_exit(b, main_f, 0);
+
+  sir_module_t* m = ok ? sir_mb_finalize(b) : NULL;
+  sir_mb_free(b);
+  return m;
+}
+
+static int compare_modules(const sir_module_t* a, const sir_module_t* b) {
+  if (a->type_count != b->type_count || a->sym_count != b->sym_count || a->global_count != b->global_count || a->func_count != b->func_count ||
+      a->entry != b->entry)
+    return fail("module counts differ");
+  for (uint32_t i = 0; i < a->type_count; i++) {
+    if (a->types[i].prim != b->types[i].prim) return fail("type differs");
+  }
+  for (uint32_t i = 0; i < a->sym_count; i++) {
+    if (a->syms[i].kind != b->syms[i].kind || !same_str(a->syms[i].name, b->syms[i].name) || !same_sig(a->syms[i].sig, b->syms[i].sig))
+      return fail("sym differs");
+  }
+  for (uint32_t i = 0; i < a->global_count; i++) {
+    const sir_global_t* ga = &a->globals[i];
+    const sir_global_t* gb = &b->globals[i];
+    if (!same_str(ga->name, gb->name) || ga->size != gb->size || ga->align != gb->align || ga->init_len != gb->init_len ||
+        memcmp(ga->init_bytes, gb->init_bytes, ga->init_len) != 0)
+      return fail("global differs");
+  }
+  for (uint32_t fi = 0; fi < a->func_count; fi++) {
+    const sir_func_t* fa = &a->funcs[fi];
+    const sir_func_t* fb = &b->funcs[fi];
+    if (!same_str(fa->name, fb->name) || fa->inst_count != fb->inst_count || fa->value_count != fb->value_count || !same_sig(fa->sig, fb->sig))
+      return fail("func differs");
+    for (uint32_t ip = 0; ip < fa->inst_count; ip++) {
+      if (!same_inst(a, &fa->insts[ip], b, &fb->insts[ip])) return fail("inst differs");
+    }
+  }
+  return 0;
+}
+
+int main(void) {
+  sir_module_t* m = build_module();
+  if (!m) return fail("failed to build module");
+  if (!sir_module_validate_ex(m, NULL)) {
+    sir_module_free(m);
+    return fail("built module is invalid");
+  }
+
+  char path[] = "/tmp/sircore_module_image_XXXXXX";
+  const int fd = mkstemp(path);
+  if (fd < 0) {
+    sir_module_free(m);
+    return fail("mkstemp failed");
+  }
+  close(fd);
+
+  if (!sir_module_write_image(m, path)) {
+    sir_module_free(m);
+    unlink(path);
+    return fail("sir_module_write_image failed");
+  }
+
+  sir_module_t* img = sir_module_load_image(path);
+  if (!img) {
+    sir_module_free(m);
+    unlink(path);
+    return fail("sir_module_load_image failed");
+  }
+  int rc = compare_modules(m, img);
+  if (!rc && !sir_module_validate_ex(img, NULL)) rc = fail("loaded image is invalid");
+  if (!rc && (!img->blob || m->blob)) rc = fail("only the image module should carry a blob");
+  sir_module_free(img);
+  sir_module_free(m);
+
+  // A truncated image must be rejected, not mapped.
+  if (!rc) {
+    FILE* f = fopen(path, "rb");
+    char buf[64];
+    const size_t n = f ? fread(buf, 1, sizeof(buf), f) : 0;
+    if (f) fclose(f);
+    f = fopen(path, "wb");
+    if (!f || fwrite(buf, 1, n, f) != n) rc = fail("failed to truncate image");
+    if (f) fclose(f);
+    if (!rc) {
+      sir_module_t* bad = sir_module_load_image(path);
+      if (bad) {
+        sir_module_free(bad);
+        rc = fail("expected truncated image to be rejected");
+      }
+    }
+  }
+  unlink(path);
+  return rc;
+}